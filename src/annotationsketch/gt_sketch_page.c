@@ -277,6 +277,9 @@ static int gt_sketch_page_runner(GT_UNUSED int argc,
   {
     /* get features */
     had_err = gt_feature_index_add_gff3file(features, argv[parsed_args+1], err);
+    /* the index is only queried from now on */
+    if (!had_err)
+      gt_feature_index_memory_make_static((GtFeatureIndexMemory*) features);
      if (!had_err && gt_str_length(arguments->seqid) == 0) {
       seqid = gt_feature_index_get_first_seqid(features, err);
       if (seqid == NULL)
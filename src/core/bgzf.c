@@ -0,0 +1,414 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+#include <zlib.h>
+#include "core/bgzf.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/xansi_api.h"
+
+/* maximal size of a (compressed) block */
+#define GT_BGZF_MAX_BLOCK_SIZE  65536UL
+/* amount of uncompressed data per written block, chosen such that the
+   compressed block fits into <GT_BGZF_MAX_BLOCK_SIZE> even for incompressible
+   data */
+#define GT_BGZF_BLOCK_DATA      0xff00UL
+#define GT_BGZF_HEADER_SIZE     18UL
+#define GT_BGZF_FOOTER_SIZE     8UL
+
+static const unsigned char bgzf_header[GT_BGZF_HEADER_SIZE - 2] = {
+  31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0
+};
+
+static const unsigned char bgzf_eof_block[] = {
+  31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0, 27, 0, 3, 0, 0, 0,
+  0, 0, 0, 0, 0, 0
+};
+
+struct GtBgzf {
+  FILE *fp;
+  char *path;
+  bool writing,
+       eof;
+  unsigned char *compressed,
+                *uncompressed;
+  GtUint64 block_offset,       /* file offset of the current block */
+           next_block_offset;  /* file offset of the next block */
+  GtUword block_length,        /* uncompressed length of the current block */
+          block_pos;           /* position in the current block */
+};
+
+static GtUword bgzf_get_le32(const unsigned char *buf)
+{
+  return (GtUword) buf[0] | ((GtUword) buf[1] << 8) |
+         ((GtUword) buf[2] << 16) | ((GtUword) buf[3] << 24);
+}
+
+static void bgzf_set_le32(unsigned char *buf, GtUword value)
+{
+  buf[0] = value & 0xff;
+  buf[1] = (value >> 8) & 0xff;
+  buf[2] = (value >> 16) & 0xff;
+  buf[3] = (value >> 24) & 0xff;
+}
+
+GtBgzf* gt_bgzf_open(const char *path, const char *mode, GtError *err)
+{
+  GtBgzf *bgzf;
+  FILE *fp;
+  gt_error_check(err);
+  gt_assert(path && mode && (mode[0] == 'r' || mode[0] == 'w'));
+  if (!(fp = gt_fa_fopen(path, mode[0] == 'r' ? "rb" : "wb", err)))
+    return NULL;
+  bgzf = gt_calloc(1, sizeof *bgzf);
+  bgzf->fp = fp;
+  bgzf->path = gt_cstr_dup(path);
+  bgzf->writing = mode[0] == 'w';
+  bgzf->compressed = gt_malloc(GT_BGZF_MAX_BLOCK_SIZE);
+  bgzf->uncompressed = gt_malloc(GT_BGZF_MAX_BLOCK_SIZE);
+  return bgzf;
+}
+
+bool gt_bgzf_is_bgzf(const char *path)
+{
+  unsigned char header[GT_BGZF_HEADER_SIZE];
+  bool is_bgzf = false;
+  FILE *fp;
+  gt_assert(path);
+  if ((fp = gt_fa_fopen(path, "rb", NULL))) {
+    if (fread(header, 1, GT_BGZF_HEADER_SIZE, fp) == GT_BGZF_HEADER_SIZE &&
+        !memcmp(header, bgzf_header, 4) && !memcmp(header + 10, bgzf_header + 10,
+                                                   6)) {
+      is_bgzf = true;
+    }
+    gt_fa_fclose(fp);
+  }
+  return is_bgzf;
+}
+
+/* read the block at the current file position, sets <bgzf->eof> at the end of
+   the file */
+static int bgzf_read_block(GtBgzf *bgzf, GtError *err)
+{
+  unsigned char *header = bgzf->compressed;
+  GtUword block_size, length;
+  size_t rval;
+  z_stream zs;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(!bgzf->writing);
+  rval = fread(header, 1, GT_BGZF_HEADER_SIZE, bgzf->fp);
+  if (rval == 0 && feof(bgzf->fp)) {
+    bgzf->eof = true;
+    bgzf->block_offset = bgzf->next_block_offset;
+    bgzf->block_length = bgzf->block_pos = 0;
+    return 0;
+  }
+  if (rval != GT_BGZF_HEADER_SIZE || memcmp(header, bgzf_header, 4) ||
+      memcmp(header + 10, bgzf_header + 10, 6)) {
+    gt_error_set(err, "file \"%s\" is not in BGZF format (block at offset "
+                 GT_LLU ")", bgzf->path, bgzf->next_block_offset);
+    return -1;
+  }
+  block_size = ((GtUword) header[16] | ((GtUword) header[17] << 8)) + 1;
+  if (block_size < GT_BGZF_HEADER_SIZE + GT_BGZF_FOOTER_SIZE ||
+      fread(header + GT_BGZF_HEADER_SIZE, 1,
+            block_size - GT_BGZF_HEADER_SIZE, bgzf->fp)
+        != block_size - GT_BGZF_HEADER_SIZE) {
+    gt_error_set(err, "file \"%s\" is truncated (block at offset " GT_LLU ")",
+                 bgzf->path, bgzf->next_block_offset);
+    return -1;
+  }
+  length = bgzf_get_le32(bgzf->compressed + block_size - 4);
+  if (length > GT_BGZF_MAX_BLOCK_SIZE)
+    had_err = -1;
+  if (!had_err && length) {
+    memset(&zs, 0, sizeof zs);
+    zs.next_in = bgzf->compressed + GT_BGZF_HEADER_SIZE;
+    zs.avail_in = block_size - GT_BGZF_HEADER_SIZE - GT_BGZF_FOOTER_SIZE;
+    zs.next_out = bgzf->uncompressed;
+    zs.avail_out = GT_BGZF_MAX_BLOCK_SIZE;
+    if (inflateInit2(&zs, -15) != Z_OK)
+      had_err = -1;
+    if (!had_err) {
+      if (inflate(&zs, Z_FINISH) != Z_STREAM_END || zs.total_out != length)
+        had_err = -1;
+      (void) inflateEnd(&zs);
+    }
+    if (!had_err && crc32(crc32(0L, Z_NULL, 0), bgzf->uncompressed, length)
+                      != bgzf_get_le32(bgzf->compressed + block_size - 8)) {
+      had_err = -1;
+    }
+  }
+  if (had_err) {
+    gt_error_set(err, "file \"%s\" is corrupt (block at offset " GT_LLU ")",
+                 bgzf->path, bgzf->next_block_offset);
+    return -1;
+  }
+  bgzf->block_offset = bgzf->next_block_offset;
+  bgzf->next_block_offset += block_size;
+  bgzf->block_length = length;
+  bgzf->block_pos = 0;
+  return 0;
+}
+
+static void bgzf_xread_block(GtBgzf *bgzf)
+{
+  GtError *err = gt_error_new();
+  if (bgzf_read_block(bgzf, err)) {
+    fprintf(stderr, "cannot read from compressed file: %s\n",
+            gt_error_get(err));
+    exit(EXIT_FAILURE);
+  }
+  gt_error_delete(err);
+}
+
+size_t gt_bgzf_xread(GtBgzf *bgzf, void *buf, size_t nbytes)
+{
+  size_t bytes_read = 0, len;
+  gt_assert(bgzf && !bgzf->writing && buf);
+  while (bytes_read < nbytes) {
+    if (bgzf->block_pos == bgzf->block_length) {
+      if (bgzf->eof)
+        break;
+      bgzf_xread_block(bgzf);
+      continue; /* blocks may be empty */
+    }
+    len = bgzf->block_length - bgzf->block_pos;
+    if (len > nbytes - bytes_read)
+      len = nbytes - bytes_read;
+    memcpy((char*) buf + bytes_read, bgzf->uncompressed + bgzf->block_pos,
+           len);
+    bgzf->block_pos += len;
+    bytes_read += len;
+  }
+  return bytes_read;
+}
+
+int gt_bgzf_xfgetc(GtBgzf *bgzf)
+{
+  gt_assert(bgzf && !bgzf->writing);
+  while (bgzf->block_pos == bgzf->block_length) {
+    if (bgzf->eof)
+      return EOF;
+    bgzf_xread_block(bgzf);
+  }
+  return bgzf->uncompressed[bgzf->block_pos++];
+}
+
+/* compress and write the buffered data as a single block */
+static void bgzf_write_block(GtBgzf *bgzf)
+{
+  GtUword block_size;
+  z_stream zs;
+  int rval;
+  gt_assert(bgzf->writing && bgzf->block_length <= GT_BGZF_BLOCK_DATA);
+  memset(&zs, 0, sizeof zs);
+  zs.next_in = bgzf->uncompressed;
+  zs.avail_in = bgzf->block_length;
+  zs.next_out = bgzf->compressed + GT_BGZF_HEADER_SIZE;
+  zs.avail_out = GT_BGZF_MAX_BLOCK_SIZE - GT_BGZF_HEADER_SIZE
+                 - GT_BGZF_FOOTER_SIZE;
+  rval = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8,
+                      Z_DEFAULT_STRATEGY);
+  gt_assert(rval == Z_OK);
+  rval = deflate(&zs, Z_FINISH);
+  gt_assert(rval == Z_STREAM_END);
+  (void) deflateEnd(&zs);
+  block_size = GT_BGZF_HEADER_SIZE + zs.total_out + GT_BGZF_FOOTER_SIZE;
+  gt_assert(block_size <= GT_BGZF_MAX_BLOCK_SIZE);
+  memcpy(bgzf->compressed, bgzf_header, sizeof (bgzf_header));
+  bgzf->compressed[16] = (block_size - 1) & 0xff;
+  bgzf->compressed[17] = ((block_size - 1) >> 8) & 0xff;
+  bgzf_set_le32(bgzf->compressed + block_size - 8,
+                crc32(crc32(0L, Z_NULL, 0), bgzf->uncompressed,
+                      bgzf->block_length));
+  bgzf_set_le32(bgzf->compressed + block_size - 4, bgzf->block_length);
+  gt_xfwrite(bgzf->compressed, 1, block_size, bgzf->fp);
+  bgzf->next_block_offset += block_size;
+  bgzf->block_length = 0;
+}
+
+void gt_bgzf_xwrite(GtBgzf *bgzf, const void *buf, size_t nbytes)
+{
+  size_t len;
+  gt_assert(bgzf && bgzf->writing && (buf || !nbytes));
+  while (nbytes) {
+    len = GT_BGZF_BLOCK_DATA - bgzf->block_length;
+    if (len > nbytes)
+      len = nbytes;
+    memcpy(bgzf->uncompressed + bgzf->block_length, buf, len);
+    bgzf->block_length += len;
+    buf = (const char*) buf + len;
+    nbytes -= len;
+    if (bgzf->block_length == GT_BGZF_BLOCK_DATA)
+      bgzf_write_block(bgzf);
+  }
+}
+
+GtUint64 gt_bgzf_tell(const GtBgzf *bgzf)
+{
+  gt_assert(bgzf);
+  if (bgzf->writing)
+    return (bgzf->next_block_offset << 16) | bgzf->block_length;
+  return (bgzf->block_offset << 16) | bgzf->block_pos;
+}
+
+int gt_bgzf_seek(GtBgzf *bgzf, GtUint64 voffset, GtError *err)
+{
+  GtUint64 block_offset = voffset >> 16;
+  GtUword block_pos = voffset & 0xffff;
+  gt_error_check(err);
+  gt_assert(bgzf && !bgzf->writing);
+  if (fseeko(bgzf->fp, (off_t) block_offset, SEEK_SET)) {
+    gt_error_set(err, "cannot seek in file \"%s\": %s", bgzf->path,
+                 strerror(errno));
+    return -1;
+  }
+  bgzf->eof = false;
+  bgzf->next_block_offset = block_offset;
+  if (bgzf_read_block(bgzf, err))
+    return -1;
+  if (block_pos > bgzf->block_length) {
+    gt_error_set(err, "invalid virtual offset " GT_LLU " for file \"%s\"",
+                 voffset, bgzf->path);
+    return -1;
+  }
+  bgzf->block_pos = block_pos;
+  return 0;
+}
+
+void gt_bgzf_xrewind(GtBgzf *bgzf)
+{
+  gt_assert(bgzf && !bgzf->writing);
+  rewind(bgzf->fp);
+  bgzf->eof = false;
+  bgzf->block_offset = bgzf->next_block_offset = 0;
+  bgzf->block_length = bgzf->block_pos = 0;
+}
+
+void gt_bgzf_close(GtBgzf *bgzf)
+{
+  if (!bgzf) return;
+  if (bgzf->writing) {
+    if (bgzf->block_length)
+      bgzf_write_block(bgzf);
+    gt_xfwrite(bgzf_eof_block, 1, sizeof (bgzf_eof_block), bgzf->fp);
+  }
+  gt_fa_xfclose(bgzf->fp);
+  gt_free(bgzf->path);
+  gt_free(bgzf->compressed);
+  gt_free(bgzf->uncompressed);
+  gt_free(bgzf);
+}
+
+#define GT_BGZF_TEST_SIZE     300000UL
+#define GT_BGZF_TEST_OFFSETS  64UL
+
+int gt_bgzf_unit_test(GtError *err)
+{
+  GtUint64 voffsets[GT_BGZF_TEST_OFFSETS];
+  GtUword i, j, positions[GT_BGZF_TEST_OFFSETS];
+  unsigned char *data, *buf;
+  GtStr *path;
+  GtBgzf *bgzf;
+  gzFile gzfile;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* the first half of the data is compressible, the second is not */
+  data = gt_malloc(GT_BGZF_TEST_SIZE);
+  buf = gt_malloc(GT_BGZF_TEST_SIZE + 1);
+  for (i = 0; i < GT_BGZF_TEST_SIZE / 2; i++)
+    data[i] = "acgt\n"[i % 5];
+  for (; i < GT_BGZF_TEST_SIZE; i++)
+    data[i] = (unsigned char) (random() & 0xff);
+  path = gt_str_new();
+  fp = gt_xtmpfp(path);
+  gt_fa_xfclose(fp);
+
+  /* write data in pieces of different lengths and remember offsets */
+  bgzf = gt_bgzf_open(gt_str_get(path), "w", err);
+  gt_ensure(bgzf != NULL);
+  if (!had_err) {
+    for (i = 0, j = 0; i < GT_BGZF_TEST_SIZE; j++) {
+      GtUword len = (j * 7919) % 5000 + 1;
+      if (j < GT_BGZF_TEST_OFFSETS) {
+        voffsets[j] = gt_bgzf_tell(bgzf);
+        positions[j] = i;
+      }
+      if (len > GT_BGZF_TEST_SIZE - i)
+        len = GT_BGZF_TEST_SIZE - i;
+      gt_bgzf_xwrite(bgzf, data + i, len);
+      i += len;
+    }
+    gt_ensure(j >= GT_BGZF_TEST_OFFSETS);
+    gt_bgzf_close(bgzf);
+  }
+  gt_ensure(gt_bgzf_is_bgzf(gt_str_get(path)));
+
+  /* read everything sequentially */
+  if (!had_err) {
+    bgzf = gt_bgzf_open(gt_str_get(path), "r", err);
+    gt_ensure(bgzf != NULL);
+  }
+  if (!had_err) {
+    gt_ensure(gt_bgzf_xread(bgzf, buf, GT_BGZF_TEST_SIZE + 1)
+              == GT_BGZF_TEST_SIZE);
+    gt_ensure(!memcmp(buf, data, GT_BGZF_TEST_SIZE));
+    gt_ensure(gt_bgzf_xfgetc(bgzf) == EOF);
+    /* seek to the remembered offsets (backwards) */
+    for (j = GT_BGZF_TEST_OFFSETS; !had_err && j > 0; j--) {
+      had_err = gt_bgzf_seek(bgzf, voffsets[j-1], err);
+      if (!had_err) {
+        gt_ensure(gt_bgzf_tell(bgzf) == voffsets[j-1]);
+        gt_ensure(gt_bgzf_xfgetc(bgzf) == data[positions[j-1]]);
+        gt_ensure(gt_bgzf_xread(bgzf, buf, 100)
+                  == MIN(100UL, GT_BGZF_TEST_SIZE - positions[j-1] - 1));
+        gt_ensure(!memcmp(buf, data + positions[j-1] + 1,
+                          MIN(100UL, GT_BGZF_TEST_SIZE - positions[j-1] - 1)));
+      }
+    }
+    gt_bgzf_xrewind(bgzf);
+    gt_ensure(gt_bgzf_xfgetc(bgzf) == data[0]);
+    gt_bgzf_close(bgzf);
+  }
+
+  /* BGZF files are valid gzip files */
+  if (!had_err) {
+    gzfile = gt_fa_xgzopen(gt_str_get(path), "r");
+    gt_ensure(gzread(gzfile, buf, GT_BGZF_TEST_SIZE + 1)
+              == (int) GT_BGZF_TEST_SIZE);
+    gt_ensure(!memcmp(buf, data, GT_BGZF_TEST_SIZE));
+    gt_fa_xgzclose(gzfile);
+  }
+
+  gt_xremove(gt_str_get(path));
+  gt_str_delete(path);
+  gt_free(buf);
+  gt_free(data);
+  return had_err;
+}
@@ -0,0 +1,60 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef BGZF_H
+#define BGZF_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtBgzf> reads or writes files in the blocked GNU zip format (BGZF) used by
+   samtools and tabix. A BGZF file is a concatenation of gzip members, each of
+   which holds at most 64 KB of uncompressed data. Hence it can be read by
+   every gzip decompressor, but also allows random access: a position in the
+   uncompressed data is denoted by a ``virtual offset'', which is the file
+   offset of the compressed block shifted left by 16 bits, combined with the
+   offset within the uncompressed block.
+   The x-functions terminate the program if an error occurs (e.g., if the file
+   is corrupt). */
+typedef struct GtBgzf GtBgzf;
+
+/* Open the BGZF file <path> for reading (if <mode> is "r") or writing (if
+   <mode> is "w"). Returns NULL and sets <err> if <path> could not be opened. */
+GtBgzf*  gt_bgzf_open(const char *path, const char *mode, GtError *err);
+/* Return true if the file <path> starts with a BGZF block. */
+bool     gt_bgzf_is_bgzf(const char *path);
+/* Read up to <nbytes> from <bgzf> into <buf> and return the number of bytes
+   read (0 at the end of the file). */
+size_t   gt_bgzf_xread(GtBgzf *bgzf, void *buf, size_t nbytes);
+/* Return the next character from <bgzf> or EOF, if end-of-file is reached. */
+int      gt_bgzf_xfgetc(GtBgzf *bgzf);
+/* Write <nbytes> from <buf> to <bgzf>. */
+void     gt_bgzf_xwrite(GtBgzf *bgzf, const void *buf, size_t nbytes);
+/* Return the virtual offset of the current position of <bgzf>. */
+GtUint64 gt_bgzf_tell(const GtBgzf *bgzf);
+/* Move the current position of the <bgzf> opened for reading to the virtual
+   offset <voffset>. Returns -1 and sets <err> if this is not possible. */
+int      gt_bgzf_seek(GtBgzf *bgzf, GtUint64 voffset, GtError *err);
+/* Rewind the <bgzf> opened for reading. */
+void     gt_bgzf_xrewind(GtBgzf *bgzf);
+/* Flush the data written to <bgzf> (if any), append the end-of-file marker
+   block, and close <bgzf>. */
+void     gt_bgzf_close(GtBgzf *bgzf);
+
+int      gt_bgzf_unit_test(GtError *err);
+
+#endif
@@ -16,10 +16,12 @@
 */
 
 #include <limits.h>
+#include <string.h>
 #include "core/dlist.h"
 #include "core/ensure.h"
 #include "core/ma.h"
 #include "core/mathsupport.h"
+#include "core/slab.h"
 #include "core/unused_api.h"
 
 #define NUM_OF_TESTS  100
@@ -44,9 +46,18 @@ static int gt_dlist_cmp_wrapper(const void *a, const void *b, void *data)
   return ((GtCompare) data)(a, b);
 }
 
+/* lists and their elements are small and numerous (every feature node with
+   children has one), so they are allocated from the size class slabs */
+static GtDlist* dlist_alloc(void)
+{
+  GtDlist *dlist = gt_slab_class_alloc(sizeof (GtDlist));
+  memset(dlist, 0, sizeof (GtDlist));
+  return dlist;
+}
+
 GtDlist* gt_dlist_new(GtCompare cmp_func)
 {
-  GtDlist *dlist = gt_calloc(1, sizeof (GtDlist));
+  GtDlist *dlist = dlist_alloc();
   if (cmp_func == NULL)
     dlist->cmp_func = NULL;
   else
@@ -57,7 +68,7 @@ GtDlist* gt_dlist_new(GtCompare cmp_func)
 
 GtDlist* gt_dlist_new_with_data(GtCompareWithData cmp_func, void *data)
 {
-  GtDlist *dlist = gt_calloc(1, sizeof (GtDlist));
+  GtDlist *dlist = dlist_alloc();
   dlist->cmp_func = cmp_func;
   dlist->data = data;
   return dlist;
@@ -100,7 +111,8 @@ void gt_dlist_add(GtDlist *dlist, void *data)
 {
   GtDlistelem *oldelem, *newelem;
   gt_assert(dlist); /* data can be null */
-  newelem = gt_calloc(1, sizeof (GtDlistelem));
+  newelem = gt_slab_class_alloc(sizeof (GtDlistelem));
+  newelem->previous = newelem->next = NULL;
   newelem->data = data;
 
   if (!dlist->first) {
@@ -170,7 +182,7 @@ void gt_dlist_remove(GtDlist *dlist, GtDlistelem *dlistelem)
   if (dlistelem == dlist->last)
     dlist->last = dlistelem->previous;
   dlist->size--;
-  gt_free(dlistelem);
+  gt_slab_class_free(dlistelem, sizeof (GtDlistelem));
 }
 
 static int intcompare(const void *a, const void *b)
@@ -368,11 +380,11 @@ void gt_dlist_delete(GtDlist *dlist)
   if (!dlist) return;
   elem = dlist->first;
   while (elem) {
-    gt_free(elem->previous);
+    gt_slab_class_free(elem->previous, sizeof (GtDlistelem));
     elem = elem->next;
   }
-  gt_free(dlist->last);
-  gt_free(dlist);
+  gt_slab_class_free(dlist->last, sizeof (GtDlistelem));
+  gt_slab_class_free(dlist, sizeof (GtDlist));
 }
 
 GtDlistelem* gt_dlistelem_next(const GtDlistelem *dlistelem)
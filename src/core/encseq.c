@@ -21,6 +21,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <limits.h>
+#include <string.h>
 #include <errno.h>
 #ifndef S_SPLINT_S
 #include <ctype.h>
@@ -58,7 +59,10 @@
 #include "core/progressbar.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_plain.h"
+#include "core/sequence_buffer_replay.h"
 #include "core/str.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/timer_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
@@ -67,6 +71,14 @@
 #include "core/xposix.h"
 #include "core/yarandom.h"
 
+/* The AVX2 kernel unpacking the two bit encoding is only available for x86-64
+   compilers which support target specific functions. */
+#if defined(__x86_64__) && GT_INTWORDSIZE == 64 && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#include <immintrin.h>
+#define GT_ENCSEQ_UNPACK_AVX2
+#endif
+
 #undef GT_RANGEDEBUG
 
 /* The following implements the access functions to the bit encoding */
@@ -84,21 +96,81 @@
                   TWOBITENCODING[(GtUword) GT_DIVBYUNITSIN2BITENC(IDX)],\
                   GT_MODBYUNITSIN2BITENC(IDX))
 
+/* number of units of the buffer used when writing the two bit encoding
+   directly to the .esq file */
+#define GT_ENCSEQ_STREAMBUFFERUNITS  ((GtUword) 65536)
+
+static GtTwobitencoding *twobitencoding_buffer_new(GtEncseq *encseq)
+{
+  GtTwobitencoding *tbe;
+
+  encseq->unitsoftwobitencoding
+    = gt_unitsoftwobitencoding(encseq->totallength);
+  encseq->twobitencodingbufferunits
+    = encseq->twobitencodingstream == NULL
+        ? encseq->unitsoftwobitencoding
+        : MIN(encseq->unitsoftwobitencoding, GT_ENCSEQ_STREAMBUFFERUNITS);
+  encseq->twobitencodingwrittenunits = 0;
+  tbe = gt_malloc(sizeof (*tbe) * encseq->twobitencodingbufferunits);
+  tbe[encseq->twobitencodingbufferunits-1] = 0;
+  return tbe;
+}
+
+/* Append the units of the buffer before <tbeptr> to the .esq file and return
+   the start of the buffer. */
+static GtTwobitencoding *twobitencoding_buffer_flush(GtEncseq *encseq,
+                                                     GtTwobitencoding *tbeptr)
+{
+  GtUword units = (GtUword) (tbeptr - encseq->twobitencoding);
+
+  gt_assert(encseq->twobitencodingstream != NULL);
+  gt_xfwrite(encseq->twobitencoding, sizeof (*encseq->twobitencoding),
+             (size_t) units, encseq->twobitencodingstream);
+  encseq->twobitencodingwrittenunits += units;
+  return encseq->twobitencoding;
+}
+
+/* Write the remaining units of the two bit encoding, which has been filled up
+   to <tbeptr>, to the .esq file and free the buffer. */
+static void twobitencoding_buffer_finish(GtEncseq *encseq,
+                                         GtTwobitencoding *tbeptr)
+{
+  if (encseq->twobitencodingstream == NULL)
+    return;
+  (void) twobitencoding_buffer_flush(encseq, tbeptr);
+  memset(encseq->twobitencoding, 0, sizeof (*encseq->twobitencoding)
+                                    * encseq->twobitencodingbufferunits);
+  while (encseq->twobitencodingwrittenunits < encseq->unitsoftwobitencoding) {
+    GtUword units = MIN(encseq->unitsoftwobitencoding
+                          - encseq->twobitencodingwrittenunits,
+                        encseq->twobitencodingbufferunits);
+    (void) twobitencoding_buffer_flush(encseq, encseq->twobitencoding + units);
+  }
+  gt_free(encseq->twobitencoding);
+  encseq->twobitencoding = NULL;
+}
+
 #define DECLARESEQBUFFER(TABLE)\
         GtTwobitencoding bitwise = 0;\
         GtUword widthbuffer = 0;\
-        GtTwobitencoding *twobitencodingptr;\
-        encseq->unitsoftwobitencoding\
-          = gt_unitsoftwobitencoding(encseq->totallength);\
-        TABLE = gt_malloc(sizeof (*(TABLE)) * encseq->unitsoftwobitencoding);\
-        TABLE[encseq->unitsoftwobitencoding-1] = 0;\
-        twobitencodingptr = TABLE
+        GtTwobitencoding *twobitencodingptr, *twobitencodingend;\
+        TABLE = twobitencoding_buffer_new(encseq);\
+        twobitencodingptr = TABLE;\
+        twobitencodingend = TABLE + encseq->twobitencodingbufferunits
+
+#define STORESEQBUFFER(BITWISE, TWOBITENCODINGPTR)\
+        *(TWOBITENCODINGPTR)++ = BITWISE;\
+        if ((TWOBITENCODINGPTR) == twobitencodingend) {\
+          TWOBITENCODINGPTR = twobitencoding_buffer_flush(encseq,\
+                                                          TWOBITENCODINGPTR);\
+        }
 
 #define UPDATESEQBUFFERFINAL(BITWISE, TWOBITENCODINGPTR)\
         if (widthbuffer > 0) {\
           BITWISE <<= GT_MULT2(GT_UNITSIN2BITENC - widthbuffer);\
-          *(TWOBITENCODINGPTR) = BITWISE;\
-        }
+          *(TWOBITENCODINGPTR)++ = BITWISE;\
+        }\
+        twobitencoding_buffer_finish(encseq, TWOBITENCODINGPTR)
 
 /* the following two macros are relevant for GT_ACCESS_TYPE_BITACCESS */
 
@@ -702,25 +774,338 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
   gt_encseq_reader_delete(esr);
 }
 
+/* Table mapping each byte of a two bit encoding to the four characters it
+   encodes. */
+typedef struct {
+  char chars[4],
+       bytes[256][4];
+} GtEncseqUnpacktable;
+
+static void gt_encseq_unpacktable_init(GtEncseqUnpacktable *table,
+                                       const GtAlphabet *alpha,
+                                       bool complement)
+{
+  unsigned int code, byte, numofchars;
+
+  numofchars = gt_alphabet_num_of_chars(alpha);
+  for (code = 0; code < 4U; code++) {
+    GtUchar cc = (GtUchar) (complement ? 3U - code : code);
+    table->chars[code] = cc < numofchars
+                         ? (char) gt_alphabet_decode(alpha, cc)
+                         : (char) gt_alphabet_decode(alpha,
+                                                     (GtUchar) WILDCARD);
+  }
+  for (byte = 0; byte < 256U; byte++) {
+    for (code = 0; code < 4U; code++) {
+      table->bytes[byte][code] = table->chars[(byte >> (6 - 2 * code)) & 3];
+    }
+  }
+}
+
+static inline char gt_encseq_unpack_char(const GtTwobitencoding *tbe,
+                                         const GtEncseqUnpacktable *table,
+                                         GtUword pos)
+{
+  return table->chars[(tbe[GT_DIVBYUNITSIN2BITENC(pos)] >>
+                       GT_MULT2(GT_UNITSIN2BITENC - 1 -
+                                GT_MODBYUNITSIN2BITENC(pos))) & 3];
+}
+
+/* write the characters at positions <pos> to <pos> + <len> - 1 */
+static void gt_encseq_unpack_generic(char *dest,
+                                     const GtTwobitencoding *tbe,
+                                     const GtEncseqUnpacktable *table,
+                                     GtUword pos,
+                                     GtUword len)
+{
+  const GtUword endpos = pos + len;
+
+  for (/* Nothing */; pos < endpos && (pos & 3) != 0; pos++) {
+    *dest++ = gt_encseq_unpack_char(tbe, table, pos);
+  }
+  for (/* Nothing */; pos + 4 <= endpos; pos += 4, dest += 4) {
+    GtUword byte = (tbe[GT_DIVBYUNITSIN2BITENC(pos)] >>
+                   GT_MULT2(GT_UNITSIN2BITENC - 4 -
+                            GT_MODBYUNITSIN2BITENC(pos))) & 255;
+    memcpy(dest, table->bytes[byte], (size_t) 4);
+  }
+  for (/* Nothing */; pos < endpos; pos++) {
+    *dest++ = gt_encseq_unpack_char(tbe, table, pos);
+  }
+}
+
+#ifdef GT_ENCSEQ_UNPACK_AVX2
+/* Unpacks whole words of the two bit encoding: the eight bytes of a word are
+   spread to 32 byte lanes, the codes are shifted into the lowest two bits and
+   mapped to characters by a table lookup. */
+__attribute__((target("avx2")))
+static void gt_encseq_unpack_avx2(char *dest,
+                                  const GtTwobitencoding *tbe,
+                                  const GtEncseqUnpacktable *table,
+                                  GtUword pos,
+                                  GtUword len)
+{
+  const GtUword endpos = pos + len;
+  GtUword headlen = (GtUword) ((GT_UNITSIN2BITENC -
+                                GT_MODBYUNITSIN2BITENC(pos)) %
+                               GT_UNITSIN2BITENC);
+  __m256i spread, mask0, mask1, mask2, mask3, lookup;
+
+  if (headlen > len) {
+    headlen = len;
+  }
+  gt_encseq_unpack_generic(dest, tbe, table, pos, headlen);
+  pos += headlen;
+  dest += headlen;
+  spread = _mm256_setr_epi8(7, 7, 7, 7, 6, 6, 6, 6, 5, 5, 5, 5, 4, 4, 4, 4,
+                            3, 3, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1, 0, 0, 0, 0);
+  mask0 = _mm256_set1_epi32(0x00000003);
+  mask1 = _mm256_set1_epi32(0x00000300);
+  mask2 = _mm256_set1_epi32(0x00030000);
+  mask3 = _mm256_set1_epi32(0x03000000);
+  lookup = _mm256_setr_epi8(table->chars[0], table->chars[1],
+                            table->chars[2], table->chars[3],
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                            table->chars[0], table->chars[1],
+                            table->chars[2], table->chars[3],
+                            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  for (/* Nothing */; pos + GT_UNITSIN2BITENC <= endpos;
+       pos += GT_UNITSIN2BITENC, dest += GT_UNITSIN2BITENC) {
+    __m256i bytes, codes;
+
+    bytes = _mm256_shuffle_epi8(
+              _mm256_set1_epi64x((long long)
+                                 tbe[GT_DIVBYUNITSIN2BITENC(pos)]),
+              spread);
+    codes = _mm256_or_si256(
+              _mm256_or_si256(
+                _mm256_and_si256(_mm256_srli_epi16(bytes, 6), mask0),
+                _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask1)),
+              _mm256_or_si256(
+                _mm256_and_si256(_mm256_srli_epi16(bytes, 2), mask2),
+                _mm256_and_si256(bytes, mask3)));
+    _mm256_storeu_si256((__m256i *) dest,
+                        _mm256_shuffle_epi8(lookup, codes));
+  }
+  gt_encseq_unpack_generic(dest, tbe, table, pos, endpos - pos);
+}
+#endif
+
+typedef void (*GtEncseqUnpackFunc)(char*, const GtTwobitencoding*,
+                                   const GtEncseqUnpacktable*, GtUword,
+                                   GtUword);
+
+static GtEncseqUnpackFunc gt_encseq_unpack_func(void)
+{
+#ifdef GT_ENCSEQ_UNPACK_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return gt_encseq_unpack_avx2;
+  }
+#endif
+  return gt_encseq_unpack_generic;
+}
+
+/* Returns true if the decoded characters of <encseq> can be computed from
+   its two bit encoding and its special ranges. */
+static bool gt_encseq_decode_via_twobitencoding(const GtEncseq *encseq)
+{
+  return encseq->twobitencoding != NULL &&
+         !encseq->has_exceptiontable &&
+         !encseq->hasmirror &&
+         gt_encseq_has_twobitencoding_stoppos_support(encseq);
+}
+
+static void gt_encseq_reverse_chars(char *buffer, GtUword len)
+{
+  char *left, *right, tmp;
+
+  if (len == 0)
+    return;
+  for (left = buffer, right = buffer + len - 1; left < right;
+       left++, right--) {
+    tmp = *left;
+    *left = *right;
+    *right = tmp;
+  }
+}
+
+/* Decodes the positions <frompos> to <topos> of <encseq>, read in forward
+   direction, into <buffer>: the characters between two special ranges are
+   unpacked from the two bit encoding, the special ranges are located with
+   <esr>. */
+static void gt_encseq_decode_twobitencoding(const GtEncseq *encseq,
+                                            GtEncseqReader *esr,
+                                            const GtEncseqUnpacktable *table,
+                                            GtEncseqUnpackFunc unpack,
+                                            char *buffer,
+                                            GtUword frompos,
+                                            GtUword topos)
+{
+  GtUword pos = frompos, stoppos;
+  const char wildcardchar = (char) gt_alphabet_decode(encseq->alpha,
+                                                      (GtUchar) WILDCARD);
+
+  gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                        pos);
+  while (pos <= topos) {
+    GtUchar cc;
+
+    stoppos = gt_getnexttwobitencodingstoppos(true, esr);
+    if (stoppos > topos + 1) {
+      stoppos = topos + 1;
+    }
+    if (stoppos > pos) {
+      unpack(buffer + pos - frompos, encseq->twobitencoding, table, pos,
+             stoppos - pos);
+      pos = stoppos;
+    }
+    if (pos > topos) {
+      break;
+    }
+    /* read the special range and the following character with <esr> */
+    if (esr->currentpos != pos) {
+      gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                            pos);
+    }
+    do {
+      cc = gt_encseq_reader_next_encoded_char(esr);
+      if (cc == (GtUchar) SEPARATOR) {
+        buffer[pos - frompos] = (char) SEPARATOR;
+      } else {
+        buffer[pos - frompos] = cc == (GtUchar) WILDCARD
+                                ? wildcardchar
+                                : table->chars[cc];
+      }
+      pos++;
+    } while (pos <= topos && ISSPECIAL(cc));
+  }
+}
+
+/* Decodes the positions <frompos> to <topos> of <encseq>, read in <readmode>,
+   into <buffer>, using <esr> as the reader. */
+static void gt_encseq_decode_range(const GtEncseq *encseq,
+                                   GtEncseqReader *esr,
+                                   const GtEncseqUnpacktable *table,
+                                   GtEncseqUnpackFunc unpack,
+                                   char *buffer,
+                                   GtReadmode readmode,
+                                   GtUword frompos,
+                                   GtUword topos)
+{
+  if (table != NULL) {
+    if (GT_ISDIRREVERSE(readmode)) {
+      gt_encseq_decode_twobitencoding(encseq, esr, table, unpack, buffer,
+                                      GT_REVERSEPOS(encseq->totallength,
+                                                    topos),
+                                      GT_REVERSEPOS(encseq->totallength,
+                                                    frompos));
+      gt_encseq_reverse_chars(buffer, topos - frompos + 1);
+    } else {
+      gt_encseq_decode_twobitencoding(encseq, esr, table, unpack, buffer,
+                                      frompos, topos);
+    }
+  } else {
+    GtUword idx, pos;
+
+    gt_encseq_reader_reinit_with_readmode(esr, encseq, readmode, frompos);
+    for (pos = frompos, idx = 0; pos <= topos; pos++, idx++) {
+      buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
+    }
+  }
+}
+
 void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                char *buffer,
                                GtUword frompos,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
+  GtEncseqUnpacktable table;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength);
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
+  if (gt_encseq_decode_via_twobitencoding(encseq)) {
+    gt_encseq_unpacktable_init(&table, encseq->alpha, false);
+    gt_encseq_decode_range(encseq, esr, &table, gt_encseq_unpack_func(),
+                           buffer, GT_READMODE_FORWARD, frompos, topos);
+  } else {
+    gt_encseq_decode_range(encseq, esr, NULL, NULL, buffer,
+                           GT_READMODE_FORWARD, frompos, topos);
   }
   gt_encseq_reader_delete(esr);
 }
 
+/* number of positions decoded by one task */
+#define GT_ENCSEQ_DECODEPARTSIZE (1UL << 18)
+
+typedef struct {
+  const GtEncseq *encseq;
+  const GtEncseqUnpacktable *table;
+  GtEncseqUnpackFunc unpack;
+  char *buffer;
+  GtReadmode readmode;
+  GtUword frompos,
+          topos;
+} GtEncseqDecodeParts;
+
+static void gt_encseq_decode_parts(GtUword start, GtUword end, void *data)
+{
+  GtEncseqDecodeParts *parts = data;
+  GtEncseqReader *esr;
+  GtUword part;
+
+  esr = gt_encseq_create_reader_with_readmode(parts->encseq,
+                                              GT_READMODE_FORWARD, 0);
+  for (part = start; part < end; part++) {
+    GtUword partfrom = parts->frompos + part * GT_ENCSEQ_DECODEPARTSIZE,
+            partto = MIN(partfrom + GT_ENCSEQ_DECODEPARTSIZE - 1,
+                         parts->topos);
+
+    gt_encseq_decode_range(parts->encseq, esr, parts->table, parts->unpack,
+                           parts->buffer + partfrom - parts->frompos,
+                           parts->readmode, partfrom, partto);
+  }
+  gt_encseq_reader_delete(esr);
+}
+
+void gt_encseq_extract_decoded_parallel(const GtEncseq *encseq,
+                                        char *buffer,
+                                        GtReadmode readmode,
+                                        GtUword frompos,
+                                        GtUword topos)
+{
+  GtEncseqDecodeParts parts;
+  GtEncseqUnpacktable table;
+  GtUword numofparts;
+
+  gt_assert(frompos <= topos && encseq != NULL &&
+            topos < encseq->logicaltotallength);
+  parts.encseq = encseq;
+  parts.table = NULL;
+  parts.unpack = NULL;
+  if (gt_encseq_decode_via_twobitencoding(encseq)) {
+    gt_encseq_unpacktable_init(&table, encseq->alpha,
+                               GT_ISDIRCOMPLEMENT(readmode));
+    parts.table = &table;
+    parts.unpack = gt_encseq_unpack_func();
+  }
+  parts.buffer = buffer;
+  parts.readmode = readmode;
+  parts.frompos = frompos;
+  parts.topos = topos;
+  numofparts = (topos - frompos) / GT_ENCSEQ_DECODEPARTSIZE + 1;
+  if (numofparts == 1UL || gt_jobs <= 1U) {
+    gt_encseq_decode_parts(0, numofparts, &parts);
+  } else {
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numofparts, 1UL,
+                                gt_encseq_decode_parts, &parts);
+  }
+}
+
 const char* gt_encseq_accessname(const GtEncseq *encseq)
 {
   gt_assert(encseq != NULL);
@@ -1371,7 +1756,15 @@ static int gt_encseq_flush2file(const char *indexname,
   bool haserr = false;
 
   gt_error_check(err);
-  fp = gt_fa_fopen_with_suffix(indexname, GT_ENCSEQFILESUFFIX, "wb", err);
+  if (encseq->twobitencodingstream != NULL) {
+    /* the two bit encoding has already been written and is skipped */
+    gt_assert(encseq->twobitencoding == NULL);
+    fp = encseq->twobitencodingstream;
+    encseq->twobitencodingstream = NULL;
+    gt_xfseek(fp, 0, SEEK_SET);
+  }
+  else
+    fp = gt_fa_fopen_with_suffix(indexname, GT_ENCSEQFILESUFFIX, "wb", err);
   if (fp == NULL)
     haserr = true;
   if (!haserr) {
@@ -2535,7 +2928,7 @@ static int fillViaequallength(GtEncseq *encseq,
       if (widthbuffer < (GtUword) (GT_UNITSIN2BITENC - 1))
         widthbuffer++;
       else {
-        *twobitencodingptr++ = bitwise;
+        STORESEQBUFFER(bitwise, twobitencodingptr);
         widthbuffer = 0;
         bitwise = 0;
       }
@@ -2763,7 +3156,7 @@ static int fillViabitaccess(GtEncseq *encseq,
       if (widthbuffer < (GtUword) (GT_UNITSIN2BITENC - 1))
         widthbuffer++;
       else {
-        *twobitencodingptr++ = bitwise;
+        STORESEQBUFFER(bitwise, twobitencodingptr);
         widthbuffer = 0;
         bitwise = 0;
       }
@@ -3232,11 +3625,11 @@ void gt_specialrangeiterator_reinit_with_startpos(GtSpecialrangeiterator *sri,
   sri->lengthofspecialrange = 0;
   if (sri->esr != NULL)
     gt_encseq_reader_delete(sri->esr);
-    sri->esr = gt_encseq_create_reader_with_readmode(encseq,
-                                                   moveforward
-                                                     ? GT_READMODE_FORWARD
-                                                     : GT_READMODE_REVERSE,
-                                                   startpos);
+  sri->esr = gt_encseq_create_reader_with_readmode(encseq,
+                                                 moveforward
+                                                   ? GT_READMODE_FORWARD
+                                                   : GT_READMODE_REVERSE,
+                                                 startpos);
 
   /* the reader initialization may have changed the direction! so reevaluate. */
   sri->moveforward = !GT_ISDIRREVERSE(sri->esr->readmode);
@@ -4062,6 +4455,7 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
   }
   encseq->satname = gt_encseq_access_type_str(sat);
   encseq->twobitencoding = NULL;
+  encseq->twobitencodingstream = NULL;
   if (sat == GT_ACCESS_TYPE_DIRECTACCESS || sat == GT_ACCESS_TYPE_BYTECOMPRESS)
     encseq->unitsoftwobitencoding = 0;
   else
@@ -4422,7 +4816,8 @@ int gt_encseq_seppos2ssptab(const char *indexname,
 
 #define SIZEOFFUNCTAB sizeof (encodedseqfunctab)/sizeof (encodedseqfunctab[0])
 
-static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
+static GtEncseq *files2encodedsequence(const char *indexname,
+                                       const GtStrArray *filenametab,
                                        const GtFilelengthvalues *filelengthtab,
                                        bool plainformat,
                                        GtUword totallength,
@@ -4445,6 +4840,7 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        GtUword wildcardranges,
                                        GtUword minseqlength,
                                        GtUword maxseqlength,
+                                       GtSequenceBuffer *replay,
                                        GtLogger *logger,
                                        GtError *err)
 {
@@ -4491,7 +4887,13 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
     encseq->subsymbolmap = subsymbolmap;
     encseq->maxsubalphasize = maxsubalphasize;
     gt_assert(filenametab != NULL);
-    if (plainformat) {
+    if (replay != NULL) {
+      /* the symbols recorded while scanning the input are encoded, so the
+         input files are not parsed again */
+      gt_sequence_buffer_replay_rewind(replay);
+      fb = gt_sequence_buffer_ref(replay);
+    }
+    else if (plainformat) {
       fb = gt_sequence_buffer_plain_new(filenametab);
     }
     else {
@@ -4523,18 +4925,39 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        specialcharinfo.exceptioncharacters,
                            true);
     }
+    if (encseq->unitsoftwobitencoding > 0) {
+      /* write the two bit encoding directly to its place in the .esq file
+         instead of keeping it in memory, the remaining components are
+         written by gt_encseq_flush2file() */
+      encseq->twobitencodingstream
+        = gt_fa_fopen_with_suffix(indexname, GT_ENCSEQFILESUFFIX, "wb", err);
+      if (encseq->twobitencodingstream == NULL)
+        haserr = true;
+      else {
+        GtUword offset
+          = gt_mapspec_offset(no_esq_header
+                                ? gt_encseq_assign_sequence_mapspec
+                                : gt_encseq_assign_mapspec,
+                              encseq, &encseq->twobitencoding);
+        gt_xfseek(encseq->twobitencodingstream, (GtWord) offset, SEEK_SET);
+      }
+    }
+  }
+  if (!haserr) {
     gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
     if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
                                                            ssptaboutinfo,
                                                            fb, err) != 0)
       haserr = true;
-    ssptaboutinfo_delete(ssptaboutinfo);
   }
+  ssptaboutinfo_delete(ssptaboutinfo);
 #ifdef GT_RANGEDEBUG
   if (!haserr)
     showallSWtables(encseq);
 #endif
   if (haserr && encseq != NULL) {
+    gt_fa_xfclose(encseq->twobitencodingstream);
+    encseq->twobitencodingstream = NULL;
     gt_encseq_delete(encseq);
     encseq = NULL;
   }
@@ -5341,6 +5764,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *minseqlen,
                                            GtUword *maxseqlen,
                                            bool clip_desc,
+                                           GtSequenceBuffer *replay,
                                            GtLogger *logger,
                                            GtError *err)
 {
@@ -5412,6 +5836,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
     if (descqueue != NULL)
       gt_sequence_buffer_set_desc_buffer(fb, descqueue);
     gt_sequence_buffer_set_chardisttab(fb, characterdistribution);
+    gt_sequence_buffer_set_recorder(fb, replay);
     distspecialrangelength = gt_disc_distri_new();
     distwildcardrangelength = gt_disc_distri_new();
     originaldistribution = gt_calloc((size_t) UCHAR_MAX,
@@ -7434,6 +7859,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                       length and no WILDCARD appears in the
                                       sequence */
   GtEncseqAccessType sat = GT_ACCESS_TYPE_UNDEFINED;
+  GtSequenceBuffer *replay = NULL;
   char *allchars = NULL,
        *maxchars = NULL;
 
@@ -7471,6 +7897,15 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     classstartpositions = gt_calloc((size_t) UCHAR_MAX,
                                     sizeof (*classstartpositions));
     memset(&subsymbolmap, 0, ((size_t) UCHAR_MAX+1) * sizeof (unsigned char));
+    /* The access type and the sizes of the tables preceding the two bit
+       encoding in the .esq file are only known after the input has been
+       scanned. So the encoded symbols are recorded during the scan and
+       encoded from the recording afterwards. Only the exception table needs
+       the original characters, in this case the input is read again. */
+    if (!outoistab) {
+      replay
+        = gt_sequence_buffer_replay_new(gt_alphabet_num_of_chars(alphabet));
+    }
     if (gt_inputfiles2sequencekeyvalues(indexname,
                                         &totallength,
                                         &specialcharinfo,
@@ -7498,6 +7933,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                         &minseqlen,
                                         &maxseqlen,
                                         clip_desc,
+                                        replay,
                                         logger,
                                         err) != 0) {
       char buf[BUFSIZ];
@@ -7539,7 +7975,8 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
       sat = (GtEncseqAccessType) retcode;
   }
   if (!haserr) {
-    encseq = files2encodedsequence(filenametab,
+    encseq = files2encodedsequence(indexname,
+                                   filenametab,
                                    filelengthtab,
                                    isplain,
                                    totallength,
@@ -7562,11 +7999,13 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                    wildcardranges,
                                    minseqlen,
                                    maxseqlen,
+                                   replay,
                                    logger,
                                    err);
     if (encseq == NULL)
       haserr = true;
   }
+  gt_sequence_buffer_delete(replay);
   if (!haserr) {
     alphabetisbound = true;
     if (gt_encseq_flush2file(indexname, encseq, esq_no_header, err) != 0)
@@ -9052,6 +9491,46 @@ GtEncseq* gt_encseq_builder_build(GtEncseqBuilder *eb, GT_UNUSED GtError *err)
   return encseq;
 }
 
+int gt_encseq_unpack_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtAlphabet *alpha;
+  GtEncseqUnpacktable table;
+  GtTwobitencoding tbe[64];
+  GtEncseqUnpackFunc unpack;
+  char result[64 * GT_UNITSIN2BITENC], expected[64 * GT_UNITSIN2BITENC];
+  const GtUword totallength = 64 * GT_UNITSIN2BITENC;
+  GtUword idx, trial;
+  gt_error_check(err);
+
+  alpha = gt_alphabet_new_dna();
+  gt_encseq_unpacktable_init(&table, alpha, false);
+  for (idx = 0; idx < 64UL; idx++) {
+    size_t byte;
+    tbe[idx] = 0;
+    for (byte = 0; byte < sizeof (GtTwobitencoding); byte++) {
+      tbe[idx] = (tbe[idx] << 8) | (GtTwobitencoding) gt_rand_max(255UL);
+    }
+  }
+  for (idx = 0; idx < totallength; idx++) {
+    expected[idx] = table.chars[(tbe[GT_DIVBYUNITSIN2BITENC(idx)] >>
+                                 GT_MULT2(GT_UNITSIN2BITENC - 1 -
+                                          GT_MODBYUNITSIN2BITENC(idx))) & 3];
+  }
+  unpack = gt_encseq_unpack_func();
+  for (trial = 0; !had_err && trial < 1000UL; trial++) {
+    GtUword pos = gt_rand_max(totallength - 1),
+            len = gt_rand_max(totallength - pos);
+
+    gt_encseq_unpack_generic(result, tbe, &table, pos, len);
+    gt_ensure(memcmp(result, expected + pos, (size_t) len) == 0);
+    unpack(result, tbe, &table, pos, len);
+    gt_ensure(memcmp(result, expected + pos, (size_t) len) == 0);
+  }
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
+
 int gt_encseq_builder_unit_test(GtError *err)
 {
   int had_err = 0;
@@ -505,6 +505,8 @@ void gt_GtSpecialcharinfo_check(const GtSpecialcharinfo *specialcharinfo,
 
 int gt_encseq_builder_unit_test(GtError *err);
 
+int gt_encseq_unpack_unit_test(GtError *err);
+
 /* The following function should only be used for test purposes, because it
   is not efficient. It compares the two suffixes
   at position <start1> and <start2> in <encseq>.  <esr1> and <esr2> refer
@@ -124,6 +124,16 @@ void              gt_encseq_extract_decoded(const GtEncseq *encseq,
                                             char *buffer,
                                             GtUword frompos,
                                             GtUword topos);
+/* Returns the decoded version of the substring from position <frompos>
+   to position <topos> of <encseq>, read in direction <readmode>. The
+   substring is split into parts which are decoded in parallel by <gt_jobs>
+   threads, each with its own <GtEncseqReader>, into the corresponding
+   slices of <buffer>, which must be large enough to hold the result. */
+void              gt_encseq_extract_decoded_parallel(const GtEncseq *encseq,
+                                                     char *buffer,
+                                                     GtReadmode readmode,
+                                                     GtUword frompos,
+                                                     GtUword topos);
 /* Returns the length of the <seqnum>-th sequence in the <encseq>.
    Requires multiple sequence support enabled in <encseq>. */
 GtUword     gt_encseq_seqlength(const GtEncseq *encseq,
@@ -25,6 +25,7 @@
   implementation detail.
 */
 
+#include <stdio.h>
 #include "core/alphabet.h"
 #include "core/bitpackarray.h"
 #include "core/chardef.h"
@@ -182,6 +183,12 @@ struct GtEncseq
               GT_ACCESS_TYPE_UINT32TABLES */
   GtTwobitencoding *twobitencoding;
   GtUword unitsoftwobitencoding;
+  /* only while encoding files: if not NULL, <twobitencoding> is a buffer of
+     <twobitencodingbufferunits> units, which is appended to this file
+     whenever it is full */
+  FILE *twobitencodingstream;
+  GtUword twobitencodingbufferunits,
+          twobitencodingwrittenunits;
 
   /* only for  GT_ACCESS_TYPE_DIRECTACCESS */
   GtUchar *plainseq;
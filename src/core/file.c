@@ -17,6 +17,7 @@
 
 #include <stdio.h>
 #include <string.h>
+#include "core/bgzf.h"
 #include "core/cstr_api.h"
 #include "core/fa.h"
 #include "core/ma.h"
@@ -30,6 +31,7 @@ struct GtFile {
     FILE *file;
     gzFile gzfile;
     BZFILE *bzfile;
+    GtBgzf *bgzf;
   } fileptr;
   char *orig_path,
        *orig_mode,
@@ -57,6 +59,7 @@ const char* gt_file_mode_suffix(GtFileMode mode)
     case GT_FILE_MODE_UNCOMPRESSED:
       return "";
     case GT_FILE_MODE_GZIP:
+    case GT_FILE_MODE_BGZF:
       return ".gz";
     case GT_FILE_MODE_BZIP2:
       return ".bz2";
@@ -123,6 +126,13 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
         file->orig_path = gt_cstr_dup(path);
         file->orig_mode = gt_cstr_dup(path);
         break;
+      case GT_FILE_MODE_BGZF:
+        file->fileptr.bgzf = gt_bgzf_open(path, mode, err);
+        if (!file->fileptr.bgzf) {
+          gt_file_delete_without_handle(file);
+          return NULL;
+        }
+        break;
       default: gt_assert(0);
     }
   }
@@ -154,6 +164,15 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         file->orig_path = gt_cstr_dup(path);
         file->orig_mode = gt_cstr_dup(path);
         break;
+      case GT_FILE_MODE_BGZF: {
+        GtError *err = gt_error_new();
+        if (!(file->fileptr.bgzf = gt_bgzf_open(path, mode, err))) {
+          fprintf(stderr, "%s\n", gt_error_get(err));
+          exit(EXIT_FAILURE);
+        }
+        gt_error_delete(err);
+        break;
+      }
       default: gt_assert(0);
     }
   }
@@ -206,6 +225,9 @@ int gt_file_xfgetc(GtFile *file)
         case GT_FILE_MODE_BZIP2:
           c = gt_xbzfgetc(file->fileptr.bzfile);
           break;
+        case GT_FILE_MODE_BGZF:
+          c = gt_bgzf_xfgetc(file->fileptr.bgzf);
+          break;
         default: gt_assert(0);
       }
     }
@@ -215,6 +237,20 @@ int gt_file_xfgetc(GtFile *file)
   return c;
 }
 
+GtUint64 gt_file_bgzf_tell(const GtFile *file)
+{
+  gt_assert(file && file->mode == GT_FILE_MODE_BGZF && !file->unget_used);
+  return gt_bgzf_tell(file->fileptr.bgzf);
+}
+
+int gt_file_bgzf_seek(GtFile *file, GtUint64 voffset, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(file && file->mode == GT_FILE_MODE_BGZF);
+  file->unget_used = false;
+  return gt_bgzf_seek(file->fileptr.bgzf, voffset, err);
+}
+
 void gt_file_unget_char(GtFile *file, char c)
 {
   if (file) {
@@ -273,6 +309,30 @@ static int vbzprintf(BZFILE *file, const char *format, va_list va, int buflen)
   return 0; /* success */
 }
 
+static int vbgzfprintf(GtBgzf *bgzf, const char *format, va_list va,
+                       int buflen)
+{
+  int len;
+  if (!buflen) {
+    char buf[BUFSIZ];
+    /* no buffer length given -> try static buffer */
+    len = gt_xvsnprintf(buf, sizeof (buf), format, va);
+    if (len >= BUFSIZ)
+      return len; /* unsuccessful trial -> return buffer length for next call */
+    gt_bgzf_xwrite(bgzf, buf, len);
+  }
+  else {
+    char *dynbuf;
+    /* buffer length given -> use dynamic buffer */
+    dynbuf = gt_malloc((buflen + 1) * sizeof (char));
+    len = gt_xvsnprintf(dynbuf, (buflen + 1) * sizeof (char), format, va);
+    gt_assert(len == buflen);
+    gt_bgzf_xwrite(bgzf, dynbuf, buflen);
+    gt_free(dynbuf);
+  }
+  return 0; /* success */
+}
+
 static int xvprintf(GtFile *file, const char *format, va_list va, int buflen)
 {
   int rval = 0;
@@ -290,6 +350,9 @@ static int xvprintf(GtFile *file, const char *format, va_list va, int buflen)
       case GT_FILE_MODE_BZIP2:
         rval = vbzprintf(file->fileptr.bzfile, format, va, buflen);
         break;
+      case GT_FILE_MODE_BGZF:
+        rval = vbgzfprintf(file->fileptr.bgzf, format, va, buflen);
+        break;
       default: gt_assert(0);
     }
   }
@@ -328,6 +391,11 @@ void gt_file_xfputc(int c, GtFile *file)
     case GT_FILE_MODE_BZIP2:
       gt_xbzfputc(c, file->fileptr.bzfile);
       break;
+    case GT_FILE_MODE_BGZF: {
+      char cc = (char) c;
+      gt_bgzf_xwrite(file->fileptr.bgzf, &cc, 1);
+      break;
+    }
     default: gt_assert(0);
   }
 }
@@ -346,6 +414,9 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
     case GT_FILE_MODE_BZIP2:
       gt_xbzfputs(cstr, file->fileptr.bzfile);
       break;
+    case GT_FILE_MODE_BGZF:
+      gt_bgzf_xwrite(file->fileptr.bgzf, cstr, strlen(cstr));
+      break;
     default: gt_assert(0);
   }
 }
@@ -364,6 +435,9 @@ int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
       case GT_FILE_MODE_BZIP2:
         rval = gt_xbzread(file->fileptr.bzfile, buf, nbytes);
         break;
+      case GT_FILE_MODE_BGZF:
+        rval = (int) gt_bgzf_xread(file->fileptr.bgzf, buf, nbytes);
+        break;
       default: gt_assert(0);
     }
   }
@@ -388,6 +462,9 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
     case GT_FILE_MODE_BZIP2:
       gt_xbzwrite(file->fileptr.bzfile, buf, nbytes);
       break;
+    case GT_FILE_MODE_BGZF:
+      gt_bgzf_xwrite(file->fileptr.bgzf, buf, nbytes);
+      break;
     default: gt_assert(0);
   }
 }
@@ -405,6 +482,9 @@ void gt_file_xrewind(GtFile *file)
     case GT_FILE_MODE_BZIP2:
       gt_xbzrewind(&file->fileptr.bzfile, file->orig_path, file->orig_mode);
       break;
+    case GT_FILE_MODE_BGZF:
+      gt_bgzf_xrewind(file->fileptr.bgzf);
+      break;
     default: gt_assert(0);
   }
 }
@@ -431,6 +511,9 @@ void gt_file_delete(GtFile *file)
     case GT_FILE_MODE_BZIP2:
         gt_fa_bzclose(file->fileptr.bzfile);
       break;
+    case GT_FILE_MODE_BGZF:
+        gt_bgzf_close(file->fileptr.bgzf);
+      break;
     default: gt_assert(0);
   }
   gt_file_delete_without_handle(file);
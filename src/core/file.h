@@ -20,11 +20,13 @@
 
 #include <stdlib.h>
 #include "core/file_api.h"
+#include "core/types_api.h"
 
 typedef enum {
   GT_FILE_MODE_UNCOMPRESSED,
   GT_FILE_MODE_GZIP,
-  GT_FILE_MODE_BZIP2
+  GT_FILE_MODE_BZIP2,
+  GT_FILE_MODE_BGZF
 } GtFileMode;
 
 /* Returns <GT_FILE_MODE_GZIP> if file with <path> ends with '.gz',
@@ -32,8 +34,8 @@ typedef enum {
    otherwise. */
 GtFileMode  gt_file_mode_determine(const char *path);
 
-/* Returns ".gz" if <mode> is GFM_GZIP, ".bz2" if <mode> is GFM_BZIP2, and ""
-   otherwise. */
+/* Returns ".gz" if <mode> is GFM_GZIP or GT_FILE_MODE_BGZF, ".bz2" if <mode>
+   is GFM_BZIP2, and "" otherwise. */
 const char* gt_file_mode_suffix(GtFileMode mode);
 
 /* Returns the length of the ``basename'' of <path>. That is, the length of path
@@ -63,4 +65,12 @@ GtFileMode  gt_file_mode(const GtFile *file);
    Can only be used once at a time. */
 void        gt_file_unget_char(GtFile *file, char c);
 
+/* Returns the virtual offset of the current position in the BGZF <file> (see
+   <GtBgzf>). No character of <file> must be unget. */
+GtUint64    gt_file_bgzf_tell(const GtFile *file);
+
+/* Moves the current position in the BGZF <file> opened for reading to the
+   virtual offset <voffset>. Returns -1 and sets <err> on error. */
+int         gt_file_bgzf_seek(GtFile *file, GtUint64 voffset, GtError *err);
+
 #endif
@@ -33,9 +33,11 @@
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/showtime.h"
+#include "core/slab.h"
 #include "core/spacepeak.h"
 #include "core/splitter.h"
 #include "core/symbol.h"
+#include "core/thread_pool.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
 #include "core/xansi_api.h"
@@ -115,6 +117,7 @@ void gt_lib_init(void)
   if (showtime) gt_showtime_enable();
   gt_symbol_init();
   gt_class_alloc_lock_init();
+  gt_slab_init();
   gt_ya_rand_init(0);
 #ifdef HAVE_MYSQL
   mysql_library_init(0, NULL, NULL);
@@ -143,8 +146,10 @@ int gt_lib_clean(void)
   }
   fa_fptr_rval = gt_fa_check_fptr_leak();
   fa_mmap_rval = gt_fa_check_mmap_leak();
+  gt_thread_pool_clean();
   gt_fa_clean();
   gt_symbol_clean();
+  gt_slab_clean();
   gt_class_alloc_clean();
   gt_class_alloc_lock_clean();
   gt_ya_rand_clean();
@@ -259,17 +259,16 @@ static void interval_tree_right_rotate(GtIntervalTree *it,
     y->max = y->right->max;
 }
 
+/* recompute the maximal end positions on the path from <x> to the root */
 static void interval_tree_max_fixup(GtIntervalTree *it,
-                                    GtIntervalTreeNode *root,
                                     GtIntervalTreeNode *x)
 {
-  while (x != it->nil && x != root) {
-    if (x->left == it->nil && x->right != it->nil)
-      x->max = x->right->max;
-    else if (x->right == it->nil && x->left != it->nil)
+  while (x != it->nil) {
+    x->max = x->high;
+    if (x->left != it->nil && x->left->max > x->max)
       x->max = x->left->max;
-    else if (x->right != it->nil && x->left != it->nil)
-      x->max = MAX(x->left->max, x->right->max);
+    if (x->right != it->nil && x->right->max > x->max)
+      x->max = x->right->max;
     x = x->parent;
   }
 }
@@ -486,12 +485,16 @@ void gt_interval_tree_remove(GtIntervalTree *it, GtIntervalTreeNode *z)
   }
 
   if (y != z) {
-    z->max = y->max;
+    /* move the successor into <z> and the data of <z> into the node to be
+       deleted, such that the right data gets freed */
+    void *data = z->data;
     z->low = y->low;
     z->high = y->high;
     z->data = y->data;
+    y->data = data;
   }
-  interval_tree_max_fixup(it, it->root, z->parent);
+  /* <z> is an ancestor of <y>, if they differ */
+  interval_tree_max_fixup(it, y->parent);
   if (y->color == BLACK) {
     y->color = z->color;
     interval_tree_delete_fixup(it, x);
@@ -388,7 +388,13 @@ int gt_mapspec_write(GtMapspecSetupFunc setup, FILE *fp,
     showmapspec(mapspecptr);
     printf(" at byteoffset "GT_WU"\n",byteoffset);
 #endif
-    if (mapspecptr->numofunits > 0)
+    if (mapspecptr->numofunits > 0 && *((void **) mapspecptr->startptr)
+                                          == NULL)
+    {
+      /* written separately, see <gt_mapspec_offset()> */
+      gt_xfseek(fp, (GtWord) (mapspecptr->sizeofunit * mapspecptr->numofunits),
+                SEEK_CUR);
+    } else if (mapspecptr->numofunits > 0)
     {
       switch (mapspecptr->typespec)
       {
@@ -471,6 +477,34 @@ int gt_mapspec_write(GtMapspecSetupFunc setup, FILE *fp,
   return had_err;
 }
 
+GtUword gt_mapspec_offset(GtMapspecSetupFunc setup, void *data,
+                          const void *ptr)
+{
+  GtMapspecification *mapspecptr;
+  GtUword byteoffset = 0;
+  GtMapspec *ms = gt_malloc(sizeof (GtMapspec));
+
+  GT_INITARRAY(&ms->mapspectable,GtMapspecification);
+  setup(ms, data, false);
+  for (mapspecptr = ms->mapspectable.spaceGtMapspecification;
+       mapspecptr < ms->mapspectable.spaceGtMapspecification +
+                    ms->mapspectable.nextfreeGtMapspecification &&
+       mapspecptr->startptr != ptr;
+       mapspecptr++)
+  {
+    byteoffset += mapspecptr->sizeofunit * mapspecptr->numofunits;
+    if (byteoffset % (GtUword) GT_WORDSIZE_INBYTES > 0)
+    {
+      byteoffset += GT_WORDSIZE_INBYTES - (byteoffset % GT_WORDSIZE_INBYTES);
+    }
+  }
+  gt_assert(mapspecptr < ms->mapspectable.spaceGtMapspecification +
+                         ms->mapspectable.nextfreeGtMapspecification);
+  GT_FREEARRAY(&ms->mapspectable,GtMapspecification);
+  gt_free(ms);
+  return byteoffset;
+}
+
 #define NEWMAPSPEC(MS,PTR,TYPE,SIZE,ELEMS)\
         GT_GETNEXTFREEINARRAY(mapspecptr,&MS->mapspectable, \
                               GtMapspecification,10);\
@@ -184,9 +184,17 @@ int  gt_mapspec_read_header(GtMapspecSetupFunc setup, void *data,
 /* Runs <setup> to build the map specification using <data> if given,
    then writes the data at the pointers given in the map specification to the
    file specified by <fp> with the expected file size <expectedsize>.
-   Returns 0 on success, -1 otherwise. <err> is set accordingly. */
+   Components whose pointer is NULL are not written but skipped, such that
+   they can be written separately at the offset given by
+   <gt_mapspec_offset()>. Returns 0 on success, -1 otherwise. <err> is set
+   accordingly. */
 int  gt_mapspec_write(GtMapspecSetupFunc setup, FILE *fp, void *data,
                       GtUword expectedsize, GtError *err);
+/* Runs <setup> in reading mode to build the map specification using <data>
+   and returns the offset in bytes of the component registered with the
+   address <ptr> in a file written by <gt_mapspec_write()>. */
+GtUword gt_mapspec_offset(GtMapspecSetupFunc setup, void *data,
+                          const void *ptr);
 /* Pads file specified by <fp> at position <byteoffset> with zero bytes up to
    the next word boundary. The amount of padding in bytes is written to
    <bytes_written>. Returns 0 on success, -1 otherwise. <err> is set
@@ -14,57 +14,28 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
-#include "core/array_api.h"
 #include "core/multithread_api.h"
+#include "core/thread_pool.h"
 #include "core/unused_api.h"
 
-#ifdef GT_THREADS_ENABLED
-
-int gt_multithread(GtThreadFunc function, void *data, GtError *err)
+int gt_multithread(GtThreadFunc function, void *data, GT_UNUSED GtError *err)
 {
-  GtArray *threads;
-  GtThread *thread;
-  unsigned int i, j;
+  GtThreadPoolGroup *group;
+  unsigned int i;
 
   gt_error_check(err);
   gt_assert(function);
 
-  threads = gt_array_new(sizeof (GtThread*));
-
-  /* start all other threads and store them */
-  for (i = 1; i < gt_jobs; i++) {
-    if (!(thread = gt_thread_new(function, data, err))) {
-      for (j = 0; j < gt_array_size(threads); j++)
-        gt_thread_delete(*(GtThread**) gt_array_get(threads, j));
-      gt_array_delete(threads);
-      return -1;
-    }
-    gt_array_add(threads, thread);
-  }
+  /* hand all other instances to the worker threads of the process-wide pool,
+     without thread support the pool runs them while we are waiting */
+  group = gt_thread_pool_group_new(gt_thread_pool_get());
+  for (i = 1; i < gt_jobs; i++)
+    gt_thread_pool_group_submit(group, function, data);
 
   function(data); /* execute function in main thread, too */
 
-  /* wait until all other threads are finished */
-  for (i = 0; i < gt_array_size(threads); i++) {
-    thread = *(GtThread**) gt_array_get(threads, i);
-    gt_thread_join(thread);
-    gt_thread_delete(thread);
-  }
-  gt_array_delete(threads);
-
-  return 0;
-}
-
-#else
+  /* wait until all other instances are finished */
+  gt_thread_pool_group_delete(group);
 
-int gt_multithread(GtThreadFunc function, void *data, GT_UNUSED GtError *err)
-{
-  unsigned int i;
-  gt_error_check(err);
-  gt_assert(function);
-  for (i = 0; i < gt_jobs; i++)
-    function(data);
   return 0;
 }
-
-#endif
@@ -25,6 +25,7 @@
 struct GtOutputFileInfo {
   GtStr *output_filename;
   bool gzip,
+       bgzip,
        bzip2,
        force;
   GtFile **outfp;
@@ -47,9 +48,12 @@ static int determine_outfp(void *data, GtError *err)
   if (!gt_str_length(ofi->output_filename))
     *ofi->outfp = NULL; /* no output file given -> use stdin */
   else { /* outputfile given -> create generic file pointer */
-    gt_assert(!(ofi->gzip && ofi->bzip2));
+    gt_assert(!(ofi->gzip && ofi->bzip2) && !(ofi->bgzip && ofi->gzip) &&
+              !(ofi->bgzip && ofi->bzip2));
     if (ofi->gzip)
       file_mode = GT_FILE_MODE_GZIP;
+    else if (ofi->bgzip)
+      file_mode = GT_FILE_MODE_BGZF;
     else if (ofi->bzip2)
       file_mode = GT_FILE_MODE_BZIP2;
     else
@@ -83,7 +87,7 @@ static int determine_outfp(void *data, GtError *err)
 void gt_output_file_info_register_options(GtOutputFileInfo *ofi,
                                           GtOptionParser *op, GtFile **outfp)
 {
-  GtOption *opto, *optgzip, *optbzip2, *optforce;
+  GtOption *opto, *optgzip, *optbgzip, *optbzip2, *optforce;
   gt_assert(outfp && ofi);
   ofi->outfp = outfp;
   /* register option -o */
@@ -94,6 +98,11 @@ void gt_output_file_info_register_options(GtOutputFileInfo *ofi,
   optgzip = gt_option_new_bool("gzip", "write gzip compressed output file",
                                &ofi->gzip, false);
   gt_option_parser_add_option(op, optgzip);
+  /* register option -bgzip */
+  optbgzip = gt_option_new_bool("bgzip", "write blocked gzip compressed "
+                                "output file (which can be indexed)",
+                                &ofi->bgzip, false);
+  gt_option_parser_add_option(op, optbgzip);
   /* register option -bzip2 */
   optbzip2 = gt_option_new_bool("bzip2", "write bzip2 compressed output file",
                                 &ofi->bzip2, false);
@@ -103,10 +112,13 @@ void gt_output_file_info_register_options(GtOutputFileInfo *ofi,
                                 "force writing to output file",
                                 &ofi->force, false);
   gt_option_parser_add_option(op, optforce);
-  /* options -gzip and -bzip2 exclude each other */
+  /* options -gzip, -bgzip, and -bzip2 exclude each other */
   gt_option_exclude(optgzip, optbzip2);
+  gt_option_exclude(optgzip, optbgzip);
+  gt_option_exclude(optbgzip, optbzip2);
   /* option implications */
   gt_option_imply(optgzip, opto);
+  gt_option_imply(optbgzip, opto);
   gt_option_imply(optbzip2, opto);
   gt_option_imply(optforce, opto);
   /* set hook function to determine <outfp> */
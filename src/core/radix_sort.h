@@ -70,6 +70,10 @@ GtUword gt_radixsort_max_num_of_entries_ulongpair(size_t memlimit);
 
 void gt_radixsort_inplace_ulong(GtUword *source, GtUword len);
 
+/* sort an array of values of type <GtUlongPair> by component <a> */
+
+void gt_radixsort_inplace_GtUlongPair(GtUlongPair *source, GtUword len);
+
 /* Determine maximum number of entries in an array of type <GtUword>
    such that the given memory limit <memlimit> (in bytes) for the array
    is not exceeded.
@@ -21,12 +21,14 @@
 #include "core/cstr_api.h"
 #include "core/file.h"
 #include "core/filelengthvalues.h"
+#include "core/minmax.h"
 #include "core/seq_iterator_fastq_api.h"
 #include "core/seq_iterator_rep.h"
+#include "core/sequence_buffer.h"
 #include "core/str_array.h"
 #include "core/unused_api.h"
 
-#define GT_SEQIT_QUAL_INBUFSIZE  8192
+#define GT_SEQIT_QUAL_INBUFSIZE  (1 << 20)
 
 struct GtSeqIteratorFastQ
 {
@@ -144,6 +146,17 @@ static int parse_fastq_sequence(GtSeqIteratorFastQ *seqit,
     } else if (currentchar == '\n') {
       seqit->curline++;
     }
+    if (!seqit->use_ungetchar) {
+      /* append the rest of the sequence line in one step */
+      const unsigned char *run = seqit->inbuf + seqit->currentinpos;
+      GtUword runlength
+        = gt_sequence_buffer_scan_symbols(run, seqit->currentfillpos
+                                                 - seqit->currentinpos,
+                                          GT_FASTQ_QUAL_SEPARATOR_CHAR);
+      gt_str_append_cstr_nt(tmp_str, (const char*) run, runlength);
+      seqit->currentinpos += runlength;
+      seqit->currentread += runlength;
+    }
     if ((currentchar = fastq_buf_getchar(seqit)) == EOF) {
       gt_str_delete(tmp_str);
       return EOF;
@@ -225,6 +238,23 @@ static inline int parse_fastq_qualities(GtSeqIteratorFastQ *seqit,
     }
     if (i+1 == gt_str_length(seqit->sequencebuffer)) {
       seqit->curline++;
+    } else if (!seqit->use_ungetchar) {
+      /* append as many of the remaining qualities as possible at once */
+      const unsigned char *run = seqit->inbuf + seqit->currentinpos;
+      GtUword runlength
+        = gt_sequence_buffer_scan_symbols(run,
+                                          MIN(seqit->currentfillpos
+                                                - seqit->currentinpos,
+                                              gt_str_length(seqit
+                                                            ->sequencebuffer)
+                                                - (i+1)),
+                                          0);
+      gt_str_append_cstr_nt(seqit->qualsbuffer, (const char*) run, runlength);
+      seqit->currentinpos += runlength;
+      seqit->currentread += runlength;
+      i += runlength;
+      if (runlength > 0 && i+1 == gt_str_length(seqit->sequencebuffer))
+        seqit->curline++;
     }
     if ((currentchar = fastq_buf_getchar(seqit)) == EOF)
       return EOF;
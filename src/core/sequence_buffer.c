@@ -16,6 +16,7 @@
 */
 
 #include <string.h>
+#include "core/alphabet.h"
 #include "core/ensure.h"
 #include "core/fa.h"
 #include "core/fileutils_api.h"
@@ -25,10 +26,102 @@
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_fastq.h"
 #include "core/sequence_buffer_gb.h"
+#include "core/sequence_buffer_replay.h"
 #include "core/sequence_buffer_inline.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 
+/* number of input characters inspected at once by the scanning and mapping
+   functions below */
+#define SEQUENCE_BUFFER_LANES 16
+
+typedef unsigned char GtSequenceBufferVector
+  __attribute__ ((vector_size (SEQUENCE_BUFFER_LANES)));
+
+static inline bool sequence_buffer_vector_any(GtSequenceBufferVector mask)
+{
+  uint64_t words[SEQUENCE_BUFFER_LANES / sizeof (uint64_t)];
+  memcpy(words, &mask, sizeof (words));
+  return (words[0] | words[1]) != 0;
+}
+
+GtUword gt_sequence_buffer_scan_symbols(const unsigned char *buf, GtUword len,
+                                        unsigned char stopchar)
+{
+  const GtSequenceBufferVector zero = {0},
+                               blank = zero + (unsigned char) ' ',
+                               stop = zero + stopchar;
+  GtUword i = 0;
+
+  gt_assert(buf != NULL || len == 0);
+  while (i + SEQUENCE_BUFFER_LANES <= len) {
+    GtSequenceBufferVector v, mask;
+    memcpy(&v, buf + i, sizeof (v));
+    mask = (GtSequenceBufferVector) (v <= blank);
+    if (stopchar != 0)
+      mask |= (GtSequenceBufferVector) (v == stop);
+    if (sequence_buffer_vector_any(mask))
+      break;
+    i += SEQUENCE_BUFFER_LANES;
+  }
+  while (i < len && buf[i] > (unsigned char) ' '
+           && (stopchar == 0 || buf[i] != stopchar))
+    i++;
+  return i;
+}
+
+int gt_sequence_buffer_process_symbols(GtSequenceBuffer *sb,
+                                       GtUword currentoutpos,
+                                       const unsigned char *buf,
+                                       GtUword len,
+                                       GtError *err)
+{
+  GtSequenceBufferMembers *pvt;
+  const GtSequenceBufferVector zero = {0},
+                               undef = zero + (unsigned char) UNDEFCHAR;
+  unsigned char *out;
+  GtUword i = 0, j;
+
+  gt_error_check(err);
+  gt_assert(sb && currentoutpos + len <= (GtUword) OUTBUFSIZE);
+  pvt = sb->pvt;
+  out = pvt->outbuf + currentoutpos;
+  if (pvt->symbolmap == NULL) {
+    memcpy(out, buf, (size_t) len);
+    memcpy(pvt->outbuforig + currentoutpos, buf, (size_t) len);
+    pvt->counter += (GtUint64) len;
+    return 0;
+  }
+  while (i + SEQUENCE_BUFFER_LANES <= len) {
+    GtSequenceBufferVector codes;
+    for (j = 0; j < (GtUword) SEQUENCE_BUFFER_LANES; j++)
+      out[i + j] = pvt->symbolmap[buf[i + j]];
+    memcpy(&codes, out + i, sizeof (codes));
+    if (sequence_buffer_vector_any((GtSequenceBufferVector) (codes >= undef))) {
+      /* wildcards or illegal characters, handle them one by one */
+      for (j = 0; j < (GtUword) SEQUENCE_BUFFER_LANES; j++) {
+        if (process_char(sb, currentoutpos + i + j, buf[i + j], err) != 0)
+          return -1;
+      }
+    } else {
+      memcpy(pvt->outbuforig + currentoutpos + i, buf + i,
+             (size_t) SEQUENCE_BUFFER_LANES);
+      if (pvt->chardisttab != NULL) {
+        for (j = 0; j < (GtUword) SEQUENCE_BUFFER_LANES; j++)
+          pvt->chardisttab[out[i + j]]++;
+      }
+      pvt->lastspeciallength = 0;
+      pvt->counter += (GtUint64) SEQUENCE_BUFFER_LANES;
+    }
+    i += SEQUENCE_BUFFER_LANES;
+  }
+  for (/* Nothing */; i < len; i++) {
+    if (process_char(sb, currentoutpos + i, buf[i], err) != 0)
+      return -1;
+  }
+  return 0;
+}
+
 GtSequenceBuffer*
 gt_sequence_buffer_create(const GtSequenceBufferClass *sic)
 {
@@ -141,6 +234,13 @@ void gt_sequence_buffer_set_chardisttab(GtSequenceBuffer *si,
   si->pvt->chardisttab = chardisttab;
 }
 
+void gt_sequence_buffer_set_recorder(GtSequenceBuffer *si,
+                                     GtSequenceBuffer *recorder)
+{
+  gt_assert(si && si->pvt);
+  si->pvt->recorder = recorder;
+}
+
 const GtUint64*
 gt_sequence_buffer_get_counter(const GtSequenceBuffer *si)
 {
@@ -150,8 +250,13 @@ gt_sequence_buffer_get_counter(const GtSequenceBuffer *si)
 
 int gt_sequence_buffer_advance(GtSequenceBuffer *sb, GtError *err)
 {
+  int had_err;
   gt_assert(sb && sb->c_class && sb->c_class->advance);
-  return sb->c_class->advance(sb, err);
+  had_err = sb->c_class->advance(sb, err);
+  if (!had_err && sb->pvt->recorder != NULL && sb->pvt->nextfree > 0)
+    gt_sequence_buffer_replay_add(sb->pvt->recorder, sb->pvt->outbuf,
+                                  sb->pvt->nextfree);
+  return had_err;
 }
 
 int gt_sequence_buffer_next(GtSequenceBuffer *sb, GtUchar *val,
@@ -211,6 +316,236 @@ int gt_sequence_buffer_next_with_original(GtSequenceBuffer *sb,
   return 1;
 }
 
+static int sequence_buffer_scan_symbols_test(GtError *err)
+{
+  const unsigned char stops[] = {' ', '\n', '\r', '\t', '\v', '\0', 0x01};
+  unsigned char buf[3 * SEQUENCE_BUFFER_LANES + 5];
+  GtUword len = (GtUword) sizeof (buf), pos, i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  memset(buf, 'a', sizeof (buf));
+  gt_ensure(gt_sequence_buffer_scan_symbols(NULL, 0, 0) == 0);
+  for (i = 0; !had_err && i <= len; i++)
+    gt_ensure(gt_sequence_buffer_scan_symbols(buf, i, '>') == i);
+
+  /* a single stop at each position, inside and between the blocks */
+  for (pos = 0; !had_err && pos < len; pos++) {
+    for (i = 0; !had_err && i < sizeof (stops); i++) {
+      buf[pos] = stops[i];
+      gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, '>') == pos);
+      gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, 0) == pos);
+    }
+    buf[pos] = '>';
+    gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, '>') == pos);
+    gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, '@') == len);
+    gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, 0) == len);
+    /* characters beyond ASCII are no stops */
+    buf[pos] = (unsigned char) 0xe9;
+    gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, '>') == len);
+    buf[pos] = 'a';
+  }
+
+  /* the first of several stops ends the run */
+  buf[SEQUENCE_BUFFER_LANES + 9] = '\n';
+  buf[SEQUENCE_BUFFER_LANES + 3] = '>';
+  buf[2 * SEQUENCE_BUFFER_LANES + 1] = ' ';
+  gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, '>')
+              == (GtUword) SEQUENCE_BUFFER_LANES + 3);
+  gt_ensure(gt_sequence_buffer_scan_symbols(buf, len, 0)
+              == (GtUword) SEQUENCE_BUFFER_LANES + 9);
+  return had_err;
+}
+
+/* processes <buf> with gt_sequence_buffer_process_symbols() in <sb> and
+   character by character in <ref>, and compares the outcome */
+static int sequence_buffer_compare_symbols(GtSequenceBuffer *sb,
+                                           GtSequenceBuffer *ref,
+                                           GtUword currentoutpos,
+                                           const unsigned char *buf,
+                                           GtUword len, GtError *err)
+{
+  GtSequenceBufferMembers *pvt = sb->pvt, *refpvt = ref->pvt;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_ensure(gt_sequence_buffer_process_symbols(sb, currentoutpos, buf, len,
+                                               err) == 0);
+  for (i = 0; !had_err && i < len; i++)
+    gt_ensure(process_char(ref, currentoutpos + i, buf[i], err) == 0);
+  gt_ensure(memcmp(pvt->outbuf + currentoutpos,
+                   refpvt->outbuf + currentoutpos, (size_t) len) == 0);
+  gt_ensure(memcmp(pvt->outbuforig + currentoutpos, buf, (size_t) len) == 0);
+  gt_ensure(pvt->counter == refpvt->counter);
+  gt_ensure(pvt->lastspeciallength == refpvt->lastspeciallength);
+  if (pvt->chardisttab != NULL) {
+    for (i = 0; !had_err && i < 4UL; i++)
+      gt_ensure(pvt->chardisttab[i] == refpvt->chardisttab[i]);
+  }
+  return had_err;
+}
+
+static int sequence_buffer_process_symbols_test(GtError *err)
+{
+  const GtUword offsets[] = {0, 3UL, OUTBUFSIZE - 3 * SEQUENCE_BUFFER_LANES
+                                                - 5};
+  unsigned char buf[3 * SEQUENCE_BUFFER_LANES + 5];
+  GtUword len = (GtUword) sizeof (buf), chardist[4] = {0},
+          refchardist[4] = {0}, o, pos, i;
+  GtSequenceBuffer *sb, *ref;
+  GtStrArray *files;
+  GtAlphabet *alpha;
+  GtError *testerr;
+  int had_err = 0;
+
+  gt_error_check(err);
+  files = gt_str_array_new();
+  gt_str_array_add_cstr(files, "test.fas");
+  alpha = gt_alphabet_new_dna();
+  testerr = gt_error_new();
+  sb = gt_sequence_buffer_fasta_new(files);
+  ref = gt_sequence_buffer_fasta_new(files);
+  gt_sequence_buffer_set_symbolmap(sb, gt_alphabet_symbolmap(alpha));
+  gt_sequence_buffer_set_symbolmap(ref, gt_alphabet_symbolmap(alpha));
+  gt_sequence_buffer_set_chardisttab(sb, chardist);
+  gt_sequence_buffer_set_chardisttab(ref, refchardist);
+
+  for (o = 0; !had_err && o < sizeof (offsets) / sizeof (offsets[0]); o++) {
+    /* no wildcard, a wildcard at each position of the blocks and of the
+       rest, and runs of wildcards at the end of the input */
+    for (pos = 0; !had_err && pos <= len; pos++) {
+      for (i = 0; i < len; i++)
+        buf[i] = (unsigned char) "acgtACGTtgca"[i % 12];
+      if (pos < len)
+        buf[pos] = (unsigned char) (pos % 2 == 0 ? 'n' : 'N');
+      had_err = sequence_buffer_compare_symbols(sb, ref, offsets[o], buf, len,
+                                                err);
+      if (!had_err && pos + SEQUENCE_BUFFER_LANES > len && pos < len) {
+        memset(buf + pos, 'n', (size_t) (len - pos));
+        had_err = sequence_buffer_compare_symbols(sb, ref, offsets[o], buf,
+                                                  len, err);
+        gt_ensure(sb->pvt->lastspeciallength > 0);
+      }
+    }
+  }
+
+  /* illegal characters inside and after the blocks */
+  for (o = 0; !had_err && o < sizeof (offsets) / sizeof (offsets[0]); o++) {
+    for (pos = 0; !had_err && pos < len; pos++) {
+      memset(buf, 'a', sizeof (buf));
+      buf[pos] = '!';
+      gt_ensure(gt_sequence_buffer_process_symbols(sb, offsets[o], buf, len,
+                                                   testerr) == -1);
+      gt_ensure(gt_error_is_set(testerr));
+      gt_ensure(strstr(gt_error_get(testerr), "illegal character '!'")
+                  != NULL);
+      gt_error_unset(testerr);
+    }
+  }
+
+  /* without symbol map, the input is copied; the failed calls above have
+     counted the blocks before the illegal characters in <sb> only */
+  if (!had_err) {
+    gt_sequence_buffer_set_symbolmap(sb, NULL);
+    gt_sequence_buffer_set_symbolmap(ref, NULL);
+    gt_sequence_buffer_set_chardisttab(sb, NULL);
+    gt_sequence_buffer_set_chardisttab(ref, NULL);
+    sb->pvt->counter = ref->pvt->counter;
+    sb->pvt->lastspeciallength = ref->pvt->lastspeciallength;
+    memcpy(buf, "acgt!nNx", (size_t) 8);
+    had_err = sequence_buffer_compare_symbols(sb, ref, 0, buf, len, err);
+    gt_ensure(memcmp(sb->pvt->outbuf, buf, sizeof (buf)) == 0);
+  }
+
+  gt_sequence_buffer_delete(sb);
+  gt_sequence_buffer_delete(ref);
+  gt_error_delete(testerr);
+  gt_alphabet_delete(alpha);
+  gt_str_array_delete(files);
+  return had_err;
+}
+
+/* the <k>-th character of the sequences read by
+   sequence_buffer_read_test(), with wildcards from time to time */
+static char sequence_buffer_test_char(GtUword k)
+{
+  return k % 1237UL < 5UL ? 'n' : "acgt"[k % 4];
+}
+
+/* Writes sequences of the given <lengths> to a FASTA (with lines of 60
+   characters) or FASTQ file, reads it back with a sequence buffer and checks
+   every character and the file length values. */
+static int sequence_buffer_read_test(const GtUword *lengths,
+                                     GtUword numofseqs, bool fastq,
+                                     GtError *err)
+{
+  GtSequenceBuffer *sb;
+  GtFilelengthvalues filelength = {0, 0};
+  GtStrArray *files;
+  GtStr *tmpfilename;
+  GtAlphabet *alpha;
+  const GtUchar *symbolmap;
+  GtUword s, k, numofchars = 0;
+  GtUchar val;
+  char orig;
+  FILE *tmpfp;
+  int had_err = 0, rval;
+
+  gt_error_check(err);
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  for (s = 0; s < numofseqs; s++) {
+    fprintf(tmpfp, "%cseq"GT_WU"\n", fastq ? '@' : '>', s);
+    for (k = 0; k < lengths[s]; k++) {
+      gt_xfputc(sequence_buffer_test_char(k), tmpfp);
+      if (!fastq && (k % 60UL == 59UL || k + 1 == lengths[s]))
+        gt_xfputc('\n', tmpfp);
+    }
+    if (fastq) {
+      fprintf(tmpfp, "\n+\n");
+      for (k = 0; k < lengths[s]; k++)
+        gt_xfputc('I', tmpfp);
+      gt_xfputc('\n', tmpfp);
+    }
+  }
+  gt_fa_xfclose(tmpfp);
+  files = gt_str_array_new();
+  gt_str_array_add(files, tmpfilename);
+  alpha = gt_alphabet_new_dna();
+  symbolmap = gt_alphabet_symbolmap(alpha);
+  sb = fastq ? gt_sequence_buffer_fastq_new(files)
+             : gt_sequence_buffer_fasta_new(files);
+  gt_sequence_buffer_set_symbolmap(sb, symbolmap);
+  gt_sequence_buffer_set_filelengthtab(sb, &filelength);
+
+  for (s = 0; !had_err && s < numofseqs; s++) {
+    if (s > 0) {
+      rval = gt_sequence_buffer_next_with_original(sb, &val, &orig, err);
+      gt_ensure(rval == 1 && val == (GtUchar) SEPARATOR);
+      numofchars++;
+    }
+    for (k = 0; !had_err && k < lengths[s]; k++) {
+      rval = gt_sequence_buffer_next_with_original(sb, &val, &orig, err);
+      gt_ensure(rval == 1);
+      gt_ensure(orig == sequence_buffer_test_char(k));
+      gt_ensure(val == symbolmap[(int) sequence_buffer_test_char(k)]);
+      numofchars++;
+    }
+  }
+  if (!had_err) {
+    gt_ensure(gt_sequence_buffer_next(sb, &val, err) == 0);
+    gt_ensure(filelength.effectivelength == (uint64_t) numofchars);
+  }
+
+  gt_sequence_buffer_delete(sb);
+  gt_alphabet_delete(alpha);
+  gt_str_array_delete(files);
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
+
 int gt_sequence_buffer_unit_test(GtError *err)
 {
   int had_err = 0;
@@ -256,5 +591,20 @@ int gt_sequence_buffer_unit_test(GtError *err)
   }
   gt_str_array_delete(testfiles);
 
+  if (!had_err)
+    had_err = sequence_buffer_scan_symbols_test(err);
+  if (!had_err)
+    had_err = sequence_buffer_process_symbols_test(err);
+  if (!had_err) {
+    /* runs crossing the end of the output buffer; in FASTQ files, the reads
+       which do not fit are kept in the overflow buffer, and separators
+       following a read ending at the end of the buffer are carried over */
+    const GtUword lengths[] = {OUTBUFSIZE, 1000UL, OUTBUFSIZE + 17UL, 1UL,
+                               OUTBUFSIZE - 1000UL, 33UL};
+    GtUword numofseqs = (GtUword) (sizeof (lengths) / sizeof (lengths[0]));
+    had_err = sequence_buffer_read_test(lengths, numofseqs, false, err);
+    if (!had_err)
+      had_err = sequence_buffer_read_test(lengths, numofseqs, true, err);
+  }
   return had_err;
 }
@@ -87,6 +87,12 @@ void          gt_sequence_buffer_set_desc_buffer(GtSequenceBuffer *si,
 void          gt_sequence_buffer_set_chardisttab(GtSequenceBuffer*,
                                                  GtUword*);
 
+/* Assigns a <GtSequenceBufferReplay> to which all encoded symbols read from
+   the sequence iterator are appended.
+   Set to NULL to disable recording (default). */
+void          gt_sequence_buffer_set_recorder(GtSequenceBuffer*,
+                                              GtSequenceBuffer*);
+
 /* Returns the length of the last processed continuous stretch of special
    characters (wildcards or separators, see chardef.h). */
 uint64_t      gt_sequence_buffer_get_lastspeciallength(const GtSequenceBuffer*);
@@ -96,6 +102,15 @@ uint64_t      gt_sequence_buffer_get_lastspeciallength(const GtSequenceBuffer*);
 const GtUint64*
               gt_sequence_buffer_get_counter(const GtSequenceBuffer *si);
 
+/* Returns the length of the longest prefix of the <len> characters in <buf>
+   containing neither white space, control characters nor <stopchar> (which is
+   ignored if it is 0), that is, the number of characters which can be
+   treated as sequence data without looking at them one by one. The input is
+   scanned in blocks of 16 characters. */
+GtUword       gt_sequence_buffer_scan_symbols(const unsigned char *buf,
+                                              GtUword len,
+                                              unsigned char stopchar);
+
 void          gt_sequence_buffer_delete(GtSequenceBuffer*);
 
 int           gt_sequence_buffer_unit_test(GtError*);
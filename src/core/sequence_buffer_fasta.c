@@ -19,7 +19,9 @@
 #ifndef S_SPLINT_S
 #include <ctype.h>
 #endif
+#include <string.h>
 #include "core/cstr_api.h"
+#include "core/minmax.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_rep.h"
 #include "core/sequence_buffer_inline.h"
@@ -84,6 +86,50 @@ static int gt_sequence_buffer_fasta_advance(GtSequenceBuffer *sb, GtError *err)
       pvt->currentfillpos = 0;
     } else
     {
+      if (!pvt->use_ungetchar && pvt->currentinpos < pvt->currentfillpos)
+      {
+        /* process runs of description or sequence characters within the
+           input buffer as a whole */
+        const unsigned char *run = pvt->inbuf + pvt->currentinpos;
+        GtUword idx, runlength,
+                available = pvt->currentfillpos - pvt->currentinpos;
+
+        if (sbf->indesc)
+        {
+          const unsigned char *newline = memchr(run, NEWLINESYMBOL,
+                                                (size_t) available);
+          runlength = newline == NULL ? available : (GtUword) (newline - run);
+          if (pvt->descptr != NULL)
+          {
+            for (idx = 0; idx < runlength; idx++)
+            {
+              if (run[idx] != CRSYMBOL)
+                gt_desc_buffer_append_char(pvt->descptr, run[idx]);
+            }
+          }
+        } else
+        {
+          runlength = gt_sequence_buffer_scan_symbols(run,
+                                            MIN(available,
+                                                OUTBUFSIZE - currentoutpos),
+                                            FASTASEPARATOR);
+          if (runlength > 0)
+          {
+            if ((ret = gt_sequence_buffer_process_symbols(sb, currentoutpos,
+                                                          run, runlength,
+                                                          err)))
+              return ret;
+            currentoutpos += runlength;
+            currentfileadd += runlength;
+          }
+        }
+        if (runlength > 0)
+        {
+          pvt->currentinpos += runlength;
+          currentfileread += runlength;
+          continue;
+        }
+      }
       currentchar = inlinebuf_getchar(sb, pvt->inputstream);
       if (currentchar == EOF)
       {
@@ -65,7 +65,6 @@ static int gt_sequence_buffer_fastq_advance(GtSequenceBuffer *sb, GtError *err)
      if so, we need to provide an additional separator! */
   if (sbfq->carryseparator) {
     pvt->outbuf[currentoutpos++] = (GtUchar) SEPARATOR;
-    currentfileread++;
     pvt->lastspeciallength++;
     currentfileadd++;
     sbfq->carryseparator = false;
@@ -85,8 +84,8 @@ static int gt_sequence_buffer_fastq_advance(GtSequenceBuffer *sb, GtError *err)
       currentfileread++;
     }
     pvt->outbuf[currentoutpos++] = (GtUchar) SEPARATOR;
-    currentfileread++;
     pvt->lastspeciallength++;
+    currentfileadd++;
     gt_str_reset(sbfq->overflowbuffer);
     gt_assert(gt_str_length(sbfq->overflowbuffer) == 0);
   }
@@ -122,17 +121,20 @@ static int gt_sequence_buffer_fastq_advance(GtSequenceBuffer *sb, GtError *err)
       break;
     }
 
-    /* copy sequence */
-    for (cnt=0;cnt<seqlen;cnt++) {
-      if (currentoutpos >= (GtUword) OUTBUFSIZE) {
-        gt_str_append_char(sbfq->overflowbuffer, seq[cnt]);
-      } else {
-        if ((had_err = process_char(sb, currentoutpos, seq[cnt], err)))
-          return had_err;
-        currentoutpos++;
-        currentfileadd++;
-        currentfileread++;
-      }
+    /* copy sequence, keep what does not fit into the buffer for later */
+    cnt = currentoutpos < (GtUword) OUTBUFSIZE
+            ? MIN(seqlen, (GtUword) OUTBUFSIZE - currentoutpos) : 0;
+    if (cnt > 0) {
+      if ((had_err = gt_sequence_buffer_process_symbols(sb, currentoutpos, seq,
+                                                        cnt, err)))
+        return had_err;
+      currentoutpos += cnt;
+      currentfileadd += cnt;
+      currentfileread += cnt;
+    }
+    if (cnt < seqlen) {
+      gt_str_append_cstr_nt(sbfq->overflowbuffer, (const char*) seq + cnt,
+                            seqlen - cnt);
     }
 
     /* place separator after sequence (or defer) */
@@ -152,8 +154,8 @@ static int gt_sequence_buffer_fastq_advance(GtSequenceBuffer *sb, GtError *err)
 
     /* enqueue description */
     if (pvt->descptr) {
-      int i;
-      for (i = 0; i < strlen(desc); i++) {
+      GtUword i;
+      for (i = 0; i + 1 < desclen; i++) {
         gt_desc_buffer_append_char(pvt->descptr, desc[i]);
       }
       gt_desc_buffer_finish(pvt->descptr);
@@ -26,8 +26,10 @@
 #include "core/sequence_buffer.h"
 #include "core/str_array.h"
 
-#define INBUFSIZE  8192
-#define OUTBUFSIZE 8192
+/* the input is read in large chunks, so that runs of sequence characters
+   usually end within the buffer and can be processed as a whole */
+#define INBUFSIZE  (1 << 20)
+#define OUTBUFSIZE (1 << 16)
 
 struct GtSequenceBufferClass {
   size_t        size;
@@ -65,8 +67,21 @@ struct GtSequenceBufferMembers {
                 outbuf[OUTBUFSIZE],
                 outbuforig[OUTBUFSIZE];
   const unsigned char *symbolmap;
+  GtSequenceBuffer *recorder;
 };
 
+/* Processes the <len> sequence characters in <buf> as process_char() does,
+   storing them in the output buffer of <sb> from position <currentoutpos> on,
+   which must leave room for all of them. Blocks of characters are mapped
+   with the symbol map and only looked at one by one if they contain
+   wildcards or illegal characters. Returns 0 on success, -1 on error (<err>
+   is set). */
+int               gt_sequence_buffer_process_symbols(GtSequenceBuffer *sb,
+                                                     GtUword currentoutpos,
+                                                     const unsigned char *buf,
+                                                     GtUword len,
+                                                     GtError *err);
+
 GtSequenceBuffer* gt_sequence_buffer_create(const GtSequenceBufferClass*);
 void*             gt_sequence_buffer_cast(const GtSequenceBufferClass*,
                                           GtSequenceBuffer*);
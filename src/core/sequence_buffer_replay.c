@@ -0,0 +1,328 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include <string.h>
+#include "core/alphabet.h"
+#include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/sequence_buffer_rep.h"
+#include "core/sequence_buffer_replay.h"
+#include "core/str.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
+
+#define GT_REPLAY_BUFSIZE (1 << 16)
+
+typedef struct {
+  GtUword start,
+          length;
+  GtUchar cc;
+} GtReplaySpecialrange;
+
+struct GtSequenceBufferReplay {
+  const GtSequenceBuffer parent_instance;
+  GtStr *symbolfile,
+        *rangefile;
+  FILE *symbolfp,
+       *rangefp;
+  unsigned int bitspersymbol,
+               shift;
+  unsigned char currentbyte,
+                symbolbuf[GT_REPLAY_BUFSIZE];
+  GtUword nextsymbolbuf,
+          numofsymbolbuf,
+          numofsymbols,
+          position;
+  GtReplaySpecialrange range;
+  bool recording,
+       hasrange;
+};
+
+#define gt_sequence_buffer_replay_cast(SB)\
+        gt_sequence_buffer_cast(gt_sequence_buffer_replay_class(), SB)
+
+static void sequence_buffer_replay_flush(GtSequenceBufferReplay *sbr)
+{
+  if (sbr->nextsymbolbuf > 0) {
+    gt_xfwrite(sbr->symbolbuf, sizeof (*sbr->symbolbuf),
+               (size_t) sbr->nextsymbolbuf, sbr->symbolfp);
+    sbr->nextsymbolbuf = 0;
+  }
+}
+
+static void sequence_buffer_replay_store_byte(GtSequenceBufferReplay *sbr)
+{
+  if (sbr->nextsymbolbuf == (GtUword) GT_REPLAY_BUFSIZE)
+    sequence_buffer_replay_flush(sbr);
+  sbr->symbolbuf[sbr->nextsymbolbuf++] = sbr->currentbyte;
+  sbr->currentbyte = 0;
+  sbr->shift = 0;
+}
+
+void gt_sequence_buffer_replay_add(GtSequenceBuffer *sb,
+                                   const GtUchar *symbols, GtUword len)
+{
+  GtSequenceBufferReplay *sbr = gt_sequence_buffer_replay_cast(sb);
+  GtUword idx;
+  GtUchar cc;
+
+  gt_assert(sbr->recording);
+  for (idx = 0; idx < len; idx++, sbr->numofsymbols++) {
+    /* four symbols of a DNA alphabet filling a whole byte are packed at
+       once */
+    if (sbr->shift == 0 && sbr->bitspersymbol == 2U && idx + 4UL <= len &&
+        (symbols[idx] | symbols[idx+1] | symbols[idx+2] | symbols[idx+3])
+          < (GtUchar) GT_DNAALPHASIZE) {
+      sbr->currentbyte = (unsigned char) (symbols[idx] |
+                                          (symbols[idx+1] << 2) |
+                                          (symbols[idx+2] << 4) |
+                                          (symbols[idx+3] << 6));
+      sequence_buffer_replay_store_byte(sbr);
+      idx += 3;
+      sbr->numofsymbols += 3;
+      continue;
+    }
+    cc = symbols[idx];
+    if (ISSPECIAL(cc)) {
+      if (sbr->hasrange && sbr->range.cc == cc &&
+          sbr->range.start + sbr->range.length == sbr->numofsymbols) {
+        sbr->range.length++;
+      } else {
+        if (sbr->hasrange)
+          gt_xfwrite_one(&sbr->range, sbr->rangefp);
+        sbr->range.start = sbr->numofsymbols;
+        sbr->range.length = 1UL;
+        sbr->range.cc = cc;
+        sbr->hasrange = true;
+      }
+    } else {
+      gt_assert(sbr->bitspersymbol == (unsigned int) CHAR_BIT ||
+                cc < (GtUchar) GT_DNAALPHASIZE);
+      sbr->currentbyte |= (unsigned char) (cc << sbr->shift);
+      sbr->shift += sbr->bitspersymbol;
+      if (sbr->shift == (unsigned int) CHAR_BIT)
+        sequence_buffer_replay_store_byte(sbr);
+    }
+  }
+}
+
+static bool sequence_buffer_replay_next_range(GtSequenceBufferReplay *sbr)
+{
+  return gt_xfread_one(&sbr->range, sbr->rangefp) == (size_t) 1;
+}
+
+void gt_sequence_buffer_replay_rewind(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferReplay *sbr = gt_sequence_buffer_replay_cast(sb);
+
+  gt_assert(sbr->recording);
+  if (sbr->shift > 0)
+    sequence_buffer_replay_store_byte(sbr);
+  sequence_buffer_replay_flush(sbr);
+  if (sbr->hasrange)
+    gt_xfwrite_one(&sbr->range, sbr->rangefp);
+  gt_xfseek(sbr->symbolfp, 0, SEEK_SET);
+  gt_xfseek(sbr->rangefp, 0, SEEK_SET);
+  sbr->recording = false;
+  sbr->position = 0;
+  sbr->nextsymbolbuf = sbr->numofsymbolbuf = 0;
+  sbr->hasrange = sequence_buffer_replay_next_range(sbr);
+  sb->pvt->nextread = sb->pvt->nextfree = 0;
+  sb->pvt->complete = false;
+}
+
+static unsigned char sequence_buffer_replay_next_byte(GtSequenceBufferReplay
+                                                        *sbr)
+{
+  if (sbr->nextsymbolbuf == sbr->numofsymbolbuf) {
+    sbr->numofsymbolbuf = (GtUword) gt_xfread(sbr->symbolbuf,
+                                              sizeof (*sbr->symbolbuf),
+                                              (size_t) GT_REPLAY_BUFSIZE,
+                                              sbr->symbolfp);
+    gt_assert(sbr->numofsymbolbuf > 0);
+    sbr->nextsymbolbuf = 0;
+  }
+  return sbr->symbolbuf[sbr->nextsymbolbuf++];
+}
+
+static int gt_sequence_buffer_replay_advance(GtSequenceBuffer *sb,
+                                             GtError *err)
+{
+  GtSequenceBufferReplay *sbr = gt_sequence_buffer_replay_cast(sb);
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  const unsigned int mask = (1U << sbr->bitspersymbol) - 1;
+  GtUword currentoutpos = 0, len, end;
+
+  gt_error_check(err);
+  gt_assert(!sbr->recording);
+  while (currentoutpos < (GtUword) OUTBUFSIZE &&
+         sbr->position < sbr->numofsymbols) {
+    if (sbr->hasrange && sbr->position >= sbr->range.start) {
+      end = sbr->range.start + sbr->range.length;
+      len = MIN(end - sbr->position, (GtUword) OUTBUFSIZE - currentoutpos);
+      memset(pvt->outbuf + currentoutpos, (int) sbr->range.cc, (size_t) len);
+      currentoutpos += len;
+      sbr->position += len;
+      if (sbr->position == end)
+        sbr->hasrange = sequence_buffer_replay_next_range(sbr);
+    } else {
+      end = sbr->hasrange ? sbr->range.start : sbr->numofsymbols;
+      len = MIN(end - sbr->position, (GtUword) OUTBUFSIZE - currentoutpos);
+      sbr->position += len;
+      end = currentoutpos + len;
+      /* the symbols of whole bytes are unpacked at once */
+      while (currentoutpos < end) {
+        if (sbr->shift == 0) {
+          if (sbr->bitspersymbol == 2U && end - currentoutpos >= 4UL) {
+            unsigned char byte = sequence_buffer_replay_next_byte(sbr);
+            pvt->outbuf[currentoutpos++] = (unsigned char) (byte & 3U);
+            pvt->outbuf[currentoutpos++] = (unsigned char) ((byte >> 2) & 3U);
+            pvt->outbuf[currentoutpos++] = (unsigned char) ((byte >> 4) & 3U);
+            pvt->outbuf[currentoutpos++] = (unsigned char) (byte >> 6);
+            continue;
+          }
+          sbr->currentbyte = sequence_buffer_replay_next_byte(sbr);
+        }
+        pvt->outbuf[currentoutpos++]
+          = (unsigned char) ((sbr->currentbyte >> sbr->shift) & mask);
+        sbr->shift
+          = (sbr->shift + sbr->bitspersymbol) % (unsigned int) CHAR_BIT;
+      }
+    }
+  }
+  pvt->nextfree = currentoutpos;
+  if (sbr->position == sbr->numofsymbols)
+    pvt->complete = true;
+  return 0;
+}
+
+static GtUword
+gt_sequence_buffer_replay_get_file_index(GtSequenceBuffer *sb)
+{
+  gt_assert(sb);
+  return (GtUword) sb->pvt->filenum;
+}
+
+static void gt_sequence_buffer_replay_free(GtSequenceBuffer *sb)
+{
+  GtSequenceBufferReplay *sbr = gt_sequence_buffer_replay_cast(sb);
+  gt_fa_xfclose(sbr->symbolfp);
+  gt_fa_xfclose(sbr->rangefp);
+  gt_xremove(gt_str_get(sbr->symbolfile));
+  gt_xremove(gt_str_get(sbr->rangefile));
+  gt_str_delete(sbr->symbolfile);
+  gt_str_delete(sbr->rangefile);
+}
+
+const GtSequenceBufferClass* gt_sequence_buffer_replay_class(void)
+{
+  static const GtSequenceBufferClass sbc = { sizeof (GtSequenceBufferReplay),
+                                      gt_sequence_buffer_replay_advance,
+                                      gt_sequence_buffer_replay_get_file_index,
+                                      gt_sequence_buffer_replay_free };
+  return &sbc;
+}
+
+GtSequenceBuffer* gt_sequence_buffer_replay_new(unsigned int numofchars)
+{
+  GtSequenceBuffer *sb;
+  GtSequenceBufferReplay *sbr;
+  sb = gt_sequence_buffer_create(gt_sequence_buffer_replay_class());
+  sbr = gt_sequence_buffer_replay_cast(sb);
+  sbr->bitspersymbol = numofchars <= GT_DNAALPHASIZE ? 2U
+                                                     : (unsigned int) CHAR_BIT;
+  sbr->symbolfile = gt_str_new();
+  sbr->symbolfp = gt_xtmpfp(sbr->symbolfile);
+  sbr->rangefile = gt_str_new();
+  sbr->rangefp = gt_xtmpfp(sbr->rangefile);
+  sbr->recording = true;
+  sb->pvt->nextread = sb->pvt->nextfree = 0;
+  sb->pvt->complete = false;
+  return sb;
+}
+
+/* Records <length> pseudo random symbols of an alphabet of size <numofchars>
+   with runs of wildcards and separators, some longer than the output buffer,
+   and checks that they are delivered again in the same order. */
+static int sequence_buffer_replay_test(unsigned int numofchars,
+                                       GtUword length, GtError *err)
+{
+  GtSequenceBuffer *sb;
+  GtUchar *symbols, val;
+  GtUword idx = 0, runlength;
+  int had_err = 0, rval;
+
+  gt_error_check(err);
+  symbols = gt_malloc(sizeof (*symbols) * (length + 1));
+  while (idx < length) {
+    GtUchar cc;
+    switch (gt_rand_max(9UL)) {
+      case 0: cc = (GtUchar) WILDCARD; break;
+      case 1: cc = (GtUchar) SEPARATOR; break;
+      default: cc = (GtUchar) gt_rand_max((GtUword) numofchars - 1);
+    }
+    runlength = ISSPECIAL(cc) && gt_rand_max(99UL) == 0
+                  ? (GtUword) OUTBUFSIZE + gt_rand_max(999UL)
+                  : 1UL + gt_rand_max(40UL);
+    for (/* Nothing */; runlength > 0 && idx < length; runlength--) {
+      symbols[idx++] = ISSPECIAL(cc)
+                         ? cc
+                         : (GtUchar) gt_rand_max((GtUword) numofchars - 1);
+    }
+  }
+  sb = gt_sequence_buffer_replay_new(numofchars);
+  /* recorded in pieces of different lengths */
+  for (idx = 0; idx < length; idx += runlength) {
+    runlength = 1UL + gt_rand_max(100UL);
+    runlength = MIN(runlength, length - idx);
+    gt_sequence_buffer_replay_add(sb, symbols + idx, runlength);
+  }
+  gt_sequence_buffer_replay_rewind(sb);
+  for (idx = 0; !had_err && idx < length; idx++) {
+    rval = gt_sequence_buffer_next(sb, &val, err);
+    gt_ensure(rval == 1);
+    gt_ensure(val == symbols[idx]);
+  }
+  if (!had_err) {
+    rval = gt_sequence_buffer_next(sb, &val, err);
+    gt_ensure(rval == 0);
+  }
+  gt_sequence_buffer_delete(sb);
+  gt_free(symbols);
+  return had_err;
+}
+
+int gt_sequence_buffer_replay_unit_test(GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+
+  had_err = sequence_buffer_replay_test(GT_DNAALPHASIZE, 0, err);
+  if (!had_err)
+    had_err = sequence_buffer_replay_test(GT_DNAALPHASIZE, 1UL, err);
+  if (!had_err) {
+    had_err = sequence_buffer_replay_test(GT_DNAALPHASIZE,
+                                          5UL * OUTBUFSIZE + 3UL, err);
+  }
+  if (!had_err)
+    had_err = sequence_buffer_replay_test(20U, 3UL * OUTBUFSIZE + 7UL, err);
+  return had_err;
+}
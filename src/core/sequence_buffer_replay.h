@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQUENCE_BUFFER_REPLAY_H
+#define SEQUENCE_BUFFER_REPLAY_H
+
+#include "core/error_api.h"
+#include "core/sequence_buffer.h"
+
+/* A <GtSequenceBufferReplay> delivers the encoded symbols which have been
+   recorded with <gt_sequence_buffer_replay_add()>, or by a sequence buffer it
+   was assigned to with <gt_sequence_buffer_set_recorder()>, once more, so that
+   a sequence does not have to be parsed twice. The symbols are kept in
+   temporary files: symbols of alphabets with at most four characters take two
+   bits each, and runs of wildcards and separators are stored as ranges.
+   Only encoded symbols are recorded, the original characters delivered by
+   <gt_sequence_buffer_next_with_original()> are undefined. */
+typedef struct GtSequenceBufferReplay GtSequenceBufferReplay;
+
+const GtSequenceBufferClass* gt_sequence_buffer_replay_class(void);
+/* Returns a new <GtSequenceBufferReplay> recording symbols of an alphabet with
+   <numofchars> characters. */
+GtSequenceBuffer*            gt_sequence_buffer_replay_new(unsigned int
+                                                             numofchars);
+/* Appends the <len> encoded symbols in <symbols> to the recording of <sb>. */
+void                         gt_sequence_buffer_replay_add(GtSequenceBuffer *sb,
+                                                           const GtUchar
+                                                             *symbols,
+                                                           GtUword len);
+/* Finishes the recording of <sb>, which then delivers the recorded symbols
+   from the first one on. */
+void                         gt_sequence_buffer_replay_rewind(GtSequenceBuffer
+                                                                *sb);
+int                          gt_sequence_buffer_replay_unit_test(GtError*);
+
+#endif
@@ -0,0 +1,315 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#ifdef GT_THREADS_ENABLED
+#include <pthread.h>
+#endif
+#include "core/array.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/slab.h"
+#include "core/thread_api.h"
+
+/* blocks are aligned to (and at least as large as) this many bytes */
+#define GT_SLAB_ALIGNMENT   16UL
+/* approximate size of a chunk */
+#define GT_SLAB_CHUNK_SIZE  (64UL << 10)
+#define GT_SLAB_MIN_BLOCKS_PER_CHUNK  16UL
+
+typedef struct GtSlabFreeBlock {
+  struct GtSlabFreeBlock *next;
+} GtSlabFreeBlock;
+
+struct GtSlab {
+  size_t size;
+  GtUword blocks_per_chunk,
+          num_of_blocks;
+  GtArray *chunks;
+  GtSlabFreeBlock *free_blocks;
+  GtMutex *mutex;
+  bool bookkeeping; /* allocate every block separately */
+};
+
+/* round up <size>, such that each block is aligned and can hold a free list
+   pointer */
+static size_t slab_block_size(size_t size)
+{
+  return (size + GT_SLAB_ALIGNMENT - 1) & ~(GT_SLAB_ALIGNMENT - 1);
+}
+
+#ifdef GT_THREADS_ENABLED
+static pthread_mutex_t slabs_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+static GtArray *slabs = NULL;
+
+/* the slabs of the size classes used by gt_slab_class_alloc(), class <i>
+   holds blocks of (<i> + 1) * GT_SLAB_ALIGNMENT bytes */
+#define GT_SLAB_NUM_OF_CLASSES  (GT_SLAB_CLASS_MAX_SIZE / GT_SLAB_ALIGNMENT)
+static GtSlab *class_slabs[GT_SLAB_NUM_OF_CLASSES];
+
+GtSlab* gt_slab_get(size_t size)
+{
+  GtSlab *slab = NULL;
+  GtUword i;
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_lock(&slabs_lock);
+#endif
+  if (slabs == NULL)
+    slabs = gt_array_new(sizeof (GtSlab*));
+  for (i = 0; slab == NULL && i < gt_array_size(slabs); i++) {
+    if ((*(GtSlab**) gt_array_get(slabs, i))->size == slab_block_size(size))
+      slab = *(GtSlab**) gt_array_get(slabs, i);
+  }
+  if (slab == NULL) {
+    slab = gt_slab_new(size);
+    gt_array_add(slabs, slab);
+  }
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_unlock(&slabs_lock);
+#endif
+  return slab;
+}
+
+void gt_slab_clean(void)
+{
+  GtUword i;
+  if (slabs == NULL) return;
+  for (i = 0; i < gt_array_size(slabs); i++)
+    gt_slab_delete(*(GtSlab**) gt_array_get(slabs, i));
+  gt_array_delete(slabs);
+  slabs = NULL;
+  memset(class_slabs, 0, sizeof (class_slabs));
+}
+
+void gt_slab_init(void)
+{
+  GtUword idx;
+  for (idx = 0; idx < GT_SLAB_NUM_OF_CLASSES; idx++)
+    class_slabs[idx] = gt_slab_get((idx + 1) * GT_SLAB_ALIGNMENT);
+}
+
+/* <class_slabs> is only written by gt_slab_init() and gt_slab_clean(), so it
+   can be read without taking <slabs_lock> */
+static GtSlab* slab_class_get(size_t size)
+{
+  GtSlab *slab;
+  gt_assert(size > 0 && size <= GT_SLAB_CLASS_MAX_SIZE);
+  slab = class_slabs[(size - 1) / GT_SLAB_ALIGNMENT];
+  gt_assert(slab != NULL);
+  return slab;
+}
+
+void* gt_slab_class_alloc_mem(size_t size, const char *src_file, int src_line)
+{
+  gt_assert(size > 0);
+  if (size > GT_SLAB_CLASS_MAX_SIZE)
+    return gt_malloc_mem(size, src_file, src_line);
+  return gt_slab_alloc_mem(slab_class_get(size), src_file, src_line);
+}
+
+void* gt_slab_class_realloc_mem(void *block, size_t oldsize, size_t newsize,
+                                const char *src_file, int src_line)
+{
+  void *newblock;
+  gt_assert(block && oldsize > 0 && newsize > 0);
+  if (oldsize > GT_SLAB_CLASS_MAX_SIZE && newsize > GT_SLAB_CLASS_MAX_SIZE)
+    return gt_realloc_mem(block, newsize, src_file, src_line);
+  if (oldsize <= GT_SLAB_CLASS_MAX_SIZE && newsize <= GT_SLAB_CLASS_MAX_SIZE &&
+      (oldsize - 1) / GT_SLAB_ALIGNMENT == (newsize - 1) / GT_SLAB_ALIGNMENT) {
+    return block; /* same size class */
+  }
+  newblock = gt_slab_class_alloc_mem(newsize, src_file, src_line);
+  memcpy(newblock, block, oldsize < newsize ? oldsize : newsize);
+  gt_slab_class_free_mem(block, oldsize, src_file, src_line);
+  return newblock;
+}
+
+void gt_slab_class_free_mem(void *block, size_t size, const char *src_file,
+                            int src_line)
+{
+  if (!block) return;
+  gt_assert(size > 0);
+  if (size > GT_SLAB_CLASS_MAX_SIZE)
+    gt_free_mem(block, src_file, src_line);
+  else
+    gt_slab_free_mem(slab_class_get(size), block, src_file, src_line);
+}
+
+GtSlab* gt_slab_new(size_t size)
+{
+  GtSlab *slab;
+  gt_assert(size);
+  slab = gt_malloc(sizeof *slab);
+  slab->size = slab_block_size(size);
+  slab->blocks_per_chunk = GT_SLAB_CHUNK_SIZE / slab->size;
+  if (slab->blocks_per_chunk < GT_SLAB_MIN_BLOCKS_PER_CHUNK)
+    slab->blocks_per_chunk = GT_SLAB_MIN_BLOCKS_PER_CHUNK;
+  slab->num_of_blocks = 0;
+  slab->chunks = gt_array_new(sizeof (void*));
+  slab->free_blocks = NULL;
+  slab->mutex = gt_mutex_new();
+  slab->bookkeeping = gt_ma_bookkeeping_enabled();
+  return slab;
+}
+
+/* add the blocks of a new chunk to the free list of <slab> */
+static void slab_add_chunk(GtSlab *slab)
+{
+  char *chunk;
+  GtUword i;
+  chunk = gt_malloc(slab->blocks_per_chunk * slab->size);
+  gt_array_add(slab->chunks, chunk);
+  for (i = slab->blocks_per_chunk; i > 0; i--) {
+    GtSlabFreeBlock *block = (GtSlabFreeBlock*) (chunk + (i-1) * slab->size);
+    block->next = slab->free_blocks;
+    slab->free_blocks = block;
+  }
+}
+
+void* gt_slab_alloc_mem(GtSlab *slab, const char *src_file, int src_line)
+{
+  GtSlabFreeBlock *block;
+  gt_assert(slab);
+  if (slab->bookkeeping) {
+    gt_mutex_lock(slab->mutex);
+    slab->num_of_blocks++;
+    gt_mutex_unlock(slab->mutex);
+    return gt_malloc_mem(slab->size, src_file, src_line);
+  }
+  gt_mutex_lock(slab->mutex);
+  if (slab->free_blocks == NULL)
+    slab_add_chunk(slab);
+  block = slab->free_blocks;
+  slab->free_blocks = block->next;
+  slab->num_of_blocks++;
+  gt_mutex_unlock(slab->mutex);
+  return block;
+}
+
+void gt_slab_free_mem(GtSlab *slab, void *block, const char *src_file,
+                      int src_line)
+{
+  gt_assert(slab);
+  if (!block) return;
+  gt_mutex_lock(slab->mutex);
+  gt_assert(slab->num_of_blocks > 0);
+  slab->num_of_blocks--;
+  if (!slab->bookkeeping) {
+    ((GtSlabFreeBlock*) block)->next = slab->free_blocks;
+    slab->free_blocks = block;
+  }
+  gt_mutex_unlock(slab->mutex);
+  if (slab->bookkeeping)
+    gt_free_mem(block, src_file, src_line);
+}
+
+GtUword gt_slab_num_of_blocks(GtSlab *slab)
+{
+  GtUword num_of_blocks;
+  gt_assert(slab);
+  gt_mutex_lock(slab->mutex);
+  num_of_blocks = slab->num_of_blocks;
+  gt_mutex_unlock(slab->mutex);
+  return num_of_blocks;
+}
+
+void gt_slab_delete(GtSlab *slab)
+{
+  GtUword i;
+  if (!slab) return;
+  for (i = 0; i < gt_array_size(slab->chunks); i++)
+    gt_free(*(void**) gt_array_get(slab->chunks, i));
+  gt_array_delete(slab->chunks);
+  gt_mutex_delete(slab->mutex);
+  gt_free(slab);
+}
+
+#define GT_SLAB_TEST_BLOCKS  10000UL
+
+int gt_slab_unit_test(GtError *err)
+{
+  GtSlab *slab;
+  GtUword i, j, **blocks;
+  size_t size;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gt_ensure(gt_slab_get(40) == gt_slab_get(40));
+  gt_ensure(gt_slab_get(40) == gt_slab_get(48));
+  gt_ensure(gt_slab_get(40) != gt_slab_get(80));
+
+  blocks = gt_malloc(GT_SLAB_TEST_BLOCKS * sizeof (*blocks));
+  for (size = 1; !had_err && size <= 257; size += 64) {
+    slab = gt_slab_new(size);
+    gt_ensure(gt_slab_num_of_blocks(slab) == 0);
+    /* fill every block with its number */
+    for (i = 0; i < GT_SLAB_TEST_BLOCKS; i++) {
+      blocks[i] = gt_slab_alloc(slab);
+      gt_ensure((((size_t) blocks[i]) % GT_SLAB_ALIGNMENT) == 0);
+      for (j = 0; j * sizeof (GtUword) < size; j++)
+        blocks[i][j] = i;
+    }
+    gt_ensure(gt_slab_num_of_blocks(slab) == GT_SLAB_TEST_BLOCKS);
+    /* free every second block and reallocate it */
+    for (i = 0; i < GT_SLAB_TEST_BLOCKS; i += 2)
+      gt_slab_free(slab, blocks[i]);
+    gt_ensure(gt_slab_num_of_blocks(slab) == GT_SLAB_TEST_BLOCKS / 2);
+    for (i = 0; i < GT_SLAB_TEST_BLOCKS; i += 2) {
+      blocks[i] = gt_slab_alloc(slab);
+      for (j = 0; j * sizeof (GtUword) < size; j++)
+        blocks[i][j] = i;
+    }
+    /* no block has been overwritten */
+    for (i = 0; !had_err && i < GT_SLAB_TEST_BLOCKS; i++) {
+      for (j = 0; !had_err && j * sizeof (GtUword) < size; j++)
+        gt_ensure(blocks[i][j] == i);
+    }
+    for (i = 0; i < GT_SLAB_TEST_BLOCKS; i++)
+      gt_slab_free(slab, blocks[i]);
+    gt_ensure(gt_slab_num_of_blocks(slab) == 0);
+    gt_slab_delete(slab);
+  }
+  gt_free(blocks);
+
+  /* grow and shrink a block across size classes and beyond the largest one,
+     its contents have to be kept */
+  if (!had_err) {
+    unsigned char *block = gt_slab_class_alloc(1);
+    size_t oldsize = 1;
+    block[0] = 0;
+    for (size = 2; !had_err && size <= 2 * GT_SLAB_CLASS_MAX_SIZE + 3;
+         size += 7) {
+      block = gt_slab_class_realloc(block, oldsize, size);
+      for (i = 0; !had_err && i < oldsize; i++)
+        gt_ensure(block[i] == (unsigned char) i);
+      for (i = oldsize; i < size; i++)
+        block[i] = (unsigned char) i;
+      oldsize = size;
+    }
+    while (!had_err && size > 7) {
+      size -= 7;
+      block = gt_slab_class_realloc(block, oldsize, size);
+      for (i = 0; !had_err && i < size; i++)
+        gt_ensure(block[i] == (unsigned char) i);
+      oldsize = size;
+    }
+    gt_slab_class_free(block, oldsize);
+  }
+
+  return had_err;
+}
@@ -0,0 +1,89 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdlib.h>
+#include "core/error_api.h"
+#include "core/types_api.h"
+
+/* A <GtSlab> hands out memory blocks of a fixed size. The blocks are carved
+   from large chunks, freed blocks are kept in a free list and reused by
+   subsequent allocations. Compared to calling <gt_malloc()> for every object
+   this avoids the per-allocation overhead and the fragmentation caused by
+   many small, similar objects (e.g., genome nodes). All chunks are released at
+   once when the slab is deleted.
+   If the memory bookkeeping is enabled, every block is allocated separately
+   with <gt_malloc()>, so that leaks are still reported for the caller.
+   A <GtSlab> is thread-safe. */
+typedef struct GtSlab GtSlab;
+
+/* Return the process-wide <GtSlab> for blocks of <size> bytes, which is
+   created on first use. */
+GtSlab* gt_slab_get(size_t size);
+/* Create the process-wide slabs of the size classes used by
+   <gt_slab_class_alloc()>. Called by <gt_lib_init()>. */
+void    gt_slab_init(void);
+/* Delete all process-wide slabs. Called by <gt_lib_clean()>. */
+void    gt_slab_clean(void);
+
+/* Return an ___uninitialized___ block of at least <size> bytes for objects of
+   varying size (e.g., attribute strings). Blocks of up to
+   <GT_SLAB_CLASS_MAX_SIZE> bytes are taken from the process-wide slab of the
+   smallest size class holding them, larger blocks are allocated with
+   <gt_malloc()>. The <size> of a block has to be passed again when it is
+   resized or freed. */
+#define GT_SLAB_CLASS_MAX_SIZE  512UL
+#define gt_slab_class_alloc(size)\
+        gt_slab_class_alloc_mem(size, __FILE__, __LINE__)
+void*   gt_slab_class_alloc_mem(size_t size, const char *src_file,
+                                int src_line);
+/* Resize the <block> of <oldsize> bytes returned by <gt_slab_class_alloc()> to
+   <newsize> bytes and return it. The contents are kept up to the smaller of
+   both sizes. The block is only moved if the size class changes. */
+#define gt_slab_class_realloc(block, oldsize, newsize)\
+        gt_slab_class_realloc_mem(block, oldsize, newsize, __FILE__, __LINE__)
+void*   gt_slab_class_realloc_mem(void *block, size_t oldsize, size_t newsize,
+                                  const char *src_file, int src_line);
+/* Free the <block> of <size> bytes returned by <gt_slab_class_alloc()>. If
+   <block> equals <NULL>, no action occurs. */
+#define gt_slab_class_free(block, size)\
+        gt_slab_class_free_mem(block, size, __FILE__, __LINE__)
+void    gt_slab_class_free_mem(void *block, size_t size, const char *src_file,
+                               int src_line);
+
+/* Return a new <GtSlab> for blocks of <size> bytes. */
+GtSlab* gt_slab_new(size_t size);
+/* Return an ___uninitialized___ block of the size of <slab>. */
+#define gt_slab_alloc(slab)\
+        gt_slab_alloc_mem(slab, __FILE__, __LINE__)
+void*   gt_slab_alloc_mem(GtSlab *slab, const char *src_file, int src_line);
+/* Return the <block> allocated from <slab> to it. If <block> equals <NULL>, no
+   action occurs. */
+#define gt_slab_free(slab, block)\
+        gt_slab_free_mem(slab, block, __FILE__, __LINE__)
+void    gt_slab_free_mem(GtSlab *slab, void *block, const char *src_file,
+                         int src_line);
+/* Return the number of blocks of <slab> currently in use. */
+GtUword gt_slab_num_of_blocks(GtSlab *slab);
+/* Delete <slab> and all of its chunks. Blocks still in use become invalid. */
+void    gt_slab_delete(GtSlab *slab);
+
+int     gt_slab_unit_test(GtError *err);
+
+#endif
@@ -0,0 +1,466 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/ensure.h"
+#include "core/interval_tree.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/static_interval_tree.h"
+#include "core/thread_pool.h"
+#include "core/unused_api.h"
+
+/* number of queries processed as one task by the batch query functions */
+#define GT_STATIC_INTERVAL_TREE_BATCHSIZE  1024UL
+
+typedef struct {
+  GtUword low,
+          high,
+          max; /* maximal <high> in the subtree rooted here */
+  void *data;
+} GtStaticIntervalTreeEntry;
+
+struct GtStaticIntervalTree {
+  GtArray *added;
+  GtStaticIntervalTreeEntry *entries; /* in Eytzinger order: the children of
+                                         entry <k> are <2k+1> and <2k+2> */
+  GtUword size;
+  GtFree free_func;
+};
+
+GtStaticIntervalTree* gt_static_interval_tree_new(GtFree func)
+{
+  GtStaticIntervalTree *sit;
+  sit = gt_calloc(1, sizeof (GtStaticIntervalTree));
+  sit->added = gt_array_new(sizeof (GtStaticIntervalTreeEntry));
+  sit->free_func = func;
+  return sit;
+}
+
+void gt_static_interval_tree_add(GtStaticIntervalTree *sit, void *data,
+                                 GtUword low, GtUword high)
+{
+  GtStaticIntervalTreeEntry entry;
+  gt_assert(sit && sit->added && low <= high);
+  entry.low = low;
+  entry.high = high;
+  entry.max = high;
+  entry.data = data;
+  gt_array_add(sit->added, entry);
+}
+
+static int static_interval_tree_entry_cmp(const void *a, const void *b)
+{
+  const GtStaticIntervalTreeEntry *ea = a, *eb = b;
+  if (ea->low < eb->low)
+    return -1;
+  if (ea->low > eb->low)
+    return 1;
+  if (ea->high < eb->high)
+    return -1;
+  if (ea->high > eb->high)
+    return 1;
+  return 0;
+}
+
+/* Store the sorted entries from <*next> on in the subtree rooted at <k> in
+   symmetric order, such that an in-order traversal yields them sorted. */
+static void static_interval_tree_fill(GtStaticIntervalTree *sit,
+                                      const GtStaticIntervalTreeEntry *sorted,
+                                      GtUword *next, GtUword k)
+{
+  if (k >= sit->size)
+    return;
+  static_interval_tree_fill(sit, sorted, next, 2 * k + 1);
+  sit->entries[k] = sorted[(*next)++];
+  static_interval_tree_fill(sit, sorted, next, 2 * k + 2);
+}
+
+void gt_static_interval_tree_build(GtStaticIntervalTree *sit)
+{
+  GtUword k, next = 0;
+  gt_assert(sit && sit->added);
+  gt_array_sort_stable(sit->added, static_interval_tree_entry_cmp);
+  sit->size = gt_array_size(sit->added);
+  sit->entries = gt_malloc(sizeof (GtStaticIntervalTreeEntry)
+                           * MAX(sit->size, 1UL));
+  static_interval_tree_fill(sit, gt_array_get_space(sit->added), &next, 0);
+  gt_assert(next == sit->size);
+  for (k = sit->size; k-- > 0; /* nothing */) {
+    GtStaticIntervalTreeEntry *entry = sit->entries + k;
+    if (2 * k + 1 < sit->size)
+      entry->max = MAX(entry->max, sit->entries[2 * k + 1].max);
+    if (2 * k + 2 < sit->size)
+      entry->max = MAX(entry->max, sit->entries[2 * k + 2].max);
+  }
+  gt_array_delete(sit->added);
+  sit->added = NULL;
+}
+
+GtUword gt_static_interval_tree_size(const GtStaticIntervalTree *sit)
+{
+  gt_assert(sit);
+  return sit->added ? gt_array_size(sit->added) : sit->size;
+}
+
+static const GtStaticIntervalTreeEntry*
+static_interval_tree_find_first(const GtStaticIntervalTree *sit, GtUword k,
+                                GtUword start, GtUword end)
+{
+  const GtStaticIntervalTreeEntry *entry;
+  while (k < sit->size && sit->entries[k].max >= start) {
+    if ((entry = static_interval_tree_find_first(sit, 2 * k + 1, start, end)))
+      return entry;
+    entry = sit->entries + k;
+    if (entry->low > end)
+      return NULL;
+    if (entry->high >= start)
+      return entry;
+    k = 2 * k + 2;
+  }
+  return NULL;
+}
+
+void* gt_static_interval_tree_find_first_overlapping(
+                                                const GtStaticIntervalTree *sit,
+                                                GtUword start, GtUword end)
+{
+  const GtStaticIntervalTreeEntry *entry;
+  gt_assert(sit && !sit->added && start <= end);
+  entry = static_interval_tree_find_first(sit, 0, start, end);
+  return entry ? entry->data : NULL;
+}
+
+/* In-order traversal of the subtree rooted at <k>, skipping all subtrees
+   whose intervals end before <start> and all right subtrees whose intervals
+   start after <end>. */
+static void static_interval_tree_collect(const GtStaticIntervalTree *sit,
+                                         GtUword k, GtUword start, GtUword end,
+                                         GtArray *results)
+{
+  while (k < sit->size && sit->entries[k].max >= start) {
+    const GtStaticIntervalTreeEntry *entry;
+    static_interval_tree_collect(sit, 2 * k + 1, start, end, results);
+    entry = sit->entries + k;
+    if (entry->low > end)
+      return;
+    if (entry->high >= start) {
+      void *data = entry->data;
+      gt_array_add(results, data);
+    }
+    k = 2 * k + 2;
+  }
+}
+
+void gt_static_interval_tree_find_all_overlapping(
+                                                const GtStaticIntervalTree *sit,
+                                                GtUword start, GtUword end,
+                                                GtArray *results)
+{
+  gt_assert(sit && !sit->added && start <= end && results);
+  gt_assert(gt_array_elem_size(results) == sizeof (void*));
+  static_interval_tree_collect(sit, 0, start, end, results);
+}
+
+typedef struct {
+  const GtStaticIntervalTree *sit;
+  const GtRange *queries;
+  const GtUword *points,
+                *order;
+  GtUword numofqueries,
+          *counts;
+  GtArray **chunkresults;
+} GtStaticIntervalTreeBatchInfo;
+
+#define BATCH_QUERY_START(INFO, Q) \
+        ((INFO)->queries ? (INFO)->queries[Q].start : (INFO)->points[Q])
+
+#define BATCH_QUERY_END(INFO, Q) \
+        ((INFO)->queries ? (INFO)->queries[Q].end : (INFO)->points[Q])
+
+static int static_interval_tree_batch_cmp(const void *a, const void *b,
+                                          void *data)
+{
+  const GtStaticIntervalTreeBatchInfo *info = data;
+  GtUword sa = BATCH_QUERY_START(info, *(const GtUword*) a),
+          sb = BATCH_QUERY_START(info, *(const GtUword*) b);
+  if (sa < sb)
+    return -1;
+  if (sa > sb)
+    return 1;
+  return 0;
+}
+
+static void static_interval_tree_batch_chunks(GtUword start, GtUword end,
+                                              void *data)
+{
+  GtStaticIntervalTreeBatchInfo *info = data;
+  GtUword c, j;
+  for (c = start; c < end; c++) {
+    GtArray *results = gt_array_new(sizeof (void*));
+    for (j = c * GT_STATIC_INTERVAL_TREE_BATCHSIZE;
+         j < MIN((c + 1) * GT_STATIC_INTERVAL_TREE_BATCHSIZE,
+                 info->numofqueries);
+         j++) {
+      GtUword q = info->order[j], before = gt_array_size(results);
+      static_interval_tree_collect(info->sit, 0, BATCH_QUERY_START(info, q),
+                                   BATCH_QUERY_END(info, q), results);
+      info->counts[q] = gt_array_size(results) - before;
+    }
+    info->chunkresults[c] = results;
+  }
+}
+
+static void static_interval_tree_batch(GtStaticIntervalTreeBatchInfo *info,
+                                       GtArray *results, GtUword *offsets)
+{
+  GtUword c, i, j, numofchunks;
+  GtArray *order;
+  void **space;
+  gt_assert(info->sit && !info->sit->added && results && offsets);
+  gt_assert(gt_array_elem_size(results) == sizeof (void*));
+
+  /* process queries sorted by start position, such that consecutive queries
+     visit mostly the same entries */
+  order = gt_array_new(sizeof (GtUword));
+  for (i = 0; i < info->numofqueries; i++) {
+    gt_assert(BATCH_QUERY_START(info, i) <= BATCH_QUERY_END(info, i));
+    gt_array_add(order, i);
+  }
+  gt_array_sort_with_data(order, static_interval_tree_batch_cmp, info);
+  info->order = gt_array_get_space(order);
+  numofchunks = (info->numofqueries + GT_STATIC_INTERVAL_TREE_BATCHSIZE - 1)
+                / GT_STATIC_INTERVAL_TREE_BATCHSIZE;
+  info->chunkresults = gt_malloc(sizeof (GtArray*) * MAX(numofchunks, 1UL));
+  /* the number of results of query <i> is stored in <offsets[i+1]> */
+  info->counts = offsets + 1;
+  gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numofchunks, 1,
+                              static_interval_tree_batch_chunks, info);
+
+  offsets[0] = gt_array_size(results);
+  for (i = 0; i < info->numofqueries; i++)
+    offsets[i + 1] += offsets[i];
+  for (i = offsets[0]; i < offsets[info->numofqueries]; i++) {
+    void *nodata = NULL;
+    gt_array_add(results, nodata);
+  }
+  space = gt_array_get_space(results);
+  for (c = 0; c < numofchunks; c++) {
+    void **chunkspace = gt_array_get_space(info->chunkresults[c]);
+    for (j = c * GT_STATIC_INTERVAL_TREE_BATCHSIZE;
+         j < MIN((c + 1) * GT_STATIC_INTERVAL_TREE_BATCHSIZE,
+                 info->numofqueries);
+         j++) {
+      GtUword q = info->order[j], count = offsets[q + 1] - offsets[q];
+      if (count > 0) {
+        memcpy(space + offsets[q], chunkspace, sizeof (void*) * count);
+        chunkspace += count;
+      }
+    }
+    gt_array_delete(info->chunkresults[c]);
+  }
+  gt_free(info->chunkresults);
+  gt_array_delete(order);
+}
+
+void gt_static_interval_tree_find_all_overlapping_batch(
+                                                const GtStaticIntervalTree *sit,
+                                                const GtRange *queries,
+                                                GtUword numofqueries,
+                                                GtArray *results,
+                                                GtUword *offsets)
+{
+  GtStaticIntervalTreeBatchInfo info;
+  gt_assert(queries || numofqueries == 0);
+  memset(&info, 0, sizeof (info));
+  info.sit = sit;
+  info.queries = queries;
+  info.numofqueries = numofqueries;
+  static_interval_tree_batch(&info, results, offsets);
+}
+
+void gt_static_interval_tree_find_all_containing_batch(
+                                                const GtStaticIntervalTree *sit,
+                                                const GtUword *points,
+                                                GtUword numofpoints,
+                                                GtArray *results,
+                                                GtUword *offsets)
+{
+  GtStaticIntervalTreeBatchInfo info;
+  gt_assert(points || numofpoints == 0);
+  memset(&info, 0, sizeof (info));
+  info.sit = sit;
+  info.points = points;
+  info.numofqueries = numofpoints;
+  static_interval_tree_batch(&info, results, offsets);
+}
+
+void gt_static_interval_tree_delete(GtStaticIntervalTree *sit)
+{
+  GtUword i;
+  if (!sit) return;
+  if (sit->free_func) {
+    if (sit->added) {
+      for (i = 0; i < gt_array_size(sit->added); i++) {
+        GtStaticIntervalTreeEntry *entry = gt_array_get(sit->added, i);
+        if (entry->data)
+          sit->free_func(entry->data);
+      }
+    }
+    else {
+      for (i = 0; i < sit->size; i++) {
+        if (sit->entries[i].data)
+          sit->free_func(sit->entries[i].data);
+      }
+    }
+  }
+  gt_array_delete(sit->added);
+  gt_free(sit->entries);
+  gt_free(sit);
+}
+
+static int range_ptr_compare(const void *r1p, const void *r2p)
+{
+  int ret;
+  gt_assert(r1p && r2p);
+  ret = gt_range_compare(*(GtRange**) r1p, *(GtRange**) r2p);
+  if (ret == 0 && *(GtRange**) r1p != *(GtRange**) r2p)
+    ret = *(GtRange**) r1p < *(GtRange**) r2p ? -1 : 1;
+  return ret;
+}
+
+int gt_static_interval_tree_unit_test(GT_UNUSED GtError *err)
+{
+  GtStaticIntervalTree *sit;
+  GtIntervalTree *it;
+  GtArray *arr, *res, *ref, *batchres;
+  GtRange *rng, *queries;
+  GtUword i, j, *points, *offsets, num_testranges = 3000,
+          num_queries = 5000, max_basepos = 90000, width = 700,
+          query_width = 5000;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* empty tree */
+  sit = gt_static_interval_tree_new(NULL);
+  gt_static_interval_tree_build(sit);
+  gt_ensure(gt_static_interval_tree_size(sit) == 0);
+  gt_ensure(!gt_static_interval_tree_find_first_overlapping(sit, 0, ~0UL));
+  gt_static_interval_tree_delete(sit);
+
+  arr = gt_array_new(sizeof (GtRange*));
+  sit = gt_static_interval_tree_new(gt_free_func);
+  it = gt_interval_tree_new(NULL);
+  for (i = 0; i < num_testranges; i++) {
+    GtUword start = gt_rand_max(max_basepos);
+    rng = gt_calloc(1, sizeof (GtRange));
+    rng->start = start;
+    rng->end = start + gt_rand_max(width);
+    gt_array_add(arr, rng);
+    gt_static_interval_tree_add(sit, rng, rng->start, rng->end);
+    gt_interval_tree_insert(it, gt_interval_tree_node_new(rng, rng->start,
+                                                          rng->end));
+  }
+  gt_ensure(gt_static_interval_tree_size(sit) == num_testranges);
+  gt_static_interval_tree_build(sit);
+  gt_ensure(gt_static_interval_tree_size(sit) == num_testranges);
+
+  queries = gt_malloc(sizeof (GtRange) * num_queries);
+  points = gt_malloc(sizeof (GtUword) * num_queries);
+  offsets = gt_malloc(sizeof (GtUword) * (num_queries + 1));
+  res = gt_array_new(sizeof (GtRange*));
+  ref = gt_array_new(sizeof (GtRange*));
+  for (i = 0; !had_err && i < num_queries; i++) {
+    GtUword start = gt_rand_max(max_basepos + width);
+    queries[i].start = start;
+    queries[i].end = start + gt_rand_max(query_width);
+    points[i] = gt_rand_max(max_basepos + width);
+
+    /* compare all overlapping intervals with the dynamic interval tree */
+    gt_array_reset(res);
+    gt_array_reset(ref);
+    gt_static_interval_tree_find_all_overlapping(sit, queries[i].start,
+                                                 queries[i].end, res);
+    gt_interval_tree_find_all_overlapping(it, queries[i].start,
+                                          queries[i].end, ref);
+    for (j = 1; !had_err && j < gt_array_size(res); j++) {
+      gt_ensure((*(GtRange**) gt_array_get(res, j-1))->start
+                  <= (*(GtRange**) gt_array_get(res, j))->start);
+    }
+    gt_array_sort_stable(res, range_ptr_compare);
+    gt_array_sort_stable(ref, range_ptr_compare);
+    gt_ensure(gt_array_cmp(res, ref) == 0);
+
+    /* the first overlapping interval has the smallest start position */
+    rng = gt_static_interval_tree_find_first_overlapping(sit, queries[i].start,
+                                                         queries[i].end);
+    if (gt_array_size(ref) == 0) {
+      gt_ensure(rng == NULL);
+    }
+    else {
+      gt_ensure(rng && gt_range_overlap(rng, queries + i));
+      gt_ensure(rng->start == (*(GtRange**) gt_array_get(ref, 0))->start);
+    }
+  }
+
+  /* batch queries yield the same results as single queries */
+  batchres = gt_array_new(sizeof (GtRange*));
+  rng = NULL;
+  gt_array_add(batchres, rng);
+  gt_static_interval_tree_find_all_overlapping_batch(sit, queries, num_queries,
+                                                     batchres, offsets);
+  gt_ensure(offsets[0] == 1);
+  gt_ensure(offsets[num_queries] == gt_array_size(batchres));
+  for (i = 0; !had_err && i < num_queries; i++) {
+    gt_array_reset(res);
+    gt_static_interval_tree_find_all_overlapping(sit, queries[i].start,
+                                                 queries[i].end, res);
+    gt_ensure(offsets[i+1] - offsets[i] == gt_array_size(res));
+    for (j = 0; !had_err && j < gt_array_size(res); j++) {
+      gt_ensure(*(GtRange**) gt_array_get(res, j)
+                  == *(GtRange**) gt_array_get(batchres, offsets[i] + j));
+    }
+  }
+  gt_array_reset(batchres);
+  gt_static_interval_tree_find_all_containing_batch(sit, points, num_queries,
+                                                    batchres, offsets);
+  gt_ensure(offsets[0] == 0);
+  for (i = 0; !had_err && i < num_queries; i++) {
+    GtRange point;
+    point.start = point.end = points[i];
+    gt_ensure(offsets[i+1] >= offsets[i]);
+    for (j = offsets[i]; !had_err && j < offsets[i+1]; j++) {
+      gt_ensure(gt_range_overlap(*(GtRange**) gt_array_get(batchres, j),
+                                 &point));
+    }
+    gt_array_reset(ref);
+    gt_interval_tree_find_all_overlapping(it, points[i], points[i], ref);
+    gt_ensure(offsets[i+1] - offsets[i] == gt_array_size(ref));
+  }
+
+  gt_array_delete(batchres);
+  gt_array_delete(ref);
+  gt_array_delete(res);
+  gt_free(offsets);
+  gt_free(points);
+  gt_free(queries);
+  gt_interval_tree_delete(it);
+  gt_static_interval_tree_delete(sit);
+  gt_array_delete(arr);
+  return had_err;
+}
@@ -0,0 +1,102 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef STATIC_INTERVAL_TREE_API_H
+#define STATIC_INTERVAL_TREE_API_H
+
+#include "core/array_api.h"
+#include "core/fptr_api.h"
+#include "core/range_api.h"
+
+/* The <GtStaticIntervalTree> class is an interval index for the case that all
+   intervals are known in advance and the index is only queried afterwards.
+   The intervals are sorted by start position and stored in a single array
+   which implicitly represents a balanced search tree in breadth-first
+   (Eytzinger) order, each entry augmented with the maximum end position in its
+   subtree. Compared to <GtIntervalTree> no node is allocated separately and
+   the top levels of the tree, which are touched by every query, are stored in
+   few adjacent cache lines. */
+typedef struct GtStaticIntervalTree GtStaticIntervalTree;
+
+/* Creates a new empty <GtStaticIntervalTree>. If a <GtFree> function is given
+   as an argument, it is applied on the data pointers of all added intervals
+   when the <GtStaticIntervalTree> is deleted. */
+GtStaticIntervalTree* gt_static_interval_tree_new(GtFree);
+
+/* Adds an interval from <low> to <high> with associated <data> to <sit>. All
+   intervals have to be added before <gt_static_interval_tree_build()> is
+   called. */
+void                  gt_static_interval_tree_add(GtStaticIntervalTree *sit,
+                                                  void *data,
+                                                  GtUword low,
+                                                  GtUword high);
+
+/* Builds the index of <sit> from all added intervals in O(n log n) time. Must
+   be called before querying <sit>, afterwards no further intervals may be
+   added. */
+void                  gt_static_interval_tree_build(GtStaticIntervalTree *sit);
+
+/* Returns the number of intervals in <sit>. */
+GtUword               gt_static_interval_tree_size(const GtStaticIntervalTree
+                                                   *sit);
+
+/* Returns the data pointer of the interval with the smallest start position
+   in <sit> which overlaps the given range (from <start> to <end>), or NULL if
+   there is none. */
+void*                 gt_static_interval_tree_find_first_overlapping(
+                                               const GtStaticIntervalTree *sit,
+                                               GtUword start,
+                                               GtUword end);
+
+/* Collects the data pointers of all intervals in <sit> which overlap with the
+   query range (from <start> to <end>) in <results>, ordered by the start
+   positions of the intervals. */
+void                  gt_static_interval_tree_find_all_overlapping(
+                                               const GtStaticIntervalTree *sit,
+                                               GtUword start,
+                                               GtUword end,
+                                               GtArray *results);
+
+/* Answers the <numofqueries> range queries in <queries> at once. The data
+   pointers of the intervals overlapping <queries[i]> are appended to
+   <results> (in the order of <gt_static_interval_tree_find_all_overlapping()>)
+   at the positions from <offsets[i]> to <offsets[i+1]> - 1, where <offsets>
+   must have space for <numofqueries> + 1 entries and <offsets[0]> is the size
+   of <results> before the call. The queries are processed in the order of
+   their start positions, in parallel if <gt_jobs> is larger than one. */
+void                  gt_static_interval_tree_find_all_overlapping_batch(
+                                               const GtStaticIntervalTree *sit,
+                                               const GtRange *queries,
+                                               GtUword numofqueries,
+                                               GtArray *results,
+                                               GtUword *offsets);
+
+/* Like <gt_static_interval_tree_find_all_overlapping_batch()>, but for the
+   <numofpoints> point queries <points>, i.e. collects the intervals containing
+   <points[i]>. */
+void                  gt_static_interval_tree_find_all_containing_batch(
+                                               const GtStaticIntervalTree *sit,
+                                               const GtUword *points,
+                                               GtUword numofpoints,
+                                               GtArray *results,
+                                               GtUword *offsets);
+
+/* Deletes <sit>. If a <GtFree> function was set in the constructor, the data
+   pointers of all intervals are freed using it. */
+void                  gt_static_interval_tree_delete(GtStaticIntervalTree *sit);
+
+#endif
@@ -19,7 +19,7 @@
 #include "core/array_api.h"
 #include "core/compat.h"
 #include "core/ma_api.h"
-#include "core/thread_api.h"
+#include "core/thread.h"
 #include "core/unused_api.h"
 
 unsigned int gt_jobs = 1;
@@ -85,6 +85,28 @@ void gt_rwlock_delete(GtRWLock *rwlock)
   free(rwlock);
 }
 
+size_t gt_rwlock_size(void)
+{
+  return sizeof (pthread_rwlock_t);
+}
+
+GtRWLock* gt_rwlock_init(void *mem)
+{
+  GT_UNUSED int rval;
+  gt_assert(mem);
+  rval = pthread_rwlock_init((pthread_rwlock_t*) mem, NULL);
+  gt_assert(!rval);
+  return mem;
+}
+
+void gt_rwlock_destroy(GtRWLock *rwlock)
+{
+  GT_UNUSED int rval;
+  if (!rwlock) return;
+  rval = pthread_rwlock_destroy((pthread_rwlock_t*) rwlock);
+  gt_assert(!rval);
+}
+
 void gt_rwlock_rdlock_func(GtRWLock *rwlock)
 {
   GT_UNUSED int rval;
@@ -169,6 +191,21 @@ void gt_rwlock_delete(GT_UNUSED GtRWLock *rwlock)
   return;
 }
 
+size_t gt_rwlock_size(void)
+{
+  return 0;
+}
+
+GtRWLock* gt_rwlock_init(GT_UNUSED void *mem)
+{
+  return NULL;
+}
+
+void gt_rwlock_destroy(GT_UNUSED GtRWLock *rwlock)
+{
+  return;
+}
+
 GtMutex* gt_mutex_new(void)
 {
   return NULL;
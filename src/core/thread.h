@@ -0,0 +1,34 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdlib.h>
+#include "core/thread_api.h"
+
+/* Return the number of bytes needed to store a <GtRWLock> in memory provided
+   by the caller (0 without thread support). */
+size_t    gt_rwlock_size(void);
+/* Initialize a <GtRWLock> in the <gt_rwlock_size()> bytes at <mem> and return
+   it. Allows to embed a read/write lock into other objects. */
+GtRWLock* gt_rwlock_init(void *mem);
+/* Destroy the <rwlock> initialized with <gt_rwlock_init()>, without freeing
+   its memory. */
+void      gt_rwlock_destroy(GtRWLock *rwlock);
+
+#endif
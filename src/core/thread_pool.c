@@ -0,0 +1,619 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#ifdef GT_THREADS_ENABLED
+#include <pthread.h>
+#endif
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/thread_pool.h"
+#include "core/unused_api.h"
+
+#define GT_THREAD_POOL_MIN_DEQUE_SIZE  16UL
+
+/* number of ranges per thread <gt_thread_pool_parallel_for()> aims at if no
+   grainsize is given */
+#define GT_THREAD_POOL_RANGES_PER_THREAD 8UL
+
+typedef struct {
+  GtThreadFunc function;
+  void *data,
+       **result;
+  GtUword *pending; /* open tasks of the future or group of this task */
+} GtThreadPoolTask;
+
+/* ring buffer of tasks, the owner works at the bottom, thieves at the top */
+typedef struct {
+  GtThreadPoolTask *tasks;
+  GtUword top,
+          bottom,
+          allocated; /* always a power of two */
+  GtMutex *mutex;
+} GtThreadPoolDeque;
+
+typedef struct {
+  GtThreadPool *pool;
+  unsigned int num;
+} GtThreadPoolWorker;
+
+struct GtThreadPool {
+  GtThreadPoolDeque *deques; /* <deques[0]> takes tasks of other threads */
+  GtThreadPoolWorker *workerinfo;
+  GtThread **threads;
+  unsigned int numofworkers;
+  GtUword epoch; /* incremented for each submitted task */
+  bool shutdown;
+#ifdef GT_THREADS_ENABLED
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+#endif
+};
+
+struct GtThreadPoolFuture {
+  GtThreadPool *pool;
+  GtUword pending;
+  void *result;
+};
+
+struct GtThreadPoolGroup {
+  GtThreadPool *pool;
+  GtUword pending;
+};
+
+#ifdef GT_THREADS_ENABLED
+static pthread_once_t worker_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t worker_key;
+static pthread_mutex_t default_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void thread_pool_worker_key_create(void)
+{
+  GT_UNUSED int rval;
+  rval = pthread_key_create(&worker_key, NULL);
+  gt_assert(!rval);
+}
+
+#define thread_pool_lock(POOL)        pthread_mutex_lock(&(POOL)->lock)
+#define thread_pool_unlock(POOL)      pthread_mutex_unlock(&(POOL)->lock)
+#define thread_pool_wait(POOL)        pthread_cond_wait(&(POOL)->cond, \
+                                                        &(POOL)->lock)
+#define thread_pool_broadcast(POOL)   pthread_cond_broadcast(&(POOL)->cond)
+#else
+#define thread_pool_lock(POOL)        ((void) 0)
+#define thread_pool_unlock(POOL)      ((void) 0)
+/* without threads all tasks are run by the waiting thread */
+#define thread_pool_wait(POOL)        gt_assert(false)
+#define thread_pool_broadcast(POOL)   ((void) 0)
+#endif
+
+static GtThreadPool *default_pool = NULL;
+
+static void thread_pool_deque_init(GtThreadPoolDeque *deque)
+{
+  deque->allocated = GT_THREAD_POOL_MIN_DEQUE_SIZE;
+  deque->tasks = gt_malloc(sizeof (*deque->tasks) * deque->allocated);
+  deque->top = deque->bottom = 0;
+  deque->mutex = gt_mutex_new();
+}
+
+static void thread_pool_deque_clean(GtThreadPoolDeque *deque)
+{
+  gt_assert(deque->top == deque->bottom);
+  gt_free(deque->tasks);
+  gt_mutex_delete(deque->mutex);
+}
+
+static void thread_pool_deque_push(GtThreadPoolDeque *deque,
+                                   const GtThreadPoolTask *task)
+{
+  gt_mutex_lock(deque->mutex);
+  if (deque->bottom - deque->top == deque->allocated) {
+    GtThreadPoolTask *tasks;
+    GtUword idx;
+    tasks = gt_malloc(sizeof (*tasks) * 2 * deque->allocated);
+    for (idx = deque->top; idx < deque->bottom; idx++)
+      tasks[idx - deque->top] = deque->tasks[idx & (deque->allocated - 1)];
+    gt_free(deque->tasks);
+    deque->tasks = tasks;
+    deque->bottom -= deque->top;
+    deque->top = 0;
+    deque->allocated *= 2;
+  }
+  deque->tasks[deque->bottom & (deque->allocated - 1)] = *task;
+  deque->bottom++;
+  gt_mutex_unlock(deque->mutex);
+}
+
+static bool thread_pool_deque_pop(GtThreadPoolDeque *deque,
+                                  GtThreadPoolTask *task)
+{
+  bool found = false;
+  gt_mutex_lock(deque->mutex);
+  if (deque->bottom > deque->top) {
+    deque->bottom--;
+    *task = deque->tasks[deque->bottom & (deque->allocated - 1)];
+    found = true;
+  }
+  gt_mutex_unlock(deque->mutex);
+  return found;
+}
+
+static bool thread_pool_deque_steal(GtThreadPoolDeque *deque,
+                                    GtThreadPoolTask *task)
+{
+  bool found = false;
+  gt_mutex_lock(deque->mutex);
+  if (deque->bottom > deque->top) {
+    *task = deque->tasks[deque->top & (deque->allocated - 1)];
+    deque->top++;
+    found = true;
+  }
+  gt_mutex_unlock(deque->mutex);
+  return found;
+}
+
+unsigned int gt_thread_pool_thread_num(GT_UNUSED const GtThreadPool *pool)
+{
+#ifdef GT_THREADS_ENABLED
+  GtThreadPoolWorker *worker;
+  gt_assert(pool);
+  (void) pthread_once(&worker_key_once, thread_pool_worker_key_create);
+  worker = pthread_getspecific(worker_key);
+  if (worker != NULL && worker->pool == pool)
+    return worker->num;
+#endif
+  return 0;
+}
+
+unsigned int gt_thread_pool_size(const GtThreadPool *pool)
+{
+  gt_assert(pool);
+  return pool->numofworkers + 1;
+}
+
+/* Fetch a task for thread <num>, first from its own deque, then from the
+   others, starting with the next one. */
+static bool thread_pool_find_task(GtThreadPool *pool, unsigned int num,
+                                  GtThreadPoolTask *task)
+{
+  unsigned int idx;
+  if (thread_pool_deque_pop(pool->deques + num, task))
+    return true;
+  for (idx = 1; idx <= pool->numofworkers; idx++) {
+    if (thread_pool_deque_steal(pool->deques
+                                + (num + idx) % (pool->numofworkers + 1), task))
+      return true;
+  }
+  return false;
+}
+
+static void thread_pool_run_task(GtThreadPool *pool,
+                                 const GtThreadPoolTask *task)
+{
+  void *result = task->function(task->data);
+  thread_pool_lock(pool);
+  if (task->result != NULL)
+    *task->result = result;
+  gt_assert(*task->pending > 0);
+  if (--*task->pending == 0)
+    thread_pool_broadcast(pool);
+  thread_pool_unlock(pool);
+}
+
+static void thread_pool_add_task(GtThreadPool *pool, GtThreadFunc function,
+                                 void *data, void **result, GtUword *pending)
+{
+  GtThreadPoolTask task;
+  gt_assert(pool && function && pending);
+  task.function = function;
+  task.data = data;
+  task.result = result;
+  task.pending = pending;
+  thread_pool_lock(pool);
+  (*pending)++;
+  thread_pool_unlock(pool);
+  thread_pool_deque_push(pool->deques + gt_thread_pool_thread_num(pool),
+                         &task);
+  thread_pool_lock(pool);
+  pool->epoch++;
+  thread_pool_broadcast(pool);
+  thread_pool_unlock(pool);
+}
+
+/* Process tasks until <*pending> becomes 0. */
+static void thread_pool_help_until_done(GtThreadPool *pool, GtUword *pending)
+{
+  unsigned int num = gt_thread_pool_thread_num(pool);
+  GtThreadPoolTask task;
+  for (;;) {
+    GtUword epoch;
+    thread_pool_lock(pool);
+    if (*pending == 0) {
+      thread_pool_unlock(pool);
+      break;
+    }
+    epoch = pool->epoch;
+    thread_pool_unlock(pool);
+    if (thread_pool_find_task(pool, num, &task)) {
+      thread_pool_run_task(pool, &task);
+      continue;
+    }
+    /* the remaining tasks are processed by other threads, sleep until one of
+       them completes or new tasks arrive */
+    thread_pool_lock(pool);
+    while (*pending > 0 && pool->epoch == epoch)
+      thread_pool_wait(pool);
+    thread_pool_unlock(pool);
+  }
+}
+
+#ifdef GT_THREADS_ENABLED
+static void* thread_pool_worker_func(void *data)
+{
+  GtThreadPoolWorker *worker = data;
+  GtThreadPool *pool = worker->pool;
+  GtThreadPoolTask task;
+  (void) pthread_setspecific(worker_key, worker);
+  for (;;) {
+    GtUword epoch;
+    thread_pool_lock(pool);
+    if (pool->shutdown) {
+      thread_pool_unlock(pool);
+      break;
+    }
+    epoch = pool->epoch;
+    thread_pool_unlock(pool);
+    if (thread_pool_find_task(pool, worker->num, &task)) {
+      thread_pool_run_task(pool, &task);
+      continue;
+    }
+    thread_pool_lock(pool);
+    while (!pool->shutdown && pool->epoch == epoch)
+      thread_pool_wait(pool);
+    thread_pool_unlock(pool);
+  }
+  return NULL;
+}
+#endif
+
+static void thread_pool_stop_workers(GtThreadPool *pool)
+{
+  unsigned int idx;
+  thread_pool_lock(pool);
+  pool->shutdown = true;
+  thread_pool_broadcast(pool);
+  thread_pool_unlock(pool);
+  for (idx = 0; idx < pool->numofworkers; idx++) {
+    gt_thread_join(pool->threads[idx]);
+    gt_thread_delete(pool->threads[idx]);
+  }
+}
+
+static void thread_pool_free(GtThreadPool *pool)
+{
+  unsigned int idx;
+  for (idx = 0; idx <= pool->numofworkers; idx++)
+    thread_pool_deque_clean(pool->deques + idx);
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_cond_destroy(&pool->cond);
+  (void) pthread_mutex_destroy(&pool->lock);
+#endif
+  gt_free(pool->deques);
+  gt_free(pool->workerinfo);
+  gt_free(pool->threads);
+  gt_free(pool);
+}
+
+GtThreadPool* gt_thread_pool_new(unsigned int numofthreads,
+                                 GT_UNUSED GtError *err)
+{
+  GtThreadPool *pool;
+  unsigned int idx;
+  gt_error_check(err);
+  gt_assert(numofthreads > 0);
+  pool = gt_calloc(1, sizeof (*pool));
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_once(&worker_key_once, thread_pool_worker_key_create);
+  (void) pthread_mutex_init(&pool->lock, NULL);
+  (void) pthread_cond_init(&pool->cond, NULL);
+  pool->numofworkers = numofthreads - 1;
+#else
+  pool->numofworkers = 0;
+#endif
+  pool->deques = gt_malloc(sizeof (*pool->deques) * (pool->numofworkers + 1));
+  for (idx = 0; idx <= pool->numofworkers; idx++)
+    thread_pool_deque_init(pool->deques + idx);
+  pool->workerinfo = gt_malloc(sizeof (*pool->workerinfo)
+                               * (pool->numofworkers + 1));
+  pool->threads = gt_malloc(sizeof (*pool->threads)
+                            * (pool->numofworkers + 1));
+#ifdef GT_THREADS_ENABLED
+  for (idx = 0; idx < pool->numofworkers; idx++) {
+    pool->workerinfo[idx].pool = pool;
+    pool->workerinfo[idx].num = idx + 1;
+    pool->threads[idx] = gt_thread_new(thread_pool_worker_func,
+                                       pool->workerinfo + idx, err);
+    if (pool->threads[idx] == NULL) {
+      /* only stop the workers started so far */
+      unsigned int numofworkers = pool->numofworkers;
+      pool->numofworkers = idx;
+      thread_pool_stop_workers(pool);
+      pool->numofworkers = numofworkers;
+      thread_pool_free(pool);
+      return NULL;
+    }
+  }
+#endif
+  return pool;
+}
+
+void gt_thread_pool_delete(GtThreadPool *pool)
+{
+  unsigned int idx;
+  GtThreadPoolTask task;
+  if (!pool) return;
+  /* run tasks nobody has waited for */
+  for (idx = 0; idx <= pool->numofworkers; idx++) {
+    while (thread_pool_deque_pop(pool->deques + idx, &task))
+      thread_pool_run_task(pool, &task);
+  }
+  thread_pool_stop_workers(pool);
+  thread_pool_free(pool);
+}
+
+GtThreadPool* gt_thread_pool_get(void)
+{
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_lock(&default_pool_lock);
+#endif
+  if (default_pool == NULL) {
+    GtError *err = gt_error_new();
+    default_pool = gt_thread_pool_new(gt_jobs, err);
+    if (default_pool == NULL) {
+      /* fall back to processing all tasks in the calling thread */
+      default_pool = gt_thread_pool_new(1U, NULL);
+    }
+    gt_error_delete(err);
+  }
+#ifdef GT_THREADS_ENABLED
+  (void) pthread_mutex_unlock(&default_pool_lock);
+#endif
+  return default_pool;
+}
+
+void gt_thread_pool_clean(void)
+{
+  gt_thread_pool_delete(default_pool);
+  default_pool = NULL;
+}
+
+GtThreadPoolFuture* gt_thread_pool_submit(GtThreadPool *pool,
+                                          GtThreadFunc function, void *data)
+{
+  GtThreadPoolFuture *future;
+  gt_assert(pool && function);
+  future = gt_malloc(sizeof (*future));
+  future->pool = pool;
+  future->pending = 0;
+  future->result = NULL;
+  thread_pool_add_task(pool, function, data, &future->result,
+                       &future->pending);
+  return future;
+}
+
+void* gt_thread_pool_future_get(GtThreadPoolFuture *future)
+{
+  gt_assert(future);
+  thread_pool_help_until_done(future->pool, &future->pending);
+  return future->result;
+}
+
+void gt_thread_pool_future_delete(GtThreadPoolFuture *future)
+{
+  if (!future) return;
+  thread_pool_help_until_done(future->pool, &future->pending);
+  gt_free(future);
+}
+
+GtThreadPoolGroup* gt_thread_pool_group_new(GtThreadPool *pool)
+{
+  GtThreadPoolGroup *group;
+  gt_assert(pool);
+  group = gt_malloc(sizeof (*group));
+  group->pool = pool;
+  group->pending = 0;
+  return group;
+}
+
+void gt_thread_pool_group_submit(GtThreadPoolGroup *group,
+                                 GtThreadFunc function, void *data)
+{
+  gt_assert(group && function);
+  thread_pool_add_task(group->pool, function, data, NULL, &group->pending);
+}
+
+void gt_thread_pool_group_wait(GtThreadPoolGroup *group)
+{
+  gt_assert(group);
+  thread_pool_help_until_done(group->pool, &group->pending);
+}
+
+void gt_thread_pool_group_delete(GtThreadPoolGroup *group)
+{
+  if (!group) return;
+  gt_thread_pool_group_wait(group);
+  gt_free(group);
+}
+
+typedef struct {
+  GtThreadPoolGroup *group;
+  GtThreadPoolRangeFunc function;
+  void *data;
+  GtUword start,
+          end,
+          grainsize;
+} GtThreadPoolRange;
+
+static void* thread_pool_range_func(void *data)
+{
+  GtThreadPoolRange *range = data;
+  /* split off the upper half until the range is small enough, the halves are
+     stolen by idle threads */
+  while (range->end - range->start > range->grainsize) {
+    GtThreadPoolRange *upper = gt_malloc(sizeof (*upper));
+    *upper = *range;
+    upper->start = range->start + (range->end - range->start) / 2;
+    range->end = upper->start;
+    gt_thread_pool_group_submit(range->group, thread_pool_range_func, upper);
+  }
+  range->function(range->start, range->end, range->data);
+  gt_free(range);
+  return NULL;
+}
+
+void gt_thread_pool_parallel_for(GtThreadPool *pool, GtUword start,
+                                 GtUword end, GtUword grainsize,
+                                 GtThreadPoolRangeFunc function, void *data)
+{
+  GtThreadPoolGroup *group;
+  GtThreadPoolRange *range;
+  gt_assert(pool && function && start <= end);
+  if (start == end)
+    return;
+  if (grainsize == 0) {
+    grainsize = (end - start) / (GT_THREAD_POOL_RANGES_PER_THREAD
+                                 * gt_thread_pool_size(pool));
+    if (grainsize == 0)
+      grainsize = 1UL;
+  }
+  if (pool->numofworkers == 0 || end - start <= grainsize) {
+    function(start, end, data);
+    return;
+  }
+  group = gt_thread_pool_group_new(pool);
+  range = gt_malloc(sizeof (*range));
+  range->group = group;
+  range->function = function;
+  range->data = data;
+  range->start = start;
+  range->end = end;
+  range->grainsize = grainsize;
+  (void) thread_pool_range_func(range);
+  gt_thread_pool_group_delete(group);
+}
+
+#define GT_THREAD_POOL_TEST_SIZE 10000UL
+
+typedef struct {
+  GtUword *marks;
+  GtMutex *mutex;
+  GtUword sum;
+} GtThreadPoolTestInfo;
+
+static void thread_pool_test_mark(GtUword start, GtUword end, void *data)
+{
+  GtThreadPoolTestInfo *info = data;
+  GtUword idx, sum = 0;
+  for (idx = start; idx < end; idx++) {
+    info->marks[idx]++;
+    sum += idx;
+  }
+  gt_mutex_lock(info->mutex);
+  info->sum += sum;
+  gt_mutex_unlock(info->mutex);
+}
+
+static void* thread_pool_test_square(void *data)
+{
+  GtUword *value = data;
+  *value = *value * *value;
+  return value;
+}
+
+static void* thread_pool_test_nested(void *data)
+{
+  GtThreadPoolTestInfo *info = data;
+  gt_thread_pool_parallel_for(gt_thread_pool_get(), 0,
+                              GT_THREAD_POOL_TEST_SIZE, 7UL,
+                              thread_pool_test_mark, info);
+  return NULL;
+}
+
+int gt_thread_pool_unit_test(GtError *err)
+{
+  GtThreadPoolTestInfo info, nested[4];
+  GtThreadPoolFuture *futures[16];
+  GtThreadPoolGroup *group;
+  GtThreadPool *pool;
+  GtUword idx, values[16], grainsize;
+  int had_err = 0;
+  gt_error_check(err);
+
+  pool = gt_thread_pool_get();
+  gt_ensure(pool == gt_thread_pool_get());
+  gt_ensure(gt_thread_pool_thread_num(pool) == 0);
+  info.marks = gt_calloc(GT_THREAD_POOL_TEST_SIZE, sizeof (*info.marks));
+  info.mutex = gt_mutex_new();
+
+  /* parallel for with different grainsizes */
+  for (grainsize = 0; !had_err && grainsize < 5UL; grainsize++) {
+    memset(info.marks, 0, sizeof (*info.marks) * GT_THREAD_POOL_TEST_SIZE);
+    info.sum = 0;
+    gt_thread_pool_parallel_for(pool, 0, GT_THREAD_POOL_TEST_SIZE,
+                                grainsize * grainsize * 100,
+                                thread_pool_test_mark, &info);
+    for (idx = 0; !had_err && idx < GT_THREAD_POOL_TEST_SIZE; idx++)
+      gt_ensure(info.marks[idx] == 1UL);
+    gt_ensure(info.sum == GT_THREAD_POOL_TEST_SIZE
+                          * (GT_THREAD_POOL_TEST_SIZE - 1) / 2);
+  }
+
+  /* futures */
+  for (idx = 0; idx < 16UL; idx++) {
+    values[idx] = idx;
+    futures[idx] = gt_thread_pool_submit(pool, thread_pool_test_square,
+                                         values + idx);
+  }
+  for (idx = 0; idx < 16UL; idx++) {
+    gt_ensure(gt_thread_pool_future_get(futures[idx]) == values + idx);
+    gt_ensure(values[idx] == idx * idx);
+    gt_thread_pool_future_delete(futures[idx]);
+  }
+
+  /* groups of tasks which submit tasks themselves */
+  group = gt_thread_pool_group_new(pool);
+  for (idx = 0; idx < 4UL; idx++) {
+    nested[idx].marks = gt_calloc(GT_THREAD_POOL_TEST_SIZE,
+                                  sizeof (*nested[idx].marks));
+    nested[idx].mutex = info.mutex;
+    nested[idx].sum = 0;
+    gt_thread_pool_group_submit(group, thread_pool_test_nested, nested + idx);
+  }
+  gt_thread_pool_group_wait(group);
+  for (idx = 0; idx < 4UL; idx++) {
+    GtUword pos;
+    for (pos = 0; !had_err && pos < GT_THREAD_POOL_TEST_SIZE; pos++)
+      gt_ensure(nested[idx].marks[pos] == 1UL);
+    gt_ensure(nested[idx].sum == GT_THREAD_POOL_TEST_SIZE
+                                 * (GT_THREAD_POOL_TEST_SIZE - 1) / 2);
+    gt_free(nested[idx].marks);
+  }
+  gt_thread_pool_group_delete(group);
+
+  gt_mutex_delete(info.mutex);
+  gt_free(info.marks);
+  return had_err;
+}
@@ -0,0 +1,102 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include "core/error_api.h"
+#include "core/thread_api.h"
+#include "core/types_api.h"
+
+/* A <GtThreadPool> is a set of persistent worker threads which execute tasks.
+   Every worker owns a double ended queue of tasks. Tasks submitted by a worker
+   are pushed onto its own queue and processed in LIFO order, idle workers
+   steal the oldest tasks from the queues of the other workers. Tasks
+   submitted by threads which are not workers of the pool are put onto a
+   separate queue from which all workers steal.
+   A thread waiting for a future or a group does not block as long as there are
+   tasks to be done, it executes them instead. Hence tasks may themselves
+   submit tasks and wait for them. */
+typedef struct GtThreadPool GtThreadPool;
+
+/* A <GtThreadPoolFuture> refers to the result of a single submitted task. */
+typedef struct GtThreadPoolFuture GtThreadPoolFuture;
+
+/* A <GtThreadPoolGroup> collects submitted tasks such that one can wait for
+   all of them at once (i.e. it is a barrier). */
+typedef struct GtThreadPoolGroup GtThreadPoolGroup;
+
+/* Function processing the indices from <start> to <end> - 1. */
+typedef void (*GtThreadPoolRangeFunc)(GtUword start, GtUword end, void *data);
+
+/* Return the process-wide thread pool, which is created on first use with
+   <gt_jobs> - 1 workers (the calling thread is the remaining one). */
+GtThreadPool*       gt_thread_pool_get(void);
+/* Delete the process-wide thread pool, if it has been created. Called by
+   <gt_lib_clean()>. */
+void                gt_thread_pool_clean(void);
+
+/* Return a new <GtThreadPool> for <numofthreads> threads including the calling
+   thread, i.e. <numofthreads> - 1 worker threads are started. Without thread
+   support no workers are started and all tasks are run by the thread waiting
+   for them. Returns NULL and sets <err> if a thread could not be created. */
+GtThreadPool*       gt_thread_pool_new(unsigned int numofthreads, GtError *err);
+/* Return the number of threads processing tasks of <pool>, including one for
+   the thread waiting for the results. */
+unsigned int        gt_thread_pool_size(const GtThreadPool *pool);
+/* Return the number of the calling thread in <pool>. That is a number between
+   1 and <gt_thread_pool_size(pool)> - 1 for the workers of <pool> and 0 for
+   all other threads. Can be used to index per-thread scratch space. */
+unsigned int        gt_thread_pool_thread_num(const GtThreadPool *pool);
+/* Submit <function> with argument <data> to <pool> and return a future for its
+   result. */
+GtThreadPoolFuture* gt_thread_pool_submit(GtThreadPool *pool,
+                                          GtThreadFunc function, void *data);
+/* Apply <function> to all index ranges of at most <grainsize> elements in the
+   interval from <start> to <end> - 1, in parallel, and return when all of them
+   have been processed. The interval is split recursively, so that idle threads
+   can steal large subranges. If <grainsize> is 0, an appropriate size is
+   chosen with respect to the size of <pool>. */
+void                gt_thread_pool_parallel_for(GtThreadPool *pool,
+                                                GtUword start, GtUword end,
+                                                GtUword grainsize,
+                                                GtThreadPoolRangeFunc function,
+                                                void *data);
+/* Delete <pool> after all tasks submitted to it have been processed. */
+void                gt_thread_pool_delete(GtThreadPool *pool);
+
+/* Wait until the task referred to by <future> has been processed and return
+   its result. */
+void*               gt_thread_pool_future_get(GtThreadPoolFuture *future);
+/* Wait for the task referred to by <future> and delete <future>. */
+void                gt_thread_pool_future_delete(GtThreadPoolFuture *future);
+
+/* Return a new empty <GtThreadPoolGroup> for tasks in <pool>. */
+GtThreadPoolGroup*  gt_thread_pool_group_new(GtThreadPool *pool);
+/* Submit <function> with argument <data> to the pool of <group> and add the
+   task to <group>. */
+void                gt_thread_pool_group_submit(GtThreadPoolGroup *group,
+                                                GtThreadFunc function,
+                                                void *data);
+/* Wait until all tasks added to <group> have been processed. Afterwards
+   <group> can be reused. */
+void                gt_thread_pool_group_wait(GtThreadPoolGroup *group);
+/* Wait for all tasks of <group> and delete it. */
+void                gt_thread_pool_group_delete(GtThreadPoolGroup *group);
+
+int                 gt_thread_pool_unit_test(GtError *err);
+
+#endif
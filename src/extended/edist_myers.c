@@ -0,0 +1,380 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/assert_api.h"
+#include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/intbits.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "extended/edist_myers.h"
+
+/* The maximal number of lanes of the vectorized APM kernels, and the
+   minimal length of the window searched by one lane. */
+#define EDIST_MYERS_MAXLANES   4
+#define EDIST_MYERS_MINWINDOW  1024UL
+
+/* The lane vectors are aligned to their size. */
+#define EDIST_MYERS_LANEBYTES  (EDIST_MYERS_MAXLANES * sizeof (GtUword))
+
+/* The AVX2 kernel is only available for x86-64 compilers which support target
+   specific functions. */
+#if defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define EDIST_MYERS_AVX2
+#endif
+
+typedef struct {
+  GtUword endpos,
+          distance;
+} GtEdistMyersHit;
+
+struct GtEdistMyers {
+  GtUword patternlength,
+          alphasize,
+          numofblocks,
+          *eqs, /* (alphasize + 1) x numofblocks, the last row is zero */
+          *Pv,
+          *Mv,
+          numofhits[EDIST_MYERS_MAXLANES],
+          hitsalloc;
+  GtWord *score;
+  void *lanespacealloc,
+       *lanespace;
+  GtEdistMyersHit *hits;
+  void (*apm_lanes)(GtEdistMyers*, const GtUchar*, GtUword, GtUword, GtUword,
+                    GtUword, GtUword);
+  GtUword lanes;
+};
+
+/* generic kernel, vectorized for the baseline instruction set */
+#define EDIST_MYERS_TARGET
+#define EDIST_MYERS_FUNC(F)  F##_generic
+#define EDIST_MYERS_LANES    2
+#include "extended/edist_myers_apm.gen"
+#undef EDIST_MYERS_TARGET
+#undef EDIST_MYERS_FUNC
+#undef EDIST_MYERS_LANES
+
+#ifdef EDIST_MYERS_AVX2
+#define EDIST_MYERS_TARGET   __attribute__((target("avx2")))
+#define EDIST_MYERS_FUNC(F)  F##_avx2
+#define EDIST_MYERS_LANES    4
+#include "extended/edist_myers_apm.gen"
+#undef EDIST_MYERS_TARGET
+#undef EDIST_MYERS_FUNC
+#undef EDIST_MYERS_LANES
+#endif
+
+GtEdistMyers* gt_edist_myers_new(const GtUchar *pattern,
+                                 GtUword patternlength,
+                                 GtUword alphasize)
+{
+  GtEdistMyers *em;
+  GtUword i, numofblocks;
+
+  em = gt_malloc(sizeof *em);
+  numofblocks = patternlength == 0
+                ? 1UL
+                : (patternlength - 1) / GT_INTWORDSIZE + 1;
+  em->patternlength = patternlength;
+  em->alphasize = alphasize;
+  em->numofblocks = numofblocks;
+  em->eqs = gt_calloc((size_t) (alphasize + 1) * numofblocks,
+                      sizeof *em->eqs);
+  for (i = 0; i < patternlength; i++) {
+    if ((GtUword) pattern[i] < alphasize) {
+      em->eqs[pattern[i] * numofblocks + i / GT_INTWORDSIZE]
+        |= (1UL << (i % GT_INTWORDSIZE));
+    }
+  }
+  em->Pv = gt_malloc(sizeof *em->Pv * numofblocks);
+  em->Mv = gt_malloc(sizeof *em->Mv * numofblocks);
+  em->score = gt_malloc(sizeof *em->score * numofblocks);
+  em->lanespacealloc = gt_malloc(2 * numofblocks * EDIST_MYERS_LANEBYTES +
+                                 EDIST_MYERS_LANEBYTES);
+  em->lanespace = (void*) (((size_t) em->lanespacealloc +
+                            EDIST_MYERS_LANEBYTES - 1) &
+                           ~(EDIST_MYERS_LANEBYTES - 1));
+  em->hits = NULL;
+  em->hitsalloc = 0;
+  em->apm_lanes = edist_myers_apm_lanes_generic;
+  em->lanes = 2UL;
+#ifdef EDIST_MYERS_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    em->apm_lanes = edist_myers_apm_lanes_avx2;
+    em->lanes = 4UL;
+  }
+#endif
+  return em;
+}
+
+void gt_edist_myers_delete(GtEdistMyers *em)
+{
+  if (!em) return;
+  gt_free(em->hits);
+  gt_free(em->lanespacealloc);
+  gt_free(em->score);
+  gt_free(em->Mv);
+  gt_free(em->Pv);
+  gt_free(em->eqs);
+  gt_free(em);
+}
+
+#define EDIST_MYERS_BLOCKLENGTH(EM, B)\
+        ((B) + 1 < (EM)->numofblocks\
+         ? (GtWord) GT_INTWORDSIZE\
+         : (GtWord) ((EM)->patternlength - (B) * GT_INTWORDSIZE))
+
+/* Advance block <Pv>, <Mv> by one column with text character equality vector
+   <Eq> and the horizontal delta <hin> of the row above the block. Return the
+   horizontal delta of the last row of the block, which is given by
+   <highbit>. */
+static inline int edist_myers_advance_block(GtUword *Pv, GtUword *Mv,
+                                            GtUword Eq, int hin,
+                                            GtUword highbit)
+{
+  GtUword Xv, Xh, Ph, Mh,
+          hinP = hin > 0 ? 1UL : 0,
+          hinM = hin < 0 ? 1UL : 0;
+  int hout = 0;
+
+  Xv = Eq | *Mv;
+  Eq |= hinM;
+  Xh = (((Eq & *Pv) + *Pv) ^ *Pv) | Eq;
+  Ph = *Mv | ~(Xh | *Pv);
+  Mh = *Pv & Xh;
+  if (Ph & highbit)
+    hout = 1;
+  else if (Mh & highbit)
+    hout = -1;
+  Ph = (Ph << 1) | hinP;
+  Mh = (Mh << 1) | hinM;
+  *Pv = Mh | ~(Xv | Ph);
+  *Mv = Ph & Xv;
+  return hout;
+}
+
+GtUword gt_edist_myers_global(GtEdistMyers *em, const GtUchar *text,
+                              GtUword textlength, GtUword maxdistance)
+{
+  const GtUword m = em->patternlength,
+                lastbit = (1UL << ((m - 1) % GT_INTWORDSIZE));
+  GtUword j, b, k;
+  GtWord lastblock, kw;
+
+  gt_assert(em);
+  if (m == 0)
+    return textlength <= maxdistance ? textlength : maxdistance + 1;
+  k = MIN(maxdistance, MAX(m, textlength));
+  if ((m > textlength ? m - textlength : textlength - m) > k)
+    return maxdistance + 1;
+  kw = (GtWord) k;
+  lastblock = (GtWord) MIN(em->numofblocks - 1, k / GT_INTWORDSIZE);
+  for (b = 0; b <= (GtUword) lastblock; b++) {
+    em->Pv[b] = ~0UL;
+    em->Mv[b] = 0;
+    em->score[b] = (GtWord) MIN((b + 1) * GT_INTWORDSIZE, m);
+  }
+  for (j = 0; j < textlength; j++) {
+    const GtUword *eq = em->eqs + (text[j] < em->alphasize
+                                   ? (GtUword) text[j]
+                                   : em->alphasize) * em->numofblocks;
+    int hout = 1;
+    for (b = 0; b <= (GtUword) lastblock; b++) {
+      hout = edist_myers_advance_block(em->Pv + b, em->Mv + b, eq[b], hout,
+                                       b + 1 < em->numofblocks
+                                       ? (1UL << (GT_INTWORDSIZE - 1))
+                                       : lastbit);
+      em->score[b] += hout;
+    }
+    /* activate the next block, if it can contain values of at most k */
+    if ((GtUword) lastblock + 1 < em->numofblocks &&
+        em->score[lastblock] - hout <= kw &&
+        ((eq[lastblock + 1] & 1UL) || hout < 0)) {
+      lastblock++;
+      em->Pv[lastblock] = ~0UL;
+      em->Mv[lastblock] = 0;
+      em->score[lastblock]
+        = em->score[lastblock - 1] - hout +
+          EDIST_MYERS_BLOCKLENGTH(em, (GtUword) lastblock) +
+          edist_myers_advance_block(em->Pv + lastblock, em->Mv + lastblock,
+                                    eq[lastblock], hout,
+                                    (GtUword) lastblock + 1 < em->numofblocks
+                                    ? (1UL << (GT_INTWORDSIZE - 1))
+                                    : lastbit);
+    }
+    /* deactivate the last blocks, if all their values exceed k */
+    while (lastblock >= 0 &&
+           em->score[lastblock] >=
+           kw + EDIST_MYERS_BLOCKLENGTH(em, (GtUword) lastblock)) {
+      lastblock--;
+    }
+    if (lastblock < 0)
+      return maxdistance + 1;
+  }
+  if ((GtUword) lastblock + 1 == em->numofblocks &&
+      em->score[lastblock] <= kw) {
+    return (GtUword) em->score[lastblock];
+  }
+  return maxdistance + 1;
+}
+
+void gt_edist_myers_apm(GtEdistMyers *em, const GtUchar *text,
+                        GtUword textlength, GtUword startpos,
+                        GtUword maxdistance, GtEdistMyersMatchFunc process,
+                        void *info)
+{
+  GtUword warmup, windowlength, windowstart, l, i;
+
+  gt_assert(em && process);
+  if (em->patternlength == 0 || startpos >= textlength)
+    return;
+  /* a match with at most <maxdistance> errors is at most
+     <patternlength> + <maxdistance> characters long */
+  warmup = MIN(em->patternlength + maxdistance, textlength);
+  windowlength = MAX(EDIST_MYERS_MINWINDOW, 4 * warmup);
+  windowlength = MIN(windowlength,
+                     (textlength - startpos + em->lanes - 1) / em->lanes);
+  if (em->lanes * windowlength > em->hitsalloc) {
+    em->hitsalloc = em->lanes * windowlength;
+    em->hits = gt_realloc(em->hits, sizeof *em->hits * em->hitsalloc);
+  }
+  for (windowstart = startpos; windowstart < textlength;
+       windowstart += em->lanes * windowlength) {
+    em->apm_lanes(em, text, textlength, windowstart, windowlength, warmup,
+                  maxdistance);
+    for (l = 0; l < em->lanes; l++) {
+      const GtEdistMyersHit *hits = em->hits + l * windowlength;
+      for (i = 0; i < em->numofhits[l]; i++)
+        process(info, hits[i].endpos, hits[i].distance);
+    }
+  }
+}
+
+/* the edit distance of <u> and <v> in the unit cost model, where only codes
+   smaller than <alphasize> match */
+static GtUword edist_myers_dp(const GtUchar *u, GtUword n, const GtUchar *v,
+                              GtUword m, GtUword alphasize, bool apm,
+                              GtUword *column)
+{
+  GtUword i, j, nw, we;
+  for (i = 0; i <= n; i++)
+    column[i] = i;
+  for (j = 1; j <= m; j++) {
+    nw = column[0];
+    column[0] = apm ? 0 : j;
+    for (i = 1; i <= n; i++) {
+      we = column[i];
+      column[i] = nw + (u[i-1] == v[j-1] && u[i-1] < alphasize ? 0 : 1);
+      if (column[i-1] + 1 < column[i])
+        column[i] = column[i-1] + 1;
+      if (we + 1 < column[i])
+        column[i] = we + 1;
+      nw = we;
+    }
+  }
+  return column[n];
+}
+
+typedef struct {
+  GtUword numofhits,
+          lastendpos,
+          *distances;
+  bool ordered;
+} EdistMyersTestHits;
+
+static void edist_myers_test_hit(void *info, GtUword endpos, GtUword distance)
+{
+  EdistMyersTestHits *hits = info;
+  if (hits->numofhits > 0 && endpos <= hits->lastendpos)
+    hits->ordered = false;
+  hits->lastendpos = endpos;
+  hits->numofhits++;
+  hits->distances[endpos] = distance;
+}
+
+int gt_edist_myers_unit_test(GtError *err)
+{
+  const GtUword alphasize = 4UL,
+                maxlength = 300UL;
+  GtUchar *u, *v;
+  GtUword *column, *distances, r;
+  int had_err = 0;
+
+  gt_error_check(err);
+  u = gt_malloc(sizeof *u * maxlength);
+  v = gt_malloc(sizeof *v * maxlength);
+  column = gt_malloc(sizeof *column * (maxlength + 1));
+  distances = gt_malloc(sizeof *distances * maxlength);
+  for (r = 0; !had_err && r < 200UL; r++) {
+    GtEdistMyers *em;
+    EdistMyersTestHits hits;
+    GtUword n = 1UL + gt_rand_max(maxlength - 2),
+            m = gt_rand_max(maxlength - 1),
+            maxdistance = gt_rand_max(n + 1),
+            i, j, edist, expected = 0;
+
+    /* <v> is a mutated copy of <u>, to obtain small distances, which contains
+       wildcards and separators */
+    for (i = 0; i < n; i++)
+      u[i] = (GtUchar) gt_rand_max(alphasize);
+    for (j = 0; j < m; j++) {
+      v[j] = j < n && gt_rand_max(3UL) > 0
+             ? u[j]
+             : (GtUchar) gt_rand_max(alphasize);
+    }
+    em = gt_edist_myers_new(u, n, alphasize);
+    edist = edist_myers_dp(u, n, v, m, alphasize, false, column);
+    gt_ensure(gt_edist_myers_global(em, v, m, GT_UWORD_MAX) == edist);
+    gt_ensure(gt_edist_myers_global(em, v, m, maxdistance)
+              == MIN(edist, maxdistance + 1));
+
+    if (m > 0 && (i = gt_rand_max(m)) < m)
+      v[i] = (GtUchar) SEPARATOR;
+    hits.numofhits = 0;
+    hits.lastendpos = 0;
+    hits.distances = distances;
+    hits.ordered = true;
+    for (j = 0; j < m; j++)
+      distances[j] = GT_UWORD_MAX;
+    gt_edist_myers_apm(em, v, m, 0, maxdistance, edist_myers_test_hit, &hits);
+    gt_ensure(hits.ordered);
+    for (j = 0; !had_err && j < m; j++) {
+      GtUword start = j, dist = GT_UWORD_MAX;
+      while (start > 0 && v[start - 1] != (GtUchar) SEPARATOR)
+        start--;
+      if (v[j] != (GtUchar) SEPARATOR) {
+        dist = edist_myers_dp(u, n, v + start, j + 1 - start, alphasize, true,
+                              column);
+        if (dist > maxdistance)
+          dist = GT_UWORD_MAX;
+        else
+          expected++;
+      }
+      gt_ensure(distances[j] == dist);
+    }
+    gt_ensure(hits.numofhits == expected);
+    gt_edist_myers_delete(em);
+  }
+  gt_free(distances);
+  gt_free(column);
+  gt_free(v);
+  gt_free(u);
+  return had_err;
+}
@@ -0,0 +1,66 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef EDIST_MYERS_H
+#define EDIST_MYERS_H
+
+#include "core/error.h"
+
+/* The <GtEdistMyers> class implements the bit-parallel edit distance
+   computation of Myers (J. ACM 46(3), 1999) for patterns of arbitrary length,
+   which are split into blocks of one machine word each (Hyyroe, 2003).
+   Patterns and texts are sequences of codes. Codes smaller than the alphabet
+   size match themselves, all other codes (e.g. wildcards) match nothing. */
+typedef struct GtEdistMyers GtEdistMyers;
+
+/* Is called for every end position <endpos> of an approximate match with
+   <distance> found by <gt_edist_myers_apm()>. */
+typedef void (*GtEdistMyersMatchFunc)(void *info, GtUword endpos,
+                                      GtUword distance);
+
+/* Return a new <GtEdistMyers> object for <pattern> of length <patternlength>
+   over an alphabet of size <alphasize>. */
+GtEdistMyers* gt_edist_myers_new(const GtUchar *pattern,
+                                 GtUword patternlength,
+                                 GtUword alphasize);
+
+/* Return the edit distance of the pattern of <em> and <text> of length
+   <textlength>, if it is at most <maxdistance>, and <maxdistance> + 1
+   otherwise. Only the blocks of the DP matrix which can contain values of at
+   most <maxdistance> are evaluated (Ukkonen's cut-off), thus a small
+   <maxdistance> results in a banded computation. Use <GT_UWORD_MAX> as
+   <maxdistance> to compute the full matrix. */
+GtUword       gt_edist_myers_global(GtEdistMyers *em, const GtUchar *text,
+                                    GtUword textlength, GtUword maxdistance);
+
+/* Search <text> of length <textlength> for approximate matches of the pattern
+   of <em> with at most <maxdistance> errors and call <process> with <info> for
+   every end position in <text> from <startpos> on, in ascending order. The
+   characters before <startpos> are only used as context. A <SEPARATOR> in
+   <text> ends a sequence, no match spans it.
+   The text is split into windows, which are searched simultaneously in the
+   lanes of a SIMD register. */
+void          gt_edist_myers_apm(GtEdistMyers *em, const GtUchar *text,
+                                 GtUword textlength, GtUword startpos,
+                                 GtUword maxdistance,
+                                 GtEdistMyersMatchFunc process, void *info);
+
+/* Delete <em>. */
+void          gt_edist_myers_delete(GtEdistMyers *em);
+
+int           gt_edist_myers_unit_test(GtError *err);
+
+#endif
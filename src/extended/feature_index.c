@@ -172,18 +172,16 @@ int  gt_feature_index_remove_node(GtFeatureIndex *feature_index,
   return ret;
 }
 
-int gt_feature_index_add_gff3file(GtFeatureIndex *feature_index,
-                                  const char *gff3file, GtError *err)
+static int feature_index_add_gff3_stream(GtFeatureIndex *feature_index,
+                                         GtNodeStream *gff3_in_stream,
+                                         GtError *err)
 {
-  GtNodeStream *gff3_in_stream;
   GtGenomeNode *gn;
   GtArray *tmp;
   int had_err = 0;
   GtUword i;
   gt_error_check(err);
-  gt_assert(feature_index && gff3file);
   tmp = gt_array_new(sizeof (GtGenomeNode*));
-  gff3_in_stream = gt_gff3_in_stream_new_unsorted(1, &gff3file);
   while (!(had_err = gt_node_stream_next(gff3_in_stream, &gn, err)) && gn)
     gt_array_add(tmp, gn);
   if (!had_err) {
@@ -196,13 +194,45 @@ int gt_feature_index_add_gff3file(GtFeatureIndex *feature_index,
     }
     gt_node_visitor_delete(feature_visitor);
   }
-  gt_node_stream_delete(gff3_in_stream);
   for (i=0;i<gt_array_size(tmp);i++)
     gt_genome_node_delete(*(GtGenomeNode**) gt_array_get(tmp, i));
   gt_array_delete(tmp);
   return had_err;
 }
 
+int gt_feature_index_add_gff3file(GtFeatureIndex *feature_index,
+                                  const char *gff3file, GtError *err)
+{
+  GtNodeStream *gff3_in_stream;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(feature_index && gff3file);
+  gff3_in_stream = gt_gff3_in_stream_new_unsorted(1, &gff3file);
+  had_err = feature_index_add_gff3_stream(feature_index, gff3_in_stream, err);
+  gt_node_stream_delete(gff3_in_stream);
+  return had_err;
+}
+
+int gt_feature_index_add_gff3file_region(GtFeatureIndex *feature_index,
+                                         const char *gff3file,
+                                         const char *seqid,
+                                         const GtRange *range, GtError *err)
+{
+  GtNodeStream *gff3_in_stream;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(feature_index && gff3file && seqid && range);
+  gff3_in_stream = gt_gff3_in_stream_new_unsorted(1, &gff3file);
+  had_err = gt_gff3_in_stream_restrict_to_region(gff3_in_stream, seqid, range,
+                                                 err);
+  if (!had_err) {
+    had_err = feature_index_add_gff3_stream(feature_index, gff3_in_stream,
+                                            err);
+  }
+  gt_node_stream_delete(gff3_in_stream);
+  return had_err;
+}
+
 GtArray* gt_feature_index_get_features_for_seqid(GtFeatureIndex *fi,
                                                  const char *seqid,
                                                  GtError *err)
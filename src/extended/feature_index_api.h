@@ -51,6 +51,16 @@ int         gt_feature_index_remove_node(GtFeatureIndex *feature_index,
    valid. Otherwise, <feature_index> is not changed and <err> is set. */
 int         gt_feature_index_add_gff3file(GtFeatureIndex *feature_index,
                                           const char *gff3file, GtError *err);
+/* Add the features contained in <gff3file> which lie on sequence region
+   <seqid> and overlap <range> to <feature_index>. <gff3file> must be sorted,
+   BGZF compressed and indexed with `gt gff3index`, only the part of it which
+   contains the requested features is read. If an error occurs,
+   <feature_index> is not changed and <err> is set. */
+int         gt_feature_index_add_gff3file_region(GtFeatureIndex *feature_index,
+                                                 const char *gff3file,
+                                                 const char *seqid,
+                                                 const GtRange *range,
+                                                 GtError *err);
 /* Returns an array of <GtFeatureNodes> associated with a given sequence region
    identifier <seqid>. */
 GtArray*    gt_feature_index_get_features_for_seqid(GtFeatureIndex*,
@@ -0,0 +1,1373 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/class_alloc_lock.h"
+#include "core/cstr_api.h"
+#include "core/cstr_table.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap.h"
+#include "core/hashmap-generic.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/range.h"
+#include "core/thread_api.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_index_disk.h"
+#include "extended/feature_index_memory_api.h"
+#include "extended/feature_index_rep.h"
+#include "extended/feature_index.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/genome_node.h"
+#include "extended/region_node_api.h"
+
+#define GT_FEATURE_INDEX_DISK_MAGIC "GTFIDX01"
+#define GT_FEATURE_INDEX_DISK_MAGICLEN 8
+
+/* All offsets in the header are byte offsets from the start of the file. The
+   sections are stored in the order of the header fields, each of them aligned
+   to the size of a <GtUword>. */
+typedef struct {
+  char magic[GT_FEATURE_INDEX_DISK_MAGICLEN];
+  GtUword wordsize,
+          numofseqids,
+          firstseqid,
+          numofintervals,
+          numofrecordwords,
+          stringslength,
+          seqidsoffset,
+          intervalsoffset,
+          recordsoffset,
+          stringsoffset,
+          filesize;
+} GtFeatureIndexDiskHeader;
+
+/* The sequence regions are sorted by their names, which are given as offsets
+   into the string table. */
+typedef struct {
+  GtUword seqid,
+          has_region,
+          region_start,
+          region_end,
+          dyn_start,
+          dyn_end,
+          firstinterval,
+          numofintervals;
+} GtFeatureIndexDiskSeqid;
+
+/* The intervals of a sequence region are sorted by start position. <maxend> is
+   the maximum end position of all intervals up to the current one, it allows
+   to find the first interval overlapping a query by binary search. <record> is
+   the offset of the feature tree in the record section, in words. */
+typedef struct {
+  GtUword start,
+          end,
+          maxend,
+          record;
+} GtFeatureIndexDiskInterval;
+
+/* A record stores the number of nodes of a feature tree, followed by the nodes
+   in breadth first order. Each node consists of the fields below, followed by
+   <numofattributes> pairs of string offsets and the <numofchildren> indices of
+   its children in the record. */
+enum {
+  GT_FID_FLAGS,
+  GT_FID_TYPE,
+  GT_FID_SOURCE,
+  GT_FID_FILENAME,
+  GT_FID_LINE,
+  GT_FID_START,
+  GT_FID_END,
+  GT_FID_SCORE,
+  GT_FID_MULTIREP,
+  GT_FID_NUMOFATTRIBUTES,
+  GT_FID_NUMOFCHILDREN,
+  GT_FID_NODESIZE
+};
+
+#define GT_FID_PSEUDO        ((GtUword) 1)
+#define GT_FID_HAS_SCORE     ((GtUword) 2)
+#define GT_FID_STRAND_SHIFT  2
+#define GT_FID_PHASE_SHIFT   5
+#define GT_FID_FIELD_MASK    ((GtUword) 7)
+
+struct GtFeatureIndexDisk {
+  const GtFeatureIndex parent_instance;
+  GtStr *filename;
+  void *map;
+  const GtFeatureIndexDiskSeqid *seqids;
+  const GtFeatureIndexDiskInterval *intervals;
+  const GtUword *records;
+  const char *strings;
+  GtUword numofseqids,
+          firstseqid,
+          numofintervals;
+  /* feature trees created so far, for each interval */
+  GtFeatureNode **nodes;
+  bool *removed;
+  /* strings shared by the created nodes, by position in the string table */
+  GtHashmap *strs;
+  /* nodes added since the file was mapped */
+  GtFeatureIndex *added;
+  GtMutex *mutex;
+};
+
+#define gt_feature_index_disk_cast(FI)\
+        gt_feature_index_cast(gt_feature_index_disk_class(), FI)
+
+DECLARE_HASHMAP(char*, cstr, GtUword, ul, static, inline)
+DEFINE_HASHMAP(char*, cstr, GtUword, ul, gt_ht_cstr_elem_hash,
+               gt_ht_cstr_elem_cmp, gt_free, NULL_DESTRUCTOR, static, inline)
+
+DECLARE_HASHMAP(GtFeatureNode*, node, GtUword, ul, static, inline)
+DEFINE_HASHMAP(GtFeatureNode*, node, GtUword, ul, gt_ht_ptr_elem_hash,
+               gt_ht_ptr_elem_cmp, NULL_DESTRUCTOR, NULL_DESTRUCTOR, static,
+               inline)
+
+static int feature_index_disk_cmp_range_start(const void *v1, const void *v2)
+{
+  return gt_genome_node_compare((GtGenomeNode**) v1, (GtGenomeNode**) v2);
+}
+
+/* writing */
+
+/* Returns the node of the tree <gn> which determines its position in the
+   input, that is the first child for pseudo-features. */
+static GtGenomeNode* feature_index_disk_origin(GtGenomeNode *gn)
+{
+  GtFeatureNode *fn = (GtFeatureNode*) gn;
+  if (gt_genome_node_get_line_number(gn) == 0
+        && gt_feature_node_is_pseudo(fn)) {
+    GtFeatureNodeIterator *fni = gt_feature_node_iterator_new_direct(fn);
+    GtFeatureNode *child = gt_feature_node_iterator_next(fni);
+    gt_feature_node_iterator_delete(fni);
+    if (child)
+      return (GtGenomeNode*) child;
+  }
+  return gn;
+}
+
+/* Orders features with equal ranges by their position in the input. */
+static int feature_index_disk_cmp_roots(const void *v1, const void *v2)
+{
+  GtGenomeNode *gn1 = *(GtGenomeNode**) v1,
+               *gn2 = *(GtGenomeNode**) v2;
+  unsigned int line1, line2;
+  int rval;
+  if ((rval = gt_genome_node_cmp(gn1, gn2)) != 0)
+    return rval;
+  gn1 = feature_index_disk_origin(gn1);
+  gn2 = feature_index_disk_origin(gn2);
+  if ((rval = strcmp(gt_genome_node_get_filename(gn1),
+                     gt_genome_node_get_filename(gn2))) != 0)
+    return rval;
+  line1 = gt_genome_node_get_line_number(gn1);
+  line2 = gt_genome_node_get_line_number(gn2);
+  return line1 < line2 ? -1 : (line1 > line2 ? 1 : 0);
+}
+
+typedef struct {
+  GtArray *seqids,
+          *intervals,
+          *records;
+  GtStr *strings;
+  GtHashtable *stringoffsets;
+} GtFeatureIndexDiskWriter;
+
+typedef struct {
+  GtFeatureIndexDiskWriter *writer;
+  GtUword numofattributes;
+} GtFeatureIndexDiskAttributeInfo;
+
+static GtFeatureIndexDiskWriter* feature_index_disk_writer_new(void)
+{
+  GtFeatureIndexDiskWriter *writer = gt_malloc(sizeof *writer);
+  writer->seqids = gt_array_new(sizeof (GtFeatureIndexDiskSeqid));
+  writer->intervals = gt_array_new(sizeof (GtFeatureIndexDiskInterval));
+  writer->records = gt_array_new(sizeof (GtUword));
+  writer->strings = gt_str_new();
+  writer->stringoffsets = cstr_ul_gt_hashmap_new();
+  return writer;
+}
+
+static void feature_index_disk_writer_delete(GtFeatureIndexDiskWriter *writer)
+{
+  if (!writer) return;
+  gt_array_delete(writer->seqids);
+  gt_array_delete(writer->intervals);
+  gt_array_delete(writer->records);
+  gt_str_delete(writer->strings);
+  cstr_ul_gt_hashmap_delete(writer->stringoffsets);
+  gt_free(writer);
+}
+
+static GtUword feature_index_disk_writer_string(GtFeatureIndexDiskWriter
+                                                                       *writer,
+                                                const char *cstr)
+{
+  GtUword *offset, newoffset;
+  offset = cstr_ul_gt_hashmap_get(writer->stringoffsets, (char*) cstr);
+  if (offset)
+    return *offset;
+  newoffset = gt_str_length(writer->strings);
+  gt_str_append_cstr(writer->strings, cstr);
+  gt_str_append_char(writer->strings, '\0');
+  cstr_ul_gt_hashmap_add(writer->stringoffsets, gt_cstr_dup(cstr), newoffset);
+  return newoffset;
+}
+
+static void feature_index_disk_writer_attribute(const char *attr_name,
+                                                const char *attr_value,
+                                                void *data)
+{
+  GtFeatureIndexDiskAttributeInfo *info =
+                                       (GtFeatureIndexDiskAttributeInfo*) data;
+  GtUword offset;
+  offset = feature_index_disk_writer_string(info->writer, attr_name);
+  gt_array_add(info->writer->records, offset);
+  offset = feature_index_disk_writer_string(info->writer, attr_value);
+  gt_array_add(info->writer->records, offset);
+  info->numofattributes++;
+}
+
+static GtUword feature_index_disk_writer_tree(GtFeatureIndexDiskWriter *writer,
+                                              GtFeatureNode *root)
+{
+  GtArray *nodes;
+  GtHashtable *nodenums;
+  GtFeatureIndexDiskAttributeInfo info;
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child;
+  GtUword i, recordoffset, numofnodes;
+
+  /* number the nodes in breadth first order, a node with several parents
+     gets the number of its first occurrence */
+  nodes = gt_array_new(sizeof (GtFeatureNode*));
+  nodenums = node_ul_gt_hashmap_new();
+  gt_array_add(nodes, root);
+  node_ul_gt_hashmap_add(nodenums, root, 0);
+  for (i = 0; i < gt_array_size(nodes); i++) {
+    fn = *(GtFeatureNode**) gt_array_get(nodes, i);
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      if (!node_ul_gt_hashmap_get(nodenums, child)) {
+        node_ul_gt_hashmap_add(nodenums, child, gt_array_size(nodes));
+        gt_array_add(nodes, child);
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+
+  recordoffset = gt_array_size(writer->records);
+  numofnodes = gt_array_size(nodes);
+  gt_array_add(writer->records, numofnodes);
+  info.writer = writer;
+  for (i = 0; i < numofnodes; i++) {
+    GtUword fields[GT_FID_NODESIZE], nodeoffset, k, numofchildren = 0;
+    GtGenomeNode *gn;
+    GtRange range;
+    float score;
+    fn = *(GtFeatureNode**) gt_array_get(nodes, i);
+    gn = (GtGenomeNode*) fn;
+    range = gt_genome_node_get_range(gn);
+    fields[GT_FID_FLAGS] =
+                   ((GtUword) gt_feature_node_get_strand(fn)
+                    << GT_FID_STRAND_SHIFT)
+                   | ((GtUword) gt_feature_node_get_phase(fn)
+                      << GT_FID_PHASE_SHIFT);
+    fields[GT_FID_TYPE] = GT_UNDEF_UWORD;
+    if (gt_feature_node_is_pseudo(fn))
+      fields[GT_FID_FLAGS] |= GT_FID_PSEUDO;
+    else {
+      fields[GT_FID_TYPE] =
+              feature_index_disk_writer_string(writer,
+                                               gt_feature_node_get_type(fn));
+    }
+    fields[GT_FID_SOURCE] = GT_UNDEF_UWORD;
+    if (gt_feature_node_has_source(fn)) {
+      fields[GT_FID_SOURCE] =
+            feature_index_disk_writer_string(writer,
+                                             gt_feature_node_get_source(fn));
+    }
+    fields[GT_FID_FILENAME] = GT_UNDEF_UWORD;
+    fields[GT_FID_LINE] = (GtUword) gt_genome_node_get_line_number(gn);
+    if (fields[GT_FID_LINE] > 0) {
+      fields[GT_FID_FILENAME] =
+              feature_index_disk_writer_string(writer,
+                                               gt_genome_node_get_filename(gn));
+    }
+    fields[GT_FID_START] = range.start;
+    fields[GT_FID_END] = range.end;
+    fields[GT_FID_SCORE] = 0;
+    if (gt_feature_node_score_is_defined(fn)) {
+      fields[GT_FID_FLAGS] |= GT_FID_HAS_SCORE;
+      score = gt_feature_node_get_score(fn);
+      memcpy(fields + GT_FID_SCORE, &score, sizeof (score));
+    }
+    fields[GT_FID_MULTIREP] = GT_UNDEF_UWORD;
+    if (gt_feature_node_is_multi(fn) && !gt_feature_node_is_pseudo(fn)) {
+      GtUword *repnum;
+      repnum = node_ul_gt_hashmap_get(nodenums,
+                                 gt_feature_node_get_multi_representative(fn));
+      /* a representative outside of this tree is replaced by the node */
+      fields[GT_FID_MULTIREP] = repnum ? *repnum : i;
+    }
+    fields[GT_FID_NUMOFATTRIBUTES] = 0;
+    fields[GT_FID_NUMOFCHILDREN] = 0;
+    nodeoffset = gt_array_size(writer->records);
+    for (k = 0; k < (GtUword) GT_FID_NODESIZE; k++)
+      gt_array_add(writer->records, fields[k]);
+
+    info.numofattributes = 0;
+    gt_feature_node_foreach_attribute(fn, feature_index_disk_writer_attribute,
+                                      &info);
+    fni = gt_feature_node_iterator_new_direct(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      GtUword childnum = *node_ul_gt_hashmap_get(nodenums, child);
+      gt_array_add(writer->records, childnum);
+      numofchildren++;
+    }
+    gt_feature_node_iterator_delete(fni);
+    *(GtUword*) gt_array_get(writer->records,
+                             nodeoffset + GT_FID_NUMOFATTRIBUTES)
+      = info.numofattributes;
+    *(GtUword*) gt_array_get(writer->records,
+                             nodeoffset + GT_FID_NUMOFCHILDREN)
+      = numofchildren;
+  }
+  node_ul_gt_hashmap_delete(nodenums);
+  gt_array_delete(nodes);
+  return recordoffset;
+}
+
+/* Adds the sequence region <seqid> with the top-level features <roots>, which
+   are sorted by this function. <region> is NULL if there is no region node. */
+static void feature_index_disk_writer_add_seqid(GtFeatureIndexDiskWriter
+                                                                       *writer,
+                                                const char *seqid,
+                                                const GtRange *region,
+                                                GtArray *roots)
+{
+  GtFeatureIndexDiskSeqid entry;
+  GtUword i, maxend = 0;
+
+  entry.seqid = feature_index_disk_writer_string(writer, seqid);
+  entry.has_region = region ? 1UL : 0;
+  entry.region_start = region ? region->start : 0;
+  entry.region_end = region ? region->end : 0;
+  entry.dyn_start = GT_UNDEF_UWORD;
+  entry.dyn_end = 0;
+  entry.firstinterval = gt_array_size(writer->intervals);
+  entry.numofintervals = gt_array_size(roots);
+  gt_array_sort_stable(roots, feature_index_disk_cmp_roots);
+  for (i = 0; i < gt_array_size(roots); i++) {
+    GtFeatureNode *fn = *(GtFeatureNode**) gt_array_get(roots, i);
+    GtRange range = gt_genome_node_get_range((GtGenomeNode*) fn);
+    GtFeatureIndexDiskInterval interval;
+    maxend = MAX(maxend, range.end);
+    interval.start = range.start;
+    interval.end = range.end;
+    interval.maxend = maxend;
+    interval.record = feature_index_disk_writer_tree(writer, fn);
+    gt_array_add(writer->intervals, interval);
+    entry.dyn_start = MIN(entry.dyn_start, range.start);
+    entry.dyn_end = MAX(entry.dyn_end, range.end);
+  }
+  gt_array_add(writer->seqids, entry);
+}
+
+static int feature_index_disk_cmp_seqid(const void *v1, const void *v2,
+                                        void *data)
+{
+  const GtFeatureIndexDiskSeqid *s1 = v1, *s2 = v2;
+  const char *strings = data;
+  return strcmp(strings + s1->seqid, strings + s2->seqid);
+}
+
+static int feature_index_disk_writer_write(GtFeatureIndexDiskWriter *writer,
+                                           const char *filename,
+                                           const char *firstseqid,
+                                           GtError *err)
+{
+  GtFeatureIndexDiskHeader header;
+  GtStr *tmpfilename;
+  GtUword i;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+
+  while (gt_str_length(writer->strings) % sizeof (GtUword) != 0)
+    gt_str_append_char(writer->strings, '\0');
+  gt_array_sort_with_data(writer->seqids, feature_index_disk_cmp_seqid,
+                          gt_str_get_mem(writer->strings));
+
+  memset(&header, 0, sizeof (header));
+  memcpy(header.magic, GT_FEATURE_INDEX_DISK_MAGIC,
+         (size_t) GT_FEATURE_INDEX_DISK_MAGICLEN);
+  header.wordsize = (GtUword) sizeof (GtUword);
+  header.numofseqids = gt_array_size(writer->seqids);
+  header.firstseqid = 0;
+  for (i = 0; firstseqid != NULL && i < header.numofseqids; i++) {
+    GtFeatureIndexDiskSeqid *entry = gt_array_get(writer->seqids, i);
+    if (strcmp(gt_str_get(writer->strings) + entry->seqid, firstseqid) == 0) {
+      header.firstseqid = i;
+      break;
+    }
+  }
+  header.numofintervals = gt_array_size(writer->intervals);
+  header.numofrecordwords = gt_array_size(writer->records);
+  header.stringslength = gt_str_length(writer->strings);
+  header.seqidsoffset = sizeof (header);
+  header.intervalsoffset = header.seqidsoffset
+                           + header.numofseqids
+                             * sizeof (GtFeatureIndexDiskSeqid);
+  header.recordsoffset = header.intervalsoffset
+                         + header.numofintervals
+                           * sizeof (GtFeatureIndexDiskInterval);
+  header.stringsoffset = header.recordsoffset
+                         + header.numofrecordwords * sizeof (GtUword);
+  header.filesize = header.stringsoffset + header.stringslength;
+
+  /* write to a temporary file first, so that a mapped index is not
+     overwritten while it is in use */
+  tmpfilename = gt_str_new_cstr(filename);
+  gt_str_append_cstr(tmpfilename, ".tmp");
+  if (!(fp = gt_fa_fopen(gt_str_get(tmpfilename), "wb", err)))
+    had_err = -1;
+  if (!had_err) {
+    gt_xfwrite(&header, sizeof (header), (size_t) 1, fp);
+    if (header.numofseqids > 0)
+      gt_xfwrite(gt_array_get_space(writer->seqids),
+                 sizeof (GtFeatureIndexDiskSeqid),
+                 (size_t) header.numofseqids, fp);
+    if (header.numofintervals > 0)
+      gt_xfwrite(gt_array_get_space(writer->intervals),
+                 sizeof (GtFeatureIndexDiskInterval),
+                 (size_t) header.numofintervals, fp);
+    if (header.numofrecordwords > 0)
+      gt_xfwrite(gt_array_get_space(writer->records), sizeof (GtUword),
+                 (size_t) header.numofrecordwords, fp);
+    if (header.stringslength > 0)
+      gt_xfwrite(gt_str_get_mem(writer->strings), sizeof (char),
+                 (size_t) header.stringslength, fp);
+    gt_fa_xfclose(fp);
+    if (rename(gt_str_get(tmpfilename), filename) != 0) {
+      gt_error_set(err, "could not rename \"%s\" to \"%s\": %s",
+                   gt_str_get(tmpfilename), filename, strerror(errno));
+      gt_xremove(gt_str_get(tmpfilename));
+      had_err = -1;
+    }
+  }
+  gt_str_delete(tmpfilename);
+  return had_err;
+}
+
+/* reading */
+
+static int feature_index_disk_map(GtFeatureIndexDisk *fid, GtError *err)
+{
+  const GtFeatureIndexDiskHeader *header;
+  const char *filename = gt_str_get(fid->filename);
+  size_t len;
+  gt_error_check(err);
+
+  if (!(fid->map = gt_fa_mmap_read(filename, &len, err)))
+    return -1;
+  header = fid->map;
+  if (len < sizeof (*header)
+        || memcmp(header->magic, GT_FEATURE_INDEX_DISK_MAGIC,
+                  (size_t) GT_FEATURE_INDEX_DISK_MAGICLEN) != 0) {
+    gt_error_set(err, "file \"%s\" is not a feature index", filename);
+    return -1;
+  }
+  if (header->wordsize != (GtUword) sizeof (GtUword)) {
+    gt_error_set(err, "feature index \"%s\" was created for "GT_WU"-bit "
+                 "words, but this program uses %d-bit words", filename,
+                 header->wordsize * CHAR_BIT,
+                 (int) sizeof (GtUword) * CHAR_BIT);
+    return -1;
+  }
+  if (header->filesize != (GtUword) len
+        || header->seqidsoffset != (GtUword) sizeof (*header)
+        || header->numofseqids > (len - header->seqidsoffset)
+                                 / sizeof (GtFeatureIndexDiskSeqid)
+        || header->intervalsoffset != header->seqidsoffset
+                                      + header->numofseqids
+                                        * sizeof (GtFeatureIndexDiskSeqid)
+        || header->numofintervals > (len - header->intervalsoffset)
+                                    / sizeof (GtFeatureIndexDiskInterval)
+        || header->recordsoffset != header->intervalsoffset
+                                    + header->numofintervals
+                                      * sizeof (GtFeatureIndexDiskInterval)
+        || header->numofrecordwords > (len - header->recordsoffset)
+                                      / sizeof (GtUword)
+        || header->stringsoffset != header->recordsoffset
+                                    + header->numofrecordwords
+                                      * sizeof (GtUword)
+        || header->stringslength != len - header->stringsoffset
+        || (header->numofseqids > 0
+              && header->firstseqid >= header->numofseqids)) {
+    gt_error_set(err, "feature index \"%s\" is corrupt", filename);
+    return -1;
+  }
+  fid->numofseqids = header->numofseqids;
+  fid->firstseqid = header->firstseqid;
+  fid->numofintervals = header->numofintervals;
+  fid->seqids = (const GtFeatureIndexDiskSeqid*)
+                ((const char*) fid->map + header->seqidsoffset);
+  fid->intervals = (const GtFeatureIndexDiskInterval*)
+                   ((const char*) fid->map + header->intervalsoffset);
+  fid->records = (const GtUword*)
+                 ((const char*) fid->map + header->recordsoffset);
+  fid->strings = (const char*) fid->map + header->stringsoffset;
+  return 0;
+}
+
+static const GtFeatureIndexDiskSeqid*
+feature_index_disk_find_seqid(const GtFeatureIndexDisk *fid,
+                              const char *seqid)
+{
+  GtUword left = 0, right = fid->numofseqids;
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+    int cmp = strcmp(fid->strings + fid->seqids[mid].seqid, seqid);
+    if (cmp == 0)
+      return fid->seqids + mid;
+    if (cmp < 0)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return NULL;
+}
+
+/* Returns the number of the first interval of <entry> which ends at or after
+   <start>. */
+static GtUword feature_index_disk_first_overlap(const GtFeatureIndexDisk *fid,
+                                           const GtFeatureIndexDiskSeqid *entry,
+                                                GtUword start)
+{
+  GtUword left = entry->firstinterval,
+          right = entry->firstinterval + entry->numofintervals;
+  while (left < right) {
+    GtUword mid = left + (right - left) / 2;
+    if (fid->intervals[mid].maxend < start)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return left;
+}
+
+static GtStr* feature_index_disk_str(GtFeatureIndexDisk *fid, GtUword offset)
+{
+  const char *cstr = fid->strings + offset;
+  GtStr *str;
+  if (!(str = gt_hashmap_get(fid->strs, cstr))) {
+    str = gt_str_new_cstr(cstr);
+    gt_hashmap_add(fid->strs, (void*) cstr, str);
+  }
+  return str;
+}
+
+/* Creates the feature tree of interval <intervalnum> of <entry> from its
+   record, unless this has happened before. Must be called with <fid->mutex>
+   locked. */
+static GtFeatureNode* feature_index_disk_get_tree(GtFeatureIndexDisk *fid,
+                                           const GtFeatureIndexDiskSeqid *entry,
+                                                  GtUword intervalnum)
+{
+  const GtUword *record, **noderecords;
+  GtFeatureNode **nodes;
+  GtStr *seqid;
+  bool *has_parent;
+  GtUword i, j, numofnodes;
+
+  if (fid->nodes[intervalnum])
+    return fid->nodes[intervalnum];
+  record = fid->records + fid->intervals[intervalnum].record;
+  numofnodes = *record++;
+  gt_assert(numofnodes > 0);
+  nodes = gt_malloc(sizeof (*nodes) * numofnodes);
+  noderecords = gt_malloc(sizeof (*noderecords) * numofnodes);
+  has_parent = gt_calloc((size_t) numofnodes, sizeof (*has_parent));
+  seqid = feature_index_disk_str(fid, entry->seqid);
+
+  /* create the nodes */
+  for (i = 0; i < numofnodes; i++) {
+    const GtUword *attributes = record + GT_FID_NODESIZE;
+    GtUword flags = record[GT_FID_FLAGS];
+    GtStrand strand = (GtStrand) ((flags >> GT_FID_STRAND_SHIFT)
+                                  & GT_FID_FIELD_MASK);
+    GtGenomeNode *gn;
+    if (flags & GT_FID_PSEUDO) {
+      gn = gt_feature_node_new_pseudo(seqid, record[GT_FID_START],
+                                      record[GT_FID_END], strand);
+    }
+    else {
+      gn = gt_feature_node_new(seqid, fid->strings + record[GT_FID_TYPE],
+                               record[GT_FID_START], record[GT_FID_END],
+                               strand);
+    }
+    nodes[i] = (GtFeatureNode*) gn;
+    noderecords[i] = record;
+    if (record[GT_FID_SOURCE] != GT_UNDEF_UWORD) {
+      gt_feature_node_set_source(nodes[i],
+                                 feature_index_disk_str(fid,
+                                                        record[GT_FID_SOURCE]));
+    }
+    if (flags & GT_FID_HAS_SCORE) {
+      float score;
+      memcpy(&score, record + GT_FID_SCORE, sizeof (score));
+      gt_feature_node_set_score(nodes[i], score);
+    }
+    gt_feature_node_set_phase(nodes[i],
+                              (GtPhase) ((flags >> GT_FID_PHASE_SHIFT)
+                                         & GT_FID_FIELD_MASK));
+    for (j = 0; j < record[GT_FID_NUMOFATTRIBUTES]; j++) {
+      gt_feature_node_add_attribute(nodes[i], fid->strings + attributes[2 * j],
+                                    fid->strings + attributes[2 * j + 1]);
+    }
+    if (record[GT_FID_FILENAME] != GT_UNDEF_UWORD) {
+      gt_genome_node_set_origin(gn,
+                                feature_index_disk_str(fid,
+                                                       record[GT_FID_FILENAME]),
+                                (unsigned int) record[GT_FID_LINE]);
+    }
+    record += GT_FID_NODESIZE + 2 * record[GT_FID_NUMOFATTRIBUTES]
+              + record[GT_FID_NUMOFCHILDREN];
+  }
+
+  /* link them, the children of a node are stored in their original order */
+  for (i = 0; i < numofnodes; i++) {
+    const GtUword *children = noderecords[i] + GT_FID_NODESIZE
+                              + 2 * noderecords[i][GT_FID_NUMOFATTRIBUTES];
+    for (j = 0; j < noderecords[i][GT_FID_NUMOFCHILDREN]; j++) {
+      GtUword childnum = children[j];
+      gt_assert(childnum < numofnodes);
+      if (has_parent[childnum])
+        (void) gt_genome_node_ref((GtGenomeNode*) nodes[childnum]);
+      has_parent[childnum] = true;
+      gt_feature_node_add_child(nodes[i], nodes[childnum]);
+    }
+  }
+  for (i = 0; i < numofnodes; i++) {
+    if (noderecords[i][GT_FID_MULTIREP] == i)
+      gt_feature_node_make_multi_representative(nodes[i]);
+  }
+  for (i = 0; i < numofnodes; i++) {
+    GtUword repnum = noderecords[i][GT_FID_MULTIREP];
+    if (repnum != GT_UNDEF_UWORD && repnum != i) {
+      gt_assert(repnum < numofnodes);
+      gt_feature_node_set_multi_representative(nodes[i], nodes[repnum]);
+    }
+  }
+  fid->nodes[intervalnum] = nodes[0];
+  gt_free(has_parent);
+  gt_free(noderecords);
+  gt_free(nodes);
+  return fid->nodes[intervalnum];
+}
+
+int gt_feature_index_disk_add_region_node(GtFeatureIndex *gfi,
+                                          GtRegionNode *rn,
+                                          GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  gt_assert(gfi && rn);
+  fid = gt_feature_index_disk_cast(gfi);
+  entry = feature_index_disk_find_seqid(fid,
+                   gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) rn)));
+  if (entry && entry->has_region)
+    return 0;
+  return gt_feature_index_add_region_node(fid->added, rn, err);
+}
+
+int gt_feature_index_disk_add_feature_node(GtFeatureIndex *gfi,
+                                           GtFeatureNode *fn,
+                                           GtError *err)
+{
+  GtFeatureIndexDisk *fid;
+  gt_assert(gfi && fn);
+  fid = gt_feature_index_disk_cast(gfi);
+  return gt_feature_index_add_feature_node(fid->added, fn, err);
+}
+
+int gt_feature_index_disk_remove_node(GtFeatureIndex *gfi,
+                                      GtFeatureNode *fn,
+                                      GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  GtRange range;
+  GtUword i;
+  gt_assert(gfi && fn);
+
+  fid = gt_feature_index_disk_cast(gfi);
+  entry = feature_index_disk_find_seqid(fid,
+                   gt_str_get(gt_genome_node_get_seqid((GtGenomeNode*) fn)));
+  if (entry) {
+    range = gt_genome_node_get_range((GtGenomeNode*) fn);
+    for (i = feature_index_disk_first_overlap(fid, entry, range.start);
+         i < entry->firstinterval + entry->numofintervals
+           && fid->intervals[i].start <= range.end;
+         i++) {
+      if (fid->nodes[i] == fn) {
+        fid->removed[i] = true;
+        return 0;
+      }
+    }
+  }
+  return gt_feature_index_remove_node(fid->added, fn, err);
+}
+
+static int feature_index_disk_has_added_seqid(GtFeatureIndexDisk *fid,
+                                              bool *has_seqid,
+                                              const char *seqid,
+                                              GtError *err)
+{
+  return gt_feature_index_has_seqid(fid->added, has_seqid, seqid, err);
+}
+
+GtArray* gt_feature_index_disk_get_features_for_seqid(GtFeatureIndex *gfi,
+                                                      const char *seqid,
+                                                      GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  GtArray *a, *added;
+  GtUword i;
+  bool has_added = false;
+  gt_assert(gfi && seqid);
+
+  fid = gt_feature_index_disk_cast(gfi);
+  a = gt_array_new(sizeof (GtFeatureNode*));
+  if ((entry = feature_index_disk_find_seqid(fid, seqid))) {
+    gt_mutex_lock(fid->mutex);
+    for (i = entry->firstinterval;
+         i < entry->firstinterval + entry->numofintervals;
+         i++) {
+      if (!fid->removed[i]) {
+        GtFeatureNode *fn = feature_index_disk_get_tree(fid, entry, i);
+        gt_array_add(a, fn);
+      }
+    }
+    gt_mutex_unlock(fid->mutex);
+  }
+  if (feature_index_disk_has_added_seqid(fid, &has_added, seqid, err) == 0
+        && has_added) {
+    added = gt_feature_index_get_features_for_seqid(fid->added, seqid, err);
+    gt_array_add_array(a, added);
+    gt_array_delete(added);
+  }
+  return a;
+}
+
+int gt_feature_index_disk_get_features_for_range(GtFeatureIndex *gfi,
+                                                 GtArray *results,
+                                                 const char *seqid,
+                                                 const GtRange *qry_range,
+                                                 GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  GtUword i;
+  bool has_added = false;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(gfi && results && qry_range);
+
+  fid = gt_feature_index_disk_cast(gfi);
+  entry = feature_index_disk_find_seqid(fid, seqid);
+  had_err = feature_index_disk_has_added_seqid(fid, &has_added, seqid, err);
+  if (!had_err && !entry && !has_added) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    had_err = -1;
+  }
+  if (!had_err && entry) {
+    gt_mutex_lock(fid->mutex);
+    for (i = feature_index_disk_first_overlap(fid, entry, qry_range->start);
+         i < entry->firstinterval + entry->numofintervals
+           && fid->intervals[i].start <= qry_range->end;
+         i++) {
+      if (fid->intervals[i].end >= qry_range->start && !fid->removed[i]) {
+        GtFeatureNode *fn = feature_index_disk_get_tree(fid, entry, i);
+        gt_array_add(results, fn);
+      }
+    }
+    gt_mutex_unlock(fid->mutex);
+  }
+  if (!had_err && has_added) {
+    had_err = gt_feature_index_get_features_for_range(fid->added, results,
+                                                      seqid, qry_range, err);
+  }
+  if (!had_err)
+    gt_array_sort_stable(results, feature_index_disk_cmp_range_start);
+  return had_err;
+}
+
+char* gt_feature_index_disk_get_first_seqid(const GtFeatureIndex *gfi,
+                                            GtError *err)
+{
+  GtFeatureIndexDisk *fid;
+  char *seqid;
+  gt_assert(gfi);
+
+  fid = gt_feature_index_disk_cast((GtFeatureIndex*) gfi);
+  if (fid->numofseqids > 0) {
+    return gt_cstr_dup(fid->strings
+                       + fid->seqids[fid->firstseqid].seqid);
+  }
+  seqid = gt_feature_index_get_first_seqid(fid->added, err);
+  if (!seqid && !gt_error_is_set(err))
+    gt_error_set(err, "no sequence regions in index");
+  return seqid;
+}
+
+GtStrArray* gt_feature_index_disk_get_seqids(const GtFeatureIndex *gfi,
+                                             GtError *err)
+{
+  GtFeatureIndexDisk *fid;
+  GtCstrTable *seqids;
+  GtStrArray *added, *ret;
+  GtUword i;
+  gt_assert(gfi);
+
+  fid = gt_feature_index_disk_cast((GtFeatureIndex*) gfi);
+  seqids = gt_cstr_table_new();
+  for (i = 0; i < fid->numofseqids; i++)
+    gt_cstr_table_add(seqids, fid->strings + fid->seqids[i].seqid);
+  if ((added = gt_feature_index_get_seqids(fid->added, err))) {
+    for (i = 0; i < gt_str_array_size(added); i++) {
+      if (!gt_cstr_table_get(seqids, gt_str_array_get(added, i)))
+        gt_cstr_table_add(seqids, gt_str_array_get(added, i));
+    }
+    gt_str_array_delete(added);
+  }
+  ret = gt_cstr_table_get_all(seqids);
+  gt_cstr_table_delete(seqids);
+  return ret;
+}
+
+int gt_feature_index_disk_get_range_for_seqid(GtFeatureIndex *gfi,
+                                              GtRange *range,
+                                              const char *seqid,
+                                              GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  bool has_added = false, is_set = false;
+  int had_err;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+
+  fid = gt_feature_index_disk_cast(gfi);
+  entry = feature_index_disk_find_seqid(fid, seqid);
+  had_err = feature_index_disk_has_added_seqid(fid, &has_added, seqid, err);
+  if (!had_err && !entry && !has_added) {
+    gt_error_set(err, "feature index does not contain the given sequence id");
+    had_err = -1;
+  }
+  if (!had_err && entry && entry->numofintervals > 0) {
+    range->start = entry->dyn_start;
+    range->end = entry->dyn_end;
+    is_set = true;
+  }
+  if (!had_err && has_added) {
+    GtRange added_range;
+    had_err = gt_feature_index_get_range_for_seqid(fid->added, &added_range,
+                                                   seqid, err);
+    if (!had_err) {
+      *range = is_set ? gt_range_join(range, &added_range) : added_range;
+      is_set = true;
+    }
+  }
+  if (!had_err && !is_set && entry && entry->has_region) {
+    range->start = entry->region_start;
+    range->end = entry->region_end;
+  }
+  return had_err;
+}
+
+int gt_feature_index_disk_get_orig_range_for_seqid(GtFeatureIndex *gfi,
+                                                   GtRange *range,
+                                                   const char *seqid,
+                                                   GtError *err)
+{
+  const GtFeatureIndexDiskSeqid *entry;
+  GtFeatureIndexDisk *fid;
+  bool has_added = false;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi && range && seqid);
+
+  fid = gt_feature_index_disk_cast(gfi);
+  entry = feature_index_disk_find_seqid(fid, seqid);
+  if (entry && entry->has_region) {
+    range->start = entry->region_start;
+    range->end = entry->region_end;
+  }
+  else {
+    had_err = feature_index_disk_has_added_seqid(fid, &has_added, seqid, err);
+    if (!had_err && has_added) {
+      had_err = gt_feature_index_get_orig_range_for_seqid(fid->added, range,
+                                                          seqid, err);
+    }
+  }
+  return had_err;
+}
+
+int gt_feature_index_disk_has_seqid(const GtFeatureIndex *gfi,
+                                    bool *has_seqid,
+                                    const char *seqid,
+                                    GtError *err)
+{
+  GtFeatureIndexDisk *fid;
+  gt_assert(gfi && has_seqid && seqid);
+
+  fid = gt_feature_index_disk_cast((GtFeatureIndex*) gfi);
+  if (feature_index_disk_find_seqid(fid, seqid)) {
+    *has_seqid = true;
+    return 0;
+  }
+  return feature_index_disk_has_added_seqid(fid, has_seqid, seqid, err);
+}
+
+/* Adds sequence region <seqid> of <fi>, which must not be locked, to
+   <writer>. */
+static int feature_index_disk_write_seqid(GtFeatureIndexDiskWriter *writer,
+                                          GtFeatureIndex *fi,
+                                          const char *seqid,
+                                          GtError *err)
+{
+  GtArray *roots;
+  GtRange region;
+  int had_err;
+  gt_error_check(err);
+
+  region.start = region.end = GT_UNDEF_UWORD;
+  had_err = gt_feature_index_get_orig_range_for_seqid(fi, &region, seqid,
+                                                      err);
+  if (!had_err) {
+    if (!(roots = gt_feature_index_get_features_for_seqid(fi, seqid, err)))
+      had_err = -1;
+    else {
+      feature_index_disk_writer_add_seqid(writer, seqid,
+                                          region.start != GT_UNDEF_UWORD
+                                            ? &region : NULL,
+                                          roots);
+      gt_array_delete(roots);
+    }
+  }
+  return had_err;
+}
+
+int gt_feature_index_disk_save(GtFeatureIndex *gfi, GtError *err)
+{
+  GtFeatureIndexDiskWriter *writer;
+  GtFeatureIndexDisk *fid;
+  GtStrArray *seqids;
+  char *firstseqid = NULL;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gfi);
+
+  /* <gfi> is locked, hence the indexed nodes are collected by the methods of
+     this class rather than by the generic <GtFeatureIndex> functions */
+  fid = gt_feature_index_disk_cast(gfi);
+  writer = feature_index_disk_writer_new();
+  seqids = gt_feature_index_disk_get_seqids(gfi, err);
+  if (gt_str_array_size(seqids) > 0
+        && !(firstseqid = gt_feature_index_disk_get_first_seqid(gfi, err)))
+    had_err = -1;
+  for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+    const char *seqid = gt_str_array_get(seqids, i);
+    GtArray *roots;
+    GtRange region;
+    region.start = region.end = GT_UNDEF_UWORD;
+    had_err = gt_feature_index_disk_get_orig_range_for_seqid(gfi, &region,
+                                                             seqid, err);
+    if (!had_err) {
+      roots = gt_feature_index_disk_get_features_for_seqid(gfi, seqid, err);
+      feature_index_disk_writer_add_seqid(writer, seqid,
+                                          region.start != GT_UNDEF_UWORD
+                                            ? &region : NULL,
+                                          roots);
+      gt_array_delete(roots);
+    }
+  }
+  if (!had_err) {
+    had_err = feature_index_disk_writer_write(writer,
+                                              gt_str_get(fid->filename),
+                                              firstseqid, err);
+  }
+  gt_free(firstseqid);
+  gt_str_array_delete(seqids);
+  feature_index_disk_writer_delete(writer);
+  return had_err;
+}
+
+void gt_feature_index_disk_delete(GtFeatureIndex *gfi)
+{
+  GtFeatureIndexDisk *fid;
+  GtUword i;
+  if (!gfi) return;
+  fid = gt_feature_index_disk_cast(gfi);
+  for (i = 0; i < fid->numofintervals; i++)
+    gt_genome_node_delete((GtGenomeNode*) fid->nodes[i]);
+  gt_free(fid->nodes);
+  gt_free(fid->removed);
+  gt_hashmap_delete(fid->strs);
+  gt_feature_index_delete(fid->added);
+  gt_fa_xmunmap(fid->map);
+  gt_mutex_delete(fid->mutex);
+  gt_str_delete(fid->filename);
+}
+
+const GtFeatureIndexClass* gt_feature_index_disk_class(void)
+{
+  static const GtFeatureIndexClass *fic = NULL;
+  gt_class_alloc_lock_enter();
+  if (!fic) {
+    fic = gt_feature_index_class_new(sizeof (GtFeatureIndexDisk),
+                     gt_feature_index_disk_add_region_node,
+                     gt_feature_index_disk_add_feature_node,
+                     gt_feature_index_disk_remove_node,
+                     gt_feature_index_disk_get_features_for_seqid,
+                     gt_feature_index_disk_get_features_for_range,
+                     gt_feature_index_disk_get_first_seqid,
+                     gt_feature_index_disk_save,
+                     gt_feature_index_disk_get_seqids,
+                     gt_feature_index_disk_get_range_for_seqid,
+                     gt_feature_index_disk_get_orig_range_for_seqid,
+                     gt_feature_index_disk_has_seqid,
+                     gt_feature_index_disk_delete);
+  }
+  gt_class_alloc_lock_leave();
+  return fic;
+}
+
+GtFeatureIndex* gt_feature_index_disk_new(const char *filename, GtError *err)
+{
+  GtFeatureIndexDisk *fid;
+  GtFeatureIndex *fi;
+  gt_error_check(err);
+  gt_assert(filename);
+
+  fi = gt_feature_index_create(gt_feature_index_disk_class());
+  fid = gt_feature_index_disk_cast(fi);
+  fid->filename = gt_str_new_cstr(filename);
+  fid->strs = gt_hashmap_new(GT_HASH_DIRECT, NULL, (GtFree) gt_str_delete);
+  fid->added = gt_feature_index_memory_new();
+  fid->mutex = gt_mutex_new();
+  if (gt_file_exists(filename) && feature_index_disk_map(fid, err) != 0) {
+    gt_feature_index_delete(fi);
+    return NULL;
+  }
+  if (fid->numofintervals > 0) {
+    fid->nodes = gt_calloc((size_t) fid->numofintervals, sizeof (*fid->nodes));
+    fid->removed = gt_calloc((size_t) fid->numofintervals,
+                             sizeof (*fid->removed));
+  }
+  return fi;
+}
+
+int gt_feature_index_disk_write(GtFeatureIndex *feature_index,
+                                const char *filename, GtError *err)
+{
+  GtFeatureIndexDiskWriter *writer;
+  GtStrArray *seqids;
+  char *firstseqid = NULL;
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(feature_index && filename);
+
+  writer = feature_index_disk_writer_new();
+  if (!(seqids = gt_feature_index_get_seqids(feature_index, err)))
+    had_err = -1;
+  if (!had_err && gt_str_array_size(seqids) > 0
+        && !(firstseqid = gt_feature_index_get_first_seqid(feature_index, err)))
+    had_err = -1;
+  for (i = 0; !had_err && i < gt_str_array_size(seqids); i++) {
+    had_err = feature_index_disk_write_seqid(writer, feature_index,
+                                             gt_str_array_get(seqids, i), err);
+  }
+  if (!had_err) {
+    had_err = feature_index_disk_writer_write(writer, filename, firstseqid,
+                                              err);
+  }
+  gt_free(firstseqid);
+  gt_str_array_delete(seqids);
+  feature_index_disk_writer_delete(writer);
+  return had_err;
+}
+
+static GtFeatureNode* feature_index_disk_test_tree(GtStr *seqid, GtUword start)
+{
+  GtFeatureNode *gene, *mrna1, *mrna2, *exon, *cds1, *cds2;
+  GtStr *source;
+  char id[32];
+
+  source = gt_str_new_cstr("test");
+  gene = (GtFeatureNode*) gt_feature_node_new(seqid, "gene", start,
+                                              start + 999, GT_STRAND_FORWARD);
+  (void) snprintf(id, sizeof (id), "gene"GT_WU, start);
+  gt_feature_node_add_attribute(gene, "ID", id);
+  gt_feature_node_set_source(gene, source);
+  gt_feature_node_set_score(gene, 0.5);
+  mrna1 = (GtFeatureNode*) gt_feature_node_new(seqid, "mRNA", start,
+                                               start + 999, GT_STRAND_FORWARD);
+  gt_feature_node_add_child(gene, mrna1);
+  mrna2 = (GtFeatureNode*) gt_feature_node_new(seqid, "mRNA", start + 10,
+                                               start + 999, GT_STRAND_FORWARD);
+  gt_feature_node_add_child(gene, mrna2);
+  /* an exon with two parents */
+  exon = (GtFeatureNode*) gt_feature_node_new(seqid, "exon", start + 10,
+                                              start + 99, GT_STRAND_FORWARD);
+  gt_feature_node_add_child(mrna1, exon);
+  gt_feature_node_add_child(mrna2,
+                            (GtFeatureNode*) gt_genome_node_ref((GtGenomeNode*)
+                                                                exon));
+  /* a multi-feature */
+  cds1 = (GtFeatureNode*) gt_feature_node_new(seqid, "CDS", start + 20,
+                                              start + 99, GT_STRAND_FORWARD);
+  gt_feature_node_set_phase(cds1, GT_PHASE_ZERO);
+  gt_feature_node_make_multi_representative(cds1);
+  gt_feature_node_add_child(mrna1, cds1);
+  cds2 = (GtFeatureNode*) gt_feature_node_new(seqid, "CDS", start + 200,
+                                              start + 299, GT_STRAND_FORWARD);
+  gt_feature_node_set_phase(cds2, GT_PHASE_TWO);
+  gt_feature_node_set_multi_representative(cds2, cds1);
+  gt_feature_node_add_child(mrna1, cds2);
+  gt_str_delete(source);
+  return gene;
+}
+
+static bool feature_index_disk_test_equal(GtFeatureNode *fn1,
+                                          GtFeatureNode *fn2)
+{
+  GtFeatureNodeIterator *fni1, *fni2;
+  GtFeatureNode *n1, *n2;
+  bool equal = true;
+
+  fni1 = gt_feature_node_iterator_new(fn1);
+  fni2 = gt_feature_node_iterator_new(fn2);
+  do {
+    n1 = gt_feature_node_iterator_next(fni1);
+    n2 = gt_feature_node_iterator_next(fni2);
+    if (!n1 || !n2) {
+      equal = (n1 == n2);
+      break;
+    }
+    if (!gt_feature_node_is_similar(n1, n2)
+          || gt_feature_node_is_multi(n1) != gt_feature_node_is_multi(n2)
+          || gt_feature_node_score_is_defined(n1)
+               != gt_feature_node_score_is_defined(n2)
+          || (gt_feature_node_score_is_defined(n1)
+                && gt_feature_node_get_score(n1)
+                     != gt_feature_node_get_score(n2))
+          || strcmp(gt_feature_node_get_source(n1),
+                    gt_feature_node_get_source(n2)) != 0) {
+      equal = false;
+    }
+    else if (gt_feature_node_get_attribute(n1, "ID")
+               || gt_feature_node_get_attribute(n2, "ID")) {
+      equal = gt_feature_node_get_attribute(n1, "ID")
+              && gt_feature_node_get_attribute(n2, "ID")
+              && strcmp(gt_feature_node_get_attribute(n1, "ID"),
+                        gt_feature_node_get_attribute(n2, "ID")) == 0;
+    }
+  } while (equal);
+  gt_feature_node_iterator_delete(fni1);
+  gt_feature_node_iterator_delete(fni2);
+  return equal;
+}
+
+#define GT_FID_TEST_SEQLEN   1000000
+#define GT_FID_TEST_TREES    500
+#define GT_FID_TEST_QUERIES  100
+
+int gt_feature_index_disk_unit_test(GtError *err)
+{
+  static const char *seqid_cstrs[] = { "seqB", "seqA" };
+  GtFeatureIndex *fi = NULL, *mfi, *dfi = NULL;
+  GtArray *results, *ref_results;
+  GtStrArray *seqids;
+  GtStr *tmpfilename, *seqid;
+  GtGenomeNode *rn;
+  GtError *testerr;
+  GtRange rng1, rng2;
+  FILE *tmpfp;
+  GtUword i, j, k;
+  bool has_seqid = false;
+  int had_err = 0, status;
+  gt_error_check(err);
+
+  testerr = gt_error_new();
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_fa_xfclose(tmpfp);
+  gt_xremove(gt_str_get(tmpfilename));
+
+  /* run generic feature index tests on a new index and save it */
+  fi = gt_feature_index_disk_new(gt_str_get(tmpfilename), testerr);
+  gt_ensure(fi != NULL);
+  if (!had_err) {
+    status = gt_feature_index_unit_test(fi, testerr);
+    gt_ensure(status == 0);
+  }
+  if (!had_err) {
+    status = gt_feature_index_save(fi, testerr);
+    gt_ensure(status == 0);
+  }
+  gt_feature_index_delete(fi);
+  fi = NULL;
+  if (!had_err) {
+    fi = gt_feature_index_disk_new(gt_str_get(tmpfilename), testerr);
+    gt_ensure(fi != NULL);
+  }
+  if (!had_err) {
+    seqids = gt_feature_index_get_seqids(fi, testerr);
+    gt_ensure(gt_str_array_size(seqids) == 1);
+    gt_str_array_delete(seqids);
+    results = gt_feature_index_get_features_for_seqid(fi, "testseqid",
+                                                      testerr);
+    gt_ensure(gt_array_size(results) > 0);
+    gt_array_delete(results);
+  }
+  gt_feature_index_delete(fi);
+
+  /* compare an index written from a memory index with the latter */
+  mfi = gt_feature_index_memory_new();
+  for (i = 0; i < sizeof (seqid_cstrs) / sizeof (seqid_cstrs[0]); i++) {
+    seqid = gt_str_new_cstr(seqid_cstrs[i]);
+    if (i == 0) {
+      rn = gt_region_node_new(seqid, 1, GT_FID_TEST_SEQLEN);
+      gt_feature_index_add_region_node(mfi, (GtRegionNode*) rn, testerr);
+      gt_genome_node_delete(rn);
+    }
+    for (j = 0; j < GT_FID_TEST_TREES; j++) {
+      GtFeatureNode *fn;
+      fn = feature_index_disk_test_tree(seqid, 1 + random()
+                                               % (GT_FID_TEST_SEQLEN - 1000));
+      gt_feature_index_add_feature_node(mfi, fn, testerr);
+      gt_genome_node_delete((GtGenomeNode*) fn);
+    }
+    gt_str_delete(seqid);
+  }
+  status = gt_feature_index_disk_write(mfi, gt_str_get(tmpfilename), testerr);
+  gt_ensure(status == 0);
+  if (!had_err) {
+    dfi = gt_feature_index_disk_new(gt_str_get(tmpfilename), testerr);
+    gt_ensure(dfi != NULL);
+  }
+  if (!had_err) {
+    char *first1, *first2;
+    first1 = gt_feature_index_get_first_seqid(mfi, testerr);
+    first2 = gt_feature_index_get_first_seqid(dfi, testerr);
+    gt_ensure(strcmp(first1, first2) == 0);
+    gt_free(first1);
+    gt_free(first2);
+    seqids = gt_feature_index_get_seqids(dfi, testerr);
+    gt_ensure(gt_str_array_size(seqids) == 2);
+    gt_ensure(strcmp(gt_str_array_get(seqids, 0), "seqA") == 0);
+    gt_str_array_delete(seqids);
+    rng1.start = rng1.end = rng2.start = rng2.end = GT_UNDEF_UWORD;
+    gt_feature_index_get_orig_range_for_seqid(dfi, &rng2, "seqA", testerr);
+    gt_ensure(rng2.start == GT_UNDEF_UWORD);
+    gt_feature_index_get_orig_range_for_seqid(dfi, &rng2, "seqB", testerr);
+    gt_ensure(rng2.start == 1 && rng2.end == GT_FID_TEST_SEQLEN);
+    for (i = 0; i < sizeof (seqid_cstrs) / sizeof (seqid_cstrs[0]); i++) {
+      gt_feature_index_get_range_for_seqid(mfi, &rng1, seqid_cstrs[i],
+                                           testerr);
+      gt_feature_index_get_range_for_seqid(dfi, &rng2, seqid_cstrs[i],
+                                           testerr);
+      gt_ensure(gt_range_compare(&rng1, &rng2) == 0);
+    }
+  }
+  results = gt_array_new(sizeof (GtFeatureNode*));
+  ref_results = gt_array_new(sizeof (GtFeatureNode*));
+  for (i = 0; !had_err && i < GT_FID_TEST_QUERIES; i++) {
+    const char *qseqid = seqid_cstrs[i % 2];
+    rng1.start = 1 + random() % (GT_FID_TEST_SEQLEN - 1);
+    rng1.end = rng1.start + random() % 20000;
+    gt_array_reset(results);
+    gt_array_reset(ref_results);
+    status = gt_feature_index_get_features_for_range(mfi, ref_results, qseqid,
+                                                     &rng1, testerr);
+    gt_ensure(status == 0);
+    status = gt_feature_index_get_features_for_range(dfi, results, qseqid,
+                                                     &rng1, testerr);
+    gt_ensure(status == 0);
+    gt_ensure(gt_array_size(results) == gt_array_size(ref_results));
+    for (k = 0; !had_err && k < gt_array_size(results); k++) {
+      gt_ensure(feature_index_disk_test_equal(
+                              *(GtFeatureNode**) gt_array_get(ref_results, k),
+                              *(GtFeatureNode**) gt_array_get(results, k)));
+    }
+  }
+
+  /* removed nodes are not reported anymore */
+  if (!had_err && gt_array_size(results) > 0) {
+    GtUword numofresults = gt_array_size(results);
+    status = gt_feature_index_remove_node(dfi,
+                                   *(GtFeatureNode**) gt_array_get(results, 0),
+                                   testerr);
+    gt_ensure(status == 0);
+    gt_array_reset(results);
+    status = gt_feature_index_get_features_for_range(dfi, results,
+                                                     seqid_cstrs[1], &rng1,
+                                                     testerr);
+    gt_ensure(gt_array_size(results) + 1 == numofresults);
+  }
+  gt_array_delete(results);
+  gt_array_delete(ref_results);
+  if (!had_err) {
+    gt_ensure(gt_feature_index_has_seqid(dfi, &has_seqid, "seqC",
+                                         testerr) == 0);
+    gt_ensure(!has_seqid);
+  }
+  gt_feature_index_delete(dfi);
+  gt_feature_index_delete(mfi);
+
+  /* other files are rejected */
+  if (!had_err) {
+    tmpfp = gt_fa_xfopen(gt_str_get(tmpfilename), "w");
+    gt_xfputs("sdfnhsnl", tmpfp);
+    gt_fa_xfclose(tmpfp);
+    dfi = gt_feature_index_disk_new(gt_str_get(tmpfilename), testerr);
+    gt_ensure(dfi == NULL);
+    gt_ensure(gt_error_is_set(testerr));
+  }
+
+  gt_xremove(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+  gt_error_delete(testerr);
+  return had_err;
+}
@@ -0,0 +1,49 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef FEATURE_INDEX_DISK_API_H
+#define FEATURE_INDEX_DISK_API_H
+
+#include "extended/feature_index_api.h"
+
+/* The <GtFeatureIndexDisk> class implements a <GtFeatureIndex> which is stored
+   in a file. The file is mapped into memory when the index is opened, so
+   opening takes constant time regardless of the number of features. Per
+   sequence region, the top-level features are kept as an array of intervals
+   sorted by start position, and each feature tree is stored as a serialized
+   record referring to a shared string table. A range query only creates the
+   <GtFeatureNode> objects of the trees it hits. These remain owned by the
+   index, as for <GtFeatureIndexMemory>.
+   Nodes added to a <GtFeatureIndexDisk> are kept in memory until the index is
+   written back with <gt_feature_index_save()>. */
+typedef struct GtFeatureIndexDisk GtFeatureIndexDisk;
+
+/* Creates a new <GtFeatureIndexDisk> object for the file <filename>. If the
+   file exists, it is mapped into memory, otherwise the index is empty and the
+   file is created by <gt_feature_index_save()>. Returns NULL and sets <err> if
+   <filename> is not a valid feature index file. */
+GtFeatureIndex* gt_feature_index_disk_new(const char *filename, GtError *err);
+
+/* Writes the contents of <feature_index>, which may be of any
+   <GtFeatureIndex> class, to the file <filename> such that it can be opened
+   with <gt_feature_index_disk_new()>. Returns 0 on success, otherwise -1 and
+   <err> is set. */
+int             gt_feature_index_disk_write(GtFeatureIndex *feature_index,
+                                            const char *filename,
+                                            GtError *err);
+
+#endif
@@ -26,14 +26,17 @@
 #include "core/hashmap.h"
 #include "core/interval_tree.h"
 #include "core/ma.h"
+#include "core/mathsupport.h"
 #include "core/minmax.h"
 #include "core/range.h"
+#include "core/static_interval_tree.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_index_rep.h"
 #include "extended/feature_index.h"
 #include "extended/feature_node.h"
+#include "extended/feature_type.h"
 #include "extended/genome_node.h"
 
 struct GtFeatureIndexMemory {
@@ -52,12 +55,15 @@ struct GtFeatureIndexMemory {
 
 typedef struct {
   GtIntervalTree *features;
+  GtStaticIntervalTree *static_features; /* if not NULL, contains the same
+                                            nodes as <features> */
   GtRegionNode *region;
   GtRange dyn_range;
 } RegionInfo;
 
 static void region_info_delete(RegionInfo *info)
 {
+  gt_static_interval_tree_delete(info->static_features);
   gt_interval_tree_delete(info->features);
   if (info->region)
     gt_genome_node_delete((GtGenomeNode*)info->region);
@@ -126,6 +132,8 @@ int gt_feature_index_memory_add_feature_node(GtFeatureIndex *gfi,
   }
 
   /* add node to the appropriate array in the hashtable */
+  gt_static_interval_tree_delete(info->static_features);
+  info->static_features = NULL;
   new_node = gt_interval_tree_node_new(gn, node_range.start, node_range.end);
   gt_interval_tree_insert(info->features, new_node);
   /* update dynamic range */
@@ -178,8 +186,11 @@ int gt_feature_index_memory_remove_node(GtFeatureIndex *gfi,
                                    node_range.end,
                                    &info);
 
-  if (info.node)
+  if (info.node) {
+    gt_static_interval_tree_delete(rinfo->static_features);
+    rinfo->static_features = NULL;
     gt_interval_tree_remove(rinfo->features, info.node);
+  }
   return 0;
 }
 
@@ -237,8 +248,15 @@ int gt_feature_index_memory_get_features_for_range(GtFeatureIndex *gfi,
     gt_error_set(err, "feature index does not contain the given sequence id");
     return -1;
   }
-  gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
-                                        qry_range->end, results);
+  if (ri->static_features) {
+    gt_static_interval_tree_find_all_overlapping(ri->static_features,
+                                                 qry_range->start,
+                                                 qry_range->end, results);
+  }
+  else {
+    gt_interval_tree_find_all_overlapping(ri->features, qry_range->start,
+                                          qry_range->end, results);
+  }
   gt_array_sort(results, gt_genome_node_cmp_range_start);
   return 0;
 }
@@ -351,6 +369,40 @@ int gt_feature_index_memory_has_seqid(const GtFeatureIndex *gfi,
   return 0;
 }
 
+static int add_feature_to_static_itree(GtIntervalTreeNode *node, void *data)
+{
+  GtStaticIntervalTree *sit = (GtStaticIntervalTree*) data;
+  GtGenomeNode *gn = (GtGenomeNode*) gt_interval_tree_node_get_data(node);
+  GtRange range = gt_genome_node_get_range(gn);
+  gt_static_interval_tree_add(sit, gn, range.start, range.end);
+  return 0;
+}
+
+static int make_region_static(GT_UNUSED void *key, void *value,
+                              GT_UNUSED void *data, GT_UNUSED GtError *err)
+{
+  RegionInfo *ri = (RegionInfo*) value;
+  GT_UNUSED int had_err;
+  if (!ri->static_features) {
+    /* the nodes remain owned by the dynamic interval tree */
+    ri->static_features = gt_static_interval_tree_new(NULL);
+    had_err = gt_interval_tree_traverse(ri->features,
+                                        add_feature_to_static_itree,
+                                        ri->static_features);
+    gt_assert(!had_err); /* add_feature_to_static_itree() is sane */
+    gt_static_interval_tree_build(ri->static_features);
+  }
+  return 0;
+}
+
+void gt_feature_index_memory_make_static(GtFeatureIndexMemory *fim)
+{
+  GT_UNUSED int had_err;
+  gt_assert(fim);
+  had_err = gt_hashmap_foreach(fim->regions, make_region_static, NULL, NULL);
+  gt_assert(!had_err); /* make_region_static() is sane */
+}
+
 void gt_feature_index_memory_delete(GtFeatureIndex *gfi)
 {
   GtFeatureIndexMemory *fi;
@@ -396,6 +448,80 @@ GtFeatureIndex* gt_feature_index_memory_new(void)
   return fi;
 }
 
+static int genome_node_ptr_cmp(const void *v1, const void *v2)
+{
+  GtGenomeNode *n1 = *(GtGenomeNode**) v1,
+               *n2 = *(GtGenomeNode**) v2;
+  if (n1 < n2)
+    return -1;
+  return n1 == n2 ? 0 : 1;
+}
+
+static int feature_index_memory_static_test(GtError *err)
+{
+  GtFeatureIndex *fi;
+  GtGenomeNode *gn;
+  GtArray *dynres, *statres;
+  GtStr *seqid;
+  GtRange qry;
+  GtUword i, num_features = 500, max_basepos = 50000, width = 2000;
+  int had_err = 0;
+  gt_error_check(err);
+
+  fi = gt_feature_index_memory_new();
+  seqid = gt_str_new_cstr("ctg1");
+  dynres = gt_array_new(sizeof (GtGenomeNode*));
+  statres = gt_array_new(sizeof (GtGenomeNode*));
+  for (i = 0; !had_err && i < num_features; i++) {
+    GtUword start = gt_rand_max(max_basepos) + 1;
+    gn = gt_feature_node_new(seqid, gt_ft_gene, start,
+                             start + gt_rand_max(width), GT_STRAND_FORWARD);
+    gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                 err));
+    gt_genome_node_delete(gn);
+  }
+
+  /* queries on the static trees yield the same results */
+  for (i = 0; !had_err && i < 100; i++) {
+    qry.start = gt_rand_max(max_basepos + width) + 1;
+    qry.end = qry.start + gt_rand_max(width);
+    gt_array_reset(dynres);
+    gt_array_reset(statres);
+    gt_ensure(!gt_feature_index_get_features_for_range(fi, dynres, "ctg1",
+                                                       &qry, err));
+    gt_feature_index_memory_make_static(gt_feature_index_memory_cast(fi));
+    gt_ensure(!gt_feature_index_get_features_for_range(fi, statres, "ctg1",
+                                                       &qry, err));
+    gt_array_sort(dynres, genome_node_ptr_cmp);
+    gt_array_sort(statres, genome_node_ptr_cmp);
+    gt_ensure(gt_array_cmp(dynres, statres) == 0);
+
+    /* changing the index switches back to the dynamic tree */
+    if (i % 10 == 0) {
+      gn = gt_feature_node_new(seqid, gt_ft_gene, qry.start, qry.end,
+                               GT_STRAND_FORWARD);
+      gt_ensure(!gt_feature_index_add_feature_node(fi, (GtFeatureNode*) gn,
+                                                   err));
+      gt_array_reset(statres);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi, statres, "ctg1",
+                                                         &qry, err));
+      gt_ensure(gt_array_size(statres) == gt_array_size(dynres) + 1);
+      gt_ensure(!gt_feature_index_remove_node(fi, (GtFeatureNode*) gn, err));
+      gt_genome_node_delete(gn);
+      gt_array_reset(statres);
+      gt_ensure(!gt_feature_index_get_features_for_range(fi, statres, "ctg1",
+                                                         &qry, err));
+      gt_ensure(gt_array_size(statres) == gt_array_size(dynres));
+    }
+  }
+
+  gt_array_delete(statres);
+  gt_array_delete(dynres);
+  gt_str_delete(seqid);
+  gt_feature_index_delete(fi);
+  return had_err;
+}
+
 int gt_feature_index_memory_unit_test(GtError *err)
 {
   int had_err = 0, status = 0;
@@ -434,5 +560,8 @@ int gt_feature_index_memory_unit_test(GtError *err)
   gt_feature_index_delete(fi);
 
   gt_error_delete(testerr);
+
+  if (!had_err)
+    had_err = feature_index_memory_static_test(err);
   return had_err;
 }
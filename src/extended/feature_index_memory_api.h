@@ -35,4 +35,12 @@ GtFeatureNode*  gt_feature_index_memory_get_node_by_ptr(GtFeatureIndexMemory*,
                                                         GtFeatureNode *ptr,
                                                         GtError *err);
 
+/* Converts the interval trees of all sequence regions in <fim> into
+   <GtStaticIntervalTree>s, which answer range queries faster and with fewer
+   cache misses. Use this after all features have been added to an index which
+   is only queried afterwards. Adding or removing a feature node later on
+   switches the affected sequence region back to the dynamic interval tree.
+   Must not be called concurrently with other methods of <fim>. */
+void            gt_feature_index_memory_make_static(GtFeatureIndexMemory *fim);
+
 #endif
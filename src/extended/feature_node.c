@@ -1193,6 +1193,11 @@ bool gt_feature_node_has_children(const GtFeatureNode *fn)
   return true;
 }
 
+size_t gt_feature_node_object_size(void)
+{
+  return sizeof (GtFeatureNode);
+}
+
 bool gt_feature_node_direct_children_do_not_overlap_generic(GtFeatureNode
                                                             *parent,
                                                             GtFeatureNode
@@ -71,6 +71,9 @@ int            gt_feature_node_traverse_direct_children(GtFeatureNode*, void*,
 /* Returns <true> if the given <feature_node> graph contains a marked node. */
 bool           gt_feature_node_contains_marked(GtFeatureNode *feature_node);
 bool           gt_feature_node_has_children(const GtFeatureNode*);
+/* Returns the size of a <GtFeatureNode> object itself, without its attributes
+   and the list of its children. */
+size_t         gt_feature_node_object_size(void);
 bool           gt_feature_node_direct_children_do_not_overlap(GtFeatureNode*);
 /* Returns <true> if all direct childred of <parent> with the same type (s.t.)
    as <child> do not overlap. */
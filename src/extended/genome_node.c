@@ -25,6 +25,7 @@
 #include "core/md5_seqid.h"
 #include "core/msort.h"
 #include "core/queue_api.h"
+#include "core/thread.h"
 #include "core/unused_api.h"
 #include "extended/eof_node_api.h"
 #include "extended/genome_node_rep.h"
@@ -67,6 +68,9 @@ gt_genome_node_class_new(size_t size,
   c_class->set_range = set_range;
   c_class->change_seqid = change_seqid;
   c_class->accept = accept;
+  /* align the lock following the node */
+  c_class->lock_offset = (size + sizeof (void*) - 1) & ~(sizeof (void*) - 1);
+  c_class->slab = gt_slab_get(c_class->lock_offset + gt_rwlock_size());
   return c_class;
 }
 
@@ -182,7 +186,10 @@ GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
 {
   GtGenomeNode *gn;
   gt_assert(gnc && gnc->size);
-  gn                     = gt_malloc(gnc->size);
+  if (gnc->slab)
+    gn                   = gt_slab_alloc(gnc->slab);
+  else
+    gn                   = gt_malloc(gnc->size);
   gn->c_class            = gnc;
   gn->filename           = NULL; /* means the node is generated */
   gn->line_number        = 0;
@@ -190,7 +197,10 @@ GtGenomeNode* gt_genome_node_create(const GtGenomeNodeClass *gnc)
   gn->userdata           = NULL;
   gn->userdata_nof_items = 0;
 #ifdef GT_THREADS_ENABLED
-  gn-> lock              = gt_rwlock_new();
+  if (gnc->slab)
+    gn->lock             = gt_rwlock_init((char*) gn + gnc->lock_offset);
+  else
+    gn->lock             = gt_rwlock_new();
 #endif
   return gn;
 }
@@ -482,8 +492,16 @@ void gt_genome_node_delete(GtGenomeNode *gn)
   if (gn->userdata)
     gt_hashmap_delete(gn->userdata);
   gt_rwlock_unlock(gn->lock);
+  if (gn->c_class->slab) {
 #ifdef GT_THREADS_ENABLED
-  gt_rwlock_delete(gn->lock);
+    gt_rwlock_destroy(gn->lock);
 #endif
-  gt_free(gn);
+    gt_slab_free(gn->c_class->slab, gn);
+  }
+  else {
+#ifdef GT_THREADS_ENABLED
+    gt_rwlock_delete(gn->lock);
+#endif
+    gt_free(gn);
+  }
 }
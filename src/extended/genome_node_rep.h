@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include "core/dlist.h"
 #include "core/hashmap.h"
+#include "core/slab.h"
 #include "core/thread_api.h"
 #include "extended/genome_node.h"
 
@@ -45,6 +46,10 @@ struct GtGenomeNodeClass
   GtGenomeNodeSetRangeFunc set_range;
   GtGenomeNodeChangeSeqidFunc change_seqid;
   GtGenomeNodeAcceptFunc accept;
+  /* nodes are allocated from <slab>, together with their lock (which is
+     stored at <lock_offset>) */
+  GtSlab *slab;
+  size_t lock_offset;
 };
 
 struct GtGenomeNode
@@ -129,6 +129,21 @@ void gt_gff3_in_stream_enable_strict_mode(GtGFF3InStream *is)
   gt_gff3_in_stream_plain_enable_strict_mode(is->gff3_in_stream_plain);
 }
 
+void gt_gff3_in_stream_enable_parallel_mode(GtGFF3InStream *is)
+{
+  gt_assert(is);
+  gt_gff3_in_stream_plain_enable_parallel_mode(is->gff3_in_stream_plain);
+}
+
+int gt_gff3_in_stream_restrict_to_region(GtNodeStream *ns, const char *seqid,
+                                         const GtRange *range, GtError *err)
+{
+  GtGFF3InStream *is = gff3_in_stream_cast(ns);
+  gt_assert(is);
+  return gt_gff3_in_stream_plain_restrict_to_region(is->gff3_in_stream_plain,
+                                                    seqid, range, err);
+}
+
 void gt_gff3_in_stream_enable_tidy_mode(GtGFF3InStream *is)
 {
   gt_assert(is);
@@ -19,6 +19,7 @@
 #define GFF3_IN_STREAM_H
 
 #include <stdio.h>
+#include "core/range_api.h"
 #include "core/str_array_api.h"
 #include "extended/gff3_in_stream_api.h"
 #include "extended/node_stream_api.h"
@@ -37,9 +38,24 @@ void                     gt_gff3_in_stream_set_offset(GtNodeStream*, GtWord);
 int                      gt_gff3_in_stream_set_offsetfile(GtNodeStream*, GtStr*,
                                                           GtError*);
 void                     gt_gff3_in_stream_disable_add_ids(GtNodeStream*);
+/* Restrict <gff3_in_stream> to the feature trees on <seqid> which overlap
+   <range>. The single input file must be sorted, BGZF compressed and indexed
+   with <gt_gff3_index_build()>. Only the region node of <seqid> and the
+   overlapping trees are delivered. Returns -1 and sets <err> if the index
+   cannot be loaded. */
+int                      gt_gff3_in_stream_restrict_to_region(GtNodeStream
+                                                              *gff3_in_stream,
+                                                              const char *seqid,
+                                                              const GtRange
+                                                              *range,
+                                                              GtError *err);
 void                     gt_gff3_in_stream_fix_region_boundaries(
                                                                GtGFF3InStream*);
 void                     gt_gff3_in_stream_enable_strict_mode(GtGFF3InStream
                                                               *gff3_in_stream);
+/* Parse the input of <gff3_in_stream> with multiple threads, the resulting
+   nodes are the same as in the serial case. */
+void                     gt_gff3_in_stream_enable_parallel_mode(GtGFF3InStream
+                                                              *gff3_in_stream);
 
 #endif
@@ -19,14 +19,19 @@
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
 #include "core/cstr_table.h"
+#include "core/file.h"
 #include "core/fileutils_api.h"
 #include "core/queue.h"
 #include "core/progressbar.h"
 #include "core/str_array.h"
+#include "extended/feature_node_api.h"
 #include "extended/genome_node.h"
 #include "extended/gff3_in_stream_plain.h"
+#include "extended/gff3_index.h"
 #include "extended/gff3_parser.h"
 #include "extended/node_stream_api.h"
+#include "extended/region_node_api.h"
+#include "extended/sequence_node_api.h"
 
 struct GtGFF3InStreamPlain {
   const GtNodeStream parent_instance;
@@ -43,6 +48,17 @@ struct GtGFF3InStreamPlain {
   GtQueue *genome_node_buffer;
   GtGFF3Parser *gff3_parser;
   GtCstrTable *used_types;
+  /* restriction to a region (see
+     <gt_gff3_in_stream_plain_restrict_to_region()>) */
+  GtStr *region_seqid;
+  GtRange region_range,
+          seqid_range;
+  GtUint64 region_voffset,
+           region_line_number;
+  bool region_indexed,
+       region_found,
+       region_node_emitted,
+       region_done;
 };
 
 #define gff3_in_stream_plain_cast(NS)\
@@ -71,8 +87,8 @@ static int buffer_is_sorted(void **elem, void *info, GtError *err)
   return 0;
 }
 
-static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
-                                     GtError *err)
+static int gff3_in_stream_plain_next_node(GtNodeStream *ns, GtGenomeNode **gn,
+                                          GtError *err)
 {
   GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
   GtStr *filenamestr;
@@ -107,6 +123,15 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
           is->file_is_open = true;
           is->stdin_argument = true;
         }
+        else if (is->region_seqid) {
+          /* start parsing at the position given by the index */
+          is->fpin = gt_file_xopen_file_mode(GT_FILE_MODE_BGZF,
+                                             gt_str_array_get(is->files,
+                                                              is->next_file),
+                                             "r");
+          is->file_is_open = true;
+          had_err = gt_file_bgzf_seek(is->fpin, is->region_voffset, err);
+        }
         else {
           is->fpin = gt_file_xopen(gt_str_array_get(is->files,
                                                        is->next_file), "r");
@@ -120,7 +145,9 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
         is->fpin = NULL;
         is->file_is_open = true;
       }
-      is->line_number = 0;
+      is->line_number = is->region_seqid ? is->region_line_number - 1 : 0;
+      if (had_err)
+        break;
 
       if (!had_err && is->progress_bar) {
         printf("processing file \"%s\"\n", gt_str_array_size(is->files)
@@ -191,6 +218,60 @@ static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
   return had_err;
 }
 
+/* Deliver the region node of the sequence region the stream is restricted to,
+   followed by the feature trees overlapping the restriction range. Parsing
+   starts at the first tree which might overlap the range and stops at the
+   first tree starting behind it. */
+static int gff3_in_stream_plain_next_in_region(GtNodeStream *ns,
+                                               GtGenomeNode **gn,
+                                               GtError *err)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  int had_err = 0;
+  gt_error_check(err);
+  if (!is->region_done && !is->region_node_emitted) {
+    is->region_node_emitted = true;
+    if (is->region_indexed) {
+      *gn = gt_region_node_new(is->region_seqid, is->seqid_range.start,
+                               is->seqid_range.end);
+      return 0;
+    }
+  }
+  if (!is->region_done && is->region_found) {
+    while (!(had_err = gff3_in_stream_plain_next_node(ns, gn, err)) && *gn) {
+      if (gt_feature_node_try_cast(*gn)) {
+        GtRange range = gt_genome_node_get_range(*gn);
+        if (gt_str_cmp(gt_genome_node_get_seqid(*gn), is->region_seqid) ||
+            range.start > is->region_range.end) {
+          gt_genome_node_delete(*gn);
+          break;
+        }
+        if (range.end >= is->region_range.start)
+          return 0;
+      }
+      else if (gt_sequence_node_try_cast(*gn)) {
+        /* the FASTA section follows the last tree */
+        gt_genome_node_delete(*gn);
+        break;
+      }
+      gt_genome_node_delete(*gn);
+    }
+  }
+  is->region_done = true;
+  *gn = NULL;
+  return had_err;
+}
+
+static int gff3_in_stream_plain_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                     GtError *err)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  gt_error_check(err);
+  if (is->region_seqid)
+    return gff3_in_stream_plain_next_in_region(ns, gn, err);
+  return gff3_in_stream_plain_next_node(ns, gn, err);
+}
+
 static void gff3_in_stream_plain_free(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *gff3_in_stream_plain = gff3_in_stream_plain_cast(ns);
@@ -204,6 +285,7 @@ static void gff3_in_stream_plain_free(GtNodeStream *ns)
   gt_gff3_parser_delete(gff3_in_stream_plain->gff3_parser);
   gt_cstr_table_delete(gff3_in_stream_plain->used_types);
   gt_file_delete(gff3_in_stream_plain->fpin);
+  gt_str_delete(gff3_in_stream_plain->region_seqid);
 }
 
 const GtNodeStreamClass* gt_gff3_in_stream_plain_class(void)
@@ -297,6 +379,41 @@ void gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream *ns)
   gt_gff3_parser_enable_strict_mode(is->gff3_parser);
 }
 
+void gt_gff3_in_stream_plain_enable_parallel_mode(GtNodeStream *ns)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  gt_assert(is);
+  gt_gff3_parser_enable_parallel_mode(is->gff3_parser);
+}
+
+int gt_gff3_in_stream_plain_restrict_to_region(GtNodeStream *ns,
+                                               const char *seqid,
+                                               const GtRange *range,
+                                               GtError *err)
+{
+  GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
+  GtGFF3Index *gff3_index;
+  gt_error_check(err);
+  gt_assert(is && seqid && range && !is->region_seqid);
+  if (gt_str_array_size(is->files) != 1 ||
+      !strcmp(gt_str_array_get(is->files, 0), "-")) {
+    gt_error_set(err, "a region can only be selected from a single indexed "
+                 "file");
+    return -1;
+  }
+  if (!(gff3_index = gt_gff3_index_new(gt_str_array_get(is->files, 0), err)))
+    return -1;
+  is->region_seqid = gt_str_new_cstr(seqid);
+  is->region_range = *range;
+  is->region_indexed = gt_gff3_index_get_region(gff3_index, seqid,
+                                                &is->seqid_range);
+  is->region_found = gt_gff3_index_lookup(gff3_index, seqid, range->start,
+                                          &is->region_voffset,
+                                          &is->region_line_number);
+  gt_gff3_index_delete(gff3_index);
+  return 0;
+}
+
 void gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream *ns)
 {
   GtGFF3InStreamPlain *is = gff3_in_stream_plain_cast(ns);
@@ -19,6 +19,7 @@
 #define GFF3_IN_STREAM_PLAIN_H
 
 #include <stdio.h>
+#include "core/range_api.h"
 #include "extended/gff3_in_stream_plain.h"
 #include "extended/node_stream_api.h"
 #include "extended/type_checker_api.h"
@@ -36,8 +37,15 @@ void          gt_gff3_in_stream_plain_check_region_boundaries(
                                                           GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_do_not_check_region_boundaries(
                                                           GtGFF3InStreamPlain*);
+/* Restrict the stream to the feature trees on <seqid> which overlap <range>,
+   using the index of its single input file (see <GtGFF3Index>). */
+int           gt_gff3_in_stream_plain_restrict_to_region(GtNodeStream*,
+                                                         const char *seqid,
+                                                         const GtRange *range,
+                                                         GtError*);
 void          gt_gff3_in_stream_plain_enable_tidy_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_enable_strict_mode(GtNodeStream*);
+void          gt_gff3_in_stream_plain_enable_parallel_mode(GtNodeStream*);
 void          gt_gff3_in_stream_plain_show_progress_bar(GtGFF3InStreamPlain*);
 void          gt_gff3_in_stream_plain_set_type_checker(GtNodeStream*,
                                                        GtTypeChecker*);
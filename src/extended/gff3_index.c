@@ -0,0 +1,536 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <string.h>
+#include "core/array.h"
+#include "core/bgzf.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/hashmap.h"
+#include "core/ma.h"
+#include "core/str_api.h"
+#include "core/xansi_api.h"
+#include "extended/feature_node_iterator_api.h"
+#include "extended/gff3_in_stream.h"
+#include "extended/gff3_index.h"
+#include "extended/region_node_api.h"
+
+#define GT_GFF3_INDEX_MAGIC       "GTGFF3I1"
+#define GT_GFF3_INDEX_WINDOW_SIZE 16384UL
+
+typedef struct {
+  GtUint64 window,
+           voffset,
+           line_number; /* 0 if no tree overlaps or follows the window */
+} GFF3IndexWindow;
+
+typedef struct {
+  GtStr *seqid;
+  GtRange range;
+  bool has_region,
+       has_trees;
+  GtUword first_window, /* the first window overlapped by a tree */
+          end_window;   /* behind the last window overlapped by a tree */
+  /* only the windows whose entry differs from the preceding window are
+     stored, in ascending order */
+  GtArray *windows;
+} GFF3IndexSeqid;
+
+struct GtGFF3Index {
+  GtArray *seqids;
+  GtHashmap *seqid_to_entry;
+};
+
+static GtGFF3Index* gff3_index_new_empty(void)
+{
+  GtGFF3Index *gff3_index = gt_malloc(sizeof *gff3_index);
+  gff3_index->seqids = gt_array_new(sizeof (GFF3IndexSeqid*));
+  gff3_index->seqid_to_entry = gt_hashmap_new(GT_HASH_STRING, NULL, NULL);
+  return gff3_index;
+}
+
+static GFF3IndexSeqid* gff3_index_add_seqid(GtGFF3Index *gff3_index,
+                                            GtStr *seqid)
+{
+  GFF3IndexSeqid *entry = gt_malloc(sizeof *entry);
+  entry->seqid = gt_str_clone(seqid);
+  entry->range.start = entry->range.end = 0;
+  entry->has_region = entry->has_trees = false;
+  entry->first_window = entry->end_window = 0;
+  entry->windows = gt_array_new(sizeof (GFF3IndexWindow));
+  gt_array_add(gff3_index->seqids, entry);
+  gt_hashmap_add(gff3_index->seqid_to_entry, gt_str_get(entry->seqid), entry);
+  return entry;
+}
+
+static GFF3IndexSeqid* gff3_index_get_seqid(GtGFF3Index *gff3_index,
+                                            GtStr *seqid)
+{
+  GFF3IndexSeqid *entry = gt_hashmap_get(gff3_index->seqid_to_entry,
+                                         gt_str_get(seqid));
+  if (!entry)
+    entry = gff3_index_add_seqid(gff3_index, seqid);
+  return entry;
+}
+
+/* Determine the first and the last line of the feature tree <fn>. */
+static void gff3_index_tree_lines(GtFeatureNode *fn, GtUint64 *first_line,
+                                  GtUint64 *last_line)
+{
+  GtFeatureNodeIterator *fni = gt_feature_node_iterator_new(fn);
+  GtFeatureNode *child;
+  *first_line = *last_line = 0;
+  while ((child = gt_feature_node_iterator_next(fni))) {
+    GtUint64 line_number = gt_genome_node_get_line_number((GtGenomeNode*)
+                                                          child);
+    if (!line_number) /* pseudo-feature */
+      continue;
+    if (!*first_line || line_number < *first_line)
+      *first_line = line_number;
+    if (line_number > *last_line)
+      *last_line = line_number;
+  }
+  gt_feature_node_iterator_delete(fni);
+}
+
+static void gff3_index_add_tree(GFF3IndexSeqid *entry, GtRange range,
+                                GtUint64 first_line)
+{
+  GFF3IndexWindow empty = { 0, 0, 0 }, *window;
+  GtUword i;
+  /* the trees are sorted, hence the first one determines the first window */
+  if (!entry->has_trees)
+    entry->first_window = range.start / GT_GFF3_INDEX_WINDOW_SIZE;
+  while (entry->first_window + gt_array_size(entry->windows) <=
+         range.end / GT_GFF3_INDEX_WINDOW_SIZE) {
+    gt_array_add(entry->windows, empty);
+  }
+  for (i = range.start / GT_GFF3_INDEX_WINDOW_SIZE;
+       i <= range.end / GT_GFF3_INDEX_WINDOW_SIZE; i++) {
+    window = gt_array_get(entry->windows, i - entry->first_window);
+    if (!window->line_number || first_line < window->line_number)
+      window->line_number = first_line;
+  }
+  if (!entry->has_trees) {
+    entry->has_trees = true;
+    if (!entry->has_region)
+      entry->range = range;
+  }
+  else if (!entry->has_region)
+    entry->range = gt_range_join(&entry->range, &range);
+}
+
+/* Collect the sequence regions and the first line of the first feature tree
+   overlapping each window from <gff3file>. The trees on each sequence region
+   must be sorted and must not be interleaved with other trees. */
+static int gff3_index_collect_lines(GtGFF3Index *gff3_index,
+                                    const char *gff3file, GtError *err)
+{
+  GtNodeStream *gff3_in_stream;
+  GFF3IndexSeqid *last_entry = NULL;
+  GtGenomeNode *gn;
+  GtUint64 last_tree_line = 0;
+  GtUword last_start = 0;
+  int had_err;
+  gt_error_check(err);
+  gff3_in_stream = gt_gff3_in_stream_new_unsorted(1, &gff3file);
+  while (!(had_err = gt_node_stream_next(gff3_in_stream, &gn, err)) && gn) {
+    GtFeatureNode *fn;
+    GtRegionNode *rn;
+    if ((rn = gt_region_node_try_cast(gn))) {
+      GFF3IndexSeqid *entry = gff3_index_get_seqid(gff3_index,
+                                                 gt_genome_node_get_seqid(gn));
+      entry->range = gt_genome_node_get_range(gn);
+      entry->has_region = true;
+    }
+    else if ((fn = gt_feature_node_try_cast(gn))) {
+      GFF3IndexSeqid *entry = gff3_index_get_seqid(gff3_index,
+                                                 gt_genome_node_get_seqid(gn));
+      GtRange range = gt_genome_node_get_range(gn);
+      GtUint64 first_line, last_line;
+      gff3_index_tree_lines(fn, &first_line, &last_line);
+      if (first_line <= last_tree_line) {
+        gt_error_set(err, "the feature tree on line " GT_LLU " in file "
+                     "\"%s\" is interleaved with the preceding one (use 'gt "
+                     "gff3 -sort' to separate them)", first_line, gff3file);
+        had_err = -1;
+      }
+      else if (entry == last_entry ? range.start < last_start
+                                   : entry->has_trees) {
+        gt_error_set(err, "the file %s is not sorted (example: line " GT_LLU
+                     ")", gff3file, first_line);
+        had_err = -1;
+      }
+      else {
+        gff3_index_add_tree(entry, range, first_line);
+        last_entry = entry;
+        last_start = range.start;
+        last_tree_line = last_line;
+      }
+    }
+    gt_genome_node_delete(gn);
+    if (had_err)
+      break;
+  }
+  gt_node_stream_delete(gff3_in_stream);
+  return had_err;
+}
+
+static int compare_uint64(const void *a, const void *b)
+{
+  GtUint64 x = *(const GtUint64*) a, y = *(const GtUint64*) b;
+  if (x < y)
+    return -1;
+  if (x > y)
+    return 1;
+  return 0;
+}
+
+/* Determine the virtual offsets of the lines stored in the windows by reading
+   the BGZF compressed <gff3file> once. */
+static int gff3_index_determine_offsets(GtGFF3Index *gff3_index,
+                                        const char *gff3file, GtError *err)
+{
+  GtArray *lines, *voffsets;
+  GtBgzf *bgzf;
+  GtUword i, j, k, next = 0;
+  GtUint64 line_number = 1;
+  int c, had_err = 0;
+  gt_error_check(err);
+  if (!(bgzf = gt_bgzf_open(gff3file, "r", err)))
+    return -1;
+  lines = gt_array_new(sizeof (GtUint64));
+  voffsets = gt_array_new(sizeof (GtUint64));
+  for (i = 0; i < gt_array_size(gff3_index->seqids); i++) {
+    GFF3IndexSeqid *entry = *(GFF3IndexSeqid**) gt_array_get(gff3_index
+                                                             ->seqids, i);
+    for (j = 0; j < gt_array_size(entry->windows); j++) {
+      GFF3IndexWindow *window = gt_array_get(entry->windows, j);
+      if (window->line_number)
+        gt_array_add(lines, window->line_number);
+    }
+  }
+  gt_array_sort(lines, compare_uint64);
+  /* scan the file, remembering the offset of every needed line */
+  if (gt_array_size(lines)) {
+    GtUint64 voffset = gt_bgzf_tell(bgzf);
+    for (;;) {
+      while (next < gt_array_size(lines) &&
+             *(GtUint64*) gt_array_get(lines, next) == line_number) {
+        gt_array_add(voffsets, voffset);
+        next++;
+      }
+      if (next == gt_array_size(lines))
+        break;
+      while ((c = gt_bgzf_xfgetc(bgzf)) != EOF && c != '\n')
+        /* nothing */;
+      if (c == EOF)
+        break;
+      line_number++;
+      voffset = gt_bgzf_tell(bgzf);
+    }
+  }
+  gt_bgzf_close(bgzf);
+  if (next < gt_array_size(lines)) {
+    gt_error_set(err, "file \"%s\" ended unexpectedly", gff3file);
+    had_err = -1;
+  }
+  /* store the offsets in the windows, fill the empty windows, and remove the
+     windows which equal their predecessor */
+  for (i = 0; !had_err && i < gt_array_size(gff3_index->seqids); i++) {
+    GFF3IndexSeqid *entry = *(GFF3IndexSeqid**) gt_array_get(gff3_index
+                                                             ->seqids, i);
+    GFF3IndexWindow following = { 0, 0, 0 }, *windows;
+    for (j = gt_array_size(entry->windows); j > 0; j--) {
+      GFF3IndexWindow *window = gt_array_get(entry->windows, j-1);
+      if (window->line_number) {
+        GtUint64 *line = bsearch(&window->line_number,
+                                 gt_array_get_space(lines),
+                                 gt_array_size(lines), sizeof (GtUint64),
+                                 compare_uint64);
+        gt_assert(line);
+        window->voffset = *(GtUint64*) gt_array_get(voffsets,
+                                                    line - (GtUint64*)
+                                                    gt_array_get_space(lines));
+        following = *window;
+      }
+      else
+        *window = following;
+    }
+    windows = gt_array_get_space(entry->windows);
+    for (j = 0, k = 0; j < gt_array_size(entry->windows); j++) {
+      if (!k || windows[j].line_number != windows[k-1].line_number) {
+        windows[k] = windows[j];
+        windows[k++].window = entry->first_window + j;
+      }
+    }
+    entry->end_window = entry->first_window + gt_array_size(entry->windows);
+    gt_array_set_size(entry->windows, k);
+  }
+  gt_array_delete(voffsets);
+  gt_array_delete(lines);
+  return had_err;
+}
+
+static void gff3_index_write(const GtGFF3Index *gff3_index, FILE *fp,
+                             GtUint64 filesize)
+{
+  GtUint64 value;
+  GtUword i;
+  gt_xfwrite(GT_GFF3_INDEX_MAGIC, sizeof (char), strlen(GT_GFF3_INDEX_MAGIC),
+             fp);
+  gt_xfwrite(&filesize, sizeof (GtUint64), 1, fp);
+  value = GT_GFF3_INDEX_WINDOW_SIZE;
+  gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+  value = gt_array_size(gff3_index->seqids);
+  gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+  for (i = 0; i < gt_array_size(gff3_index->seqids); i++) {
+    GFF3IndexSeqid *entry = *(GFF3IndexSeqid**) gt_array_get(gff3_index
+                                                             ->seqids, i);
+    value = gt_str_length(entry->seqid);
+    gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+    gt_xfwrite(gt_str_get(entry->seqid), sizeof (char), value, fp);
+    value = entry->range.start;
+    gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+    value = entry->range.end;
+    gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+    value = entry->end_window;
+    gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+    value = gt_array_size(entry->windows);
+    gt_xfwrite(&value, sizeof (GtUint64), 1, fp);
+    if (value) {
+      gt_xfwrite(gt_array_get_space(entry->windows), sizeof (GFF3IndexWindow),
+                 value, fp);
+    }
+  }
+}
+
+int gt_gff3_index_build(const char *gff3file, GtError *err)
+{
+  GtGFF3Index *gff3_index;
+  GtStr *indexfile;
+  FILE *fp = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gff3file);
+  if (!gt_bgzf_is_bgzf(gff3file)) {
+    gt_error_set(err, "file \"%s\" is not BGZF compressed (use 'gt gff3 -sort "
+                 "-bgzip' to create an indexable file)", gff3file);
+    return -1;
+  }
+  gff3_index = gff3_index_new_empty();
+  had_err = gff3_index_collect_lines(gff3_index, gff3file, err);
+  if (!had_err)
+    had_err = gff3_index_determine_offsets(gff3_index, gff3file, err);
+  if (!had_err) {
+    indexfile = gt_str_new_cstr(gff3file);
+    gt_str_append_cstr(indexfile, GT_GFF3_INDEX_SUFFIX);
+    if (!(fp = gt_fa_fopen(gt_str_get(indexfile), "wb", err)))
+      had_err = -1;
+    else {
+      gff3_index_write(gff3_index, fp, gt_file_size(gff3file));
+      gt_fa_xfclose(fp);
+    }
+    gt_str_delete(indexfile);
+  }
+  gt_gff3_index_delete(gff3_index);
+  return had_err;
+}
+
+static int gff3_index_read(void *buf, size_t size, size_t nmemb, FILE *fp,
+                           const char *indexfile, GtError *err)
+{
+  gt_error_check(err);
+  if (fread(buf, size, nmemb, fp) != nmemb) {
+    gt_error_set(err, "index file \"%s\" is truncated", indexfile);
+    return -1;
+  }
+  return 0;
+}
+
+static int gff3_index_read_seqid(GtGFF3Index *gff3_index, FILE *fp,
+                                 GtStr *seqid, const char *indexfile,
+                                 GtError *err)
+{
+  GFF3IndexSeqid *entry;
+  GtUint64 value, end, i;
+  int had_err;
+  gt_error_check(err);
+  gt_str_reset(seqid);
+  had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp, indexfile, err);
+  if (!had_err) {
+    char *buf = gt_malloc(value * sizeof (char));
+    had_err = gff3_index_read(buf, sizeof (char), value, fp, indexfile, err);
+    if (!had_err)
+      gt_str_append_cstr_nt(seqid, buf, value);
+    gt_free(buf);
+  }
+  if (had_err)
+    return had_err;
+  entry = gff3_index_add_seqid(gff3_index, seqid);
+  had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp, indexfile, err);
+  if (!had_err) {
+    had_err = gff3_index_read(&end, sizeof (GtUint64), 1, fp, indexfile,
+                              err);
+  }
+  if (!had_err) {
+    entry->range.start = value;
+    entry->range.end = end;
+    had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp, indexfile,
+                              err);
+  }
+  if (!had_err) {
+    entry->end_window = value;
+    had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp, indexfile,
+                              err);
+  }
+  if (!had_err && value) {
+    GFF3IndexWindow *windows = gt_malloc(value * sizeof *windows);
+    had_err = gff3_index_read(windows, sizeof *windows, value, fp, indexfile,
+                              err);
+    for (i = 0; !had_err && i < value; i++)
+      gt_array_add(entry->windows, windows[i]);
+    gt_free(windows);
+  }
+  return had_err;
+}
+
+GtGFF3Index* gt_gff3_index_new(const char *gff3file, GtError *err)
+{
+  GtGFF3Index *gff3_index;
+  GtStr *indexfile, *seqid;
+  char magic[sizeof (GT_GFF3_INDEX_MAGIC)];
+  GtUint64 value, i;
+  FILE *fp;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(gff3file);
+  indexfile = gt_str_new_cstr(gff3file);
+  gt_str_append_cstr(indexfile, GT_GFF3_INDEX_SUFFIX);
+  if (!gt_file_exists(gt_str_get(indexfile))) {
+    gt_error_set(err, "file \"%s\" has not been indexed (use 'gt gff3index' "
+                 "to create index file \"%s\")", gff3file,
+                 gt_str_get(indexfile));
+    gt_str_delete(indexfile);
+    return NULL;
+  }
+  if (!(fp = gt_fa_fopen(gt_str_get(indexfile), "rb", err))) {
+    gt_str_delete(indexfile);
+    return NULL;
+  }
+  gff3_index = gff3_index_new_empty();
+  seqid = gt_str_new();
+  had_err = gff3_index_read(magic, sizeof (char), strlen(GT_GFF3_INDEX_MAGIC),
+                            fp, gt_str_get(indexfile), err);
+  if (!had_err && strncmp(magic, GT_GFF3_INDEX_MAGIC,
+                          strlen(GT_GFF3_INDEX_MAGIC))) {
+    gt_error_set(err, "file \"%s\" is not a GFF3 index file",
+                 gt_str_get(indexfile));
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp,
+                              gt_str_get(indexfile), err);
+  }
+  if (!had_err && value != (GtUint64) gt_file_size(gff3file)) {
+    gt_error_set(err, "index file \"%s\" does not belong to the current "
+                 "version of file \"%s\" (rebuild it with 'gt gff3index')",
+                 gt_str_get(indexfile), gff3file);
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp,
+                              gt_str_get(indexfile), err);
+  }
+  if (!had_err && value != GT_GFF3_INDEX_WINDOW_SIZE) {
+    gt_error_set(err, "index file \"%s\" has unsupported window size " GT_LLU,
+                 gt_str_get(indexfile), value);
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = gff3_index_read(&value, sizeof (GtUint64), 1, fp,
+                              gt_str_get(indexfile), err);
+  }
+  for (i = 0; !had_err && i < value; i++) {
+    had_err = gff3_index_read_seqid(gff3_index, fp, seqid,
+                                    gt_str_get(indexfile), err);
+  }
+  gt_fa_xfclose(fp);
+  gt_str_delete(seqid);
+  gt_str_delete(indexfile);
+  if (had_err) {
+    gt_gff3_index_delete(gff3_index);
+    return NULL;
+  }
+  return gff3_index;
+}
+
+bool gt_gff3_index_get_region(const GtGFF3Index *gff3_index, const char *seqid,
+                              GtRange *range)
+{
+  GFF3IndexSeqid *entry;
+  gt_assert(gff3_index && seqid && range);
+  if (!(entry = gt_hashmap_get(gff3_index->seqid_to_entry, seqid)))
+    return false;
+  *range = entry->range;
+  return true;
+}
+
+bool gt_gff3_index_lookup(const GtGFF3Index *gff3_index, const char *seqid,
+                          GtUword start, GtUint64 *voffset,
+                          GtUint64 *line_number)
+{
+  GFF3IndexSeqid *entry;
+  GFF3IndexWindow *windows;
+  GtUword window, left, right;
+  gt_assert(gff3_index && seqid && voffset && line_number);
+  window = start / GT_GFF3_INDEX_WINDOW_SIZE;
+  if (!(entry = gt_hashmap_get(gff3_index->seqid_to_entry, seqid)) ||
+      window >= entry->end_window || !gt_array_size(entry->windows)) {
+    return false;
+  }
+  /* find the last stored window not behind <window>, all trees follow the
+     windows in front of the first stored one */
+  windows = gt_array_get_space(entry->windows);
+  left = 0;
+  right = gt_array_size(entry->windows) - 1;
+  while (left < right) {
+    GtUword mid = left + (right - left + 1) / 2;
+    if (windows[mid].window <= window)
+      left = mid;
+    else
+      right = mid - 1;
+  }
+  *voffset = windows[left].voffset;
+  *line_number = windows[left].line_number;
+  return true;
+}
+void gt_gff3_index_delete(GtGFF3Index *gff3_index)
+{
+  GtUword i;
+  if (!gff3_index) return;
+  for (i = 0; i < gt_array_size(gff3_index->seqids); i++) {
+    GFF3IndexSeqid *entry = *(GFF3IndexSeqid**) gt_array_get(gff3_index
+                                                             ->seqids, i);
+    gt_str_delete(entry->seqid);
+    gt_array_delete(entry->windows);
+    gt_free(entry);
+  }
+  gt_array_delete(gff3_index->seqids);
+  gt_hashmap_delete(gff3_index->seqid_to_entry);
+  gt_free(gff3_index);
+}
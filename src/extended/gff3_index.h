@@ -0,0 +1,59 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef GFF3_INDEX_H
+#define GFF3_INDEX_H
+
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "core/types_api.h"
+
+/* Suffix of the index files built by <gt_gff3_index_build()>. */
+#define GT_GFF3_INDEX_SUFFIX ".gti"
+
+/* A <GtGFF3Index> maps coordinates of a sorted and BGZF compressed GFF3 file
+   to virtual offsets in the file (see <GtBgzf>), similar to a tabix index.
+   Every sequence region is divided into windows of fixed size. For every
+   window the index stores the position of the first feature tree which
+   overlaps the window or (if there is none) which follows it. Hence all
+   feature trees overlapping a given range can be found by starting to parse
+   the file at the position stored for the window containing the range start
+   and stopping at the first tree which starts behind the range end. */
+typedef struct GtGFF3Index GtGFF3Index;
+
+/* Build the index for the sorted and BGZF compressed GFF3 file <gff3file> (as
+   written by `gt gff3 -sort -bgzip`) and store it in the file <gff3file> with
+   suffix <GT_GFF3_INDEX_SUFFIX>. The lines of different feature trees must not
+   be interleaved. Returns -1 and sets <err> on error. */
+int          gt_gff3_index_build(const char *gff3file, GtError *err);
+/* Load the index of <gff3file> built by <gt_gff3_index_build()>. Returns NULL
+   and sets <err> if the index does not exist or does not fit <gff3file>. */
+GtGFF3Index* gt_gff3_index_new(const char *gff3file, GtError *err);
+/* Return true if <seqid> occurs in the indexed file and store the range of
+   its sequence region in <range>. */
+bool         gt_gff3_index_get_region(const GtGFF3Index *gff3_index,
+                                      const char *seqid, GtRange *range);
+/* Return true if there may be feature trees on <seqid> which overlap a range
+   starting at <start>. In this case the virtual offset of the first line to
+   parse is stored in <voffset> and its (1-based) line number in
+   <line_number>. */
+bool         gt_gff3_index_lookup(const GtGFF3Index *gff3_index,
+                                  const char *seqid, GtUword start,
+                                  GtUint64 *voffset, GtUint64 *line_number);
+void         gt_gff3_index_delete(GtGFF3Index *gff3_index);
+
+#endif
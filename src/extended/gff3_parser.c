@@ -16,6 +16,7 @@
 */
 
 #include <ctype.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,6 +30,8 @@
 #include "core/parseutils.h"
 #include "core/queue.h"
 #include "core/splitter.h"
+#include "core/str.h"
+#include "core/thread_pool.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
@@ -44,6 +47,29 @@
 #include "extended/orphanage.h"
 #include "extended/region_node.h"
 
+/* In parallel mode the input is read in blocks of at most
+   <GT_GFF3_PARSER_BLOCK_LINES> lines or <GT_GFF3_PARSER_BLOCK_SIZE> bytes. */
+#define GT_GFF3_PARSER_BLOCK_LINES  65536UL
+#define GT_GFF3_PARSER_BLOCK_SIZE   (16UL << 20)
+/* number of lines of a block which are prepared as one unit */
+#define GT_GFF3_PARSER_GRAINSIZE    256UL
+
+typedef struct {
+  GtGenomeNode *feature_node; /* prepared feature, NULL if the line has to be
+                                 parsed from scratch */
+  GtUword offset, /* of the line in the block buffer */
+          length,
+          source_offset, /* of the source column relative to the line */
+          source_length;
+} GFF3BlockLine;
+
+typedef struct {
+  GtStr *buffer; /* contains the lines, each terminated by '\0' */
+  GtArray *lines;
+  GtUword next_line;
+  bool gvf_mode;
+} GFF3Block;
+
 struct GtGFF3Parser {
   GtFeatureInfo *feature_info;
   GtHashmap *seqid_to_ssr_mapping, /* maps seqids to simple sequence regions */
@@ -62,6 +88,16 @@ struct GtGFF3Parser {
   GtOrphanage *orphanage;
   GtTypeChecker *type_checker;
   unsigned int last_terminator; /* line number of the last terminator */
+  bool parallel,
+       block_pending, /* <next_block> is prepared by <prepare_group> */
+       reading_stopped, /* the remaining input is read line by line */
+       input_eof,
+       input_gvf_mode;
+  GtUint64 input_line_number;
+  GFF3Block *current_block,
+            *next_block;
+  GtThreadPoolGroup *prepare_group;
+  GtStr *source_buffer;
 };
 
 typedef struct {
@@ -91,6 +127,37 @@ static void simple_sequence_region_delete(SimpleSequenceRegion *ssr)
   gt_free(ssr);
 }
 
+static GFF3Block* gff3_block_new(void)
+{
+  GFF3Block *block = gt_malloc(sizeof *block);
+  block->buffer = gt_str_new();
+  block->lines = gt_array_new(sizeof (GFF3BlockLine));
+  block->next_line = 0;
+  block->gvf_mode = false;
+  return block;
+}
+
+static void gff3_block_reset(GFF3Block *block)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(block->lines); i++) {
+    GFF3BlockLine *block_line = gt_array_get(block->lines, i);
+    gt_genome_node_delete(block_line->feature_node);
+  }
+  gt_array_reset(block->lines);
+  gt_str_reset(block->buffer);
+  block->next_line = 0;
+}
+
+static void gff3_block_delete(GFF3Block *block)
+{
+  if (!block) return;
+  gff3_block_reset(block);
+  gt_array_delete(block->lines);
+  gt_str_delete(block->buffer);
+  gt_free(block);
+}
+
 GtGFF3Parser* gt_gff3_parser_new(GtTypeChecker *type_checker)
 {
   GtGFF3Parser *parser;
@@ -159,6 +226,18 @@ void gt_gff3_parser_enable_strict_mode(GtGFF3Parser *parser)
   parser->strict = true;
 }
 
+void gt_gff3_parser_enable_parallel_mode(GtGFF3Parser *parser)
+{
+  gt_assert(parser);
+  if (parser->parallel)
+    return;
+  parser->parallel = true;
+  parser->current_block = gff3_block_new();
+  parser->next_block = gff3_block_new();
+  parser->prepare_group = gt_thread_pool_group_new(gt_thread_pool_get());
+  parser->source_buffer = gt_str_new();
+}
+
 void gt_gff3_parser_enable_tidy_mode(GtGFF3Parser *parser)
 {
   gt_assert(parser && !parser->strict);
@@ -1149,6 +1228,41 @@ return (strcmp(attr_tag, GT_GVF_GENOTYPE) &&
         strcmp(attr_tag, GT_GVF_ZYGOSITY));
 }
 
+/* Link <feature_node> according to its ID and Parent attributes, which have
+   the values <id_value> and <parent_value> (or NULL). */
+static int process_id_and_parent_attr(const char *id_value, char *parent_value,
+                                      GtGenomeNode *feature_node,
+                                      bool *is_child, GtGFF3Parser *parser,
+                                      GtQueue *genome_nodes,
+                                      const char *filename,
+                                      unsigned int line_number, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+
+  if (id_value) {
+    had_err = store_id(id_value, (GtFeatureNode*) feature_node, is_child,
+                       parser, genome_nodes, filename, line_number, err);
+  }
+  if (!had_err && parent_value) {
+    had_err = process_parent_attr(parent_value, feature_node, id_value,
+                                  is_child, parser, genome_nodes, filename,
+                                  line_number, err);
+  }
+
+  if (!had_err && gt_feature_node_is_multi((GtFeatureNode*) feature_node)) {
+    had_err =
+      check_multi_feature_constrains(feature_node, (GtGenomeNode*)
+                    gt_feature_node_get_multi_representative((GtFeatureNode*)
+                                                             feature_node),
+                    gt_feature_node_get_attribute((GtFeatureNode*) feature_node,
+                                                  GT_GFF_ID),
+                                     parser, filename, line_number, err);
+  }
+
+  return had_err;
+}
+
 static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
                             bool *is_child, GtGFF3Parser *parser,
                             const char *seqid, GtQueue *genome_nodes,
@@ -1350,24 +1464,10 @@ static int parse_attributes(char *attributes, GtGenomeNode *feature_node,
     }
   }
 
-  if (!had_err && id_value) {
-    had_err = store_id(id_value, (GtFeatureNode*) feature_node, is_child,
-                       parser, genome_nodes, filename, line_number, err);
-  }
-  if (!had_err && parent_value) {
-    had_err = process_parent_attr(parent_value, feature_node, id_value,
-                                  is_child, parser, genome_nodes, filename,
-                                  line_number, err);
-  }
-
-  if (!had_err && gt_feature_node_is_multi((GtFeatureNode*) feature_node)) {
-    had_err =
-      check_multi_feature_constrains(feature_node, (GtGenomeNode*)
-                    gt_feature_node_get_multi_representative((GtFeatureNode*)
-                                                             feature_node),
-                    gt_feature_node_get_attribute((GtFeatureNode*) feature_node,
-                                                  GT_GFF_ID),
-                                     parser, filename, line_number, err);
+  if (!had_err) {
+    had_err = process_id_and_parent_attr(id_value, parent_value, feature_node,
+                                         is_child, parser, genome_nodes,
+                                         filename, line_number, err);
   }
 
   gt_splitter_delete(parent_splitter);
@@ -1551,6 +1651,330 @@ static int parse_gff3_feature_line(GtGFF3Parser *parser,
   return had_err;
 }
 
+static bool parse_prepared_position(GtUword *value, const char *position)
+{
+  GtWord val;
+  char *ep;
+  errno = 0;
+  val = strtol(position, &ep, 10);
+  if (position[0] == '\0' || *ep != '\0' || errno == ERANGE || val < 1)
+    return false;
+  *value = val;
+  return true;
+}
+
+/* Returns true, if all attributes in <attributes> have been added to
+   <feature_node> such that <parse_attributes()> would neither have reported
+   an error nor a warning and no attribute requires special care except for
+   the ID and Parent attributes. */
+static bool prepare_attributes(GtFeatureNode *feature_node, char *attributes,
+                               bool gvf_mode, GtSplitter *attribute_splitter,
+                               GtSplitter *tmp_splitter)
+{
+  GtUword i;
+  gt_splitter_reset(attribute_splitter);
+  gt_splitter_split(attribute_splitter, attributes, strlen(attributes), ';');
+  for (i = 0; i < gt_splitter_size(attribute_splitter); i++) {
+    char *attr_tag, *attr_value,
+         *token = gt_splitter_get_token(attribute_splitter, i);
+    if (token[0] == '.') {
+      if (gt_splitter_size(attribute_splitter) > 1)
+        return false;
+      break; /* no attributes */
+    }
+    if (is_blank_attribute(token))
+      continue;
+    gt_splitter_reset(tmp_splitter);
+    gt_splitter_split(tmp_splitter, token, strlen(token), '=');
+    if (gt_splitter_size(tmp_splitter) != 2)
+      return false;
+    attr_tag = gt_splitter_get_token(tmp_splitter, 0);
+    while (attr_tag[0] == ' ')
+      attr_tag++;
+    attr_value = gt_splitter_get_token(tmp_splitter, 1);
+    if (attr_tag[0] == '\0' || attr_value[0] == '\0')
+      return false;
+    if (isupper(attr_tag[0]) && invalid_uppercase_gff3_attribute(attr_tag) &&
+        (!gvf_mode || invalid_uppercase_gvf_attribute(attr_tag))) {
+      return false;
+    }
+    if (!strcmp(attr_tag, GT_GFF_IS_CIRCULAR) ||
+        !strcmp(attr_tag, GT_GFF_TARGET) ||
+        gt_feature_node_get_attribute(feature_node, attr_tag)) {
+      return false;
+    }
+    gt_feature_node_add_attribute(feature_node, attr_tag, attr_value);
+  }
+  return true;
+}
+
+typedef struct {
+  GtStr *line,
+        *seqid;
+  GtSplitter *splitter,
+             *attribute_splitter,
+             *tmp_splitter;
+  GtError *err;
+} GFF3PrepareInfo;
+
+/* Create the feature node for the feature <line> of length <length>, if the
+   line is well-formed. All checks and modifications which depend on the state
+   of the parser are left to <parse_prepared_gff3_feature_line()>. */
+static GtGenomeNode* prepare_gff3_feature_line(GFF3BlockLine *block_line,
+                                               const char *line, bool gvf_mode,
+                                               GFF3PrepareInfo *info)
+{
+  GtGenomeNode *feature_node;
+  GtStrand strand;
+  GtPhase phase;
+  GtRange range;
+  float score;
+  bool score_is_defined;
+  char **tokens;
+
+  if (block_line->length == 0 || line[0] == '#' || line[0] == '>')
+    return NULL;
+  gt_str_reset(info->line);
+  gt_str_append_cstr_nt(info->line, line, block_line->length);
+  gt_splitter_reset(info->splitter);
+  gt_splitter_split(info->splitter, gt_str_get(info->line), block_line->length,
+                    '\t');
+  if (gt_splitter_size(info->splitter) != 9)
+    return NULL;
+  tokens = gt_splitter_get_tokens(info->splitter);
+  if (!parse_prepared_position(&range.start, tokens[3]) ||
+      !parse_prepared_position(&range.end, tokens[4]) ||
+      range.start > range.end) {
+    return NULL;
+  }
+  if (gt_parse_score(&score_is_defined, &score, tokens[5], 0, "", info->err) ||
+      gt_parse_strand(&strand, tokens[6], 0, "", info->err) ||
+      gt_parse_phase(&phase, tokens[7], 0, "", info->err)) {
+    gt_error_unset(info->err);
+    return NULL;
+  }
+  if (!info->seqid || strcmp(gt_str_get(info->seqid), tokens[0])) {
+    gt_str_delete(info->seqid);
+    info->seqid = gt_str_new_cstr(tokens[0]);
+  }
+  feature_node = gt_feature_node_new(info->seqid, tokens[2], range.start,
+                                     range.end, strand);
+  if (!prepare_attributes((GtFeatureNode*) feature_node, tokens[8], gvf_mode,
+                          info->attribute_splitter, info->tmp_splitter)) {
+    gt_genome_node_delete(feature_node);
+    return NULL;
+  }
+  if (score_is_defined)
+    gt_feature_node_set_score((GtFeatureNode*) feature_node, score);
+  if (phase != GT_PHASE_UNDEFINED)
+    gt_feature_node_set_phase((GtFeatureNode*) feature_node, phase);
+  block_line->source_offset = tokens[1] - gt_str_get(info->line);
+  block_line->source_length = strlen(tokens[1]);
+  return feature_node;
+}
+
+static void prepare_block_lines(GtUword start, GtUword end, void *data)
+{
+  GFF3Block *block = data;
+  GFF3PrepareInfo info;
+  GtUword i;
+  info.line = gt_str_new();
+  info.seqid = NULL;
+  info.splitter = gt_splitter_new();
+  info.attribute_splitter = gt_splitter_new();
+  info.tmp_splitter = gt_splitter_new();
+  info.err = gt_error_new();
+  for (i = start; i < end; i++) {
+    GFF3BlockLine *block_line = gt_array_get(block->lines, i);
+    block_line->feature_node =
+      prepare_gff3_feature_line(block_line,
+                                gt_str_get(block->buffer) + block_line->offset,
+                                block->gvf_mode, &info);
+  }
+  gt_error_delete(info.err);
+  gt_splitter_delete(info.tmp_splitter);
+  gt_splitter_delete(info.attribute_splitter);
+  gt_splitter_delete(info.splitter);
+  gt_str_delete(info.seqid);
+  gt_str_delete(info.line);
+}
+
+static void* prepare_block(void *data)
+{
+  GFF3Block *block = data;
+  gt_thread_pool_parallel_for(gt_thread_pool_get(), 0,
+                              gt_array_size(block->lines),
+                              GT_GFF3_PARSER_GRAINSIZE, prepare_block_lines,
+                              block);
+  return NULL;
+}
+
+/* Read the next block of lines from <fpin> into <parser->next_block> and start
+   preparing its feature lines in the background. Reading in blocks stops
+   before the FASTA section, because it is parsed directly from <fpin>. */
+static void gff3_parser_read_block(GtGFF3Parser *parser, GtFile *fpin)
+{
+  GFF3Block *block = parser->next_block;
+  GtStr *line_buffer = gt_str_new();
+  gff3_block_reset(block);
+  while (gt_array_size(block->lines) < GT_GFF3_PARSER_BLOCK_LINES &&
+         gt_str_length(block->buffer) < GT_GFF3_PARSER_BLOCK_SIZE) {
+    GFF3BlockLine block_line;
+    const char *line;
+    if (gt_str_read_next_line_generic(line_buffer, fpin) == EOF) {
+      parser->input_eof = true;
+      break;
+    }
+    line = gt_str_get(line_buffer);
+    if (++parser->input_line_number == 1 &&
+        strncmp(line, GT_GFF_VERSION_PREFIX, strlen(GT_GFF_VERSION_PREFIX)) &&
+        !strncmp(line, GT_GVF_VERSION_PREFIX, strlen(GT_GVF_VERSION_PREFIX))) {
+      parser->input_gvf_mode = true;
+    }
+    block_line.feature_node = NULL;
+    block_line.offset = gt_str_length(block->buffer);
+    block_line.length = gt_str_length(line_buffer);
+    gt_array_add(block->lines, block_line);
+    gt_str_append_str(block->buffer, line_buffer);
+    gt_str_append_char(block->buffer, '\0');
+    if (line[0] == '>' || !strcmp(line, GT_GFF_FASTA_DIRECTIVE)) {
+      parser->reading_stopped = true;
+      break;
+    }
+    gt_str_reset(line_buffer);
+  }
+  gt_str_delete(line_buffer);
+  block->gvf_mode = parser->input_gvf_mode;
+  if (gt_array_size(block->lines)) {
+    gt_thread_pool_group_submit(parser->prepare_group, prepare_block, block);
+    parser->block_pending = true;
+  }
+}
+
+/* Store the next input line in <*line> and <*line_length>. In parallel mode
+   <*block_line> refers to the corresponding prepared line, otherwise it is set
+   to NULL. Returns EOF if there are no more lines. */
+static int gff3_parser_next_line(GtGFF3Parser *parser, GtStr *line_buffer,
+                                 GtFile *fpin, char **line, size_t *line_length,
+                                 GFF3BlockLine **block_line)
+{
+  *block_line = NULL;
+  while (parser->parallel) {
+    GFF3Block *block = parser->current_block;
+    if (block->next_line < gt_array_size(block->lines)) {
+      *block_line = gt_array_get(block->lines, block->next_line++);
+      *line = gt_str_get(block->buffer) + (*block_line)->offset;
+      *line_length = (*block_line)->length;
+      return 0;
+    }
+    if (!parser->block_pending) {
+      if (parser->input_eof)
+        return EOF;
+      if (parser->reading_stopped)
+        break;
+      gff3_parser_read_block(parser, fpin);
+      continue;
+    }
+    gt_thread_pool_group_wait(parser->prepare_group);
+    parser->block_pending = false;
+    parser->current_block = parser->next_block;
+    parser->next_block = block;
+    /* read ahead while the current block is processed */
+    if (!parser->input_eof && !parser->reading_stopped)
+      gff3_parser_read_block(parser, fpin);
+  }
+  if (gt_str_read_next_line_generic(line_buffer, fpin) == EOF)
+    return EOF;
+  *line = gt_str_get(line_buffer);
+  *line_length = gt_str_length(line_buffer);
+  return 0;
+}
+
+/* Process a feature line which has been converted to <feature_node> by
+   <prepare_gff3_feature_line()> exactly like <parse_gff3_feature_line()>
+   would have processed it. */
+static int parse_prepared_gff3_feature_line(GtGFF3Parser *parser,
+                                            GtQueue *genome_nodes,
+                                            GtCstrTable *used_types,
+                                            GtGenomeNode *feature_node,
+                                            const char *source,
+                                            GtStr *filenamestr,
+                                            unsigned int line_number,
+                                            GtError *err)
+{
+  GtFeatureNode *fn = (GtFeatureNode*) feature_node;
+  GtStr *seqid_str = NULL;
+  const char *type, *seqid, *filename, *value;
+  char *id_value = NULL, *parent_value = NULL;
+  bool is_child = false;
+  GtRange range;
+  int had_err = 0;
+
+  gt_error_check(err);
+
+  filename = gt_str_get(filenamestr);
+  type = gt_feature_node_get_type(fn);
+  seqid = gt_str_get(gt_genome_node_get_seqid(feature_node));
+  range = gt_genome_node_get_range(feature_node);
+
+  /* check the feature type */
+  if (parser->type_checker &&
+      !gt_type_checker_is_valid(parser->type_checker, type)) {
+    gt_error_set(err, "type \"%s\" on line %u in file \"%s\" is not a valid "
+                 "one", type, line_number, filename);
+    had_err = -1;
+  }
+  else if (!gt_cstr_table_get(used_types, type))
+    gt_cstr_table_add(used_types, type);
+
+  /* adjust the range */
+  if (!had_err) {
+    had_err = add_offset_if_necessary(&range, parser, seqid, filename,
+                                      line_number, err);
+    if (!had_err)
+      gt_genome_node_set_range(feature_node, &range);
+  }
+
+  /* get and verify seqid */
+  if (!had_err) {
+    had_err = get_seqid_str(&seqid_str, seqid, range, parser, filename,
+                            line_number, err);
+  }
+  if (!had_err)
+    had_err = verify_seqid(seqid_str, filename, line_number, err);
+
+  if (!had_err) {
+    gt_genome_node_change_seqid(feature_node, seqid_str);
+    gt_genome_node_set_origin(feature_node, filenamestr, line_number);
+    set_source(fn, source, parser->source_to_str_mapping);
+  }
+
+  /* process the ID and Parent attributes on copies, because the latter is
+     split in place */
+  if (!had_err) {
+    if ((value = gt_feature_node_get_attribute(fn, GT_GFF_ID)))
+      id_value = gt_cstr_dup(value);
+    if ((value = gt_feature_node_get_attribute(fn, GT_GFF_PARENT)))
+      parent_value = gt_cstr_dup(value);
+    had_err = process_id_and_parent_attr(id_value, parent_value, feature_node,
+                                         &is_child, parser, genome_nodes,
+                                         filename, line_number, err);
+    gt_free(parent_value);
+    gt_free(id_value);
+  }
+
+  if (!is_child) {
+    if (!had_err)
+      gt_queue_add(genome_nodes, feature_node);
+    else
+      gt_genome_node_delete(feature_node);
+  }
+
+  gt_str_delete(seqid_str);
+
+  return had_err;
+}
+
 static int parse_first_gff3_line(const char *line, const char *filename,
                                  GtQueue *genome_nodes, GtStr *filenamestr,
                                  GtUint64 *line_number,
@@ -2010,6 +2434,7 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
 {
   size_t line_length;
   GtStr *line_buffer;
+  GFF3BlockLine *block_line;
   char *line;
   const char *filename;
   int rval, had_err = 0;
@@ -2022,9 +2447,8 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   /* init */
   line_buffer = gt_str_new();
 
-  while ((rval = gt_str_read_next_line_generic(line_buffer, fpin)) != EOF) {
-    line = gt_str_get(line_buffer);
-    line_length = gt_str_length(line_buffer);
+  while ((rval = gff3_parser_next_line(parser, line_buffer, fpin, &line,
+                                       &line_length, &block_line)) != EOF) {
     (*line_number)++;
 
     if (*line_number == 1) {
@@ -2058,6 +2482,22 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
         break;
       }
     }
+    else if (block_line && block_line->feature_node) {
+      GtGenomeNode *feature_node = block_line->feature_node;
+      block_line->feature_node = NULL;
+      gt_str_reset(parser->source_buffer);
+      gt_str_append_cstr_nt(parser->source_buffer,
+                            line + block_line->source_offset,
+                            block_line->source_length);
+      had_err = parse_prepared_gff3_feature_line(parser, genome_nodes,
+                                                 used_types, feature_node,
+                                                 gt_str_get(parser
+                                                            ->source_buffer),
+                                                 filenamestr, *line_number,
+                                                 err);
+      if (had_err || (!parser->incomplete_node && gt_queue_size(genome_nodes)))
+        break;
+    }
     else {
       had_err = parse_gff3_feature_line(parser, genome_nodes, used_types, line,
                                         line_length, filenamestr, *line_number,
@@ -2098,6 +2538,17 @@ int gt_gff3_parser_parse_genome_nodes(GtGFF3Parser *parser, int *status_code,
   return had_err;
 }
 
+static void gff3_parser_reset_blocks(GtGFF3Parser *parser)
+{
+  gt_thread_pool_group_wait(parser->prepare_group);
+  gff3_block_reset(parser->current_block);
+  gff3_block_reset(parser->next_block);
+  parser->block_pending = false;
+  parser->reading_stopped = false;
+  parser->input_eof = false;
+  parser->input_line_number = 0;
+}
+
 void gt_gff3_parser_reset(GtGFF3Parser *parser)
 {
   gt_assert(parser);
@@ -2108,11 +2559,20 @@ void gt_gff3_parser_reset(GtGFF3Parser *parser)
   gt_hashmap_reset(parser->source_to_str_mapping);
   gt_orphanage_reset(parser->orphanage);
   parser->last_terminator = 0;
+  if (parser->parallel)
+    gff3_parser_reset_blocks(parser);
 }
 
 void gt_gff3_parser_delete(GtGFF3Parser *parser)
 {
   if (!parser) return;
+  if (parser->parallel) {
+    gff3_parser_reset_blocks(parser);
+    gt_thread_pool_group_delete(parser->prepare_group);
+    gff3_block_delete(parser->current_block);
+    gff3_block_delete(parser->next_block);
+    gt_str_delete(parser->source_buffer);
+  }
   gt_feature_info_delete(parser->feature_info);
   gt_hashmap_delete(parser->seqid_to_ssr_mapping);
   gt_hashmap_delete(parser->source_to_str_mapping);
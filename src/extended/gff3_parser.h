@@ -21,6 +21,12 @@
 #include "extended/gff3_parser_api.h"
 
 void gt_gff3_parser_enable_strict_mode(GtGFF3Parser*);
+/* Enable the parallel mode in the given parser. That is, the input is read in
+   large blocks of lines whose feature lines are tokenized and converted to
+   feature nodes by the threads of the process-wide thread pool. Linking parents
+   and children and all other checks which depend on previous lines are done in
+   input order, hence the result equals the one of the serial mode. */
+void gt_gff3_parser_enable_parallel_mode(GtGFF3Parser*);
 int  gt_gff3_parser_set_offsetfile(GtGFF3Parser*, GtStr*, GtError*);
 int  gt_gff3_parser_parse_target_attributes(const char *values,
                                             GtUword *num_of_targets,
@@ -0,0 +1,1110 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include <math.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/cstr_api.h"
+#include "core/ensure.h"
+#include "core/file_api.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/parseutils_api.h"
+#include "core/str.h"
+#include "core/unused_api.h"
+#include "extended/hmmer_model.h"
+
+/* The canonical amino acids in the order of the HMMER3 format, followed by
+   the degenerate residues. All other characters (like '*' for stop codons)
+   are nonresidues, which cannot be aligned. */
+static const char hmmer_residues[] = "ACDEFGHIKLMNPQRSTVWYBJZOUX";
+#define HMMER_NUMAMINO      20UL
+#define HMMER_NONRESIDUE    26UL
+#define HMMER_NUMCODES      27UL
+
+/* the residues represented by the degenerate ones */
+static const char *hmmer_degenerate[] = {"DN", "IL", "EQ", "K", "C",
+                                         "ACDEFGHIKLMNPQRSTVWY"};
+
+/* the background frequencies of HMMER3 (null model), in residue order */
+static const double hmmer_background[HMMER_NUMAMINO] = {
+  0.0787945, 0.0151600, 0.0535222, 0.0668298, 0.0397062, 0.0695071, 0.0229198,
+  0.0590092, 0.0594422, 0.0963728, 0.0237718, 0.0414386, 0.0482904, 0.0395639,
+  0.0540978, 0.0683364, 0.0540687, 0.0673417, 0.0114135, 0.0304133
+};
+
+/* the transitions of a node, in the order of the HMMER3 format */
+typedef enum {
+  HMMER_TMM,
+  HMMER_TMI,
+  HMMER_TMD,
+  HMMER_TIM,
+  HMMER_TII,
+  HMMER_TDM,
+  HMMER_TDD,
+  HMMER_NUMTRANS
+} HMMERTransition;
+
+/* the states of the core model in a traceback */
+typedef enum {
+  HMMER_STATE_B,
+  HMMER_STATE_M,
+  HMMER_STATE_I,
+  HMMER_STATE_D
+} HMMERState;
+
+/* Sequences whose MSV score has a larger P-value are not aligned, like in the
+   default pipeline of hmmscan. */
+#define HMMER_MSV_PVALUE    0.02
+
+/* The maximal number of lanes of the vectorized MSV kernels, to which the
+   rows are padded and aligned. */
+#define HMMER_MSV_MAXLANES  8UL
+#define HMMER_MSV_LANEBYTES (HMMER_MSV_MAXLANES * sizeof (float))
+
+#define HMMER_NEGINF        ((float) -HUGE_VAL)
+#define HMMER_LN2           0.69314718055994530942
+#define HMMER_LOG_HALF      ((float) -HMMER_LN2)
+
+/* The AVX2 kernel is only available for x86-64 compilers which support target
+   specific functions. */
+#if defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define HMMER_MSV_AVX2
+#endif
+
+/* The transition scores of the special states, which depend on the length of
+   the sequence (multiple domains per sequence, as in hmmscan). */
+typedef struct {
+  float loop,  /* N->N, J->J, C->C */
+        move;  /* N->B, J->B, C->T */
+  double null; /* score of the sequence in the null model */
+} HMMERLengthModel;
+
+struct GtHMMERModel {
+  char *name,
+       *consensus;   /* consensus residue of every match state */
+  GtUword length,
+          msvcolumns;
+  double ga[2],
+         tc[2],
+         msv_mu,
+         msv_lambda,
+         viterbi_mu,
+         viterbi_lambda;
+  bool has_ga,
+       has_tc;
+  float *msc,        /* match scores, HMMER_NUMCODES per state */
+        *tsc,        /* transition scores, HMMER_NUMTRANS per node */
+        *bsc,        /* local entry scores */
+        msv_entry,   /* uniform local entry score of the MSV filter */
+        *msvprofilealloc,
+        *msvprofile; /* match scores, <msvcolumns> per residue */
+  float (*msv)(const GtHMMERModel*, const GtUchar*, GtUword,
+               const HMMERLengthModel*, float*);
+};
+
+/* generic kernel, vectorized for the baseline instruction set */
+#define HMMER_MSV_TARGET
+#define HMMER_MSV_FUNC(F)  F##_generic
+#define HMMER_MSV_LANES    4
+#include "extended/hmmer_model_msv.gen"
+#undef HMMER_MSV_TARGET
+#undef HMMER_MSV_FUNC
+#undef HMMER_MSV_LANES
+
+#ifdef HMMER_MSV_AVX2
+#define HMMER_MSV_TARGET   __attribute__((target("avx2")))
+#define HMMER_MSV_FUNC(F)  F##_avx2
+#define HMMER_MSV_LANES    8
+#include "extended/hmmer_model_msv.gen"
+#undef HMMER_MSV_TARGET
+#undef HMMER_MSV_FUNC
+#undef HMMER_MSV_LANES
+#endif
+
+static GtUchar hmmer_digitize(char c)
+{
+  const char *p;
+  if (c == '\0')
+    return (GtUchar) HMMER_NONRESIDUE;
+  p = strchr(hmmer_residues, toupper((unsigned char) c));
+  return p != NULL ? (GtUchar) (p - hmmer_residues)
+                   : (GtUchar) HMMER_NONRESIDUE;
+}
+
+static double hmmer_gumbel_surv(double x, double mu, double lambda)
+{
+  return -expm1(-exp(-lambda * (x - mu)));
+}
+
+static void hmmer_length_model(HMMERLengthModel *lm, GtUword seqlen)
+{
+  double len = (double) seqlen;
+  lm->loop = (float) log(len / (len + 3.0));
+  lm->move = (float) log(3.0 / (len + 3.0));
+  lm->null = len * log(len / (len + 1.0)) + log(1.0 / (len + 1.0));
+}
+
+static double hmmer_bits(float score, const HMMERLengthModel *lm)
+{
+  return ((double) score - lm->null) / HMMER_LN2;
+}
+
+static GtHMMERModel* hmmer_model_new(void)
+{
+  GtHMMERModel *model = gt_calloc((size_t) 1, sizeof *model);
+  model->msv_lambda = model->viterbi_lambda = -1.0;
+  return model;
+}
+
+/* Computes the scores of <model> from the match emission probabilities <mat>
+   (HMMER_NUMAMINO per node) and the transition probabilities <trans>
+   (HMMER_NUMTRANS per node, including the begin node 0). The AVX2 MSV kernel
+   is used if <use_avx2> is true and the CPU supports it. */
+static void hmmer_model_configure(GtHMMERModel *model, const double *mat,
+                                  const double *trans, GT_UNUSED bool use_avx2)
+{
+  const GtUword m = model->length;
+  double *occ, occsum = 0.0;
+  GtUword k, a, c;
+
+  /* local entries are weighted by the occupancy of the match states */
+  occ = gt_malloc(sizeof *occ * (m + 1));
+  occ[1] = trans[HMMER_TMI] + trans[HMMER_TMM];
+  for (k = 2; k <= m; k++) {
+    const double *t = trans + (k - 1) * HMMER_NUMTRANS;
+    occ[k] = occ[k-1] * (t[HMMER_TMM] + t[HMMER_TMI])
+             + (1.0 - occ[k-1]) * t[HMMER_TDM];
+  }
+  for (k = 1; k <= m; k++)
+    occsum += occ[k] * (double) (m - k + 1);
+  model->bsc = gt_malloc(sizeof *model->bsc * (m + 1));
+  model->bsc[0] = HMMER_NEGINF;
+  for (k = 1; k <= m; k++)
+    model->bsc[k] = (float) log(occ[k] / occsum);
+  gt_free(occ);
+
+  model->tsc = gt_malloc(sizeof *model->tsc * (m + 1) * HMMER_NUMTRANS);
+  for (k = 0; k < (m + 1) * HMMER_NUMTRANS; k++)
+    model->tsc[k] = (float) log(trans[k]);
+
+  model->msc = gt_malloc(sizeof *model->msc * (m + 1) * HMMER_NUMCODES);
+  model->consensus = gt_malloc(sizeof *model->consensus * (m + 2));
+  for (c = 0; c < HMMER_NUMCODES; c++)
+    model->msc[c] = HMMER_NEGINF;
+  model->consensus[0] = model->consensus[m+1] = '\0';
+  for (k = 1; k <= m; k++) {
+    const double *p = mat + k * HMMER_NUMAMINO;
+    float *sc = model->msc + k * HMMER_NUMCODES;
+    GtUword best = 0;
+    for (a = 0; a < HMMER_NUMAMINO; a++) {
+      sc[a] = (float) log(p[a] / hmmer_background[a]);
+      if (p[a] > p[best])
+        best = a;
+    }
+    /* degenerate residues score the expectation of their residues */
+    for (c = HMMER_NUMAMINO; c < HMMER_NONRESIDUE; c++) {
+      const char *r;
+      double sum = 0.0, weight = 0.0;
+      for (r = hmmer_degenerate[c - HMMER_NUMAMINO]; *r != '\0'; r++) {
+        a = (GtUword) hmmer_digitize(*r);
+        sum += hmmer_background[a] * sc[a];
+        weight += hmmer_background[a];
+      }
+      sc[c] = (float) (sum / weight);
+    }
+    sc[HMMER_NONRESIDUE] = HMMER_NEGINF;
+    model->consensus[k] = p[best] >= 0.5
+                          ? hmmer_residues[best]
+                          : (char) tolower((unsigned char) hmmer_residues[best]);
+  }
+
+  /* the MSV filter enters every match state with the same probability */
+  model->msv_entry = (float) log(2.0 / ((double) m * (double) (m + 1)));
+  model->msvcolumns = (m + HMMER_MSV_MAXLANES - 1) / HMMER_MSV_MAXLANES
+                      * HMMER_MSV_MAXLANES;
+  model->msvprofilealloc = gt_malloc(sizeof *model->msvprofilealloc
+                                     * (HMMER_NUMCODES * model->msvcolumns
+                                        + HMMER_MSV_MAXLANES));
+  model->msvprofile = (float*) (((size_t) model->msvprofilealloc +
+                                 HMMER_MSV_LANEBYTES - 1) &
+                                ~(HMMER_MSV_LANEBYTES - 1));
+  for (c = 0; c < HMMER_NUMCODES; c++) {
+    for (k = 0; k < model->msvcolumns; k++) {
+      model->msvprofile[c * model->msvcolumns + k]
+        = k < m ? model->msc[(k + 1) * HMMER_NUMCODES + c] : HMMER_NEGINF;
+    }
+  }
+  model->msv = hmmer_msv_generic;
+#ifdef HMMER_MSV_AVX2
+  __builtin_cpu_init();
+  if (use_avx2 && __builtin_cpu_supports("avx2"))
+    model->msv = hmmer_msv_avx2;
+#endif
+}
+
+/* reading HMMER3 files */
+
+#define HMMER_MAXTOKENS 32
+
+typedef struct {
+  GtFile *file;
+  const char *filename;
+  GtStr *line;
+  GtUword line_number,
+          numoftokens;
+  char *tokens[HMMER_MAXTOKENS];
+} HMMERParser;
+
+/* Reads the next line and splits it into whitespace separated tokens. Returns
+   EOF at the end of the file. */
+static int hmmer_parser_next_line(HMMERParser *p)
+{
+  char *s;
+  gt_str_reset(p->line);
+  if (gt_str_read_next_line_generic(p->line, p->file) == EOF)
+    return EOF;
+  p->line_number++;
+  p->numoftokens = 0;
+  s = gt_str_get(p->line);
+  while (*s != '\0' && p->numoftokens < (GtUword) HMMER_MAXTOKENS) {
+    while (isspace((unsigned char) *s))
+      s++;
+    if (*s == '\0')
+      break;
+    p->tokens[p->numoftokens++] = s;
+    while (*s != '\0' && !isspace((unsigned char) *s))
+      s++;
+    if (*s != '\0')
+      *s++ = '\0';
+  }
+  return 0;
+}
+
+static int hmmer_parser_expect_line(HMMERParser *p, GtError *err)
+{
+  if (hmmer_parser_next_line(p) == EOF) {
+    gt_error_set(err, "file \"%s\": unexpected end of file after line "GT_WU,
+                 p->filename, p->line_number);
+    return -1;
+  }
+  return 0;
+}
+
+/* Parses <num> negative natural logarithms of probabilities, beginning with
+   token <first>, into <probs>. */
+static int hmmer_parser_probs(HMMERParser *p, GtUword first, GtUword num,
+                              double *probs, GtError *err)
+{
+  GtUword i;
+  if (p->numoftokens < first + num) {
+    gt_error_set(err, "file \"%s\": line "GT_WU": expected "GT_WU" values",
+                 p->filename, p->line_number, num);
+    return -1;
+  }
+  for (i = 0; i < num; i++) {
+    const char *token = p->tokens[first + i];
+    double value;
+    if (strcmp(token, "*") == 0)
+      probs[i] = 0.0;
+    else if (gt_parse_double(&value, token) == 0 && value >= 0.0)
+      probs[i] = exp(-value);
+    else {
+      gt_error_set(err, "file \"%s\": line "GT_WU": invalid value \"%s\"",
+                   p->filename, p->line_number, token);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Parses the two bit score thresholds of a GA or TC line. */
+static int hmmer_parser_thresholds(HMMERParser *p, double *thresholds,
+                                   GtError *err)
+{
+  GtUword i;
+  if (p->numoftokens < 3UL) {
+    gt_error_set(err, "file \"%s\": line "GT_WU": expected two thresholds",
+                 p->filename, p->line_number);
+    return -1;
+  }
+  for (i = 0; i < 2UL; i++) {
+    (void) gt_cstr_rtrim(p->tokens[i + 1], ';');
+    if (gt_parse_double(thresholds + i, p->tokens[i + 1]) != 0) {
+      gt_error_set(err, "file \"%s\": line "GT_WU": invalid threshold \"%s\"",
+                   p->filename, p->line_number, p->tokens[i + 1]);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+static int hmmer_parser_header(HMMERParser *p, GtHMMERModel *model,
+                               GtError *err)
+{
+  int had_err = 0;
+  bool amino = false;
+
+  if (strncmp(p->tokens[0], "HMMER3/", (size_t) 7) != 0) {
+    if (strncmp(p->tokens[0], "HMMER2", (size_t) 6) == 0) {
+      gt_error_set(err, "file \"%s\": line "GT_WU": HMMER2 models are not "
+                   "supported, convert them with `hmmconvert'", p->filename,
+                   p->line_number);
+    } else {
+      gt_error_set(err, "file \"%s\": line "GT_WU": expected HMMER3 header "
+                   "line", p->filename, p->line_number);
+    }
+    return -1;
+  }
+  while (!had_err && !(had_err = hmmer_parser_expect_line(p, err))) {
+    const char *tag;
+    if (p->numoftokens == 0)
+      continue;
+    tag = p->tokens[0];
+    if (strcmp(tag, "HMM") == 0)
+      break;
+    if (strcmp(tag, "NAME") == 0 && p->numoftokens > 1) {
+      gt_free(model->name);
+      model->name = gt_cstr_dup(p->tokens[1]);
+    } else if (strcmp(tag, "LENG") == 0) {
+      if (p->numoftokens < 2UL ||
+          gt_parse_ulong(&model->length, p->tokens[1]) != 0 ||
+          model->length == 0) {
+        gt_error_set(err, "file \"%s\": line "GT_WU": invalid model length",
+                     p->filename, p->line_number);
+        had_err = -1;
+      }
+    } else if (strcmp(tag, "ALPH") == 0) {
+      amino = p->numoftokens > 1 && strcmp(p->tokens[1], "amino") == 0;
+    } else if (strcmp(tag, "GA") == 0) {
+      had_err = hmmer_parser_thresholds(p, model->ga, err);
+      model->has_ga = true;
+    } else if (strcmp(tag, "TC") == 0) {
+      had_err = hmmer_parser_thresholds(p, model->tc, err);
+      model->has_tc = true;
+    } else if (strcmp(tag, "STATS") == 0 && p->numoftokens >= 5UL &&
+               strcmp(p->tokens[1], "LOCAL") == 0 &&
+               (strcmp(p->tokens[2], "MSV") == 0 ||
+                strcmp(p->tokens[2], "VITERBI") == 0)) {
+      double mu, lambda;
+      if (gt_parse_double(&mu, p->tokens[3]) != 0 ||
+          gt_parse_double(&lambda, p->tokens[4]) != 0 || lambda <= 0.0) {
+        gt_error_set(err, "file \"%s\": line "GT_WU": invalid statistics",
+                     p->filename, p->line_number);
+        had_err = -1;
+      } else if (strcmp(p->tokens[2], "MSV") == 0) {
+        model->msv_mu = mu;
+        model->msv_lambda = lambda;
+      } else {
+        model->viterbi_mu = mu;
+        model->viterbi_lambda = lambda;
+      }
+    }
+  }
+  if (!had_err && (model->name == NULL || model->length == 0)) {
+    gt_error_set(err, "file \"%s\": line "GT_WU": model without NAME or LENG",
+                 p->filename, p->line_number);
+    had_err = -1;
+  }
+  if (!had_err && !amino) {
+    gt_error_set(err, "file \"%s\": model \"%s\" is not a protein model",
+                 p->filename, model->name);
+    had_err = -1;
+  }
+  if (!had_err && (model->msv_lambda <= 0.0 || model->viterbi_lambda <= 0.0)) {
+    gt_error_set(err, "file \"%s\": model \"%s\" has no STATS LOCAL MSV and "
+                 "VITERBI lines", p->filename, model->name);
+    had_err = -1;
+  }
+  return had_err;
+}
+
+/* Parses a model, beginning with the header line which has already been
+   read. */
+static GtHMMERModel* hmmer_parser_model(HMMERParser *p, GtError *err)
+{
+  GtHMMERModel *model = hmmer_model_new();
+  double *mat = NULL, *trans = NULL, ins[HMMER_NUMAMINO];
+  GtUword k;
+  int had_err;
+
+  had_err = hmmer_parser_header(p, model, err);
+  if (!had_err) {
+    mat = gt_calloc((size_t) (model->length + 1) * HMMER_NUMAMINO,
+                    sizeof *mat);
+    trans = gt_calloc((size_t) (model->length + 1) * HMMER_NUMTRANS,
+                      sizeof *trans);
+    /* skip the line with the names of the transitions */
+    had_err = hmmer_parser_expect_line(p, err);
+  }
+  if (!had_err)
+    had_err = hmmer_parser_expect_line(p, err);
+  if (!had_err && p->numoftokens > 0 && strcmp(p->tokens[0], "COMPO") == 0)
+    had_err = hmmer_parser_expect_line(p, err);
+  /* the insert emissions are scored like the background, only the number of
+     values is checked */
+  if (!had_err)
+    had_err = hmmer_parser_probs(p, 0, HMMER_NUMAMINO, ins, err);
+  if (!had_err)
+    had_err = hmmer_parser_expect_line(p, err);
+  if (!had_err)
+    had_err = hmmer_parser_probs(p, 0, HMMER_NUMTRANS, trans, err);
+  for (k = 1; !had_err && k <= model->length; k++) {
+    GtUword node;
+    had_err = hmmer_parser_expect_line(p, err);
+    if (!had_err && (p->numoftokens == 0 ||
+                     gt_parse_ulong(&node, p->tokens[0]) != 0 || node != k)) {
+      gt_error_set(err, "file \"%s\": line "GT_WU": expected node "GT_WU,
+                   p->filename, p->line_number, k);
+      had_err = -1;
+    }
+    if (!had_err)
+      had_err = hmmer_parser_probs(p, 1, HMMER_NUMAMINO,
+                                   mat + k * HMMER_NUMAMINO, err);
+    if (!had_err)
+      had_err = hmmer_parser_expect_line(p, err);
+    if (!had_err)
+      had_err = hmmer_parser_probs(p, 0, HMMER_NUMAMINO, ins, err);
+    if (!had_err)
+      had_err = hmmer_parser_expect_line(p, err);
+    if (!had_err)
+      had_err = hmmer_parser_probs(p, 0, HMMER_NUMTRANS,
+                                   trans + k * HMMER_NUMTRANS, err);
+  }
+  if (!had_err)
+    had_err = hmmer_parser_expect_line(p, err);
+  if (!had_err && (p->numoftokens == 0 || strcmp(p->tokens[0], "//") != 0)) {
+    gt_error_set(err, "file \"%s\": line "GT_WU": expected \"//\" at the end "
+                 "of model \"%s\"", p->filename, p->line_number, model->name);
+    had_err = -1;
+  }
+  if (!had_err)
+    hmmer_model_configure(model, mat, trans, true);
+  gt_free(mat);
+  gt_free(trans);
+  if (had_err) {
+    gt_hmmer_model_delete(model);
+    return NULL;
+  }
+  return model;
+}
+
+int gt_hmmer_model_read(GtArray *models, const char *filename, GtError *err)
+{
+  HMMERParser p;
+  GtUword numofmodels = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(models && filename);
+
+  p.file = gt_file_new(filename, "r", err);
+  if (p.file == NULL)
+    return -1;
+  p.filename = filename;
+  p.line = gt_str_new();
+  p.line_number = 0;
+  while (!had_err && hmmer_parser_next_line(&p) != EOF) {
+    GtHMMERModel *model;
+    if (p.numoftokens == 0)
+      continue;
+    if ((model = hmmer_parser_model(&p, err)) == NULL)
+      had_err = -1;
+    else {
+      gt_array_add(models, model);
+      numofmodels++;
+    }
+  }
+  if (!had_err && numofmodels == 0) {
+    gt_error_set(err, "file \"%s\": no HMMER3 models found", filename);
+    had_err = -1;
+  }
+  gt_str_delete(p.line);
+  gt_file_delete(p.file);
+  return had_err;
+}
+
+const char* gt_hmmer_model_get_name(const GtHMMERModel *model)
+{
+  gt_assert(model);
+  return model->name;
+}
+
+GtUword gt_hmmer_model_length(const GtHMMERModel *model)
+{
+  gt_assert(model);
+  return model->length;
+}
+
+bool gt_hmmer_model_get_ga(const GtHMMERModel *model, double *thresholds)
+{
+  gt_assert(model && thresholds);
+  if (model->has_ga) {
+    thresholds[0] = model->ga[0];
+    thresholds[1] = model->ga[1];
+  }
+  return model->has_ga;
+}
+
+bool gt_hmmer_model_get_tc(const GtHMMERModel *model, double *thresholds)
+{
+  gt_assert(model && thresholds);
+  if (model->has_tc) {
+    thresholds[0] = model->tc[0];
+    thresholds[1] = model->tc[1];
+  }
+  return model->has_tc;
+}
+
+double gt_hmmer_model_score_for_pvalue(const GtHMMERModel *model,
+                                       double pvalue)
+{
+  gt_assert(model);
+  if (pvalue >= 1.0)
+    return -HUGE_VAL;
+  if (pvalue <= 0.0)
+    return HUGE_VAL;
+  return model->viterbi_mu - log(-log1p(-pvalue)) / model->viterbi_lambda;
+}
+
+/* searching */
+
+/* the buffers of the Viterbi algorithm */
+typedef struct {
+  float *rows;    /* the match, insert and delete states of two rows */
+  GtUchar *tb,    /* traceback of the core states of every cell */
+          *xtb;   /* traceback of the special states of every row */
+  GtUword *ek;    /* match state entering E in every row */
+} HMMERViterbiSpace;
+
+/* bits of the traceback of a cell */
+#define HMMER_TB_MSTATE  3U  /* predecessor of M */
+#define HMMER_TB_IFROMI  4U
+#define HMMER_TB_DFROMD  8U
+/* bits of the traceback of a row */
+#define HMMER_TB_JFROME  1U
+#define HMMER_TB_CFROME  2U
+#define HMMER_TB_BFROMJ  4U
+
+/* Returns the Viterbi score (in nats) of <dsq>, storing the traceback in
+   <vs>. */
+static float hmmer_viterbi(const GtHMMERModel *model, const GtUchar *dsq,
+                           GtUword seqlen, const HMMERLengthModel *lm,
+                           HMMERViterbiSpace *vs)
+{
+  const GtUword m = model->length;
+  float *prevm = vs->rows, *previ = prevm + m + 1, *prevd = previ + m + 1,
+        *curm = prevd + m + 1, *curi = curm + m + 1, *curd = curi + m + 1,
+        xN = 0, xB = lm->move, xJ = HMMER_NEGINF, xC = HMMER_NEGINF;
+  GtUword i, k;
+
+  for (k = 0; k <= m; k++)
+    prevm[k] = previ[k] = prevd[k] = HMMER_NEGINF;
+  curm[0] = curi[0] = curd[0] = HMMER_NEGINF;
+  curi[m] = HMMER_NEGINF;
+  vs->xtb[0] = 0;
+  for (i = 1; i <= seqlen; i++) {
+    const GtUchar x = dsq[i-1];
+    const float isc = x == (GtUchar) HMMER_NONRESIDUE ? HMMER_NEGINF : 0;
+    GtUchar *tb = vs->tb + i * (m + 1), xtb = 0;
+    float xE = HMMER_NEGINF, a, b, *tmp;
+    GtUword ek = 0;
+
+    for (k = 1; k <= m; k++) {
+      /* transitions into node k */
+      const float *t = model->tsc + (k - 1) * HMMER_NUMTRANS;
+      float best = xB + model->bsc[k], v;
+      GtUchar ptr = (GtUchar) HMMER_STATE_B;
+      if ((v = prevm[k-1] + t[HMMER_TMM]) > best) {
+        best = v;
+        ptr = (GtUchar) HMMER_STATE_M;
+      }
+      if ((v = previ[k-1] + t[HMMER_TIM]) > best) {
+        best = v;
+        ptr = (GtUchar) HMMER_STATE_I;
+      }
+      if ((v = prevd[k-1] + t[HMMER_TDM]) > best) {
+        best = v;
+        ptr = (GtUchar) HMMER_STATE_D;
+      }
+      curm[k] = best + model->msc[k * HMMER_NUMCODES + x];
+      if (k < m) {
+        const float *tk = model->tsc + k * HMMER_NUMTRANS;
+        a = prevm[k] + tk[HMMER_TMI];
+        if ((b = previ[k] + tk[HMMER_TII]) > a) {
+          a = b;
+          ptr |= HMMER_TB_IFROMI;
+        }
+        curi[k] = a + isc;
+      }
+      a = curm[k-1] + t[HMMER_TMD];
+      if ((b = curd[k-1] + t[HMMER_TDD]) > a) {
+        a = b;
+        ptr |= HMMER_TB_DFROMD;
+      }
+      curd[k] = a;
+      tb[k] = ptr;
+      /* local alignments end in any match state */
+      if (curm[k] > xE) {
+        xE = curm[k];
+        ek = k;
+      }
+    }
+    vs->ek[i] = ek;
+    a = xJ + lm->loop;
+    if ((b = xE + HMMER_LOG_HALF) > a) {
+      a = b;
+      xtb |= HMMER_TB_JFROME;
+    }
+    xJ = a;
+    a = xC + lm->loop;
+    if ((b = xE + HMMER_LOG_HALF) > a) {
+      a = b;
+      xtb |= HMMER_TB_CFROME;
+    }
+    xC = a;
+    xN += lm->loop;
+    a = xN + lm->move;
+    if ((b = xJ + lm->move) > a) {
+      a = b;
+      xtb |= HMMER_TB_BFROMJ;
+    }
+    xB = a;
+    vs->xtb[i] = xtb;
+    tmp = prevm; prevm = curm; curm = tmp;
+    tmp = previ; previ = curi; curi = tmp;
+    tmp = prevd; prevd = curd; curd = tmp;
+  }
+  return xC + lm->move;
+}
+
+typedef struct {
+  HMMERState state;
+  GtUword i, k;
+} HMMERColumn;
+
+/* Returns the score (in nats) of the core model path given by the <num>
+   <columns>. */
+static float hmmer_path_score(const GtHMMERModel *model, const GtUchar *dsq,
+                              const HMMERColumn *columns, GtUword num)
+{
+  float score = model->bsc[columns[0].k];
+  GtUword c;
+  for (c = 0; c < num; c++) {
+    const HMMERColumn *col = columns + c;
+    const GtUchar x = dsq[col->i - 1];
+    if (c > 0) {
+      const HMMERColumn *prev = col - 1;
+      const float *t = model->tsc + prev->k * HMMER_NUMTRANS;
+      switch (prev->state) {
+        case HMMER_STATE_M:
+          score += t[col->state == HMMER_STATE_M ? HMMER_TMM
+                     : (col->state == HMMER_STATE_I ? HMMER_TMI
+                                                     : HMMER_TMD)];
+          break;
+        case HMMER_STATE_I:
+          score += t[col->state == HMMER_STATE_M ? HMMER_TIM : HMMER_TII];
+          break;
+        default:
+          score += t[col->state == HMMER_STATE_M ? HMMER_TDM : HMMER_TDD];
+          break;
+      }
+    }
+    if (col->state == HMMER_STATE_M)
+      score += model->msc[col->k * HMMER_NUMCODES + x];
+    else if (col->state == HMMER_STATE_I && x == (GtUchar) HMMER_NONRESIDUE)
+      score = HMMER_NEGINF;
+  }
+  return score;
+}
+
+static void hmmer_domain_alignment(const GtHMMERModel *model, const char *seq,
+                                   const GtUchar *dsq,
+                                   const HMMERColumn *columns, GtUword num,
+                                   GtHMMERDomain *domain)
+{
+  GtUword c;
+  domain->model_ali = gt_str_new();
+  domain->match_ali = gt_str_new();
+  domain->seq_ali = gt_str_new();
+  for (c = 0; c < num; c++) {
+    const HMMERColumn *col = columns + c;
+    char cons = model->consensus[col->k];
+    switch (col->state) {
+      case HMMER_STATE_M:
+        {
+          char r = (char) toupper((unsigned char) seq[col->i - 1]);
+          gt_str_append_char(domain->model_ali, cons);
+          if (toupper((unsigned char) cons) == r)
+            gt_str_append_char(domain->match_ali, cons);
+          else if (model->msc[col->k * HMMER_NUMCODES + dsq[col->i - 1]] > 0)
+            gt_str_append_char(domain->match_ali, '+');
+          else
+            gt_str_append_char(domain->match_ali, ' ');
+          gt_str_append_char(domain->seq_ali, r);
+        }
+        break;
+      case HMMER_STATE_I:
+        gt_str_append_char(domain->model_ali, '.');
+        gt_str_append_char(domain->match_ali, ' ');
+        gt_str_append_char(domain->seq_ali,
+                           (char) tolower((unsigned char) seq[col->i - 1]));
+        break;
+      default:
+        gt_str_append_char(domain->model_ali, cons);
+        gt_str_append_char(domain->match_ali, ' ');
+        gt_str_append_char(domain->seq_ali, '-');
+        break;
+    }
+  }
+}
+
+/* Follows the traceback in <vs> from the end of <dsq> and appends the domains
+   with a score of at least <min_domscore> to <domains>, in the order of the
+   sequence. Returns the score (in nats) of the path. */
+static float hmmer_traceback(const GtHMMERModel *model, const char *seq,
+                             const GtUchar *dsq, GtUword seqlen,
+                             const HMMERLengthModel *lm,
+                             const HMMERViterbiSpace *vs, double min_domscore,
+                             GtArray *domains)
+{
+  const GtUword m = model->length;
+  GtArray *columns = gt_array_new(sizeof (HMMERColumn)),
+          *found = gt_array_new(sizeof (GtHMMERDomain));
+  GtUword i = seqlen;
+  float score = lm->move;  /* C->T */
+  bool in_c = true, complete = false;
+
+  while (!complete && i > 0) {
+    GtUchar xtb = vs->xtb[i];
+    if ((xtb & (in_c ? HMMER_TB_CFROME : HMMER_TB_JFROME)) == 0) {
+      /* residue i is emitted by the C or J state */
+      score += lm->loop;
+      i--;
+    } else {
+      /* a domain ends in row i, follow it back to its B state */
+      HMMERColumn col, *cols;
+      GtHMMERDomain domain;
+      GtUword num;
+      float core, nats;
+      gt_array_reset(columns);
+      col.state = HMMER_STATE_M;
+      col.i = i;
+      col.k = vs->ek[i];
+      while (col.state != HMMER_STATE_B) {
+        GtUchar tb = vs->tb[col.i * (m + 1) + col.k];
+        gt_array_add(columns, col);
+        switch (col.state) {
+          case HMMER_STATE_M:
+            col.state = (HMMERState) (tb & HMMER_TB_MSTATE);
+            col.i--;
+            col.k--;
+            break;
+          case HMMER_STATE_I:
+            col.state = (tb & HMMER_TB_IFROMI) ? HMMER_STATE_I
+                                               : HMMER_STATE_M;
+            col.i--;
+            break;
+          default:
+            col.state = (tb & HMMER_TB_DFROMD) ? HMMER_STATE_D
+                                               : HMMER_STATE_M;
+            col.k--;
+            break;
+        }
+      }
+      gt_array_reverse(columns);
+      cols = gt_array_get_space(columns);
+      num = gt_array_size(columns);
+      core = hmmer_path_score(model, dsq, cols, num);
+      score += HMMER_LOG_HALF + core + lm->move;
+      /* the domain is scored like the only one of the sequence */
+      nats = (float) (col.i) * lm->loop + lm->move + core + HMMER_LOG_HALF
+             + (float) (seqlen - i) * lm->loop + lm->move;
+      domain.score = hmmer_bits(nats, lm);
+      if (domain.score >= min_domscore) {
+        domain.seqfrom = col.i + 1;
+        domain.seqto = i;
+        domain.hmmfrom = cols[0].k;
+        domain.hmmto = cols[num-1].k;
+        domain.pvalue = hmmer_gumbel_surv(domain.score, model->viterbi_mu,
+                                          model->viterbi_lambda);
+        hmmer_domain_alignment(model, seq, dsq, cols, num, &domain);
+        gt_array_add(found, domain);
+      }
+      /* the B state was reached from N or J */
+      i = col.i;
+      in_c = false;
+      if ((vs->xtb[i] & HMMER_TB_BFROMJ) == 0) {
+        score += (float) i * lm->loop;
+        complete = true;
+      }
+    }
+  }
+  if (!complete)
+    score = HMMER_NEGINF;
+  if (gt_array_size(found) > 1UL)
+    gt_array_reverse(found);
+  gt_array_add_array(domains, found);
+  gt_array_delete(found);
+  gt_array_delete(columns);
+  return score;
+}
+
+static HMMERViterbiSpace* hmmer_viterbi_space_new(GtUword m, GtUword seqlen)
+{
+  HMMERViterbiSpace *vs = gt_malloc(sizeof *vs);
+  vs->rows = gt_malloc(sizeof *vs->rows * 6 * (m + 1));
+  vs->tb = gt_malloc(sizeof *vs->tb * (seqlen + 1) * (m + 1));
+  vs->xtb = gt_malloc(sizeof *vs->xtb * (seqlen + 1));
+  vs->ek = gt_malloc(sizeof *vs->ek * (seqlen + 1));
+  return vs;
+}
+
+static void hmmer_viterbi_space_delete(HMMERViterbiSpace *vs)
+{
+  if (!vs) return;
+  gt_free(vs->rows);
+  gt_free(vs->tb);
+  gt_free(vs->xtb);
+  gt_free(vs->ek);
+  gt_free(vs);
+}
+
+static float* hmmer_msv_space(const GtHMMERModel *model, float **spacealloc)
+{
+  *spacealloc = gt_malloc(sizeof **spacealloc
+                          * (2 * (model->msvcolumns + HMMER_MSV_MAXLANES)
+                             + HMMER_MSV_MAXLANES));
+  return (float*) (((size_t) *spacealloc + HMMER_MSV_LANEBYTES - 1) &
+                   ~(HMMER_MSV_LANEBYTES - 1));
+}
+
+void gt_hmmer_model_search(const GtHMMERModel *model, const char *seq,
+                           GtUword seqlen, double min_seqscore,
+                           double min_domscore, GtArray *domains)
+{
+  HMMERLengthModel lm;
+  GtUchar *dsq;
+  float *spacealloc, *space, msv;
+  GtUword i;
+  gt_assert(model && seq && domains);
+
+  if (seqlen == 0)
+    return;
+  dsq = gt_malloc(sizeof *dsq * seqlen);
+  for (i = 0; i < seqlen; i++)
+    dsq[i] = hmmer_digitize(seq[i]);
+  hmmer_length_model(&lm, seqlen);
+  space = hmmer_msv_space(model, &spacealloc);
+  msv = model->msv(model, dsq, seqlen, &lm, space);
+  gt_free(spacealloc);
+  if (hmmer_gumbel_surv(hmmer_bits(msv, &lm), model->msv_mu,
+                        model->msv_lambda) <= HMMER_MSV_PVALUE) {
+    HMMERViterbiSpace *vs = hmmer_viterbi_space_new(model->length, seqlen);
+    float score = hmmer_viterbi(model, dsq, seqlen, &lm, vs);
+    if (score > HMMER_NEGINF && hmmer_bits(score, &lm) >= min_seqscore) {
+      (void) hmmer_traceback(model, seq, dsq, seqlen, &lm, vs, min_domscore,
+                             domains);
+    }
+    hmmer_viterbi_space_delete(vs);
+  }
+  gt_free(dsq);
+}
+
+void gt_hmmer_model_delete(GtHMMERModel *model)
+{
+  if (!model) return;
+  gt_free(model->name);
+  gt_free(model->consensus);
+  gt_free(model->msc);
+  gt_free(model->tsc);
+  gt_free(model->bsc);
+  gt_free(model->msvprofilealloc);
+  gt_free(model);
+}
+
+/* scalar reference of the MSV kernels */
+static float hmmer_test_msv(const GtHMMERModel *model, const GtUchar *dsq,
+                            GtUword seqlen, const HMMERLengthModel *lm)
+{
+  const GtUword m = model->length;
+  float *prev = gt_malloc(sizeof *prev * (m + 1)),
+        *cur = gt_malloc(sizeof *cur * (m + 1)),
+        xN = 0, xB = lm->move, xJ = HMMER_NEGINF, xC = HMMER_NEGINF;
+  GtUword i, k;
+
+  for (k = 0; k <= m; k++)
+    prev[k] = HMMER_NEGINF;
+  cur[0] = HMMER_NEGINF;
+  for (i = 0; i < seqlen; i++) {
+    float xE = HMMER_NEGINF, entry = xB + model->msv_entry, *tmp;
+    for (k = 1; k <= m; k++) {
+      cur[k] = MAX(prev[k-1], entry)
+               + model->msc[k * HMMER_NUMCODES + dsq[i]];
+      xE = MAX(xE, cur[k]);
+    }
+    xJ = MAX(xJ + lm->loop, xE + HMMER_LOG_HALF);
+    xC = MAX(xC + lm->loop, xE + HMMER_LOG_HALF);
+    xN += lm->loop;
+    xB = MAX(xN, xJ) + lm->move;
+    tmp = prev;
+    prev = cur;
+    cur = tmp;
+  }
+  gt_free(prev);
+  gt_free(cur);
+  return xC + lm->move;
+}
+
+/* a model of length <m> with random probabilities, whose match states
+   prefer one residue */
+static GtHMMERModel* hmmer_test_model(GtUword m)
+{
+  GtHMMERModel *model = hmmer_model_new();
+  double *mat, *trans;
+  GtUword k, a;
+
+  model->name = gt_cstr_dup("test");
+  model->length = m;
+  model->msv_mu = model->viterbi_mu = -10.0;
+  model->msv_lambda = model->viterbi_lambda = 0.7;
+  mat = gt_calloc((size_t) (m + 1) * HMMER_NUMAMINO, sizeof *mat);
+  trans = gt_calloc((size_t) (m + 1) * HMMER_NUMTRANS, sizeof *trans);
+  for (k = 1; k <= m; k++) {
+    double *p = mat + k * HMMER_NUMAMINO, sum = 0.0;
+    for (a = 0; a < HMMER_NUMAMINO; a++) {
+      p[a] = gt_rand_0_to_1();
+      sum += p[a];
+    }
+    for (a = 0; a < HMMER_NUMAMINO; a++)
+      p[a] = 0.4 * p[a] / sum;
+    p[gt_rand_max(HMMER_NUMAMINO - 1)] += 0.6;
+  }
+  for (k = 0; k <= m; k++) {
+    double *t = trans + k * HMMER_NUMTRANS, mm = 0.7 + 0.29 * gt_rand_0_to_1(),
+           mi = (1.0 - mm) * gt_rand_0_to_1(), ii = 0.6 * gt_rand_0_to_1(),
+           dd = 0.6 * gt_rand_0_to_1();
+    if (k < m) {
+      t[HMMER_TMM] = mm;
+      t[HMMER_TMI] = mi;
+      t[HMMER_TMD] = 1.0 - mm - mi;
+      t[HMMER_TIM] = 1.0 - ii;
+      t[HMMER_TII] = ii;
+      t[HMMER_TDM] = k > 0 ? 1.0 - dd : 1.0;
+      t[HMMER_TDD] = k > 0 ? dd : 0.0;
+    } else {
+      t[HMMER_TMM] = t[HMMER_TIM] = t[HMMER_TDM] = 1.0;
+    }
+  }
+  hmmer_model_configure(model, mat, trans, true);
+  gt_free(mat);
+  gt_free(trans);
+  return model;
+}
+
+int gt_hmmer_model_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtUword r;
+  gt_error_check(err);
+
+  gt_ensure(hmmer_digitize('a') == 0);
+  gt_ensure(hmmer_digitize('Y') == (GtUchar) (HMMER_NUMAMINO - 1));
+  gt_ensure(hmmer_digitize('x') == (GtUchar) (HMMER_NONRESIDUE - 1));
+  gt_ensure(hmmer_digitize('*') == (GtUchar) HMMER_NONRESIDUE);
+
+  for (r = 0; !had_err && r < 30UL; r++) {
+    GtUword m = 1 + gt_rand_max(r < 20UL ? 40UL : 150UL), q;
+    GtHMMERModel *model = hmmer_test_model(m);
+    float *spacealloc, *space = hmmer_msv_space(model, &spacealloc);
+
+    for (q = 0; !had_err && q < 10UL; q++) {
+      GtUword seqlen = 1 + gt_rand_max(120UL), i;
+      char *seq = gt_malloc(sizeof *seq * (seqlen + 1));
+      GtUchar *dsq = gt_malloc(sizeof *dsq * seqlen);
+      HMMERLengthModel lm;
+      HMMERViterbiSpace *vs;
+      float msv, score, pathscore;
+
+      for (i = 0; i < seqlen; i++) {
+        GtUword c = gt_rand_max(30UL);
+        seq[i] = c < HMMER_NUMAMINO ? hmmer_residues[c]
+                 : (c < 29UL ? hmmer_residues[HMMER_NUMAMINO +
+                                              c % (HMMER_NONRESIDUE -
+                                                   HMMER_NUMAMINO)]
+                             : '*');
+        /* plant the consensus in some sequences */
+        if (q % 2 == 1 && i >= 10UL && i < 10UL + m)
+          seq[i] = model->consensus[i - 9];
+        dsq[i] = hmmer_digitize(seq[i]);
+      }
+      seq[seqlen] = '\0';
+      hmmer_length_model(&lm, seqlen);
+
+      /* the kernels compute the same floats as the scalar reference */
+      msv = hmmer_test_msv(model, dsq, seqlen, &lm);
+      gt_ensure(hmmer_msv_generic(model, dsq, seqlen, &lm, space) == msv);
+#ifdef HMMER_MSV_AVX2
+      if (__builtin_cpu_supports("avx2"))
+        gt_ensure(hmmer_msv_avx2(model, dsq, seqlen, &lm, space) == msv);
+#endif
+
+      /* the traceback yields a path with the Viterbi score */
+      vs = hmmer_viterbi_space_new(m, seqlen);
+      score = hmmer_viterbi(model, dsq, seqlen, &lm, vs);
+      if (!had_err && score > HMMER_NEGINF) {
+        GtArray *domains = gt_array_new(sizeof (GtHMMERDomain));
+        pathscore = hmmer_traceback(model, seq, dsq, seqlen, &lm, vs,
+                                    -HUGE_VAL, domains);
+        gt_ensure(fabs(pathscore - score) <= 1e-3 * (1.0 + fabs(score)));
+        /* the domains are ordered, and their alignments consistent */
+        for (i = 0; !had_err && i < gt_array_size(domains); i++) {
+          GtHMMERDomain *d = gt_array_get(domains, i);
+          gt_ensure(d->seqfrom <= d->seqto && d->seqto <= seqlen);
+          gt_ensure(d->hmmfrom <= d->hmmto && d->hmmto <= m);
+          gt_ensure(i == 0 || (d - 1)->seqto < d->seqfrom);
+          gt_ensure(gt_str_length(d->model_ali) == gt_str_length(d->seq_ali));
+          gt_ensure(d->score <= hmmer_bits(score, &lm) + 1e-3);
+        }
+        /* a planted consensus is found */
+        if (!had_err && q % 2 == 1 && m >= 20UL && seqlen >= 10UL + m) {
+          bool found = false;
+          for (i = 0; i < gt_array_size(domains); i++) {
+            GtHMMERDomain *d = gt_array_get(domains, i);
+            if (d->seqfrom <= 10UL + m && d->seqto > 10UL)
+              found = true;
+          }
+          gt_ensure(found);
+        }
+        for (i = 0; i < gt_array_size(domains); i++) {
+          GtHMMERDomain *d = gt_array_get(domains, i);
+          gt_str_delete(d->model_ali);
+          gt_str_delete(d->match_ali);
+          gt_str_delete(d->seq_ali);
+        }
+        gt_array_delete(domains);
+      }
+      hmmer_viterbi_space_delete(vs);
+      gt_free(seq);
+      gt_free(dsq);
+    }
+    gt_free(spacealloc);
+    gt_hmmer_model_delete(model);
+  }
+  return had_err;
+}
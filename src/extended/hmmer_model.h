@@ -0,0 +1,91 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef HMMER_MODEL_H
+#define HMMER_MODEL_H
+
+#include "core/array_api.h"
+#include "core/error_api.h"
+#include "core/str_api.h"
+
+/* The <GtHMMERModel> class represents a protein profile HMM read from a file
+   in the HMMER3 ASCII format (as written by hmmbuild and distributed by Pfam),
+   configured for local alignments with multiple domains per sequence like
+   hmmscan does. Sequences are searched in-process: a vectorized MSV filter
+   (ungapped local segments) discards most sequences, the remaining ones are
+   aligned with the Viterbi algorithm and every domain of the optimal path is
+   reported with its bit score and the P-value derived from the Viterbi score
+   statistics stored in the file. */
+typedef struct GtHMMERModel GtHMMERModel;
+
+/* A domain found by <gt_hmmer_model_search()>, the positions are 1-based. */
+typedef struct {
+  GtUword hmmfrom,
+          hmmto,
+          seqfrom,
+          seqto;
+  double score,  /* in bits */
+         pvalue;
+  GtStr *model_ali, /* consensus residues of the model, '.' for insertions */
+        *match_ali, /* identities and positive scores */
+        *seq_ali;   /* residues of the sequence, '-' for deletions */
+} GtHMMERDomain;
+
+/* Read all models from the HMMER3 file <filename> (possibly compressed) and
+   append them to <models>. Returns 0 on success, -1 on error (<err> is
+   set). */
+int                 gt_hmmer_model_read(GtArray *models, const char *filename,
+                                        GtError *err);
+
+/* Return the name of <model>. */
+const char*         gt_hmmer_model_get_name(const GtHMMERModel *model);
+
+/* Return the number of match states of <model>. */
+GtUword             gt_hmmer_model_length(const GtHMMERModel *model);
+
+/* Store the gathering thresholds (sequence and domain score, in bits) of
+   <model> in <thresholds> and return true, or return false if the file did
+   not define them. */
+bool                gt_hmmer_model_get_ga(const GtHMMERModel *model,
+                                          double *thresholds);
+
+/* Like <gt_hmmer_model_get_ga()> for the trusted cutoffs. */
+bool                gt_hmmer_model_get_tc(const GtHMMERModel *model,
+                                          double *thresholds);
+
+/* Return the minimal bit score of an alignment with <model> whose P-value is
+   at most <pvalue>. */
+double              gt_hmmer_model_score_for_pvalue(const GtHMMERModel *model,
+                                                    double pvalue);
+
+/* Search the amino acid sequence <seq> of length <seqlen> with <model>. If the
+   sequence passes the MSV filter and the score of its optimal Viterbi path is
+   at least <min_seqscore>, the domains of this path with a score of at least
+   <min_domscore> are appended to <domains> (an array of <GtHMMERDomain>s whose
+   alignment strings must be deleted by the caller). May be called for
+   different sequences simultaneously. */
+void                gt_hmmer_model_search(const GtHMMERModel *model,
+                                          const char *seq, GtUword seqlen,
+                                          double min_seqscore,
+                                          double min_domscore,
+                                          GtArray *domains);
+
+/* Delete <model>. */
+void                gt_hmmer_model_delete(GtHMMERModel *model);
+
+int                 gt_hmmer_model_unit_test(GtError *err);
+
+#endif
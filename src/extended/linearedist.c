@@ -15,39 +15,49 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <limits.h>
 #include "core/ma.h"
 #include "core/minmax.h"
+#include "extended/edist_myers.h"
 #include "extended/linearedist.h"
 
-static void fillDPtable(GtUword *dptable,
-                        const char *u, GtUword n,
-                        const char *v, GtUword m)
+/* Transform <u> and <v> into codes for the bit-parallel computation. Every
+   character of <u> gets its own code, all other characters of <v> are mapped
+   to the code following the last one, which matches nothing. Return the number
+   of codes of <u>. */
+static GtUword encode_sequences(GtUchar *ucodes, const char *u, GtUword n,
+                                GtUchar *vcodes, const char *v, GtUword m)
 {
-  GtUword i, j , nw, we;
-  for (i = 0; i <= n; i++)
-    dptable[i] = i;
-  for (j = 1; j <= m; j++) {
-    nw = dptable[0];
-    dptable[0] = j;
-    for (i = 1; i <= n; i++) {
-      we = dptable[i];
-      dptable[i] = nw + (u[i-1] == v[j-1] ? 0 : 1); /* replacement */
-      if (dptable[i-1] + 1 < dptable[i]) /* deletion */
-        dptable[i] = dptable[i-1] + 1;
-      if (we + 1 < dptable[i]) /* insertion */
-        dptable[i] = we + 1;
-      nw = we;
-    }
+  GtUword i, alphasize = 0, code[UCHAR_MAX + 1];
+  for (i = 0; i <= UCHAR_MAX; i++)
+    code[i] = UCHAR_MAX + 1;
+  for (i = 0; i < n; i++) {
+    if (code[(unsigned char) u[i]] > UCHAR_MAX)
+      code[(unsigned char) u[i]] = alphasize++;
+    ucodes[i] = (GtUchar) code[(unsigned char) u[i]];
   }
+  for (i = 0; i < m; i++) {
+    vcodes[i] = (GtUchar) MIN(code[(unsigned char) v[i]], alphasize);
+  }
+  return alphasize;
 }
 
 GtUword gt_calc_linearedist(const char *u, GtUword n,
                                   const char *v, GtUword m)
 {
-  GtUword *dptable, edist;
-  dptable = gt_malloc(sizeof (GtUword) * (MIN(n,m) + 1));
-  fillDPtable(dptable, n <= m ? u : v, MIN(n,m), n <= m ? v : u, MAX(n,m));
-  edist = dptable[MIN(n,m)];
-  gt_free(dptable);
+  GtEdistMyers *em;
+  GtUchar *ucodes, *vcodes;
+  GtUword edist, alphasize;
+  /* the shorter sequence is the pattern, which minimizes the number of
+     blocks of the bit vectors */
+  if (n > m)
+    return gt_calc_linearedist(v, m, u, n);
+  ucodes = gt_malloc(sizeof *ucodes * (n + m));
+  vcodes = ucodes + n;
+  alphasize = encode_sequences(ucodes, u, n, vcodes, v, m);
+  em = gt_edist_myers_new(ucodes, n, alphasize);
+  edist = gt_edist_myers_global(em, vcodes, m, GT_UWORD_MAX);
+  gt_edist_myers_delete(em);
+  gt_free(ucodes);
   return edist;
 }
@@ -20,7 +20,9 @@
 
 #include "core/error.h"
 
-/* Compute the edit distance of sequences u and v in O(max{|u|,|v|}) space */
+/* Compute the edit distance of sequences u and v in O(max{|u|,|v|}) space,
+   with the bit-parallel algorithm of Myers in O(|u||v|/w) time, where w is
+   the word size. */
 GtUword gt_calc_linearedist(const char *u, GtUword n,
                                   const char *v, GtUword m);
 
@@ -15,25 +15,304 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/array.h"
 #include "core/assert_api.h"
 #include "core/class_alloc_lock.h"
+#include "core/fa.h"
+#include "core/file_api.h"
+#include "core/hashmap_api.h"
+#include "core/log_api.h"
+#include "core/xansi_api.h"
 #include "extended/eof_node_api.h"
+#include "extended/feature_node_api.h"
+#include "extended/feature_node.h"
+#include "extended/feature_node_iterator_api.h"
 #include "extended/genome_node.h"
+#include "extended/gff3_in_stream_api.h"
+#include "extended/gff3_visitor_api.h"
+#include "extended/merge_stream.h"
+#include "extended/meta_node_api.h"
 #include "extended/node_stream_api.h"
+#include "extended/region_node.h"
+#include "extended/sequence_node_api.h"
 #include "extended/sort_stream.h"
 
+/* estimate of the memory occupied by a genome node whose size is not
+   estimated from its contents (comment nodes, for example) */
+#define GT_SORT_STREAM_NODE_SIZE      128UL
+
+/* estimated overhead of a single allocation, used to account for the blocks
+   a genome node consists of */
+#define GT_SORT_STREAM_ALLOC_OVERHEAD (2 * sizeof (void*))
+
+/* maximal number of runs merged at once */
+#define GT_SORT_STREAM_MAX_FANIN  64UL
+
 struct GtSortStream {
   const GtNodeStream parent_instance;
-  GtNodeStream *in_stream;
-  GtUword idx;
-  GtArray *nodes;
+  GtNodeStream *in_stream,
+               *merge_stream;
+  GtUword idx,
+          memlimit,
+          memused;
+  GtArray *nodes,
+          *region_nodes,
+          *runfiles;
+  GtHashmap *seqid_to_region_node;
   bool sorted;
 };
 
 #define gt_sort_stream_cast(GS)\
         gt_node_stream_cast(gt_sort_stream_class(), GS);
 
+/* Return the next node from the sorted <nodes>, starting at <*idx>. Region
+   nodes with the same sequence ID are joined. */
+static GtGenomeNode* sort_stream_next_sorted_node(GtArray *nodes, GtUword *idx)
+{
+  GtGenomeNode *gn, *node;
+  gt_assert(*idx < gt_array_size(nodes));
+  gn = *(GtGenomeNode**) gt_array_get(nodes, *idx);
+  (*idx)++;
+  /* join region nodes with the same sequence ID */
+  if (gt_region_node_try_cast(gn)) {
+    GtRange range_a, range_b;
+    while (*idx < gt_array_size(nodes)) {
+      node = *(GtGenomeNode**) gt_array_get(nodes, *idx);
+      if (!gt_region_node_try_cast(node) ||
+          gt_str_cmp(gt_genome_node_get_seqid(gn),
+                     gt_genome_node_get_seqid(node))) {
+        /* the next node is not a region node with the same ID */
+        break;
+      }
+      range_a = gt_genome_node_get_range(gn);
+      range_b = gt_genome_node_get_range(node);
+      range_a = gt_range_join(&range_a, &range_b);
+      gt_genome_node_set_range(gn, &range_a);
+      gt_genome_node_delete(node);
+      (*idx)++;
+    }
+  }
+  return gn;
+}
+
+static void sort_stream_add_attribute_size(const char *attr_name,
+                                           const char *attr_value, void *data)
+{
+  GtUword *size = data;
+  /* tag and value are stored as consecutive '\0' terminated strings */
+  *size += strlen(attr_name) + strlen(attr_value) + 2;
+}
+
+/* Return an estimate of the memory occupied by <gn>, which is used to decide
+   when a run has to be written to disk. For feature nodes every node of the
+   tree is accounted for with its attributes and its entry in the child list
+   of its parent. Sequence IDs, sources and types are shared between nodes and
+   are not counted. */
+static GtUword sort_stream_estimate_node_size(GtGenomeNode *gn)
+{
+  GtFeatureNodeIterator *fni;
+  GtFeatureNode *fn, *child;
+  GtSequenceNode *sn;
+  GtMetaNode *mn;
+  GtUword size = 0;
+  if ((fn = gt_feature_node_try_cast(gn))) {
+    fni = gt_feature_node_iterator_new(fn);
+    while ((child = gt_feature_node_iterator_next(fni))) {
+      GtUword attributes = 0;
+      size += gt_feature_node_object_size() + GT_SORT_STREAM_ALLOC_OVERHEAD;
+      gt_feature_node_foreach_attribute(child, sort_stream_add_attribute_size,
+                                        &attributes);
+      if (attributes > 0)
+        size += attributes + 1 + GT_SORT_STREAM_ALLOC_OVERHEAD;
+      if (child != fn) {
+        /* the element of the child list of the parent */
+        size += 3 * sizeof (void*) + GT_SORT_STREAM_ALLOC_OVERHEAD;
+      }
+    }
+    gt_feature_node_iterator_delete(fni);
+  }
+  else if ((sn = gt_sequence_node_try_cast(gn))) {
+    size = GT_SORT_STREAM_NODE_SIZE
+           + gt_sequence_node_get_sequence_length(sn)
+           + strlen(gt_sequence_node_get_description(sn));
+  }
+  else if ((mn = gt_meta_node_try_cast(gn))) {
+    size = GT_SORT_STREAM_NODE_SIZE + strlen(gt_meta_node_get_directive(mn));
+    if (gt_meta_node_get_data(mn) != NULL)
+      size += strlen(gt_meta_node_get_data(mn));
+  }
+  else
+    size = GT_SORT_STREAM_NODE_SIZE;
+  /* the pointer in the array of collected nodes */
+  return size + sizeof (GtGenomeNode*);
+}
+
+/* Keep the region node <rn> in memory, joined with the region node for the
+   same sequence ID seen before (if any). Region nodes are repeated at the
+   beginning of every run, so that each run is a valid sorted GFF3 file. */
+static void sort_stream_add_region_node(GtSortStream *sort_stream,
+                                        GtGenomeNode *rn)
+{
+  GtGenomeNode *prev;
+  const char *seqid = gt_str_get(gt_genome_node_get_seqid(rn));
+  if ((prev = gt_hashmap_get(sort_stream->seqid_to_region_node, seqid))) {
+    gt_region_node_consolidate(gt_region_node_cast(prev),
+                               gt_region_node_cast(rn));
+    gt_genome_node_delete(rn);
+  }
+  else {
+    gt_array_add(sort_stream->region_nodes, rn);
+    gt_hashmap_add(sort_stream->seqid_to_region_node, (void*) seqid, rn);
+  }
+}
+
+/* Return a GFF3 visitor writing to a new temporary file, whose name is stored
+   in <runfile>. The original ID attributes are retained, so that the feature
+   trees can be reconstructed when the run is read back. */
+static GtNodeVisitor* sort_stream_run_visitor_new(GtStr *runfile,
+                                                  GtFile **outfp)
+{
+  GtNodeVisitor *gff3_visitor;
+  *outfp = gt_file_new_from_fileptr(gt_xtmpfp(runfile));
+  gff3_visitor = gt_gff3_visitor_new(*outfp);
+  gt_gff3_visitor_retain_id_attributes((GtGFF3Visitor*) gff3_visitor);
+  return gff3_visitor;
+}
+
+/* Sort the nodes collected so far and write them as a run into a temporary
+   GFF3 file. */
+static int sort_stream_write_run(GtSortStream *sort_stream, GtError *err)
+{
+  GtNodeVisitor *gff3_visitor;
+  GtGenomeNode *gn;
+  GtFile *outfp;
+  GtStr *runfile;
+  GtUword idx = 0;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_genome_nodes_sort_stable(sort_stream->nodes);
+  runfile = gt_str_new();
+  gt_array_add(sort_stream->runfiles, runfile);
+  gff3_visitor = sort_stream_run_visitor_new(runfile, &outfp);
+  gt_genome_nodes_sort_stable(sort_stream->region_nodes);
+  while (!had_err && idx < gt_array_size(sort_stream->region_nodes)) {
+    gn = *(GtGenomeNode**) gt_array_get(sort_stream->region_nodes, idx++);
+    had_err = gt_genome_node_accept(gn, gff3_visitor, err);
+  }
+  idx = 0;
+  while (idx < gt_array_size(sort_stream->nodes)) {
+    gn = sort_stream_next_sorted_node(sort_stream->nodes, &idx);
+    if (!had_err)
+      had_err = gt_genome_node_accept(gn, gff3_visitor, err);
+    gt_genome_node_delete(gn);
+  }
+  gt_node_visitor_delete(gff3_visitor);
+  gt_file_delete(outfp);
+  gt_log_log("sort stream: wrote run "GT_WU" with an estimated size of "GT_WU
+             " bytes", gt_array_size(sort_stream->runfiles),
+             sort_stream->memused);
+  gt_array_reset(sort_stream->nodes);
+  sort_stream->memused = 0;
+  return had_err;
+}
+
+/* Return a stream merging the runs <from> to <to> - 1 of <runfiles>. */
+static GtNodeStream* sort_stream_merge_stream_new(const GtArray *runfiles,
+                                                  GtUword from, GtUword to)
+{
+  GtNodeStream *merge_stream;
+  GtArray *run_streams;
+  GtUword i;
+  gt_assert(from < to && to <= gt_array_size(runfiles));
+  run_streams = gt_array_new(sizeof (GtNodeStream*));
+  for (i = from; i < to; i++) {
+    GtNodeStream *run_stream =
+      gt_gff3_in_stream_new_sorted(gt_str_get(*(GtStr**)
+                                              gt_array_get(runfiles, i)));
+    gt_array_add(run_streams, run_stream);
+  }
+  merge_stream = gt_merge_stream_new(run_streams);
+  for (i = 0; i < gt_array_size(run_streams); i++)
+    gt_node_stream_delete(*(GtNodeStream**) gt_array_get(run_streams, i));
+  gt_array_delete(run_streams);
+  return merge_stream;
+}
+
+/* Merge groups of at most <GT_SORT_STREAM_MAX_FANIN> consecutive runs into
+   single runs, such that the number of runs (and open files) is reduced by
+   this factor. The order of the runs is kept to preserve stability. */
+static int sort_stream_merge_pass(GtSortStream *sort_stream, GtError *err)
+{
+  GtNodeStream *merge_stream;
+  GtNodeVisitor *gff3_visitor;
+  GtGenomeNode *gn;
+  GtArray *runfiles;
+  GtFile *outfp;
+  GtStr *runfile;
+  GtUword i, from, to;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_log_log("sort stream: merging "GT_WU" runs in groups of at most "GT_WU,
+             gt_array_size(sort_stream->runfiles),
+             (GtUword) GT_SORT_STREAM_MAX_FANIN);
+  runfiles = gt_array_new(sizeof (GtStr*));
+  for (from = 0; !had_err && from < gt_array_size(sort_stream->runfiles);
+       from = to) {
+    to = from + GT_SORT_STREAM_MAX_FANIN;
+    if (to > gt_array_size(sort_stream->runfiles))
+      to = gt_array_size(sort_stream->runfiles);
+    runfile = gt_str_new();
+    gt_array_add(runfiles, runfile);
+    merge_stream = sort_stream_merge_stream_new(sort_stream->runfiles, from,
+                                                to);
+    gff3_visitor = sort_stream_run_visitor_new(runfile, &outfp);
+    while (!(had_err = gt_node_stream_next(merge_stream, &gn, err)) && gn) {
+      had_err = gt_genome_node_accept(gn, gff3_visitor, err);
+      gt_genome_node_delete(gn);
+      if (had_err)
+        break;
+    }
+    gt_node_visitor_delete(gff3_visitor);
+    gt_file_delete(outfp);
+    gt_node_stream_delete(merge_stream);
+  }
+  for (i = 0; i < gt_array_size(sort_stream->runfiles); i++) {
+    runfile = *(GtStr**) gt_array_get(sort_stream->runfiles, i);
+    gt_xremove(gt_str_get(runfile));
+    gt_str_delete(runfile);
+  }
+  gt_array_delete(sort_stream->runfiles);
+  sort_stream->runfiles = runfiles;
+  return had_err;
+}
+
+/* Write the remaining nodes as the last run and merge all runs. */
+static int sort_stream_merge_runs(GtSortStream *sort_stream, GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  if (gt_array_size(sort_stream->nodes))
+    had_err = sort_stream_write_run(sort_stream, err);
+  for (i = 0; i < gt_array_size(sort_stream->region_nodes); i++) {
+    gt_genome_node_delete(*(GtGenomeNode**)
+                          gt_array_get(sort_stream->region_nodes, i));
+  }
+  gt_array_reset(sort_stream->region_nodes);
+  gt_hashmap_reset(sort_stream->seqid_to_region_node);
+  while (!had_err &&
+         gt_array_size(sort_stream->runfiles) > GT_SORT_STREAM_MAX_FANIN) {
+    had_err = sort_stream_merge_pass(sort_stream, err);
+  }
+  if (!had_err) {
+    sort_stream->merge_stream =
+      sort_stream_merge_stream_new(sort_stream->runfiles, 0,
+                                   gt_array_size(sort_stream->runfiles));
+  }
+  return had_err;
+}
+
 static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -49,41 +328,41 @@ static int gt_sort_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                            err)) && node) {
       if ((eofn = gt_eof_node_try_cast(node)))
         gt_genome_node_delete(node); /* get rid of EOF nodes */
-      else
+      else if (sort_stream->memlimit && gt_region_node_try_cast(node))
+        sort_stream_add_region_node(sort_stream, node);
+      else {
         gt_array_add(sort_stream->nodes, node);
+        if (sort_stream->memlimit) {
+          sort_stream->memused += sort_stream_estimate_node_size(node);
+          if (sort_stream->memused > sort_stream->memlimit &&
+              (had_err = sort_stream_write_run(sort_stream, err))) {
+            break;
+          }
+        }
+      }
     }
     if (!had_err) {
-      gt_genome_nodes_sort_stable(sort_stream->nodes);
-      sort_stream->sorted = true;
+      if (gt_array_size(sort_stream->runfiles))
+        had_err = sort_stream_merge_runs(sort_stream, err);
+      else {
+        /* everything fits into memory, put the region nodes back */
+        gt_array_add_array(sort_stream->nodes, sort_stream->region_nodes);
+        gt_array_reset(sort_stream->region_nodes);
+        gt_genome_nodes_sort_stable(sort_stream->nodes);
+      }
     }
+    if (!had_err)
+      sort_stream->sorted = true;
   }
 
+  if (!had_err && sort_stream->merge_stream)
+    return gt_node_stream_next(sort_stream->merge_stream, gn, err);
+
   if (!had_err) {
     gt_assert(sort_stream->sorted);
     if (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-      *gn = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                           sort_stream->idx);
-      sort_stream->idx++;
-      /* join region nodes with the same sequence ID */
-      if (gt_region_node_try_cast(*gn)) {
-        GtRange range_a, range_b;
-        while (sort_stream->idx < gt_array_size(sort_stream->nodes)) {
-          node = *(GtGenomeNode**) gt_array_get(sort_stream->nodes,
-                                                sort_stream->idx);
-          if (!gt_region_node_try_cast(node) ||
-              gt_str_cmp(gt_genome_node_get_seqid(*gn),
-                         gt_genome_node_get_seqid(node))) {
-            /* the next node is not a region node with the same ID */
-            break;
-          }
-          range_a = gt_genome_node_get_range(*gn);
-          range_b = gt_genome_node_get_range(node);
-          range_a = gt_range_join(&range_a, &range_b);
-          gt_genome_node_set_range(*gn, &range_a);
-          gt_genome_node_delete(node);
-          sort_stream->idx++;
-        }
-      }
+      *gn = sort_stream_next_sorted_node(sort_stream->nodes,
+                                         &sort_stream->idx);
       return 0;
     }
   }
@@ -105,6 +384,19 @@ static void gt_sort_stream_free(GtNodeStream *ns)
                           gt_array_get(sort_stream->nodes, i));
   }
   gt_array_delete(sort_stream->nodes);
+  for (i = 0; i < gt_array_size(sort_stream->region_nodes); i++) {
+    gt_genome_node_delete(*(GtGenomeNode**)
+                          gt_array_get(sort_stream->region_nodes, i));
+  }
+  gt_array_delete(sort_stream->region_nodes);
+  gt_hashmap_delete(sort_stream->seqid_to_region_node);
+  gt_node_stream_delete(sort_stream->merge_stream);
+  for (i = 0; i < gt_array_size(sort_stream->runfiles); i++) {
+    GtStr *runfile = *(GtStr**) gt_array_get(sort_stream->runfiles, i);
+    gt_xremove(gt_str_get(runfile));
+    gt_str_delete(runfile);
+  }
+  gt_array_delete(sort_stream->runfiles);
   gt_node_stream_delete(sort_stream->in_stream);
 }
 
@@ -130,5 +422,18 @@ GtNodeStream* gt_sort_stream_new(GtNodeStream *in_stream)
   sort_stream->sorted = false;
   sort_stream->idx = 0;
   sort_stream->nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->merge_stream = NULL;
+  sort_stream->region_nodes = gt_array_new(sizeof (GtGenomeNode*));
+  sort_stream->seqid_to_region_node = gt_hashmap_new(GT_HASH_STRING, NULL,
+                                                     NULL);
+  sort_stream->runfiles = gt_array_new(sizeof (GtStr*));
+  sort_stream->memlimit = 0;
+  sort_stream->memused = 0;
   return ns;
 }
+
+void gt_sort_stream_set_memlimit(GtSortStream *sort_stream, GtUword memlimit)
+{
+  gt_assert(sort_stream && !sort_stream->sorted);
+  sort_stream->memlimit = memlimit;
+}
@@ -22,4 +22,12 @@
 
 const GtNodeStreamClass* gt_sort_stream_class(void);
 
+/* Limit the memory used by <sort_stream> for collecting genome nodes to
+   (approximately) <memlimit> bytes. Whenever the limit is exceeded, the nodes
+   collected so far are sorted and written to a temporary file as a sorted run.
+   The runs are merged afterwards. A <memlimit> of 0 means no limit (the
+   default). */
+void                     gt_sort_stream_set_memlimit(GtSortStream *sort_stream,
+                                                     GtUword memlimit);
+
 #endif
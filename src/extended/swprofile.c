@@ -0,0 +1,521 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <limits.h>
+#include "core/assert_api.h"
+#include "core/chardef.h"
+#include "core/ensure.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
+#include "core/qsort_r_api.h"
+#include "core/unused_api.h"
+#include "extended/swprofile.h"
+
+/* The maximal number of lanes of the vectorized kernels. */
+#define SWPROFILE_MAXLANES  16
+
+/* The lane vectors are aligned to their maximal size. */
+#define SWPROFILE_LANEBYTES (SWPROFILE_MAXLANES * sizeof (short))
+
+/* The kernels are used if the scores of all cells are at most
+   SWPROFILE_MAXSCORE. Smaller scores are clipped to SWPROFILE_NOSTART, which
+   is also the value of cells without alignments in the anchored DP. From a
+   value this small, no positive score can be reached, and the sum of two
+   clipped values still fits into a short. */
+#define SWPROFILE_MAXSCORE  8191
+#define SWPROFILE_NOSTART   (-2 * SWPROFILE_MAXSCORE - 2)
+
+/* The AVX2 kernel is only available for x86-64 compilers which support target
+   specific functions. */
+#if defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define SWPROFILE_AVX2
+#endif
+
+struct GtSWProfile {
+  GtUword numofseqs,
+          numofgroups,
+          lanes,
+          alphasize,  /* of the queries, the last row is used for wildcards */
+          libalphasize,
+          maxcolumns,
+          *order,     /* library sequences sorted by length */
+          *columns,   /* length of the longest sequence of each group */
+          *groupoffset,
+          *seqlengths;
+  const GtUchar **seqs;
+  const int **scores;
+  int deletion_score,
+      insertion_score,
+      maxpositive;
+  void *profilealloc,
+       *profile;
+  void (*group_scores)(const GtSWProfile*, GtUword, const GtUchar*, GtUword,
+                       GtRange, GtRange, void*, GtWord*, GtWord*);
+};
+
+static short swprofile_clip(int score)
+{
+  if (score < SWPROFILE_NOSTART)
+    return (short) SWPROFILE_NOSTART;
+  if (score > SWPROFILE_MAXSCORE)
+    return (short) SWPROFILE_MAXSCORE;
+  return (short) score;
+}
+
+/* generic kernel, vectorized for the baseline instruction set */
+#define SWPROFILE_TARGET
+#define SWPROFILE_FUNC(F)  F##_generic
+#define SWPROFILE_LANES    8
+#include "extended/swprofile_lanes.gen"
+#undef SWPROFILE_TARGET
+#undef SWPROFILE_FUNC
+#undef SWPROFILE_LANES
+
+#ifdef SWPROFILE_AVX2
+#define SWPROFILE_TARGET   __attribute__((target("avx2")))
+#define SWPROFILE_FUNC(F)  F##_avx2
+#define SWPROFILE_LANES    16
+#include "extended/swprofile_lanes.gen"
+#undef SWPROFILE_TARGET
+#undef SWPROFILE_FUNC
+#undef SWPROFILE_LANES
+#endif
+
+static GtUword swprofile_libcode(const GtSWProfile *swp, GtUchar cc)
+{
+  return cc == (GtUchar) WILDCARD ? swp->libalphasize - 1 : (GtUword) cc;
+}
+
+static int swprofile_compare_lengths(const void *a, const void *b,
+                                     void *data)
+{
+  const GtUword *seqlengths = data,
+                idx1 = *(const GtUword*) a,
+                idx2 = *(const GtUword*) b;
+  if (seqlengths[idx1] != seqlengths[idx2])
+    return seqlengths[idx1] < seqlengths[idx2] ? -1 : 1;
+  return idx1 < idx2 ? -1 : (idx1 > idx2 ? 1 : 0);
+}
+
+static void swprofile_fill(GtSWProfile *swp)
+{
+  GtUword g, c, j, l, totalvectors = 0;
+  short *profile;
+
+  swp->columns = gt_malloc(sizeof *swp->columns * swp->numofgroups);
+  swp->groupoffset = gt_malloc(sizeof *swp->groupoffset * swp->numofgroups);
+  swp->maxcolumns = 0;
+  for (g = 0; g < swp->numofgroups; g++) {
+    GtUword last = MIN((g + 1) * swp->lanes, swp->numofseqs) - 1;
+    /* the groups are sorted by length, the last one is the longest */
+    swp->columns[g] = swp->seqlengths[swp->order[last]];
+    swp->maxcolumns = MAX(swp->maxcolumns, swp->columns[g]);
+    swp->groupoffset[g] = totalvectors;
+    /* one vector of scores per query character and column, and a mask */
+    totalvectors += (swp->alphasize + 1) * swp->columns[g];
+  }
+  swp->profilealloc = gt_calloc((size_t) (totalvectors + 1),
+                                SWPROFILE_LANEBYTES);
+  swp->profile = (void*) (((size_t) swp->profilealloc +
+                           SWPROFILE_LANEBYTES - 1) &
+                          ~(SWPROFILE_LANEBYTES - 1));
+  profile = swp->profile;
+  for (g = 0; g < swp->numofgroups; g++) {
+    short *gprofile = profile + swp->groupoffset[g] * swp->lanes,
+          *mask = gprofile + swp->alphasize * swp->columns[g] * swp->lanes;
+    for (l = 0; l < swp->lanes; l++) {
+      GtUword idx = g * swp->lanes + l, seqnum;
+      if (idx >= swp->numofseqs)
+        break;
+      seqnum = swp->order[idx];
+      for (j = 0; j < swp->seqlengths[seqnum]; j++) {
+        GtUword vcode = swprofile_libcode(swp, swp->seqs[seqnum][j]);
+        for (c = 0; c < swp->alphasize; c++) {
+          gprofile[(c * swp->columns[g] + j) * swp->lanes + l]
+            = swprofile_clip(swp->scores[c][vcode]);
+        }
+        mask[j * swp->lanes + l] = (short) -1;
+      }
+    }
+  }
+}
+
+/* Returns a new <GtSWProfile> using the AVX2 kernel if <use_avx2> is true
+   and the CPU supports it. */
+static GtSWProfile* swprofile_new(GtSeq **library, GtUword numofseqs,
+                                  const GtAlphabet *query_alpha,
+                                  const GtScoreFunction *sf,
+                                  GT_UNUSED bool use_avx2)
+{
+  GtSWProfile *swp;
+  GtUword i, c, d;
+  gt_assert((library || numofseqs == 0) && query_alpha && sf);
+
+  swp = gt_calloc((size_t) 1, sizeof *swp);
+  swp->numofseqs = numofseqs;
+  swp->alphasize = (GtUword) gt_alphabet_size(query_alpha);
+  swp->libalphasize = numofseqs > 0
+                      ? (GtUword) gt_alphabet_size(
+                                             gt_seq_get_alphabet(library[0]))
+                      : swp->alphasize;
+  swp->scores = gt_score_function_get_scores(sf);
+  swp->deletion_score = gt_score_function_get_deletion_score(sf);
+  swp->insertion_score = gt_score_function_get_insertion_score(sf);
+  swp->maxpositive = MAX(MAX(swp->deletion_score, swp->insertion_score), 0);
+  for (c = 0; c < swp->alphasize; c++) {
+    for (d = 0; d < swp->libalphasize; d++)
+      swp->maxpositive = MAX(swp->maxpositive, swp->scores[c][d]);
+  }
+  swp->seqs = gt_malloc(sizeof *swp->seqs * numofseqs);
+  swp->seqlengths = gt_malloc(sizeof *swp->seqlengths * numofseqs);
+  swp->order = gt_malloc(sizeof *swp->order * numofseqs);
+  for (i = 0; i < numofseqs; i++) {
+    gt_assert(gt_alphabet_size(gt_seq_get_alphabet(library[i]))
+              == (unsigned int) swp->libalphasize);
+    swp->seqs[i] = gt_seq_get_encoded(library[i]);
+    swp->seqlengths[i] = gt_seq_length(library[i]);
+    swp->order[i] = i;
+  }
+  /* sequences of similar length share a group, to save padding */
+  gt_qsort_r(swp->order, (size_t) numofseqs, sizeof *swp->order,
+             swp->seqlengths, swprofile_compare_lengths);
+
+  swp->group_scores = swprofile_group_generic;
+  swp->lanes = 8UL;
+#ifdef SWPROFILE_AVX2
+  __builtin_cpu_init();
+  if (use_avx2 && __builtin_cpu_supports("avx2")) {
+    swp->group_scores = swprofile_group_avx2;
+    swp->lanes = 16UL;
+  }
+#endif
+  swp->numofgroups = (numofseqs + swp->lanes - 1) / swp->lanes;
+  swprofile_fill(swp);
+  return swp;
+}
+
+GtSWProfile* gt_swprofile_new(GtSeq **library, GtUword numofseqs,
+                              const GtAlphabet *query_alpha,
+                              const GtScoreFunction *sf)
+{
+  return swprofile_new(library, numofseqs, query_alpha, sf, true);
+}
+
+/* Computes the scores of <u> and <v> with linear space, used if the scores
+   could exceed the range of the vectorized kernels. */
+static void swprofile_scalar(const GtSWProfile *swp,
+                             const GtUchar *u, GtUword ulen,
+                             const GtUchar *v, GtUword vlen,
+                             GtRange ustart, GtRange vstart,
+                             GtWord *row, GtWord *score,
+                             GtWord *anchoredscore)
+{
+  const GtWord nostart = GT_WORD_MIN / 4;
+  GtWord *arow = row + vlen + 1, best = 0, abest = nostart;
+  GtUword i, j;
+
+  for (j = 0; j <= vlen; j++) {
+    row[j] = 0;
+    arow[j] = nostart;
+  }
+  for (i = 0; i < ulen; i++) {
+    GtWord diag = 0, adiag = nostart;
+    for (j = 1; j <= vlen; j++) {
+      GtWord s = swp->scores[u[i]][swprofile_libcode(swp, v[j-1])],
+             up = row[j],
+             h = diag + s;
+      h = MAX(h, up + swp->deletion_score);
+      h = MAX(h, row[j-1] + swp->insertion_score);
+      h = MAX(h, 0);
+      diag = up;
+      row[j] = h;
+      best = MAX(best, h);
+      if (anchoredscore != NULL) {
+        up = arow[j];
+        h = adiag + s;
+        if (i >= ustart.start && i <= ustart.end &&
+            j - 1 >= vstart.start && j - 1 <= vstart.end)
+          h = MAX(h, s);
+        h = MAX(h, up + swp->deletion_score);
+        h = MAX(h, arow[j-1] + swp->insertion_score);
+        h = MAX(h, nostart);
+        adiag = up;
+        arow[j] = h;
+        abest = MAX(abest, h);
+      }
+    }
+  }
+  *score = best;
+  if (anchoredscore != NULL)
+    *anchoredscore = abest;
+}
+
+static void swprofile_scores(const GtSWProfile *swp, GtSeq *query,
+                             GtRange ustart, GtRange vstart,
+                             GtWord *scores, GtWord *anchoredscores)
+{
+  const GtUchar *encoded;
+  GtUchar *mapped;
+  GtUword i, querylength;
+  gt_assert(swp && query && scores);
+
+  querylength = gt_seq_length(query);
+  encoded = gt_seq_get_encoded(query);
+  mapped = gt_malloc(sizeof *mapped * (querylength + 1));
+  for (i = 0; i < querylength; i++) {
+    mapped[i] = encoded[i] == (GtUchar) WILDCARD
+                ? (GtUchar) (swp->alphasize - 1)
+                : encoded[i];
+    gt_assert((GtUword) mapped[i] < swp->alphasize);
+  }
+  if ((GtWord) (querylength + swp->maxcolumns) * swp->maxpositive
+        <= (GtWord) SWPROFILE_MAXSCORE) {
+    void *spacealloc, *space;
+    spacealloc = gt_malloc((2 * swp->maxcolumns + 1) * SWPROFILE_LANEBYTES);
+    space = (void*) (((size_t) spacealloc + SWPROFILE_LANEBYTES - 1) &
+                     ~(SWPROFILE_LANEBYTES - 1));
+    for (i = 0; i < swp->numofgroups; i++) {
+      swp->group_scores(swp, i, mapped, querylength, ustart, vstart, space,
+                        scores, anchoredscores);
+    }
+    gt_free(spacealloc);
+  } else {
+    GtWord *row = gt_malloc(sizeof *row * 2 * (swp->maxcolumns + 1));
+    for (i = 0; i < swp->numofseqs; i++) {
+      swprofile_scalar(swp, mapped, querylength, swp->seqs[i],
+                       swp->seqlengths[i], ustart, vstart, row, scores + i,
+                       anchoredscores != NULL ? anchoredscores + i : NULL);
+    }
+    gt_free(row);
+  }
+  gt_free(mapped);
+}
+
+void gt_swprofile_scores(const GtSWProfile *swp, GtSeq *query, GtWord *scores)
+{
+  GtRange norange = {0, 0};
+  swprofile_scores(swp, query, norange, norange, scores, NULL);
+}
+
+void gt_swprofile_scores_anchored(const GtSWProfile *swp, GtSeq *query,
+                                  GtRange ustart, GtRange vstart,
+                                  GtWord *scores, GtWord *anchoredscores)
+{
+  gt_assert(anchoredscores);
+  swprofile_scores(swp, query, ustart, vstart, scores, anchoredscores);
+}
+
+void gt_swprofile_delete(GtSWProfile *swp)
+{
+  if (!swp) return;
+  gt_free(swp->profilealloc);
+  gt_free(swp->groupoffset);
+  gt_free(swp->columns);
+  gt_free(swp->order);
+  gt_free(swp->seqlengths);
+  gt_free(swp->seqs);
+  gt_free(swp);
+}
+
+/* quadratic space reference, following the recurrences of <gt_swalign()> */
+static GtWord swprofile_test_score(const GtUchar *u, GtUword ulen,
+                                   const GtUchar *v, GtUword vlen,
+                                   const int **scores, int deletion_score,
+                                   int insertion_score, GtUword alphasize)
+{
+  GtWord **dp, best = 0;
+  GtUword i, j;
+
+  dp = gt_malloc(sizeof *dp * (ulen + 1));
+  for (i = 0; i <= ulen; i++)
+    dp[i] = gt_calloc((size_t) (vlen + 1), sizeof **dp);
+  for (i = 1; i <= ulen; i++) {
+    for (j = 1; j <= vlen; j++) {
+      GtUword uval = u[i-1] == (GtUchar) WILDCARD ? alphasize - 1 : u[i-1],
+              vval = v[j-1] == (GtUchar) WILDCARD ? alphasize - 1 : v[j-1];
+      GtWord h = dp[i-1][j-1] + scores[uval][vval];
+      h = MAX(h, dp[i-1][j] + deletion_score);
+      h = MAX(h, dp[i][j-1] + insertion_score);
+      dp[i][j] = MAX(h, 0);
+      best = MAX(best, dp[i][j]);
+    }
+  }
+  for (i = 0; i <= ulen; i++)
+    gt_free(dp[i]);
+  gt_free(dp);
+  return best;
+}
+
+/* the best score of the alignments beginning with a replacement of <u>[<a>]
+   and <v>[<b>], for all <a> in <ustart> and <b> in <vstart> */
+static GtWord swprofile_test_anchored(const GtUchar *u, GtUword ulen,
+                                      const GtUchar *v, GtUword vlen,
+                                      GtRange ustart, GtRange vstart,
+                                      const int **scores, int deletion_score,
+                                      int insertion_score, GtUword alphasize)
+{
+  const GtWord undef = GT_WORD_MIN / 4;
+  GtWord **dp, best = undef;
+  GtUword a, b, i, j;
+
+  dp = gt_malloc(sizeof *dp * (ulen + 1));
+  for (i = 0; i <= ulen; i++)
+    dp[i] = gt_malloc(sizeof **dp * (vlen + 1));
+  for (a = ustart.start; a <= ustart.end && a < ulen; a++) {
+    for (b = vstart.start; b <= vstart.end && b < vlen; b++) {
+      for (i = a; i <= ulen; i++) {
+        for (j = b; j <= vlen; j++)
+          dp[i][j] = undef;
+      }
+      for (i = a + 1; i <= ulen; i++) {
+        for (j = b + 1; j <= vlen; j++) {
+          GtUword uval = u[i-1] == (GtUchar) WILDCARD ? alphasize - 1 : u[i-1],
+                  vval = v[j-1] == (GtUchar) WILDCARD ? alphasize - 1 : v[j-1];
+          GtWord h = undef;
+          if (i == a + 1 && j == b + 1)
+            h = scores[uval][vval];
+          else {
+            if (dp[i-1][j-1] != undef)
+              h = MAX(h, dp[i-1][j-1] + scores[uval][vval]);
+            if (dp[i-1][j] != undef)
+              h = MAX(h, dp[i-1][j] + deletion_score);
+            if (dp[i][j-1] != undef)
+              h = MAX(h, dp[i][j-1] + insertion_score);
+          }
+          dp[i][j] = h;
+          best = MAX(best, h);
+        }
+      }
+    }
+  }
+  for (i = 0; i <= ulen; i++)
+    gt_free(dp[i]);
+  gt_free(dp);
+  return best;
+}
+
+static char* swprofile_test_seq(GtUword length, GtUword maxlength)
+{
+  static const char chars[] = "acgtn";
+  char *seq = gt_malloc(sizeof *seq * (maxlength + 1));
+  GtUword i;
+  for (i = 0; i < length; i++)
+    seq[i] = chars[gt_rand_max(gt_rand_max(20UL) == 0 ? 4UL : 3UL)];
+  seq[length] = '\0';
+  return seq;
+}
+
+int gt_swprofile_unit_test(GtError *err)
+{
+  const GtUword maxlength = 80UL;
+  GtAlphabet *alpha;
+  int had_err = 0;
+  GtUword r;
+
+  gt_error_check(err);
+  alpha = gt_alphabet_new_dna();
+  for (r = 0; !had_err && r < 50UL; r++) {
+    GtUword numofseqs = gt_rand_max(30UL), i, q, alphasize;
+    GtScoreMatrix *sm = gt_score_matrix_new(alpha);
+    GtScoreFunction *sf;
+    GtSWProfile *swp[2];
+    GtSeq **library;
+    GtWord *scores, *anchoredscores;
+    unsigned int m, n;
+    int match = 1 + (int) gt_rand_max(9UL),
+        mismatch = -(int) gt_rand_max(10UL);
+
+    alphasize = (GtUword) gt_alphabet_size(alpha);
+    for (m = 0; m < (unsigned int) alphasize; m++) {
+      for (n = 0; n < (unsigned int) alphasize; n++)
+        gt_score_matrix_set_score(sm, m, n, m == n ? match : mismatch);
+    }
+    /* every tenth round the scores exceed the range of the kernels */
+    if (r % 10 == 9)
+      gt_score_matrix_set_score(sm, 0, 0, 1000);
+    /* and in some rounds gaps are rewarded, which also extends alignments
+       beyond the ends of the library sequences in the kernels */
+    sf = gt_score_function_new(sm, r % 10 == 4 ? 1 : -(int) gt_rand_max(10UL),
+                               r % 10 == 5 ? 1 : -(int) gt_rand_max(10UL));
+    library = gt_malloc(sizeof *library * (numofseqs + 1));
+    for (i = 0; i < numofseqs; i++) {
+      GtUword length = gt_rand_max(maxlength);
+      library[i] = gt_seq_new_own(swprofile_test_seq(length, maxlength),
+                                  length, alpha);
+    }
+    /* test the generic kernel and the fastest one the CPU supports */
+    swp[0] = swprofile_new(library, numofseqs, alpha, sf, false);
+    swp[1] = gt_swprofile_new(library, numofseqs, alpha, sf);
+    scores = gt_malloc(sizeof *scores * (numofseqs + 1));
+    anchoredscores = gt_malloc(sizeof *anchoredscores * (numofseqs + 1));
+    for (q = 0; !had_err && q < 10UL; q++) {
+      GtUword length = gt_rand_max(maxlength);
+      GtSeq *query = gt_seq_new_own(swprofile_test_seq(length, maxlength),
+                                    length, alpha);
+      GtRange ustart, vstart;
+      ustart.start = gt_rand_max(maxlength);
+      ustart.end = ustart.start + gt_rand_max(2UL);
+      vstart.start = gt_rand_max(maxlength / 2);
+      vstart.end = vstart.start + gt_rand_max(2UL);
+      if (q < 5UL)
+        gt_swprofile_scores(swp[q % 2], query, scores);
+      else {
+        gt_swprofile_scores_anchored(swp[q % 2], query, ustart, vstart, scores,
+                                     anchoredscores);
+      }
+      for (i = 0; !had_err && i < numofseqs; i++) {
+        GtWord expected;
+        if (q >= 5UL) {
+          expected = swprofile_test_anchored(gt_seq_get_encoded(query),
+                                    length,
+                                    gt_seq_get_encoded(library[i]),
+                                    gt_seq_length(library[i]),
+                                    ustart, vstart,
+                                    gt_score_function_get_scores(sf),
+                                    gt_score_function_get_deletion_score(sf),
+                                    gt_score_function_get_insertion_score(sf),
+                                    alphasize);
+          if (expected > 0)
+            gt_ensure(anchoredscores[i] == expected);
+          else
+            gt_ensure(anchoredscores[i] <= 0);
+        }
+        expected = swprofile_test_score(gt_seq_get_encoded(query),
+                                    length,
+                                    gt_seq_get_encoded(library[i]),
+                                    gt_seq_length(library[i]),
+                                    gt_score_function_get_scores(sf),
+                                    gt_score_function_get_deletion_score(sf),
+                                    gt_score_function_get_insertion_score(sf),
+                                    alphasize);
+        gt_ensure(scores[i] == expected);
+      }
+      gt_seq_delete(query);
+    }
+    gt_swprofile_delete(swp[0]);
+    gt_swprofile_delete(swp[1]);
+    for (i = 0; i < numofseqs; i++)
+      gt_seq_delete(library[i]);
+    gt_free(library);
+    gt_free(scores);
+    gt_free(anchoredscores);
+    gt_score_function_delete(sf);
+  }
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
@@ -0,0 +1,66 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SWPROFILE_H
+#define SWPROFILE_H
+
+#include "core/alphabet_api.h"
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "core/score_function.h"
+#include "core/seq.h"
+
+/* The <GtSWProfile> class computes the scores of optimal local alignments
+   (as computed by <gt_swalign()>) of query sequences with every sequence of a
+   fixed library, without the alignments themselves. The library sequences are
+   aligned simultaneously, one per lane of a SIMD register (inter-sequence
+   vectorization), with a profile which stores the scores of all lanes for every
+   library position and query character. */
+typedef struct GtSWProfile GtSWProfile;
+
+/* Return a new <GtSWProfile> for the <numofseqs> sequences in <library>, to
+   be aligned with queries over <query_alpha> using score function <sf>. The
+   library sequences and <sf> must not be deleted before the returned
+   object. */
+GtSWProfile* gt_swprofile_new(GtSeq **library, GtUword numofseqs,
+                              const GtAlphabet *query_alpha,
+                              const GtScoreFunction *sf);
+
+/* Store the score of an optimal local alignment of <query> and the <i>-th
+   library sequence of <swp> in <scores>[<i>], for all library sequences.
+   May be called for different queries simultaneously. */
+void         gt_swprofile_scores(const GtSWProfile *swp, GtSeq *query,
+                                 GtWord *scores);
+
+/* Like <gt_swprofile_scores()>, but additionally store in
+   <anchoredscores>[<i>] the maximal score of the alignments of <query> and the
+   <i>-th library sequence which begin with a replacement of a query position
+   in <ustart> and a library position in <vstart>, if it is positive, and a
+   value <= 0 otherwise. Used to decide whether an optimal alignment begins in
+   this rectangle, which is the case iff the anchored score equals the score
+   (and is positive). */
+void         gt_swprofile_scores_anchored(const GtSWProfile *swp,
+                                          GtSeq *query,
+                                          GtRange ustart, GtRange vstart,
+                                          GtWord *scores,
+                                          GtWord *anchoredscores);
+
+/* Delete <swp>. */
+void         gt_swprofile_delete(GtSWProfile *swp);
+
+int          gt_swprofile_unit_test(GtError *err);
+
+#endif
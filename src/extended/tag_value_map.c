@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "core/ma.h"
+#include "core/slab.h"
 #include "core/ensure.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -37,7 +38,7 @@ GtTagValueMap gt_tag_value_map_new(const char *tag, const char *value)
   tag_len = strlen(tag);
   value_len = strlen(value);
   gt_assert(tag_len && value_len);
-  map = gt_malloc((tag_len + 1 + value_len + 1 + 1) * sizeof *map);
+  map = gt_slab_class_alloc((tag_len + 1 + value_len + 1 + 1) * sizeof *map);
   memcpy(map, tag, tag_len + 1);
   memcpy(map + tag_len + 1, value, value_len + 1);
   map[tag_len + 1 + value_len + 1] = '\0';
@@ -94,7 +95,8 @@ void gt_tag_value_map_add(GtTagValueMap *map, const char *tag,
   tag_already_used = get_value(*map, tag, &map_len);
   gt_assert(!tag_already_used); /* map does not contain given <tag> already */
   /* allocate additional space */
-  *map = gt_realloc(*map, map_len + tag_len + 1 + value_len + 1 + 1);
+  *map = gt_slab_class_realloc(*map, map_len + 1,
+                               map_len + tag_len + 1 + value_len + 1 + 1);
   /* store new tag/value pair */
   memcpy(*map + map_len, tag, tag_len + 1);
   memcpy(*map + map_len + tag_len + 1, value, value_len + 1);
@@ -117,7 +119,8 @@ void gt_tag_value_map_remove(GtTagValueMap *map, const char *tag)
   /* move memory from end position of value to start position of tag */
   memmove(value - tag_len - 1, value + value_len + 1,
           map_len - ((size_t) value - (size_t) *map + value_len));
-  *map = gt_realloc(*map, map_len - (tag_len + 1 + value_len + 1) + 1);
+  *map = gt_slab_class_realloc(*map, map_len + 1,
+                               map_len - (tag_len + 1 + value_len + 1) + 1);
   gt_assert((*map)[map_len - (tag_len + 1 + value_len + 1)] == '\0');
 }
 
@@ -141,13 +144,15 @@ void gt_tag_value_map_set(GtTagValueMap *map, const char *tag,
     memcpy(old_value, new_value, new_value_len);
     memmove(old_value + new_value_len, old_value + old_value_len,
             map_len - ((size_t) old_value - (size_t) *map + old_value_len) + 1);
-    *map = gt_realloc(*map, map_len - (old_value_len - new_value_len) + 1);
+    *map = gt_slab_class_realloc(*map, map_len + 1,
+                                 map_len - (old_value_len - new_value_len) + 1);
   }
   else if (new_value_len == old_value_len) {
     memcpy(old_value, new_value, new_value_len);
   }
   else { /* (new_value_len > old_value_len)  */
-    *map = gt_realloc(*map, map_len + (new_value_len - old_value_len) + 1);
+    *map = gt_slab_class_realloc(*map, map_len + 1,
+                                 map_len + (new_value_len - old_value_len) + 1);
     /* determine old_value again, realloc() might have moved it */
     old_value = get_value(*map, tag, &map_len);
     gt_assert(old_value);
@@ -337,5 +342,6 @@ int gt_tag_value_map_unit_test(GtError *err)
 void gt_tag_value_map_delete(GtTagValueMap map)
 {
   if (!map) return;
-  gt_free(map);
+  /* the map is empty if all tags have been removed */
+  gt_slab_class_free(map, *map == '\0' ? 1 : get_map_len(map) + 1);
 }
@@ -15,6 +15,8 @@
 */
 
 #include "core/class_alloc_lock.h"
+#include "core/ma.h"
+#include "core/thread_api.h"
 #include "extended/feature_node.h"
 #include "extended/node_stream_api.h"
 #include "extended/visitor_stream.h"
@@ -23,11 +25,53 @@ struct GtVisitorStream {
   const GtNodeStream parent_instance;
   GtNodeStream *in_stream;
   GtNodeVisitor *visitor;
+  GtVisitorStreamVisitNodesFunc visit_nodes;
+  GtGenomeNode **nodes;
+  GtUword batchsize,
+          numofnodes,
+          next_index;
 };
 
+/* The number of nodes visited in parallel per thread (batched mode). */
+#define GT_VISITOR_STREAM_NODESPERTHREAD  64UL
+
 #define visitor_stream_cast(GS)\
         gt_node_stream_cast(gt_visitor_stream_class(), GS)
 
+static int visitor_stream_next_batched(GtVisitorStream *visitor_stream,
+                                       GtGenomeNode **gn, GtError *err)
+{
+  int had_err = 0;
+  gt_error_check(err);
+  if (visitor_stream->next_index == visitor_stream->numofnodes) {
+    /* read and visit the next batch */
+    visitor_stream->numofnodes = visitor_stream->next_index = 0;
+    while (visitor_stream->numofnodes < visitor_stream->batchsize
+             && !(had_err = gt_node_stream_next(visitor_stream->in_stream, gn,
+                                                err))
+             && *gn != NULL) {
+      visitor_stream->nodes[visitor_stream->numofnodes++] = *gn;
+    }
+    if (!had_err) {
+      had_err = visitor_stream->visit_nodes(visitor_stream->visitor,
+                                            visitor_stream->nodes,
+                                            visitor_stream->numofnodes, err);
+    }
+    if (had_err) {
+      /* we own the nodes -> delete them */
+      while (visitor_stream->numofnodes > 0) {
+        gt_genome_node_delete(
+                          visitor_stream->nodes[--visitor_stream->numofnodes]);
+      }
+    }
+  }
+  if (!had_err && visitor_stream->next_index < visitor_stream->numofnodes)
+    *gn = visitor_stream->nodes[visitor_stream->next_index++];
+  else
+    *gn = NULL;
+  return had_err;
+}
+
 static int visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
                                GtError *err)
 {
@@ -35,6 +79,8 @@ static int visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
   int had_err;
   gt_error_check(err);
   visitor_stream = visitor_stream_cast(ns);
+  if (visitor_stream->visit_nodes)
+    return visitor_stream_next_batched(visitor_stream, gn, err);
   had_err = gt_node_stream_next(visitor_stream->in_stream, gn, err);
   if (!had_err && *gn)
     had_err = gt_genome_node_accept(*gn, visitor_stream->visitor, err);
@@ -49,6 +95,11 @@ static int visitor_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
 static void visitor_stream_free(GtNodeStream *ns)
 {
   GtVisitorStream *visitor_stream = visitor_stream_cast(ns);
+  while (visitor_stream->next_index < visitor_stream->numofnodes) {
+    gt_genome_node_delete(
+                         visitor_stream->nodes[visitor_stream->next_index++]);
+  }
+  gt_free(visitor_stream->nodes);
   gt_node_visitor_delete(visitor_stream->visitor);
   gt_node_stream_delete(visitor_stream->in_stream);
 }
@@ -76,5 +127,29 @@ GtNodeStream* gt_visitor_stream_new(GtNodeStream *in_stream,
   visitor_stream = visitor_stream_cast(ns);
   visitor_stream->in_stream = gt_node_stream_ref(in_stream);
   visitor_stream->visitor = visitor;
+  visitor_stream->visit_nodes = NULL;
+  visitor_stream->nodes = NULL;
+  visitor_stream->batchsize = visitor_stream->numofnodes =
+                              visitor_stream->next_index = 0;
+  return ns;
+}
+
+GtNodeStream* gt_visitor_stream_new_batched(GtNodeStream *in_stream,
+                                            GtNodeVisitor *visitor,
+                                            GtVisitorStreamVisitNodesFunc
+                                                                   visit_nodes)
+{
+  GtVisitorStream *visitor_stream;
+  GtNodeStream *ns;
+  gt_assert(in_stream && visitor && visit_nodes);
+  ns = gt_visitor_stream_new(in_stream, visitor);
+  visitor_stream = visitor_stream_cast(ns);
+  visitor_stream->visit_nodes = visit_nodes;
+  /* without multiple threads the nodes are passed on one by one */
+  visitor_stream->batchsize = gt_jobs > 1U
+                              ? GT_VISITOR_STREAM_NODESPERTHREAD * gt_jobs
+                              : 1UL;
+  visitor_stream->nodes = gt_malloc(sizeof *visitor_stream->nodes
+                                    * visitor_stream->batchsize);
   return ns;
 }
@@ -19,6 +19,21 @@
 
 #include "extended/visitor_stream_api.h"
 
+/* Visits the <numofnodes> <nodes> with <nv>, as if they were visited one after
+   another (e.g., by processing them in parallel). */
+typedef int (*GtVisitorStreamVisitNodesFunc)(GtNodeVisitor *nv,
+                                             GtGenomeNode **nodes,
+                                             GtUword numofnodes,
+                                             GtError *err);
+
 const GtNodeStreamClass* gt_visitor_stream_class(void);
 
+/* Like gt_visitor_stream_new(), but reads batches of up to 64 nodes per job
+   (see <gt_jobs>) from <in_stream> and visits each batch with <visit_nodes>.
+   The nodes are passed on in their original order. */
+GtNodeStream*            gt_visitor_stream_new_batched(GtNodeStream *in_stream,
+                                                       GtNodeVisitor *visitor,
+                                                 GtVisitorStreamVisitNodesFunc
+                                                                  visit_nodes);
+
 #endif
@@ -75,6 +75,7 @@ extern "C" {
 #include "core/seq_iterator_fastq_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/splitter_api.h"
+#include "core/static_interval_tree_api.h"
 #include "core/str_api.h"
 #include "core/str_array_api.h"
 #include "core/strand_api.h"
@@ -106,6 +107,7 @@ extern "C" {
 #include "extended/eof_node_api.h"
 #include "extended/extract_feature_stream_api.h"
 #include "extended/feature_index_api.h"
+#include "extended/feature_index_disk_api.h"
 #include "extended/feature_index_memory_api.h"
 #include "extended/feature_in_stream_api.h"
 #include "extended/feature_node_api.h"
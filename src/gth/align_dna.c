@@ -16,7 +16,13 @@
 */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -46,16 +52,121 @@ static const char* dna_showretracenames(DnaRetrace retrace)
   return dna_retracenames[retrace];
 }
 
-/* the following function allocates space for the DP tables for cDNAs/ESTs */
+/* the following function resets the first row of the backtrace table and the
+   score, intronstart, and exonstart tables to their initial values */
+static void dp_matrix_reset(GthDPMatrix *dpm)
+{
+  GtUword n, m;
+
+  dpm->path[0][0]  = DNA_E_NM;
+  dpm->path[0][0] |= I_STATE_E_N;
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->path[0][m]  = DNA_E_M;
+    dpm->path[0][m] |= I_STATE_I_N;
+  }
+
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
+    dpm->score[DNA_E_STATE][n][0] = 0.0;
+    dpm->score[DNA_I_STATE][n][0] = 0.0;
+
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
+      /* disallow intron status for 5' non-matching cDNA letters: */
+      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
+    }
+
+    memset(dpm->intronstart[n], 0,
+           sizeof *dpm->intronstart[n] * (dpm->ref_dp_length + 1));
+    memset(dpm->exonstart[n], 0,
+           sizeof *dpm->exonstart[n] * (dpm->ref_dp_length + 1));
+  }
+}
+
+static void dp_matrix_checkpoints_delete(GthDPMatrixCheckpoints *cp)
+{
+  GtUword t;
+  if (!cp) return;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++)
+    free(cp->score[t]);
+  free(cp->intronstart);
+  free(cp->exonstart);
+  gt_free(cp);
+}
+
+/* the following function allocates a backtrace table which keeps only the rows
+   of one block together with the checkpoints necessary to recompute the other
+   blocks. The number of rows per block is chosen such that the total space is
+   minimal, it grows with the square root of <gen_dp_length>. Returns the size
+   of the allocated space in bytes, or 0 if the space could not be allocated or
+   if a complete backtrace table would not be larger. */
+static GtUword dp_matrix_init_checkpoints(GthDPMatrix *dpm,
+                                          GtUword gen_dp_length,
+                                          GtUword ref_dp_length)
+{
+  GthDPMatrixCheckpoints *cp;
+  GtUword t, checkpointsize, numofcheckpoints;
+  bool allocated = true;
+
+  /* a checkpoint takes <checkpointsize> bytes per column, a row of the
+     backtrace table half a byte */
+  checkpointsize = DNA_NUMOFSTATES * sizeof (GthFlt) + 2 * sizeof (GtUword);
+  cp = gt_malloc(sizeof *cp);
+  cp->blockrows = (GtUword) ceil(sqrt(2.0 * checkpointsize *
+                                      (gen_dp_length + 1)));
+  /* blocks must start at even rows, because two rows share one byte */
+  cp->blockrows += GT_MOD2(cp->blockrows);
+  if (cp->blockrows > gen_dp_length) {
+    gt_free(cp);
+    return 0;
+  }
+  cp->numofblocks = (gen_dp_length + cp->blockrows) / cp->blockrows;
+  /* after the DP the backtrace table contains the last block */
+  cp->currentblock = gen_dp_length / cp->blockrows;
+  cp->store = true;
+  numofcheckpoints = cp->numofblocks - 1;
+
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    cp->score[t] = malloc(sizeof (GthFlt) * numofcheckpoints *
+                          (ref_dp_length + 1));
+    allocated = allocated && cp->score[t];
+  }
+  cp->intronstart = malloc(sizeof (GtUword) * numofcheckpoints *
+                           (ref_dp_length + 1));
+  cp->exonstart = malloc(sizeof (GtUword) * numofcheckpoints *
+                         (ref_dp_length + 1));
+  gth_array2dim_plain_malloc_cyclic(dpm->path,
+                                    GT_DIV2(gen_dp_length + 1) +
+                                    GT_MOD2(gen_dp_length + 1),
+                                    GT_DIV2(cp->blockrows), ref_dp_length + 1);
+  if (!allocated || !cp->intronstart || !cp->exonstart || !dpm->path) {
+    if (dpm->path) {
+      gth_array2dim_plain_delete(dpm->path);
+      dpm->path = NULL;
+    }
+    dp_matrix_checkpoints_delete(cp);
+    return 0;
+  }
+  dpm->checkpoints = cp;
+
+  return GT_DIV2(cp->blockrows) * (ref_dp_length + 1) +
+         checkpointsize * numofcheckpoints * (ref_dp_length + 1);
+}
+
+/* the following function allocates space for the DP tables for cDNAs/ESTs.
+   If the backtrace table would be larger than <maxbtmatrixsize> megabytes (if
+   <maxbtmatrixsize> is not 0) or cannot be allocated, a backtrace table with
+   checkpoints is used instead (except for the jump table case). */
 static int dp_matrix_init(GthDPMatrix *dpm,
                           GtUword gen_dp_length,
                           GtUword ref_dp_length,
                           GtUword autoicmaxmatrixsize,
                           bool introncutout,
                           GthJumpTable *jump_table,
+                          GtUword maxbtmatrixsize,
                           GthStat *stat)
 {
-  GtUword t, n, m, matrixsize, sizeofpathtype =  sizeof (GthPath);
+  GtUword t, n, matrixsize, sizeofpathtype =  sizeof (GthPath),
+          allocatedsize = 0;
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
   if (DNA_NUMOFSTATES * sizeofpathtype * (gen_dp_length + 1) >=
@@ -80,17 +191,33 @@ static int dp_matrix_init(GthDPMatrix *dpm,
   }
 
   /* allocate space for dpm->path */
-  if (jump_table) {
-    gth_array2dim_plain_calloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+  dpm->path = NULL;
+  dpm->path_jt = NULL;
+  dpm->checkpoints = NULL;
+  if (!jump_table && maxbtmatrixsize > 0 &&
+      sizeofpathtype * matrixsize > maxbtmatrixsize << 20) {
+    allocatedsize = dp_matrix_init_checkpoints(dpm, gen_dp_length,
+                                               ref_dp_length);
   }
-  else {
-    gth_array2dim_plain_malloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+  if (!dpm->path) {
+    if (jump_table) {
+      gth_array2dim_plain_calloc(dpm->path,
+                                 GT_DIV2(gen_dp_length + 1) +
+                                 GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+    }
+    else {
+      gth_array2dim_plain_malloc(dpm->path,
+                                 GT_DIV2(gen_dp_length + 1) +
+                                 GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+      if (!dpm->path) {
+        /* the complete backtrace table does not fit into memory */
+        allocatedsize = dp_matrix_init_checkpoints(dpm, gen_dp_length,
+                                                   ref_dp_length);
+      }
+    }
+    if (dpm->path && !dpm->checkpoints)
+      allocatedsize = sizeofpathtype * matrixsize;
   }
-  dpm->path_jt = NULL;
   if (!dpm->path)
     return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
 
@@ -103,40 +230,48 @@ static int dp_matrix_init(GthDPMatrix *dpm,
 
   /* allocating space for intronstart and exonstart */
   for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->intronstart[n] = gt_calloc(ref_dp_length + 1,
-                                    sizeof *dpm->intronstart);
-    dpm->exonstart[n] = gt_calloc(ref_dp_length + 1, sizeof *dpm->exonstart);
-  }
-
-  /* initialize the DP matrices */
-  dpm->path[0][0]  = DNA_E_NM;
-  dpm->path[0][0] |= I_STATE_E_N;
-  for (m = 1; m <= ref_dp_length; m++) {
-    dpm->path[0][m]  = DNA_E_M;
-    dpm->path[0][m] |= I_STATE_I_N;
+    dpm->intronstart[n] = gt_malloc(sizeof *dpm->intronstart[n] *
+                                    (ref_dp_length + 1));
+    dpm->exonstart[n] = gt_malloc(sizeof *dpm->exonstart[n] *
+                                  (ref_dp_length + 1));
   }
 
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->score[DNA_E_STATE][n][0] = 0.0;
-    dpm->score[DNA_I_STATE][n][0] = 0.0;
-
-    for (m = 1; m <= ref_dp_length; m++) {
-      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
-      /* disallow intron status for 5' non-matching cDNA letters: */
-      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
-    }
-  }
   dpm->gen_dp_length = gen_dp_length;
   dpm->ref_dp_length = ref_dp_length;
 
+  /* initialize the DP matrices */
+  dp_matrix_reset(dpm);
+
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
-  gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
-                                           (sizeofpathtype * matrixsize) >> 20);
+  gth_stat_increase_totalsizeofbacktracematricesinMB(stat, allocatedsize >> 20);
 
   return 0;
 }
 
+/* the following function stores the checkpoint for row <n>, if row <n> is the
+   last row of a block (but not of the last block) */
+static void dp_matrix_store_checkpoint(GthDPMatrix *dpm, GtUword n)
+{
+  GthDPMatrixCheckpoints *cp = dpm->checkpoints;
+  GtUword t, block, offset, rowsize = dpm->ref_dp_length + 1;
+
+  if (!cp->store || (n + 1) % cp->blockrows)
+    return;
+  block = (n + 1) / cp->blockrows;
+  if (block == cp->numofblocks)
+    return;
+  offset = (block - 1) * rowsize;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    memcpy(cp->score[t] + offset, dpm->score[t][GT_MOD2(n)],
+           sizeof (GthFlt) * rowsize);
+  }
+  memcpy(cp->intronstart + offset, dpm->intronstart[GT_MOD2(n)],
+         sizeof (GtUword) * rowsize);
+  memcpy(cp->exonstart + offset, dpm->exonstart[GT_MOD2(n)],
+         sizeof (GtUword) * rowsize);
+}
+
 #if 0
 static GtUword dp_matrix_get_reference_length(DPMatrix *dpm)
 {
@@ -275,11 +410,99 @@ static void I_1m(GthDPMatrix *dpm, GtUword m, GthDbl log_1minusprobies)
   }
 }
 
-/* the following function evaluate the dynamic programming tables */
+/* the following function evaluates the column parallel part of the DP
+   recurrences of <row> for the columns <mstart> to <ref_dp_length> */
+static void dna_row_scalar(GthDPRowDNA *row, GtUword mstart)
+{
+  GthFlt value, maxvalue;
+  GthPath retrace;
+  GthDbl rval;
+  GtUword m, n = row->n;
+
+  /* evaluate I_nm */
+  for (m = mstart; m <= row->ref_dp_length; m++) {
+    /* 0. */
+    maxvalue = row->E_prev[m] + row->I_E_weight;
+    if (n - row->exonstart_prev[m] < row->dpminexonlength)
+       maxvalue -= row->shortexonpenalty;
+    retrace  = I_STATE_E_N;
+
+    /* 1. */
+    value = row->I_prev[m];
+    if (row->I_I_weighted && m < row->ref_dp_length)
+      value += row->I_I_weight;
+    UPDATEMAX(I_STATE_I_N);
+
+    /* save maximum values */
+    row->I_cur[m] = maxvalue;
+    row->I_retrace[m] = retrace;
+
+    switch (retrace) {
+     case I_STATE_E_N:
+        /* begin of a new intron */
+        row->intronstart_cur[m] = n;
+        break;
+      case I_STATE_I_N:
+        /* continue existing intron */
+        row->intronstart_cur[m] = row->intronstart_prev[m];
+        break;
+      default: gt_assert(0);
+    }
+  }
+
+  /* evaluate E_nm, except for the transitions DNA_E_M and DNA_I_M */
+  for (m = mstart; m <= row->ref_dp_length; m++) {
+    /* 0. */
+    rval = row->E_NM_weight + row->matchweight[m] - row->matchweight_half[m];
+    maxvalue = (GthFlt) (row->E_prev[m-1] + rval);
+    retrace  = DNA_E_NM;
+
+    /* 1. */
+    rval = row->I_NM_weight + row->matchweight[m] - row->matchweight_half[m];
+    value = (GthFlt) (row->I_prev[m-1] + rval);
+    /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
+    if (n - row->intronstart_prev[m-1] < row->dpminintronlength)
+      value -= row->shortintronpenalty;
+    UPDATEMAX(DNA_I_NM);
+
+    /* 2. */
+    rval = m < row->ref_dp_length ? row->E_N_weight : row->E_N_weight_last;
+    value = (GthFlt) (row->E_prev[m] + rval);
+    UPDATEMAX(DNA_E_N);
+
+    /* 3. */
+    rval = m < row->ref_dp_length ? row->I_N_weight : row->I_N_weight_last;
+    value = (GthFlt) (row->I_prev[m] + rval);
+    /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
+    if (n - row->intronstart_prev[m] < row->dpminintronlength)
+      value -= row->shortintronpenalty;
+    UPDATEMAX(DNA_I_N);
+
+    row->E_max[m] = maxvalue;
+    row->E_retrace[m] = retrace;
+
+    /* 5. */
+    rval = row->I_M_weight;
+    if (!row->last)
+      rval += row->dashweight[m];
+    value = (GthFlt) (row->I_cur[m-1] + rval);
+    /* intron from intronstart to n => n - intronstart + 1 */
+    if (n - row->intronstart_cur[m-1] + 1 < row->dpminintronlength)
+      value -= row->shortintronpenalty;
+    row->E_I_M[m] = value;
+  }
+}
+
+/* the following function evaluate the dynamic programming tables for the rows
+   <genomic_offset> + 1 to <genomic_end>. Every row is evaluated in two steps:
+   first everything which does not depend on other columns of the same row
+   (with the vectorized kernel <dp_options_core->dpkernel>, if possible), then
+   the remaining DNA_E_M transition column by column. */
 static void dna_complete_path_matrix(GthDPMatrix *dpm,
                                      const unsigned char *gen_seq_tran,
                                      const unsigned char *ref_seq_tran,
                                      GtUword genomic_offset,
+                                     GtUword genomic_end,
                                      GtAlphabet *gen_alphabet,
                                      GthDPParam *dp_param,
                                      GthDPOptionsEST *dp_options_est,
@@ -288,29 +511,59 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
   GthFlt value, maxvalue;
   GthPath retrace;
   GtUword n, m, modn, modnminus1;
-  GthDbl rval, outputweight, **outputweights,
+  GthDbl rval, outputweight, genomicdashweight, *dashweight,
+         *matchweight[UCHAR_MAX+1], *matchweight_half[UCHAR_MAX+1],
          log_probies,          /* initial exon state probability */
          log_1minusprobies;    /* initial intron state probability */
   GthFlt log_probdelgen,       /* deletion in genomic sequence */
          log_1minusprobdelgen;
   unsigned char genomicchar, referencechar;
   unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
+  GthDPRowDNAFunc row_func = gth_dp_kernel_row_dna(dp_options_core->dpkernel);
+  GthDPRowDNA row;
 
   gt_assert(dpm->gen_dp_length > 1);
+  gt_assert(genomic_offset < genomic_end &&
+            genomic_end <= dpm->gen_dp_length);
+
+  if (dpm->checkpoints && dpm->checkpoints->store) {
+    /* remember the input to recompute blocks during the backtracing */
+    dpm->checkpoints->gen_seq_tran = gen_seq_tran;
+    dpm->checkpoints->ref_seq_tran = ref_seq_tran;
+    dpm->checkpoints->gen_alphabet = gen_alphabet;
+    dpm->checkpoints->dp_param = dp_param;
+    dpm->checkpoints->dp_options_est = dp_options_est;
+    dpm->checkpoints->dp_options_core = dp_options_core;
+  }
 
   log_probies = (GthDbl) log((double) dp_options_est->probies);
   log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
   log_probdelgen = (GthFlt) log((double) dp_options_est->probdelgen);
   log_1minusprobdelgen = (GthFlt) log(1.0 - dp_options_est->probdelgen);
 
-  /* precompute outputweights
-     XXX: move this to somewhere else, maybe make it smaller */
-  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
-  for (n = 0; n <= UCHAR_MAX; n++) {
-    for (m = 0; m <= UCHAR_MAX; m++) {
-      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
-    }
+  /* precompute the output weights of the columns for deletions in the genomic
+     sequence, the output weights for the genomic characters are computed on
+     demand */
+  dashweight = gt_malloc(sizeof *dashweight * (dpm->ref_dp_length + 1));
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dashweight[m] = 0.0;
+    ADDOUTPUTWEIGHT(dashweight[m], (unsigned char) DASH, ref_seq_tran[m-1]);
   }
+  memset(matchweight, 0, sizeof matchweight);
+  memset(matchweight_half, 0, sizeof matchweight_half);
+
+  /* setup the row */
+  row.ref_dp_length = dpm->ref_dp_length;
+  row.dpminexonlength = dp_options_core->dpminexonlength;
+  row.dpminintronlength = dp_options_core->dpminintronlength;
+  row.shortexonpenalty = dp_options_core->shortexonpenalty;
+  row.shortintronpenalty = dp_options_core->shortintronpenalty;
+  row.I_I_weighted = !dp_options_core->freeintrontrans;
+  row.dashweight = dashweight;
+  row.E_max = gt_malloc(sizeof *row.E_max * (dpm->ref_dp_length + 1));
+  row.E_I_M = gt_malloc(sizeof *row.E_I_M * (dpm->ref_dp_length + 1));
+  row.E_retrace = gt_malloc(sizeof *row.E_retrace * (dpm->ref_dp_length + 1));
+  row.I_retrace = gt_malloc(sizeof *row.I_retrace * (dpm->ref_dp_length + 1));
 
   if (!genomic_offset) {
     /* handle case for n equals 1 */
@@ -323,6 +576,8 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
            dp_options_est, dp_options_core);
       I_1m(dpm, m, log_1minusprobies);
     }
+    if (dpm->checkpoints)
+      dp_matrix_store_checkpoint(dpm, 1);
   }
 
   /* handle all other n's
@@ -332,7 +587,7 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
   else
     n = 2;
 
-  for (; n <= dpm->gen_dp_length; n++) {
+  for (; n <= genomic_end; n++) {
     modn = GT_MOD2(n);
     modnminus1 = GT_MOD2(n-1);
     genomicchar = gen_seq_tran[n-1];
@@ -346,93 +601,86 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
       dpm->path[GT_DIV2(n)][0] |= I_STATE_I_N;
     }
 
-    /* stepping along the cDNA/EST sequence */
-    for (m = 1; m <= dpm->ref_dp_length; m++) {
-      referencechar = ref_seq_tran[m-1];
-
-      /* evaluate E_nm */
-
-      /* 0. */
-      outputweight = 0.0;
-      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      rval += outputweights[genomicchar][referencechar];
-      if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
-        rval -= (outputweight / 2.0);
-      }
-      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
-      retrace  = DNA_E_NM;
-
-      /* 1. */
-      outputweight = 0.0;
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      rval += outputweights[genomicchar][referencechar];
-      if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
-        rval -= (outputweight / 2.0);
-      }
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
-      /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m - 1] <
-          dp_options_core->dpminintronlength) {
-        value -= dp_options_core->shortintronpenalty;
+    if (!matchweight[genomicchar]) {
+      matchweight[genomicchar] = gt_malloc(sizeof (GthDbl) *
+                                           (dpm->ref_dp_length + 1));
+      matchweight_half[genomicchar] = gt_malloc(sizeof (GthDbl) *
+                                                (dpm->ref_dp_length + 1));
+      for (m = 1; m <= dpm->ref_dp_length; m++) {
+        referencechar = ref_seq_tran[m-1];
+        rval = 0.0;
+        ADDOUTPUTWEIGHT(rval, genomicchar, referencechar);
+        matchweight[genomicchar][m] = rval;
+        outputweight = 0.0;
+        if ((m < dp_options_est->wdecreasedoutput ||
+             m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
+             genomicchar == referencechar) {
+          outputweight += rval;
+          outputweight /= 2.0;
+        }
+        matchweight_half[genomicchar][m] = outputweight;
       }
-      UPDATEMAX(DNA_I_NM);
+    }
+    genomicdashweight = 0.0;
+    ADDOUTPUTWEIGHT(genomicdashweight, genomicchar, (unsigned char) DASH);
+
+    /* setup the row */
+    row.n = n;
+    row.last = n == dpm->gen_dp_length;
+    row.E_NM_weight = (GthDbl) (log_1minusprobdelgen +
+                                dp_param->log_1minusPdonor[n-1]);
+    row.I_NM_weight = (GthDbl) (dp_param->log_Pacceptor[n-2] +
+                                log_1minusprobdelgen);
+    rval = 0.0;
+    rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
+    row.E_N_weight = rval + genomicdashweight;
+    row.E_N_weight_last = n < dp_options_est->wzerotransition ? rval : 0.0;
+    row.I_N_weight = row.I_NM_weight + genomicdashweight;
+    row.I_N_weight_last = row.I_NM_weight;
+    row.I_M_weight = 0.0;
+    if (!row.last)
+      row.I_M_weight += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
+    row.I_E_weight = log_1minusprobdelgen + dp_param->log_Pdonor[n-1];
+    row.I_I_weight = dp_param->log_1minusPacceptor[n-2];
+    row.matchweight = matchweight[genomicchar];
+    row.matchweight_half = matchweight_half[genomicchar];
+    row.E_prev = dpm->score[DNA_E_STATE][modnminus1];
+    row.I_prev = dpm->score[DNA_I_STATE][modnminus1];
+    row.intronstart_prev = dpm->intronstart[modnminus1];
+    row.exonstart_prev = dpm->exonstart[modnminus1];
+    row.I_cur = dpm->score[DNA_I_STATE][modn];
+    row.intronstart_cur = dpm->intronstart[modn];
+
+    /* evaluate everything except for the transition DNA_E_M */
+    m = 1;
+    if (row_func && !row.last)
+      m = row_func(&row);
+    dna_row_scalar(&row, m);
 
-      /* 2. */
-      rval = 0.0;
-      if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
-        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
-      UPDATEMAX(DNA_E_N);
-
-      /* 3. */
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
-      /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m] <
-          dp_options_core->dpminintronlength) {
-        value -= dp_options_core->shortintronpenalty;
-      }
-      UPDATEMAX(DNA_I_N);
+    /* stepping along the cDNA/EST sequence */
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      maxvalue = row.E_max[m];
+      retrace = row.E_retrace[m];
 
       /* 4. */
       rval = 0.0;
       if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
         rval = (GthDbl) log_probdelgen;
       if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
+        rval += dashweight[m];
       value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
       UPDATEMAX(DNA_E_M);
 
       /* 5. */
-      rval = 0.0;
-      if (n < dpm->gen_dp_length)
-       rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
-      if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
-      /* intron from intronstart to n => n - intronstart + 1 */
-      if (n - dpm->intronstart[modn][m - 1] + 1 <
-          dp_options_core->dpminintronlength) {
-        value -= dp_options_core->shortintronpenalty;
-      }
+      value = row.E_I_M[m];
       UPDATEMAX(DNA_I_M);
 
       /* save maximum values */
       dpm->score[DNA_E_STATE][modn][m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        dpm->path[GT_DIV2(n)][m] |= (retrace | row.I_retrace[m]) << 4;
       else
-        dpm->path[GT_DIV2(n)][m]  = retrace;
+        dpm->path[GT_DIV2(n)][m]  = retrace | row.I_retrace[m];
 
       switch (retrace) {
         case DNA_I_NM:
@@ -451,47 +699,62 @@ static void dna_complete_path_matrix(GthDPMatrix *dpm,
           break;
         default: gt_assert(0);
       }
+    }
 
-      /* evaluate I_nm */
-
-      /* 0. */
-      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
-                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
-      if (n - dpm->exonstart[modnminus1][m]
-          < dp_options_core->dpminexonlength) {
-         maxvalue -= dp_options_core->shortexonpenalty;
-      }
-      retrace  = I_STATE_E_N;
+    if (dpm->checkpoints)
+      dp_matrix_store_checkpoint(dpm, n);
+  }
 
-      /* 1. */
-      value = dpm->score[DNA_I_STATE][modnminus1][m];
-      if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
-        value += dp_param->log_1minusPacceptor[n-2];
-      UPDATEMAX(I_STATE_I_N);
+  /* free space  */
+  for (m = 0; m <= UCHAR_MAX; m++) {
+    gt_free(matchweight[m]);
+    gt_free(matchweight_half[m]);
+  }
+  gt_free(dashweight);
+  gt_free(row.E_max);
+  gt_free(row.E_I_M);
+  gt_free(row.E_retrace);
+  gt_free(row.I_retrace);
+}
 
-      /* save maximum values */
-      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
-      if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
-      else
-        dpm->path[GT_DIV2(n)][m] |= retrace;
+/* the following function recomputes the block of the backtrace table which
+   contains row <genptr>, if it is not the current one. Since the backtracing
+   moves from the last row to the first one, every block is recomputed at most
+   once. */
+static void dna_complete_path_matrix_block(GthDPMatrix *dpm, GtUword genptr)
+{
+  GthDPMatrixCheckpoints *cp = dpm->checkpoints;
+  GtUword t, block, first, offset, modn, rowsize = dpm->ref_dp_length + 1;
 
-      switch (retrace) {
-       case I_STATE_E_N:
-          /* begin of a new intron */
-          dpm->intronstart[modn][m] = n;
-          break;
-        case I_STATE_I_N:
-          /* continue existing intron */
-          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
-          break;
-        default: gt_assert(0);
-      }
+  block = genptr / cp->blockrows;
+  if (block == cp->currentblock)
+    return;
+  gt_assert(block < cp->currentblock);
+  cp->store = false;
+  first = block * cp->blockrows;
+
+  if (block) {
+    /* restore the DP state of the row before the block from its checkpoint */
+    offset = (block - 1) * rowsize;
+    modn = GT_MOD2(first - 1);
+    for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+      memcpy(dpm->score[t][modn], cp->score[t] + offset,
+             sizeof (GthFlt) * rowsize);
     }
+    memcpy(dpm->intronstart[modn], cp->intronstart + offset,
+           sizeof (GtUword) * rowsize);
+    memcpy(dpm->exonstart[modn], cp->exonstart + offset,
+           sizeof (GtUword) * rowsize);
   }
-
-  /* free space  */
-  gt_array2dim_delete(outputweights);
+  else
+    dp_matrix_reset(dpm);
+
+  dna_complete_path_matrix(dpm, cp->gen_seq_tran, cp->ref_seq_tran,
+                           block ? first - 1 : 0,
+                           MIN(first + cp->blockrows - 1, dpm->gen_dp_length),
+                           cp->gen_alphabet, cp->dp_param, cp->dp_options_est,
+                           cp->dp_options_core);
+  cp->currentblock = block;
 }
 
 static void dna_include_exon(GthBacktracePath *backtrace_path,
@@ -539,6 +802,9 @@ static int dna_evaltracepath(GthBacktracePath *backtrace_path, GthDPMatrix *dpm,
   gt_assert(!gth_backtrace_path_length(backtrace_path));
 
   while ((genptr > 0) || (refptr > 0)) {
+    if (dpm->checkpoints)
+      dna_complete_path_matrix_block(dpm, genptr);
+
     /* here we map the quarter matrix bitvector stuff back on the simple Retrace
        types.  Thereby, no further changes on the backtracing procedure are
        necessary. */
@@ -764,6 +1030,7 @@ static void dp_matrix_free(GthDPMatrix *dpm)
   gth_array2dim_plain_delete(dpm->path);
   if (dpm->path_jt)
     gt_array2dim_delete(dpm->path_jt);
+  dp_matrix_checkpoints_delete(dpm->checkpoints);
 }
 
 #if 0
@@ -997,7 +1264,8 @@ static void detect_small_terminal_exons(GthSA *sa,
   }
 
   if (dp_matrix_init(&dpm_terminal, gen_dp_length_terminal,
-                     ref_dp_length_terminal, 0, false, NULL, stat)) {
+                     ref_dp_length_terminal, 0, false, NULL,
+                     dp_options_core->maxbtmatrixsize, stat)) {
     /* out of memory */
     return;
   }
@@ -1030,7 +1298,7 @@ static void detect_small_terminal_exons(GthSA *sa,
                            gen_seq_tran + gen_dp_start_terminal,
                           ref_seq_tran + ref_dp_length - ref_dp_length_terminal,
                            /*gth_sa_genomiccutoff_end(sa), */
-                           0,
+                           0, gen_dp_length_terminal,
                            gen_alphabet,
                            dp_param_terminal, dp_options_est_terminal,
                            dp_options_core_terminal);
@@ -1135,7 +1403,8 @@ static void detect_small_initial_exons(GthSA *sa,
             gen_seq_bounds->end);
 
   if (dp_matrix_init(&dpm_initial, gen_dp_length_initial,
-                     ref_dp_length_initial, 0, false, NULL, stat)) {
+                     ref_dp_length_initial, 0, false, NULL,
+                     dp_options_core->maxbtmatrixsize, stat)) {
     /* out of memory */
     return;
   }
@@ -1152,7 +1421,8 @@ static void detect_small_initial_exons(GthSA *sa,
   }
   dna_complete_path_matrix(&dpm_initial,
                            gen_seq_tran + gen_dp_start_initial, ref_seq_tran, 0,
-                           gen_alphabet, dp_param_initial, dp_options_est,
+                           gen_dp_length_initial, gen_alphabet,
+                           dp_param_initial, dp_options_est,
                            dp_options_core);
   backtrace_path = gth_backtrace_path_new(gen_dp_start_initial,
                                           gen_dp_length_initial,
@@ -1273,7 +1543,8 @@ int gth_align_dna(GthSA *sa,
                              introncutout ? spliced_seq->splicedseqlen
                                           : gen_dp_length,
                              ref_dp_length, autoicmaxmatrixsize, introncutout,
-                             jump_table, stat))) {
+                             jump_table, dp_options_core->maxbtmatrixsize,
+                             stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     return rval;
@@ -1294,12 +1565,12 @@ int gth_align_dna(GthSA *sa,
     dna_complete_path_matrix(&dpm,
                              introncutout ? spliced_seq->splicedseq
                                           : gen_seq_tran + gen_dp_start,
-                             ref_seq_tran, 0, gen_alphabet, dp_param,
-                             dp_options_est, dp_options_core);
+                             ref_seq_tran, 0, dpm.gen_dp_length, gen_alphabet,
+                             dp_param, dp_options_est, dp_options_core);
   }
 
   /* debugging */
-  if (!dpm.path_jt &&
+  if (!dpm.path_jt && !dpm.checkpoints &&
       dp_options_core->btmatrixgenrange.start != GT_UNDEF_UWORD) {
     pm = gth_path_matrix_new(dpm.path, dpm.gen_dp_length, dpm.ref_dp_length,
                              &dp_options_core->btmatrixgenrange,
@@ -1380,6 +1651,48 @@ int gth_align_dna(GthSA *sa,
   return 0;
 }
 
+int gth_align_dna_fill(GtArray *gen_ranges,
+                       const unsigned char *gen_seq_tran,
+                       const unsigned char *ref_seq_tran,
+                       GtUword ref_dp_length,
+                       GtAlphabet *gen_alphabet,
+                       const GtRange *gen_seq_bounds,
+                       GthSpliceSiteModel *splice_site_model,
+                       GthDPOptionsCore *dp_options_core,
+                       GthDPOptionsEST *dp_options_est,
+                       GthStat *stat)
+{
+  GtUword gen_dp_start, gen_dp_end, gen_dp_length;
+  GthDPParam *dp_param;
+  GthDPMatrix dpm;
+  int rval;
+
+  gt_assert(gen_ranges);
+
+  gen_dp_start  = ((GtRange*) gt_array_get_first(gen_ranges))->start;
+  gen_dp_end    = ((GtRange*) gt_array_get_last(gen_ranges))->end;
+  gt_assert(gen_dp_start <= gen_dp_end);
+  gen_dp_length = gen_dp_end - gen_dp_start + 1;
+  dp_param = gth_dp_param_new(gen_ranges, gen_seq_tran, gen_seq_bounds,
+                              splice_site_model, gen_alphabet);
+  if (!dp_param)
+    return GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED;
+  if ((rval = dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, false,
+                             NULL, dp_options_core->maxbtmatrixsize, stat))) {
+    gth_dp_param_delete(dp_param);
+    return rval;
+  }
+
+  dna_complete_path_matrix(&dpm, gen_seq_tran + gen_dp_start, ref_seq_tran, 0,
+                           dpm.gen_dp_length, gen_alphabet, dp_param,
+                           dp_options_est, dp_options_core);
+
+  dp_matrix_free(&dpm);
+  gth_dp_param_delete(dp_param);
+
+  return 0;
+}
+
 GthSA* gth_align_dna_simple(GthInput *input,
                             const GtRange *gen_range,
                             GtUword gen_file_num,
@@ -1454,3 +1767,251 @@ GthSA* gth_align_dna_simple(GthInput *input,
   gth_dp_options_core_delete(dp_options_core);
   return sa;
 }
+
+#define GTH_ALIGN_DNA_TEST_FLANKLENGTH     300
+#define GTH_ALIGN_DNA_TEST_EXONLENGTH      200
+#define GTH_ALIGN_DNA_TEST_INTRONLENGTH    1400
+#define GTH_ALIGN_DNA_TEST_NUMOFEXONS      3
+#define GTH_ALIGN_DNA_TEST_MAXSHORTLENGTH  40
+
+/* compute the backtrace path of <gen_seq_tran> and <ref_seq_tran> with a
+   backtrace table of at most <maxbtmatrixsize> megabytes and the DP kernel
+   <kernel> */
+static int dna_test_backtrace(GthBacktracePath *backtrace_path,
+                              const GtUchar *gen_seq_tran,
+                              GtUword gen_dp_length,
+                              const GtUchar *ref_seq_tran,
+                              GtUword ref_dp_length,
+                              GtAlphabet *gen_alphabet,
+                              GtUword maxbtmatrixsize, GthDPKernel kernel,
+                              bool *checkpoints, GthFlt *score)
+{
+  GthSpliceSiteModel *splice_site_model;
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GthDPParam *dp_param;
+  GthStat *stat;
+  GtArray *gen_ranges;
+  GtRange range;
+  GthDPMatrix dpm;
+  int rval;
+
+  splice_site_model = gth_splice_site_model_new();
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_core->maxbtmatrixsize = maxbtmatrixsize;
+  dp_options_core->dpkernel = kernel;
+  dp_options_est = gth_dp_options_est_new();
+  stat = gth_stat_new();
+  range.start = 0;
+  range.end = gen_dp_length - 1;
+  gen_ranges = gt_array_new(sizeof (GtRange));
+  gt_array_add(gen_ranges, range);
+
+  dp_param = gth_dp_param_new(gen_ranges, gen_seq_tran, &range,
+                              splice_site_model, gen_alphabet);
+  gt_assert(dp_param);
+  rval = dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, false, NULL,
+                        maxbtmatrixsize, stat);
+  gt_assert(!rval);
+  *checkpoints = dpm.checkpoints ? true : false;
+  dna_complete_path_matrix(&dpm, gen_seq_tran, ref_seq_tran, 0,
+                           dpm.gen_dp_length, gen_alphabet, dp_param,
+                           dp_options_est, dp_options_core);
+  *score = dpm.score[DNA_E_STATE][GT_MOD2(gen_dp_length)][ref_dp_length];
+  gth_backtrace_path_set_alphatype(backtrace_path, DNA_ALPHA);
+  rval = dna_find_optimal_path(backtrace_path, &dpm, ref_seq_tran,
+                               gen_seq_tran, false, NULL, false,
+                               dp_options_core->noicinintroncheck, false, NULL,
+                               NULL);
+
+  dp_matrix_free(&dpm);
+  gth_dp_param_delete(dp_param);
+  gt_array_delete(gen_ranges);
+  gth_stat_delete(stat);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  gth_splice_site_model_delete(splice_site_model);
+  return rval;
+}
+
+/* align <gen_seq_tran> and <ref_seq_tran> once with the complete backtrace
+   table and once with a backtrace table limited to one megabyte, which is
+   small enough to force the checkpointed backtrace */
+static int dna_test_compare_backtraces(const GtUchar *gen_seq_tran,
+                                       GtUword gen_dp_length,
+                                       const GtUchar *ref_seq_tran,
+                                       GtUword ref_dp_length,
+                                       GtAlphabet *gen_alphabet, GtError *err)
+{
+  GthBacktracePath *full, *limited;
+  bool checkpoints;
+  GthFlt full_score, limited_score;
+  int had_err = 0;
+  gt_error_check(err);
+
+  full = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  limited = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  gt_ensure(!dna_test_backtrace(full, gen_seq_tran, gen_dp_length,
+                                ref_seq_tran, ref_dp_length, gen_alphabet, 0,
+                                gth_dp_kernel_best(), &checkpoints,
+                                &full_score));
+  gt_ensure(!checkpoints);
+  if (!had_err) {
+    gt_ensure(!dna_test_backtrace(limited, gen_seq_tran, gen_dp_length,
+                                  ref_seq_tran, ref_dp_length, gen_alphabet, 1,
+                                  gth_dp_kernel_best(), &checkpoints,
+                                  &limited_score));
+    gt_ensure(checkpoints);
+  }
+  gt_ensure(full_score == limited_score);
+  gt_ensure(gth_backtrace_path_length(full) > 0);
+  gt_ensure(gth_backtrace_path_length(full) ==
+            gth_backtrace_path_length(limited));
+  gt_ensure(!memcmp(gth_backtrace_path_get(full),
+                    gth_backtrace_path_get(limited),
+                    sizeof (Editoperation) * gth_backtrace_path_length(full)));
+  gth_backtrace_path_delete(limited);
+  gth_backtrace_path_delete(full);
+  return had_err;
+}
+
+/* align <gen_seq_tran> and <ref_seq_tran> with every vectorized DP kernel
+   supported by the CPU and compare the results with the scalar kernel */
+static int dna_test_compare_kernels(const GtUchar *gen_seq_tran,
+                                    GtUword gen_dp_length,
+                                    const GtUchar *ref_seq_tran,
+                                    GtUword ref_dp_length,
+                                    GtAlphabet *gen_alphabet, GtError *err)
+{
+  GthBacktracePath *scalar, *vectorized;
+  GthDPKernel kernel;
+  bool checkpoints;
+  GthFlt scalar_score, vectorized_score;
+  int had_err = 0;
+  gt_error_check(err);
+
+  scalar = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  gt_ensure(!dna_test_backtrace(scalar, gen_seq_tran, gen_dp_length,
+                                ref_seq_tran, ref_dp_length, gen_alphabet, 0,
+                                GTH_DP_KERNEL_SCALAR, &checkpoints,
+                                &scalar_score));
+  for (kernel = GTH_DP_KERNEL_SCALAR + 1;
+       !had_err && kernel < GTH_NUM_OF_DP_KERNELS; kernel++) {
+    if (!gth_dp_kernel_is_supported(kernel))
+      continue;
+    vectorized = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+    gt_ensure(!dna_test_backtrace(vectorized, gen_seq_tran, gen_dp_length,
+                                  ref_seq_tran, ref_dp_length, gen_alphabet,
+                                  0, kernel, &checkpoints, &vectorized_score));
+    gt_ensure(scalar_score == vectorized_score);
+    gt_ensure(gth_backtrace_path_length(scalar) ==
+              gth_backtrace_path_length(vectorized));
+    gt_ensure(!memcmp(gth_backtrace_path_get(scalar),
+                      gth_backtrace_path_get(vectorized),
+                      sizeof (Editoperation) *
+                      gth_backtrace_path_length(scalar)));
+    gth_backtrace_path_delete(vectorized);
+  }
+  gth_backtrace_path_delete(scalar);
+  return had_err;
+}
+
+static void dna_test_random(GtUchar *seq, GtUword length)
+{
+  GtUword i;
+  for (i = 0; i < length; i++)
+    seq[i] = (GtUchar) gt_rand_max(3);
+}
+
+/* like dna_test_random(), but with some wildcards */
+static void dna_test_random_with_wildcards(GtUchar *seq, GtUword length,
+                                           GtAlphabet *gen_alphabet)
+{
+  GtUword i;
+  for (i = 0; i < length; i++) {
+    seq[i] = gt_rand_max(29) ? (GtUchar) gt_rand_max(3)
+                             : (GtUchar) (gt_alphabet_size(gen_alphabet) - 1);
+  }
+}
+
+int gth_align_dna_unit_test(GtError *err)
+{
+  GtAlphabet *gen_alphabet;
+  GtUchar *gen_seq_tran, *ref_seq_tran, *gen_ptr, *ref_ptr;
+  GtUword i, e, gen_dp_length, ref_dp_length;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gen_alphabet = gt_alphabet_new_dna();
+
+  /* a gene with introns: the cDNA consists of the exons, in the genomic
+     sequence they are separated by GT-AG introns and some of the exonic
+     bases are mutated */
+  ref_dp_length = GTH_ALIGN_DNA_TEST_NUMOFEXONS *
+                  GTH_ALIGN_DNA_TEST_EXONLENGTH;
+  gen_dp_length = 2 * GTH_ALIGN_DNA_TEST_FLANKLENGTH + ref_dp_length +
+                  (GTH_ALIGN_DNA_TEST_NUMOFEXONS - 1) *
+                  GTH_ALIGN_DNA_TEST_INTRONLENGTH;
+  gen_seq_tran = gt_malloc(sizeof (GtUchar) * gen_dp_length);
+  ref_seq_tran = gt_malloc(sizeof (GtUchar) * ref_dp_length);
+  dna_test_random(gen_seq_tran, gen_dp_length);
+  dna_test_random(ref_seq_tran, ref_dp_length);
+  gen_ptr = gen_seq_tran + GTH_ALIGN_DNA_TEST_FLANKLENGTH;
+  ref_ptr = ref_seq_tran;
+  for (e = 0; e < GTH_ALIGN_DNA_TEST_NUMOFEXONS; e++) {
+    for (i = 0; i < GTH_ALIGN_DNA_TEST_EXONLENGTH; i++) {
+      *gen_ptr++ = gt_rand_max(49) ? *ref_ptr : (GtUchar) gt_rand_max(3);
+      ref_ptr++;
+    }
+    if (e + 1 < GTH_ALIGN_DNA_TEST_NUMOFEXONS) {
+      gen_ptr[0] = 2; /* G */
+      gen_ptr[1] = 3; /* T */
+      gen_ptr[GTH_ALIGN_DNA_TEST_INTRONLENGTH - 2] = 0; /* A */
+      gen_ptr[GTH_ALIGN_DNA_TEST_INTRONLENGTH - 1] = 2; /* G */
+      gen_ptr += GTH_ALIGN_DNA_TEST_INTRONLENGTH;
+    }
+  }
+  had_err = dna_test_compare_backtraces(gen_seq_tran, gen_dp_length,
+                                        ref_seq_tran, ref_dp_length,
+                                        gen_alphabet, err);
+
+  /* unrelated sequences whose lengths are no multiples of the block size */
+  if (!had_err) {
+    dna_test_random(gen_seq_tran, gen_dp_length - 117);
+    dna_test_random(ref_seq_tran, ref_dp_length - 45);
+    had_err = dna_test_compare_backtraces(gen_seq_tran, gen_dp_length - 117,
+                                          ref_seq_tran, ref_dp_length - 45,
+                                          gen_alphabet, err);
+  }
+
+  /* the vectorized kernels on the gene */
+  if (!had_err) {
+    had_err = dna_test_compare_kernels(gen_seq_tran, gen_dp_length,
+                                       ref_seq_tran, ref_dp_length,
+                                       gen_alphabet, err);
+  }
+
+  /* the vectorized kernels on short random sequences, most reference lengths
+     are no multiples of the vector width; in every second case the reference
+     is a mutated copy of a part of the genomic sequence (which has to be
+     longer than the U12 consensus, see dp_param.c) */
+  for (i = 1; !had_err && i <= GTH_ALIGN_DNA_TEST_MAXSHORTLENGTH; i++) {
+    GtUword gen_length = i + 8 + gt_rand_max(2 * i), j;
+    dna_test_random_with_wildcards(gen_seq_tran, gen_length, gen_alphabet);
+    dna_test_random_with_wildcards(ref_seq_tran, i, gen_alphabet);
+    if (i % 2) {
+      GtUword offset = gt_rand_max(gen_length - i);
+      for (j = 0; j < i; j++) {
+        if (gt_rand_max(9))
+          ref_seq_tran[j] = gen_seq_tran[offset + j];
+      }
+    }
+    had_err = dna_test_compare_kernels(gen_seq_tran, gen_length, ref_seq_tran,
+                                       i, gen_alphabet, err);
+  }
+
+  gt_free(ref_seq_tran);
+  gt_free(gen_seq_tran);
+  gt_alphabet_delete(gen_alphabet);
+  return had_err;
+}
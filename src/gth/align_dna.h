@@ -18,6 +18,7 @@
 #ifndef ALIGN_DNA_H
 #define ALIGN_DNA_H
 
+#include "core/error_api.h"
 #include "gth/align_common.h"
 #include "gth/dp_options_core.h"
 #include "gth/dp_options_est.h"
@@ -131,6 +132,20 @@ int gth_align_dna(GthSA*,
                   GthStat*,
                   GtFile*);
 
+/* The following function evaluates the DP of gth_align_dna() for the given
+   sequences, without computing the spliced alignment itself. It is used to
+   benchmark the DP kernels. */
+int gth_align_dna_fill(GtArray *gen_ranges,
+                       const unsigned char *gen_seq_tran,
+                       const unsigned char *ref_seq_tran,
+                       GtUword ref_dp_length,
+                       GtAlphabet *gen_alphabet,
+                       const GtRange *gen_seq_bounds,
+                       GthSpliceSiteModel *splice_site_model,
+                       GthDPOptionsCore *dp_options_core,
+                       GthDPOptionsEST *dp_options_est,
+                       GthStat*);
+
 /* can return NULL */
 GthSA* gth_align_dna_simple(GthInput *input,
                             const GtRange *gen_range,
@@ -147,4 +162,6 @@ void gth_show_backtrace_matrix(GthPath **path,
                                const GtRange *btmatrixgenrange,
                                const GtRange *btmatrixrefrange);
 
+int gth_align_dna_unit_test(GtError*);
+
 #endif
@@ -19,6 +19,7 @@
 #define ALIGN_DNA_IMP_H
 
 #include "gth/align_dna.h"
+#include "gth/dp_simd.h"
 
 #define DNA_NUMOFSCORETABLES  2
 
@@ -70,6 +71,75 @@ typedef enum {
   DNA_NUMOFRETRACE
 } DnaRetrace;
 
+/* the following structure stores the DP state of every <blockrows>-th row of
+   the genomic sequence. If it is used, the backtrace table only keeps the rows
+   of one block and the other blocks are recomputed from these checkpoints
+   during the backtracing */
+typedef struct {
+  GthFlt *score[DNA_NUMOFSTATES];   /* the stored score rows */
+  GtUword *intronstart,             /* the stored intronstart rows */
+          *exonstart,               /* the stored exonstart rows */
+          blockrows,                /* number of rows per block (even) */
+          numofblocks,
+          currentblock;             /* block currently in the backtrace
+                                       table */
+  bool store;                       /* store checkpoints while computing */
+  /* the input of the DP, necessary to recompute a block */
+  const unsigned char *gen_seq_tran,
+                      *ref_seq_tran;
+  GtAlphabet *gen_alphabet;
+  GthDPParam *dp_param;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsCore *dp_options_core;
+} GthDPMatrixCheckpoints;
+
+/* the following structure bundles the input and the output of the evaluation
+   of those DP recurrences of row <n> which do not depend on other columns of
+   the same row. That is, the I state and the maximum over all transitions into
+   the E state except for DNA_E_M and DNA_I_M, as well as the value of the
+   DNA_I_M transition. These are evaluated column parallel, afterwards the
+   DNA_E_M transition is evaluated column by column. */
+struct GthDPRowDNA {
+  GtUword n,
+          ref_dp_length,
+          dpminexonlength,
+          dpminintronlength;
+  double shortexonpenalty,
+         shortintronpenalty;
+  bool last,                          /* <n> is the last row */
+       I_I_weighted;                  /* add <I_I_weight> to the I_STATE_I_N
+                                         transitions */
+  /* the weights of the transitions (for column <ref_dp_length> if marked as
+     last) */
+  GthDbl E_NM_weight,
+         I_NM_weight,
+         E_N_weight,
+         E_N_weight_last,
+         I_N_weight,
+         I_N_weight_last,
+         I_M_weight;
+  GthFlt I_E_weight,
+         I_I_weight;
+  /* the output weights of the columns for the genomic character of row <n>,
+     <matchweight_half> is 0.0 outside of the decreased output windows */
+  const GthDbl *matchweight,
+               *matchweight_half,
+               *dashweight;
+  /* the previous row */
+  const GthFlt *E_prev,
+               *I_prev;
+  const GtUword *intronstart_prev,
+                *exonstart_prev;
+  /* the current row */
+  GthFlt *I_cur;
+  GtUword *intronstart_cur;
+  /* the output for the E state */
+  GthFlt *E_max,
+         *E_I_M;
+  GthPath *E_retrace,
+          *I_retrace;
+};
+
 /* the following structure bundles all tables involved in the dynamic
    programming for cDNAs/ESTs */
 struct GthDPMatrix {
@@ -82,6 +152,8 @@ struct GthDPMatrix {
                 *exonstart[DNA_NUMOFSCORETABLES],
                 gen_dp_length,
                 ref_dp_length;
+  GthDPMatrixCheckpoints *checkpoints; /* NULL if the backtrace table is
+                                          complete */
 };
 
 #endif
@@ -15,8 +15,15 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include "core/codon_api.h"
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -25,6 +32,7 @@
 #include "gth/gtherror.h"
 #include "gth/align_protein_imp.h"
 #include "gth/compute_scores.h"
+#include "gth/default.h"
 
 #define WSIZE_PROTEIN   20
 #define WSIZE_DNA       60 /* (3 * WSIZE_PROTEIN) */
@@ -48,6 +56,22 @@ static const char *retracenames[]= {
   SHOWENUMTYPE(NUMOFRETRACE)
 };
 
+static void dp_table_checkpoints_delete(DPtablecheckpoints *cp)
+{
+  GtUword t;
+  if (!cp) return;
+  for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++)
+    free(cp->score[t]);
+  free(cp->intronstart_A);
+  free(cp->intronstart_B);
+  free(cp->intronstart_C);
+  free(cp->exonstart);
+  free(cp->splitcodon_B);
+  free(cp->splitcodon_C1);
+  free(cp->splitcodon_C2);
+  gt_free(cp);
+}
+
 static void dp_table_core_free(DPtablecore *core)
 {
   GtUword t, n;
@@ -57,7 +81,10 @@ static void dp_table_core_free(DPtablecore *core)
     for (n = 0; n < PROTEIN_NUMOFSCORETABLES; n++)
       gt_free(core->score[t][n]);
   }
-  gth_array2dim_plain_delete(core->path);
+  if (core->path) {
+    gth_array2dim_plain_delete(core->path);
+  }
+  dp_table_checkpoints_delete(core->checkpoints);
 }
 
 static GthPath path_e_state_read(GthDPtables *dpm, unsigned int n,
@@ -117,13 +144,87 @@ static void path_ic_state_write(GthDPtables *dpm, unsigned int n,
     dpm->core.path[n][m] |= (1 << 6);
 }
 
+/* the following function allocates a backtrace table which keeps only the rows
+   of one block together with the checkpoints necessary to recompute the other
+   blocks. The number of rows per block is chosen such that the total space is
+   minimal, it grows with the square root of <gen_dp_length>. Returns the size
+   of the allocated space in bytes, or 0 if the space could not be allocated or
+   if a complete backtrace table would not be larger. */
+static GtUword dp_table_core_init_checkpoints(DPtablecore *core,
+                                              GtUword gen_dp_length,
+                                              GtUword ref_dp_length,
+                                              bool proteinexonpenal)
+{
+  DPtablecheckpoints *cp;
+  GtUword t, checkpointsize, checkpointcells;
+  bool allocated = true;
+
+  /* a checkpoint takes <checkpointsize> bytes per column, a row of the
+     backtrace table one byte */
+  checkpointsize = PROTEIN_CHECKPOINTROWS *
+                   (PROTEIN_NUMOFSTATES * sizeof (GthFlt) +
+                    (proteinexonpenal ? 4 : 3) * sizeof (GtUword) + 3);
+  cp = gt_malloc(sizeof *cp);
+  cp->blockrows = (GtUword) ceil(sqrt((double) checkpointsize *
+                                      (gen_dp_length + 1)));
+  /* the initial rows must be contained in the first block */
+  cp->blockrows = MAX(cp->blockrows, GENOMICDPSTART + 1);
+  if (cp->blockrows > gen_dp_length) {
+    gt_free(cp);
+    return 0;
+  }
+  cp->numofblocks = (gen_dp_length + cp->blockrows) / cp->blockrows;
+  /* after the DP the backtrace table contains the last block */
+  cp->currentblock = gen_dp_length / cp->blockrows;
+  cp->store = true;
+  checkpointcells = (cp->numofblocks - 1) * PROTEIN_CHECKPOINTROWS *
+                    (ref_dp_length + 1);
+
+  for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
+    cp->score[t] = malloc(sizeof (GthFlt) * checkpointcells);
+    allocated = allocated && cp->score[t];
+  }
+  cp->intronstart_A = malloc(sizeof (GtUword) * checkpointcells);
+  cp->intronstart_B = malloc(sizeof (GtUword) * checkpointcells);
+  cp->intronstart_C = malloc(sizeof (GtUword) * checkpointcells);
+  if (proteinexonpenal) {
+    cp->exonstart = malloc(sizeof (GtUword) * checkpointcells);
+    allocated = allocated && cp->exonstart;
+  }
+  else
+    cp->exonstart = NULL;
+  cp->splitcodon_B = malloc(sizeof (unsigned char) * checkpointcells);
+  cp->splitcodon_C1 = malloc(sizeof (unsigned char) * checkpointcells);
+  cp->splitcodon_C2 = malloc(sizeof (unsigned char) * checkpointcells);
+  gth_array2dim_plain_malloc_cyclic(core->path, gen_dp_length + 1,
+                                    cp->blockrows, ref_dp_length + 1);
+  if (!allocated || !cp->intronstart_A || !cp->intronstart_B ||
+      !cp->intronstart_C || !cp->splitcodon_B || !cp->splitcodon_C1 ||
+      !cp->splitcodon_C2 || !core->path) {
+    if (core->path) {
+      gth_array2dim_plain_delete(core->path);
+      core->path = NULL;
+    }
+    dp_table_checkpoints_delete(cp);
+    return 0;
+  }
+  core->checkpoints = cp;
+
+  return cp->blockrows * (ref_dp_length + 1) +
+         checkpointsize * (cp->numofblocks - 1) * (ref_dp_length + 1);
+}
+
+/* If the backtrace table would be larger than <maxbtmatrixsize> megabytes (if
+   <maxbtmatrixsize> is not 0) or cannot be allocated, a backtrace table with
+   checkpoints is used instead (except for the jump table case). */
 static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
                               GtUword ref_dp_length,
                               GtUword autoicmaxmatrixsize,
                               bool introncutout, GthJumpTable *jump_table,
+                              bool proteinexonpenal, GtUword maxbtmatrixsize,
                               GthStat *stat)
 {
-  GtUword matrixsize, t, n,
+  GtUword matrixsize, t, n, allocatedsize = 0,
                 sizeofpathtype = sizeof (GthPath);
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
@@ -152,6 +253,7 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
       core->score[t][n] = NULL;
   }
   core->path = NULL;
+  core->checkpoints = NULL;
 
   /* allocating space for core->score and core->path */
   for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
@@ -160,13 +262,29 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
     }
   }
 
-  if (jump_table) {
-    gth_array2dim_plain_calloc(core->path, gen_dp_length + 1,
-                               ref_dp_length + 1);
+  if (!jump_table && maxbtmatrixsize > 0 &&
+      sizeofpathtype * matrixsize > maxbtmatrixsize << 20) {
+    allocatedsize = dp_table_core_init_checkpoints(core, gen_dp_length,
+                                                   ref_dp_length,
+                                                   proteinexonpenal);
   }
-  else {
-    gth_array2dim_plain_malloc(core->path, gen_dp_length + 1,
-                               ref_dp_length + 1);
+  if (!core->path) {
+    if (jump_table) {
+      gth_array2dim_plain_calloc(core->path, gen_dp_length + 1,
+                                 ref_dp_length + 1);
+    }
+    else {
+      gth_array2dim_plain_malloc(core->path, gen_dp_length + 1,
+                                 ref_dp_length + 1);
+      if (!core->path) {
+        /* the complete backtrace table does not fit into memory */
+        allocatedsize = dp_table_core_init_checkpoints(core, gen_dp_length,
+                                                       ref_dp_length,
+                                                       proteinexonpenal);
+      }
+    }
+    if (core->path && !core->checkpoints)
+      allocatedsize = sizeofpathtype * matrixsize;
   }
   if (!core->path) {
     /* matrix allocation failed, return after free of allocated tables */
@@ -176,8 +294,7 @@ static int dp_table_core_init(DPtablecore *core, GtUword gen_dp_length,
 
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
-  gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
-                                           (sizeofpathtype * matrixsize) >> 20);
+  gth_stat_increase_totalsizeofbacktracematricesinMB(stat, allocatedsize >> 20);
 
   return 0;
 }
@@ -202,7 +319,8 @@ static void initinput(GthAlignInputProtein *input,
 static int dp_tables_alloc(GthDPtables *dpm, GtUword gen_dp_length,
                            bool proteinexonpenal, GtUword ref_dp_length,
                            GtUword autoicmaxmatrixsize, bool introncutout,
-                           GthJumpTable *jump_table, GthStat *stat)
+                           GthJumpTable *jump_table, GtUword maxbtmatrixsize,
+                           GthStat *stat)
 {
   GtUword n;
   int rval;
@@ -210,7 +328,7 @@ static int dp_tables_alloc(GthDPtables *dpm, GtUword gen_dp_length,
   /* allocate core */
   if ((rval = dp_table_core_init(&dpm->core, gen_dp_length, ref_dp_length,
                                  autoicmaxmatrixsize, introncutout, jump_table,
-                                 stat))) {
+                                 proteinexonpenal, maxbtmatrixsize, stat))) {
     return rval;
   }
 
@@ -318,23 +436,289 @@ unsigned char gthgetcodon(unsigned char genomicchar1,
   return codon;
 }
 
-/* the following function evaluate the dynamic programming tables */
+/* the following function stores the checkpoint for row <n>, if row <n> is the
+   last row of a block (but not of the last block) */
+static void dp_tables_store_checkpoint(GthDPtables *dpm, GtUword n)
+{
+  DPtablecheckpoints *cp = dpm->core.checkpoints;
+  GtUword t, r, block, offset, rowsize = cp->ref_dp_length + 1;
+
+  if (!cp->store || (n + 1) % cp->blockrows)
+    return;
+  block = (n + 1) / cp->blockrows;
+  if (block == cp->numofblocks)
+    return;
+  for (r = 0; r < PROTEIN_CHECKPOINTROWS; r++) {
+    offset = ((block - 1) * PROTEIN_CHECKPOINTROWS + r) * rowsize;
+    for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
+      memcpy(cp->score[t] + offset, dpm->core.score[t][GT_MOD4(n - r)],
+             sizeof (GthFlt) * rowsize);
+    }
+    memcpy(cp->intronstart_A + offset, dpm->intronstart_A[GT_MOD4(n - r)],
+           sizeof (GtUword) * rowsize);
+    memcpy(cp->intronstart_B + offset, dpm->intronstart_B[GT_MOD4(n - r)],
+           sizeof (GtUword) * rowsize);
+    memcpy(cp->intronstart_C + offset, dpm->intronstart_C[GT_MOD4(n - r)],
+           sizeof (GtUword) * rowsize);
+    if (cp->exonstart) {
+      memcpy(cp->exonstart + offset, dpm->exonstart[GT_MOD4(n - r)],
+             sizeof (GtUword) * rowsize);
+    }
+    memcpy(cp->splitcodon_B + offset, dpm->splitcodon_B[GT_MOD4(n - r)],
+           sizeof (unsigned char) * rowsize);
+    memcpy(cp->splitcodon_C1 + offset, dpm->splitcodon_C1[GT_MOD4(n - r)],
+           sizeof (unsigned char) * rowsize);
+    memcpy(cp->splitcodon_C2 + offset, dpm->splitcodon_C2[GT_MOD4(n - r)],
+           sizeof (unsigned char) * rowsize);
+  }
+}
+
+/* the following function evaluates the column parallel part of the DP
+   recurrences of <row> for the columns <mstart> to <ref_dp_length> */
+static void protein_row_scalar(GthDPRowProtein *row, GtUword mstart)
+{
+  GtUword m, n = row->n;
+  GthFlt value, maxvalue;
+  GthPath retrace, I_retrace;
+
+  for (m = mstart; m <= row->ref_dp_length; m++) {
+    /* evaluate E_nm before transition E_M */
+    /* 0. */
+    maxvalue = row->score[E_STATE][3][m-1] +
+               /* XXX: why is here no extra condition? */
+               (row->E_N3M_weight + row->codonscore[m]);
+    retrace  = (GthPath) E_N3M;
+
+    /* 1. */
+    value = row->score[E_STATE][2][m-1];
+    if (!row->last || m < WSIZE_PROTEIN)
+      value += row->E_N2M_weight + row->dashscore[m];
+    UPDATEMAX(E_N2M);
+
+    /* 2. */
+    value = row->score[E_STATE][1][m-1];
+    if (!row->last || m < WSIZE_PROTEIN)
+      value += row->E_N1M_weight + row->dashscore[m];
+    UPDATEMAX(E_N1M);
+
+    row->E_max_before[m] = maxvalue;
+    row->E_retrace_before[m] = retrace;
+
+    /* evaluate E_nm after transition E_M */
+    /* 4. */
+    maxvalue = row->score[E_STATE][3][m];
+    if (m < row->ref_dp_length || n < WSIZE_DNA)
+      maxvalue += row->E_N3_weight;
+    retrace  = (GthPath) E_N3;
+
+    /* 5. */
+    value = row->score[E_STATE][2][m];
+    if (m < row->ref_dp_length || n < WSIZE_DNA)
+      value += row->E_N2_weight;
+    UPDATEMAX(E_N2);
+
+    /* 6. */
+    value = row->score[E_STATE][1][m];
+    if (m < row->ref_dp_length || n < WSIZE_DNA)
+      value += row->E_N1_weight;
+    UPDATEMAX(E_N1);
+
+    /* 7. */
+    value = row->score[IA_STATE][3][m-1];
+    if (row->IA_N3M_weighted)
+      value += row->IA_N3M_weight;
+    value += row->codonscore[m];
+    if (n - 2 - row->intronstart_A[3][m-1] < row->dpminintronlength)
+      value -= row->shortintronpenalty;
+    UPDATEMAX(IA_N3M);
+
+    /* 8. */
+    value = row->E_IB_N2M[m];
+    UPDATEMAX(IB_N2M);
+
+    /* 9. */
+    value = row->E_IC_N1M[m];
+    UPDATEMAX(IC_N1M);
+
+    row->E_max_after[m] = maxvalue;
+    row->E_retrace_after[m] = retrace;
+
+    /* evaluate IA_nm */
+    I_retrace = 0;
+    maxvalue = row->score[IA_STATE][1][m];
+    if (row->I_N1_weighted)
+      maxvalue += row->I_N1_weight;
+    retrace  = (GthPath) IA_N1;
+
+    value = row->score[E_STATE][1][m] + row->I_E_weight;
+    if (row->exonstart[1] &&
+        n - row->exonstart[1][m] < row->dpminexonlength) {
+      value -= row->shortexonpenalty;
+    }
+    UPDATEMAX(E_N1);
+
+    /* save maximum values */
+    row->score[IA_STATE][0][m] = maxvalue;
+
+    switch (retrace) {
+      case IA_N1:
+        row->intronstart_A[0][m] = row->intronstart_A[1][m];
+        break;
+      case E_N1:
+        row->intronstart_A[0][m] = n;
+        I_retrace |= IA_STATE_MASK;
+        break;
+      default: gt_assert(0);
+    }
+
+    /* evaluate IB_nm */
+    maxvalue = row->score[IB_STATE][1][m];
+    if (row->I_N1_weighted)
+      maxvalue += row->I_N1_weight;
+    retrace  = (GthPath) IB_N1;
+
+    value = row->score[E_STATE][2][m] + row->I_E_weight;
+    if (row->exonstart[2] &&
+        n - 1 - row->exonstart[2][m] < row->dpminexonlength) {
+      value -= row->shortexonpenalty;
+    }
+    UPDATEMAX(E_N2);
+
+    /* save maximum values */
+    row->score[IB_STATE][0][m] = maxvalue;
+
+    switch (retrace) {
+      case(IB_N1):
+        row->intronstart_B[0][m] = row->intronstart_B[1][m];
+        row->splitcodon_B[0][m]  = row->splitcodon_B[1][m];
+        break;
+      case(E_N2):
+        row->intronstart_B[0][m] = n;
+        row->splitcodon_B[0][m]  = row->newsplitcodon_B;
+        I_retrace |= IB_STATE_MASK;
+        break;
+      default: gt_assert(0);
+    }
+
+    /* evaluate IC_nm */
+    maxvalue = row->score[IC_STATE][1][m];
+    if (row->I_N1_weighted)
+      maxvalue += row->I_N1_weight;
+    retrace = (GthPath) IC_N1;
+
+    value = row->score[E_STATE][3][m] + row->I_E_weight;
+    if (row->exonstart[3] &&
+        n - 2 - row->exonstart[3][m] < row->dpminexonlength) {
+      value -= row->shortexonpenalty;
+    }
+    UPDATEMAX(E_N3);
+
+    /* save maximum values */
+    row->score[IC_STATE][0][m] = maxvalue;
+
+    switch (retrace) {
+      case(IC_N1):
+        row->intronstart_C[0][m] = row->intronstart_C[1][m];
+        row->splitcodon_C1[0][m] = row->splitcodon_C1[1][m];
+        row->splitcodon_C2[0][m] = row->splitcodon_C2[1][m];
+        break;
+      case(E_N3):
+        row->intronstart_C[0][m] = n;
+        row->splitcodon_C1[0][m] = row->newsplitcodon_C1;
+        row->splitcodon_C2[0][m] = row->newsplitcodon_C2;
+        I_retrace |= IC_STATE_MASK;
+        break;
+      default: gt_assert(0);
+    }
+
+    row->I_retrace[m] = I_retrace;
+  }
+}
+
+/* the following function returns the scores of the columns for <amino>, which
+   are computed on demand and stored in <aminoscore> */
+static const GthFlt* protein_aminoscore(GthFlt **aminoscore,
+                                        unsigned char amino,
+                                        GthAlignInputProtein *input,
+                                        GtUword ref_dp_length,
+                                        GthDPScoresProtein *dp_scores_protein)
+{
+  GtUword m;
+  if (!aminoscore[amino]) {
+    aminoscore[amino] = gt_malloc(sizeof (GthFlt) * (ref_dp_length + 1));
+    for (m = REFERENCEDPSTART; m <= ref_dp_length; m++) {
+      aminoscore[amino][m] =
+        dp_scores_protein->score[amino][input->ref_seq_orig[m-1]];
+    }
+  }
+  return aminoscore[amino];
+}
+
+/* the following function evaluate the dynamic programming tables for the rows
+   <genomic_start> to <genomic_end>. Every row is evaluated in two steps: first
+   everything which does not depend on other columns of the same row (with the
+   vectorized kernel <dp_options_core->dpkernel>, if possible), then the
+   remaining E_M transition column by column. */
 static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
                                  bool proteinexonpenal,
                                  const unsigned char *gen_seq_tran,
                                  GtUword gen_dp_length,
                                  GtUword ref_dp_length,
+                                 GtUword genomic_start,
+                                 GtUword genomic_end,
                                  GthDPParam *dp_param,
                                  GthDPOptionsCore *dp_options_core,
                                  GthDPScoresProtein *dp_scores_protein)
 {
-  GtUword n, m, modn, modnminus1, modnminus2, modnminus3;
+  DPtablecheckpoints *cp = dpm->core.checkpoints;
+  GtUword d, n, m, modn, modnminus1, modnminus2, modnminus3, t;
   unsigned char origreferencechar;
-  GthFlt value, maxvalue;
+  GthFlt value, maxvalue, *aminoscore[UCHAR_MAX+1], *E_IB_N2M, *E_IC_N1M;
   GthPath retrace;
+  GthDPRowProteinFunc row_func =
+    gth_dp_kernel_row_protein(dp_options_core->dpkernel);
+  GthDPRowProtein row;
+
+  gt_assert(genomic_start >= GENOMICDPSTART && genomic_end <= gen_dp_length);
+
+  if (cp && cp->store) {
+    /* remember the input to recompute blocks during the backtracing */
+    cp->input = input;
+    cp->proteinexonpenal = proteinexonpenal;
+    cp->gen_seq_tran = gen_seq_tran;
+    cp->gen_dp_length = gen_dp_length;
+    cp->ref_dp_length = ref_dp_length;
+    cp->dp_param = dp_param;
+    cp->dp_options_core = dp_options_core;
+    cp->dp_scores_protein = dp_scores_protein;
+  }
+
+  /* the scores of the columns are computed on demand for every amino acid */
+  memset(aminoscore, 0, sizeof aminoscore);
+
+  /* setup the row */
+  row.ref_dp_length = ref_dp_length;
+  row.dpminexonlength = dp_options_core->dpminexonlength;
+  row.dpminintronlength = dp_options_core->dpminintronlength;
+  row.shortexonpenalty = dp_options_core->shortexonpenalty;
+  row.shortintronpenalty = dp_options_core->shortintronpenalty;
+  row.I_N1_weighted = !dp_options_core->freeintrontrans;
+  row.dashscore = protein_aminoscore(aminoscore, DASH, input, ref_dp_length,
+                                     dp_scores_protein);
+  E_IB_N2M = gt_malloc(sizeof *E_IB_N2M * (ref_dp_length + 1));
+  E_IC_N1M = gt_malloc(sizeof *E_IC_N1M * (ref_dp_length + 1));
+  row.E_IB_N2M = E_IB_N2M;
+  row.E_IC_N1M = E_IC_N1M;
+  row.E_max_before = gt_malloc(sizeof *row.E_max_before * (ref_dp_length + 1));
+  row.E_max_after = gt_malloc(sizeof *row.E_max_after * (ref_dp_length + 1));
+  row.E_retrace_before = gt_malloc(sizeof *row.E_retrace_before *
+                                   (ref_dp_length + 1));
+  row.E_retrace_after = gt_malloc(sizeof *row.E_retrace_after *
+                                  (ref_dp_length + 1));
+  row.I_retrace = gt_malloc(sizeof *row.I_retrace * (ref_dp_length + 1));
 
   /* stepping along the genomic sequence */
-  for (n = GENOMICDPSTART; n <= gen_dp_length; n++) {
+  for (n = genomic_start; n <= genomic_end; n++) {
     modn       = GT_MOD4(n),
     modnminus1 = GT_MOD4(n-1),
     modnminus2 = GT_MOD4(n-2),
@@ -345,95 +729,54 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
     path_ib_state_write(dpm, n, 0, IB_N1);
     path_ic_state_write(dpm, n, 0, IC_N1);
 
-    /* stepping along the protein sequence */
+    /* setup the row */
+    row.n = n;
+    row.last = n == gen_dp_length;
+    row.IA_N3M_weighted = n > GENOMICDPSTART; /* the weight is only defined in
+                                                 this case */
+    row.E_N3M_weight = dp_param->log_1minusPdonor[n-3];
+    row.E_N2M_weight = dp_param->log_1minusPdonor[n-2];
+    row.E_N1M_weight = dp_param->log_1minusPdonor[n-1];
+    row.E_N3_weight = dp_param->log_1minusPdonor[n-3] +
+                      GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
+                                  gen_seq_tran[n-2], gen_seq_tran[n-1], DASH);
+    row.E_N2_weight = dp_param->log_1minusPdonor[n-2] +
+                      GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-2],
+                                  gen_seq_tran[n-1], DASH, DASH);
+    row.E_N1_weight = dp_param->log_1minusPdonor[n-1] +
+                      GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-1], DASH,
+                                  DASH, DASH);
+    if (row.IA_N3M_weighted)
+      row.IA_N3M_weight = dp_param->log_Pacceptor[n-4];
+    row.I_N1_weight = dp_param->log_1minusPacceptor[n-2];
+    row.I_E_weight = dp_param->log_Pdonor[n-1];
+    row.codonscore = protein_aminoscore(aminoscore,
+                                        GTHGETAMINO(dp_scores_protein,
+                                                    gen_seq_tran[n-3],
+                                                    gen_seq_tran[n-2],
+                                                    gen_seq_tran[n-1]),
+                                        input, ref_dp_length,
+                                        dp_scores_protein);
+    row.newsplitcodon_B = gen_seq_tran[n-2];
+    row.newsplitcodon_C1 = gen_seq_tran[n-3];
+    row.newsplitcodon_C2 = gen_seq_tran[n-2];
+    for (d = 0; d < PROTEIN_NUMOFSCORETABLES; d++) {
+      for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++)
+        row.score[t][d] = dpm->core.score[t][GT_MOD4(n-d)];
+      row.intronstart_A[d] = dpm->intronstart_A[GT_MOD4(n-d)];
+      row.intronstart_B[d] = dpm->intronstart_B[GT_MOD4(n-d)];
+      row.intronstart_C[d] = dpm->intronstart_C[GT_MOD4(n-d)];
+      row.exonstart[d] = dpm->exonstart[GT_MOD4(n-d)];
+      row.splitcodon_B[d] = dpm->splitcodon_B[GT_MOD4(n-d)];
+      row.splitcodon_C1[d] = dpm->splitcodon_C1[GT_MOD4(n-d)];
+      row.splitcodon_C2[d] = dpm->splitcodon_C2[GT_MOD4(n-d)];
+    }
+
+    /* evaluate the transitions from the split codon states, which depend on
+       the split codons of the columns */
     for (m = REFERENCEDPSTART; m <= ref_dp_length; m++) {
       origreferencechar = input->ref_seq_orig[m-1];
 
-      /* evaluate E_nm */
-      /* 0. */
-      maxvalue = SCORE(E_STATE, modnminus3, m-1) +
-                 /* XXX: why is here no extra condition? */
-                 (dp_param->log_1minusPdonor[n-3] +
-                  GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                              gen_seq_tran[n-2], gen_seq_tran[n-1],
-                              origreferencechar));
-      retrace  = (GthPath) E_N3M;
-
-      /* 1. */
-      value = SCORE(E_STATE, modnminus2, m-1);
-      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        value += dp_param->log_1minusPdonor[n-2] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-2],
-                             gen_seq_tran[n-1], DASH, origreferencechar);
-      }
-      UPDATEMAX(E_N2M);
-
-      /* 2. */
-      value = SCORE(E_STATE, modnminus1, m-1);
-      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        value += dp_param->log_1minusPdonor[n-1] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-1], DASH, DASH,
-                             origreferencechar);
-      }
-      UPDATEMAX(E_N1M);
-
-      /* 3. */
-      value = SCORE(E_STATE, modn, m-1);
-      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
-        if (n == gen_dp_length) {
-          /* in this case the value used in the 'else' branch below is not
-             defined. */
-          value += dp_param->log_1minusPdonor[n-1];
-        }
-        else {
-          value += dp_param->log_1minusPdonor[n];
-                                     /* XXX: ^^^  why n? */
-        }
-        value += GTHGETSCORE(dp_scores_protein, DASH, DASH, DASH,
-                             origreferencechar);
-      }
-      UPDATEMAX(E_M);
-
-      /* 4. */
-      value = SCORE(E_STATE, modnminus3, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-3] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                             gen_seq_tran[n-2], gen_seq_tran[n-1], DASH);
-      }
-      UPDATEMAX(E_N3);
-
-      /* 5. */
-      value = SCORE(E_STATE, modnminus2, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-2] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-2],
-                             gen_seq_tran[n-1], DASH, DASH);
-      }
-      UPDATEMAX(E_N2);
-
-      /* 6. */
-      value = SCORE(E_STATE, modnminus1, m);
-      if (m < ref_dp_length || n < WSIZE_DNA) {
-        value += dp_param->log_1minusPdonor[n-1] +
-                 GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-1], DASH, DASH,
-                             DASH);
-      }
-      UPDATEMAX(E_N1);
-
-      /* 7. */
-      value = SCORE(IA_STATE, modnminus3, m-1);
-      if (n > GENOMICDPSTART) /* the value below is only defined in this case */
-        value += dp_param->log_Pacceptor[n-4];
-      value += GTHGETSCORE(dp_scores_protein, gen_seq_tran[n-3],
-                           gen_seq_tran[n-2], gen_seq_tran[n-1],
-                           origreferencechar);
-      if (n - 2 - dpm->intronstart_A[modnminus3][m-1] <
-          dp_options_core->dpminintronlength) {
-        value -= dp_options_core->shortintronpenalty;
-      }
-      UPDATEMAX(IA_N3M);
-
       /* 8.
          this recurrence is only used if an intron has already been introduced.
          (in this case "dpm->splitcodon_B[modnminus1][m-1]" is different from
@@ -449,8 +792,10 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
             dp_options_core->dpminintronlength) {
           value -= dp_options_core->shortintronpenalty;
         }
-        UPDATEMAX(IB_N2M);
+        E_IB_N2M[m] = value;
       }
+      else
+        E_IB_N2M[m] = (GthFlt) -HUGE_VAL;
 
       /* 9.
          explanation for check see above.
@@ -468,12 +813,46 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
             dp_options_core->dpminintronlength) {
           value -= dp_options_core->shortintronpenalty;
         }
-        UPDATEMAX(IC_N1M);
+        E_IC_N1M[m] = value;
       }
+      else
+        E_IC_N1M[m] = (GthFlt) -HUGE_VAL;
+    }
+
+    /* evaluate everything except for the transition E_M */
+    m = REFERENCEDPSTART;
+    if (row_func && !row.last)
+      m = row_func(&row);
+    protein_row_scalar(&row, m);
+
+    /* stepping along the protein sequence */
+    for (m = REFERENCEDPSTART; m <= ref_dp_length; m++) {
+      maxvalue = row.E_max_before[m];
+      retrace = row.E_retrace_before[m];
+
+      /* 3. */
+      value = SCORE(E_STATE, modn, m-1);
+      if (n < gen_dp_length || m < WSIZE_PROTEIN) {
+        if (n == gen_dp_length) {
+          /* in this case the value used in the 'else' branch below is not
+             defined. */
+          value += dp_param->log_1minusPdonor[n-1];
+        }
+        else {
+          value += dp_param->log_1minusPdonor[n];
+                                     /* XXX: ^^^  why n? */
+        }
+        value += row.dashscore[m];
+      }
+      UPDATEMAX(E_M);
+
+      /* 4. to 9. */
+      value = row.E_max_after[m];
+      UPDATEMAX(row.E_retrace_after[m]);
 
       /* save maximum values */
       SCORE(E_STATE, modn, m) = maxvalue;
-      path_e_state_write(dpm, n, m, retrace);
+      dpm->core.path[n][m] = retrace | row.I_retrace[m];
 
       if (proteinexonpenal) {
         switch (retrace) {
@@ -509,101 +888,79 @@ static void complete_path_matrix(GthDPtables *dpm, GthAlignInputProtein *input,
           default: gt_assert(0);
         }
       }
+    }
 
-      /* evaluate IA_nm */
-      maxvalue = SCORE(IA_STATE, modnminus1, m);
-      if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
-      retrace  = (GthPath) IA_N1;
-
-      value = SCORE(E_STATE, modnminus1, m) + dp_param->log_Pdonor[n-1];
-      if (proteinexonpenal) {
-        if (n - dpm->exonstart[modnminus1][m] <
-            dp_options_core->dpminexonlength) {
-          value -= dp_options_core->shortexonpenalty;
-        }
-      }
-      UPDATEMAX(E_N1);
-
-      /* save maximum values */
-      SCORE(IA_STATE, modn, m) = maxvalue;
-      path_ia_state_write(dpm, n, m, retrace);
-
-      switch (retrace) {
-        case IA_N1:
-          dpm->intronstart_A[modn][m] = dpm->intronstart_A[modnminus1][m];
-          break;
-        case E_N1:
-          dpm->intronstart_A[modn][m] = n;
-          break;
-        default: gt_assert(0);
-      }
-
-      /* evaluate IB_nm */
-      maxvalue = SCORE(IB_STATE, modnminus1, m);
-      if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
-      retrace  = (GthPath) IB_N1;
-
-      value = SCORE(E_STATE, modnminus2, m) + dp_param->log_Pdonor[n-1];
-      if (proteinexonpenal) {
-        if (n - 1 - dpm->exonstart[modnminus2][m] <
-            dp_options_core->dpminexonlength) {
-          value -= dp_options_core->shortexonpenalty;
-        }
-      }
-      UPDATEMAX(E_N2);
-
-      /* save maximum values */
-      SCORE(IB_STATE, modn, m) = maxvalue;
-      path_ib_state_write(dpm, n, m, retrace);
-
-      switch (retrace) {
-        case(IB_N1):
-          dpm->intronstart_B[modn][m] = dpm->intronstart_B[modnminus1][m];
-          dpm->splitcodon_B[modn][m]  = dpm->splitcodon_B[modnminus1][m];
-          break;
-        case(E_N2):
-          dpm->intronstart_B[modn][m] = n;
-          dpm->splitcodon_B[modn][m]  = gen_seq_tran[n-2];
-          break;
-        default: gt_assert(0);
-      }
+    if (cp)
+      dp_tables_store_checkpoint(dpm, n);
+  }
 
-      /* evaluate IC_nm */
-      maxvalue = SCORE(IC_STATE, modnminus1, m);
-      if (!dp_options_core->freeintrontrans)
-        maxvalue += dp_param->log_1minusPacceptor[n-2];
-      retrace = (GthPath) IC_N1;
+  for (m = 0; m <= UCHAR_MAX; m++)
+    gt_free(aminoscore[m]);
+  gt_free(E_IB_N2M);
+  gt_free(E_IC_N1M);
+  gt_free(row.E_max_before);
+  gt_free(row.E_max_after);
+  gt_free(row.E_retrace_before);
+  gt_free(row.E_retrace_after);
+  gt_free(row.I_retrace);
+}
 
-      value = SCORE(E_STATE, modnminus3, m) + dp_param->log_Pdonor[n-1];
-      if (proteinexonpenal) {
-        if (n - 2 - dpm->exonstart[modnminus3][m] <
-            dp_options_core->dpminexonlength) {
-          value -= dp_options_core->shortexonpenalty;
-        }
+/* the following function recomputes the block of the backtrace table which
+   contains row <genptr>, if it is not the current one. Since the backtracing
+   moves from the last row to the first one, every block is recomputed at most
+   once. */
+static void complete_path_matrix_block(GthDPtables *dpm, GtUword genptr)
+{
+  DPtablecheckpoints *cp = dpm->core.checkpoints;
+  GtUword t, r, block, first, offset, modn, rowsize = cp->ref_dp_length + 1;
+
+  block = genptr / cp->blockrows;
+  if (block == cp->currentblock)
+    return;
+  gt_assert(block < cp->currentblock);
+  cp->store = false;
+  first = block * cp->blockrows;
+
+  if (block) {
+    /* restore the DP state of the rows before the block from its
+       checkpoint */
+    for (r = 0; r < PROTEIN_CHECKPOINTROWS; r++) {
+      offset = ((block - 1) * PROTEIN_CHECKPOINTROWS + r) * rowsize;
+      modn = GT_MOD4(first - 1 - r);
+      for (t = E_STATE; t < PROTEIN_NUMOFSTATES; t++) {
+        memcpy(dpm->core.score[t][modn], cp->score[t] + offset,
+               sizeof (GthFlt) * rowsize);
       }
-      UPDATEMAX(E_N3);
-
-      /* save maximum values */
-      SCORE(IC_STATE, modn, m) = maxvalue;
-      path_ic_state_write(dpm, n, m, retrace);
-
-      switch (retrace) {
-        case(IC_N1):
-          dpm->intronstart_C[modn][m] = dpm->intronstart_C[modnminus1][m];
-          dpm->splitcodon_C1[modn][m] = dpm->splitcodon_C1[modnminus1][m];
-          dpm->splitcodon_C2[modn][m] = dpm->splitcodon_C2[modnminus1][m];
-          break;
-        case(E_N3):
-          dpm->intronstart_C[modn][m] = n;
-          dpm->splitcodon_C1[modn][m] = gen_seq_tran[n-3];
-          dpm->splitcodon_C2[modn][m] = gen_seq_tran[n-2];
-          break;
-        default: gt_assert(0);
+      memcpy(dpm->intronstart_A[modn], cp->intronstart_A + offset,
+             sizeof (GtUword) * rowsize);
+      memcpy(dpm->intronstart_B[modn], cp->intronstart_B + offset,
+             sizeof (GtUword) * rowsize);
+      memcpy(dpm->intronstart_C[modn], cp->intronstart_C + offset,
+             sizeof (GtUword) * rowsize);
+      if (cp->exonstart) {
+        memcpy(dpm->exonstart[modn], cp->exonstart + offset,
+               sizeof (GtUword) * rowsize);
       }
+      memcpy(dpm->splitcodon_B[modn], cp->splitcodon_B + offset,
+             sizeof (unsigned char) * rowsize);
+      memcpy(dpm->splitcodon_C1[modn], cp->splitcodon_C1 + offset,
+             sizeof (unsigned char) * rowsize);
+      memcpy(dpm->splitcodon_C2[modn], cp->splitcodon_C2 + offset,
+             sizeof (unsigned char) * rowsize);
     }
   }
+  else {
+    dp_tables_init(dpm, cp->proteinexonpenal, cp->ref_dp_length);
+    first = GENOMICDPSTART;
+  }
+
+  complete_path_matrix(dpm, cp->input, cp->proteinexonpenal, cp->gen_seq_tran,
+                       cp->gen_dp_length, cp->ref_dp_length, first,
+                       MIN(block * cp->blockrows + cp->blockrows - 1,
+                           cp->gen_dp_length),
+                       cp->dp_param, cp->dp_options_core,
+                       cp->dp_scores_protein);
+  cp->currentblock = block;
 }
 
 static void include_exon(GthBacktracePath *backtrace_path,
@@ -704,6 +1061,9 @@ static int evaltracepath(GthBacktracePath *backtrace_path, GthDPtables *dpm,
     skipdummyprocessing = true;
 
   while ((genptr > 0) || (refptr > 0)) {
+    if (dpm->core.checkpoints)
+      complete_path_matrix_block(dpm, genptr);
+
     switch (actualstate) {
       case E_STATE:
         pathtype = path_e_state_read(dpm, genptr, refptr);
@@ -1106,7 +1466,7 @@ int gth_align_protein(GthSA *sa,
                                                  : gen_dp_length,
                               proteinexonpenal, ref_dp_length,
                               autoicmaxmatrixsize, introncutout, jump_table,
-                              stat))) {
+                              dp_options_core->maxbtmatrixsize, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
     gth_dp_scores_protein_delete(dp_scores_protein);
@@ -1140,8 +1500,10 @@ int gth_align_protein(GthSA *sa,
                                       : gen_seq_tran + gen_dp_start,
                          introncutout ? spliced_seq->splicedseqlen
                                       : gen_dp_length,
-                         ref_dp_length, dp_param, dp_options_core,
-                         dp_scores_protein);
+                         ref_dp_length, GENOMICDPSTART,
+                         introncutout ? spliced_seq->splicedseqlen
+                                      : gen_dp_length,
+                         dp_param, dp_options_core, dp_scores_protein);
 
   /* backtracing */
   if ((rval = find_optimal_path(gth_sa_backtrace_path(sa), &dpm, ref_dp_length,
@@ -1192,3 +1554,378 @@ int gth_align_protein(GthSA *sa,
 
   return 0;
 }
+
+int gth_align_protein_fill(GtArray *gen_ranges,
+                           const unsigned char *gen_seq_tran,
+                           const unsigned char *ref_seq_orig,
+                           GtUword ref_dp_length,
+                           GtAlphabet *gen_alphabet,
+                           GtScoreMatrix *score_matrix,
+                           GtAlphabet *score_matrix_alpha,
+                           bool proteinexonpenal,
+                           GtUword translationtable,
+                           const GtRange *gen_seq_bounds,
+                           GthSpliceSiteModel *splice_site_model,
+                           GthDPOptionsCore *dp_options_core,
+                           GthStat *stat)
+{
+  GtUword gen_dp_start, gen_dp_end, gen_dp_length;
+  GthDPScoresProtein *dp_scores_protein;
+  GthDPParam *dp_param;
+  GthAlignInputProtein input;
+  GthDPtables dpm;
+  int rval;
+
+  gt_assert(gen_ranges && score_matrix && score_matrix_alpha);
+
+  gen_dp_start  = ((GtRange*) gt_array_get_first(gen_ranges))->start;
+  gen_dp_end    = ((GtRange*) gt_array_get_last(gen_ranges))->end;
+  gt_assert(gen_dp_start <= gen_dp_end);
+  gen_dp_length = gen_dp_end - gen_dp_start + 1;
+  dp_param = gth_dp_param_new(gen_ranges, gen_seq_tran, gen_seq_bounds,
+                              splice_site_model, gen_alphabet);
+  if (!dp_param)
+    return GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED;
+  input.ref_seq_orig       = ref_seq_orig;
+  input.score_matrix       = score_matrix;
+  input.score_matrix_alpha = score_matrix_alpha;
+  if ((rval = dp_tables_alloc(&dpm, gen_dp_length, proteinexonpenal,
+                              ref_dp_length, 0, false, NULL,
+                              dp_options_core->maxbtmatrixsize, stat))) {
+    gth_dp_param_delete(dp_param);
+    return rval;
+  }
+  dp_tables_init(&dpm, proteinexonpenal, ref_dp_length);
+  dp_scores_protein = gth_dp_scores_protein_new(translationtable, score_matrix,
+                                                score_matrix_alpha);
+
+  complete_path_matrix(&dpm, &input, proteinexonpenal,
+                       gen_seq_tran + gen_dp_start, gen_dp_length,
+                       ref_dp_length, GENOMICDPSTART, gen_dp_length, dp_param,
+                       dp_options_core, dp_scores_protein);
+
+  dp_tables_free(&dpm);
+  gth_dp_param_delete(dp_param);
+  gth_dp_scores_protein_delete(dp_scores_protein);
+
+  return 0;
+}
+
+#define GTH_ALIGN_PROTEIN_TEST_FLANKLENGTH     300
+#define GTH_ALIGN_PROTEIN_TEST_EXONLENGTH      100 /* amino acids */
+#define GTH_ALIGN_PROTEIN_TEST_INTRONLENGTH    1200
+#define GTH_ALIGN_PROTEIN_TEST_NUMOFEXONS      3
+#define GTH_ALIGN_PROTEIN_TEST_MATCHSCORE      4
+#define GTH_ALIGN_PROTEIN_TEST_MISMATCHSCORE   -1
+#define GTH_ALIGN_PROTEIN_TEST_MAXSHORTLENGTH  40
+
+/* compute the backtrace path of <gen_seq_tran> and <ref_seq_orig> with a
+   backtrace table of at most <maxbtmatrixsize> megabytes and the DP kernel
+   <kernel> */
+static int protein_test_backtrace(GthBacktracePath *backtrace_path,
+                                  const GtUchar *gen_seq_tran,
+                                  GtUword gen_dp_length,
+                                  const GtUchar *ref_seq_orig,
+                                  GtUword ref_dp_length,
+                                  GtAlphabet *gen_alphabet,
+                                  GtScoreMatrix *score_matrix,
+                                  GtAlphabet *score_matrix_alpha,
+                                  const GtTransTable *transtable,
+                                  GtUword maxbtmatrixsize, GthDPKernel kernel,
+                                  bool *checkpoints, GthFlt *score)
+{
+  GthSpliceSiteModel *splice_site_model;
+  GthDPOptionsCore *dp_options_core;
+  GthDPScoresProtein *dp_scores_protein;
+  GthAlignInputProtein input;
+  GthDPParam *dp_param;
+  GthStat *stat;
+  GtArray *gen_ranges;
+  GtRange range;
+  GthDPtables dpmatrix, *dpm = &dpmatrix;
+  int rval;
+
+  splice_site_model = gth_splice_site_model_new();
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_core->maxbtmatrixsize = maxbtmatrixsize;
+  dp_options_core->dpkernel = kernel;
+  stat = gth_stat_new();
+  range.start = 0;
+  range.end = gen_dp_length - 1;
+  gen_ranges = gt_array_new(sizeof (GtRange));
+  gt_array_add(gen_ranges, range);
+  input.ref_seq_orig       = ref_seq_orig;
+  input.score_matrix       = score_matrix;
+  input.score_matrix_alpha = score_matrix_alpha;
+
+  dp_param = gth_dp_param_new(gen_ranges, gen_seq_tran, &range,
+                              splice_site_model, gen_alphabet);
+  gt_assert(dp_param);
+  rval = dp_tables_alloc(dpm, gen_dp_length, false, ref_dp_length, 0, false,
+                         NULL, maxbtmatrixsize, stat);
+  gt_assert(!rval);
+  *checkpoints = dpm->core.checkpoints ? true : false;
+  dp_tables_init(dpm, false, ref_dp_length);
+  dp_scores_protein = gth_dp_scores_protein_new(GTH_DEFAULT_TRANSLATIONTABLE,
+                                                score_matrix,
+                                                score_matrix_alpha);
+  complete_path_matrix(dpm, &input, false, gen_seq_tran, gen_dp_length,
+                       ref_dp_length, GENOMICDPSTART, gen_dp_length, dp_param,
+                       dp_options_core, dp_scores_protein);
+  *score = SCORE(E_STATE, GT_MOD4(gen_dp_length), ref_dp_length);
+  gth_backtrace_path_set_alphatype(backtrace_path, PROTEIN_ALPHA);
+  rval = find_optimal_path(backtrace_path, dpm, ref_dp_length, gen_seq_tran,
+                           gen_dp_length, false, NULL, transtable, false,
+                           dp_options_core->noicinintroncheck, gen_alphabet,
+                           ref_seq_orig, NULL);
+
+  gth_dp_scores_protein_delete(dp_scores_protein);
+  dp_tables_free(dpm);
+  gth_dp_param_delete(dp_param);
+  gt_array_delete(gen_ranges);
+  gth_stat_delete(stat);
+  gth_dp_options_core_delete(dp_options_core);
+  gth_splice_site_model_delete(splice_site_model);
+  return rval;
+}
+
+/* align <gen_seq_tran> and <ref_seq_orig> once with the complete backtrace
+   table and once with a backtrace table limited to one megabyte, which is
+   small enough to force the checkpointed backtrace */
+static int protein_test_compare_backtraces(const GtUchar *gen_seq_tran,
+                                           GtUword gen_dp_length,
+                                           const GtUchar *ref_seq_orig,
+                                           GtUword ref_dp_length,
+                                           GtAlphabet *gen_alphabet,
+                                           GtScoreMatrix *score_matrix,
+                                           GtAlphabet *score_matrix_alpha,
+                                           const GtTransTable *transtable,
+                                           GtError *err)
+{
+  GthBacktracePath *full, *limited;
+  bool checkpoints;
+  GthFlt full_score, limited_score;
+  int had_err = 0;
+  gt_error_check(err);
+
+  full = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  limited = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  gt_ensure(!protein_test_backtrace(full, gen_seq_tran, gen_dp_length,
+                                    ref_seq_orig, ref_dp_length, gen_alphabet,
+                                    score_matrix, score_matrix_alpha,
+                                    transtable, 0, gth_dp_kernel_best(),
+                                    &checkpoints, &full_score));
+  gt_ensure(!checkpoints);
+  if (!had_err) {
+    gt_ensure(!protein_test_backtrace(limited, gen_seq_tran, gen_dp_length,
+                                      ref_seq_orig, ref_dp_length,
+                                      gen_alphabet, score_matrix,
+                                      score_matrix_alpha, transtable, 1,
+                                      gth_dp_kernel_best(), &checkpoints,
+                                      &limited_score));
+    gt_ensure(checkpoints);
+  }
+  gt_ensure(full_score == limited_score);
+  gt_ensure(gth_backtrace_path_length(full) > 0);
+  gt_ensure(gth_backtrace_path_length(full) ==
+            gth_backtrace_path_length(limited));
+  gt_ensure(!memcmp(gth_backtrace_path_get(full),
+                    gth_backtrace_path_get(limited),
+                    sizeof (Editoperation) * gth_backtrace_path_length(full)));
+  gth_backtrace_path_delete(limited);
+  gth_backtrace_path_delete(full);
+  return had_err;
+}
+
+/* align <gen_seq_tran> and <ref_seq_orig> with every vectorized DP kernel
+   supported by the CPU and compare the results with the scalar kernel */
+static int protein_test_compare_kernels(const GtUchar *gen_seq_tran,
+                                        GtUword gen_dp_length,
+                                        const GtUchar *ref_seq_orig,
+                                        GtUword ref_dp_length,
+                                        GtAlphabet *gen_alphabet,
+                                        GtScoreMatrix *score_matrix,
+                                        GtAlphabet *score_matrix_alpha,
+                                        const GtTransTable *transtable,
+                                        GtError *err)
+{
+  GthBacktracePath *scalar, *vectorized;
+  GthDPKernel kernel;
+  bool checkpoints;
+  GthFlt scalar_score, vectorized_score;
+  int had_err = 0;
+  gt_error_check(err);
+
+  scalar = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+  gt_ensure(!protein_test_backtrace(scalar, gen_seq_tran, gen_dp_length,
+                                    ref_seq_orig, ref_dp_length, gen_alphabet,
+                                    score_matrix, score_matrix_alpha,
+                                    transtable, 0, GTH_DP_KERNEL_SCALAR,
+                                    &checkpoints, &scalar_score));
+  for (kernel = GTH_DP_KERNEL_SCALAR + 1;
+       !had_err && kernel < GTH_NUM_OF_DP_KERNELS; kernel++) {
+    if (!gth_dp_kernel_is_supported(kernel))
+      continue;
+    vectorized = gth_backtrace_path_new(0, gen_dp_length, 0, ref_dp_length);
+    gt_ensure(!protein_test_backtrace(vectorized, gen_seq_tran, gen_dp_length,
+                                      ref_seq_orig, ref_dp_length,
+                                      gen_alphabet, score_matrix,
+                                      score_matrix_alpha, transtable, 0,
+                                      kernel, &checkpoints,
+                                      &vectorized_score));
+    gt_ensure(scalar_score == vectorized_score);
+    gt_ensure(gth_backtrace_path_length(scalar) ==
+              gth_backtrace_path_length(vectorized));
+    gt_ensure(!memcmp(gth_backtrace_path_get(scalar),
+                      gth_backtrace_path_get(vectorized),
+                      sizeof (Editoperation) *
+                      gth_backtrace_path_length(scalar)));
+    gth_backtrace_path_delete(vectorized);
+  }
+  gth_backtrace_path_delete(scalar);
+  return had_err;
+}
+
+static void protein_test_random_codon(GtUchar *codon,
+                                      const GtTransTable *transtable,
+                                      char *amino)
+{
+  static const char *dna = "acgt";
+  do {
+    codon[0] = (GtUchar) gt_rand_max(3);
+    codon[1] = (GtUchar) gt_rand_max(3);
+    codon[2] = (GtUchar) gt_rand_max(3);
+  } while (gt_trans_table_is_stop_codon(transtable, dna[codon[0]],
+                                        dna[codon[1]], dna[codon[2]]));
+  (void) gt_trans_table_translate_codon(transtable, dna[codon[0]],
+                                        dna[codon[1]], dna[codon[2]], amino,
+                                        NULL);
+}
+
+int gth_align_protein_unit_test(GtError *err)
+{
+  GtAlphabet *gen_alphabet, *score_matrix_alpha;
+  GtScoreMatrix *score_matrix;
+  GtTransTable *transtable;
+  GtUchar *gen_seq_tran, *ref_seq_orig, *gen_ptr;
+  GtUword i, e, gen_dp_length, ref_dp_length, numofchars;
+  unsigned int a, b;
+  char amino;
+  int had_err = 0;
+  gt_error_check(err);
+
+  gen_alphabet = gt_alphabet_new_dna();
+  score_matrix_alpha = gt_alphabet_new_protein();
+  score_matrix = gt_score_matrix_new(score_matrix_alpha);
+  for (a = 0; a < gt_alphabet_size(score_matrix_alpha); a++) {
+    for (b = 0; b < gt_alphabet_size(score_matrix_alpha); b++) {
+      gt_score_matrix_set_score(score_matrix, a, b,
+                                a == b ? GTH_ALIGN_PROTEIN_TEST_MATCHSCORE
+                                       : GTH_ALIGN_PROTEIN_TEST_MISMATCHSCORE);
+    }
+  }
+  transtable = gt_trans_table_new(GTH_DEFAULT_TRANSLATIONTABLE, NULL);
+  gt_assert(transtable);
+
+  /* a gene with introns: the protein is the translation of the exons, in the
+     genomic sequence they are separated by GT-AG introns and some of the
+     codons are replaced */
+  ref_dp_length = GTH_ALIGN_PROTEIN_TEST_NUMOFEXONS *
+                  GTH_ALIGN_PROTEIN_TEST_EXONLENGTH;
+  gen_dp_length = 2 * GTH_ALIGN_PROTEIN_TEST_FLANKLENGTH +
+                  GT_MULT2(ref_dp_length) + ref_dp_length +
+                  (GTH_ALIGN_PROTEIN_TEST_NUMOFEXONS - 1) *
+                  GTH_ALIGN_PROTEIN_TEST_INTRONLENGTH;
+  gen_seq_tran = gt_malloc(sizeof (GtUchar) * gen_dp_length);
+  ref_seq_orig = gt_malloc(sizeof (GtUchar) * ref_dp_length);
+  for (i = 0; i < gen_dp_length; i++)
+    gen_seq_tran[i] = (GtUchar) gt_rand_max(3);
+  gen_ptr = gen_seq_tran + GTH_ALIGN_PROTEIN_TEST_FLANKLENGTH;
+  for (e = 0; e < GTH_ALIGN_PROTEIN_TEST_NUMOFEXONS; e++) {
+    for (i = 0; i < GTH_ALIGN_PROTEIN_TEST_EXONLENGTH; i++) {
+      protein_test_random_codon(gen_ptr, transtable, &amino);
+      ref_seq_orig[e * GTH_ALIGN_PROTEIN_TEST_EXONLENGTH + i] =
+        (GtUchar) amino;
+      if (!gt_rand_max(19)) {
+        /* replace the codon, the amino acid is likely to change */
+        protein_test_random_codon(gen_ptr, transtable, &amino);
+      }
+      gen_ptr += GT_CODON_LENGTH;
+    }
+    if (e + 1 < GTH_ALIGN_PROTEIN_TEST_NUMOFEXONS) {
+      gen_ptr[0] = 2; /* G */
+      gen_ptr[1] = 3; /* T */
+      gen_ptr[GTH_ALIGN_PROTEIN_TEST_INTRONLENGTH - 2] = 0; /* A */
+      gen_ptr[GTH_ALIGN_PROTEIN_TEST_INTRONLENGTH - 1] = 2; /* G */
+      gen_ptr += GTH_ALIGN_PROTEIN_TEST_INTRONLENGTH;
+    }
+  }
+  had_err = protein_test_compare_backtraces(gen_seq_tran, gen_dp_length,
+                                            ref_seq_orig, ref_dp_length,
+                                            gen_alphabet, score_matrix,
+                                            score_matrix_alpha, transtable,
+                                            err);
+
+  /* unrelated sequences whose lengths are no multiples of the block size */
+  numofchars = gt_alphabet_num_of_chars(score_matrix_alpha);
+  if (!had_err) {
+    for (i = 0; i < gen_dp_length; i++)
+      gen_seq_tran[i] = (GtUchar) gt_rand_max(3);
+    for (i = 0; i < ref_dp_length; i++) {
+      ref_seq_orig[i] = gt_alphabet_decode(score_matrix_alpha,
+                                           gt_rand_max(numofchars - 1));
+    }
+    had_err = protein_test_compare_backtraces(gen_seq_tran, gen_dp_length - 117,
+                                              ref_seq_orig, ref_dp_length - 13,
+                                              gen_alphabet, score_matrix,
+                                              score_matrix_alpha, transtable,
+                                              err);
+  }
+
+  /* the vectorized kernels on the gene */
+  if (!had_err) {
+    had_err = protein_test_compare_kernels(gen_seq_tran, gen_dp_length,
+                                           ref_seq_orig, ref_dp_length,
+                                           gen_alphabet, score_matrix,
+                                           score_matrix_alpha, transtable,
+                                           err);
+  }
+
+  /* the vectorized kernels on short random sequences, most reference lengths
+     are no multiples of the vector width; in every second case the reference
+     is the mutated translation of a part of the genomic sequence (which has to
+     be longer than the U12 consensus, see dp_param.c). The genomic sequence
+     contains some wildcards. */
+  for (i = 1; !had_err && i <= GTH_ALIGN_PROTEIN_TEST_MAXSHORTLENGTH; i++) {
+    GtUword gen_length = GT_CODON_LENGTH * i + 8 + gt_rand_max(3 * i), j;
+    for (j = 0; j < gen_length; j++)
+      gen_seq_tran[j] = (GtUchar) gt_rand_max(3);
+    for (j = 0; j < i; j++) {
+      if (i % 2 && gt_rand_max(9)) {
+        protein_test_random_codon(gen_seq_tran + GT_CODON_LENGTH * j,
+                                  transtable, &amino);
+        ref_seq_orig[j] = (GtUchar) amino;
+      }
+      else {
+        ref_seq_orig[j] = gt_alphabet_decode(score_matrix_alpha,
+                                             gt_rand_max(numofchars - 1));
+      }
+    }
+    for (j = 0; j < gen_length; j++) {
+      if (!gt_rand_max(29))
+        gen_seq_tran[j] = (GtUchar) (gt_alphabet_size(gen_alphabet) - 1);
+    }
+    had_err = protein_test_compare_kernels(gen_seq_tran, gen_length,
+                                           ref_seq_orig, i, gen_alphabet,
+                                           score_matrix, score_matrix_alpha,
+                                           transtable, err);
+  }
+
+  gt_free(ref_seq_orig);
+  gt_free(gen_seq_tran);
+  gt_trans_table_delete(transtable);
+  gt_score_matrix_delete(score_matrix);
+  gt_alphabet_delete(score_matrix_alpha);
+  gt_alphabet_delete(gen_alphabet);
+  return had_err;
+}
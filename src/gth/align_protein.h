@@ -87,4 +87,23 @@ int gth_align_protein(GthSA*,
                       GthStat*,
                       GtFile*);
 
+/* The following function evaluates the DP of gth_align_protein() for the given
+   sequences, without computing the spliced alignment itself. It is used to
+   benchmark the DP kernels. */
+int gth_align_protein_fill(GtArray *gen_ranges,
+                           const unsigned char *gen_seq_tran,
+                           const unsigned char *ref_seq_orig,
+                           GtUword ref_dp_length,
+                           GtAlphabet *gen_alphabet,
+                           GtScoreMatrix *score_matrix,
+                           GtAlphabet *score_matrix_alpha,
+                           bool proteinexonpenal,
+                           GtUword translationtable,
+                           const GtRange *gen_seq_bounds,
+                           GthSpliceSiteModel *splice_site_model,
+                           GthDPOptionsCore *dp_options_core,
+                           GthStat*);
+
+int gth_align_protein_unit_test(GtError*);
+
 #endif
@@ -19,6 +19,7 @@
 #define ALIGN_PROTEIN_IMP_H
 
 #include "gth/align_protein.h"
+#include "gth/dp_simd.h"
 
 #define WSIZE_PROTEIN   20
 #define WSIZE_DNA       60 /* (3 * WSIZE_PROTEIN) */
@@ -73,11 +74,46 @@ typedef enum {
   NUMOFRETRACE
 } Retrace;
 
+/* the number of rows the recurrences look back */
+#define PROTEIN_CHECKPOINTROWS    (PROTEIN_NUMOFSCORETABLES - 1)
+
+/* the following structure stores the DP state of the last
+   PROTEIN_CHECKPOINTROWS rows of every block of <blockrows> rows of the genomic
+   sequence. If it is used, the backtrace table only keeps the rows of one block
+   and the other blocks are recomputed from these checkpoints during the
+   backtracing */
+typedef struct {
+  GthFlt *score[PROTEIN_NUMOFSTATES];
+  GtUword *intronstart_A,
+          *intronstart_B,
+          *intronstart_C,
+          *exonstart,                  /* NULL if proteinexonpenal is false */
+          blockrows,                   /* number of rows per block */
+          numofblocks,
+          currentblock;                /* block currently in the backtrace
+                                          table */
+  unsigned char *splitcodon_B,
+                *splitcodon_C1,
+                *splitcodon_C2;
+  bool store;                          /* store checkpoints while computing */
+  /* the input of the DP, necessary to recompute a block */
+  GthAlignInputProtein *input;
+  bool proteinexonpenal;
+  const unsigned char *gen_seq_tran;
+  GtUword gen_dp_length,
+          ref_dp_length;
+  GthDPParam *dp_param;
+  GthDPOptionsCore *dp_options_core;
+  GthDPScoresProtein *dp_scores_protein;
+} DPtablecheckpoints;
+
 /* the following structure bundles core all tables involved in the DP */
 typedef struct {
   /* table to store the score of a path */
   GthFlt *score[PROTEIN_NUMOFSTATES][PROTEIN_NUMOFSCORETABLES];
   GthPath **path; /* backtrace table of size gen_dp_length * ref_dp_length */
+  DPtablecheckpoints *checkpoints; /* NULL if the backtrace table is
+                                      complete */
 } DPtablecore;
 
 /* structure of a path matrix byte:
@@ -99,6 +135,63 @@ typedef struct {
 #define IB_STATE_MASK     0x20    /* |0010|0000| */
 #define IC_STATE_MASK     0x40    /* |0100|0000| */
 
+/* the following structure bundles the input and the output of the evaluation
+   of those DP recurrences of row <n> which do not depend on other columns of
+   the same row. That is, the IA, IB, and IC states and the maxima over the
+   transitions into the E state before and after the E_M transition. These are
+   evaluated column parallel, afterwards the E_M transition is evaluated column
+   by column. */
+struct GthDPRowProtein {
+  GtUword n,
+          ref_dp_length,
+          dpminexonlength,
+          dpminintronlength;
+  double shortexonpenalty,
+         shortintronpenalty;
+  bool last,                       /* <n> is the last row */
+       IA_N3M_weighted,            /* add <IA_N3M_weight> */
+       I_N1_weighted;              /* add <I_N1_weight> to the IA_N1, IB_N1,
+                                      and IC_N1 transitions */
+  /* the weights of the transitions */
+  GthFlt E_N3M_weight,
+         E_N2M_weight,
+         E_N1M_weight,
+         E_N3_weight,
+         E_N2_weight,
+         E_N1_weight,
+         IA_N3M_weight,
+         I_N1_weight,
+         I_E_weight;
+  /* the scores of the columns for the codon ending in row <n> and for a
+     deletion */
+  const GthFlt *codonscore,
+               *dashscore;
+  /* the split codons of introns starting in row <n> */
+  unsigned char newsplitcodon_B,
+                newsplitcodon_C1,
+                newsplitcodon_C2;
+  /* the rows <n> - d for d = 0, ..., PROTEIN_NUMOFSCORETABLES - 1 */
+  GthFlt *score[PROTEIN_NUMOFSTATES][PROTEIN_NUMOFSCORETABLES];
+  GtUword *intronstart_A[PROTEIN_NUMOFSCORETABLES],
+          *intronstart_B[PROTEIN_NUMOFSCORETABLES],
+          *intronstart_C[PROTEIN_NUMOFSCORETABLES],
+          *exonstart[PROTEIN_NUMOFSCORETABLES]; /* NULL if there is no penalty
+                                                   for short exons */
+  unsigned char *splitcodon_B[PROTEIN_NUMOFSCORETABLES],
+                *splitcodon_C1[PROTEIN_NUMOFSCORETABLES],
+                *splitcodon_C2[PROTEIN_NUMOFSCORETABLES];
+  /* the values of the IB_N2M and IC_N1M transitions (minus infinity if
+     undefined), which are computed beforehand */
+  const GthFlt *E_IB_N2M,
+               *E_IC_N1M;
+  /* the output for the E state */
+  GthFlt *E_max_before,            /* over E_N3M, E_N2M, and E_N1M */
+         *E_max_after;             /* over E_N3 to IC_N1M */
+  GthPath *E_retrace_before,
+          *E_retrace_after,
+          *I_retrace;              /* the IA, IB, and IC bits of the path */
+};
+
 /* the following structure bundles all tables involved in the dynamic
    programming for proteins */
 struct GthDPtables {
@@ -60,6 +60,30 @@
           }                                                                    \
         }
 
+/* Variant of gth_array2dim_plain_malloc() which allocates only <BUFROWS> rows
+   of memory and maps row <i> of the <ROWS> rows onto buffer row
+   <i> % <BUFROWS>. Can be deleted with gth_array2dim_plain_delete(). */
+
+#define gth_array2dim_plain_malloc_cyclic(ARRAY2DIM, ROWS, BUFROWS, COLUMNS)   \
+        {                                                                      \
+          GtUword gth_a2d_i;                                             \
+          ARRAY2DIM = malloc(sizeof *ARRAY2DIM * (ROWS));                      \
+          if (ARRAY2DIM) {                                                     \
+            (ARRAY2DIM)[0] = malloc(sizeof **ARRAY2DIM * (BUFROWS) *           \
+                                    (COLUMNS));                                \
+            if ((ARRAY2DIM)[0]) {                                              \
+              for (gth_a2d_i = 1; gth_a2d_i < (ROWS); gth_a2d_i++) {           \
+                (ARRAY2DIM)[gth_a2d_i] = (ARRAY2DIM)[0] +                      \
+                                         (gth_a2d_i % (BUFROWS)) * (COLUMNS);  \
+              }                                                                \
+            }                                                                  \
+            else {                                                             \
+              free(ARRAY2DIM);                                                 \
+              ARRAY2DIM = NULL;                                                \
+            }                                                                  \
+          }                                                                    \
+        }
+
 #define gth_array2dim_plain_delete(ARRAY2DIM) \
         free((ARRAY2DIM)[0]);                 \
         free(ARRAY2DIM);
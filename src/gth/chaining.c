@@ -17,6 +17,7 @@
 
 #include "core/unused_api.h"
 #include "gth/chaining.h"
+#include "gth/seed_matcher.h"
 
 #define POLYATAILFILTERALPHASIZE                4
 #define SHOW_CHAIN_CALCULATION_STATUS_BUF_SIZE  160
@@ -614,28 +615,35 @@ int gth_match_processor(GthMatchProcessorInfo *info, GthSeqCon *gen_seq_con,
   return 0;
 }
 
-void gth_chaining(GthChainCollection *chain_collection,
-                  GtUword gen_file_num,
-                  GtUword ref_file_num,
-                  GthCallInfo *call_info,
-                  GthInput *input,
-                  GthStat *stat,
-                  bool directmatches,
-                  const GthPlugins *plugins)
+int gth_chaining(GthChainCollection *chain_collection,
+                 GtUword gen_file_num,
+                 GtUword ref_file_num,
+                 GthCallInfo *call_info,
+                 GthInput *input,
+                 GthStat *stat,
+                 bool directmatches,
+                 const GthPlugins *plugins,
+                 GtError *err)
 {
   GtUword i, numofsequences = 0;
   GtArray *matches;
   GthChainingInfo chaining_info;
-  void *matcher_arguments;
+  void *matcher_arguments = NULL;
   GtFile *outfp = call_info->out->outfp;
   GthMatchProcessorInfo match_processor_info;
-  bool refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+  bool refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num),
+       builtinmatcher;
 
-  /* make sure matcher is defined */
+  gt_error_check(err);
+
+  /* use the built-in matcher if requested or if no matcher plugin is given */
   gt_assert(plugins);
-  gt_assert(plugins->matcher_arguments_new);
-  gt_assert(plugins->matcher_arguments_delete);
-  gt_assert(plugins->matcher_runner);
+  builtinmatcher = call_info->simfilterparam.builtinmatcher ||
+                   !plugins->matcher_runner;
+
+  /* make sure matcher is defined */
+  gt_assert(builtinmatcher || plugins->matcher_arguments_new);
+  gt_assert(builtinmatcher || plugins->matcher_arguments_delete);
 
   /* init */
   matches = gt_array_new(sizeof (GthMatch));
@@ -643,36 +651,40 @@ void gth_chaining(GthChainCollection *chain_collection,
   chaining_info_init(&chaining_info, directmatches, refseqisdna, call_info,
                      input, stat, gen_file_num, ref_file_num);
 
-  matcher_arguments =
-    plugins->matcher_arguments_new(true,
-                          input,
-                          call_info->simfilterparam.inverse || !refseqisdna
-                          ? gth_input_get_genomic_filename(input, gen_file_num)
-                          : gth_input_get_reference_filename(input,
-                                                             ref_file_num),
-                          call_info->simfilterparam.inverse || !refseqisdna
-                          ? gth_input_get_reference_filename(input,
-                                                             ref_file_num)
-                          : gth_input_get_genomic_filename(input, gen_file_num),
-                          directmatches,
-                          refseqisdna,
-                          call_info->progname,
-                          gt_str_get(gth_input_proteinsmap(input)),
-                          call_info->simfilterparam.exact,
-                          call_info->simfilterparam.edist,
-                          false,
-                          0,
-                          call_info->simfilterparam.minmatchlength,
-                          call_info->simfilterparam.seedlength,
-                          call_info->simfilterparam.exdrop,
-                          call_info->simfilterparam.prminmatchlen,
-                          call_info->simfilterparam.prseedlength,
-                          call_info->simfilterparam.prhdist,
-                          call_info->translationtable,
-                          call_info->simfilterparam.online,
-                          call_info->simfilterparam.noautoindex,
-                          call_info->simfilterparam.maskpolyAtails,
-                          false);
+  if (!builtinmatcher) {
+    matcher_arguments =
+      plugins->matcher_arguments_new(true,
+                            input,
+                            call_info->simfilterparam.inverse || !refseqisdna
+                            ? gth_input_get_genomic_filename(input,
+                                                             gen_file_num)
+                            : gth_input_get_reference_filename(input,
+                                                               ref_file_num),
+                            call_info->simfilterparam.inverse || !refseqisdna
+                            ? gth_input_get_reference_filename(input,
+                                                               ref_file_num)
+                            : gth_input_get_genomic_filename(input,
+                                                             gen_file_num),
+                            directmatches,
+                            refseqisdna,
+                            call_info->progname,
+                            gt_str_get(gth_input_proteinsmap(input)),
+                            call_info->simfilterparam.exact,
+                            call_info->simfilterparam.edist,
+                            false,
+                            0,
+                            call_info->simfilterparam.minmatchlength,
+                            call_info->simfilterparam.seedlength,
+                            call_info->simfilterparam.exdrop,
+                            call_info->simfilterparam.prminmatchlen,
+                            call_info->simfilterparam.prseedlength,
+                            call_info->simfilterparam.prhdist,
+                            call_info->translationtable,
+                            call_info->simfilterparam.online,
+                            call_info->simfilterparam.noautoindex,
+                            call_info->simfilterparam.maskpolyAtails,
+                            false);
+  }
 
   match_processor_info_init(&match_processor_info, matches, chain_collection,
                             directmatches, refseqisdna,
@@ -698,25 +710,41 @@ void gth_chaining(GthChainCollection *chain_collection,
            (size_t) numofsequences * sizeof (GtUword));
   }
 
-  /* free input, which contains the virtual trees.
-     because vmatch loads the virtual trees into memory, too.
-     this prevents that the virtual trees are loaded twice. */
-  gth_input_delete_current(input);
-
-  /* call matcher */
-  if (call_info->out->showverbose)
-    call_info->out->showverbose("call vmatch to compute matches");
-
-  plugins->matcher_runner(matcher_arguments, call_info->out->showverbose,
-                          call_info->out->showverboseVM, &match_processor_info);
-
-  /* free matcher stuff here, because otherwise the reference file is mapped
-     twice below */
-  plugins->matcher_arguments_delete(matcher_arguments);
-
-  /* free sequence collections (if they have been filled by the matcher) */
-  gth_seq_con_delete(match_processor_info.gen_seq_con);
-  gth_seq_con_delete(match_processor_info.ref_seq_con);
+  if (builtinmatcher) {
+    /* the built-in matcher works on the input, which stays loaded */
+    if (call_info->out->showverbose) {
+      call_info->out->showverbose("compute matches with the built-in "
+                                  "matcher");
+    }
+    if (gth_seed_matcher_run(input, gen_file_num, ref_file_num, directmatches,
+                             call_info, &match_processor_info, err)) {
+      gt_free(match_processor_info.matchnumcounter);
+      gt_array_delete(matches);
+      return -1;
+    }
+  }
+  else {
+    /* free input, which contains the virtual trees.
+       because vmatch loads the virtual trees into memory, too.
+       this prevents that the virtual trees are loaded twice. */
+    gth_input_delete_current(input);
+
+    /* call matcher */
+    if (call_info->out->showverbose)
+      call_info->out->showverbose("call vmatch to compute matches");
+
+    plugins->matcher_runner(matcher_arguments, call_info->out->showverbose,
+                            call_info->out->showverboseVM,
+                            &match_processor_info);
+
+    /* free matcher stuff here, because otherwise the reference file is mapped
+       twice below */
+    plugins->matcher_arguments_delete(matcher_arguments);
+
+    /* free sequence collections (if they have been filled by the matcher) */
+    gth_seq_con_delete(match_processor_info.gen_seq_con);
+    gth_seq_con_delete(match_processor_info.ref_seq_con);
+  }
 
   /* save match numbers of match number distribution, if necessary */
   if (gth_stat_get_matchnumdistri(stat)) {
@@ -736,14 +764,16 @@ void gth_chaining(GthChainCollection *chain_collection,
     if (call_info->out->comments)
       gt_file_xprintf(outfp, "%c no match has been found\n", COMMENTCHAR);
     gt_array_delete(matches);
-    return;
+    return 0;
   }
 
-  /* load genomic file back into memory */
-  gth_input_load_genomic_file(input, gen_file_num, true);
+  if (!builtinmatcher) {
+    /* load genomic file back into memory */
+    gth_input_load_genomic_file(input, gen_file_num, true);
 
-  /* load reference file back into memory */
-  gth_input_load_reference_file(input, ref_file_num, true);
+    /* load reference file back into memory */
+    gth_input_load_reference_file(input, ref_file_num, true);
+  }
 
   /* compute chains from matches */
   calc_chains_from_matches(chain_collection, matches, &chaining_info,
@@ -765,4 +795,5 @@ void gth_chaining(GthChainCollection *chain_collection,
 
   /* free */
   gt_array_delete(matches);
+  return 0;
 }
@@ -53,6 +53,7 @@
 #define GTH_DEFAULT_SKIPINDEXCHECK     false
 #define GTH_DEFAULT_MASKPOLYATAILS     false
 #define GTH_DEFAULT_MAXNUMOFMATCHES    0
+#define GTH_DEFAULT_BUILTINMATCHER     false
 
 #define GTH_DEFAULT_FRAGWEIGHTFACTOR   0.5
 #define GTH_DEFAULT_GCMAXGAPWIDTH      1000000
@@ -102,6 +103,7 @@
 #define GTH_DEFAULT_DPMININTRONLENGTH    50
 #define GTH_DEFAULT_SHORTEXONPENALTY     100.0
 #define GTH_DEFAULT_SHORTINTRONPENALTY   100.0
+#define GTH_DEFAULT_MAXBTMATRIXSIZE      0
 
 #define GTH_DEFAULT_JTOVERLAP            5
 #define GTH_DEFAULT_JTDEBUG              false
@@ -20,6 +20,7 @@
 
 #include <stdbool.h>
 #include "core/range_api.h"
+#include "gth/dp_simd.h"
 
 typedef struct {
   bool noicinintroncheck,         /* perform no check if intron coutout is in
@@ -30,6 +31,9 @@ typedef struct {
                dpminintronlength; /* minimum intron length */
   double shortexonpenalty,        /* penalty for short exons */
          shortintronpenalty;      /* penalty for short introns */
+  GtUword maxbtmatrixsize;        /* maximum size of the backtrace table in
+                                     megabytes (0 = unlimited) */
+  GthDPKernel dpkernel;           /* kernel used to evaluate the DP */
   GtRange btmatrixgenrange,
           btmatrixrefrange;
   GtUword jtoverlap;
@@ -26,15 +26,21 @@ typedef struct {
   GthFlt **score;
 } GthDPScoresProtein;
 
+static inline GtUchar GTHGETAMINO(GthDPScoresProtein *scores,
+                                  GtUchar n1, GtUchar n2, GtUchar n3)
+{
+  if (n1 == DASH || n2 == DASH || n3 == DASH)
+    return DASH;
+  else if (n1 > 3 || n2 > 3 || n3 > 3)
+    return WILDCARD;
+  return scores->codon2amino[n1][n2][n3];
+}
+
 static inline GthFlt GTHGETSCORE(GthDPScoresProtein *scores,
                                  GtUchar n1, GtUchar n2, GtUchar n3,
                                  GtUchar aa)
 {
-  if (n1 == DASH || n2 == DASH || n3 == DASH)
-    return scores->score[DASH][aa];
-  else if (n1 > 3 || n2 > 3 || n3 > 3)
-    return scores->score[WILDCARD][aa];
-  return scores->score[scores->codon2amino[n1][n2][n3]][aa];
+  return scores->score[GTHGETAMINO(scores, n1, n2, n3)][aa];
 }
 
 GthDPScoresProtein* gth_dp_scores_protein_new(GtUword translationtable,
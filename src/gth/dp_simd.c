@@ -0,0 +1,381 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/assert_api.h"
+#include "gth/align_dna_imp.h"
+#include "gth/align_protein_imp.h"
+#include "gth/dp_simd.h"
+
+#ifdef GTH_DP_SIMD
+
+#include <immintrin.h>
+
+/* The kernels are generated from dp_simd_dna.gen and dp_simd_protein.gen for
+   every instruction set with the following macros, which operate on vectors of
+   doubles (VD), floats (VF), the doubles corresponding to one half of a
+   vector of floats (VFD), and GtUwords (VI, one per double of VD and VFD) and
+   bytes (VB, one per float of VF). Blends return the second argument for the
+   lanes which are set in the mask, and the first one otherwise. */
+
+/* SSE4.2 */
+
+#define DP_SIMD_TARGET              __attribute__((target("sse4.2")))
+#define DP_SIMD_FUNC(F)             F##_sse4_2
+
+#define VD                          __m128d
+#define VD_WIDTH                    2
+#define VD_SET1(X)                  _mm_set1_pd(X)
+#define VD_LOAD(P)                  _mm_loadu_pd(P)
+#define VD_LOADF(P)\
+        _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64((const __m128i*) (P))))
+#define VD_STOREF(P, X)\
+        _mm_storel_epi64((__m128i*) (P), _mm_castps_si128(_mm_cvtpd_ps(X)))
+#define VD_STORE_CODES(P, X)        sse4_2_store_codes_2(P, _mm_cvtpd_epi32(X))
+#define VD_ADD(X, Y)                _mm_add_pd(X, Y)
+#define VD_SUB(X, Y)                _mm_sub_pd(X, Y)
+#define VD_ROUNDF(X)                _mm_cvtps_pd(_mm_cvtpd_ps(X))
+#define VD_CMPLT(X, Y)              _mm_cmplt_pd(X, Y)
+#define VD_BLEND(X, Y, MASK)        _mm_blendv_pd(X, Y, MASK)
+#define VD_UWORD_LT(N, P, MIN)\
+        _mm_castsi128_pd(_mm_cmpgt_epi64(MIN, _mm_sub_epi64(N, VI_LOAD(P))))
+
+#define VF                          __m128
+#define VF_WIDTH                    4
+#define VF_SET1(X)                  _mm_set1_ps(X)
+#define VF_LOAD(P)                  _mm_loadu_ps(P)
+#define VF_STORE(P, X)              _mm_storeu_ps(P, X)
+#define VF_STORE_CODES(P, X)        sse4_2_store_codes_4(P, _mm_cvtps_epi32(X))
+#define VF_ADD(X, Y)                _mm_add_ps(X, Y)
+#define VF_SUB_DBL(X, Y)            sse4_2_sub_dbl(X, Y)
+#define VF_CMPLT(X, Y)              _mm_cmplt_ps(X, Y)
+#define VF_BLEND(X, Y, MASK)        _mm_blendv_ps(X, Y, MASK)
+#define VF_UWORD_LT(N, P, MIN)      sse4_2_uword_lt(N, P, MIN)
+#define VF_UWORD_BLEND_STORE(DEST, P, X, MASK)\
+        sse4_2_uword_blend_store(DEST, P, X, MASK)
+#define VF_BYTE_BLEND_STORE(DEST, P, X, MASK)\
+        sse4_2_byte_blend_store(DEST, P, X, MASK)
+
+#define VFD                         __m128d
+#define VFD_SET1(X)                 _mm_set1_pd(X)
+
+#define VI                          __m128i
+#define VI_SET1(X)                  _mm_set1_epi64x((long long) (X))
+#define VI_LOAD(P)                  _mm_loadu_si128((const __m128i*) (P))
+#define VI_STORE(P, X)              _mm_storeu_si128((__m128i*) (P), X)
+#define VI_BLEND(X, Y, MASK)\
+        _mm_castpd_si128(_mm_blendv_pd(_mm_castsi128_pd(X),\
+                                       _mm_castsi128_pd(Y), MASK))
+
+#define VB                          __m128i
+#define VB_SET1(X)                  _mm_set1_epi8((char) (X))
+
+/* store the 2 integers in the lower half of <codes> as bytes */
+DP_SIMD_TARGET
+static inline void sse4_2_store_codes_2(GthPath *dest, __m128i codes)
+{
+  short bytes;
+  codes = _mm_packus_epi16(_mm_packs_epi32(codes, codes), codes);
+  bytes = (short) _mm_extract_epi16(codes, 0);
+  memcpy(dest, &bytes, sizeof bytes);
+}
+
+/* store the 4 integers of <codes> as bytes */
+DP_SIMD_TARGET
+static inline void sse4_2_store_codes_4(GthPath *dest, __m128i codes)
+{
+  int bytes;
+  codes = _mm_packus_epi16(_mm_packs_epi32(codes, codes), codes);
+  bytes = _mm_cvtsi128_si32(codes);
+  memcpy(dest, &bytes, sizeof bytes);
+}
+
+DP_SIMD_TARGET
+static inline __m128 sse4_2_sub_dbl(__m128 x, __m128d y)
+{
+  return _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_cvtps_pd(x), y)),
+                       _mm_cvtpd_ps(_mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(x,
+                                                                          x)),
+                                               y)));
+}
+
+DP_SIMD_TARGET
+static inline __m128 sse4_2_uword_lt(__m128i n, const GtUword *p, __m128i min)
+{
+  __m128i lower = _mm_cmpgt_epi64(min, _mm_sub_epi64(n, VI_LOAD(p))),
+          upper = _mm_cmpgt_epi64(min, _mm_sub_epi64(n, VI_LOAD(p + 2)));
+  return _mm_shuffle_ps(_mm_castsi128_ps(lower), _mm_castsi128_ps(upper),
+                        _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+DP_SIMD_TARGET
+static inline void sse4_2_uword_blend_store(GtUword *dest, const GtUword *p,
+                                            __m128i x, __m128 mask)
+{
+  __m128i m = _mm_castps_si128(mask);
+  VI_STORE(dest, _mm_blendv_epi8(VI_LOAD(p), x, _mm_cvtepi32_epi64(m)));
+  VI_STORE(dest + 2, _mm_blendv_epi8(VI_LOAD(p + 2), x,
+                                     _mm_cvtepi32_epi64(_mm_srli_si128(m,
+                                                                       8))));
+}
+
+DP_SIMD_TARGET
+static inline void sse4_2_byte_blend_store(unsigned char *dest,
+                                           const unsigned char *p, __m128i x,
+                                           __m128 mask)
+{
+  __m128i m = _mm_castps_si128(mask);
+  int bytes;
+  m = _mm_packs_epi16(_mm_packs_epi32(m, m), m);
+  memcpy(&bytes, p, sizeof bytes);
+  bytes = _mm_cvtsi128_si32(_mm_blendv_epi8(_mm_cvtsi32_si128(bytes), x, m));
+  memcpy(dest, &bytes, sizeof bytes);
+}
+
+#include "gth/dp_simd_dna.gen"
+#include "gth/dp_simd_protein.gen"
+
+#undef DP_SIMD_TARGET
+#undef DP_SIMD_FUNC
+#undef VD
+#undef VD_WIDTH
+#undef VD_SET1
+#undef VD_LOAD
+#undef VD_LOADF
+#undef VD_STOREF
+#undef VD_STORE_CODES
+#undef VD_ADD
+#undef VD_SUB
+#undef VD_ROUNDF
+#undef VD_CMPLT
+#undef VD_BLEND
+#undef VD_UWORD_LT
+#undef VF
+#undef VF_WIDTH
+#undef VF_SET1
+#undef VF_LOAD
+#undef VF_STORE
+#undef VF_STORE_CODES
+#undef VF_ADD
+#undef VF_SUB_DBL
+#undef VF_CMPLT
+#undef VF_BLEND
+#undef VF_UWORD_LT
+#undef VF_UWORD_BLEND_STORE
+#undef VF_BYTE_BLEND_STORE
+#undef VFD
+#undef VFD_SET1
+#undef VI
+#undef VI_SET1
+#undef VI_LOAD
+#undef VI_STORE
+#undef VI_BLEND
+#undef VB
+#undef VB_SET1
+
+/* AVX2 */
+
+#define DP_SIMD_TARGET              __attribute__((target("avx2")))
+#define DP_SIMD_FUNC(F)             F##_avx2
+
+#define VD                          __m256d
+#define VD_WIDTH                    4
+#define VD_SET1(X)                  _mm256_set1_pd(X)
+#define VD_LOAD(P)                  _mm256_loadu_pd(P)
+#define VD_LOADF(P)                 _mm256_cvtps_pd(_mm_loadu_ps(P))
+#define VD_STOREF(P, X)             _mm_storeu_ps(P, _mm256_cvtpd_ps(X))
+#define VD_STORE_CODES(P, X)        avx2_store_codes_4(P, _mm256_cvtpd_epi32(X))
+#define VD_ADD(X, Y)                _mm256_add_pd(X, Y)
+#define VD_SUB(X, Y)                _mm256_sub_pd(X, Y)
+#define VD_ROUNDF(X)                _mm256_cvtps_pd(_mm256_cvtpd_ps(X))
+#define VD_CMPLT(X, Y)              _mm256_cmp_pd(X, Y, _CMP_LT_OS)
+#define VD_BLEND(X, Y, MASK)        _mm256_blendv_pd(X, Y, MASK)
+#define VD_UWORD_LT(N, P, MIN)\
+        _mm256_castsi256_pd(_mm256_cmpgt_epi64(MIN,\
+                                               _mm256_sub_epi64(N,\
+                                                                VI_LOAD(P))))
+
+#define VF                          __m256
+#define VF_WIDTH                    8
+#define VF_SET1(X)                  _mm256_set1_ps(X)
+#define VF_LOAD(P)                  _mm256_loadu_ps(P)
+#define VF_STORE(P, X)              _mm256_storeu_ps(P, X)
+#define VF_STORE_CODES(P, X)        avx2_store_codes_8(P, _mm256_cvtps_epi32(X))
+#define VF_ADD(X, Y)                _mm256_add_ps(X, Y)
+#define VF_SUB_DBL(X, Y)            avx2_sub_dbl(X, Y)
+#define VF_CMPLT(X, Y)              _mm256_cmp_ps(X, Y, _CMP_LT_OS)
+#define VF_BLEND(X, Y, MASK)        _mm256_blendv_ps(X, Y, MASK)
+#define VF_UWORD_LT(N, P, MIN)      avx2_uword_lt(N, P, MIN)
+#define VF_UWORD_BLEND_STORE(DEST, P, X, MASK)\
+        avx2_uword_blend_store(DEST, P, X, MASK)
+#define VF_BYTE_BLEND_STORE(DEST, P, X, MASK)\
+        avx2_byte_blend_store(DEST, P, X, MASK)
+
+#define VFD                         __m256d
+#define VFD_SET1(X)                 _mm256_set1_pd(X)
+
+#define VI                          __m256i
+#define VI_SET1(X)                  _mm256_set1_epi64x((long long) (X))
+#define VI_LOAD(P)                  _mm256_loadu_si256((const __m256i*) (P))
+#define VI_STORE(P, X)              _mm256_storeu_si256((__m256i*) (P), X)
+#define VI_BLEND(X, Y, MASK)\
+        _mm256_castpd_si256(_mm256_blendv_pd(_mm256_castsi256_pd(X),\
+                                             _mm256_castsi256_pd(Y), MASK))
+
+#define VB                          __m128i
+#define VB_SET1(X)                  _mm_set1_epi8((char) (X))
+
+/* store the 4 integers of <codes> as bytes */
+DP_SIMD_TARGET
+static inline void avx2_store_codes_4(GthPath *dest, __m128i codes)
+{
+  int bytes;
+  codes = _mm_packus_epi16(_mm_packs_epi32(codes, codes), codes);
+  bytes = _mm_cvtsi128_si32(codes);
+  memcpy(dest, &bytes, sizeof bytes);
+}
+
+/* store the 8 integers of <codes> as bytes */
+DP_SIMD_TARGET
+static inline void avx2_store_codes_8(GthPath *dest, __m256i codes)
+{
+  __m128i bytes = _mm_packs_epi32(_mm256_castsi256_si128(codes),
+                                  _mm256_extracti128_si256(codes, 1));
+  _mm_storel_epi64((__m128i*) dest, _mm_packus_epi16(bytes, bytes));
+}
+
+DP_SIMD_TARGET
+static inline __m256 avx2_sub_dbl(__m256 x, __m256d y)
+{
+  __m128 lower, upper;
+  lower = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_cvtps_pd(
+                                          _mm256_castps256_ps128(x)), y));
+  upper = _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_cvtps_pd(
+                                          _mm256_extractf128_ps(x, 1)), y));
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(lower), upper, 1);
+}
+
+DP_SIMD_TARGET
+static inline __m256 avx2_uword_lt(__m256i n, const GtUword *p, __m256i min)
+{
+  __m256i lower = _mm256_cmpgt_epi64(min, _mm256_sub_epi64(n, VI_LOAD(p))),
+          upper = _mm256_cmpgt_epi64(min, _mm256_sub_epi64(n, VI_LOAD(p + 4)));
+  /* the masks of the GtUwords consist of two equal halves, take one of each */
+  return _mm256_castsi256_ps(
+           _mm256_permutevar8x32_epi32(_mm256_blend_epi32(lower, upper, 0xaa),
+                                       _mm256_setr_epi32(0, 2, 4, 6,
+                                                         1, 3, 5, 7)));
+}
+
+DP_SIMD_TARGET
+static inline void avx2_uword_blend_store(GtUword *dest, const GtUword *p,
+                                          __m256i x, __m256 mask)
+{
+  __m256i m = _mm256_castps_si256(mask);
+  VI_STORE(dest, _mm256_blendv_epi8(VI_LOAD(p), x,
+                                    _mm256_cvtepi32_epi64(
+                                      _mm256_castsi256_si128(m))));
+  VI_STORE(dest + 4, _mm256_blendv_epi8(VI_LOAD(p + 4), x,
+                                        _mm256_cvtepi32_epi64(
+                                          _mm256_extracti128_si256(m, 1))));
+}
+
+DP_SIMD_TARGET
+static inline void avx2_byte_blend_store(unsigned char *dest,
+                                         const unsigned char *p, __m128i x,
+                                         __m256 mask)
+{
+  __m256i m = _mm256_castps_si256(mask);
+  __m128i bytemask = _mm_packs_epi32(_mm256_castsi256_si128(m),
+                                     _mm256_extracti128_si256(m, 1));
+  bytemask = _mm_packs_epi16(bytemask, bytemask);
+  _mm_storel_epi64((__m128i*) dest,
+                   _mm_blendv_epi8(_mm_loadl_epi64((const __m128i*) p), x,
+                                   bytemask));
+}
+
+#include "gth/dp_simd_dna.gen"
+#include "gth/dp_simd_protein.gen"
+
+#endif
+
+static const char *dp_kernel_names[] = {
+  "scalar",
+  "sse4.2",
+  "avx2"
+};
+
+bool gth_dp_kernel_is_supported(GthDPKernel kernel)
+{
+  gt_assert(kernel < GTH_NUM_OF_DP_KERNELS);
+#ifdef GTH_DP_SIMD
+  __builtin_cpu_init();
+  switch (kernel) {
+    case GTH_DP_KERNEL_SSE4_2:
+      return __builtin_cpu_supports("sse4.2") ? true : false;
+    case GTH_DP_KERNEL_AVX2:
+      return __builtin_cpu_supports("avx2") ? true : false;
+    default:
+      break;
+  }
+#endif
+  return kernel == GTH_DP_KERNEL_SCALAR;
+}
+
+GthDPKernel gth_dp_kernel_best(void)
+{
+  if (gth_dp_kernel_is_supported(GTH_DP_KERNEL_AVX2))
+    return GTH_DP_KERNEL_AVX2;
+  if (gth_dp_kernel_is_supported(GTH_DP_KERNEL_SSE4_2))
+    return GTH_DP_KERNEL_SSE4_2;
+  return GTH_DP_KERNEL_SCALAR;
+}
+
+const char* gth_dp_kernel_name(GthDPKernel kernel)
+{
+  gt_assert(kernel < GTH_NUM_OF_DP_KERNELS);
+  return dp_kernel_names[kernel];
+}
+
+GthDPRowDNAFunc gth_dp_kernel_row_dna(GthDPKernel kernel)
+{
+  gt_assert(gth_dp_kernel_is_supported(kernel));
+  switch (kernel) {
+#ifdef GTH_DP_SIMD
+    case GTH_DP_KERNEL_SSE4_2:
+      return dp_simd_row_dna_sse4_2;
+    case GTH_DP_KERNEL_AVX2:
+      return dp_simd_row_dna_avx2;
+#endif
+    default:
+      return NULL;
+  }
+}
+
+GthDPRowProteinFunc gth_dp_kernel_row_protein(GthDPKernel kernel)
+{
+  gt_assert(gth_dp_kernel_is_supported(kernel));
+  switch (kernel) {
+#ifdef GTH_DP_SIMD
+    case GTH_DP_KERNEL_SSE4_2:
+      return dp_simd_row_protein_sse4_2;
+    case GTH_DP_KERNEL_AVX2:
+      return dp_simd_row_protein_avx2;
+#endif
+    default:
+      return NULL;
+  }
+}
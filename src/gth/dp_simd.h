@@ -0,0 +1,63 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef DP_SIMD_H
+#define DP_SIMD_H
+
+#include <stdbool.h>
+#include "core/types_api.h"
+
+/* The vectorized kernels are only available for x86-64 compilers which support
+   target specific functions. */
+#if defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define GTH_DP_SIMD
+#endif
+
+/* The kernels which can be used to evaluate the DP recurrences of the spliced
+   aligners. The vectorized kernels produce exactly the same results as the
+   scalar one. */
+typedef enum {
+  GTH_DP_KERNEL_SCALAR = 0,
+  GTH_DP_KERNEL_SSE4_2,
+  GTH_DP_KERNEL_AVX2,
+  GTH_NUM_OF_DP_KERNELS
+} GthDPKernel;
+
+/* The rows of the DP for cDNAs/ESTs and proteins, see align_dna_imp.h and
+   align_protein_imp.h. */
+typedef struct GthDPRowDNA GthDPRowDNA;
+typedef struct GthDPRowProtein GthDPRowProtein;
+
+/* Evaluate the column parallel part of the DP recurrences of <row> for the
+   columns 1 to <n> - 1, where <n> is returned. */
+typedef GtUword (*GthDPRowDNAFunc)(GthDPRowDNA *row);
+typedef GtUword (*GthDPRowProteinFunc)(GthDPRowProtein *row);
+
+/* Return the fastest kernel supported by the CPU we are running on. */
+GthDPKernel         gth_dp_kernel_best(void);
+/* Return <true> if <kernel> is supported by the CPU we are running on. */
+bool                gth_dp_kernel_is_supported(GthDPKernel kernel);
+/* Return the name of <kernel>. */
+const char*         gth_dp_kernel_name(GthDPKernel kernel);
+/* Return the row function of <kernel> for cDNAs/ESTs, or NULL for the scalar
+   kernel. */
+GthDPRowDNAFunc     gth_dp_kernel_row_dna(GthDPKernel kernel);
+/* Return the row function of <kernel> for proteins, or NULL for the scalar
+   kernel. */
+GthDPRowProteinFunc gth_dp_kernel_row_protein(GthDPKernel kernel);
+
+#endif
@@ -45,7 +45,7 @@ int gt_gth(int argc, const char **argv, const GthPlugins *plugins, GtError *err)
                             (const char**) argv, false, NULL, stat,
                             gth_show_on_stdout, gth_show_on_stdout_vmatch,
                             plugins->gth_version_func, plugins->jump_table_new,
-                            err)) {
+                            plugins->matcher_runner, err)) {
     case GT_OPTION_PARSER_OK: break;
     case GT_OPTION_PARSER_ERROR:
       gth_stat_delete(stat);
@@ -99,7 +99,7 @@ int gt_gthconsensus(int argc, const char **argv, const GthPlugins *plugins,
                             (const char**) argv, true, consensusfiles, stat,
                             gth_show_on_stdout, gth_show_on_stdout_vmatch,
                             plugins->gth_version_func, plugins->jump_table_new,
-                            err)) {
+                            plugins->matcher_runner, err)) {
     case GT_OPTION_PARSER_OK: break;
     case GT_OPTION_PARSER_ERROR:
       gt_str_array_delete(consensusfiles);
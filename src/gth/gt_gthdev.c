@@ -0,0 +1,33 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/option_api.h"
+#include "core/versionfunc.h"
+#include "gt_config.h"
+#include "gth/gt_gth.h"
+#include "gth/gt_gthdev.h"
+#include "gth/seq_con_encseq.h"
+
+int gt_gthdev(int argc, const char **argv, GtError *err)
+{
+  GthPlugins plugins = { 0 };
+  gt_error_check(err);
+  plugins.file_preprocessor = gth_seq_con_encseq_preprocess;
+  plugins.seq_con_new = gth_seq_con_encseq_new;
+  plugins.gth_version = GT_VERSION;
+  plugins.gth_version_func = gt_versionfunc;
+  return gt_gth(argc, argv, &plugins, err);
+}
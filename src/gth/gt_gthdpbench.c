@@ -0,0 +1,241 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <sys/time.h>
+#include "core/alphabet.h"
+#include "core/ma.h"
+#include "core/mathsupport.h"
+#include "core/score_matrix.h"
+#include "core/unused_api.h"
+#include "gth/align_dna.h"
+#include "gth/align_protein.h"
+#include "gth/default.h"
+#include "gth/dp_simd.h"
+#include "gth/gt_gthdpbench.h"
+
+#define GTHDPBENCH_MATCHSCORE     4
+#define GTHDPBENCH_MISMATCHSCORE  -1
+
+typedef struct {
+  GtUword genlength,
+          reflength,
+          runs;
+} GthDPBenchArguments;
+
+typedef struct {
+  GtArray *gen_ranges;
+  GtRange gen_seq_bounds;
+  GtUchar *gen_seq_tran,
+          *ref_seq_tran,
+          *ref_seq_orig;
+  GtAlphabet *gen_alphabet,
+             *score_matrix_alpha;
+  GtScoreMatrix *score_matrix;
+  GthSpliceSiteModel *splice_site_model;
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GthStat *stat;
+} GthDPBenchData;
+
+static void* gt_gthdpbench_arguments_new(void)
+{
+  return gt_calloc(1, sizeof (GthDPBenchArguments));
+}
+
+static void gt_gthdpbench_arguments_delete(void *tool_arguments)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  if (!arguments) return;
+  gt_free(arguments);
+}
+
+static GtOptionParser* gt_gthdpbench_option_parser_new(void *tool_arguments)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  GtOptionParser *op;
+  GtOption *option;
+
+  gt_assert(arguments);
+
+  op = gt_option_parser_new("[option ...]", "Benchmark the DP kernels of the "
+                            "spliced aligners on random sequences and show "
+                            "the evaluated cells per second.");
+
+  option = gt_option_new_uword_min("genlength", "length of the genomic DNA "
+                                   "sequence", &arguments->genlength, 20000,
+                                   1);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("reflength", "length of the cDNA and "
+                                   "protein sequence", &arguments->reflength,
+                                   2000, 1);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword_min("runs", "number of DPs evaluated per "
+                                    "kernel, the fastest one is shown",
+                                    &arguments->runs, 3, 1);
+  gt_option_parser_add_option(op, option);
+
+  gt_option_parser_set_max_args(op, 0);
+
+  return op;
+}
+
+static void random_sequence(GtUchar *seq, GtUword length, GtAlphabet *alphabet)
+{
+  GtUword i, numofchars = gt_alphabet_num_of_chars(alphabet);
+  for (i = 0; i < length; i++)
+    seq[i] = (GtUchar) gt_rand_max(numofchars - 1);
+}
+
+static void bench_data_init(GthDPBenchData *data,
+                            const GthDPBenchArguments *arguments)
+{
+  GtAlphabet *protein_alpha;
+  GtRange range;
+  unsigned int i, j, numofchars;
+
+  data->gen_alphabet = gt_alphabet_new_dna();
+  data->gen_seq_tran = gt_malloc(sizeof (GtUchar) * arguments->genlength);
+  random_sequence(data->gen_seq_tran, arguments->genlength,
+                  data->gen_alphabet);
+  data->ref_seq_tran = gt_malloc(sizeof (GtUchar) * arguments->reflength);
+  random_sequence(data->ref_seq_tran, arguments->reflength,
+                  data->gen_alphabet);
+  range.start = 0;
+  range.end = arguments->genlength - 1;
+  data->gen_seq_bounds = range;
+  data->gen_ranges = gt_array_new(sizeof (GtRange));
+  gt_array_add(data->gen_ranges, range);
+
+  /* the protein sequence is stored with its original characters and scored
+     with a simple match/mismatch matrix */
+  protein_alpha = gt_alphabet_new_protein();
+  data->ref_seq_orig = gt_malloc(sizeof (GtUchar) * arguments->reflength);
+  random_sequence(data->ref_seq_orig, arguments->reflength, protein_alpha);
+  for (i = 0; i < arguments->reflength; i++) {
+    data->ref_seq_orig[i] = gt_alphabet_decode(protein_alpha,
+                                               data->ref_seq_orig[i]);
+  }
+  data->score_matrix_alpha = protein_alpha;
+  data->score_matrix = gt_score_matrix_new(protein_alpha);
+  numofchars = gt_alphabet_size(protein_alpha);
+  for (i = 0; i < numofchars; i++) {
+    for (j = 0; j < numofchars; j++) {
+      gt_score_matrix_set_score(data->score_matrix, i, j,
+                                i == j ? GTHDPBENCH_MATCHSCORE
+                                       : GTHDPBENCH_MISMATCHSCORE);
+    }
+  }
+
+  data->splice_site_model = gth_splice_site_model_new();
+  data->dp_options_core = gth_dp_options_core_new();
+  data->dp_options_est = gth_dp_options_est_new();
+  data->stat = gth_stat_new();
+}
+
+static void bench_data_delete(GthDPBenchData *data)
+{
+  gth_stat_delete(data->stat);
+  gth_dp_options_est_delete(data->dp_options_est);
+  gth_dp_options_core_delete(data->dp_options_core);
+  gth_splice_site_model_delete(data->splice_site_model);
+  gt_score_matrix_delete(data->score_matrix);
+  gt_alphabet_delete(data->score_matrix_alpha);
+  gt_free(data->ref_seq_orig);
+  gt_array_delete(data->gen_ranges);
+  gt_free(data->ref_seq_tran);
+  gt_free(data->gen_seq_tran);
+  gt_alphabet_delete(data->gen_alphabet);
+}
+
+static int bench_fill(GthDPBenchData *data, bool protein, GtUword reflength)
+{
+  if (protein) {
+    return gth_align_protein_fill(data->gen_ranges, data->gen_seq_tran,
+                                  data->ref_seq_orig, reflength,
+                                  data->gen_alphabet, data->score_matrix,
+                                  data->score_matrix_alpha, false,
+                                  GTH_DEFAULT_TRANSLATIONTABLE,
+                                  &data->gen_seq_bounds,
+                                  data->splice_site_model,
+                                  data->dp_options_core, data->stat);
+  }
+  return gth_align_dna_fill(data->gen_ranges, data->gen_seq_tran,
+                            data->ref_seq_tran, reflength, data->gen_alphabet,
+                            &data->gen_seq_bounds, data->splice_site_model,
+                            data->dp_options_core, data->dp_options_est,
+                            data->stat);
+}
+
+static int gt_gthdpbench_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
+                                GT_UNUSED int parsed_args, void *tool_arguments,
+                                GtError *err)
+{
+  GthDPBenchArguments *arguments = tool_arguments;
+  GthDPBenchData data;
+  GthDPKernel kernel;
+  GtUword r;
+  double cells;
+  int p, had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments);
+
+  bench_data_init(&data, arguments);
+  cells = (double) arguments->genlength * arguments->reflength;
+  printf("# DP of " GT_WU " x " GT_WU " cells, fastest of " GT_WU " runs\n",
+         arguments->genlength, arguments->reflength, arguments->runs);
+  for (p = 0; !had_err && p < 2; p++) {
+    for (kernel = GTH_DP_KERNEL_SCALAR;
+         !had_err && kernel < GTH_NUM_OF_DP_KERNELS; kernel++) {
+      double seconds, best = 0.0;
+      struct timeval start, stop;
+      if (!gth_dp_kernel_is_supported(kernel))
+        continue;
+      data.dp_options_core->dpkernel = kernel;
+      for (r = 0; !had_err && r < arguments->runs; r++) {
+        gettimeofday(&start, NULL);
+        if (bench_fill(&data, p, arguments->reflength)) {
+          gt_error_set(err, "could not allocate the DP matrix");
+          had_err = -1;
+        }
+        gettimeofday(&stop, NULL);
+        seconds = (stop.tv_sec - start.tv_sec) +
+                  (stop.tv_usec - start.tv_usec) / 1000000.0;
+        if (r == 0 || seconds < best)
+          best = seconds;
+      }
+      if (!had_err) {
+        printf("%-7s  %-6s  %8.3fs  %10.2f Mcells/s\n",
+               p ? "protein" : "dna", gth_dp_kernel_name(kernel), best,
+               best > 0.0 ? cells / best / 1000000.0 : 0.0);
+      }
+    }
+  }
+  bench_data_delete(&data);
+
+  return had_err;
+}
+
+GtTool* gt_gthdpbench(void)
+{
+  return gt_tool_new(gt_gthdpbench_arguments_new,
+                     gt_gthdpbench_arguments_delete,
+                     gt_gthdpbench_option_parser_new,
+                     NULL,
+                     gt_gthdpbench_runner);
+}
@@ -48,7 +48,9 @@ typedef struct {
        paralogs,                 /* compute paralogous genes
                                     (different chaining procedure) */
        enrichchains,             /* enrich chains with additional matches */
-       stopafterchaining;        /* stop gth after chaining phase */
+       stopafterchaining,        /* stop gth after chaining phase */
+       builtinmatcher;           /* compute the matches in-process instead of
+                                    calling vmatch */
   bool jump_table;               /* use jump table in DP */
   Introncutoutinfo introncutoutinfo; /* parameter for intron cutout */
 } Gthsimfilterparam;
@@ -16,6 +16,7 @@
 */
 
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "gth/default.h"
 #include "gth/gthdef.h"
@@ -93,7 +94,8 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
                            GthShowVerbose showverbose,
                            GthShowVerboseVM showverboseVM,
                            GtShowVersionFunc show_version,
-                           GthJumpTableNew jump_table_new, GtError *err)
+                           GthJumpTableNew jump_table_new,
+                           GthMatcherRunner matcher_runner, GtError *err)
 {
   GtUword i;
   int ret, mode;
@@ -156,6 +158,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optinverse = NULL,              /* sim. filter, vmatch */
          *optexact = NULL,                /* sim. filter, vmatch */
          *optedist = NULL,                /* sim. filter, vmatch */
+         *optbuiltinmatcher = NULL,       /* sim. filter, built-in matcher */
          *optmaxnumofmatches = NULL,      /* sim. filter, vmatch */
          *optfragweightfactor = NULL,     /* sim. filter, before gl. chaining */
          *optgcmaxgapwidth = NULL,        /* sim. filter, global chaining */
@@ -185,6 +188,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optdpminintronlength = NULL,    /* short exon/intron parameters */
          *optshortexonpenalty = NULL,     /* short exon/intron parameters */
          *optshortintronpenalty = NULL,   /* short exon/intron parameters */
+         *optmaxbtmatrixsize = NULL,      /* basic DP algorithm */
          *optbtmatrixgenrange = NULL,
          *optbtmatrixrefrange = NULL,
          *optjtoverlap = NULL,
@@ -220,6 +224,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optrefseqcovdistri = NULL,      /* statistics */
          *optmatchnumdistri = NULL,       /* statistics */
          *optfirstalshown = NULL,         /* miscellaneous */
+         *optjobs = NULL,                 /* miscellaneous */
          *optshoweops = NULL;             /* testing */
   GtOPrval oprval;
 
@@ -646,6 +651,26 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optedist);
   }
 
+  /* -builtinmatcher */
+  if (!gthconsensus_parsing) {
+    optbuiltinmatcher = gt_option_new_bool("builtinmatcher", "compute the "
+                                           "matches of the similarity filter "
+                                           "in-process with an in-memory "
+                                           "suffix array of the genomic "
+                                           "sequences instead of calling "
+                                           "vmatch (like vmatch, the seeds "
+                                           "are extended with -exdrop or "
+                                           "-prhdist, unless -exact is given; "
+                                           "-online, -inverse, -edist, and "
+                                           "-maskpolyatails are not "
+                                           "supported)",
+                                           &call_info->simfilterparam
+                                           .builtinmatcher,
+                                           GTH_DEFAULT_BUILTINMATCHER);
+    gt_option_is_extended_option(optbuiltinmatcher);
+    gt_option_parser_add_option(op, optbuiltinmatcher);
+  }
+
   /* -maxnumofmatches */
   if (!gthconsensus_parsing) {
     optmaxnumofmatches = gt_option_new_uword("maxnumofmatches", "set the "
@@ -983,6 +1008,21 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optshortintronpenalty);
   }
 
+  /* -maxbtmatrixsize */
+  if (!gthconsensus_parsing) {
+    optmaxbtmatrixsize = gt_option_new_uword("maxbtmatrixsize", "set the "
+                                             "maximum size of the backtrace "
+                                             "matrix in megabytes, larger DPs "
+                                             "are backtraced in less space by "
+                                             "recomputing parts of the matrix "
+                                             "from checkpoints (0 = unlimited)",
+                                             &call_info->dp_options_core
+                                             ->maxbtmatrixsize,
+                                             GTH_DEFAULT_MAXBTMATRIXSIZE);
+    gt_option_is_extended_option(optmaxbtmatrixsize);
+    gt_option_parser_add_option(op, optmaxbtmatrixsize);
+  }
+
   /* -btmatrixgenrage */
   if (!gthconsensus_parsing) {
     optbtmatrixgenrange = gt_option_new_range("btmatrixgenrange", "set the "
@@ -1251,6 +1291,15 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optfirstalshown);
   }
 
+  /* -j */
+  if (!gthconsensus_parsing) {
+    optjobs = gt_option_new_uint_min("j", "set the number of threads used to "
+                                     "compute the spliced alignments of "
+                                     "different chains", &gt_jobs, gt_jobs, 1);
+    gt_option_is_extended_option(optjobs);
+    gt_option_parser_add_option(op, optjobs);
+  }
+
   /* -showeops */
   if (!gthconsensus_parsing) {
     optshoweops = gt_option_new_bool("showeops", "show complete array of multi "
@@ -1440,10 +1489,27 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
       oprval = GT_OPTION_PARSER_ERROR;
     }
 
+    /* the built-in matcher does not support the options which are specific
+       to vmatch */
+    if (oprval == GT_OPTION_PARSER_OK &&
+        (call_info->simfilterparam.builtinmatcher || !matcher_runner)) {
+      GtOption *vmatch_options[] = { optonline, optinverse, optedist,
+                                     optmaskpolyatails };
+      for (i = 0; i < sizeof vmatch_options / sizeof vmatch_options[0]; i++) {
+        if (gt_option_is_set(vmatch_options[i])) {
+          gt_error_set(err, "option \"-%s\" is not supported by the built-in "
+                       "matcher", gt_option_get_name(vmatch_options[i]));
+          oprval = GT_OPTION_PARSER_ERROR;
+          break;
+        }
+      }
+    }
+
     /* if optfrompos is set, we set optinverse automatically. This is more
        intuitive for the user (instead of requiring him to set -inverse) */
     if (oprval == GT_OPTION_PARSER_OK && gt_option_is_set(optfrompos) &&
-        !gt_option_is_set(optinverse)) {
+        !gt_option_is_set(optinverse) &&
+        !call_info->simfilterparam.builtinmatcher && matcher_runner) {
       call_info->simfilterparam.inverse = true;
     }
   }
@@ -22,16 +22,19 @@
 #include "gth/call_info.h"
 #include "gth/input.h"
 #include "gth/jump_table.h"
+#include "gth/matcher.h"
 #include "gth/stat.h"
 
 #define FROMPOS_OPT_CSTR  "frompos"
 
 /* The following function parses the arguments given by the <argv> array of
-   length <argc>. */
+   length <argc>. If <matcher_runner> is NULL the built-in matcher is used (see
+   gth/seed_matcher.h) and the options which are specific to vmatch are
+   rejected. */
 GtOPrval gth_parse_options(GthCallInfo*, GthInput*, int *parsed_args, int argc,
                            const char **argv, bool gthconsensus_parsing,
                            GtStrArray *consensusfiles, GthStat*, GthShowVerbose,
                            GthShowVerboseVM, GtShowVersionFunc, GthJumpTableNew,
-                           GtError*);
+                           GthMatcherRunner matcher_runner, GtError*);
 
 #endif
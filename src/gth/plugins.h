@@ -27,9 +27,11 @@
 typedef struct {
   GthInputFilePreprocessor file_preprocessor;         /* required */
   GthSeqConConstructor seq_con_new;                   /* required */
-  GthMatcherArgumentsNew matcher_arguments_new;       /* required */
-  GthMatcherArgumentsDelete matcher_arguments_delete; /* required */
-  GthMatcherRunner matcher_runner;                    /* required */
+  /* the matcher methods are optional, the built-in matcher (see
+     gth/seed_matcher.h) is used if <matcher_runner> is NULL */
+  GthMatcherArgumentsNew matcher_arguments_new;
+  GthMatcherArgumentsDelete matcher_arguments_delete;
+  GthMatcherRunner matcher_runner;
   const char *gth_version;                            /* required */
   GtShowVersionFunc gth_version_func;                 /* required */
 
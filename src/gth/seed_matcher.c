@@ -0,0 +1,647 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/array3dim.h"
+#include "core/chardef.h"
+#include "core/codon_api.h"
+#include "core/encseq_api.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
+#include "core/trans_table.h"
+#include "core/unused_api.h"
+#include "match/esa-mmsearch.h"
+#include "match/seqabstract.h"
+#include "match/xdrop.h"
+#include "gth/seed_matcher.h"
+
+/* the number of reference sequences per thread which are matched at once */
+#define GTH_SEQS_PER_THREAD  64
+
+#define GTH_NUM_OF_FRAMES    3
+
+/* the scores used for the X-drop extension of DNA seeds. They correspond to
+   unit edit costs, like the extension of vmatch */
+static const GtXdropArbitraryscores seed_xdrop_scores = { 2, -1, -2, -2 };
+
+/* a sequence of the index, i.e. a genomic sequence or one of its translated
+   reading frames */
+typedef struct {
+  GtUword gen_seq_num,
+          gen_offset,
+          gen_length;
+  unsigned int frame;
+} GthSeedIndexSeq;
+
+typedef struct {
+  GtEncseq *encseq;
+  GtQuerysubstringmatcher *matcher;
+  GtArray *seqs; /* of GthSeedIndexSeq, one for every sequence in <encseq> */
+  bool protein;
+} GthSeedIndex;
+
+/* the data shared by all threads. The reference sequences of a batch are
+   fetched from the sequence collection beforehand, such that the threads do
+   not access it */
+typedef struct {
+  const GthSeedIndex *index;
+  GtUword seedlength,
+          minmatchlength,
+          xdrop,
+          hdist,
+          startseqnum;
+  unsigned int numofchars; /* of the reference alphabet */
+  bool directmatches,
+       use_substring_spec,
+       extend; /* extend the seeds, unless exact matches are demanded */
+  GtRange gen_substring; /* the considered genomic region, if
+                            <use_substring_spec> is true */
+  const GtUchar **ref_seqs;
+  GtRange *ref_ranges;
+  GtArray **matchestab; /* one array of matches per reference sequence */
+  GtError **errtab; /* set if matching a reference sequence failed */
+  bool *haserrtab;
+} GthSeedMatcherBatch;
+
+/* the data of a single reference sequence */
+typedef struct {
+  const GthSeedMatcherBatch *batch;
+  GtArray *matches;
+  GtXdropresources *xdropresources;
+  GtSeqabstract *sa_useq,
+                *sa_vseq;
+  GtUword ref_seq_num,
+          ref_offset,
+          ref_length;
+} GthSeedMatcherQuery;
+
+/* a match in the coordinates of the query and of the sequence of the index */
+typedef struct {
+  GtUword querystart,
+          querylen,
+          dbstart, /* absolute position in the index */
+          dblen;
+  GtWord score;
+} GthSeedMatch;
+
+/* Copies the transformed sequence <seq> of length <len> to <dest> and replaces
+   all characters which are not contained in an alphabet of size <numofchars>
+   by the wildcard. If <rc> is true, the reverse complement is copied. */
+static void copy_tran_seq(GtUchar *dest, const GtUchar *seq, GtUword len,
+                          unsigned int numofchars, bool rc)
+{
+  GtUword i;
+  GtUchar cc;
+
+  for (i = 0; i < len; i++) {
+    cc = rc ? seq[len - 1 - i] : seq[i];
+    if (cc >= (GtUchar) numofchars)
+      dest[i] = (GtUchar) WILDCARD;
+    else
+      dest[i] = rc ? (GtUchar) (numofchars - 1) - cc : cc;
+  }
+}
+
+static GtUchar*** codon2amino_new(GtUword translationtable,
+                                  GtAlphabet *dna_alpha,
+                                  GtAlphabet *protein_alpha)
+{
+  GtUchar ***codon2amino;
+  GtTransTable *transtable;
+  unsigned int x, y, z, numofchars;
+  GT_UNUSED int rval;
+  char amino;
+
+  gt_array3dim_malloc(codon2amino, 4, 4, 4);
+  transtable = gt_trans_table_new(translationtable, NULL);
+  /* XXX: the validity of the translation table has to be checked before */
+  gt_assert(transtable);
+  numofchars = gt_alphabet_num_of_chars(protein_alpha);
+  for (x = 0; x <= 3; x++) {
+    for (y = 0; y <= 3; y++) {
+      for (z = 0; z <= 3; z++) {
+        rval = gt_trans_table_translate_codon(transtable,
+                                              gt_alphabet_decode(dna_alpha, x),
+                                              gt_alphabet_decode(dna_alpha, y),
+                                              gt_alphabet_decode(dna_alpha, z),
+                                              &amino, NULL);
+        gt_assert(!rval);
+        /* stop codons terminate matches like wildcards */
+        if (amino != GT_STOP_AMINO &&
+            gt_alphabet_valid_input(protein_alpha, amino) &&
+            gt_alphabet_encode(protein_alpha, amino) < numofchars) {
+          codon2amino[x][y][z] = gt_alphabet_encode(protein_alpha, amino);
+        }
+        else
+          codon2amino[x][y][z] = (GtUchar) WILDCARD;
+      }
+    }
+  }
+  gt_trans_table_delete(transtable);
+  return codon2amino;
+}
+
+static void seed_index_add_seq(GthSeedIndex *index, GtEncseqBuilder *eb,
+                               const GtUchar *seq, GtUword len,
+                               GtUword gen_seq_num, GtRange gen_range,
+                               unsigned int frame)
+{
+  GthSeedIndexSeq index_seq;
+
+  /* the encoded sequence does not contain empty sequences */
+  if (!len)
+    return;
+  gt_encseq_builder_add_encoded_own(eb, seq, len, NULL);
+  index_seq.gen_seq_num = gen_seq_num;
+  index_seq.gen_offset = gen_range.start;
+  index_seq.gen_length = gen_range.end - gen_range.start + 1;
+  index_seq.frame = frame;
+  gt_array_add(index->seqs, index_seq);
+}
+
+static void seed_index_delete(GthSeedIndex *index)
+{
+  if (!index) return;
+  gt_querysubstringmatcher_delete(index->matcher);
+  gt_encseq_delete(index->encseq);
+  gt_array_delete(index->seqs);
+  gt_free(index);
+}
+
+/* Returns the index of the genomic sequences. Its matcher is NULL if the
+   genomic sequences contain nothing to match. Returns NULL and sets <err> if
+   the index could not be constructed. */
+static GthSeedIndex* seed_index_new(GthSeqCon *gen_seq_con,
+                                    GtAlphabet *protein_alpha,
+                                    bool directmatches,
+                                    GtUword translationtable,
+                                    GtError *err)
+{
+  GtAlphabet *dna_alpha = gth_seq_con_get_alphabet(gen_seq_con);
+  GtUword i, j, len, maxlen = 0;
+  GtUchar ***codon2amino = NULL, *buf, *dna;
+  GtEncseqBuilder *eb;
+  GthSeedIndex *index;
+  unsigned int frame;
+  int had_err = 0;
+
+  gt_error_check(err);
+  index = gt_malloc(sizeof *index);
+  index->seqs = gt_array_new(sizeof (GthSeedIndexSeq));
+  index->protein = protein_alpha != NULL;
+  index->encseq = NULL;
+  index->matcher = NULL;
+  eb = gt_encseq_builder_new(index->protein ? protein_alpha : dna_alpha);
+  gt_encseq_builder_enable_multiseq_support(eb);
+  gt_encseq_builder_disable_description_support(eb);
+  if (index->protein) {
+    codon2amino = codon2amino_new(translationtable, dna_alpha, protein_alpha);
+  }
+  for (i = 0; i < gth_seq_con_num_of_seqs(gen_seq_con); i++)
+    maxlen = MAX(maxlen, gth_seq_con_get_length(gen_seq_con, i));
+  buf = gt_malloc(sizeof (GtUchar) * maxlen * (index->protein ? 2 : 1));
+  dna = buf + (index->protein ? maxlen : 0);
+
+  for (i = 0; i < gth_seq_con_num_of_seqs(gen_seq_con); i++) {
+    GtRange range = gth_seq_con_get_range(gen_seq_con, i);
+    len = range.end - range.start + 1;
+    if (!index->protein) {
+      copy_tran_seq(buf, gth_seq_con_get_tran_seq(gen_seq_con, i), len,
+                    gt_alphabet_num_of_chars(dna_alpha), false);
+      seed_index_add_seq(index, eb, buf, len, i, range, 0);
+      continue;
+    }
+    /* translate the three reading frames of the genomic sequence, which is
+       reverse complemented for palindromic matches */
+    copy_tran_seq(dna, gth_seq_con_get_tran_seq(gen_seq_con, i), len,
+                  gt_alphabet_num_of_chars(dna_alpha), !directmatches);
+    for (frame = 0; frame < GTH_NUM_OF_FRAMES; frame++) {
+      GtUword numofcodons = len > frame ? (len - frame) / GT_CODON_LENGTH : 0;
+      for (j = 0; j < numofcodons; j++) {
+        const GtUchar *codon = dna + frame + GT_CODON_LENGTH * j;
+        if (codon[0] < 4 && codon[1] < 4 && codon[2] < 4)
+          buf[j] = codon2amino[codon[0]][codon[1]][codon[2]];
+        else
+          buf[j] = (GtUchar) WILDCARD;
+      }
+      seed_index_add_seq(index, eb, buf, numofcodons, i, range, frame);
+    }
+  }
+  gt_free(buf);
+  if (codon2amino) {
+    gt_array3dim_delete(codon2amino);
+  }
+
+  if (gt_array_size(index->seqs)) {
+    if (!(index->encseq = gt_encseq_builder_build(eb, err)))
+      had_err = -1;
+    if (!had_err &&
+        !(index->matcher = gt_querysubstringmatcher_new(index->encseq, err))) {
+      had_err = -1;
+    }
+  }
+  gt_encseq_builder_delete(eb);
+  if (had_err) {
+    seed_index_delete(index);
+    return NULL;
+  }
+  return index;
+}
+
+/* Extends the DNA seed <sm> to both sides with the X-drop algorithm. The
+   extension does not cross the boundaries of the query and of the sequence of
+   the index which starts at <seqstart> and has length <seqlength>. */
+static void extend_seed_xdrop(GthSeedMatch *sm, GthSeedMatcherQuery *query_info,
+                              const GtEncseq *encseq, const GtUchar *query,
+                              GtUword query_totallength, GtUword seqstart,
+                              GtUword seqlength)
+{
+  GtXdropbest best_left, best_right;
+  GtXdropscore xdrop = (GtXdropscore) query_info->batch->xdrop;
+  GtUword seqend = seqstart + seqlength;
+
+  if (sm->querystart > 0 && sm->dbstart > seqstart) {
+    gt_seqabstract_reinit_gtuchar(query_info->sa_useq, query, sm->querystart,
+                                  0);
+    gt_seqabstract_reinit_encseq(query_info->sa_vseq, encseq,
+                                 sm->dbstart - seqstart, 0);
+    gt_evalxdroparbitscoresextend(false, &best_left,
+                                  query_info->xdropresources,
+                                  query_info->sa_useq, query_info->sa_vseq,
+                                  sm->querystart, sm->dbstart, xdrop);
+  }
+  else {
+    best_left.ivalue = best_left.jvalue = 0;
+    best_left.score = 0;
+  }
+  if (sm->querystart + sm->querylen < query_totallength &&
+      sm->dbstart + sm->dblen < seqend) {
+    gt_seqabstract_reinit_gtuchar(query_info->sa_useq, query,
+                                  query_totallength -
+                                  (sm->querystart + sm->querylen), 0);
+    gt_seqabstract_reinit_encseq(query_info->sa_vseq, encseq,
+                                 seqend - (sm->dbstart + sm->dblen), 0);
+    gt_evalxdroparbitscoresextend(true, &best_right,
+                                  query_info->xdropresources,
+                                  query_info->sa_useq, query_info->sa_vseq,
+                                  sm->querystart + sm->querylen,
+                                  sm->dbstart + sm->dblen, xdrop);
+  }
+  else {
+    best_right.ivalue = best_right.jvalue = 0;
+    best_right.score = 0;
+  }
+  sm->querystart -= best_left.ivalue;
+  sm->querylen += best_left.ivalue + best_right.ivalue;
+  sm->dbstart -= best_left.jvalue;
+  sm->dblen += best_left.jvalue + best_right.jvalue;
+  sm->score += best_left.score + best_right.score;
+}
+
+/* Stores in <ext>[i] (for all i <= <maxmismatches>) the number of characters
+   by which a protein seed can be extended with at most i mismatches in
+   direction <forward>, starting next to <querypos> and <dbpos>. Wildcards and
+   stop codons are never matched. */
+static void hamming_extensions(GtUword *ext, GtUword maxmismatches,
+                               bool forward, const GtEncseq *encseq,
+                               const GtUchar *query, GtUword querypos,
+                               GtUword querymax, GtUword dbpos, GtUword dbmax)
+{
+  GtUword len, maxlen = MIN(querymax, dbmax), mismatches = 0;
+  GtUchar a, b;
+
+  for (len = 0; len < maxlen; len++) {
+    a = query[forward ? querypos + len : querypos - len - 1];
+    b = gt_encseq_get_encoded_char(encseq,
+                                   forward ? dbpos + len : dbpos - len - 1,
+                                   GT_READMODE_FORWARD);
+    if (a != b || ISSPECIAL(a)) {
+      if (ISSPECIAL(a) || ISSPECIAL(b))
+        break;
+      ext[mismatches++] = len;
+      if (mismatches > maxmismatches)
+        return;
+    }
+  }
+  while (mismatches <= maxmismatches)
+    ext[mismatches++] = len;
+}
+
+/* Extends the protein seed <sm> to both sides, such that it contains at most
+   <hdist> mismatches (the Hamming distance used by vmatch) and is as long as
+   possible. */
+static void extend_seed_hamming(GthSeedMatch *sm, GtUword hdist,
+                                const GtEncseq *encseq, const GtUchar *query,
+                                GtUword query_totallength, GtUword seqstart,
+                                GtUword seqlength)
+{
+  GtUword *left, *right, i, best = 0, bestleft = 0, bestright = 0;
+
+  left = gt_malloc(sizeof *left * 2 * (hdist + 1));
+  right = left + hdist + 1;
+  hamming_extensions(left, hdist, false, encseq, query, sm->querystart,
+                     sm->querystart, sm->dbstart, sm->dbstart - seqstart);
+  hamming_extensions(right, hdist, true, encseq, query,
+                     sm->querystart + sm->querylen,
+                     query_totallength - (sm->querystart + sm->querylen),
+                     sm->dbstart + sm->dblen,
+                     seqstart + seqlength - (sm->dbstart + sm->dblen));
+  for (i = 0; i <= hdist; i++) {
+    if (left[i] + right[hdist - i] > best) {
+      best = left[i] + right[hdist - i];
+      bestleft = left[i];
+      bestright = right[hdist - i];
+    }
+  }
+  gt_free(left);
+  sm->querystart -= bestleft;
+  sm->dbstart -= bestleft;
+  sm->querylen += bestleft + bestright;
+  sm->dblen = sm->querylen;
+  sm->score = (GtWord) (seed_xdrop_scores.mat * sm->querylen);
+}
+
+static int save_match(void *data, const GtEncseq *encseq,
+                      const GtQuerymatch *querymatch,
+                      const GtUchar *query,
+                      GtUword query_totallength,
+                      GT_UNUSED GtError *err)
+{
+  GthSeedMatcherQuery *query_info = data;
+  const GthSeedMatcherBatch *batch = query_info->batch;
+  const GthSeedIndexSeq *index_seq;
+  GtUword seqnum, seqstart, seqlength, seqpos;
+  GthSeedMatch sm;
+  GthMatch match;
+
+  sm.querystart = gt_querymatch_querystart(querymatch);
+  sm.querylen = sm.dblen = gt_querymatch_querylen(querymatch);
+  sm.dbstart = gt_querymatch_dbstart(querymatch);
+  sm.score = (GtWord) (seed_xdrop_scores.mat * sm.querylen);
+  seqnum = gt_encseq_seqnum(encseq, sm.dbstart);
+  seqstart = gt_encseq_seqstartpos(encseq, seqnum);
+  seqlength = gt_encseq_seqlength(encseq, seqnum);
+  index_seq = gt_array_get(batch->index->seqs, seqnum);
+
+  if (batch->extend) {
+    if (batch->index->protein) {
+      extend_seed_hamming(&sm, batch->hdist, encseq, query, query_totallength,
+                          seqstart, seqlength);
+    }
+    else {
+      extend_seed_xdrop(&sm, query_info, encseq, query, query_totallength,
+                        seqstart, seqlength);
+    }
+    if (sm.querylen < batch->minmatchlength)
+      return 0;
+  }
+  seqpos = sm.dbstart - seqstart;
+
+  match.Storescore = sm.score;
+  match.Storeseqnumreference = query_info->ref_seq_num;
+  match.Storeseqnumgenomic = index_seq->gen_seq_num;
+  match.Storelengthreference = sm.querylen;
+  if (batch->index->protein) {
+    /* the reference positions refer to the protein, the genomic positions to
+       the forward strand of the genomic sequence */
+    match.Storepositionreference = query_info->ref_offset + sm.querystart;
+    match.Storelengthgenomic = GT_CODON_LENGTH * sm.dblen;
+    seqpos = index_seq->frame + GT_CODON_LENGTH * seqpos;
+    if (!batch->directmatches)
+      seqpos = index_seq->gen_length - (seqpos + match.Storelengthgenomic);
+    match.Storepositiongenomic = index_seq->gen_offset + seqpos;
+  }
+  else {
+    /* palindromic matches are reported on the forward strand of the reference
+       sequence, they are transformed before the chaining */
+    match.Storepositionreference = query_info->ref_offset +
+                                   (batch->directmatches
+                                    ? sm.querystart
+                                    : query_info->ref_length - sm.querystart
+                                      - sm.querylen);
+    match.Storelengthgenomic = sm.dblen;
+    match.Storepositiongenomic = index_seq->gen_offset + seqpos;
+  }
+  /* discard matches outside of the region given by -frompos */
+  if (batch->use_substring_spec &&
+      (match.Storepositiongenomic < batch->gen_substring.start ||
+       match.Storepositiongenomic + match.Storelengthgenomic - 1 >
+       batch->gen_substring.end)) {
+    return 0;
+  }
+  gt_array_add(query_info->matches, match);
+  return 0;
+}
+
+static int compare_matches(const void *a, const void *b)
+{
+  const GthMatch *m1 = a, *m2 = b;
+
+  if (m1->Storepositionreference != m2->Storepositionreference)
+    return m1->Storepositionreference < m2->Storepositionreference ? -1 : 1;
+  if (m1->Storepositiongenomic != m2->Storepositiongenomic)
+    return m1->Storepositiongenomic < m2->Storepositiongenomic ? -1 : 1;
+  if (m1->Storelengthreference != m2->Storelengthreference)
+    return m1->Storelengthreference < m2->Storelengthreference ? -1 : 1;
+  if (m1->Storelengthgenomic != m2->Storelengthgenomic)
+    return m1->Storelengthgenomic < m2->Storelengthgenomic ? -1 : 1;
+  if (m1->Storeseqnumgenomic != m2->Storeseqnumgenomic)
+    return m1->Storeseqnumgenomic < m2->Storeseqnumgenomic ? -1 : 1;
+  if (m1->Storescore != m2->Storescore)
+    return m1->Storescore < m2->Storescore ? -1 : 1;
+  return 0;
+}
+
+/* Different seeds can be extended to the same match, which is kept only
+   once. */
+static void remove_duplicate_matches(GtArray *matches)
+{
+  GthMatch *space;
+  GtUword i, j = 0;
+
+  if (gt_array_size(matches) < 2)
+    return;
+  gt_array_sort_stable(matches, compare_matches);
+  space = gt_array_get_space(matches);
+  for (i = 1; i < gt_array_size(matches); i++) {
+    if (!gth_matches_are_equal(space + j, space + i))
+      space[++j] = space[i];
+  }
+  gt_array_set_size(matches, j + 1);
+}
+
+static void match_ref_seqs(GtUword start, GtUword end, void *data)
+{
+  const GthSeedMatcherBatch *batch = data;
+  GthSeedMatcherQuery query_info;
+  GtUchar *query;
+  GtUword i;
+
+  query_info.batch = batch;
+  query_info.xdropresources = gt_xdrop_resources_new(&seed_xdrop_scores);
+  query_info.sa_useq = gt_seqabstract_new_empty();
+  query_info.sa_vseq = gt_seqabstract_new_empty();
+  for (i = start; i < end; i++) {
+    query_info.matches = batch->matchestab[i];
+    query_info.ref_seq_num = batch->startseqnum + i;
+    query_info.ref_offset = batch->ref_ranges[i].start;
+    query_info.ref_length = batch->ref_ranges[i].end -
+                            batch->ref_ranges[i].start + 1;
+    query = gt_malloc(sizeof (GtUchar) * query_info.ref_length);
+    copy_tran_seq(query, batch->ref_seqs[i], query_info.ref_length,
+                  batch->numofchars,
+                  !batch->index->protein && !batch->directmatches);
+    batch->haserrtab[i]
+      = gt_querysubstringmatcher_run(batch->index->matcher, query,
+                                     query_info.ref_length,
+                                     batch->seedlength, save_match,
+                                     &query_info, batch->errtab[i]) != 0;
+    if (!batch->haserrtab[i] && batch->extend)
+      remove_duplicate_matches(query_info.matches);
+    gt_free(query);
+  }
+  gt_seqabstract_delete(query_info.sa_vseq);
+  gt_seqabstract_delete(query_info.sa_useq);
+  gt_xdrop_resources_delete(query_info.xdropresources);
+}
+
+static unsigned int seed_matcher_num_of_threads(void)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U)
+    return gt_thread_pool_size(gt_thread_pool_get());
+#endif
+  return 1U;
+}
+
+int gth_seed_matcher_run(GthInput *input,
+                         GtUword gen_file_num,
+                         GtUword ref_file_num,
+                         bool directmatches,
+                         const GthCallInfo *call_info,
+                         GthMatchProcessorInfo *match_processor_info,
+                         GtError *err)
+{
+  const Gthsimfilterparam *simfilterparam = &call_info->simfilterparam;
+  GthSeqCon *gen_seq_con, *ref_seq_con;
+  GthSeedMatcherBatch batch;
+  GthSeedIndex *index;
+  GtUword i, j, numofseqs, batchsize;
+  bool refseqisdna;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(input && call_info && match_processor_info);
+
+  gth_input_load_genomic_file(input, gen_file_num, true);
+  gth_input_load_reference_file(input, ref_file_num, true);
+  gen_seq_con = gth_input_current_gen_seq_con(input);
+  ref_seq_con = gth_input_current_ref_seq_con(input);
+  refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+
+  index = seed_index_new(gen_seq_con,
+                         refseqisdna ? NULL
+                                     : gth_seq_con_get_alphabet(ref_seq_con),
+                         directmatches, call_info->translationtable, err);
+  if (!index)
+    return -1;
+  if (!index->matcher) {
+    /* the genomic sequences contain nothing to match */
+    seed_index_delete(index);
+    return 0;
+  }
+
+  batch.index = index;
+  batch.numofchars =
+    gt_alphabet_num_of_chars(gth_seq_con_get_alphabet(ref_seq_con));
+  batch.directmatches = directmatches;
+  batch.use_substring_spec = gth_input_use_substring_spec(input);
+  if (batch.use_substring_spec) {
+    batch.gen_substring.start = gth_input_genomic_substring_from(input);
+    batch.gen_substring.end = gth_input_genomic_substring_to(input);
+  }
+  /* like vmatch, the seeds are extended with the X-drop algorithm (DNA) or
+     with at most the given Hamming distance (protein), unless exact matches
+     are demanded */
+  batch.extend = !simfilterparam->exact;
+  batch.xdrop = simfilterparam->exdrop;
+  batch.hdist = simfilterparam->prhdist;
+  if (refseqisdna) {
+    batch.minmatchlength = simfilterparam->minmatchlength;
+    batch.seedlength = simfilterparam->exact ? simfilterparam->minmatchlength
+                                             : simfilterparam->seedlength;
+  }
+  else {
+    batch.minmatchlength = simfilterparam->prminmatchlen;
+    batch.seedlength = simfilterparam->exact ? simfilterparam->prminmatchlen
+                                             : simfilterparam->prseedlength;
+  }
+  gt_assert(batch.seedlength > 0);
+
+  numofseqs = gth_seq_con_num_of_seqs(ref_seq_con);
+  batchsize = MIN((GtUword) GTH_SEQS_PER_THREAD *
+                  seed_matcher_num_of_threads(), numofseqs);
+  batch.ref_seqs = gt_malloc(sizeof (GtUchar*) * batchsize);
+  batch.ref_ranges = gt_malloc(sizeof (GtRange) * batchsize);
+  batch.matchestab = gt_malloc(sizeof (GtArray*) * batchsize);
+  batch.errtab = gt_malloc(sizeof (GtError*) * batchsize);
+  batch.haserrtab = gt_malloc(sizeof (bool) * batchsize);
+  for (i = 0; i < batchsize; i++) {
+    batch.matchestab[i] = gt_array_new(sizeof (GthMatch));
+    batch.errtab[i] = gt_error_new();
+  }
+
+  /* the reference sequences of a batch are matched in parallel, afterwards
+     their matches are processed in the order of the reference sequences */
+  for (batch.startseqnum = 0; !had_err && batch.startseqnum < numofseqs;
+       batch.startseqnum += batchsize) {
+    GtUword end = MIN(batchsize, numofseqs - batch.startseqnum);
+    for (i = 0; i < end; i++) {
+      batch.ref_seqs[i] = gth_seq_con_get_tran_seq(ref_seq_con,
+                                                   batch.startseqnum + i);
+      batch.ref_ranges[i] = gth_seq_con_get_range(ref_seq_con,
+                                                  batch.startseqnum + i);
+    }
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, end, 1UL,
+                                match_ref_seqs, &batch);
+    for (i = 0; !had_err && i < end; i++) {
+      if (batch.haserrtab[i]) {
+        gt_error_set(err, "%s", gt_error_get(batch.errtab[i]));
+        had_err = -1;
+      }
+    }
+    for (i = 0; i < end; i++) {
+      for (j = 0; !had_err && j < gt_array_size(batch.matchestab[i]); j++) {
+        gth_match_processor(match_processor_info, gen_seq_con, ref_seq_con,
+                            gt_array_get(batch.matchestab[i], j));
+      }
+      gt_array_reset(batch.matchestab[i]);
+    }
+  }
+
+  for (i = 0; i < batchsize; i++) {
+    gt_error_delete(batch.errtab[i]);
+    gt_array_delete(batch.matchestab[i]);
+  }
+  gt_free(batch.haserrtab);
+  gt_free(batch.errtab);
+  gt_free(batch.matchestab);
+  gt_free(batch.ref_ranges);
+  gt_free(batch.ref_seqs);
+  seed_index_delete(index);
+  return had_err;
+}
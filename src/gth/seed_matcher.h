@@ -0,0 +1,52 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEED_MATCHER_H
+#define SEED_MATCHER_H
+
+#include "gth/call_info.h"
+#include "gth/chaining.h"
+#include "gth/input.h"
+
+/* The built-in matcher of the similarity filter. It is used instead of the
+   matcher plugin (which calls vmatch) and computes the matches in-process, on
+   the sequences loaded in <input>.
+
+   An enhanced suffix array of the genomic sequences of file <gen_file_num> is
+   constructed in memory (for protein reference sequences of their three
+   translated reading frames, on the reverse strand if <directmatches> is
+   false). Then the maximal exact matches of every reference sequence of file
+   <ref_file_num> (reverse complemented if <directmatches> is false and the
+   reference sequences are DNA) of at least the seed length are computed.
+   Like vmatch, these seeds are extended with the X-drop algorithm (DNA) or up
+   to the given Hamming distance (protein) and the matches of at least the
+   minimum match length are kept. If <call_info> demands exact matches, the
+   maximal exact matches of at least the minimum match length are used as they
+   are.
+   The reference sequences are matched in parallel, if more than one thread is
+   available. The matches are passed to <gth_match_processor()> with
+   <match_processor_info> in the order of the reference sequences, in the
+   coordinates vmatch reports. Returns 0 on success and -1 on error, in which
+   case <err> is set. */
+int gth_seed_matcher_run(GthInput *input,
+                         GtUword gen_file_num,
+                         GtUword ref_file_num,
+                         bool directmatches,
+                         const GthCallInfo *call_info,
+                         GthMatchProcessorInfo *match_processor_info,
+                         GtError *err);
+
+#endif
@@ -0,0 +1,339 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <ctype.h>
+#include "core/chardef.h"
+#include "core/class_alloc_lock.h"
+#include "core/encseq_api.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/str_array_api.h"
+#include "core/unused_api.h"
+#include "core/warning_api.h"
+#include "gth/gthdef.h"
+#include "gth/seq_con_encseq.h"
+#include "gth/seq_con_rep.h"
+
+struct GthSeqConEncseq {
+  const GthSeqCon parent_instance;
+  GtEncseq *encseq;
+  GtAlphabet *alphabet;
+  GtUchar *orig_seq,
+          *tran_seq,
+          *orig_seq_rc,
+          *tran_seq_rc;
+};
+
+#define gth_seq_con_encseq_cast(SC)\
+        gth_seq_con_cast(gth_seq_con_encseq_class(), SC)
+
+static void gth_seq_con_encseq_demand_orig_seq(GT_UNUSED GthSeqCon *sc)
+{
+  /* the original sequence is always loaded */
+}
+
+static GtUword seq_con_encseq_start(GthSeqConEncseq *scm, GtUword seq_num)
+{
+  return gt_encseq_seqstartpos(scm->encseq, seq_num);
+}
+
+static GtUchar* gth_seq_con_encseq_get_orig_seq(GthSeqCon *sc,
+                                                GtUword seq_num)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  return scm->orig_seq + seq_con_encseq_start(scm, seq_num);
+}
+
+static GtUchar* gth_seq_con_encseq_get_tran_seq(GthSeqCon *sc,
+                                                GtUword seq_num)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  return scm->tran_seq + seq_con_encseq_start(scm, seq_num);
+}
+
+static GtUchar* gth_seq_con_encseq_get_orig_seq_rc(GthSeqCon *sc,
+                                                   GtUword seq_num)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  gt_assert(scm->orig_seq_rc);
+  return scm->orig_seq_rc + seq_con_encseq_start(scm, seq_num);
+}
+
+static GtUchar* gth_seq_con_encseq_get_tran_seq_rc(GthSeqCon *sc,
+                                                   GtUword seq_num)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  gt_assert(scm->tran_seq_rc);
+  return scm->tran_seq_rc + seq_con_encseq_start(scm, seq_num);
+}
+
+static void gth_seq_con_encseq_get_description(GthSeqCon *sc,
+                                               GtUword seq_num, GtStr *desc)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  const char *description;
+  GtUword desclen;
+  description = gt_encseq_description(scm->encseq, &desclen, seq_num);
+  gt_str_append_cstr_nt(desc, description, desclen);
+}
+
+static void gth_seq_con_encseq_echo_description(GthSeqCon *sc,
+                                                GtUword seq_num,
+                                                GtFile *outfp)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  const char *description;
+  GtUword desclen;
+  description = gt_encseq_description(scm->encseq, &desclen, seq_num);
+  gt_file_xwrite(outfp, (char*) description, desclen);
+}
+
+static GtUword gth_seq_con_encseq_num_of_seqs(GthSeqCon *sc)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  return gt_encseq_num_of_sequences(scm->encseq);
+}
+
+static GtUword gth_seq_con_encseq_total_length(GthSeqCon *sc)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  return gt_encseq_total_length(scm->encseq);
+}
+
+static GtRange gth_seq_con_encseq_get_range(GthSeqCon *sc, GtUword seq_num)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  GtRange range;
+  range.start = gt_encseq_seqstartpos(scm->encseq, seq_num);
+  range.end = range.start + gt_encseq_seqlength(scm->encseq, seq_num) - 1;
+  return range;
+}
+
+static GtAlphabet* gth_seq_con_encseq_get_alphabet(GthSeqCon *sc)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  return scm->alphabet;
+}
+
+static void gth_seq_con_encseq_free(GthSeqCon *sc)
+{
+  GthSeqConEncseq *scm = gth_seq_con_encseq_cast(sc);
+  gt_free(scm->orig_seq);
+  gt_free(scm->tran_seq);
+  gt_free(scm->orig_seq_rc);
+  gt_free(scm->tran_seq_rc);
+  gt_alphabet_delete(scm->alphabet);
+  gt_encseq_delete(scm->encseq);
+}
+
+const GthSeqConClass* gth_seq_con_encseq_class(void)
+{
+  static const GthSeqConClass *scc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!scc) {
+    scc = gth_seq_con_class_new(sizeof (GthSeqConEncseq),
+                                gth_seq_con_encseq_demand_orig_seq,
+                                gth_seq_con_encseq_get_orig_seq,
+                                gth_seq_con_encseq_get_tran_seq,
+                                gth_seq_con_encseq_get_orig_seq_rc,
+                                gth_seq_con_encseq_get_tran_seq_rc,
+                                gth_seq_con_encseq_get_description,
+                                gth_seq_con_encseq_echo_description,
+                                gth_seq_con_encseq_num_of_seqs,
+                                gth_seq_con_encseq_total_length,
+                                gth_seq_con_encseq_get_range,
+                                gth_seq_con_encseq_get_alphabet,
+                                gth_seq_con_encseq_free);
+  }
+  gt_class_alloc_lock_leave();
+  return scc;
+}
+
+/* The alphabet codes of the sequences are stored like vmatch does it: the
+   wildcard has the largest code of the alphabet, separators are stored as
+   <SEPARATOR>. The original characters are shown in upper case. The reverse
+   complement of every sequence is stored at the position of the sequence
+   itself. */
+static void seq_con_encseq_fill(GthSeqConEncseq *scm, bool assign_rc)
+{
+  GtUword i, totallength, seq_num, numofseqs;
+  GtUchar wildcard = (GtUchar) (gt_alphabet_size(scm->alphabet) - 1);
+
+  totallength = gt_encseq_total_length(scm->encseq);
+  scm->tran_seq = gt_malloc(sizeof (GtUchar) * totallength);
+  scm->orig_seq = gt_malloc(sizeof (GtUchar) * totallength);
+  gt_encseq_extract_encoded(scm->encseq, scm->tran_seq, 0, totallength - 1);
+  for (i = 0; i < totallength; i++) {
+    if (scm->tran_seq[i] == (GtUchar) WILDCARD)
+      scm->tran_seq[i] = wildcard;
+    if (scm->tran_seq[i] == (GtUchar) SEPARATOR)
+      scm->orig_seq[i] = (GtUchar) SEPARATOR;
+    else {
+      scm->orig_seq[i] = (GtUchar) toupper(gt_alphabet_decode(scm->alphabet,
+                                                             scm->tran_seq[i]));
+    }
+  }
+  if (!assign_rc)
+    return;
+  gt_assert(gt_alphabet_is_dna(scm->alphabet));
+  scm->tran_seq_rc = gt_malloc(sizeof (GtUchar) * totallength);
+  scm->orig_seq_rc = gt_malloc(sizeof (GtUchar) * totallength);
+  numofseqs = gt_encseq_num_of_sequences(scm->encseq);
+  for (seq_num = 0; seq_num < numofseqs; seq_num++) {
+    GtUword start = gt_encseq_seqstartpos(scm->encseq, seq_num),
+            length = gt_encseq_seqlength(scm->encseq, seq_num);
+    for (i = 0; i < length; i++) {
+      GtUchar cc = scm->tran_seq[start + length - 1 - i];
+      if (cc != wildcard)
+        cc = (GtUchar) 3 - cc;
+      scm->tran_seq_rc[start + i] = cc;
+      scm->orig_seq_rc[start + i] =
+        (GtUchar) toupper(gt_alphabet_decode(scm->alphabet, cc));
+    }
+    if (seq_num + 1 < numofseqs) {
+      scm->tran_seq_rc[start + length] = (GtUchar) SEPARATOR;
+      scm->orig_seq_rc[start + length] = (GtUchar) SEPARATOR;
+    }
+  }
+}
+
+GthSeqCon* gth_seq_con_encseq_new(const char *indexname, bool assign_rc,
+                                  GT_UNUSED bool orig_seq,
+                                  GT_UNUSED bool tran_seq)
+{
+  GthSeqConEncseq *scm;
+  GthSeqCon *sc;
+  GtEncseqLoader *el;
+  GtEncseq *encseq;
+  GtError *err;
+  gt_assert(indexname);
+
+  err = gt_error_new();
+  el = gt_encseq_loader_new();
+  gt_encseq_loader_require_description_support(el);
+  gt_encseq_loader_require_multiseq_support(el);
+  gt_encseq_loader_drop_lossless_support(el);
+  gt_encseq_loader_drop_md5_support(el);
+  encseq = gt_encseq_loader_load(el, indexname, err);
+  gt_encseq_loader_delete(el);
+  if (!encseq) {
+    fprintf(stderr, "%s: error: %s\n", gt_error_get_progname(err),
+            gt_error_get(err));
+    exit(EXIT_FAILURE);
+  }
+  gt_error_delete(err);
+
+  sc = gth_seq_con_create(gth_seq_con_encseq_class());
+  scm = gth_seq_con_encseq_cast(sc);
+  scm->encseq = encseq;
+  scm->alphabet = gt_alphabet_ref(gt_encseq_alphabet(encseq));
+  seq_con_encseq_fill(scm, assign_rc);
+  return sc;
+}
+
+static int seq_con_encseq_make_index(const char *filename, bool dna,
+                                     const char *suffix, bool noautoindex,
+                                     bool skipindexcheck, GthOutput *out,
+                                     GtError *err)
+{
+  GtStr *indexname, *esqfile;
+  int had_err = 0;
+  gt_error_check(err);
+
+  indexname = gt_str_new_cstr(filename);
+  gt_str_append_char(indexname, '.');
+  gt_str_append_cstr(indexname, suffix);
+  esqfile = gt_str_clone(indexname);
+  gt_str_append_cstr(esqfile, GT_ENCSEQFILESUFFIX);
+
+  if (!gt_file_exists(gt_str_get(esqfile)) ||
+      (!skipindexcheck &&
+       gt_file_is_newer(filename, gt_str_get(esqfile)))) {
+    if (noautoindex) {
+      gt_error_set(err, "index \"%s\" does not exist or is out of date and "
+                   "option -noautoindex is used", gt_str_get(indexname));
+      had_err = -1;
+    }
+    else {
+      GtEncseqEncoder *ee = gt_encseq_encoder_new();
+      GtStrArray *files = gt_str_array_new();
+      if (out->showverbose) {
+        GtStr *msg = gt_str_new_cstr("create index ");
+        gt_str_append_str(msg, indexname);
+        out->showverbose(gt_str_get(msg));
+        gt_str_delete(msg);
+      }
+      gt_str_array_add_cstr(files, filename);
+      if (dna)
+        gt_encseq_encoder_set_input_dna(ee);
+      else
+        gt_encseq_encoder_set_input_protein(ee);
+      gt_encseq_encoder_enable_description_support(ee);
+      gt_encseq_encoder_enable_multiseq_support(ee);
+      gt_encseq_encoder_disable_lossless_support(ee);
+      gt_encseq_encoder_disable_md5_support(ee);
+      had_err = gt_encseq_encoder_encode(ee, files, gt_str_get(indexname),
+                                         err);
+      gt_str_array_delete(files);
+      gt_encseq_encoder_delete(ee);
+    }
+  }
+
+  gt_str_delete(esqfile);
+  gt_str_delete(indexname);
+  return had_err;
+}
+
+int gth_seq_con_encseq_preprocess(GthInput *input,
+                                  GT_UNUSED bool gthconsensus,
+                                  bool noautoindex,
+                                  bool skipindexcheck,
+                                  bool maskpolyAtails,
+                                  bool online,
+                                  bool inverse,
+                                  GT_UNUSED const char *progname,
+                                  GT_UNUSED unsigned int translationtable,
+                                  GthOutput *out,
+                                  GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  gt_assert(input && out);
+
+  if (maskpolyAtails || online || inverse) {
+    gt_error_set(err, "the options -maskpolyatails, -online and -inverse "
+                 "require the vmatch based preprocessing of the input files");
+    had_err = -1;
+  }
+  for (i = 0; !had_err && i < gth_input_num_of_gen_files(input); i++) {
+    had_err = seq_con_encseq_make_index(gth_input_get_genomic_filename(input,
+                                                                       i),
+                                        true, DNASUFFIX, noautoindex,
+                                        skipindexcheck, out, err);
+  }
+  for (i = 0; !had_err && i < gth_input_num_of_ref_files(input); i++) {
+    bool dna = gth_input_ref_file_is_dna(input, i);
+    had_err = seq_con_encseq_make_index(gth_input_get_reference_filename(input,
+                                                                         i),
+                                        dna,
+                                        dna ? DNASUFFIX
+                                            : gt_str_get(gth_input_proteinsmap(
+                                                                       input)),
+                                        noautoindex, skipindexcheck, out, err);
+  }
+  return had_err;
+}
@@ -0,0 +1,59 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SEQ_CON_ENCSEQ_H
+#define SEQ_CON_ENCSEQ_H
+
+#include "gth/input.h"
+#include "gth/seq_con.h"
+
+/* A sequence container which holds the sequences of an encoded sequence
+   (see core/encseq_api.h) in memory. Together with
+   gth_seq_con_encseq_preprocess() it allows to run GenomeThreader without the
+   vmatch based plugins, using the built-in matcher of the similarity filter
+   (see gth/seed_matcher.h). */
+typedef struct GthSeqConEncseq GthSeqConEncseq;
+
+const GthSeqConClass* gth_seq_con_encseq_class(void);
+
+/* Load the encoded sequence <indexname> (as created by
+   gth_seq_con_encseq_preprocess()). The sequences are always kept with their
+   original characters and their alphabet codes, the reverse complements only
+   if <assign_rc> is true. Exits on failure, like the constructors of the
+   plugins. */
+GthSeqCon*            gth_seq_con_encseq_new(const char *indexname,
+                                             bool assign_rc, bool orig_seq,
+                                             bool tran_seq);
+
+/* Implements <GthInputFilePreprocessor>. Creates the encoded sequences used by
+   gth_seq_con_encseq_new() for the genomic and reference files of <input>, if
+   they do not exist or are older than the input files (unless
+   <skipindexcheck> is true). The options -maskpolyatails, -online and
+   -inverse of the vmatch based preprocessor are not supported. */
+int                   gth_seq_con_encseq_preprocess(GthInput *input,
+                                                    bool gthconsensus,
+                                                    bool noautoindex,
+                                                    bool skipindexcheck,
+                                                    bool maskpolyAtails,
+                                                    bool online,
+                                                    bool inverse,
+                                                    const char *progname,
+                                                    unsigned int
+                                                    translationtable,
+                                                    GthOutput *out,
+                                                    GtError *err);
+
+#endif
@@ -15,6 +15,10 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -355,47 +359,78 @@ static bool isunsuccessfulalignment(GthSA *sa,
   return false;
 }
 
-static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
-                       GthInput *input, GthStat *stat,
-                       GthSACollection *sa_collection, GthSA *saA,
-                       GtUword gen_file_num,
-                       GtUword ref_file_num,
-                       GtUword gen_total_length,
-                       GtUword gen_offset,
-                       const GtRange *gen_seq_bounds,
-                       const GtRange *gen_seq_bounds_rc,
-                       GtUword ref_total_length, GtUword ref_offset,
-                       GtUword chainctr,
-                       GtUword num_of_chains, GthMatchInfo *match_info,
-                       const unsigned char *ref_seq_tran,
-                       const unsigned char *ref_seq_orig,
-                       const unsigned char *ref_seq_tran_rc,
-                       const unsigned char *ref_seq_orig_rc,
-                       GthChain *chain,
-                       GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
-                       GthProteinCompletePathMatrixJT
-                       protein_complete_path_matrix_jt)
-{
+/* the outcome of the DPs computed for a single chain */
+typedef enum {
+  GTH_CHAIN_DP_NONE,        /* no DP has been computed */
+  GTH_CHAIN_DP_DISCARD,     /* the spliced alignment has been discarded */
+  GTH_CHAIN_DP_SIGNIFICANT, /* the spliced alignment has been discarded, but
+                               counts as a significant match */
+  GTH_CHAIN_DP_SAVE         /* the spliced alignment <saA> has to be saved */
+} GthChainDPOutcome;
+
+/* the data which is the same for all chains of a chain collection */
+typedef struct {
+  GthCallInfo *call_info;
+  GthInput *input;
+  GtUword gen_file_num,
+          ref_file_num,
+          num_of_chains;
+  bool directmatches,
+       refseqisdna;
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+} GthChainDPInfo;
+
+/* the DP data of a single chain. The spliced alignments are allocated before
+   the DPs are computed, because this accesses <input>. The outcome is applied
+   afterwards by save_chain_dp(), in the order of the chains. Only the
+   computation of the DPs itself can be done in parallel for several chains. */
+typedef struct {
+  GthChain *chain;
+  GtUword chainctr,
+          gen_total_length,
+          gen_offset,
+          ref_total_length,
+          ref_offset;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc;
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  GthSA *saA,
+        *saB;
+  GthStat *stat;
+  GthChainDPOutcome outcome;
   int rval;
+} GthChainDP;
+
+static int call_dna_DP(GthChainDP *cdp, const GthChainDPInfo *info)
+{
+  GthCallInfo *call_info = info->call_info;
+  GthInput *input = info->input;
   bool bothstrandsanalyzed, firstdp = true,
+       directmatches = info->directmatches,
        GT_UNUSED gs2outdirectmatches = directmatches;
-  GthSA *saB = NULL;
   GtFile *outfp = call_info->out->outfp;
+  int rval;
 
   if (directmatches ? gth_input_forward(input)
                     : gth_input_reverse(input)) {
     /* calculate alignment */
-    rval = callsahmt(true, saA, directmatches, gen_file_num, ref_file_num,
-                     chain, gen_total_length, gen_offset, gen_seq_bounds,
-                     gen_seq_bounds_rc,
-                     ref_seq_tran, ref_seq_orig, ref_total_length, ref_offset,
-                     input, &call_info->simfilterparam.introncutoutinfo, stat,
-                     chainctr, num_of_chains, call_info->translationtable,
-                     directmatches, call_info->proteinexonpenal,
+    rval = callsahmt(true, cdp->saA, directmatches, info->gen_file_num,
+                     info->ref_file_num, cdp->chain, cdp->gen_total_length,
+                     cdp->gen_offset, &cdp->gen_seq_bounds,
+                     &cdp->gen_seq_bounds_rc, cdp->ref_seq_tran,
+                     cdp->ref_seq_orig, cdp->ref_total_length, cdp->ref_offset,
+                     input, &call_info->simfilterparam.introncutoutinfo,
+                     cdp->stat, cdp->chainctr, info->num_of_chains,
+                     call_info->translationtable, directmatches,
+                     call_info->proteinexonpenal,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
-                     dna_complete_path_matrix_jt,
-                     protein_complete_path_matrix_jt, call_info->out);
+                     info->dna_complete_path_matrix_jt,
+                     info->protein_complete_path_matrix_jt, call_info->out);
     if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                      /* ^ this error is treated below */
       return rval;
@@ -405,11 +440,12 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
     bothstrandsanalyzed = gth_input_both(input);
 
     if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-        isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-      match_info->call_number--;
+        isunsuccessfulalignment(cdp->saA, call_info->out->comments, outfp)) {
       /* if the spliced alignment was unsuccessful, it is deleted and the
          next hit is considered. */
-      gth_sa_delete(saA);
+      gth_sa_delete(cdp->saA);
+      cdp->saA = NULL;
+      cdp->outcome = GTH_CHAIN_DP_DISCARD;
       return 0; /* continue */
     }
 
@@ -417,44 +453,48 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
        Otherwise we have to calculate the alignment to the other strand
        first and then save the better one. */
     if (!bothstrandsanalyzed)
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+      cdp->outcome = GTH_CHAIN_DP_SAVE;
   }
 
   if (directmatches ? gth_input_reverse(input)
                     : gth_input_forward(input)) {
-    if ((firstdp || gth_sa_is_poor(saA, call_info->minaveragessp)) &&
+    if ((firstdp || gth_sa_is_poor(cdp->saA, call_info->minaveragessp)) &&
         !call_info->cdnaforwardonly) {
       if (firstdp) {
         /* space for first alignment is already allocated, bu we have to
            change the direction of the genomic and the reference strand */
-        gth_sa_set_gen_strand(saA, !directmatches);
-        gth_sa_set_ref_strand(saA, false);
+        gth_sa_set_gen_strand(cdp->saA, !directmatches);
+        gth_sa_set_ref_strand(cdp->saA, false);
       }
-      else {
+      else if (!cdp->saB) {
         /* allocating space for second alignment */
-        saB = gth_sa_new_and_set(!directmatches, false, input,
-                                 chain->gen_file_num, chain->gen_seq_num,
-                                 chain->ref_file_num, chain->ref_seq_num,
-                                 match_info->call_number, gen_total_length,
-                                 gen_offset, ref_total_length);
+        cdp->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                      cdp->chain->gen_file_num,
+                                      cdp->chain->gen_seq_num,
+                                      cdp->chain->ref_file_num,
+                                      cdp->chain->ref_seq_num, GT_UNDEF_UWORD,
+                                      cdp->gen_total_length, cdp->gen_offset,
+                                      cdp->ref_total_length);
       }
 
       /* setting gs2outdirectmatches (for compatibility) */
       gs2outdirectmatches = (bool) !directmatches;
 
       /* calculate alignment */
-      rval = callsahmt(true, firstdp ? saA : saB, !directmatches,
-                       gen_file_num, ref_file_num, chain, gen_total_length,
-                       gen_offset, gen_seq_bounds, gen_seq_bounds_rc,
-                       ref_seq_tran_rc, ref_seq_orig_rc, ref_total_length,
-                       ref_offset, input,
-                       &call_info->simfilterparam.introncutoutinfo, stat,
-                       chainctr, num_of_chains, call_info->translationtable,
-                       directmatches, call_info->proteinexonpenal,
+      rval = callsahmt(true, firstdp ? cdp->saA : cdp->saB, !directmatches,
+                       info->gen_file_num, info->ref_file_num, cdp->chain,
+                       cdp->gen_total_length, cdp->gen_offset,
+                       &cdp->gen_seq_bounds, &cdp->gen_seq_bounds_rc,
+                       cdp->ref_seq_tran_rc, cdp->ref_seq_orig_rc,
+                       cdp->ref_total_length, cdp->ref_offset, input,
+                       &call_info->simfilterparam.introncutoutinfo, cdp->stat,
+                       cdp->chainctr, info->num_of_chains,
+                       call_info->translationtable, directmatches,
+                       call_info->proteinexonpenal,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
-                       dna_complete_path_matrix_jt,
-                       protein_complete_path_matrix_jt, call_info->out);
+                       info->dna_complete_path_matrix_jt,
+                       info->protein_complete_path_matrix_jt, call_info->out);
       if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                        /* ^ this error is treated below */
         return rval;
@@ -462,108 +502,88 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
       if (firstdp) {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
+            isunsuccessfulalignment(cdp->saA, call_info->out->comments,
+                                    outfp)) {
           /* for compatibility with GS2 */
           /* XXX: makes no sense. Possibly only if -gs2out is used. */
-          match_info->significant_match_found= true;
+          cdp->outcome = GTH_CHAIN_DP_SIGNIFICANT;
 
           /* if the spliced alignment was unsuccessful, it is deleted and
              the next hit is considered. */
-          gth_sa_delete(saA);
+          gth_sa_delete(cdp->saA);
+          cdp->saA = NULL;
           return 0; /* continue */
         }
-
-        save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
       }
       else /* !firstdp */
       {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saB, call_info->out->comments, outfp) ||
-            !gth_sa_B_is_better_than_A(saA, saB)) {
-          /* insert first SA */
-          save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-          /* discard second SA */
-          gth_sa_delete(saB);
+            isunsuccessfulalignment(cdp->saB, call_info->out->comments,
+                                    outfp) ||
+            !gth_sa_B_is_better_than_A(cdp->saA, cdp->saB)) {
+          /* keep first SA, discard second SA */
+          gth_sa_delete(cdp->saB);
         }
         else {
-          /* insert second SA */
-          save_sa(sa_collection, saB, call_info->sa_filter, match_info, stat);
-          /* free first SA */
-          gth_sa_delete(saA);
+          /* keep second SA, free first SA */
+          gth_sa_delete(cdp->saA);
+          cdp->saA = cdp->saB;
         }
+        cdp->saB = NULL;
       }
     }
-    else
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+    cdp->outcome = GTH_CHAIN_DP_SAVE;
   }
 
   return 0;
 }
 
-static int call_protein_DP(bool directmatches,
-                           GthCallInfo *call_info,
-                           GthInput *input,
-                           GthStat *stat,
-                           GthSACollection *sa_collection,
-                           GthSA *saA,
-                           GtUword gen_file_num,
-                           GtUword ref_file_num,
-                           GtUword gen_total_length,
-                           GtUword gen_offset,
-                           const GtRange *gen_seq_bounds,
-                           const GtRange *gen_seq_bounds_rc,
-                           GtUword ref_total_length,
-                           GtUword ref_offset,
-                           GtUword chainctr,
-                           GtUword num_of_chains,
-                           GthMatchInfo *match_info,
-                           const unsigned char *ref_seq_tran,
-                           const unsigned char *ref_seq_orig,
-                           GthChain *chain,
-                           GthDNACompletePathMatrixJT
-                           dna_complete_path_matrix_jt,
-                           GthProteinCompletePathMatrixJT
-                           protein_complete_path_matrix_jt)
+static int call_protein_DP(GthChainDP *cdp, const GthChainDPInfo *info)
 {
+  GthCallInfo *call_info = info->call_info;
   GtFile *outfp = call_info->out->outfp;
   int rval;
 
 #ifndef NDEBUG
   /* strand is in searchmode */
-  if (directmatches)
-    gt_assert(gth_input_forward(input));
+  if (info->directmatches)
+    gt_assert(gth_input_forward(info->input));
   else
-    gt_assert(gth_input_reverse(input));
+    gt_assert(gth_input_reverse(info->input));
 #endif
 
   /* calculate alignment */
-  rval = callsahmt(false, saA, directmatches, gen_file_num, ref_file_num,
-                   chain, gen_total_length, gen_offset, gen_seq_bounds,
-                   gen_seq_bounds_rc, ref_seq_tran, ref_seq_orig,
-                   ref_total_length, ref_offset, input,
-                   &call_info->simfilterparam.introncutoutinfo, stat, chainctr,
-                   num_of_chains, call_info->translationtable, directmatches,
+  rval = callsahmt(false, cdp->saA, info->directmatches, info->gen_file_num,
+                   info->ref_file_num, cdp->chain, cdp->gen_total_length,
+                   cdp->gen_offset, &cdp->gen_seq_bounds,
+                   &cdp->gen_seq_bounds_rc, cdp->ref_seq_tran,
+                   cdp->ref_seq_orig, cdp->ref_total_length, cdp->ref_offset,
+                   info->input, &call_info->simfilterparam.introncutoutinfo,
+                   cdp->stat, cdp->chainctr, info->num_of_chains,
+                   call_info->translationtable, info->directmatches,
                    call_info->proteinexonpenal, call_info->splice_site_model,
                    call_info->dp_options_core, call_info->dp_options_est,
-                   call_info->dp_options_postpro, dna_complete_path_matrix_jt,
-                   protein_complete_path_matrix_jt, call_info->out);
+                   call_info->dp_options_postpro,
+                   info->dna_complete_path_matrix_jt,
+                   info->protein_complete_path_matrix_jt, call_info->out);
   if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                    /* ^ this error is treated below */
     return rval;
   }
 
   if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-      isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-    match_info->call_number--;
+      isunsuccessfulalignment(cdp->saA, call_info->out->comments, outfp)) {
     /* if the spliced alignment was unsuccessful, it is deleted and the
        next hit is considered. */
-    gth_sa_delete(saA);
+    gth_sa_delete(cdp->saA);
+    cdp->saA = NULL;
+    cdp->outcome = GTH_CHAIN_DP_DISCARD;
     /* continue */
     return 0;
   }
 
   /* we can save the alignment now */
-  save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+  cdp->outcome = GTH_CHAIN_DP_SAVE;
 
   return 0;
 }
@@ -591,14 +611,18 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
                                            GtUword ref_file_num,
                                            bool directmatches,
                                            GthMatchInfo *match_info,
-                                           const GthPlugins *plugins)
+                                           const GthPlugins *plugins,
+                                           GtError *err)
 {
   GtFile *outfp = call_info->out->outfp;
   GthChainCollection *chain_collection = gth_chain_collection_new();
 
   /* compute the chains */
-  gth_chaining(chain_collection, gen_file_num, ref_file_num, call_info, input,
-               stat, directmatches, plugins);
+  if (gth_chaining(chain_collection, gen_file_num, ref_file_num, call_info,
+                   input, stat, directmatches, plugins, err)) {
+    gth_chain_collection_delete(chain_collection);
+    return NULL;
+  }
 
   /* update statistics */
   gth_stat_increase_numofchains(stat,
@@ -626,6 +650,297 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
   return chain_collection;
 }
 
+/* the following function increases the call number and returns true, if the
+   maximal number of spliced alignments to be shown has been reached */
+static bool max_call_number_reached(GthCallInfo *call_info,
+                                    GthMatchInfo *match_info,
+                                    bool refseqisdna)
+{
+  GtFile *outfp = call_info->out->outfp;
+
+  if (++match_info->call_number > call_info->firstalshown &&
+      call_info->firstalshown > 0) {
+    if (!(call_info->out->xmlout || call_info->out->gff3out))
+      gt_file_xfputc('\n', outfp);
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "<!--\n");
+
+    if (!call_info->out->gff3out) {
+      gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
+                      refseqisdna ? "EST" : "protein",
+                      call_info->firstalshown);
+      gt_file_xprintf(outfp, "Only the first %u matches will be "
+                         "displayed.\n", call_info->firstalshown);
+    }
+
+    if (!(call_info->out->xmlout || call_info->out->gff3out))
+      gt_file_xfputc('\n', outfp);
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "-->\n");
+
+    match_info->max_call_number_reached = true;
+    return true;
+  }
+  return false;
+}
+
+static void check_stop_amino_acid(const GthChainDP *cdp, GthInput *input,
+                                  GthMatchInfo *match_info, bool refseqisdna)
+{
+  /* check if protein sequences have a stop amino acid */
+  if (!refseqisdna && !match_info->stop_amino_acid_warning &&
+     cdp->ref_seq_orig[cdp->ref_total_length - 1] != GT_STOP_AMINO) {
+    GtStr *ref_id = gt_str_new();
+    gth_input_save_ref_id(input, ref_id, cdp->chain->ref_file_num,
+                          cdp->chain->ref_seq_num);
+    gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
+               "with a stop amino acid ('%c'). If it is not a protein "
+               "fragment you should add a stop amino acid to improve the "
+               "prediction. For example with `gt seqtransform "
+               "-addstopaminos` (see http://genometools.org for details).",
+               gt_str_get(ref_id), cdp->chain->ref_seq_num,
+               gth_input_get_reference_filename(input,
+                                                cdp->chain->ref_file_num),
+               GT_STOP_AMINO);
+    match_info->stop_amino_acid_warning = true;
+    gt_str_delete(ref_id);
+  }
+}
+
+/* the following function prepares the DP for chain number <chainctr> of
+   <chain_collection>, the statistics are collected in <stat>. If <alloc_saB>
+   is true, the second alignment which might be needed if both strands are
+   analyzed is allocated as well. Otherwise call_dna_DP() allocates it. */
+static void chain_dp_init(GthChainDP *cdp,
+                          GthChainCollection *chain_collection,
+                          GtUword chainctr, const GthChainDPInfo *info,
+                          GthStat *stat, bool alloc_saB)
+{
+  GthInput *input = info->input;
+  GthChain *chain;
+  GtRange range;
+
+  chain = gth_chain_collection_get(chain_collection, chainctr);
+  cdp->chain = chain;
+  cdp->chainctr = chainctr;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    cdp->gen_seq_bounds = gth_input_get_genomic_range(input,
+                                                      chain->gen_file_num,
+                                                      chain->gen_seq_num);
+    cdp->gen_total_length  = gt_range_length(&cdp->gen_seq_bounds);
+    cdp->gen_offset        = cdp->gen_seq_bounds.start;
+    cdp->gen_seq_bounds_rc = cdp->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    cdp->gen_total_length =
+      gth_input_genomic_file_total_length(input, chain->gen_file_num);
+    cdp->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    cdp->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    cdp->gen_offset              = 0;
+    cdp->gen_seq_bounds_rc.start = cdp->gen_total_length - 1
+                                   - cdp->gen_seq_bounds.end;
+    cdp->gen_seq_bounds_rc.end   = cdp->gen_total_length - 1
+                                   - cdp->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                        chain->ref_seq_num);
+  cdp->ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
+  cdp->ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
+  if (info->refseqisdna) {
+    cdp->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input)
+                           + range.start;
+    cdp->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input)
+                           + range.start;
+  }
+  else {
+    cdp->ref_seq_tran_rc = NULL;
+    cdp->ref_seq_orig_rc = NULL;
+  }
+  cdp->ref_total_length = range.end - range.start + 1;
+  cdp->ref_offset = range.start;
+
+  /* allocating space for alignment, the call number is set when it is
+     saved */
+  cdp->saA = gth_sa_new_and_set(info->directmatches, true, input,
+                                chain->gen_file_num, chain->gen_seq_num,
+                                chain->ref_file_num, chain->ref_seq_num,
+                                GT_UNDEF_UWORD, cdp->gen_total_length,
+                                cdp->gen_offset, cdp->ref_total_length);
+  if (alloc_saB && info->refseqisdna && gth_input_both(input) &&
+      !info->call_info->cdnaforwardonly) {
+    cdp->saB = gth_sa_new_and_set(!info->directmatches, false, input,
+                                  chain->gen_file_num, chain->gen_seq_num,
+                                  chain->ref_file_num, chain->ref_seq_num,
+                                  GT_UNDEF_UWORD, cdp->gen_total_length,
+                                  cdp->gen_offset, cdp->ref_total_length);
+  }
+  else
+    cdp->saB = NULL;
+  cdp->stat = stat;
+  cdp->outcome = GTH_CHAIN_DP_NONE;
+  cdp->rval = 0;
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &cdp->gen_seq_bounds,
+                           &cdp->gen_seq_bounds_rc, cdp->gen_total_length,
+                           cdp->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+static void chain_dp_compute(GthChainDP *cdp, const GthChainDPInfo *info)
+{
+  /* call the Dynamic Programming */
+  if (info->refseqisdna)
+    cdp->rval = call_dna_DP(cdp, info);
+  else
+    cdp->rval = call_protein_DP(cdp, info);
+}
+
+/* the following function applies the outcome of the DPs for <cdp> to
+   <sa_collection> and <match_info> */
+static int chain_dp_save(GthChainDP *cdp, GthSACollection *sa_collection,
+                         GthCallInfo *call_info, GthMatchInfo *match_info,
+                         GthStat *stat)
+{
+  if (cdp->stat != stat)
+    gth_stat_add_counters(stat, cdp->stat);
+
+  /* check return value */
+  if (cdp->rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    match_info->call_number--;
+    return 0; /* continue with the next DP range */
+  }
+  else if (cdp->rval)
+    return -1;
+
+  switch (cdp->outcome) {
+    case GTH_CHAIN_DP_NONE:
+      break;
+    case GTH_CHAIN_DP_DISCARD:
+      match_info->call_number--;
+      break;
+    case GTH_CHAIN_DP_SIGNIFICANT:
+      match_info->significant_match_found = true;
+      break;
+    case GTH_CHAIN_DP_SAVE:
+      gth_sa_set_call_number(cdp->saA, match_info->call_number);
+      save_sa(sa_collection, cdp->saA, call_info->sa_filter, match_info, stat);
+      cdp->saA = NULL;
+      break;
+    default: gt_assert(0);
+  }
+  return 0;
+}
+
+static void chain_dp_free(GthChainDP *cdp, GthStat *stat)
+{
+  gth_sa_delete(cdp->saA);
+  gth_sa_delete(cdp->saB);
+  if (cdp->stat != stat)
+    gth_stat_delete(cdp->stat);
+}
+
+/* the number of threads used to compute the DPs of the chains. With
+   comments, edit operations, or the path matrix shown by the DP the output of
+   the DPs would be interleaved, so they are computed sequentially then. */
+static unsigned int calc_spliced_alignments_numofthreads(GT_UNUSED
+                                                         GthCallInfo
+                                                         *call_info)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && !call_info->out->comments && !call_info->out->showeops &&
+      call_info->dp_options_core->btmatrixgenrange.start == GT_UNDEF_UWORD) {
+    return gt_thread_pool_size(gt_thread_pool_get());
+  }
+#endif
+  return 1U;
+}
+
+/* the number of chains per thread whose DPs are computed at once */
+#define GTH_CHAINS_PER_THREAD  16
+
+typedef struct {
+  GthChainDP *cdptab;
+  const GthChainDPInfo *info;
+} GthChainDPBatch;
+
+static void chain_dp_compute_range(GtUword start, GtUword end, void *data)
+{
+  GthChainDPBatch *batch = data;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+    chain_dp_compute(batch->cdptab + idx, batch->info);
+}
+
+/* The DPs of different chains are independent of each other. Hence they are
+   computed in parallel for batches of chains, every chain with its own DP
+   matrices and statistics. Afterwards the spliced alignments of a batch are
+   saved in the order of the chains, which gives the same result as the
+   sequential computation. If the maximal number of spliced alignments is
+   reached, the remaining DPs of the batch have been computed in vain. */
+static int calc_spliced_alignments_threaded(GthSACollection *sa_collection,
+                                            GthChainCollection
+                                            *chain_collection,
+                                            const GthChainDPInfo *info,
+                                            GthMatchInfo *match_info,
+                                            GthStat *stat,
+                                            unsigned int numofthreads)
+{
+  GtThreadPool *pool = gt_thread_pool_get();
+  GthChainDPBatch batch;
+  GtUword batchsize = (GtUword) GTH_CHAINS_PER_THREAD * numofthreads,
+          start, end, idx;
+  bool done = false;
+  int had_err = 0;
+
+  batch.cdptab = gt_malloc(sizeof (*batch.cdptab) *
+                           MIN(batchsize, info->num_of_chains));
+  batch.info = info;
+  for (start = 0; !done && start < info->num_of_chains; start = end) {
+    end = MIN(start + batchsize, info->num_of_chains);
+    for (idx = start; idx < end; idx++) {
+      chain_dp_init(batch.cdptab + idx - start, chain_collection, idx, info,
+                    gth_stat_new(), true);
+    }
+    gt_thread_pool_parallel_for(pool, 0, end - start, 1UL,
+                                chain_dp_compute_range, &batch);
+    for (idx = start; idx < end; idx++) {
+      GthChainDP *cdp = batch.cdptab + idx - start;
+
+      if (!done) {
+        if (max_call_number_reached(info->call_info, match_info,
+                                    info->refseqisdna)) {
+          done = true;
+        }
+        else {
+          check_stop_amino_acid(cdp, info->input, match_info,
+                                info->refseqisdna);
+          if (chain_dp_save(cdp, sa_collection, info->call_info, match_info,
+                            stat)) {
+            had_err = -1;
+            done = true;
+          }
+        }
+      }
+      chain_dp_free(cdp, stat);
+    }
+  }
+  gt_free(batch.cdptab);
+  return had_err;
+}
+
 static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthChainCollection *chain_collection,
                                    GthCallInfo *call_info,
@@ -640,154 +955,52 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthProteinCompletePathMatrixJT
                                    protein_complete_path_matrix_jt)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
-  GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
-  bool refseqisdna;
-  GthChain *chain;
-  GtRange range;
-  GthSA *saA;
-  int rval;
+  GthChainDPInfo info;
+  GthChainDP cdp;
+  GtUword chainctr;
+  unsigned int numofthreads;
+  int had_err = 0;
 
   gt_assert(sa_collection && chain_collection);
 
-  refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
-
-  for (chainctr = 0;
-       chainctr < gth_chain_collection_size(chain_collection);
-       chainctr++) {
-       chain = gth_chain_collection_get(chain_collection, chainctr);
-    if (++match_info->call_number > call_info->firstalshown &&
-        call_info->firstalshown > 0) {
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "<!--\n");
-
-      if (!call_info->out->gff3out) {
-        gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
-                        refseqisdna ? "EST" : "protein",
-                        call_info->firstalshown);
-        gt_file_xprintf(outfp, "Only the first %u matches will be "
-                           "displayed.\n", call_info->firstalshown);
-      }
-
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "-->\n");
-
-      match_info->max_call_number_reached = true;
-      break; /* break out of loop */
-    }
-
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
-
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
-    }
-    ref_total_length = range.end - range.start + 1;
-
-    /* check if protein sequences have a stop amino acid */
-    if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
-      GtStr *ref_id = gt_str_new();
-      gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
-                            chain->ref_seq_num);
-      gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
-                 "with a stop amino acid ('%c'). If it is not a protein "
-                 "fragment you should add a stop amino acid to improve the "
-                 "prediction. For example with `gt seqtransform "
-                 "-addstopaminos` (see http://genometools.org for details).",
-                 gt_str_get(ref_id), chain->ref_seq_num,
-                 gth_input_get_reference_filename(input, chain->ref_file_num),
-                 GT_STOP_AMINO);
-      match_info->stop_amino_acid_warning = true;
-      gt_str_delete(ref_id);
-    }
-
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
-    /* call the Dynamic Programming */
-    if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
-    }
-    else {
-      rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
-                             gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
-                             protein_complete_path_matrix_jt);
-    }
-    /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
+  info.call_info = call_info;
+  info.input = input;
+  info.gen_file_num = gen_file_num;
+  info.ref_file_num = ref_file_num;
+  info.num_of_chains = gth_chain_collection_size(chain_collection);
+  info.directmatches = directmatches;
+  info.refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
+  info.dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+  info.protein_complete_path_matrix_jt = protein_complete_path_matrix_jt;
+
+  numofthreads = calc_spliced_alignments_numofthreads(call_info);
+  if (numofthreads > 1U && info.num_of_chains > 1UL) {
+    had_err = calc_spliced_alignments_threaded(sa_collection, chain_collection,
+                                               &info, match_info, stat,
+                                               numofthreads);
+  }
+  else {
+    for (chainctr = 0;
+         !had_err && chainctr < info.num_of_chains;
+         chainctr++) {
+      if (max_call_number_reached(call_info, match_info, info.refseqisdna))
+        break; /* break out of loop */
+      chain_dp_init(&cdp, chain_collection, chainctr, &info, stat, false);
+      check_stop_amino_acid(&cdp, input, match_info, info.refseqisdna);
+      chain_dp_compute(&cdp, &info);
+      had_err = chain_dp_save(&cdp, sa_collection, call_info, match_info,
+                              stat);
+      chain_dp_free(&cdp, stat);
     }
-    else if (rval)
-      return -1;
   }
+  if (had_err)
+    return -1;
 
   if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
       !match_info->significant_match_found &&
       match_info->call_number <= call_info->firstalshown) {
-    show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
+    show_no_match_line(gth_input_get_alphatype(input, ref_file_num),
+                       call_info->out->outfp);
   }
 
   return 0;
@@ -833,7 +1046,8 @@ static int compute_sa_collection(GthSACollection *sa_collection,
                                  GthCallInfo *call_info,
                                  GthInput *input,
                                  GthStat *stat,
-                                 const GthPlugins *plugins)
+                                 const GthPlugins *plugins,
+                                 GtError *err)
 {
   GthChainCollection *chain_collection;
   GthMatchInfo match_info;
@@ -845,7 +1059,7 @@ static int compute_sa_collection(GthSACollection *sa_collection,
   match_info.max_call_number_reached = false;
   match_info.stop_amino_acid_warning = false;
 
-  for (g = 0; g < gth_input_num_of_gen_files(input); g++) {
+  for (g = 0; !rval && g < gth_input_num_of_gen_files(input); g++) {
     for (r = 0; r < gth_input_num_of_ref_files(input); r++) {
       if (gth_input_get_alphatype(input, r) == DNA_ALPHA ||
           gth_input_forward(input)) {
@@ -856,7 +1070,11 @@ static int compute_sa_collection(GthSACollection *sa_collection,
         }
         /* compute direct matches */
         chain_collection = match_and_chain(call_info, input, stat, g, r, true,
-                                           &match_info, plugins);
+                                           &match_info, plugins, err);
+        if (!chain_collection && gt_error_is_set(err)) {
+          rval = -1;
+          break;
+        }
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
                                          call_info, input, stat, g, r, true,
@@ -881,7 +1099,11 @@ static int compute_sa_collection(GthSACollection *sa_collection,
         }
         /* compute reverse complemented (palindromic) matches */
         chain_collection = match_and_chain(call_info, input, stat, g, r, false,
-                                           &match_info, plugins);
+                                           &match_info, plugins, err);
+        if (!chain_collection && gt_error_is_set(err)) {
+          rval = -1;
+          break;
+        }
         if (chain_collection) {
           rval = calc_spliced_alignments(sa_collection, chain_collection,
                                          call_info, input, stat, g, r, false,
@@ -904,7 +1126,7 @@ static int compute_sa_collection(GthSACollection *sa_collection,
 
 int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
                           GthStat *stat, unsigned int indentlevel,
-                          const GthPlugins *plugins, GT_UNUSED GtError *err)
+                          const GthPlugins *plugins, GtError *err)
 {
   GthSACollection *sa_collection; /* stores the calculated spliced alignments */
 
@@ -914,7 +1136,8 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
   sa_collection = gth_sa_collection_new(call_info->duplicate_check);
 
   /* compute the spliced alignments */
-  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins)) {
+  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins,
+                            err)) {
     gth_sa_collection_delete(sa_collection);
     return -1;
   }
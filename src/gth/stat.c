@@ -285,6 +285,28 @@ void gth_stat_add_to_sa_coverage_distri(GthStat *stat, GtUword data)
     gt_disc_distri_add(stat->sa_coverage_distribution, data);
 }
 
+void gth_stat_add_counters(GthStat *dest, const GthStat *src)
+{
+  gt_assert(dest && src);
+  dest->numofchains                       += src->numofchains;
+  dest->numofremovedzerobaseexons         += src->numofremovedzerobaseexons;
+  dest->numofautointroncutoutcalls        += src->numofautointroncutoutcalls;
+  dest->numofunsuccessfulintroncutoutDPs
+    += src->numofunsuccessfulintroncutoutDPs;
+  dest->numoffailedDPparameterallocations
+    += src->numoffailedDPparameterallocations;
+  dest->numoffailedmatrixallocations      += src->numoffailedmatrixallocations;
+  dest->numofundeterminedSAs              += src->numofundeterminedSAs;
+  dest->numoffilteredpolyAtailmatches     += src->numoffilteredpolyAtailmatches;
+  dest->numofSAs                          += src->numofSAs;
+  dest->numofPGLs_stored                  += src->numofPGLs_stored;
+  gt_safe_add(dest->totalsizeofbacktracematricesinMB,
+              dest->totalsizeofbacktracematricesinMB,
+              src->totalsizeofbacktracematricesinMB);
+  dest->numofbacktracematrixallocations
+    += src->numofbacktracematrixallocations;
+}
+
 static void outputgeneralstatistics(GthStat *stat, bool show_full_stats,
                                     GtFile *outfp)
 {
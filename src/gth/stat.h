@@ -56,6 +56,8 @@ void          gth_stat_add_to_refseqcovdistri(GthStat*, GtUword);
 void          gth_stat_add_to_sa_alignment_score_distri(GthStat*,
                                                         GtUword);
 void          gth_stat_add_to_sa_coverage_distri(GthStat*, GtUword);
+/* adds the counters of <src> (but not its distributions) to <dest> */
+void          gth_stat_add_counters(GthStat *dest, const GthStat *src);
 void          gth_stat_show(GthStat*, bool show_full_stats, bool xmlout,
                             GtFile*);
 void          gth_stat_delete(GthStat*);
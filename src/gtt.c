@@ -22,6 +22,7 @@
 #include "core/array2dim_sparse.h"
 #include "core/array3dim.h"
 #include "core/basename_api.h"
+#include "core/bgzf.h"
 #include "core/bitpackarray.h"
 #include "core/bitpackstring.h"
 #include "core/bittab.h"
@@ -48,17 +49,23 @@
 #include "core/quality.h"
 #include "core/queue.h"
 #include "core/sequence_buffer.h"
+#include "core/sequence_buffer_replay.h"
+#include "core/slab.h"
 #include "core/splitter.h"
+#include "core/static_interval_tree.h"
 #include "core/symbol.h"
+#include "core/thread_pool.h"
 #include "core/tokenizer.h"
 #include "core/translator.h"
 #include "extended/alignment.h"
 #include "extended/anno_db_gfflike_api.h"
 #include "extended/compressed_bitsequence.h"
+#include "extended/edist_myers.h"
 #include "extended/elias_gamma.h"
 #include "extended/encdesc.h"
 #include "extended/evaluator.h"
 #include "extended/feature_index.h"
+#include "extended/feature_index_disk.h"
 #include "extended/feature_index_memory.h"
 #include "extended/feature_node.h"
 #include "extended/feature_node_iterator_api.h"
@@ -66,6 +73,7 @@
 #include "extended/gff3_escaping.h"
 #include "extended/golomb.h"
 #include "extended/hmm.h"
+#include "extended/hmmer_model.h"
 #include "extended/huffcode.h"
 #include "extended/luaserialize.h"
 #include "extended/popcount_tab.h"
@@ -75,8 +83,11 @@
 #include "extended/rmq.h"
 #include "extended/splicedseq.h"
 #include "extended/string_matching.h"
+#include "extended/swprofile.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
+#include "gth/align_dna.h"
+#include "gth/align_protein.h"
 #include "ltr/gt_ltrclustering.h"
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
@@ -108,6 +119,7 @@
 #include "tools/gt_genomediff.h"
 #include "tools/gt_gff3.h"
 #include "tools/gt_gff3_to_gtf.h"
+#include "tools/gt_gff3index.h"
 #include "tools/gt_gff3validator.h"
 #include "tools/gt_gtf_to_gff3.h"
 #include "tools/gt_hop.h"
@@ -200,10 +212,12 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "eval", gt_eval());
   gt_toolbox_add_tool(tools, "extractfeat", gt_extractfeat());
   gt_toolbox_add_tool(tools, "extractseq", gt_extractseq());
+  gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
   gt_toolbox_add_tool(tools, "fingerprint", gt_fingerprint());
   gt_toolbox_add_tool(tools, "genomediff", gt_genomediff());
   gt_toolbox_add_tool(tools, "gff3", gt_gff3());
   gt_toolbox_add_tool(tools, "gff3_to_gtf", gt_gff3_to_gtf());
+  gt_toolbox_add_tool(tools, "gff3index", gt_gff3index());
   gt_toolbox_add_tool(tools, "gff3validator", gt_gff3validator());
   gt_toolbox_add_tool(tools, "gtf_to_gff3", gt_gtf_to_gff3());
   gt_toolbox_add_tool(tools, "hop", gt_hop());
@@ -215,6 +229,7 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "matchtool", gt_matchtool());
   gt_toolbox_add_tool(tools, "md5_to_id", gt_md5_to_id());
   gt_toolbox_add_tool(tools, "mergefeat", gt_mergefeat());
+  gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
   gt_toolbox_add_tool(tools, "packedindex", gt_packedindex());
   gt_toolbox_add_tool(tools, "prebwt", gt_prebwt());
   gt_toolbox_add_tool(tools, "readjoiner", gt_readjoiner());
@@ -245,10 +260,6 @@ GtToolbox* gtt_tools(void)
   gt_toolbox_add_tool(tools, "sketch", gt_sketch());
   gt_toolbox_add_tool(tools, "sketch_page", gt_sketch_page());
 #endif
-#if defined (HAVE_MYSQL) || defined (HAVE_SQLITE)
-  gt_toolbox_add_tool(tools, "featureindex", gt_featureindex());
-  gt_toolbox_add_tool(tools, "mkfeatureindex", gt_mkfeatureindex());
-#endif
 
   return tools;
 }
@@ -268,6 +279,7 @@ GtHashmap* gtt_unit_tests(void)
                                                    gt_array2dim_sparse_example);
   gt_hashmap_add(unit_tests, "array3dim example", gt_array3dim_example);
   gt_hashmap_add(unit_tests, "basename module", gt_basename_unit_test);
+  gt_hashmap_add(unit_tests, "bgzf class", gt_bgzf_unit_test);
   gt_hashmap_add(unit_tests, "bit pack array class", gt_bitpackarray_unit_test);
   gt_hashmap_add(unit_tests, "bit pack string module",
                                                     gt_bitPackString_unit_test);
@@ -290,14 +302,19 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "description buffer class",
                                                       gt_desc_buffer_unit_test);
   gt_hashmap_add(unit_tests, "disc distri class", gt_disc_distri_unit_test);
+  gt_hashmap_add(unit_tests, "disk feature index class",
+                                               gt_feature_index_disk_unit_test);
   gt_hashmap_add(unit_tests, "dlist class", gt_dlist_unit_test);
   gt_hashmap_add(unit_tests, "dlist example", gt_dlist_example);
   gt_hashmap_add(unit_tests, "dynamic bittab class", gt_dyn_bittab_unit_test);
+  gt_hashmap_add(unit_tests, "edist myers class", gt_edist_myers_unit_test);
   gt_hashmap_add(unit_tests, "elias gamma class", gt_elias_gamma_unit_test);
   gt_hashmap_add(unit_tests, "encdesc class", gt_encdesc_unit_test);
   gt_hashmap_add(unit_tests, "encseq builder class",
                                                    gt_encseq_builder_unit_test);
   gt_hashmap_add(unit_tests, "encseq gc module", gt_encseq_gc_unit_test);
+  gt_hashmap_add(unit_tests, "encseq unpack module",
+                                                    gt_encseq_unpack_unit_test);
   gt_hashmap_add(unit_tests, "evaluator class", gt_evaluator_unit_test);
   gt_hashmap_add(unit_tests, "feature node iterator example",
                                              gt_feature_node_iterator_example);
@@ -307,15 +324,22 @@ GtHashmap* gtt_unit_tests(void)
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
   gt_hashmap_add(unit_tests, "golomb class", gt_golomb_unit_test);
+  gt_hashmap_add(unit_tests, "gth DNA aligner module",
+                 gth_align_dna_unit_test);
+  gt_hashmap_add(unit_tests, "gth protein aligner module",
+                 gth_align_protein_unit_test);
   gt_hashmap_add(unit_tests, "hashmap class", gt_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
   gt_hashmap_add(unit_tests, "hmm class", gt_hmm_unit_test);
+  gt_hashmap_add(unit_tests, "hmmer model class", gt_hmmer_model_unit_test);
   gt_hashmap_add(unit_tests, "huffman coding class", gt_huffman_unit_test);
   gt_hashmap_add(unit_tests, "interval tree class", gt_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
   gt_hashmap_add(unit_tests, "memory allocator module", gt_ma_unit_test);
+  gt_hashmap_add(unit_tests, "memory feature index class",
+                                             gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
                                                           gt_spmlist_unit_test);
@@ -335,14 +359,21 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "safearith module", gt_safearith_unit_test);
   gt_hashmap_add(unit_tests, "sequence buffer class",
                                                   gt_sequence_buffer_unit_test);
+  gt_hashmap_add(unit_tests, "sequence buffer replay class",
+                 gt_sequence_buffer_replay_unit_test);
+  gt_hashmap_add(unit_tests, "slab class", gt_slab_unit_test);
   gt_hashmap_add(unit_tests, "splicedseq class", gt_splicedseq_unit_test);
   gt_hashmap_add(unit_tests, "splitter class", gt_splitter_unit_test);
+  gt_hashmap_add(unit_tests, "static interval tree class",
+                                             gt_static_interval_tree_unit_test);
   gt_hashmap_add(unit_tests, "string class", gt_str_unit_test);
   gt_hashmap_add(unit_tests, "string matching module",
                                                   gt_string_matching_unit_test);
   gt_hashmap_add(unit_tests, "symbol module", gt_symbol_unit_test);
+  gt_hashmap_add(unit_tests, "swprofile class", gt_swprofile_unit_test);
   gt_hashmap_add(unit_tests, "tag value map class", gt_tag_value_map_unit_test);
   gt_hashmap_add(unit_tests, "tag value map example", gt_tag_value_map_example);
+  gt_hashmap_add(unit_tests, "thread pool class", gt_thread_pool_unit_test);
   gt_hashmap_add(unit_tests, "tokenizer class", gt_tokenizer_unit_test);
   gt_hashmap_add(unit_tests, "translator class", gt_translator_unit_test);
   gt_hashmap_add(unit_tests, "uint64hashtable", gt_uint64hashtable_unit_test);
@@ -352,8 +383,6 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "diagram class", gt_diagram_unit_test);
   gt_hashmap_add(unit_tests, "style class", gt_style_unit_test);
   gt_hashmap_add(unit_tests, "element class", gt_element_unit_test);
-  gt_hashmap_add(unit_tests, "memory feature index class",
-                                             gt_feature_index_memory_unit_test);
   gt_hashmap_add(unit_tests, "imageinfo class", gt_image_info_unit_test);
   gt_hashmap_add(unit_tests, "line class", gt_line_unit_test);
   gt_hashmap_add(unit_tests, "track class", gt_track_unit_test);
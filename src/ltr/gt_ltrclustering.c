@@ -32,9 +32,8 @@ typedef struct {
   GtStr  *file_prefix;
   GtUword psmall,
                 plarge;
-  double xdrop,
-         identity;
-  int wordsize;
+  int xdrop,
+      seedlength;
 } GtLTRClusteringArguments;
 
 static void* gt_ltrclustering_arguments_new(void)
@@ -88,6 +87,21 @@ static GtOptionParser* gt_ltrclustering_option_parser_new(void *tool_arguments)
 
   gt_option_is_mandatory(option);
 
+  /* -seedlength */
+  option = gt_option_new_int_min("seedlength", "specify the minimal length of "
+                                 "the exact matches which are extended to "
+                                 "local alignments",
+                                 &arguments->seedlength, 14, 1);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
+  /* -xdrop */
+  option = gt_option_new_int_min("xdrop", "specify xdropbelowscore for the "
+                                 "extension of the exact matches",
+                                 &arguments->xdrop, 20, 0);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
+
   gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
 
   gt_option_parser_set_min_args(op, 1U);
@@ -127,12 +141,8 @@ static int gt_ltrclustering_runner(int argc, const char **argv,
                                                          GT_UNDEF_INT,
                                                          GT_UNDEF_INT,
                                                          GT_UNDEF_INT,
-                                                         GT_UNDEF_INT,
-                                                         GT_UNDEF_INT,
-                                                         GT_UNDEF_INT,
-                                                         GT_UNDEF_INT,
-                                                         10,
-                                                         GT_UNDEF_INT,
+                                                         arguments->xdrop,
+                                                         arguments->seedlength,
                                                          GT_UNDEF_INT,
                                                          arguments->plarge,
                                                          arguments->psmall,
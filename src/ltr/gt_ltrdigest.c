@@ -46,7 +46,7 @@
 #include "core/encseq.h"
 
 typedef struct GtLTRdigestOptions {
-  GtStr *trna_lib, *prefix, *cutoffs;
+  GtStr *trna_lib, *prefix, *cutoffs, *pdomsearch;
   bool verbose,
        write_alignments,
        write_aaseqs,
@@ -57,6 +57,7 @@ typedef struct GtLTRdigestOptions {
   GtStrArray *hmm_files;
   GtSeqid2FileInfo *s2fi;
   GtPdomCutoff cutoff;
+  GtPdomSearch search;
   double evalue_cutoff;
   GtUword nthreads;
   unsigned int chain_max_gap_length,
@@ -90,6 +91,7 @@ static void* gt_ltrdigest_arguments_new(void)
   arguments->trna_lib = gt_str_new();
   arguments->prefix = gt_str_new();
   arguments->cutoffs = gt_str_new();
+  arguments->pdomsearch = gt_str_new();
   arguments->ofi = gt_output_file_info_new();
   arguments->hmm_files = gt_str_array_new();
   arguments->s2fi = gt_seqid2file_info_new();
@@ -103,6 +105,7 @@ static void gt_ltrdigest_arguments_delete(void *tool_arguments)
   gt_str_delete(arguments->trna_lib);
   gt_str_delete(arguments->prefix);
   gt_str_delete(arguments->cutoffs);
+  gt_str_delete(arguments->pdomsearch);
   gt_str_array_delete(arguments->hmm_files);
   gt_file_delete(arguments->outfp);
   gt_output_file_info_delete(arguments->ofi);
@@ -117,6 +120,7 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   GtOption *o, *ot, *oto;
   GtOption *oh, *oc, *oeval;
   static const char *cutoffs[] = {"NONE", "GA", "TC", NULL};
+  static const char *searches[] = {"hmmscan", "builtin", NULL};
   static GtRange pptlen_defaults           = { 8UL, 30UL},
                  uboxlen_defaults          = { 3UL, 30UL},
                  pbsalilen_defaults        = {11UL, 30UL},
@@ -305,6 +309,17 @@ static GtOptionParser* gt_ltrdigest_option_parser_new(void *tool_arguments)
   gt_option_is_extended_option(oeval);
   gt_option_imply(oeval, oh);
 
+  o = gt_option_new_choice("pdomsearch", "program used for the pHMM search\n"
+                                         "choose from hmmscan (external "
+                                         "HMMER3 hmmscan) | builtin "
+                                         "(in-process, requires the chosen "
+                                         "cutoffs in the models, no domain "
+                                         "envelopes or bias correction)",
+                           arguments->pdomsearch, searches[0], searches);
+  gt_option_parser_add_option(op, o);
+  gt_option_is_extended_option(o);
+  gt_option_imply(o, oh);
+
   o = gt_option_new_bool("aliout",
                          "output pHMM to amino acid sequence alignments",
                          &arguments->write_alignments,
@@ -506,6 +521,10 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
       gt_error_set(err, "invalid cutoff setting!");
       had_err = -1;
     }
+    if (!strcmp(gt_str_get(arguments->pdomsearch), "builtin"))
+      arguments->search = GT_PDOM_SEARCH_BUILTIN;
+    else
+      arguments->search = GT_PDOM_SEARCH_HMMSCAN;
   }
 
   if (!had_err) {
@@ -514,7 +533,7 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
 
   if (!had_err && gt_str_array_size(arguments->hmm_files) > 0) {
     GtNodeVisitor *pdom_v;
-    ms = gt_pdom_model_set_new(arguments->hmm_files, err);
+    ms = gt_pdom_model_set_new(arguments->hmm_files, arguments->search, err);
     if (ms != NULL) {
       pdom_v = gt_ltrdigest_pdom_visitor_new(ms, arguments->evalue_cutoff,
                                              arguments->chain_max_gap_length,
@@ -528,7 +547,9 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
         if (arguments->output_all_chains)
           gt_ltrdigest_pdom_visitor_output_all_chains((GtLTRdigestPdomVisitor*)
                                                                         pdom_v);
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
+        last_stream = pdom_stream =
+                  gt_visitor_stream_new_batched(last_stream, pdom_v,
+                                         gt_ltrdigest_pdom_visitor_visit_nodes);
       }
     } else had_err = -1;
   }
@@ -546,7 +567,9 @@ static int gt_ltrdigest_runner(GT_UNUSED int argc, const char **argv,
                                          arguments->ali_score_deletion,
                                          arguments->trna_lib_bs, err);
     if (pbs_v != NULL)
-      last_stream = pbs_stream = gt_visitor_stream_new(last_stream, pbs_v);
+      last_stream = pbs_stream =
+                   gt_visitor_stream_new_batched(last_stream, pbs_v,
+                                          gt_ltrdigest_pbs_visitor_visit_nodes);
     else
       had_err = -1;
   }
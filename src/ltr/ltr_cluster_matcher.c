@@ -0,0 +1,323 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include "core/array.h"
+#include "core/chardef.h"
+#include "core/encseq.h"
+#include "core/ma.h"
+#include "core/readmode.h"
+#include "core/thread_pool.h"
+#include "core/undef_api.h"
+#include "core/unused_api.h"
+#include "match/esa-mmsearch.h"
+#include "match/querymatch.h"
+#include "match/seqabstract.h"
+#include "ltr/ltr_cluster_matcher.h"
+
+/* A maximal exact match of a query (one strand of a sequence) with sequence
+   <seqnum>, <dbpos> is the position in the encoded sequence. */
+typedef struct {
+  GtUword seqnum,
+          dbpos,
+          querypos,
+          length;
+} GtLTRClusterSeed;
+
+typedef struct {
+  GtXdropresources *xdropresources;
+  GtSeqabstract *useq,
+                *vseq;
+  GtArray *seeds,
+          *alignments;
+  GtUchar *query;
+  GtError *err;
+} GtLTRClusterMatcherResources;
+
+typedef struct {
+  const GtEncseq *encseq;
+  const GtUchar *dbseq;
+  GtQuerysubstringmatcher *qsm;
+  GtThreadPool *pool;
+  GtLTRClusterMatcherResources *resources;
+  GtUword seedlength;
+  GtXdropArbitraryscores scores;
+  GtXdropscore xdropbelowscore,
+               minscore;
+  GtArray **matchtab; /* the alignments of each sequence */
+  GtError **errtab;   /* set if matching a sequence failed */
+} GtLTRClusterMatcherInfo;
+
+typedef struct {
+  GtUword seqnum;
+  GtArray *seeds;
+} GtLTRClusterQuery;
+
+static int ltr_cluster_save_seed(void *data, const GtEncseq *encseq,
+                                 const GtQuerymatch *querymatch,
+                                 GT_UNUSED const GtUchar *query,
+                                 GT_UNUSED GtUword query_totallength,
+                                 GT_UNUSED GtError *err)
+{
+  GtLTRClusterQuery *queryinfo = data;
+  GtLTRClusterSeed seed;
+
+  seed.dbpos = gt_querymatch_dbstart(querymatch);
+  seed.seqnum = gt_encseq_seqnum(encseq, seed.dbpos);
+  /* every pair of sequences is compared once */
+  if (seed.seqnum > queryinfo->seqnum) {
+    seed.querypos = gt_querymatch_querystart(querymatch);
+    seed.length = gt_querymatch_querylen(querymatch);
+    gt_array_add(queryinfo->seeds, seed);
+  }
+  return 0;
+}
+
+/* sort by sequence, diagonal and query position, such that the seeds of an
+   alignment are extended in the order of their position */
+static int ltr_cluster_seed_cmp(const void *a, const void *b)
+{
+  const GtLTRClusterSeed *seeda = a, *seedb = b;
+  GtWord diaga, diagb;
+
+  if (seeda->seqnum != seedb->seqnum)
+    return seeda->seqnum < seedb->seqnum ? -1 : 1;
+  diaga = (GtWord) seeda->dbpos - (GtWord) seeda->querypos;
+  diagb = (GtWord) seedb->dbpos - (GtWord) seedb->querypos;
+  if (diaga != diagb)
+    return diaga < diagb ? -1 : 1;
+  if (seeda->querypos != seedb->querypos)
+    return seeda->querypos < seedb->querypos ? -1 : 1;
+  return 0;
+}
+
+static bool ltr_cluster_seed_is_covered(const GtArray *alignments,
+                                        const GtRange *range1,
+                                        const GtRange *range2)
+{
+  GtUword i;
+
+  for (i = 0; i < gt_array_size(alignments); i++) {
+    const GtLTRClusterMatch *ali = gt_array_get(alignments, i);
+    if (gt_range_contains(&ali->range1, range1) &&
+        gt_range_contains(&ali->range2, range2)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Extend the seeds of the query <query> of length <querylen>, which is the
+   forward or (if <reverse> is true) the reverse complemented strand of
+   sequence <seqnum>, and append the alignments to <matches>. */
+static void ltr_cluster_extend_seeds(const GtLTRClusterMatcherInfo *info,
+                                     GtLTRClusterMatcherResources *res,
+                                     GtUword seqnum, bool reverse,
+                                     GtUword querylen, GtArray *matches)
+{
+  GtUword i, dbstart = 0, dbend = 0, currentseqnum = GT_UNDEF_UWORD;
+
+  gt_array_sort(res->seeds, ltr_cluster_seed_cmp);
+  gt_array_reset(res->alignments);
+  for (i = 0; i < gt_array_size(res->seeds); i++) {
+    const GtLTRClusterSeed *seed = gt_array_get(res->seeds, i);
+    GtXdropbest left, right;
+    GtLTRClusterMatch ali;
+
+    if (seed->seqnum != currentseqnum) {
+      currentseqnum = seed->seqnum;
+      dbstart = gt_encseq_seqstartpos(info->encseq, currentseqnum);
+      dbend = dbstart + gt_encseq_seqlength(info->encseq, currentseqnum);
+      gt_array_reset(res->alignments);
+    }
+    ali.seqnum1 = seqnum;
+    ali.seqnum2 = currentseqnum;
+    ali.reverse = reverse;
+    if (reverse) {
+      ali.range1.start = querylen - seed->querypos - seed->length;
+      ali.range1.end = querylen - 1 - seed->querypos;
+    } else {
+      ali.range1.start = seed->querypos;
+      ali.range1.end = seed->querypos + seed->length - 1;
+    }
+    ali.range2.start = seed->dbpos - dbstart;
+    ali.range2.end = ali.range2.start + seed->length - 1;
+    if (ltr_cluster_seed_is_covered(res->alignments, &ali.range1, &ali.range2))
+      continue;
+
+    left.ivalue = left.jvalue = 0;
+    left.score = 0;
+    if (seed->querypos > 0 && seed->dbpos > dbstart) {
+      gt_seqabstract_reinit_gtuchar(res->useq, res->query, seed->querypos, 0);
+      gt_seqabstract_reinit_gtuchar(res->vseq, info->dbseq,
+                                    seed->dbpos - dbstart, 0);
+      gt_evalxdroparbitscoresextend(false, &left, res->xdropresources,
+                                    res->useq, res->vseq, seed->querypos,
+                                    seed->dbpos, info->xdropbelowscore);
+    }
+    right.ivalue = right.jvalue = 0;
+    right.score = 0;
+    if (seed->querypos + seed->length < querylen &&
+        seed->dbpos + seed->length < dbend) {
+      gt_seqabstract_reinit_gtuchar(res->useq, res->query,
+                                    querylen - (seed->querypos + seed->length),
+                                    0);
+      gt_seqabstract_reinit_gtuchar(res->vseq, info->dbseq,
+                                    dbend - (seed->dbpos + seed->length), 0);
+      gt_evalxdroparbitscoresextend(true, &right, res->xdropresources,
+                                    res->useq, res->vseq,
+                                    seed->querypos + seed->length,
+                                    seed->dbpos + seed->length,
+                                    info->xdropbelowscore);
+    }
+
+    if (reverse) {
+      ali.range1.start -= right.ivalue;
+      ali.range1.end += left.ivalue;
+    } else {
+      ali.range1.start -= left.ivalue;
+      ali.range1.end += right.ivalue;
+    }
+    ali.range2.start -= left.jvalue;
+    ali.range2.end += right.jvalue;
+    ali.score = (GtXdropscore) seed->length * info->scores.mat + left.score
+                + right.score;
+    gt_array_add(res->alignments, ali);
+    if (ali.score >= info->minscore)
+      gt_array_add(matches, ali);
+  }
+}
+
+static void ltr_cluster_match_seqs(GtUword start, GtUword end, void *data)
+{
+  const GtLTRClusterMatcherInfo *info = data;
+  GtLTRClusterMatcherResources *res
+    = info->resources + gt_thread_pool_thread_num(info->pool);
+  GtLTRClusterQuery queryinfo;
+  GtUword i, k;
+
+  queryinfo.seeds = res->seeds;
+  for (i = start; i < end; i++) {
+    const GtUword seqstart = gt_encseq_seqstartpos(info->encseq, i),
+                  seqlen = gt_encseq_seqlength(info->encseq, i);
+    int strand;
+
+    queryinfo.seqnum = i;
+    for (strand = 0; strand < 2; strand++) {
+      const bool reverse = strand == 1 ? true : false;
+      if (reverse) {
+        for (k = 0; k < seqlen; k++) {
+          GtUchar cc = info->dbseq[seqstart + seqlen - 1 - k];
+          res->query[k] = ISSPECIAL(cc) ? cc : GT_COMPLEMENTBASE(cc);
+        }
+      } else
+        memcpy(res->query, info->dbseq + seqstart, sizeof (GtUchar) * seqlen);
+      gt_array_reset(res->seeds);
+      if (gt_querysubstringmatcher_run(info->qsm, res->query, seqlen,
+                                       info->seedlength,
+                                       ltr_cluster_save_seed, &queryinfo,
+                                       res->err) != 0) {
+        info->errtab[i] = res->err;
+        return;
+      }
+      ltr_cluster_extend_seeds(info, res, i, reverse, seqlen,
+                               info->matchtab[i]);
+    }
+  }
+}
+
+int gt_ltr_cluster_matcher_run(const GtEncseq *encseq,
+                               GtUword seedlength,
+                               const GtXdropArbitraryscores *scores,
+                               GtXdropscore xdropbelowscore,
+                               GtXdropscore minscore,
+                               GtArray *matches,
+                               GtError *err)
+{
+  GtLTRClusterMatcherInfo info;
+  GtUchar *dbseq;
+  GtUword i, numofseqs, totallength, maxseqlen = 0;
+  unsigned int t, numofthreads;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(encseq && scores && matches && seedlength > 0);
+  numofseqs = gt_encseq_num_of_sequences(encseq);
+  if (numofseqs < 2UL)
+    return 0;
+  info.qsm = gt_querysubstringmatcher_new(encseq, err);
+  if (info.qsm == NULL)
+    return -1;
+  totallength = gt_encseq_total_length(encseq);
+  dbseq = gt_malloc(sizeof (GtUchar) * totallength);
+  gt_encseq_extract_encoded(encseq, dbseq, 0, totallength - 1);
+  for (i = 0; i < numofseqs; i++) {
+    if (gt_encseq_seqlength(encseq, i) > maxseqlen)
+      maxseqlen = gt_encseq_seqlength(encseq, i);
+  }
+
+  info.encseq = encseq;
+  info.dbseq = dbseq;
+  info.pool = gt_thread_pool_get();
+  info.seedlength = seedlength;
+  info.scores = *scores;
+  info.xdropbelowscore = xdropbelowscore;
+  info.minscore = minscore;
+  numofthreads = gt_thread_pool_size(info.pool);
+  info.resources = gt_malloc(sizeof (*info.resources) * numofthreads);
+  for (t = 0; t < numofthreads; t++) {
+    info.resources[t].xdropresources = gt_xdrop_resources_new(scores);
+    info.resources[t].useq = gt_seqabstract_new_empty();
+    info.resources[t].vseq = gt_seqabstract_new_empty();
+    info.resources[t].seeds = gt_array_new(sizeof (GtLTRClusterSeed));
+    info.resources[t].alignments = gt_array_new(sizeof (GtLTRClusterMatch));
+    info.resources[t].query = gt_malloc(sizeof (GtUchar) * maxseqlen);
+    info.resources[t].err = gt_error_new();
+  }
+  info.matchtab = gt_malloc(sizeof (*info.matchtab) * numofseqs);
+  info.errtab = gt_calloc((size_t) numofseqs, sizeof (*info.errtab));
+  for (i = 0; i < numofseqs; i++)
+    info.matchtab[i] = gt_array_new(sizeof (GtLTRClusterMatch));
+
+  gt_thread_pool_parallel_for(info.pool, 0, numofseqs, 1UL,
+                              ltr_cluster_match_seqs, &info);
+
+  /* collect the alignments in the order of the sequences */
+  for (i = 0; i < numofseqs; i++) {
+    if (!had_err && info.errtab[i] != NULL) {
+      gt_error_set(err, "%s", gt_error_get(info.errtab[i]));
+      had_err = -1;
+    }
+    if (!had_err)
+      gt_array_add_array(matches, info.matchtab[i]);
+    gt_array_delete(info.matchtab[i]);
+  }
+  gt_free(info.errtab);
+  gt_free(info.matchtab);
+  for (t = 0; t < numofthreads; t++) {
+    gt_xdrop_resources_delete(info.resources[t].xdropresources);
+    gt_seqabstract_delete(info.resources[t].useq);
+    gt_seqabstract_delete(info.resources[t].vseq);
+    gt_array_delete(info.resources[t].seeds);
+    gt_array_delete(info.resources[t].alignments);
+    gt_free(info.resources[t].query);
+    gt_error_delete(info.resources[t].err);
+  }
+  gt_free(info.resources);
+  gt_free(dbseq);
+  gt_querysubstringmatcher_delete(info.qsm);
+  return had_err;
+}
@@ -0,0 +1,56 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTR_CLUSTER_MATCHER_H
+#define LTR_CLUSTER_MATCHER_H
+
+#include "core/array_api.h"
+#include "core/encseq_api.h"
+#include "core/error_api.h"
+#include "core/range_api.h"
+#include "match/xdrop.h"
+
+/* A local alignment of two different sequences of an encoded sequence. The
+   ranges are relative to the start of the sequences and refer to their
+   forward strands, <reverse> is true if the reverse complement of sequence
+   <seqnum1> was aligned to sequence <seqnum2>. */
+typedef struct {
+  GtUword seqnum1,
+          seqnum2;
+  GtRange range1,
+          range2;
+  GtXdropscore score;
+  bool reverse;
+} GtLTRClusterMatch;
+
+/* Compares all sequences of the DNA sequence <encseq> with each other, on both
+   strands, and appends the local alignments with a score of at least
+   <minscore> to <matches>, with <seqnum1> smaller than <seqnum2>. Maximal
+   exact matches of length at least <seedlength>, found with an in-memory
+   suffix array of <encseq>, are extended to both sides with the X-drop
+   algorithm using <scores> and <xdropbelowscore>, seeds lying inside an
+   alignment already computed are skipped. The sequences are compared in
+   parallel (use <gt -j>), the order of <matches> does not depend on the number
+   of threads. Returns 0 on success, -1 on error (<err> is set). */
+int gt_ltr_cluster_matcher_run(const GtEncseq *encseq,
+                               GtUword seedlength,
+                               const GtXdropArbitraryscores *scores,
+                               GtXdropscore xdropbelowscore,
+                               GtXdropscore minscore,
+                               GtArray *matches,
+                               GtError *err);
+
+#endif
@@ -33,12 +33,9 @@
 #include "extended/feature_type.h"
 #include "extended/node_stream_api.h"
 #include "extended/match.h"
-#include "extended/match_iterator_api.h"
-#include "extended/match_iterator_last.h"
-#include "extended/match_iterator_open.h"
+#include "ltr/ltr_cluster_matcher.h"
 #include "ltr/ltr_cluster_stream.h"
 #include "ltr/ltr_cluster_prepare_seq_visitor.h"
-#include "match/sfx-run.h"
 
 struct GtLTRClusterStream {
   const GtNodeStream parent_instance;
@@ -51,12 +48,21 @@ struct GtLTRClusterStream {
   GtUword psmall,
                 plarge,
                 next_index;
-  int match_score, mismatch_cost, gap_open_cost,
-      gap_ext_cost, xdrop, ydrop, zdrop, mscoregapped,
-      mscoregapless, k;
+  GtUword seedlength;
+  GtXdropArbitraryscores arbitscores;
+  GtXdropscore xdropbelowscore,
+               minscore;
   char **current_state;
 };
 
+/* defaults for the similarity search */
+#define GT_LTR_CLUSTER_SEEDLENGTH     14UL
+#define GT_LTR_CLUSTER_MATCHSCORE     2
+#define GT_LTR_CLUSTER_MISMATCHSCORE  -2
+#define GT_LTR_CLUSTER_GAPSCORE       -3
+#define GT_LTR_CLUSTER_XDROP          20
+#define GT_LTR_CLUSTER_MINSCORE       40
+
 #define gt_ltr_cluster_stream_cast(CS)\
         gt_node_stream_cast(gt_ltr_cluster_stream_class(), CS);
 
@@ -144,30 +150,24 @@ static int gt_cluster_matches(GtClusteredSet *cs,
 
 static int cluster_sequences(GtArray *matches,
                              GtClusteredSet *cs,
-                             GtHashmap *seqdesc2seqnum,
                              unsigned int psmall,
                              unsigned int plarge,
                              GtEncseq *encseq,
                              GtError *err)
 {
-  GtMatch *match;
+  GtLTRClusterMatch *match;
   GtMatchEdgeTable matchedgetab;
   GtMatchEdge matchedge;
-  GtRange rng_seq1,
-          rng_seq2;
   int had_err = 0;
   GtUword i,
                 lsmall,
                 llarge,
                 matchlen1,
                 matchlen2,
-                num_of_seq,
-                seqnum1 = 0,
-                seqnum2 = 0;
-  const char *seqid;
+                num_of_seq;
 
   num_of_seq = gt_encseq_num_of_sequences(encseq);
-  gt_assert(matches && cs && seqdesc2seqnum && encseq);
+  gt_assert(matches && cs && encseq);
 
   if (gt_clustered_set_num_of_elements(cs, err) != num_of_seq) {
     had_err = -1;
@@ -181,57 +181,34 @@ static int cluster_sequences(GtArray *matches,
     matchedgetab.num_of_edges = 0;
 
     for (i = 0; i < gt_array_size(matches); i++) {
-      match = *(GtMatch**) gt_array_get(matches, i);
-      gt_match_get_range_seq1(match, &rng_seq1);
-      gt_match_get_range_seq2(match, &rng_seq2);
-
-      matchlen1 =  gt_range_length(&rng_seq1);
-      matchlen2 =  gt_range_length(&rng_seq2);
-
-      seqid = gt_match_get_seqid1(match);
-      if (gt_hashmap_get(seqdesc2seqnum, (void*) seqid) != NULL)
-        seqnum1 = ((GtUword) gt_hashmap_get(seqdesc2seqnum, seqid)) - 1;
-      else {
-        had_err = -1;
-        gt_error_set(err, "key %s not found", seqid);
+      match = (GtLTRClusterMatch*) gt_array_get(matches, i);
+      matchlen1 =  gt_range_length(&match->range1);
+      matchlen2 =  gt_range_length(&match->range2);
+
+      if (gt_encseq_seqlength(encseq, match->seqnum1) >
+          gt_encseq_seqlength(encseq, match->seqnum2)) {
+        llarge = gt_encseq_seqlength(encseq, match->seqnum1);
+        lsmall = gt_encseq_seqlength(encseq, match->seqnum2);
+      } else {
+        lsmall = gt_encseq_seqlength(encseq, match->seqnum1);
+        llarge = gt_encseq_seqlength(encseq, match->seqnum2);
       }
-
-      seqid = gt_match_get_seqid2(match);
-      if (!had_err && gt_hashmap_get(seqdesc2seqnum, (void*) seqid) != NULL)
-        seqnum2 = ((GtUword) gt_hashmap_get(seqdesc2seqnum, seqid)) - 1;
-      else {
-        had_err = -1;
-        gt_error_set(err, "key %s not found", seqid);
-      }
-
-      if (!had_err) {
-        if (gt_encseq_seqlength(encseq, seqnum1) >
-            gt_encseq_seqlength(encseq, seqnum2)) {
-          llarge = gt_encseq_seqlength(encseq, seqnum1);
-          lsmall = gt_encseq_seqlength(encseq, seqnum2);
-        } else {
-          lsmall = gt_encseq_seqlength(encseq, seqnum1);
-          llarge = gt_encseq_seqlength(encseq, seqnum2);
-        }
-        if (((llarge * plarge)/100 <= matchlen1) &&
-            ((lsmall * psmall)/100 <= matchlen1) &&
-            ((llarge * plarge)/100 <= matchlen2) &&
-            ((lsmall * psmall)/100 <= matchlen2)) {
-          if (seqnum1 != seqnum2) {
-            matchedge.matchnum0 = seqnum1;
-            matchedge.matchnum1 = seqnum2;
-            gt_array_add(matchedgetab.edges, matchedge);
-            matchedgetab.num_of_edges++;
-          }
+      if (((llarge * plarge)/100 <= matchlen1) &&
+          ((lsmall * psmall)/100 <= matchlen1) &&
+          ((llarge * plarge)/100 <= matchlen2) &&
+          ((lsmall * psmall)/100 <= matchlen2)) {
+        if (match->seqnum1 != match->seqnum2) {
+          matchedge.matchnum0 = match->seqnum1;
+          matchedge.matchnum1 = match->seqnum2;
+          gt_array_add(matchedgetab.edges, matchedge);
+          matchedgetab.num_of_edges++;
         }
       }
     }
-  }
-  if (!had_err)
     if (gt_cluster_matches(cs, &matchedgetab, err) != 0)
       had_err = -1;
-  if (!had_err)
     gt_array_delete(matchedgetab.edges);
+  }
   return had_err;
 }
 
@@ -321,7 +298,7 @@ static int cluster_annotate_nodes(GtClusteredSet *cs, GtEncseq *encseq,
       continue;
     fni = gt_feature_node_iterator_new((GtFeatureNode*) gn);
     while ((curnode = gt_feature_node_iterator_next(fni)) != NULL) {
-      char header[BUFSIZ];
+      char header[2 * BUFSIZ];
       fnt = gt_feature_node_get_type(curnode);
       if (strcmp(fnt, gt_ft_repeat_region) == 0) {
         const char *rid;
@@ -341,7 +318,7 @@ static int cluster_annotate_nodes(GtClusteredSet *cs, GtEncseq *encseq,
         range = gt_genome_node_get_range((GtGenomeNode*) curnode);
         if ((range.end - range.start + 1) < 10UL)
           continue;
-        (void) snprintf(header, BUFSIZ, "%s_"GT_WU"_"GT_WU"", buffer,
+        (void) snprintf(header, sizeof header, "%s_"GT_WU"_"GT_WU"", buffer,
                         range.start, range.end);
         gt_hashmap_add(desc2node, (void*) gt_cstr_dup(header), (void*) curnode);
       } else if (strcmp(fnt, real_feature) == 0) {
@@ -349,7 +326,7 @@ static int cluster_annotate_nodes(GtClusteredSet *cs, GtEncseq *encseq,
         range = gt_genome_node_get_range((GtGenomeNode*) curnode);
         if ((range.end - range.start + 1) < 10UL)
           continue;
-        (void) snprintf(header, BUFSIZ, "%s_"GT_WU"_"GT_WU"", buffer,
+        (void) snprintf(header, sizeof header, "%s_"GT_WU"_"GT_WU"", buffer,
                         range.start, range.end);
         gt_hashmap_add(desc2node, (void*) gt_cstr_dup(header), (void*) curnode);
       }
@@ -390,11 +367,7 @@ static int process_feature(GtLTRClusterStream *lcs,
                            GtError *err)
 {
   GtArray *matches;
-  GtMatchIterator *mi = NULL;
-  GtMatch *match = NULL;
-  GtMatchIteratorStatus status;
   GtEncseq *encseq;
-  GtUword i;
   int had_err = 0;
 
   if (lcs->current_state != NULL) {
@@ -403,57 +376,19 @@ static int process_feature(GtLTRClusterStream *lcs,
     (void) snprintf(tmp, BUFSIZ, "Clustering feature: %s", feature);
     *lcs->current_state = gt_cstr_dup(tmp);
   }
-  matches = gt_array_new(sizeof(GtMatch*));
+  matches = gt_array_new(sizeof (GtLTRClusterMatch));
   encseq = (GtEncseq*) gt_hashmap_get(lcs->feat_to_encseq, feature);
   gt_log_log("found encseq %p for feature %s", encseq, feature);
-  if (!had_err) {
-    mi = gt_match_iterator_last_new(encseq, encseq, lcs->match_score,
-                                        lcs->mismatch_cost,
-                                        lcs->gap_open_cost,
-                                        lcs->gap_ext_cost,
-                                        lcs->xdrop,
-                                        lcs->ydrop,
-                                        lcs->zdrop,
-                                        lcs->k,
-                                        lcs->mscoregapped,
-                                        lcs->mscoregapless, err);
-    if (mi != NULL) {
-      while ((status = gt_match_iterator_next(mi, &match, err))
-             != GT_MATCHER_STATUS_END) {
-        if (status == GT_MATCHER_STATUS_OK) {
-          gt_array_add(matches, match);
-        } else {
-          gt_assert(status == GT_MATCHER_STATUS_ERROR);
-          had_err = -1;
-          break;
-        }
-      }
-    } else
-      had_err = -1;
-  }
+  had_err = gt_ltr_cluster_matcher_run(encseq, lcs->seedlength,
+                                       &lcs->arbitscores, lcs->xdropbelowscore,
+                                       lcs->minscore, matches, err);
   if (!had_err) {
     GtClusteredSet *cs;
-    GtHashmap *seqdesc2seqnum;
-    GtMatch *tmp_match;
-    const char *description;
-    char *output;
-    GtUword desclen,
-                  num_of_seq;
-
-    seqdesc2seqnum = gt_hashmap_new(GT_HASH_STRING, free_hash, NULL);
-    num_of_seq = gt_encseq_num_of_sequences(encseq);
-    for (i = 0; i < num_of_seq; i++) {
-      description = gt_encseq_description(encseq, &desclen, i);
-      output = gt_calloc((size_t) (desclen + 1), sizeof (char));
-      strncpy(output, description, (size_t) desclen);
-      output[desclen] = '\0';
-      gt_hashmap_add(seqdesc2seqnum, (void*) gt_cstr_dup(output),
-                     (void*) (i + 1));
-      gt_free(output);
-    }
-    cs = gt_clustered_set_union_find_new(num_of_seq, err);
+
+    cs = gt_clustered_set_union_find_new(gt_encseq_num_of_sequences(encseq),
+                                         err);
     if (cs != NULL) {
-      if (cluster_sequences(matches, cs, seqdesc2seqnum, (unsigned) lcs->psmall,
+      if (cluster_sequences(matches, cs, (unsigned) lcs->psmall,
                             (unsigned) lcs->plarge, encseq, err) != 0) {
         had_err = -1;
       }
@@ -462,17 +397,9 @@ static int process_feature(GtLTRClusterStream *lcs,
       }
     } else
       had_err = -1;
-
-    for (i = 0; i < gt_array_size(matches); i++) {
-      tmp_match = *(GtMatch**) gt_array_get(matches, i);
-      gt_match_delete(tmp_match);
-    }
-    gt_array_delete(matches);
-    matches = NULL;
-    gt_hashmap_delete(seqdesc2seqnum);
     gt_clustered_set_delete(cs, err);
   }
-  gt_match_iterator_delete(mi);
+  gt_array_delete(matches);
 
   return had_err;
 }
@@ -562,14 +489,10 @@ GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
                                         GtEncseq *encseq,
                                         int match_score,
                                         int mismatch_cost,
-                                        int gap_open_cost,
-                                        int gap_ext_cost,
+                                        int gap_cost,
                                         int xdrop,
-                                        int ydrop,
-                                        int zdrop,
-                                        int k,
-                                        int mscoregapped,
-                                        int mscoregapless,
+                                        int seedlength,
+                                        int min_score,
                                         GtUword plarge,
                                         GtUword psmall,
                                         char **current_state,
@@ -587,16 +510,19 @@ GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
                            gt_ltr_cluster_prepare_seq_visitor_new(encseq, err));
   lcs->first_next = true;
   lcs->next_index = 0;
-  lcs->match_score = match_score;
-  lcs->mismatch_cost = mismatch_cost;
-  lcs->gap_open_cost = gap_open_cost;
-  lcs->gap_ext_cost = gap_ext_cost;
-  lcs->xdrop = xdrop;
-  lcs->ydrop = ydrop;
-  lcs->zdrop = zdrop;
-  lcs->mscoregapped = mscoregapped;
-  lcs->mscoregapless = mscoregapless;
-  lcs->k = k;
+  lcs->arbitscores.mat = match_score != GT_UNDEF_INT
+                           ? match_score : GT_LTR_CLUSTER_MATCHSCORE;
+  lcs->arbitscores.mis = mismatch_cost != GT_UNDEF_INT
+                           ? -mismatch_cost : GT_LTR_CLUSTER_MISMATCHSCORE;
+  lcs->arbitscores.ins = lcs->arbitscores.del
+                       = gap_cost != GT_UNDEF_INT
+                           ? -gap_cost : GT_LTR_CLUSTER_GAPSCORE;
+  lcs->xdropbelowscore = xdrop != GT_UNDEF_INT
+                           ? (GtXdropscore) xdrop : GT_LTR_CLUSTER_XDROP;
+  lcs->seedlength = seedlength != GT_UNDEF_INT && seedlength > 0
+                      ? (GtUword) seedlength : GT_LTR_CLUSTER_SEEDLENGTH;
+  lcs->minscore = min_score != GT_UNDEF_INT
+                    ? (GtXdropscore) min_score : GT_LTR_CLUSTER_MINSCORE;
   lcs->plarge = plarge;
   lcs->psmall = psmall;
   lcs->current_state = current_state;
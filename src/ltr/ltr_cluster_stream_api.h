@@ -25,19 +25,24 @@
 typedef struct GtLTRClusterStream GtLTRClusterStream;
 
 /* Implements the <GtNodeStream> interface. <GtLTRClusterStream> annotates
-   all LTR features with cluster IDs, based on matches. */
+   all LTR features with cluster IDs, based on matches. The sequences of each
+   feature type are compared all-vs-all in-process (in parallel, use <gt -j>):
+   maximal exact matches of length at least <seedlength> are extended with the
+   X-drop algorithm (with <match_score>, <mismatch_cost> and the linear
+   <gap_cost>, stopping if the score drops by more than <xdrop>), and the
+   alignments with a score of at least <min_score> whose lengths in both
+   sequences cover <plarge> percent of the larger and <psmall> percent of the
+   smaller sequence join their clusters. Parameters set to <GT_UNDEF_INT> take
+   the default values 2 (<match_score>), 2 (<mismatch_cost>), 3 (<gap_cost>),
+   20 (<xdrop>), 14 (<seedlength>) and 40 (<min_score>). */
 GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
                                         GtEncseq *encseq,
                                         int match_score,
                                         int mismatch_cost,
-                                        int gap_open_cost,
-                                        int gap_ext_cost,
+                                        int gap_cost,
                                         int xdrop,
-                                        int ydrop,
-                                        int zdrop,
-                                        int k,
-                                        int mscoregapped,
-                                        int mscoregapless,
+                                        int seedlength,
+                                        int min_score,
                                         GtUword plarge,
                                         GtUword psmall,
                                         char **current_state,
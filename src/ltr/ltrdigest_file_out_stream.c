@@ -114,14 +114,12 @@ static int gt_ltrelement_format_description(GtLTRElement *e,
                                             char *buf, size_t buflen)
 {
   int ret;
-  char tmpstr[BUFSIZ];
   gt_assert(buf && e);
 
-  (void) snprintf(tmpstr, MIN(BUFSIZ, (size_t) seqnamelen+1), "%s", e->seqid);
-  tmpstr[seqnamelen+1] = '\0';
-  gt_cstr_rep(tmpstr, ' ', '_');
-  ret = snprintf(buf, buflen, "%s_"GT_WU"_"GT_WU"", tmpstr, e->leftLTR_5+1,
-                 e->rightLTR_3+1);
+  ret = snprintf(buf, buflen, "%.*s_"GT_WU"_"GT_WU"",
+                 (int) MIN(BUFSIZ - 1, seqnamelen), e->seqid,
+                 e->leftLTR_5+1, e->rightLTR_3+1);
+  gt_cstr_rep(buf, ' ', '_');
   return ret;
 }
 
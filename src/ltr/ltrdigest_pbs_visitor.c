@@ -29,6 +29,7 @@
 #include "core/str_api.h"
 #include "core/strand_api.h"
 #include "core/symbol_api.h"
+#include "core/thread_pool.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/alignment.h"
@@ -39,6 +40,7 @@
 #include "extended/node_visitor_api.h"
 #include "extended/reverse_api.h"
 #include "extended/swalign.h"
+#include "extended/swprofile.h"
 #include "ltr/ltrdigest_def.h"
 #include "ltr/ltrdigest_pbs_visitor.h"
 
@@ -46,11 +48,6 @@ struct GtLTRdigestPBSVisitor{
   const GtNodeVisitor parent_instance;
   GtRegionMapping *rmap;
   GtStr *tag;
-  GtFeatureNode *ltr_retrotrans;
-  GtUword leftLTR_3,
-                rightLTR_5,
-                leftltrlen,
-                rightltrlen;
   unsigned int radius,
                max_edist;
   GtRange alilen,
@@ -61,11 +58,32 @@ struct GtLTRdigestPBSVisitor{
       ali_score_insertion,
       ali_score_deletion;
   GtBioseq *trna_lib;
+  GtAlphabet *alpha;
+  GtScoreFunction *sf;
+  GtSeq **trnas_from3;
+  GtUword numoftrnas;
+  GtSWProfile *trna_profile;
+  GtWord min_score;
 };
 
+/* The LTR retrotransposon of a node and the sequences to search for its PBS,
+   kept apart from the visitor to search several candidates in parallel. */
+typedef struct GtPBSResults GtPBSResults;
+
 typedef struct {
+  GtFeatureNode *ltr_retrotrans;
+  GtUword leftLTR_3,
+          rightLTR_5,
+          leftltrlen,
+          rightltrlen;
+  GtStr *seq;
+  char *rev_seq;
+  GtPBSResults *results;
+} GtPBSCandidate;
+
+struct GtPBSResults {
   GtArray *hits;
-} GtPBSResults;
+};
 
 typedef struct {
   GtUword start,
@@ -109,6 +127,7 @@ static GtPBSResults* gt_pbs_results_new(void)
 }
 
 static GtRange gt_pbs_hit_get_coords(GtLTRdigestPBSVisitor *lv,
+                                     const GtPBSCandidate *c,
                                      const GtPBSHit *h)
 {
   GtRange rng;
@@ -119,12 +138,12 @@ static GtRange gt_pbs_hit_get_coords(GtLTRdigestPBSVisitor *lv,
   {
     case GT_STRAND_FORWARD:
     default:
-      rng.start = lv->leftLTR_3 + 1 - lv->radius
+      rng.start = c->leftLTR_3 + 1 - lv->radius
                     + rng.start;
       rng.end = rng.start + (h->end - h->start);
       break;
     case GT_STRAND_REVERSE:
-      rng.end = lv->rightLTR_5 - 1 + lv->radius - rng.start;
+      rng.end = c->rightLTR_5 - 1 + lv->radius - rng.start;
       rng.start = rng.end - (h->end - h->start);
       break;
   }
@@ -278,66 +297,119 @@ static int gt_pbs_hit_compare(const void *h1, const void *h2)
   return (gt_double_compare(hp2->score, hp1->score));
 }
 
-static GtPBSResults* gt_pbs_find(GtLTRdigestPBSVisitor *lv, const char *seq,
-                          const char *rev_seq, GtError *err)
+/* Return the minimal score of an alignment which satisfies the edit distance
+   and length constraints for PBS hits. Every such alignment contains at least
+   <alilen.start> - <max_edist> matching characters and at most <max_edist>
+   edit operations. As the alignment of a query and a tRNA is only used if it
+   is an optimal one, tRNAs whose optimal score is below this bound cannot
+   yield a hit. This does not hold if the query contains wildcards, because
+   equal wildcards are no edit operation but are scored as mismatches. */
+static GtWord gt_pbs_min_score(const GtLTRdigestPBSVisitor *lv)
+{
+  GtWord minmatches, minpenalty;
+  if (lv->ali_score_match <= 0)
+    return 1;
+  minmatches = lv->alilen.start > (GtUword) lv->max_edist
+               ? (GtWord) (lv->alilen.start - lv->max_edist)
+               : 0;
+  minpenalty = MIN(MIN(lv->ali_score_mismatch, lv->ali_score_insertion),
+                   MIN(lv->ali_score_deletion, 0));
+  return MAX((GtWord) lv->ali_score_match * minmatches
+               + (GtWord) lv->max_edist * minpenalty, 1);
+}
+
+static bool gt_pbs_has_wildcards(GtSeq *seq)
+{
+  const GtUchar *encoded = gt_seq_get_encoded(seq);
+  GtUword i;
+  for (i = 0; i < gt_seq_length(seq); i++) {
+    if (encoded[i] == (GtUchar) WILDCARD)
+      return true;
+  }
+  return false;
+}
+
+/* Score <seq> against the whole tRNA library at once, and select the tRNAs
+   which can yield a hit, for which the alignments are computed. That is, the
+   optimal score must reach the minimal score of a hit, and an optimal
+   alignment must begin within the offsets allowed for a PBS (tested with the
+   score of the alignments anchored there, if gaps are not rewarded).
+   <scores> provides space for twice the number of tRNAs. */
+static void gt_pbs_select_trnas(GtLTRdigestPBSVisitor *lv, GtSeq *seq,
+                                GtWord *scores, bool *selected)
+{
+  GtWord min_score = gt_pbs_has_wildcards(seq) ? 1 : lv->min_score,
+         *anchoredscores = scores + lv->numoftrnas;
+  bool anchored = lv->ali_score_insertion <= 0 && lv->ali_score_deletion <= 0;
+  GtUword j;
+
+  if (anchored) {
+    GtRange ustart, vstart;
+    ustart.start = lv->radius > lv->offsetlen.end
+                   ? lv->radius - lv->offsetlen.end
+                   : 0;
+    ustart.end = lv->radius + lv->offsetlen.end;
+    vstart = lv->trnaoffsetlen;
+    gt_swprofile_scores_anchored(lv->trna_profile, seq, ustart, vstart, scores,
+                                 anchoredscores);
+  } else
+    gt_swprofile_scores(lv->trna_profile, seq, scores);
+  for (j = 0; j < lv->numoftrnas; j++) {
+    selected[j] = scores[j] >= min_score
+                    && (!anchored || anchoredscores[j] >= scores[j]);
+  }
+}
+
+static void gt_pbs_align(GtLTRdigestPBSVisitor *lv, GtSeq *seq, GtUword j,
+                         GtStrand strand, GtPBSResults *results)
+{
+  GtAlignment *ali = gt_swalign(seq, lv->trnas_from3[j], lv->sf);
+  gt_pbs_add_hit(lv, results->hits, ali, gt_seq_length(lv->trnas_from3[j]),
+                 gt_seq_get_description(lv->trnas_from3[j]), strand,
+                 results);
+  gt_alignment_delete(ali);
+}
+
+static GtPBSResults* gt_pbs_find(GtLTRdigestPBSVisitor *lv,
+                                 const GtPBSCandidate *c)
 {
   GtSeq *seq_forward, *seq_rev;
   GtPBSResults *results;
+  GtWord *scores;
+  bool *selected_forward, *selected_rev;
   GtUword j;
-  GtAlignment *ali;
-  GtAlphabet *a = gt_alphabet_new_dna();
-  GtScoreFunction *sf;
-  gt_assert(lv && seq && rev_seq);
-
-  sf = gt_dna_scorefunc_new(a, lv->ali_score_match, lv->ali_score_mismatch,
-                            lv->ali_score_insertion, lv->ali_score_deletion);
+  gt_assert(lv && c && c->seq && c->rev_seq);
 
   results = gt_pbs_results_new();
 
-  seq_forward = gt_seq_new(seq + (lv->leftltrlen)
+  seq_forward = gt_seq_new(gt_str_get(c->seq) + (c->leftltrlen)
                                - (lv->radius),
                            (GtUword) (2 * lv->radius + 1),
-                           a);
+                           lv->alpha);
 
-  seq_rev     = gt_seq_new(rev_seq + (lv->rightltrlen)
-                                   - (lv->radius),
+  seq_rev     = gt_seq_new(c->rev_seq + (c->rightltrlen)
+                                      - (lv->radius),
                            (GtUword) (2 * lv->radius + 1),
-                           a);
+                           lv->alpha);
 
-  for (j = 0; j < gt_bioseq_number_of_sequences(lv->trna_lib); j++)
+  scores = gt_malloc(sizeof *scores * 2 * (lv->numoftrnas + 1));
+  selected_forward = gt_malloc(sizeof *selected_forward
+                               * 2 * (lv->numoftrnas + 1));
+  selected_rev = selected_forward + lv->numoftrnas + 1;
+  gt_pbs_select_trnas(lv, seq_forward, scores, selected_forward);
+  gt_pbs_select_trnas(lv, seq_rev, scores, selected_rev);
+
+  for (j = 0; j < lv->numoftrnas; j++)
   {
-    GtSeq *trna_seq, *trna_from3;
-    char *trna_from3_full;
-    GtUword trna_seqlen;
-
-    trna_seq = gt_bioseq_get_seq(lv->trna_lib, j);
-    trna_seqlen = gt_seq_length(trna_seq);
-
-    trna_from3_full = gt_calloc((size_t) trna_seqlen, sizeof (char));
-    memcpy(trna_from3_full, gt_seq_get_orig(trna_seq),
-           sizeof (char) * trna_seqlen);
-    (void) gt_reverse_complement(trna_from3_full, trna_seqlen, err);
-    trna_from3 = gt_seq_new_own(trna_from3_full, trna_seqlen, a);
-
-    ali = gt_swalign(seq_forward, trna_from3, sf);
-    gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_FORWARD,
-                   results);
-    gt_alignment_delete(ali);
-
-    ali = gt_swalign(seq_rev, trna_from3, sf);
-    gt_pbs_add_hit(lv, results->hits, ali, trna_seqlen,
-                   gt_seq_get_description(trna_seq), GT_STRAND_REVERSE,
-                   results);
-    gt_alignment_delete(ali);
-
-    gt_seq_delete(trna_seq);
-    gt_seq_delete(trna_from3);
+    if (selected_forward[j])
+      gt_pbs_align(lv, seq_forward, j, GT_STRAND_FORWARD, results);
+    if (selected_rev[j])
+      gt_pbs_align(lv, seq_rev, j, GT_STRAND_REVERSE, results);
   }
+  gt_free(selected_forward);
+  gt_free(scores);
   gt_seq_delete(seq_forward);
   gt_seq_delete(seq_rev);
-  gt_score_function_delete(sf);
-  gt_alphabet_delete(a);
   gt_array_sort(results->hits, gt_pbs_hit_compare);
   return results;
 }
@@ -359,6 +431,7 @@ static void gt_pbs_results_delete(GtPBSResults *results)
 }
 
 static void pbs_attach_results_to_gff3(GtLTRdigestPBSVisitor *lv,
+                                       const GtPBSCandidate *c,
                                        GtPBSResults *results,
                                        GtFeatureNode *mainnode,
                                        GtStrand *canonical_strand)
@@ -386,7 +459,7 @@ static void pbs_attach_results_to_gff3(GtLTRdigestPBSVisitor *lv,
       return;
   }
   gt_log_log("final strand %c", GT_STRAND_CHARS[hit->strand]);
-  pbs_range = gt_pbs_hit_get_coords(lv, hit);
+  pbs_range = gt_pbs_hit_get_coords(lv, c, hit);
   pbs_range.start++; pbs_range.end++;  /* GFF3 is 1-based */
   gf = gt_feature_node_new(gt_genome_node_get_seqid((GtGenomeNode*) mainnode),
                            gt_ft_primer_binding_site,
@@ -416,86 +489,173 @@ const GtNodeVisitorClass* gt_ltrdigest_pbs_visitor_class(void);
 #define gt_ltrdigest_pbs_visitor_cast(GV)\
         gt_node_visitor_cast(gt_ltrdigest_pbs_visitor_class(), GV)
 
-static int gt_ltrdigest_pbs_visitor_feature_node(GtNodeVisitor *nv,
-                                                 GtFeatureNode *fn,
-                                                 GtError *err)
+/* Find the LTR retrotransposon in the annotation subgraph of <fn> and extract
+   its sequence. <c->ltr_retrotrans> is NULL if there is none. */
+static int gt_pbs_candidate_init(GtLTRdigestPBSVisitor *lv, GtPBSCandidate *c,
+                                 GtFeatureNode *fn, GtError *err)
 {
-  GT_UNUSED GtLTRdigestPBSVisitor *lv;
   GtFeatureNodeIterator *fni;
   GtRange leftltrrng, rightltrrng;
   bool seen_left = false;
   GtFeatureNode *curnode = NULL;
   int had_err = 0;
-  lv = gt_ltrdigest_pbs_visitor_cast(nv);
-  gt_assert(lv);
   gt_error_check(err);
 
+  memset(c, 0, sizeof *c);
   /* traverse annotation subgraph and find LTR element */
   fni = gt_feature_node_iterator_new(fn);
   while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
     if (strcmp(gt_feature_node_get_type(curnode),
                gt_ft_LTR_retrotransposon) == 0) {
-      lv->ltr_retrotrans = curnode;
+      c->ltr_retrotrans = curnode;
     }
     if (strcmp(gt_feature_node_get_type(curnode),
                gt_ft_long_terminal_repeat) == 0) {
       if (seen_left) {
         rightltrrng = gt_genome_node_get_range((GtGenomeNode*) curnode);
-        lv->rightltrlen = gt_range_length(&rightltrrng);
-        lv->rightLTR_5 = rightltrrng.start - 1;
+        c->rightltrlen = gt_range_length(&rightltrrng);
+        c->rightLTR_5 = rightltrrng.start - 1;
       } else {
         leftltrrng = gt_genome_node_get_range((GtGenomeNode*) curnode);
-        lv->leftltrlen = gt_range_length(&leftltrrng);
-        lv->leftLTR_3 = leftltrrng.end - 1;
+        c->leftltrlen = gt_range_length(&leftltrrng);
+        c->leftLTR_3 = leftltrrng.end - 1;
         seen_left = true;
       }
     }
   }
   gt_feature_node_iterator_delete(fni);
 
-  if (!had_err && lv->ltr_retrotrans != NULL) {
-    char *rev_seq;
+  if (!had_err && c->ltr_retrotrans != NULL) {
     GtRange rng;
-    GtStrand canonical_strand = gt_feature_node_get_strand(lv->ltr_retrotrans);
     GtUword seqlen;
-    GtStr *seq = gt_str_new();
-    rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
+    c->seq = gt_str_new();
+    rng = gt_genome_node_get_range((GtGenomeNode*) c->ltr_retrotrans);
     seqlen = gt_range_length(&rng);
 
-    had_err = gt_extract_feature_sequence(seq,
-                                          (GtGenomeNode*) lv->ltr_retrotrans,
+    had_err = gt_extract_feature_sequence(c->seq,
+                                          (GtGenomeNode*) c->ltr_retrotrans,
                                           gt_symbol(gt_ft_LTR_retrotransposon),
                                           false, NULL, NULL, lv->rmap, err);
 
     if (!had_err) {
-      GtPBSResults *pbs_results = NULL;
-      rev_seq = gt_malloc((size_t) (seqlen * sizeof (char)));
-      strncpy(rev_seq, gt_str_get(seq), (size_t) seqlen * sizeof (char));
-      (void) gt_reverse_complement(rev_seq, seqlen, NULL);
-
-      pbs_results = gt_pbs_find(lv, gt_str_get(seq), (const char*) rev_seq,
-                                err);
-       if (gt_pbs_results_get_number_of_hits(pbs_results) > 0)
-       {
-        pbs_attach_results_to_gff3(lv, pbs_results, lv->ltr_retrotrans,
-                                   &canonical_strand);
-       }
-       gt_pbs_results_delete(pbs_results);
-
-      gt_free(rev_seq);
+      c->rev_seq = gt_malloc((size_t) (seqlen * sizeof (char)));
+      strncpy(c->rev_seq, gt_str_get(c->seq), (size_t) seqlen * sizeof (char));
+      (void) gt_reverse_complement(c->rev_seq, seqlen, NULL);
     }
-    gt_str_delete(seq);
   }
+  return had_err;
+}
+
+static void gt_pbs_candidate_attach(GtLTRdigestPBSVisitor *lv,
+                                    GtPBSCandidate *c)
+{
+  GtStrand canonical_strand;
+  gt_assert(c->ltr_retrotrans && c->results);
+  canonical_strand = gt_feature_node_get_strand(c->ltr_retrotrans);
+  if (gt_pbs_results_get_number_of_hits(c->results) > 0)
+  {
+    pbs_attach_results_to_gff3(lv, c, c->results, c->ltr_retrotrans,
+                               &canonical_strand);
+  }
+}
 
+static void gt_pbs_candidate_wipe(GtPBSCandidate *c)
+{
+  gt_pbs_results_delete(c->results);
+  gt_free(c->rev_seq);
+  gt_str_delete(c->seq);
+}
+
+static int gt_ltrdigest_pbs_visitor_feature_node(GtNodeVisitor *nv,
+                                                 GtFeatureNode *fn,
+                                                 GtError *err)
+{
+  GtLTRdigestPBSVisitor *lv;
+  GtPBSCandidate c;
+  int had_err = 0;
+  lv = gt_ltrdigest_pbs_visitor_cast(nv);
+  gt_assert(lv);
+  gt_error_check(err);
+
+  had_err = gt_pbs_candidate_init(lv, &c, fn, err);
+  if (!had_err && c.ltr_retrotrans != NULL) {
+    c.results = gt_pbs_find(lv, &c);
+    gt_pbs_candidate_attach(lv, &c);
+  }
+  gt_pbs_candidate_wipe(&c);
+  return had_err;
+}
+
+typedef struct {
+  GtLTRdigestPBSVisitor *lv;
+  GtPBSCandidate *candidates;
+} GtPBSFindInfo;
+
+static void gt_pbs_find_range(GtUword start, GtUword end, void *data)
+{
+  GtPBSFindInfo *info = data;
+  GtUword i;
+  for (i = start; i < end; i++) {
+    if (info->candidates[i].ltr_retrotrans != NULL)
+      info->candidates[i].results = gt_pbs_find(info->lv,
+                                                info->candidates + i);
+  }
+}
+
+int gt_ltrdigest_pbs_visitor_visit_nodes(GtNodeVisitor *nv,
+                                         GtGenomeNode **nodes,
+                                         GtUword numofnodes,
+                                         GtError *err)
+{
+  GtLTRdigestPBSVisitor *lv;
+  GtPBSCandidate *candidates;
+  GtPBSFindInfo info;
+  GtUword i, numofcandidates = 0;
+  int had_err = 0;
+  lv = gt_ltrdigest_pbs_visitor_cast(nv);
+  gt_assert(lv && (nodes || numofnodes == 0));
+  gt_error_check(err);
+
+  /* the sequences are extracted and the results attached sequentially, only
+     the searches run in parallel */
+  candidates = gt_calloc((size_t) (numofnodes + 1), sizeof *candidates);
+  for (i = 0; !had_err && i < numofnodes; i++) {
+    GtFeatureNode *fn = gt_feature_node_try_cast(nodes[i]);
+    if (fn != NULL) {
+      had_err = gt_pbs_candidate_init(lv, candidates + numofcandidates, fn,
+                                      err);
+      numofcandidates++;
+    }
+  }
+  if (!had_err) {
+    info.lv = lv;
+    info.candidates = candidates;
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numofcandidates, 1UL,
+                                gt_pbs_find_range, &info);
+    for (i = 0; i < numofcandidates; i++) {
+      if (candidates[i].ltr_retrotrans != NULL)
+        gt_pbs_candidate_attach(lv, candidates + i);
+    }
+  }
+  for (i = 0; i < numofcandidates; i++)
+    gt_pbs_candidate_wipe(candidates + i);
+  gt_free(candidates);
   return had_err;
 }
 
 static void gt_ltrdigest_pbs_visitor_free(GtNodeVisitor *nv)
 {
-  GT_UNUSED GtLTRdigestPBSVisitor *lv;
+  GtLTRdigestPBSVisitor *lv;
+  GtUword j;
   if (!nv) return;
   lv = gt_ltrdigest_pbs_visitor_cast(nv);
   gt_str_delete(lv->tag);
+  gt_swprofile_delete(lv->trna_profile);
+  for (j = 0; j < lv->numoftrnas; j++)
+    gt_seq_delete(lv->trnas_from3[j]);
+  gt_free(lv->trnas_from3);
+  gt_score_function_delete(lv->sf);
+  gt_alphabet_delete(lv->alpha);
 }
 
 const GtNodeVisitorClass* gt_ltrdigest_pbs_visitor_class(void)
@@ -524,10 +684,12 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
                                             int ali_score_insertion,
                                             int ali_score_deletion,
                                             GtBioseq *trna_lib,
-                                            GT_UNUSED GtError *err)
+                                            GtError *err)
 {
   GtNodeVisitor *nv = NULL;
   GtLTRdigestPBSVisitor *lv;
+  GtUword j;
+  int had_err = 0;
   gt_assert(rmap && trna_lib);
   nv = gt_node_visitor_create(gt_ltrdigest_pbs_visitor_class());
   lv = gt_ltrdigest_pbs_visitor_cast(nv);
@@ -543,6 +705,36 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
   lv->ali_score_insertion = ali_score_insertion;
   lv->ali_score_deletion = ali_score_deletion;
   lv->trna_lib = trna_lib;
+  lv->alpha = gt_alphabet_new_dna();
+  lv->sf = gt_dna_scorefunc_new(lv->alpha, ali_score_match,
+                                ali_score_mismatch, ali_score_insertion,
+                                ali_score_deletion);
+  lv->min_score = gt_pbs_min_score(lv);
+
+  /* the reverse complements of the tRNAs are prepared once, to be shared by
+     all searches */
+  lv->numoftrnas = gt_bioseq_number_of_sequences(trna_lib);
+  lv->trnas_from3 = gt_calloc((size_t) (lv->numoftrnas + 1),
+                              sizeof (GtSeq*));
+  for (j = 0; !had_err && j < lv->numoftrnas; j++)
+  {
+    char *trna_from3_full;
+    GtUword trna_seqlen = gt_bioseq_get_sequence_length(trna_lib, j);
+
+    trna_from3_full = gt_bioseq_get_sequence(trna_lib, j);
+    had_err = gt_reverse_complement(trna_from3_full, trna_seqlen, err);
+    lv->trnas_from3[j] = gt_seq_new_own(trna_from3_full, trna_seqlen,
+                                        lv->alpha);
+    gt_seq_set_description(lv->trnas_from3[j],
+                           gt_bioseq_get_description(trna_lib, j));
+  }
+  if (!had_err)
+    lv->trna_profile = gt_swprofile_new(lv->trnas_from3, lv->numoftrnas,
+                                        lv->alpha, lv->sf);
+  if (had_err) {
+    gt_node_visitor_delete(nv);
+    return NULL;
+  }
   return nv;
 }
 
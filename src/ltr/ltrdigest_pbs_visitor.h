@@ -40,6 +40,14 @@ GtNodeVisitor* gt_ltrdigest_pbs_visitor_new(GtRegionMapping *rmap,
                                             GtBioseq *trna_lib,
                                             GtError *err);
 
+/* Annotate the primer binding sites of the LTR retrotransposons in the
+   <numofnodes> <nodes>, as if they were visited one after another by <nv>,
+   but search them in parallel. */
+int            gt_ltrdigest_pbs_visitor_visit_nodes(GtNodeVisitor *nv,
+                                                    GtGenomeNode **nodes,
+                                                    GtUword numofnodes,
+                                                    GtError *err);
+
 int            gt_ltrdigest_pbs_visitor_unit_test(GtError *err);
 
 #endif
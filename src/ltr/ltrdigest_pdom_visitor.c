@@ -15,6 +15,8 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <errno.h>
+#include <float.h>
 #include <signal.h>
 #include <string.h>
 #ifndef S_SPLINT_S
@@ -35,11 +37,13 @@
 #include "core/log.h"
 #include "core/ma.h"
 #include "core/mathsupport.h"
+#include "core/minmax.h"
 #include "core/range.h"
 #include "core/str_api.h"
 #include "core/strand_api.h"
 #include "core/symbol_api.h"
 #include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/translator_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -49,21 +53,27 @@
 #include "extended/feature_node_iterator_api.h"
 #include "extended/feature_type.h"
 #include "extended/globalchaining.h"
+#include "extended/hmmer_model.h"
 #include "extended/reverse_api.h"
 #include "ltr/ltrdigest_def.h"
 #include "ltr/ltrdigest_pdom_visitor.h"
 
 #define GT_HMMER_BUF_LEN  122
 
+/* The E-value a translated sequence must reach for its domains to be
+   reported, as in hmmscan (built-in search). */
+#define GT_PDOM_SEQ_EVALUE     10.0
+/* The number of alignment columns per line of the reported alignments. */
+#define GT_PDOM_ALI_LINEWIDTH  60UL
+
 struct GtLTRdigestPdomVisitor {
   const GtNodeVisitor parent_instance;
   GtPdomModelSet *model;
   GtRegionMapping *rmap;
-  double eval_cutoff;
-  GtFeatureNode *ltr_retrotrans;
-  GtStr *fwd[3], *rev[3];
+  double eval_cutoff,
+         *min_seqscores,
+         *min_domscores;
   unsigned int chain_max_gap_length;
-  GtUword leftLTR_5, rightLTR_3;
   GtPdomCutoff cutoff;
   GtStr *cmdline, *tag;
   bool output_all_chains;
@@ -71,37 +81,89 @@ struct GtLTRdigestPdomVisitor {
   const char *root_type;
 };
 
-typedef struct {
-  GtStrand strand;
-  unsigned int frame;
-  GtStr *cur_model;
-  GtHashmap *models;
-} GtHMMERParseStatus;
-
 typedef struct {
   GtArray *fwd_hits,
           *rev_hits;
   GtUword last_array_size_fwd,
-                last_array_size_rev;
+          last_array_size_rev;
   double best_rev,
          best_fwd;
-  char *modelname;
+  const char *modelname;
 } GtHMMERModelHit;
 
+/* The hits of the models in the hmmscan output of a candidate. */
+typedef struct {
+  GtStrand strand;
+  unsigned int frame;
+  GtStr *cur_model;
+  GtHashmap *models;
+} GtHMMERParseStatus;
+
 typedef struct {
   GtUword hmmfrom, hmmto, alifrom, alito, frame;
   double evalue, score;
   GtStrand strand;
   GtArray *chains;
-  bool reported;
   GtStr *alignment, *aastring;
 } GtHMMERSingleHit;
 
-#ifndef _WIN32
-static void gt_hmmer_model_hit_delete(GtHMMERModelHit *mh);
-#endif
+/* The LTR retrotransposon of a node and its translations, kept apart from the
+   visitor to search several candidates in parallel. The built-in search stores
+   the hits of every model of the model set in <modelhits>, in the same order,
+   hmmscan the hits of the models it reported in <pstatus>. */
+typedef struct {
+  GtFeatureNode *ltr_retrotrans;
+  GtUword leftLTR_5,
+          rightLTR_3;
+  GtStr *fwd[3],
+        *rev[3];
+  GtHMMERModelHit *modelhits;
+  GtHMMERParseStatus *pstatus;
+} GtPdomCandidate;
+
+static void gt_hmmer_single_hit_delete(GtHMMERSingleHit *h)
+{
+  if (!h) return;
+  gt_array_delete(h->chains);
+  gt_str_delete(h->alignment);
+  gt_str_delete(h->aastring);
+  gt_free(h);
+}
+
+static void gt_hmmer_model_hit_wipe(GtHMMERModelHit *mh)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(mh->fwd_hits); i++)
+    gt_hmmer_single_hit_delete(*(GtHMMERSingleHit**)
+                                                 gt_array_get(mh->fwd_hits, i));
+  gt_array_delete(mh->fwd_hits);
+  for (i = 0; i < gt_array_size(mh->rev_hits); i++)
+    gt_hmmer_single_hit_delete(*(GtHMMERSingleHit**)
+                                                 gt_array_get(mh->rev_hits, i));
+  gt_array_delete(mh->rev_hits);
+}
+
+static void gt_hmmer_model_hit_delete(GtHMMERModelHit *mh)
+{
+  if (!mh) return;
+  gt_hmmer_model_hit_wipe(mh);
+  gt_free(mh);
+}
+
+static void gt_hmmer_model_hit_add(GtHMMERModelHit *mh, GtHMMERSingleHit *hit)
+{
+  gt_assert(mh && mh->fwd_hits && mh->rev_hits);
+  if (hit->strand == GT_STRAND_FORWARD) {
+    if (gt_double_compare(mh->best_fwd, hit->evalue) > 0)
+      mh->best_fwd = hit->evalue;
+    gt_array_add(mh->fwd_hits, hit);
+  } else {
+    if (gt_double_compare(mh->best_rev, hit->evalue) > 0)
+      mh->best_rev = hit->evalue;
+    gt_array_add(mh->rev_hits, hit);
+  }
+}
 
-#ifndef _WIN32
 static GtHMMERParseStatus* gt_hmmer_parse_status_new(void)
 {
   GtHMMERParseStatus *s;
@@ -111,7 +173,163 @@ static GtHMMERParseStatus* gt_hmmer_parse_status_new(void)
                              (GtFree) gt_hmmer_model_hit_delete);
   return s;
 }
-#endif
+
+static void gt_hmmer_parse_status_delete(GtHMMERParseStatus *s)
+{
+  if (!s) return;
+  gt_str_delete(s->cur_model);
+  gt_hashmap_delete(s->models);
+  gt_free(s);
+}
+
+const GtNodeVisitorClass* gt_ltrdigest_pdom_visitor_class(void);
+
+#define gt_ltrdigest_pdom_visitor_cast(GV)\
+        gt_node_visitor_cast(gt_ltrdigest_pdom_visitor_class(), GV)
+
+#define gt_ltrdigest_pdom_visitor_isgap(c) \
+        ((c) == ' ' || (c) == '.' || (c) == '_' \
+                    || (c) == '-' || (c) == '~')
+
+static void gt_ltrdigest_pdom_visitor_add_aaseq(const char *str, GtStr *dest)
+{
+  GtUword i;
+  gt_assert(str && dest);
+  for (i = 0; str[i] != '\0'; i++) {
+    if (!gt_ltrdigest_pdom_visitor_isgap(str[i])) {
+      /* replace stop codons by 'X'es */
+      if (str[i] == '*') {
+        gt_str_append_char(dest, 'X');
+      } else {
+        gt_str_append_char(dest, toupper(str[i]));
+      }
+    }
+  }
+}
+
+/* Append a line of the alignment <ali> from column <col> to <dest>, prefixed
+   by <name> and followed by the positions of the first and last residue in
+   the line. <pos> is the position of the next residue and is updated. */
+static void gt_ltrdigest_pdom_visitor_add_aliline(GtStr *dest,
+                                                  const char *name,
+                                                  int namewidth,
+                                                  int poswidth,
+                                                  const GtStr *ali,
+                                                  GtUword col, GtUword width,
+                                                  char gapchar, GtUword *pos)
+{
+  const char *a = gt_str_get(ali) + col;
+  GtUword j, from = *pos;
+  char buf[BUFSIZ];
+  for (j = 0; j < width; j++) {
+    if (a[j] != gapchar)
+      (*pos)++;
+  }
+  (void) snprintf(buf, sizeof buf, "%*s %*"GT_WUS" ", namewidth, name,
+                  poswidth, from);
+  gt_str_append_cstr(dest, buf);
+  gt_str_append_cstr_nt(dest, a, width);
+  (void) snprintf(buf, sizeof buf, " "GT_WU"\n", *pos - 1);
+  gt_str_append_cstr(dest, buf);
+}
+
+/* Format the alignment of <domain> of <modelname> in the translated sequence
+   <seqname> like hmmscan does, in blocks of GT_PDOM_ALI_LINEWIDTH columns. */
+static GtStr* gt_ltrdigest_pdom_visitor_alignment(const char *modelname,
+                                                  const char *seqname,
+                                                  const GtHMMERDomain *domain)
+{
+  GtStr *alignment = gt_str_new();
+  GtUword col, alilen, hmmpos = domain->hmmfrom, seqpos = domain->seqfrom;
+  int namewidth, poswidth;
+  char buf[BUFSIZ];
+  namewidth = (int) MAX(strlen(modelname), strlen(seqname));
+  poswidth = snprintf(buf, sizeof buf, ""GT_WU"",
+                      MAX(domain->hmmto, domain->seqto));
+  alilen = gt_str_length(domain->model_ali);
+  gt_assert(alilen == gt_str_length(domain->seq_ali));
+  for (col = 0; col < alilen; col += GT_PDOM_ALI_LINEWIDTH) {
+    GtUword width = MIN(GT_PDOM_ALI_LINEWIDTH, alilen - col);
+    gt_ltrdigest_pdom_visitor_add_aliline(alignment, modelname, namewidth,
+                                          poswidth, domain->model_ali, col,
+                                          width, '.', &hmmpos);
+    (void) snprintf(buf, sizeof buf, "%*s ", namewidth + poswidth + 1, "");
+    gt_str_append_cstr(alignment, buf);
+    gt_str_append_cstr_nt(alignment, gt_str_get(domain->match_ali) + col,
+                          width);
+    gt_str_append_char(alignment, '\n');
+    gt_ltrdigest_pdom_visitor_add_aliline(alignment, seqname, namewidth,
+                                          poswidth, domain->seq_ali, col,
+                                          width, '-', &seqpos);
+    gt_str_append_char(alignment, '\n');
+  }
+  return alignment;
+}
+
+/* Search all translations of <c> with all models of the built-in search and
+   collect the hits. */
+static void gt_pdom_find_builtin(GtLTRdigestPdomVisitor *lv,
+                                 GtPdomCandidate *c)
+{
+  GtUword i, m, nofmodels;
+  GtArray *domains;
+  double nofmodels_d;
+  gt_assert(lv && c && !c->modelhits);
+
+  nofmodels = gt_pdom_model_set_size(lv->model);
+  nofmodels_d = (double) nofmodels;
+  c->modelhits = gt_calloc((size_t) nofmodels, sizeof *c->modelhits);
+  for (m = 0; m < nofmodels; m++) {
+    const GtHMMERModel *model = gt_pdom_model_set_get(lv->model, m);
+    c->modelhits[m].fwd_hits = gt_array_new(sizeof (GtHMMERSingleHit*));
+    c->modelhits[m].rev_hits = gt_array_new(sizeof (GtHMMERSingleHit*));
+    c->modelhits[m].best_rev = c->modelhits[m].best_fwd = DBL_MAX;
+    c->modelhits[m].modelname = gt_hmmer_model_get_name(model);
+  }
+  domains = gt_array_new(sizeof (GtHMMERDomain));
+  /* query the translations in the order hmmscan got them */
+  for (i = 0; i < 6UL; i++) {
+    GtStrand strand = (i % 2 == 0) ? GT_STRAND_FORWARD : GT_STRAND_REVERSE;
+    GtStr *seq = (strand == GT_STRAND_FORWARD) ? c->fwd[i / 2]
+                                               : c->rev[i / 2];
+    char seqname[32];
+    (void) snprintf(seqname, sizeof seqname, ""GT_WU"%c", i / 2,
+                    GT_STRAND_CHARS[strand]);
+    for (m = 0; m < nofmodels; m++) {
+      const GtHMMERModel *model = gt_pdom_model_set_get(lv->model, m);
+      GtUword j;
+      gt_array_reset(domains);
+      gt_hmmer_model_search(model, gt_str_get(seq), gt_str_length(seq),
+                            lv->min_seqscores[m], lv->min_domscores[m],
+                            domains);
+      for (j = 0; j < gt_array_size(domains); j++) {
+        GtHMMERDomain *d = gt_array_get(domains, j);
+        GtHMMERSingleHit *hit = gt_calloc((size_t) 1, sizeof (*hit));
+        hit->hmmfrom = d->hmmfrom;
+        hit->hmmto = d->hmmto;
+        hit->alifrom = d->seqfrom;
+        hit->alito = d->seqto;
+        hit->score = d->score;
+        /* like the independent E-value of hmmscan */
+        hit->evalue = d->pvalue * nofmodels_d;
+        hit->strand = strand;
+        hit->frame = i / 2;
+        hit->chains = gt_array_new(sizeof (GtUword));
+        hit->alignment = gt_ltrdigest_pdom_visitor_alignment(
+                                           c->modelhits[m].modelname, seqname,
+                                           d);
+        hit->aastring = gt_str_new();
+        gt_ltrdigest_pdom_visitor_add_aaseq(gt_str_get(d->seq_ali),
+                                            hit->aastring);
+        gt_hmmer_model_hit_add(c->modelhits + m, hit);
+        gt_str_delete(d->model_ali);
+        gt_str_delete(d->match_ali);
+        gt_str_delete(d->seq_ali);
+      }
+    }
+  }
+  gt_array_delete(domains);
+}
 
 #ifndef _WIN32
 static void gt_hmmer_parse_status_add_hit(GtHMMERParseStatus *s,
@@ -120,27 +338,17 @@ static void gt_hmmer_parse_status_add_hit(GtHMMERParseStatus *s,
   GtHMMERModelHit *mh;
   gt_assert(s);
   if (!(mh = gt_hashmap_get(s->models, gt_str_get(s->cur_model)))) {
+    char *modelname = gt_cstr_dup(gt_str_get(s->cur_model));
     mh = gt_calloc((size_t) 1, sizeof (*mh));
     mh->fwd_hits = gt_array_new(sizeof (GtHMMERSingleHit*));
     mh->rev_hits = gt_array_new(sizeof (GtHMMERSingleHit*));
     mh->best_rev = mh->best_fwd = DBL_MAX;
-    mh->modelname = gt_cstr_dup(gt_str_get(s->cur_model));
-    gt_hashmap_add(s->models, mh->modelname, mh);
-  }
-  gt_assert(mh && mh->fwd_hits &&mh->rev_hits);
-  if (hit->strand == GT_STRAND_FORWARD) {
-    if (gt_double_compare(mh->best_fwd, hit->evalue) > 0)
-      mh->best_fwd = hit->evalue;
-    gt_array_add(mh->fwd_hits, hit);
-  } else {
-    if (gt_double_compare(mh->best_rev, hit->evalue) > 0)
-      mh->best_rev = hit->evalue;
-    gt_array_add(mh->rev_hits, hit);
+    mh->modelname = modelname;
+    gt_hashmap_add(s->models, modelname, mh);
   }
+  gt_hmmer_model_hit_add(mh, hit);
 }
-#endif
 
-#ifndef _WIN32
 static void gt_hmmer_parse_status_mark_frame_finished(GtHMMERParseStatus *s)
 {
   GtHMMERModelHit *mh;
@@ -151,9 +359,7 @@ static void gt_hmmer_parse_status_mark_frame_finished(GtHMMERParseStatus *s)
     mh->last_array_size_rev = gt_array_size(mh->rev_hits);
   }
 }
-#endif
 
-#ifndef _WIN32
 static GtHMMERSingleHit* gt_hmmer_parse_status_get_hit(GtHMMERParseStatus *s,
                                                        GtUword i)
 {
@@ -172,62 +378,6 @@ static GtHMMERSingleHit* gt_hmmer_parse_status_get_hit(GtHMMERParseStatus *s,
     }
   } else return NULL;
 }
-#endif
-
-GT_UNUSED static int pdom_printvals(void *key, void *val, GT_UNUSED void *data,
-                                    GT_UNUSED GtError *err) {
-  GtHMMERModelHit *mh = (GtHMMERModelHit*) val;
-  GtUword i;
-  printf(">>  %s\n", (char*) key);
-  for (i = 0; i < gt_array_size(mh->fwd_hits); i++) {
-    GtHMMERSingleHit *h = *(GtHMMERSingleHit**) gt_array_get(mh->fwd_hits, i);
-    printf(">>f    "GT_WU"-"GT_WU" ("GT_WU"%c, eval %e)\n", h->alifrom,
-           h->alito, h->frame, GT_STRAND_CHARS[h->strand], h->evalue);
-  }
-  for (i = 0; i < gt_array_size(mh->rev_hits); i++) {
-    GtHMMERSingleHit *h = *(GtHMMERSingleHit**) gt_array_get(mh->rev_hits, i);
-    printf(">>r    "GT_WU"-"GT_WU" ("GT_WU"%c, eval %e)\n", h->alifrom,
-           h->alito, h->frame, GT_STRAND_CHARS[h->strand], h->evalue);
-  }
-  printf("bestf: %e, bestr: %e\n", mh->best_fwd, mh->best_rev);
-  return 0;
-}
-
-GT_UNUSED static void gt_hmmer_parse_status_show(GtHMMERParseStatus *s)
-{
-  gt_assert(s);
-  (void) gt_hashmap_foreach(s->models, pdom_printvals, NULL, NULL);
-}
-
-#ifndef _WIN32
-static void gt_hmmer_model_hit_delete(GtHMMERModelHit *mh)
-{
-  GtUword i;
-  if (!mh) return;
-  for (i = 0; i < gt_array_size(mh->fwd_hits); i++)
-    gt_free(*(GtHMMERSingleHit**) gt_array_get(mh->fwd_hits, i));
-  gt_array_delete(mh->fwd_hits);
-  for (i = 0; i < gt_array_size(mh->rev_hits); i++)
-    gt_free(*(GtHMMERSingleHit**) gt_array_get(mh->rev_hits, i));
-   gt_array_delete(mh->rev_hits);
-  gt_free(mh);
-}
-#endif
-
-#ifndef _WIN32
-static void gt_hmmer_parse_status_delete(GtHMMERParseStatus *s)
-{
-  if (!s) return;
-  gt_str_delete(s->cur_model);
-  gt_hashmap_delete(s->models);
-  gt_free(s);
-}
-#endif
-
-const GtNodeVisitorClass* gt_ltrdigest_pdom_visitor_class(void);
-
-#define gt_ltrdigest_pdom_visitor_cast(GV)\
-        gt_node_visitor_cast(gt_ltrdigest_pdom_visitor_class(), GV)
 
 static inline int pdom_parser_get_next_line(char *buf, FILE *instream,
                                             GtError *err) {
@@ -249,30 +399,23 @@ static inline int pdom_parser_get_next_line(char *buf, FILE *instream,
   return 0;
 }
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_statistics(GT_UNUSED
-                                                      GtLTRdigestPdomVisitor
-                                                                            *lv,
-                                                     char *buf, FILE *instream,
-                                                     GtError *err)
+static int gt_ltrdigest_pdom_visitor_parse_statistics(char *buf,
+                                                      FILE *instream,
+                                                      GtError *err)
 {
   int had_err = 0;
-  gt_assert(lv && instream);
+  gt_assert(instream);
   gt_error_check(err);
   while (!had_err && (buf[0] != '/' && buf[1] != '/'))
     had_err = pdom_parser_get_next_line(buf, instream, err);
   return had_err;
 }
-#endif
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_scores(GT_UNUSED
-                                                  GtLTRdigestPdomVisitor *lv,
-                                                  char *buf, FILE *instream,
+static int gt_ltrdigest_pdom_visitor_parse_scores(char *buf, FILE *instream,
                                                   GtError *err)
 {
   int had_err = 0;
-  gt_assert(lv && instream);
+  gt_assert(instream);
   gt_error_check(err);
   had_err = pdom_parser_get_next_line(buf, instream, err);
   gt_assert(had_err || buf != NULL);
@@ -285,43 +428,18 @@ static int gt_ltrdigest_pdom_visitor_parse_scores(GT_UNUSED
     had_err = pdom_parser_get_next_line(buf, instream, err);
   return had_err;
 }
-#endif
 
-#define gt_ltrdigest_pdom_visitor_isgap(c) \
-        ((c) == ' ' || (c) == '.' || (c) == '_' \
-                    || (c) == '-' || (c) == '~')
-
-GT_UNUSED static void gt_ltrdigest_pdom_visitor_add_aaseq(const char *str,
-                                                          GtStr *dest)
-{
-  GtUword i;
-  gt_assert(str && dest);
-  for (i = 0; str[i] != '\0'; i++) {
-    if (!gt_ltrdigest_pdom_visitor_isgap(str[i])) {
-      /* replace stop codons by 'X'es */
-      if (str[i] == '*') {
-        gt_str_append_char(dest, 'X');
-      } else {
-        gt_str_append_char(dest, toupper(str[i]));
-      }
-    }
-  }
-}
-
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_alignments(GT_UNUSED
-                                                      GtLTRdigestPdomVisitor
-                                                                            *lv,
-                                                     GtHMMERParseStatus *status,
-                                                     char *buf,
-                                                     FILE *instream,
-                                                     GtError *err)
+static int gt_ltrdigest_pdom_visitor_parse_alignments(GtHMMERParseStatus
+                                                                        *status,
+                                                      char *buf,
+                                                      FILE *instream,
+                                                      GtError *err)
 {
   int had_err = 0, cur_domain = GT_UNDEF_INT, line = GT_UNDEF_INT;
   bool first_align_line = false;
   int mod_val = 4;
   GtHMMERSingleHit *hit = NULL;
-  gt_assert(lv && instream && status);
+  gt_assert(instream && status);
   gt_error_check(err);
   had_err = pdom_parser_get_next_line(buf, instream, err);
   gt_assert(buf != NULL);
@@ -383,19 +501,16 @@ static int gt_ltrdigest_pdom_visitor_parse_alignments(GT_UNUSED
   }
   return had_err;
 }
-#endif
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
-                                                                            *lv,
-                                                     GtHMMERParseStatus *status,
-                                                     char *buf,
-                                                     FILE *instream,
-                                                     GtError *err)
+static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtHMMERParseStatus
+                                                                        *status,
+                                                      char *buf,
+                                                      FILE *instream,
+                                                      GtError *err)
 {
   int had_err = 0;
-  GtUword i, nof_targets = 0, nof_hits = 0;
-  gt_assert(lv && instream && status);
+  GtUword i, nof_hits = 0;
+  gt_assert(instream && status);
   gt_error_check(err);
 
   had_err = pdom_parser_get_next_line(buf, instream, err);
@@ -414,7 +529,6 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
         for (i = 0UL; i < 2UL && !had_err; i++)
           had_err = pdom_parser_get_next_line(buf, instream, err);
       }
-      nof_targets++;
       nof_hits = 0UL;
       gt_hmmer_parse_status_mark_frame_finished(status);
     }
@@ -431,7 +545,6 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
       shit->evalue = evalue;
       shit->strand = status->strand;
       shit->frame = (GtUword) status->frame;
-      shit->reported = (threshold_ok == '!');
       shit->chains = gt_array_new(sizeof (GtUword));
       gt_hmmer_parse_status_add_hit(status, shit);
       nof_hits++;
@@ -439,7 +552,7 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
     }
     if (!had_err) {
       if (nof_hits > 0)
-        had_err = gt_ltrdigest_pdom_visitor_parse_alignments(lv, status, buf,
+        had_err = gt_ltrdigest_pdom_visitor_parse_alignments(status, buf,
                                                              instream, err);
       else
         had_err = pdom_parser_get_next_line(buf, instream, err);
@@ -447,17 +560,14 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(GtLTRdigestPdomVisitor
   }
   return had_err;
 }
-#endif
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
-                                                 GtHMMERParseStatus *status,
+static int gt_ltrdigest_pdom_visitor_parse_query(GtHMMERParseStatus *status,
                                                  bool *end,
                                                  FILE *instream, GtError *err)
 {
   int had_err = 0;
   char buf[GT_HMMER_BUF_LEN];
-  gt_assert(lv && instream && status);
+  gt_assert(instream && status);
   gt_error_check(err);
 
   had_err = pdom_parser_get_next_line(buf, instream, err);
@@ -470,39 +580,102 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
     status->frame = (unsigned) atoi(buf+13);
   }
   if (!had_err && !(*end)) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_scores(lv, buf, instream, err);
+    had_err = gt_ltrdigest_pdom_visitor_parse_scores(buf, instream, err);
   }
   if (!had_err && !(*end)) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_domainhits(lv, status, buf,
+    had_err = gt_ltrdigest_pdom_visitor_parse_domainhits(status, buf,
                                                          instream, err);
   }
   if (!had_err && !(*end)) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_statistics(lv, buf, instream,
-                                                         err);
+    had_err = gt_ltrdigest_pdom_visitor_parse_statistics(buf, instream, err);
   }
   return had_err;
 }
-#endif
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_parse_output(GtLTRdigestPdomVisitor *lv,
-                                                  GtHMMERParseStatus *status,
+static int gt_ltrdigest_pdom_visitor_parse_output(GtHMMERParseStatus *status,
                                                   FILE *instream, GtError *err)
 {
   int had_err = 0;
   bool end = false;
-  gt_assert(lv && instream && status);
+  gt_assert(instream && status);
   gt_error_check(err);
   while (!had_err && !end) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, status, &end,
-                                                    instream, err);
+    had_err = gt_ltrdigest_pdom_visitor_parse_query(status, &end, instream,
+                                                    err);
   }
-  /* gt_hmmer_parse_status_show(status); */
   return had_err;
 }
 #endif
 
+/* Search all translations of <c> with hmmscan and parse its output. */
+static int gt_pdom_find_hmmscan(GtLTRdigestPdomVisitor *lv, GtPdomCandidate *c,
+                                GtError *err)
+{
+  int had_err = 0;
 #ifndef _WIN32
+  int pid, pc[2], cp[2];
+  GtUword i;
+  FILE *instream;
+  GT_UNUSED int rval;
+  gt_assert(lv && c && !c->pstatus);
+  gt_error_check(err);
+
+  (void) signal(SIGCHLD, SIG_IGN); /* XXX: for now, ignore child's
+                                           exit status */
+  rval = pipe(pc);
+  gt_assert(rval == 0);
+  rval = pipe(cp);
+  gt_assert(rval == 0);
+
+  switch ((pid = (int) fork())) {
+    case -1:
+      gt_error_set(err, "could not fork hmmscan: %s", strerror(errno));
+      (void) close(pc[0]); (void) close(pc[1]);
+      (void) close(cp[0]); (void) close(cp[1]);
+      had_err = -1;
+      break;
+    case 0:    /* child */
+      (void) close(1);    /* close current stdout. */
+      rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
+      (void) close(0);    /* close current stdin. */
+      rval = dup(pc[0]);  /* make stdin come from read end of pipe. */
+      (void) close(pc[1]);
+      (void) close(cp[0]);
+      (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
+      perror("couldn't execute hmmscan!");
+      exit(1);
+    default:    /* parent */
+      (void) close(pc[0]);
+      for (i = 0UL; i < 3UL; i++) {
+        char buf[5];
+        GT_UNUSED ssize_t written;
+        (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
+        written = write(pc[1], buf, 4 * sizeof (char));
+        written = write(pc[1], gt_str_get(c->fwd[i]),
+                        (size_t) gt_str_length(c->fwd[i]) * sizeof (char));
+        written = write(pc[1], "\n", 1 * sizeof (char));
+        (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
+        written = write(pc[1], buf, 4 * sizeof (char));
+        written = write(pc[1], gt_str_get(c->rev[i]),
+                        (size_t) gt_str_length(c->rev[i]) * sizeof (char));
+        written = write(pc[1], "\n", 1 * sizeof (char));
+      }
+      (void) close(pc[1]);
+      (void) close(cp[1]);
+      instream = fdopen(cp[0], "r");
+      c->pstatus = gt_hmmer_parse_status_new();
+      had_err = gt_ltrdigest_pdom_visitor_parse_output(c->pstatus, instream,
+                                                       err);
+      (void) fclose(instream);
+  }
+#else
+  /* XXX */
+  gt_error_set(err, "HMMER call not implemented on Windows\n");
+  had_err = -1;
+#endif
+  return had_err;
+}
+
 static int gt_ltrdigest_pdom_visitor_fragcmp(const void *frag1,
                                              const void *frag2)
 {
@@ -512,9 +685,7 @@ static int gt_ltrdigest_pdom_visitor_fragcmp(const void *frag1,
     return 0;
   else return (f1->startpos2 < f2->startpos2 ? -1 : 1);
 }
-#endif
 
-#ifndef _WIN32
 static void gt_ltrdigest_pdom_visitor_chainproc(GtChain *c, GtFragment *f,
                                              GT_UNUSED GtUword nof_frags,
                                              GT_UNUSED GtUword gap_length,
@@ -535,10 +706,8 @@ static void gt_ltrdigest_pdom_visitor_chainproc(GtChain *c, GtFragment *f,
   (*chainno)++;
   gt_log_log("\n");
 }
-#endif
 
-#ifndef _WIN32
-static GtRange gt_ltrdigest_pdom_visitor_coords(GtLTRdigestPdomVisitor *lv,
+static GtRange gt_ltrdigest_pdom_visitor_coords(const GtPdomCandidate *c,
                                               const GtHMMERSingleHit *singlehit)
 {
   GtRange retrng;
@@ -547,13 +716,13 @@ static GtRange gt_ltrdigest_pdom_visitor_coords(GtLTRdigestPdomVisitor *lv,
   {
     case GT_STRAND_FORWARD:
     default:
-      retrng.start = lv->leftLTR_5 + (singlehit->alifrom - 1) * GT_CODON_LENGTH
+      retrng.start = c->leftLTR_5 + (singlehit->alifrom - 1) * GT_CODON_LENGTH
                         + (GtUword) singlehit->frame;
       retrng.end   =  retrng.start + (singlehit->alito - singlehit->alifrom + 1)
                            * GT_CODON_LENGTH;
       break;
     case GT_STRAND_REVERSE:
-      retrng.start = lv->rightLTR_3 - (singlehit->alito) * GT_CODON_LENGTH
+      retrng.start = c->rightLTR_3 - (singlehit->alito) * GT_CODON_LENGTH
                         - (GtUword) singlehit->frame;
       retrng.end   =  retrng.start + (singlehit->alito - singlehit->alifrom + 1)
                            * GT_CODON_LENGTH;
@@ -562,33 +731,33 @@ static GtRange gt_ltrdigest_pdom_visitor_coords(GtLTRdigestPdomVisitor *lv,
   retrng.start++; retrng.end++;  /* GFF3 is 1-based */
   return retrng;
 }
-#endif
 
-#ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_attach_hit(GtLTRdigestPdomVisitor *lv,
+                                                GtPdomCandidate *c,
                                                 GtHMMERModelHit *modelhit,
                                                 GtHMMERSingleHit *singlehit)
 {
-  GT_UNUSED GtUword i;
   GtGenomeNode *gf;
   int had_err = 0;
   GtRange rrng;
-  gt_assert(lv && singlehit);
+  gt_assert(lv && c && singlehit);
 
-  rrng = gt_ltrdigest_pdom_visitor_coords(lv, singlehit);
+  rrng = gt_ltrdigest_pdom_visitor_coords(c, singlehit);
 
   if (gt_array_size(singlehit->chains) > 0 || lv->output_all_chains) {
     char buf[32];
     gf = gt_feature_node_new(gt_genome_node_get_seqid((GtGenomeNode*)
-                                                      lv->ltr_retrotrans),
+                                                      c->ltr_retrotrans),
                              gt_ft_protein_match,
                              rrng.start,
                              rrng.end,
                              singlehit->strand);
+    /* the feature node takes over the alignment and the sequence */
     gt_genome_node_add_user_data((GtGenomeNode*) gf, "pdom_alignment",
                                  singlehit->alignment, (GtFree) gt_str_delete);
     gt_genome_node_add_user_data((GtGenomeNode*) gf, "pdom_aaseq",
                                  singlehit->aastring, (GtFree) gt_str_delete);
+    singlehit->alignment = singlehit->aastring = NULL;
     gt_feature_node_set_source((GtFeatureNode*) gf, lv->tag);
     gt_feature_node_set_score((GtFeatureNode*) gf, (float) singlehit->evalue);
     (void) snprintf(buf, (size_t) 32, "%d", (int) singlehit->frame);
@@ -616,21 +785,15 @@ static int gt_ltrdigest_pdom_visitor_attach_hit(GtLTRdigestPdomVisitor *lv,
                                     gt_str_get(buffer));
       gt_str_delete(buffer);
     }
-    gt_array_delete(singlehit->chains);
-    gt_feature_node_add_child(lv->ltr_retrotrans, (GtFeatureNode*) gf);
+    gt_feature_node_add_child(c->ltr_retrotrans, (GtFeatureNode*) gf);
   }
   return had_err;
 }
-#endif
 
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_process_hit(GT_UNUSED void *key, void *val,
-                                                 void *data,
-                                                 GT_UNUSED GtError *err)
+static void gt_ltrdigest_pdom_visitor_process_hit(GtLTRdigestPdomVisitor *lv,
+                                                  GtPdomCandidate *c,
+                                                  GtHMMERModelHit *mh)
 {
-  GtHMMERModelHit *mh = (GtHMMERModelHit*) val;
-  GtLTRdigestPdomVisitor *lv = (GtLTRdigestPdomVisitor*) data;
-  const char *mdl = (const char*) key;
   GtArray *hits = NULL;
   GtUword nof_hits;
   GtFragment *frags;
@@ -641,10 +804,10 @@ static int gt_ltrdigest_pdom_visitor_process_hit(GT_UNUSED void *key, void *val,
     hits = mh->rev_hits;
   gt_assert(hits);
   nof_hits = gt_array_size(hits);
-  if (nof_hits == 0) return 0;
+  if (nof_hits == 0) return;
 
   if (nof_hits > 1UL) {
-    GtUword i, chainno;
+    GtUword i, chainno = 0UL;
     frags = gt_malloc((size_t) nof_hits * sizeof (GtFragment));
     for (i = 0; i < nof_hits; i++) {
       GtHMMERSingleHit *h = *(GtHMMERSingleHit**) gt_array_get(hits, i);
@@ -658,44 +821,40 @@ static int gt_ltrdigest_pdom_visitor_process_hit(GT_UNUSED void *key, void *val,
     }
     qsort(frags, (size_t) nof_hits, sizeof (GtFragment),
           gt_ltrdigest_pdom_visitor_fragcmp);
-    gt_log_log("%s: chaining "GT_WU" frags", mdl, nof_hits);
+    gt_log_log("%s: chaining "GT_WU" frags", mh->modelname, nof_hits);
     gt_globalchaining_max(frags, nof_hits,
                          (GtUword) lv->chain_max_gap_length,
                          gt_ltrdigest_pdom_visitor_chainproc, &chainno);
     gt_free(frags);
     for (i = 0; i < nof_hits; i++) {
       GtHMMERSingleHit *h = *(GtHMMERSingleHit**) gt_array_get(hits, i);
-      (void) gt_ltrdigest_pdom_visitor_attach_hit(lv, mh, h);
+      (void) gt_ltrdigest_pdom_visitor_attach_hit(lv, c, mh, h);
     }
   } else {
     GtUword chainno = 0UL;
     GtHMMERSingleHit *h = *(GtHMMERSingleHit**) gt_array_get(hits, 0);
     gt_array_add(h->chains, chainno);
-    (void) gt_ltrdigest_pdom_visitor_attach_hit(lv, mh, h);
+    (void) gt_ltrdigest_pdom_visitor_attach_hit(lv, c, mh, h);
   }
-
-  return 0;
 }
-#endif
-
-#ifndef _WIN32
-static int gt_ltrdigest_pdom_visitor_process_hits(GtLTRdigestPdomVisitor *lv,
-                                                  GtHMMERParseStatus *status,
-                                                  GtError *err)
-{
-  int had_err = 0;
-  gt_assert(lv && status && status->models);
-  gt_error_check(err);
 
-  had_err = gt_hashmap_foreach(status->models,
-                               gt_ltrdigest_pdom_visitor_process_hit,
-                               lv, err);
+typedef struct {
+  GtLTRdigestPdomVisitor *lv;
+  GtPdomCandidate *c;
+} GtPdomProcessInfo;
 
-  return had_err;
+static int gt_ltrdigest_pdom_visitor_process_model_hit(GT_UNUSED void *key,
+                                                       void *val, void *data,
+                                                       GT_UNUSED GtError *err)
+{
+  GtPdomProcessInfo *info = data;
+  gt_ltrdigest_pdom_visitor_process_hit(info->lv, info->c,
+                                        (GtHMMERModelHit*) val);
+  return 0;
 }
-#endif
 
-static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
+static int gt_ltrdigest_pdom_visitor_choose_strand(GtFeatureNode
+                                                                *ltr_retrotrans)
 {
   int had_err = 0;
   double log_eval_fwd = 0.0,
@@ -709,7 +868,7 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   GtUword i;
   GtArray *to_delete;
 
-  fni = gt_feature_node_iterator_new(lv->ltr_retrotrans);
+  fni = gt_feature_node_iterator_new(ltr_retrotrans);
   while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
     if (strcmp(gt_feature_node_get_type(curnode),
                gt_ft_protein_match) == 0) {
@@ -727,9 +886,9 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   gt_feature_node_iterator_delete(fni);
 
   if (seen_rev && !seen_fwd)
-    gt_feature_node_set_strand(lv->ltr_retrotrans, GT_STRAND_REVERSE);
+    gt_feature_node_set_strand(ltr_retrotrans, GT_STRAND_REVERSE);
   else if (!seen_rev && seen_fwd)
-    gt_feature_node_set_strand(lv->ltr_retrotrans, GT_STRAND_FORWARD);
+    gt_feature_node_set_strand(ltr_retrotrans, GT_STRAND_FORWARD);
   else if (!seen_rev && !seen_fwd)
     return had_err;
   else {
@@ -738,10 +897,10 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
       strand = GT_STRAND_FORWARD;
     else
       strand = GT_STRAND_REVERSE;
-    gt_feature_node_set_strand(lv->ltr_retrotrans, strand);
+    gt_feature_node_set_strand(ltr_retrotrans, strand);
 
     to_delete = gt_array_new(sizeof (GtFeatureNode*));
-    fni = gt_feature_node_iterator_new(lv->ltr_retrotrans);
+    fni = gt_feature_node_iterator_new(ltr_retrotrans);
     while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
       if (strcmp(gt_feature_node_get_type(curnode),
                  gt_ft_protein_match) == 0) {
@@ -753,7 +912,7 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
     gt_feature_node_iterator_delete(fni);
     gt_assert(gt_array_size(to_delete) > 0);
     for (i = 0; i < gt_array_size(to_delete); i++) {
-      gt_feature_node_remove_leaf(lv->ltr_retrotrans,
+      gt_feature_node_remove_leaf(ltr_retrotrans,
                                   *(GtFeatureNode**) gt_array_get(to_delete,
                                                                   i));
     }
@@ -762,66 +921,62 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   return had_err;
 }
 
-static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
-                                                  GtFeatureNode *fn,
-                                                  GtError *err)
+/* Find the element of the root type in the annotation subgraph of <fn>,
+   extract its sequence and translate it in all six frames.
+   <c->ltr_retrotrans> is NULL if there is none. */
+static int gt_pdom_candidate_init(GtLTRdigestPdomVisitor *lv,
+                                  GtPdomCandidate *c, GtFeatureNode *fn,
+                                  GtError *err)
 {
-  GtLTRdigestPdomVisitor *lv;
   GtFeatureNodeIterator *fni;
   GtFeatureNode *curnode = NULL;
   int had_err = 0;
-  GtRange rng;
   GtUword i;
-  lv = gt_ltrdigest_pdom_visitor_cast(nv);
-  gt_assert(lv);
   gt_error_check(err);
 
+  memset(c, 0, sizeof *c);
   /* traverse annotation subgraph and find LTR element */
   fni = gt_feature_node_iterator_new(fn);
   while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
     if (strcmp(gt_feature_node_get_type(curnode), lv->root_type) == 0) {
-      lv->ltr_retrotrans = curnode;
+      c->ltr_retrotrans = curnode;
     }
   }
   gt_feature_node_iterator_delete(fni);
 
-  if (!had_err && lv->ltr_retrotrans != NULL) {
+  if (!had_err && c->ltr_retrotrans != NULL) {
     GtCodonIterator *ci;
     GtTranslator *tr;
     GtTranslatorStatus status;
     GtUword seqlen;
+    GtRange rng;
     char translated, *rev_seq;
-#ifndef _WIN32
-    FILE *instream;
-    GtHMMERParseStatus *pstatus;
-#endif
     unsigned int frame;
     GtStr *seq;
 
+    for (i = 0UL; i < 3UL; i++) {
+      c->fwd[i] = gt_str_new();
+      c->rev[i] = gt_str_new();
+    }
     seq = gt_str_new();
-    rng = gt_genome_node_get_range((GtGenomeNode*) lv->ltr_retrotrans);
-    lv->leftLTR_5 = rng.start - 1;
-    lv->rightLTR_3 = rng.end - 1;
+    rng = gt_genome_node_get_range((GtGenomeNode*) c->ltr_retrotrans);
+    c->leftLTR_5 = rng.start - 1;
+    c->rightLTR_3 = rng.end - 1;
     seqlen = gt_range_length(&rng);
 
     had_err = gt_extract_feature_sequence(seq,
-                                          (GtGenomeNode*) lv->ltr_retrotrans,
+                                          (GtGenomeNode*) c->ltr_retrotrans,
                                           lv->root_type,
                                           false, NULL, NULL, lv->rmap, err);
 
     if (!had_err) {
-      for (i = 0UL; i < 3UL; i++) {
-        gt_str_reset(lv->fwd[i]);
-        gt_str_reset(lv->rev[i]);
-      }
-
       /* create translations */
       ci = gt_codon_iterator_simple_new(gt_str_get(seq), seqlen, NULL);
       gt_assert(ci);
       tr = gt_translator_new(ci);
       status = gt_translator_next(tr, &translated, &frame, err);
       while (status == GT_TRANSLATOR_OK && translated) {
-        gt_str_append_char(lv->fwd[frame], translated);
+        gt_str_append_char(c->fwd[frame], translated);
         status = gt_translator_next(tr, &translated, &frame, NULL);
       }
       if (status == GT_TRANSLATOR_ERROR) had_err = -1;
@@ -834,7 +989,7 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
         gt_translator_set_codon_iterator(tr, ci);
         status = gt_translator_next(tr, &translated, &frame, err);
         while (status == GT_TRANSLATOR_OK && translated) {
-          gt_str_append_char(lv->rev[frame], translated);
+          gt_str_append_char(c->rev[frame], translated);
           status = gt_translator_next(tr, &translated, &frame, NULL);
         }
         if (status == GT_TRANSLATOR_ERROR) had_err = -1;
@@ -843,83 +998,147 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
       gt_codon_iterator_delete(ci);
       gt_translator_delete(tr);
     }
-
-    /* run HMMER and handle results */
-    if (!had_err) {
-#ifndef _WIN32
-      int pid, pc[2], cp[2];
-      GT_UNUSED int rval;
-
-      (void) signal(SIGCHLD, SIG_IGN); /* XXX: for now, ignore child's
-                                               exit status */
-      rval = pipe(pc);
-      gt_assert(rval == 0);
-      rval = pipe(cp);
-      gt_assert(rval == 0);
-
-      switch ((pid = (int) fork())) {
-        case -1:
-          perror("Can't fork");
-          exit(1);   /* XXX: error handling */
-        case 0:    /* child */
-          (void) close(1);    /* close current stdout. */
-          rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
-          (void) close(0);    /* close current stdin. */
-          rval = dup(pc[0]);  /* make stdin come from read end of pipe. */
-          (void) close(pc[1]);
-          (void) close(cp[0]);
-          (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
-          perror("couldn't execute hmmscan!");
-          exit(1);
-        default:    /* parent */
-          for (i = 0UL; i < 3UL; i++) {
-            char buf[5];
-            GT_UNUSED ssize_t written;
-            (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
-            written = write(pc[1], buf, 4 * sizeof (char));
-            written = write(pc[1], gt_str_get(lv->fwd[i]),
-                            (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
-            written = write(pc[1], "\n", 1 * sizeof (char));
-            (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
-            written = write(pc[1], buf, 4 * sizeof (char));
-            written = write(pc[1], gt_str_get(lv->rev[i]),
-                            (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
-            written = write(pc[1], "\n", 1 * sizeof (char));
-          }
-          (void) close(pc[1]);
-          (void) close(cp[1]);
-          instream = fdopen(cp[0], "r");
-          pstatus = gt_hmmer_parse_status_new();
-          had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
-                                                           instream, err);
-          (void) fclose(instream);
-          if (!had_err)
-            had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus, err);
-          gt_hmmer_parse_status_delete(pstatus);
-      }
-#else
-      /* XXX */
-      gt_error_set(err, "HMMER call not implemented on Windows\n");
-      had_err = -1;
-#endif
-    }
     gt_str_delete(seq);
   }
+  return had_err;
+}
+
+static int gt_pdom_candidate_attach(GtLTRdigestPdomVisitor *lv,
+                                    GtPdomCandidate *c, GtError *err)
+{
+  int had_err = 0;
+  gt_assert(c->ltr_retrotrans && (c->modelhits || c->pstatus));
+  gt_error_check(err);
+  if (c->pstatus != NULL) {
+    GtPdomProcessInfo info;
+    info.lv = lv;
+    info.c = c;
+    had_err = gt_hashmap_foreach(c->pstatus->models,
+                                 gt_ltrdigest_pdom_visitor_process_model_hit,
+                                 &info, err);
+  } else {
+    GtUword m;
+    for (m = 0; m < gt_pdom_model_set_size(lv->model); m++)
+      gt_ltrdigest_pdom_visitor_process_hit(lv, c, c->modelhits + m);
+  }
   if (!had_err)
-    had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
+    had_err = gt_ltrdigest_pdom_visitor_choose_strand(c->ltr_retrotrans);
   return had_err;
 }
 
-void gt_ltrdigest_pdom_visitor_free(GtNodeVisitor *nv)
+static void gt_pdom_candidate_wipe(GtLTRdigestPdomVisitor *lv,
+                                   GtPdomCandidate *c)
+{
+  GtUword i;
+  if (c->modelhits != NULL) {
+    for (i = 0; i < gt_pdom_model_set_size(lv->model); i++)
+      gt_hmmer_model_hit_wipe(c->modelhits + i);
+    gt_free(c->modelhits);
+  }
+  gt_hmmer_parse_status_delete(c->pstatus);
+  for (i = 0UL; i < 3UL; i++) {
+    gt_str_delete(c->fwd[i]);
+    gt_str_delete(c->rev[i]);
+  }
+}
+
+static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
+                                                  GtFeatureNode *fn,
+                                                  GtError *err)
 {
   GtLTRdigestPdomVisitor *lv;
+  GtPdomCandidate c;
+  int had_err = 0;
+  lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  gt_assert(lv);
+  gt_error_check(err);
+
+  had_err = gt_pdom_candidate_init(lv, &c, fn, err);
+  if (!had_err && c.ltr_retrotrans != NULL) {
+    if (gt_pdom_model_set_get_search(lv->model) == GT_PDOM_SEARCH_BUILTIN)
+      gt_pdom_find_builtin(lv, &c);
+    else
+      had_err = gt_pdom_find_hmmscan(lv, &c, err);
+    if (!had_err)
+      had_err = gt_pdom_candidate_attach(lv, &c, err);
+  }
+  gt_pdom_candidate_wipe(lv, &c);
+  return had_err;
+}
+
+typedef struct {
+  GtLTRdigestPdomVisitor *lv;
+  GtPdomCandidate *candidates;
+} GtPdomFindInfo;
+
+static void gt_pdom_find_range(GtUword start, GtUword end, void *data)
+{
+  GtPdomFindInfo *info = data;
   GtUword i;
-  if (!nv) return;
+  for (i = start; i < end; i++) {
+    if (info->candidates[i].ltr_retrotrans != NULL)
+      gt_pdom_find_builtin(info->lv, info->candidates + i);
+  }
+}
+
+int gt_ltrdigest_pdom_visitor_visit_nodes(GtNodeVisitor *nv,
+                                          GtGenomeNode **nodes,
+                                          GtUword numofnodes,
+                                          GtError *err)
+{
+  GtLTRdigestPdomVisitor *lv;
+  GtPdomCandidate *candidates;
+  GtPdomFindInfo info;
+  GtUword i, numofcandidates = 0;
+  int had_err = 0;
   lv = gt_ltrdigest_pdom_visitor_cast(nv);
-  for (i = 0UL; i < 3UL; i++) {
-    gt_str_delete(lv->fwd[i]);
-    gt_str_delete(lv->rev[i]);
+  gt_assert(lv && (nodes || numofnodes == 0));
+  gt_error_check(err);
+
+  if (gt_pdom_model_set_get_search(lv->model) == GT_PDOM_SEARCH_HMMSCAN) {
+    /* hmmscan is forked for each candidate and uses all threads itself */
+    for (i = 0; !had_err && i < numofnodes; i++) {
+      GtFeatureNode *fn = gt_feature_node_try_cast(nodes[i]);
+      if (fn != NULL)
+        had_err = gt_ltrdigest_pdom_visitor_feature_node(nv, fn, err);
+    }
+    return had_err;
   }
+
+  /* the sequences are translated and the hits attached sequentially, only
+     the searches run in parallel */
+  candidates = gt_calloc((size_t) (numofnodes + 1), sizeof *candidates);
+  for (i = 0; !had_err && i < numofnodes; i++) {
+    GtFeatureNode *fn = gt_feature_node_try_cast(nodes[i]);
+    if (fn != NULL) {
+      had_err = gt_pdom_candidate_init(lv, candidates + numofcandidates, fn,
+                                       err);
+      numofcandidates++;
+    }
+  }
+  if (!had_err) {
+    info.lv = lv;
+    info.candidates = candidates;
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numofcandidates, 1UL,
+                                gt_pdom_find_range, &info);
+    for (i = 0; !had_err && i < numofcandidates; i++) {
+      if (candidates[i].ltr_retrotrans != NULL)
+        had_err = gt_pdom_candidate_attach(lv, candidates + i, err);
+    }
+  }
+  for (i = 0; i < numofcandidates; i++)
+    gt_pdom_candidate_wipe(lv, candidates + i);
+  gt_free(candidates);
+  return had_err;
+}
+
+void gt_ltrdigest_pdom_visitor_free(GtNodeVisitor *nv)
+{
+  GtLTRdigestPdomVisitor *lv;
+  if (!nv) return;
+  lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  gt_free(lv->min_seqscores);
+  gt_free(lv->min_domscores);
   gt_str_delete(lv->cmdline);
   gt_str_delete(lv->tag);
   gt_cstr_array_delete(lv->args);
@@ -961,6 +1180,83 @@ void gt_ltrdigest_pdom_visitor_set_source_tag(GtLTRdigestPdomVisitor *lv,
   gt_str_append_cstr(lv->tag, tag);
 }
 
+/* Build the hmmscan command line for the pressed models of <lv>. */
+static void gt_ltrdigest_pdom_visitor_hmmscan_cmdline(GtLTRdigestPdomVisitor
+                                                                            *lv)
+{
+  GtStr *cmd;
+  cmd = gt_str_new_cstr("hmmscan --cpu ");
+  gt_str_append_uint(cmd, gt_jobs);
+  gt_str_append_cstr(cmd, " ");
+  switch (lv->cutoff) {
+    case GT_PHMM_CUTOFF_GA:
+      gt_str_append_cstr(cmd, "--cut_ga");
+      break;
+    case GT_PHMM_CUTOFF_TC:
+      gt_str_append_cstr(cmd, "--cut_tc");
+      break;
+    case GT_PHMM_CUTOFF_NONE:
+      gt_str_append_cstr(cmd, "--domE ");
+      gt_str_append_double(cmd, lv->eval_cutoff, 50);
+      break;
+  }
+  gt_str_append_cstr(cmd, " ");
+  gt_str_append_cstr(cmd, gt_pdom_model_set_get_filename(lv->model));
+  gt_str_append_cstr(cmd, " -");
+  lv->cmdline = cmd;
+  lv->args = gt_cstr_split(gt_str_get(lv->cmdline), ' ');
+  gt_log_log("HMMER cmdline: %s", gt_str_get(cmd));
+}
+
+/* Compute the score thresholds of each model of <lv> for the built-in search,
+   E-values are computed with respect to the number of models like in
+   hmmscan. */
+static int gt_ltrdigest_pdom_visitor_thresholds(GtLTRdigestPdomVisitor *lv,
+                                                GtError *err)
+{
+  GtUword i, nofmodels;
+  int had_err = 0;
+  gt_error_check(err);
+  nofmodels = gt_pdom_model_set_size(lv->model);
+  lv->min_seqscores = gt_malloc(sizeof (double) * (nofmodels + 1));
+  lv->min_domscores = gt_malloc(sizeof (double) * (nofmodels + 1));
+  for (i = 0; !had_err && i < nofmodels; i++) {
+    const GtHMMERModel *hmm = gt_pdom_model_set_get(lv->model, i);
+    double thresholds[2] = {0.0, 0.0};
+    switch (lv->cutoff) {
+      case GT_PHMM_CUTOFF_GA:
+        if (!gt_hmmer_model_get_ga(hmm, thresholds)) {
+          gt_error_set(err, "model %s has no gathering cutoffs (GA)",
+                       gt_hmmer_model_get_name(hmm));
+          had_err = -1;
+        }
+        break;
+      case GT_PHMM_CUTOFF_TC:
+        if (!gt_hmmer_model_get_tc(hmm, thresholds)) {
+          gt_error_set(err, "model %s has no trusted cutoffs (TC)",
+                       gt_hmmer_model_get_name(hmm));
+          had_err = -1;
+        }
+        break;
+      case GT_PHMM_CUTOFF_NONE:
+        thresholds[0] = gt_hmmer_model_score_for_pvalue(hmm,
+                                                        GT_PDOM_SEQ_EVALUE
+                                                          / (double) nofmodels);
+        thresholds[1] = gt_hmmer_model_score_for_pvalue(hmm,
+                                                        lv->eval_cutoff
+                                                          / (double) nofmodels);
+        break;
+    }
+    if (!had_err) {
+      lv->min_seqscores[i] = thresholds[0];
+      lv->min_domscores[i] = thresholds[1];
+      gt_log_log("%s: minimal sequence score %.2f, domain score %.2f bits",
+                 gt_hmmer_model_get_name(hmm), thresholds[0], thresholds[1]);
+    }
+  }
+  return had_err;
+}
+
 GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
                                              double eval_cutoff,
                                              unsigned int chain_max_gap_length,
@@ -970,28 +1266,31 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
 {
   GtNodeVisitor *nv;
   GtLTRdigestPdomVisitor *lv;
-  GtStr *cmd;
-  int had_err = 0, i, rval;
+  int had_err = 0;
   gt_assert(model && rmap);
+  gt_error_check(err);
 
-  rval = system("hmmscan -h > /dev/null");
-  if (rval == -1) {
-    gt_error_set(err, "error executing system(hmmscan)");
-    return NULL;
-  }
+  if (gt_pdom_model_set_get_search(model) == GT_PDOM_SEARCH_HMMSCAN) {
+    int rval = system("hmmscan -h > /dev/null");
+    if (rval == -1) {
+      gt_error_set(err, "error executing system(hmmscan)");
+      return NULL;
+    }
 #ifndef _WIN32
-  if (WEXITSTATUS(rval) != 0) {
-    gt_error_set(err, "cannot find the hmmscan executable in PATH");
-    return NULL;
-  }
+    if (WEXITSTATUS(rval) != 0) {
+      gt_error_set(err, "cannot find the hmmscan executable in PATH");
+      return NULL;
+    }
 #else
-  /* XXX */
-  gt_error_set(err, "hmmscan for Windows not implemented");
-  return NULL;
+    /* XXX */
+    gt_error_set(err, "hmmscan for Windows not implemented");
+    return NULL;
 #endif
+  }
 
   nv = gt_node_visitor_create(gt_ltrdigest_pdom_visitor_class());
   lv = gt_ltrdigest_pdom_visitor_cast(nv);
+  lv->model = model;
   lv->eval_cutoff = eval_cutoff;
   lv->cutoff = cutoff;
   lv->chain_max_gap_length = chain_max_gap_length;
@@ -1000,33 +1299,13 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   lv->tag = gt_str_new_cstr("GenomeTools");
   lv->root_type = gt_symbol(gt_ft_LTR_retrotransposon);
 
-  for (i = 0; i < 3; i++) {
-    lv->fwd[i] = gt_str_new();
-    lv->rev[i] = gt_str_new();
-  }
-
-  if (!had_err) {
-    cmd = gt_str_new_cstr("hmmscan --cpu ");
-    gt_str_append_uint(cmd, gt_jobs);
-    gt_str_append_cstr(cmd, " ");
-    switch (cutoff) {
-      case GT_PHMM_CUTOFF_GA:
-        gt_str_append_cstr(cmd, "--cut_ga");
-        break;
-      case GT_PHMM_CUTOFF_TC:
-        gt_str_append_cstr(cmd, "--cut_tc");
-        break;
-      case GT_PHMM_CUTOFF_NONE:
-        gt_str_append_cstr(cmd, "--domE ");
-        gt_str_append_double(cmd, eval_cutoff, 50);
-        break;
-    }
-    gt_str_append_cstr(cmd, " ");
-    gt_str_append_cstr(cmd, gt_pdom_model_set_get_filename(model));
-    gt_str_append_cstr(cmd, " -");
-    lv->cmdline = cmd;
-    lv->args = gt_cstr_split(gt_str_get(lv->cmdline), ' ');
-    gt_log_log("HMMER cmdline: %s", gt_str_get(cmd));
+  if (gt_pdom_model_set_get_search(model) == GT_PDOM_SEARCH_HMMSCAN)
+    gt_ltrdigest_pdom_visitor_hmmscan_cmdline(lv);
+  else
+    had_err = gt_ltrdigest_pdom_visitor_thresholds(lv, err);
+  if (had_err) {
+    gt_node_visitor_delete(nv);
+    return NULL;
   }
   return nv;
 }
@@ -38,6 +38,14 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
                                              GtRegionMapping *rmap,
                                              GtError *err);
 
+/* Annotate the protein domains of the elements in the <numofnodes> <nodes>, as
+   if they were visited one after another by <nv>. With the built-in search
+   (see <GtPdomSearch>), the elements are searched in parallel. */
+int            gt_ltrdigest_pdom_visitor_visit_nodes(GtNodeVisitor *nv,
+                                                     GtGenomeNode **nodes,
+                                                     GtUword numofnodes,
+                                                     GtError *err);
+
 void           gt_ltrdigest_pdom_visitor_output_all_chains(
                                                     GtLTRdigestPdomVisitor *lv);
 void           gt_ltrdigest_pdom_visitor_set_root_type(
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "core/array_api.h"
 #include "core/arraydef.h"
 #include "core/assert_api.h"
@@ -29,9 +30,9 @@
 #include "core/mathsupport.h"
 #include "core/md5_seqid.h"
 #include "core/minmax.h"
-#include "core/multithread_api.h"
 #include "core/str_api.h"
 #include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
 #include "extended/feature_type.h"
@@ -135,6 +136,7 @@ struct GtLTRharvestStream
   const GtEncseq *encseq;
   Sequentialsuffixarrayreader *ssar;
   bool verbosemode,
+       scan,
        nooverlaps,
        bestoverlaps,
        output_md5,
@@ -228,6 +230,34 @@ static int gt_simpleexactselfmatchstore(void *info, const GtEncseq *encseq,
   return 0;
 }
 
+/* The seeds of one part of the suffix array enumerated in parallel, with the
+   constraints of the RepeatInfo <data>. */
+static void *gt_repeatinfo_range_new(void *data)
+{
+  RepeatInfo *rangeinfo = gt_malloc(sizeof *rangeinfo);
+
+  *rangeinfo = *(const RepeatInfo *) data;
+  GT_INITARRAY(&rangeinfo->repeats, Repeat);
+  return rangeinfo;
+}
+
+static void gt_repeatinfo_range_done(void *data, void *rangeinfo)
+{
+  RepeatInfo *repeatinfo = data,
+             *rangerepeatinfo = rangeinfo;
+  const GtUword numofnew = rangerepeatinfo->repeats.nextfreeRepeat;
+
+  if (numofnew > 0)
+  {
+    GT_CHECKARRAYSPACEMULTI(&repeatinfo->repeats, Repeat, numofnew);
+    memcpy(repeatinfo->repeats.spaceRepeat + repeatinfo->repeats.nextfreeRepeat,
+           rangerepeatinfo->repeats.spaceRepeat, sizeof (Repeat) * numofnew);
+    repeatinfo->repeats.nextfreeRepeat += numofnew;
+  }
+  GT_FREEARRAY(&rangerepeatinfo->repeats, Repeat);
+  gt_free(rangerepeatinfo);
+}
+
 static int gt_subsimpleexactselfmatchstore(void *info,
                                             GT_UNUSED const GtEncseq *encseq,
                                             const GtQuerymatch *querymatch,
@@ -898,17 +928,28 @@ static void adjustboundariesfromXdropextension(GtXdropbest xdropbest_left,
   boundaries->rightLTR_3 = seed2_endpos + xdropbest_right.jvalue;
 }
 
+/* The resources for the seed extension, one set for each thread. */
+typedef struct
+{
+  GtXdropresources *xdropresources;
+  GtSeqabstract *sa_useq,
+                *sa_vseq;
+  GtFrontResource *frontresource;
+  GtError *err;
+} GtLTRharvestSeedResources;
+
 /* The following function applies the filter algorithms one after another
-   to all candidate pairs */
-static int gt_searchforLTRs(GtLTRharvestStream *lo,
+   to the candidate pairs from <firstseed> to <endseed> - 1 and appends the
+   predictions to <arrayLTRboundaries> */
+static int gt_searchforLTRs(const GtLTRharvestStream *lo,
+                            GtLTRharvestSeedResources *resources,
+                            GtUword firstseed,
+                            GtUword endseed,
                             GtArrayLTRboundaries *arrayLTRboundaries,
-                            GT_UNUSED GtMutex *rmutex,
-                            GT_UNUSED GtMutex *wmutex,
-                            GtUword *cur_seed,
                             GtError *err)
 {
   GtUword my_seed;
-  GtXdropresources *xdropresources;
+  GtXdropresources *xdropresources = resources->xdropresources;
   GtXdropbest xdropbest_left, xdropbest_right;
 #undef GT_GREEDY_BUFFER
 #ifdef GT_GREEDY_BUFFER
@@ -916,32 +957,22 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
   GtUchar *useq = NULL,
           *vseq = NULL;
 #endif
-  GtSeqabstract *sa_useq = gt_seqabstract_new_empty(),
-                *sa_vseq = gt_seqabstract_new_empty();
+  GtSeqabstract *sa_useq = resources->sa_useq,
+                *sa_vseq = resources->sa_vseq;
   GtUword edist,
                 alilen = 0;
   Repeat *repeatptr;
   LTRboundaries boundaries, *boundaries_ptr;
-  GtFrontResource *frontresource = gt_frontresource_new(100UL);
+  GtFrontResource *frontresource = resources->frontresource;
   bool haserr = false;
 
   gt_error_check(err);
-  xdropresources = gt_xdrop_resources_new(&lo->arbitscores);
 
-  /* XXX: do thread-synchronized error checking */
-  while (true) {
+  for (my_seed = firstseed; my_seed < endseed; my_seed++) {
     GtUword ulen,
                   vlen,
                   seqend,
                   seqstart;
-    gt_mutex_lock(rmutex);
-    if (*cur_seed < lo->repeatinfo.repeats.nextfreeRepeat)
-      my_seed = (*cur_seed)++;
-    else {
-      gt_mutex_unlock(rmutex);
-      break;
-    }
-    gt_mutex_unlock(rmutex);
 
     repeatptr = &(lo->repeatinfo.repeats.spaceRepeat[my_seed]);
     seqstart = gt_encseq_seqstartpos(lo->encseq, repeatptr->contignumber);
@@ -1108,40 +1139,132 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     if (!gt_double_smaller_double(boundaries.similarity,
                                   lo->similaritythreshold))
     {
-      gt_mutex_lock(wmutex);
       GT_GETNEXTFREEINARRAY(boundaries_ptr,arrayLTRboundaries,LTRboundaries,5);
       *boundaries_ptr = boundaries;
-      gt_mutex_unlock(wmutex);
     }
   }
 #ifdef GT_GREEDY_BUFFER
   FREESPACE(useq);
   FREESPACE(vseq);
 #endif
-  gt_xdrop_resources_delete(xdropresources);
-  gt_seqabstract_delete(sa_useq);
-  gt_seqabstract_delete(sa_vseq);
-  gt_frontresource_delete(frontresource);
   return haserr ? -1 : 0;
 }
 
-typedef struct {
-  GtLTRharvestStream *lo;
-  GtArrayLTRboundaries *arrayLTRboundaries;
-  const GtEncseq *encseq;
+/* The number of seeds extended in one piece of work. */
+#define GT_LTRHARVEST_SEEDSPERCHUNK  64UL
+
+/* The predictions of one chunk of seeds, in the order of the seeds. */
+typedef struct
+{
+  GtArrayLTRboundaries arrayLTRboundaries;
+  bool haserr;
   GtError *err;
-  GtMutex *rmutex, *wmutex;
-  GtUword cur_seed;
-} GtLTRharvestThreadInfo;
-
-static void* gt_searchforLTRs_threadfunc(void *data) {
-  GtLTRharvestThreadInfo *info = (GtLTRharvestThreadInfo*) data;
-  GT_UNUSED int rval;
-  gt_assert(info);
-  rval = gt_searchforLTRs(info->lo, info->arrayLTRboundaries, info->rmutex,
-                          info->wmutex, &info->cur_seed, info->err);
-  gt_assert(rval == 0);
-  return NULL;
+} GtLTRharvestSeedChunk;
+
+typedef struct
+{
+  const GtLTRharvestStream *lo;
+  GtThreadPool *pool;
+  GtLTRharvestSeedResources *resources;
+  GtLTRharvestSeedChunk *chunks;
+} GtLTRharvestSeedInfo;
+
+static void gt_searchforLTRs_range(GtUword start, GtUword end, void *data)
+{
+  GtLTRharvestSeedInfo *info = data;
+  GtLTRharvestSeedResources *resources
+    = info->resources + gt_thread_pool_thread_num(info->pool);
+  const GtUword numofseeds = info->lo->repeatinfo.repeats.nextfreeRepeat;
+  GtUword c;
+
+  for (c = start; c < end; c++)
+  {
+    GtLTRharvestSeedChunk *chunk = info->chunks + c;
+    const GtUword firstseed = c * GT_LTRHARVEST_SEEDSPERCHUNK;
+
+    if (gt_searchforLTRs(info->lo, resources, firstseed,
+                         MIN(firstseed + GT_LTRHARVEST_SEEDSPERCHUNK,
+                             numofseeds),
+                         &chunk->arrayLTRboundaries, resources->err) != 0)
+    {
+      chunk->haserr = true;
+      chunk->err = resources->err;
+      return;
+    }
+  }
+}
+
+/* Extend all seeds in parallel. The seeds are distributed in chunks by the
+   work stealing thread pool, the predictions of each chunk are kept apart and
+   appended to <lo->arrayLTRboundaries> in the order of the seeds afterwards,
+   such that the result does not depend on the number of threads. */
+static int gt_searchforLTRs_parallel(GtLTRharvestStream *lo, GtError *err)
+{
+  GtThreadPool *pool = gt_thread_pool_get();
+  const unsigned int numofthreads = gt_thread_pool_size(pool);
+  const GtUword numofseeds = lo->repeatinfo.repeats.nextfreeRepeat,
+                numofchunks = (numofseeds + GT_LTRHARVEST_SEEDSPERCHUNK - 1)
+                              / GT_LTRHARVEST_SEEDSPERCHUNK;
+  GtLTRharvestSeedInfo info;
+  GtUword c;
+  unsigned int t;
+  bool haserr = false;
+
+  gt_error_check(err);
+  info.lo = lo;
+  info.pool = pool;
+  info.resources = gt_malloc(sizeof (*info.resources) * numofthreads);
+  for (t = 0; t < numofthreads; t++)
+  {
+    info.resources[t].xdropresources
+      = gt_xdrop_resources_new(&lo->arbitscores);
+    info.resources[t].sa_useq = gt_seqabstract_new_empty();
+    info.resources[t].sa_vseq = gt_seqabstract_new_empty();
+    info.resources[t].frontresource = gt_frontresource_new(100UL);
+    info.resources[t].err = gt_error_new();
+  }
+  info.chunks = gt_malloc(sizeof (*info.chunks) * (numofchunks + 1));
+  for (c = 0; c < numofchunks; c++)
+  {
+    GT_INITARRAY(&info.chunks[c].arrayLTRboundaries, LTRboundaries);
+    info.chunks[c].haserr = false;
+    info.chunks[c].err = NULL;
+  }
+
+  gt_thread_pool_parallel_for(pool, 0, numofchunks, 1UL,
+                              gt_searchforLTRs_range, &info);
+
+  for (c = 0; c < numofchunks; c++)
+  {
+    GtLTRharvestSeedChunk *chunk = info.chunks + c;
+    if (!haserr && chunk->haserr)
+    {
+      gt_error_set(err, "%s", gt_error_get(chunk->err));
+      haserr = true;
+    }
+    if (!haserr && chunk->arrayLTRboundaries.nextfreeLTRboundaries > 0)
+    {
+      GtArrayLTRboundaries *dest = &lo->arrayLTRboundaries;
+      const GtUword numofnew = chunk->arrayLTRboundaries.nextfreeLTRboundaries;
+      GT_CHECKARRAYSPACEMULTI(dest, LTRboundaries, numofnew);
+      memcpy(dest->spaceLTRboundaries + dest->nextfreeLTRboundaries,
+             chunk->arrayLTRboundaries.spaceLTRboundaries,
+             sizeof (LTRboundaries) * numofnew);
+      dest->nextfreeLTRboundaries += numofnew;
+    }
+    GT_FREEARRAY(&chunk->arrayLTRboundaries, LTRboundaries);
+  }
+  gt_free(info.chunks);
+  for (t = 0; t < numofthreads; t++)
+  {
+    gt_xdrop_resources_delete(info.resources[t].xdropresources);
+    gt_seqabstract_delete(info.resources[t].sa_useq);
+    gt_seqabstract_delete(info.resources[t].sa_vseq);
+    gt_frontresource_delete(info.resources[t].frontresource);
+    gt_error_delete(info.resources[t].err);
+  }
+  gt_free(info.resources);
+  return haserr ? -1 : 0;
 }
 
 /* The following function removes exact duplicates from the (sorted!)
@@ -1228,7 +1351,6 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
                                      GtError *err)
 {
   GtLTRharvestStream *ltrh_stream;
-  GtLTRharvestThreadInfo threadinfo;
   int had_err = 0;
   gt_error_check(err);
 
@@ -1236,40 +1358,49 @@ static int gt_ltrharvest_stream_next(GtNodeStream *ns,
   if (ltrh_stream->state == GT_LTRHARVEST_STREAM_STATE_START) {
     GT_INITARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
     ltrh_stream->prevseqnum = GT_UNDEF_UWORD;
-    if (!had_err && gt_enumeratemaxpairs(ltrh_stream->ssar,
+    if (gt_jobs > 1U && !ltrh_stream->scan)
+    {
+      /* the seeds of the parts of the suffix array are collected separately
+         and appended in the order of the sequential enumeration */
+      if (!had_err && gt_enumeratemaxpairs_ranges(ltrh_stream->ssar,
                       ltrh_stream->encseq,
                       gt_readmodeSequentialsuffixarrayreader(ltrh_stream->ssar),
                       (unsigned int) ltrh_stream->minseedlength,
                       gt_simpleexactselfmatchstore,
+                      gt_repeatinfo_range_new,
+                      gt_repeatinfo_range_done,
                       &ltrh_stream->repeatinfo,
                       err) != 0)
+      {
+        had_err = -1;
+      }
+    } else
     {
-      had_err = -1;
+      if (!had_err && gt_enumeratemaxpairs(ltrh_stream->ssar,
+                      ltrh_stream->encseq,
+                      gt_readmodeSequentialsuffixarrayreader(ltrh_stream->ssar),
+                      (unsigned int) ltrh_stream->minseedlength,
+                      gt_simpleexactselfmatchstore,
+                      &ltrh_stream->repeatinfo,
+                      err) != 0)
+      {
+        had_err = -1;
+      }
     }
 
-    threadinfo.lo = ltrh_stream;
-    threadinfo.encseq = ltrh_stream->encseq;
-    threadinfo.arrayLTRboundaries = &ltrh_stream->arrayLTRboundaries;
-    threadinfo.err = err;
-    threadinfo.cur_seed = 0;
-    threadinfo.rmutex = gt_mutex_new();
-    threadinfo.wmutex = gt_mutex_new();
     /* apply the seed extension and filter algorithms */
-    if (!had_err && gt_multithread(gt_searchforLTRs_threadfunc,
-                                   &threadinfo, err) != 0)
+    if (!had_err && gt_searchforLTRs_parallel(ltrh_stream, err) != 0)
     {
       had_err = -1;
     }
-    gt_mutex_delete(threadinfo.rmutex);
-    gt_mutex_delete(threadinfo.wmutex);
 
     /* not needed any longer */
     GT_FREEARRAY(&ltrh_stream->repeatinfo.repeats, Repeat);
 
     /* sort results after seed extension */
-    if (!had_err && threadinfo.arrayLTRboundaries->spaceLTRboundaries) {
-      qsort(threadinfo.arrayLTRboundaries->spaceLTRboundaries,
-            (size_t) threadinfo.arrayLTRboundaries->nextfreeLTRboundaries,
+    if (!had_err && ltrh_stream->arrayLTRboundaries.spaceLTRboundaries) {
+      qsort(ltrh_stream->arrayLTRboundaries.spaceLTRboundaries,
+            (size_t) ltrh_stream->arrayLTRboundaries.nextfreeLTRboundaries,
              sizeof (LTRboundaries),  bdcompare);
     }
 
@@ -1704,6 +1835,7 @@ GtNodeStream* gt_ltrharvest_stream_new(GtStr *str_indexname,
   ltrh_stream->arbitscores = arbitscores;
   ltrh_stream->motif = motif;
   ltrh_stream->verbosemode = verbosemode;
+  ltrh_stream->scan = scan;
   ltrh_stream->offset = offset;
   ltrh_stream->repeatinfo.ltrsearchseqrange = searchrange;
   ltrh_stream->minlengthTSD = minlengthTSD;
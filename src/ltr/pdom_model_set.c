@@ -22,6 +22,7 @@
 #include <sys/wait.h>
 #endif
 #endif
+#include "core/array_api.h"
 #include "core/compat.h"
 #include "core/error_api.h"
 #include "core/fileutils_api.h"
@@ -34,65 +35,71 @@
 
 struct GtPdomModelSet
 {
-  GtStr *filename,
-        *hmmer_path;
+  GtPdomSearch search;
+  GtStr *filename;
+  GtArray *models;
 };
 
-GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, GtError *err)
+static int gt_pdom_model_set_check_files(GtStrArray *hmmfiles, GtError *err)
 {
-  GtStr *concat_dbnames, *cmdline, *indexfilename = NULL;
+  GtUword i;
+  gt_error_check(err);
+  for (i = 0; i < gt_str_array_size(hmmfiles); i++) {
+    const char *filename = gt_str_array_get(hmmfiles, i);
+    if (!gt_file_exists(filename)) {
+      gt_error_set(err, "invalid HMM file: %s", filename);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/* Concatenate the <hmmfiles> into a file in $TMPDIR named after their MD5
+   fingerprint and press it with hmmpress, unless this has been done before. */
+static int gt_pdom_model_set_press(GtPdomModelSet *pdom_model_set,
+                                   GtStrArray *hmmfiles, GtError *err)
+{
+  GtStr *concat_dbnames, *cmdline, *indexfilename;
   GtUword i;
   char *md5_hash, ch;
   const char *tmpdir;
   int had_err = 0, rval;
   FILE *dest;
-  GtPdomModelSet *pdom_model_set;
-  gt_assert(hmmfiles);
   gt_error_check(err);
 
   rval = system("hmmpress -h > /dev/null");
   if (rval == -1) {
     gt_error_set(err, "error executing system(hmmpress)");
-    return NULL;
+    return -1;
   }
 #ifndef _WIN32
   if (WEXITSTATUS(rval) != 0) {
     gt_error_set(err, "cannot find the hmmpress executable in PATH");
-    return NULL;
+    return -1;
   }
 #else
   /* XXX */
   gt_error_set(err, "hmmpress for Windows not implemented");
-  return NULL;
+  return -1;
 #endif
 
-  pdom_model_set = gt_calloc((size_t) 1, sizeof (GtPdomModelSet));
+  if (gt_pdom_model_set_check_files(hmmfiles, err) != 0)
+    return -1;
   concat_dbnames = gt_str_new();
-  for (i = 0; !had_err && i < gt_str_array_size(hmmfiles); i++) {
-    const char *filename = gt_str_array_get(hmmfiles, i);
-    if (!gt_file_exists(filename)) {
-      gt_error_set(err, "invalid HMM file: %s", filename);
-      gt_str_delete(concat_dbnames);
-      gt_free(pdom_model_set);
-      return NULL;
-    } else {
-      gt_str_append_cstr(concat_dbnames, filename);
-    }
-  }
-  if (!had_err) {
-    pdom_model_set->filename = gt_str_new();
-    if (!(tmpdir = getenv("TMPDIR")))
-      tmpdir = "/tmp";
-    gt_str_append_cstr(pdom_model_set->filename, tmpdir);
-    gt_str_append_char(pdom_model_set->filename, GT_PATH_SEPARATOR);
-    md5_hash = gt_md5_fingerprint(gt_str_get(concat_dbnames),
-                                  gt_str_length(concat_dbnames));
-    gt_str_append_cstr(pdom_model_set->filename, md5_hash);
-    gt_free(md5_hash);
-    gt_str_delete(concat_dbnames);
-    indexfilename = gt_str_new_cstr(gt_str_get(pdom_model_set->filename));
-    gt_str_append_cstr(indexfilename, GT_HMM_INDEX_SUFFIX);
-  }
+  for (i = 0; i < gt_str_array_size(hmmfiles); i++)
+    gt_str_append_cstr(concat_dbnames, gt_str_array_get(hmmfiles, i));
+  pdom_model_set->filename = gt_str_new();
+  if (!(tmpdir = getenv("TMPDIR")))
+    tmpdir = "/tmp";
+  gt_str_append_cstr(pdom_model_set->filename, tmpdir);
+  gt_str_append_char(pdom_model_set->filename, GT_PATH_SEPARATOR);
+  md5_hash = gt_md5_fingerprint(gt_str_get(concat_dbnames),
+                                gt_str_length(concat_dbnames));
+  gt_str_append_cstr(pdom_model_set->filename, md5_hash);
+  gt_free(md5_hash);
+  gt_str_delete(concat_dbnames);
+  indexfilename = gt_str_new_cstr(gt_str_get(pdom_model_set->filename));
+  gt_str_append_cstr(indexfilename, GT_HMM_INDEX_SUFFIX);
 
   if (!gt_file_exists(gt_str_get(indexfilename))) {
     dest = fopen(gt_str_get(pdom_model_set->filename), "w+");
@@ -118,45 +125,109 @@ GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, GtError *err)
       }
       (void) fclose(dest);
     }
-    /* XXX: read hmmer path from env */
-    cmdline = gt_str_new_cstr("hmmpress -f ");
-    gt_str_append_str(cmdline, pdom_model_set->filename);
-    gt_str_append_cstr(cmdline, "> /dev/null");   /* XXX: portability? */
-
-    rval = system(gt_str_get(cmdline));
-    gt_str_delete(cmdline);
-    if (rval == -1) {
-      gt_error_set(err, "error executing system(hmmpress)");
-      return NULL;
-    }
+    if (!had_err) {
+      /* XXX: read hmmer path from env */
+      cmdline = gt_str_new_cstr("hmmpress -f ");
+      gt_str_append_str(cmdline, pdom_model_set->filename);
+      gt_str_append_cstr(cmdline, "> /dev/null");   /* XXX: portability? */
+
+      rval = system(gt_str_get(cmdline));
+      gt_str_delete(cmdline);
+      if (rval == -1) {
+        gt_error_set(err, "error executing system(hmmpress)");
+        had_err = -1;
+      }
 #ifndef _WIN32
-    if (WEXITSTATUS(rval) != 0) {
-      gt_error_set(err, "an error occurred during HMM preprocessing");
-      had_err = -1;
-    }
+      if (!had_err && WEXITSTATUS(rval) != 0) {
+        gt_error_set(err, "an error occurred during HMM preprocessing");
+        had_err = -1;
+      }
 #else
-    gt_error_set(err, "WEXITSTATUS not implemented on Windows");
-    had_err = -1;
+      gt_error_set(err, "WEXITSTATUS not implemented on Windows");
+      had_err = -1;
 #endif
+    }
+  }
+  gt_str_delete(indexfilename);
+  return had_err;
+}
+
+static int gt_pdom_model_set_read(GtPdomModelSet *pdom_model_set,
+                                  GtStrArray *hmmfiles, GtError *err)
+{
+  GtUword i;
+  int had_err = 0;
+  gt_error_check(err);
+  had_err = gt_pdom_model_set_check_files(hmmfiles, err);
+  pdom_model_set->models = gt_array_new(sizeof (GtHMMERModel*));
+  for (i = 0; !had_err && i < gt_str_array_size(hmmfiles); i++) {
+    had_err = gt_hmmer_model_read(pdom_model_set->models,
+                                  gt_str_array_get(hmmfiles, i), err);
+  }
+  return had_err;
+}
+
+GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles,
+                                      GtPdomSearch search, GtError *err)
+{
+  int had_err = 0;
+  GtPdomModelSet *pdom_model_set;
+  gt_assert(hmmfiles);
+  gt_error_check(err);
+
+  pdom_model_set = gt_calloc((size_t) 1, sizeof (GtPdomModelSet));
+  pdom_model_set->search = search;
+  switch (search) {
+    case GT_PDOM_SEARCH_HMMSCAN:
+      had_err = gt_pdom_model_set_press(pdom_model_set, hmmfiles, err);
+      break;
+    case GT_PDOM_SEARCH_BUILTIN:
+      had_err = gt_pdom_model_set_read(pdom_model_set, hmmfiles, err);
+      break;
   }
 
   if (had_err) {
     gt_pdom_model_set_delete(pdom_model_set);
     pdom_model_set = NULL;
   }
-  gt_str_delete(indexfilename);
   return pdom_model_set;
 }
 
-const char* gt_pdom_model_set_get_filename(GtPdomModelSet *set)
+GtPdomSearch gt_pdom_model_set_get_search(const GtPdomModelSet *set)
 {
   gt_assert(set);
+  return set->search;
+}
+
+const char* gt_pdom_model_set_get_filename(const GtPdomModelSet *set)
+{
+  gt_assert(set && set->search == GT_PDOM_SEARCH_HMMSCAN);
   return gt_str_get(set->filename);
 }
 
+GtUword gt_pdom_model_set_size(const GtPdomModelSet *set)
+{
+  gt_assert(set && set->search == GT_PDOM_SEARCH_BUILTIN);
+  return gt_array_size(set->models);
+}
+
+const GtHMMERModel* gt_pdom_model_set_get(const GtPdomModelSet *set,
+                                          GtUword idx)
+{
+  gt_assert(set && set->search == GT_PDOM_SEARCH_BUILTIN
+              && idx < gt_array_size(set->models));
+  return *(GtHMMERModel**) gt_array_get(set->models, idx);
+}
+
 void gt_pdom_model_set_delete(GtPdomModelSet *set)
 {
+  GtUword i;
   if (!set) return;
   gt_str_delete(set->filename);
+  if (set->models != NULL) {
+    for (i = 0; i < gt_array_size(set->models); i++)
+      gt_hmmer_model_delete(*(GtHMMERModel**) gt_array_get(set->models, i));
+    gt_array_delete(set->models);
+  }
   gt_free(set);
 }
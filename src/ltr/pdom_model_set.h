@@ -18,10 +18,34 @@
 #ifndef PDOM_MODEL_SET_H
 #define PDOM_MODEL_SET_H
 
+#include "core/error_api.h"
+#include "core/str_array_api.h"
+#include "extended/hmmer_model.h"
+
+/* The ways to search protein domains with the models of a <GtPdomModelSet>. */
+typedef enum {
+  GT_PDOM_SEARCH_HMMSCAN, /* run the external hmmscan on the pressed models */
+  GT_PDOM_SEARCH_BUILTIN  /* search with the built-in <GtHMMERModel>s */
+} GtPdomSearch;
+
+/* A set of protein domain profile HMMs read from HMMER3 files. */
 typedef struct GtPdomModelSet GtPdomModelSet;
 
-GtPdomModelSet* gt_pdom_model_set_new(GtStrArray *hmmfiles, GtError *err);
-const char*     gt_pdom_model_set_get_filename(GtPdomModelSet *set);
-void            gt_pdom_model_set_delete(GtPdomModelSet *set);
+/* Return a new <GtPdomModelSet> for the models in <hmmfiles>. With
+   <GT_PDOM_SEARCH_HMMSCAN>, the files are concatenated and pressed with the
+   external hmmpress, otherwise the models are read into memory. */
+GtPdomModelSet*     gt_pdom_model_set_new(GtStrArray *hmmfiles,
+                                          GtPdomSearch search, GtError *err);
+/* Return the way the models in <set> are searched. */
+GtPdomSearch        gt_pdom_model_set_get_search(const GtPdomModelSet *set);
+/* Return the name of the pressed model file (<GT_PDOM_SEARCH_HMMSCAN> only). */
+const char*         gt_pdom_model_set_get_filename(const GtPdomModelSet *set);
+/* Return the number of models in <set> (<GT_PDOM_SEARCH_BUILTIN> only). */
+GtUword             gt_pdom_model_set_size(const GtPdomModelSet *set);
+/* Return the <idx>-th model in <set>, in the order of the files
+   (<GT_PDOM_SEARCH_BUILTIN> only). */
+const GtHMMERModel* gt_pdom_model_set_get(const GtPdomModelSet *set,
+                                          GtUword idx);
+void                gt_pdom_model_set_delete(GtPdomModelSet *set);
 
 #endif
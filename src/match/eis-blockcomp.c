@@ -985,6 +985,37 @@ blockCompSeqSelect(GT_UNUSED struct encIdxSeq *seq, GT_UNUSED Symbol sym,
   return 0;
 }
 
+/*
+ * Only the start of the constant width data of the super block,
+ * which holds the partial symbol sums, is prefetched. Indices which
+ * are read from disk are not prefetched.
+ */
+static void
+blockCompSeqPrefetch(const struct encIdxSeq *eSeqIdx, GtUword pos)
+{
+  const struct blockCompositionSeq *seqIdx;
+  gt_assert(eSeqIdx && eSeqIdx->classInfo == &blockCompositionSeqClass);
+  seqIdx = constEncIdxSeq2blockCompositionSeq(eSeqIdx);
+  if (seqIdxUsesMMap(seqIdx) && pos < EISLength(eSeqIdx))
+  {
+    BitOffset bucketOffset
+      = bucketNumFromPos(seqIdx, pos) * superBlockCWBits(seqIdx);
+    __builtin_prefetch(seqIdx->externalData.idxMMap
+                       + bucketOffset / bitElemBits * sizeof (BitElem));
+  }
+}
+
+/*
+ * All state of a query is kept in its hint, only the file pointer of
+ * indices which could not be mapped into memory is shared.
+ */
+static int
+blockCompSeqConcurrentQueries(const struct encIdxSeq *eSeqIdx)
+{
+  gt_assert(eSeqIdx && eSeqIdx->classInfo == &blockCompositionSeqClass);
+  return seqIdxUsesMMap(constEncIdxSeq2blockCompositionSeq(eSeqIdx));
+}
+
 /*
  * routines for management of super-Block-Cache, this does currently
  * use a simple direct-mapped caching
@@ -2771,4 +2802,6 @@ static const struct encIdxSeqClass blockCompositionSeqClass =
   .seekToHeader = seekToHeader,
   .printPosDiags = printBlockEncPosDiags,
   .printExtPosDiags = displayBlockEncBlock,
+  .prefetch = blockCompSeqPrefetch,
+  .concurrentQueries = blockCompSeqConcurrentQueries,
 };
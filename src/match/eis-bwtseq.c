@@ -20,6 +20,8 @@
 #include "core/error.h"
 #include "core/log.h"
 #include "core/str.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/undef_api.h"
@@ -159,67 +161,112 @@ static const Mbtab *gt_prebwt_next(GtPrebwtstate *prebwt,unsigned int cc)
   return prebwt->mbtab[prebwt->depth] + prebwt->code;
 }
 
-static inline void
-getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
-              struct matchBound *match, bool forward)
+/* state of the backward search for one query, see getMatchBound */
+struct matchBoundState
 {
   const Symbol *qptr, *qend;
+  bool forward;
+  GtPrebwtstate prebwt;
+};
+
+static inline void
+matchBoundInit(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
+               struct matchBound *match, bool forward,
+               struct matchBoundState *state)
+{
   unsigned int cc;
   const Mbtab *mbptr;
-  GtPrebwtstate prebwt;
 
   gt_assert(bwtSeq && query);
+  state->forward = forward;
   if (forward)
   {
-    qptr = query;
-    qend = query + queryLen;
+    state->qptr = query;
+    state->qend = query + queryLen;
   } else
   {
-    qptr = query + queryLen - 1;
-    qend = query - 1;
+    state->qptr = query + queryLen - 1;
+    state->qend = query - 1;
   }
-  gt_assert(ISNOTSPECIAL(*qptr));
-  cc = (unsigned int) *qptr;
-  prebwt.mbtab = gt_bwtseq2mbtab((const FMindex *) bwtSeq);
-  if (prebwt.mbtab != NULL)
+  gt_assert(ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
+  state->prebwt.mbtab = gt_bwtseq2mbtab((const FMindex *) bwtSeq);
+  if (state->prebwt.mbtab != NULL)
   {
-    prebwt.numofchars = gt_bwtseq2numofchars((const FMindex *) bwtSeq);
-    prebwt.maxdepth = gt_bwtseq2maxdepth((const FMindex *) bwtSeq);
-    prebwt.code = 0;
-    prebwt.depth = 0;
-    mbptr = gt_prebwt_next(&prebwt,cc);
+    state->prebwt.numofchars = gt_bwtseq2numofchars((const FMindex *) bwtSeq);
+    state->prebwt.maxdepth = gt_bwtseq2maxdepth((const FMindex *) bwtSeq);
+    state->prebwt.code = 0;
+    state->prebwt.depth = 0;
+    mbptr = gt_prebwt_next(&state->prebwt,cc);
     match->start = mbptr->lowerbound;
     match->end = mbptr->upperbound;
   } else
   {
-    prebwt.numofchars = GT_UNDEF_UINT;
-    prebwt.maxdepth = GT_UNDEF_UINT;
-    prebwt.code = 0;
-    prebwt.depth = GT_UNDEF_UINT;
+    state->prebwt.numofchars = GT_UNDEF_UINT;
+    state->prebwt.maxdepth = GT_UNDEF_UINT;
+    state->prebwt.code = 0;
+    state->prebwt.depth = GT_UNDEF_UINT;
     match->start = bwtSeq->count[cc];
     match->end   = bwtSeq->count[cc + 1];
   }
-  qptr = forward ? (qptr+1) : (qptr-1);
-  while (match->start < match->end && qptr != qend)
+  state->qptr = forward ? (state->qptr+1) : (state->qptr-1);
+}
+
+static inline bool
+matchBoundDone(const struct matchBoundState *state,
+               const struct matchBound *match)
+{
+  return match->start >= match->end || state->qptr == state->qend;
+}
+
+/* prefetch the rank data the next call of matchBoundNext will access */
+static inline void
+matchBoundPrefetch(const BWTSeq *bwtSeq, const struct matchBoundState *state,
+                   const struct matchBound *match)
+{
+  if (state->prebwt.mbtab == NULL ||
+      state->prebwt.depth >= state->prebwt.maxdepth)
   {
-    GtUlongPair occPair;
+    EISPrefetch(bwtSeq->seqIdx, match->start);
+    EISPrefetch(bwtSeq->seqIdx, match->end);
+  }
+}
 
-    gt_assert(ISNOTSPECIAL(*qptr));
-    cc = (unsigned int) *qptr;
-    if (prebwt.mbtab != NULL && prebwt.depth < prebwt.maxdepth)
-    {
-      mbptr = gt_prebwt_next(&prebwt,cc);
-      match->start = mbptr->lowerbound;
-      match->end = mbptr->upperbound;
-    } else
-    {
-      occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
-                                            match->end);
-      match->start = bwtSeq->count[cc] + occPair.a;
-      match->end   = bwtSeq->count[cc] + occPair.b;
-    }
-    qptr = forward ? (qptr+1) : (qptr-1);
+static inline void
+matchBoundNext(const BWTSeq *bwtSeq, struct matchBoundState *state,
+               struct matchBound *match)
+{
+  unsigned int cc;
+  const Mbtab *mbptr;
+  GtUlongPair occPair;
+
+  gt_assert(ISNOTSPECIAL(*state->qptr));
+  cc = (unsigned int) *state->qptr;
+  if (state->prebwt.mbtab != NULL &&
+      state->prebwt.depth < state->prebwt.maxdepth)
+  {
+    mbptr = gt_prebwt_next(&state->prebwt,cc);
+    match->start = mbptr->lowerbound;
+    match->end = mbptr->upperbound;
+  } else
+  {
+    occPair = BWTSeqTransformedPosPairOcc(bwtSeq, (Symbol) cc, match->start,
+                                          match->end);
+    match->start = bwtSeq->count[cc] + occPair.a;
+    match->end   = bwtSeq->count[cc] + occPair.b;
   }
+  state->qptr = state->forward ? (state->qptr+1) : (state->qptr-1);
+}
+
+static inline void
+getMatchBound(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
+              struct matchBound *match, bool forward)
+{
+  struct matchBoundState state;
+
+  matchBoundInit(bwtSeq, query, queryLen, match, forward, &state);
+  while (!matchBoundDone(&state, match))
+    matchBoundNext(bwtSeq, &state, match);
 }
 
 GtUword gt_packedindexuniqueforward(const BWTSeq *bwtSeq,
@@ -376,6 +423,166 @@ gt_BWTSeqMatchCount(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
     return match.end - match.start;
 }
 
+enum
+{
+  /* number of queries whose backward searches are interleaved */
+  MATCH_BOUND_INTERLEAVE = 16,
+  /* number of queries processed by one task */
+  MATCH_BOUND_GRAIN = 256,
+};
+
+struct BWTSeqBatchInfo
+{
+  const BWTSeq *bwtSeq;
+  const Symbol *const *queries;
+  const GtUword *queryLens;
+  bool forward;
+  struct matchBound *bounds;
+  const GtUword *offsets;
+  GtUword *positions;
+};
+
+/* Compute the match bounds of queries <start> to <end> - 1 by advancing the
+   backward searches of up to <MATCH_BOUND_INTERLEAVE> queries in lock step.
+   The rank data needed by the next step of every query is prefetched before
+   any of them is computed, so the cache misses overlap. */
+static void
+matchBoundsInterleaved(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                       const GtUword *queryLens, GtUword start, GtUword end,
+                       bool forward, struct matchBound *bounds)
+{
+  struct matchBoundState states[MATCH_BOUND_INTERLEAVE];
+  GtUword active[MATCH_BOUND_INTERLEAVE], next = start;
+  unsigned numActive = 0, i, j;
+
+  while (next < end || numActive > 0)
+  {
+    while (next < end && numActive < MATCH_BOUND_INTERLEAVE)
+    {
+      matchBoundInit(bwtSeq, queries[next], (size_t) queryLens[next],
+                     bounds + next, forward, states + numActive);
+      if (!matchBoundDone(states + numActive, bounds + next))
+        active[numActive++] = next;
+      next++;
+    }
+    for (i = 0; i < numActive; i++)
+      matchBoundPrefetch(bwtSeq, states + i, bounds + active[i]);
+    for (i = j = 0; i < numActive; i++)
+    {
+      matchBoundNext(bwtSeq, states + i, bounds + active[i]);
+      if (!matchBoundDone(states + i, bounds + active[i]))
+      {
+        states[j] = states[i];
+        active[j++] = active[i];
+      }
+    }
+    numActive = j;
+  }
+}
+
+static void
+matchBoundsRange(GtUword start, GtUword end, void *data)
+{
+  struct BWTSeqBatchInfo *info = data;
+  BWTSeq localSeq = *info->bwtSeq;
+
+  localSeq.hint = newEISHint(localSeq.seqIdx);
+  matchBoundsInterleaved(&localSeq, info->queries, info->queryLens, start, end,
+                         info->forward, info->bounds);
+  deleteEISHint(localSeq.seqIdx, localSeq.hint);
+}
+
+static bool
+BWTSeqBatchInParallel(const BWTSeq *bwtSeq, GtUword numQueries)
+{
+#ifdef GT_THREADS_ENABLED
+  return gt_jobs > 1U && numQueries > (GtUword) MATCH_BOUND_GRAIN
+         && EISAllowsConcurrentQueries(bwtSeq->seqIdx);
+#else
+  (void) bwtSeq;
+  (void) numQueries;
+  return false;
+#endif
+}
+
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const GtUword *queryLens, GtUword numQueries,
+                          bool forward, struct matchBound *bounds)
+{
+  gt_assert(bwtSeq && queries && queryLens && bounds);
+  if (BWTSeqBatchInParallel(bwtSeq, numQueries))
+  {
+    struct BWTSeqBatchInfo info;
+    info.bwtSeq = bwtSeq;
+    info.queries = queries;
+    info.queryLens = queryLens;
+    info.forward = forward;
+    info.bounds = bounds;
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numQueries,
+                                (GtUword) MATCH_BOUND_GRAIN, matchBoundsRange,
+                                &info);
+  } else
+    matchBoundsInterleaved(bwtSeq, queries, queryLens, 0, numQueries,
+                           forward, bounds);
+}
+
+static void
+locateMatchesRange(GtUword start, GtUword end, void *data)
+{
+  struct BWTSeqBatchInfo *info = data;
+  BWTSeq localSeq = *info->bwtSeq;
+  struct extBitsRetrieval extBits;
+  GtUword idx, row, *posptr;
+
+  localSeq.hint = newEISHint(localSeq.seqIdx);
+  initExtBitsRetrieval(&extBits);
+  for (idx = start; idx < end; idx++)
+  {
+    posptr = info->positions + info->offsets[idx];
+    for (row = info->bounds[idx].start; row < info->bounds[idx].end; row++)
+      *posptr++ = gt_BWTSeqLocateMatch(&localSeq, row, &extBits);
+  }
+  destructExtBitsRetrieval(&extBits);
+  deleteEISHint(localSeq.seqIdx, localSeq.hint);
+}
+
+GtUword *
+gt_BWTSeqLocateMatchesBatch(const BWTSeq *bwtSeq,
+                            const struct matchBound *bounds,
+                            GtUword numQueries, GtUword *offsets)
+{
+  struct BWTSeqBatchInfo info;
+  GtUword idx, total = 0;
+
+  gt_assert(bwtSeq && bounds && offsets);
+  if (!bwtSeq->locateSampleInterval)
+  {
+    fputs("Index does not contain locate information.\n"
+          "Localization of matches impossible!", stderr);
+    return NULL;
+  }
+  for (idx = 0; idx < numQueries; idx++)
+  {
+    offsets[idx] = total;
+    if (bounds[idx].start < bounds[idx].end)
+      total += bounds[idx].end - bounds[idx].start;
+  }
+  offsets[numQueries] = total;
+  info.bwtSeq = bwtSeq;
+  info.bounds = (struct matchBound *) bounds;
+  info.offsets = offsets;
+  info.positions = gt_malloc(sizeof (*info.positions) * (total > 0 ? total
+                                                                   : 1UL));
+  if (BWTSeqBatchInParallel(bwtSeq, numQueries))
+    gt_thread_pool_parallel_for(gt_thread_pool_get(), 0, numQueries,
+                                (GtUword) MATCH_BOUND_GRAIN,
+                                locateMatchesRange, &info);
+  else
+    locateMatchesRange(0, numQueries, &info);
+  return info.positions;
+}
+
 bool
 gt_initEMIterator(BWTSeqExactMatchesIterator *iter, const BWTSeq *bwtSeq,
                const Symbol *query, size_t queryLen, bool forward)
@@ -301,6 +301,42 @@ GtUword
 gt_BWTSeqMatchCount(const BWTSeq *bwtSeq, const Symbol *query, size_t queryLen,
                  bool forward);
 
+/**
+ * \brief Compute the matching intervals of a batch of queries.
+ *
+ * The backward searches of several queries are interleaved such that
+ * the memory accesses of one query overlap with the computations for
+ * the others. If gt_jobs is larger than one and the index allows it,
+ * the queries are distributed over the threads of the global thread pool.
+ * @param bwtSeq reference of object to query
+ * @param queries table of numQueries symbol strings to search matches for
+ * @param queryLens table of the lengths of the query strings
+ * @param numQueries number of queries
+ * @param forward direction of processing the queries
+ * @param bounds the matching interval of queries[i] is stored in bounds[i]
+ */
+void
+gt_BWTSeqMatchBoundsBatch(const BWTSeq *bwtSeq, const Symbol *const *queries,
+                          const GtUword *queryLens, GtUword numQueries,
+                          bool forward, struct matchBound *bounds);
+
+/**
+ * \brief Locate the matches of a batch of matching intervals, as
+ * computed by gt_BWTSeqMatchBoundsBatch.
+ * @param bwtSeq reference of object to query
+ * @param bounds table of numQueries matching intervals
+ * @param numQueries number of intervals
+ * @param offsets table of numQueries + 1 entries, the positions of the
+ * matches of bounds[i] are stored from index offsets[i] to offsets[i+1]-1
+ * of the result, in the order produced by EMIGetNextMatch
+ * @return newly allocated table of positions, NULL if the index contains
+ * no locate information
+ */
+GtUword *
+gt_BWTSeqLocateMatchesBatch(const BWTSeq *bwtSeq,
+                            const struct matchBound *bounds,
+                            GtUword numQueries, GtUword *offsets);
+
 /**
  * \brief Given a pair of limiting positions in the suffix array and a
  * symbol, compute the interval reached by matching one symbol further.
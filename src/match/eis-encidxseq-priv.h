@@ -50,6 +50,8 @@ struct encIdxSeqClass
                        EISHint hint);
   int (*printExtPosDiags)(const EISeq *seq, GtUword pos, FILE *fp,
                           EISHint hint);
+  void (*prefetch)(const EISeq *seq, GtUword pos);
+  int (*concurrentQueries)(const EISeq *seq);
 };
 
 struct encIdxSeq
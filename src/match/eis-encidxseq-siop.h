@@ -164,6 +164,22 @@ deleteEISHint(EISeq *seq, EISHint hint)
   return seq->classInfo->deleteHint(seq, hint);
 }
 
+static inline void
+EISPrefetch(const EISeq *seq, GtUword pos)
+{
+  if (seq->classInfo->prefetch)
+    seq->classInfo->prefetch(seq, pos);
+}
+
+static inline int
+EISAllowsConcurrentQueries(const EISeq *seq)
+{
+  if (seq->classInfo->concurrentQueries)
+    return seq->classInfo->concurrentQueries(seq);
+  else
+    return 0;
+}
+
 static inline int
 EISPrintDiagsForPos(const EISeq *seq, GtUword pos, FILE *fp, EISHint hint)
 {
@@ -366,6 +366,25 @@ newEISHint(const EISeq *seq);
 static inline void
 deleteEISHint(EISeq *seq, EISHint hint);
 
+/**
+ * \brief Prefetch the data needed to compute ranks for the given
+ * position into the cache, such that the latency of the memory access
+ * can be hidden behind other work.
+ * @param seq reference of sequence object to use
+ * @param pos position for which a rank query will follow
+ */
+static inline void
+EISPrefetch(const EISeq *seq, GtUword pos);
+
+/**
+ * \brief Query whether different threads may query the sequence at
+ * the same time, each with its own hint.
+ * @param seq reference of sequence object to use
+ * @return 0 if queries must be serialized, non-zero otherwise
+ */
+static inline int
+EISAllowsConcurrentQueries(const EISeq *seq);
+
 /**
  * Possible outcome of index integrity check.
  */
@@ -495,6 +495,91 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
   return numofmatches > 0 ? true : false;
 }
 
+void gt_pck_exactpatternmatching_batch(const FMindex *fmindex,
+                                       const GtUchar *const *patterns,
+                                       const GtUword *patternlengths,
+                                       GtUword numofpatterns,
+                                       GtUword totallength,
+                                       GtUword maxnumofmatches,
+                                       ProcessIdxMatchesBatch processmatches,
+                                       void *processmatchesinfo)
+{
+  struct matchBound *bounds, *roundbounds;
+  GtUword idx, row, roundidx, numinround, numofmatches, width,
+          *roundpatterns, *offsets, *positions, *posptr;
+
+  gt_assert(maxnumofmatches > 0);
+  if (numofpatterns == 0)
+  {
+    return;
+  }
+  bounds = gt_malloc(sizeof (*bounds) * numofpatterns);
+  gt_BWTSeqMatchBoundsBatch((const BWTSeq *) fmindex, patterns,
+                            patternlengths, numofpatterns, true, bounds);
+  for (idx = 0; idx < numofpatterns; idx++)
+  {
+    if (bounds[idx].end < bounds[idx].start)
+    {
+      bounds[idx].end = bounds[idx].start;
+    }
+  }
+  /* a pattern occurs at most once in each round, either completely or with
+     a part of its matching interval */
+  roundbounds = gt_malloc(sizeof (*roundbounds) * numofpatterns);
+  roundpatterns = gt_malloc(sizeof (*roundpatterns) * numofpatterns);
+  offsets = gt_malloc(sizeof (*offsets) * (numofpatterns + 1));
+  idx = 0;
+  row = bounds[0].start;
+  while (idx < numofpatterns)
+  {
+    for (numinround = 0, numofmatches = 0;
+         idx < numofpatterns && numofmatches < maxnumofmatches;
+         numinround++)
+    {
+      width = bounds[idx].end - row;
+      if (width > maxnumofmatches - numofmatches)
+      {
+        width = maxnumofmatches - numofmatches;
+      }
+      roundbounds[numinround].start = row;
+      roundbounds[numinround].end = row + width;
+      roundpatterns[numinround] = idx;
+      numofmatches += width;
+      row += width;
+      if (row == bounds[idx].end)
+      {
+        idx++;
+        if (idx < numofpatterns)
+        {
+          row = bounds[idx].start;
+        }
+      }
+    }
+    positions = gt_BWTSeqLocateMatchesBatch((const BWTSeq *) fmindex,
+                                            roundbounds, numinround, offsets);
+    gt_assert(positions != NULL);
+    for (roundidx = 0; roundidx < numinround; roundidx++)
+    {
+      GtUword patternnum = roundpatterns[roundidx];
+
+      for (posptr = positions + offsets[roundidx];
+           posptr < positions + offsets[roundidx+1]; posptr++)
+      {
+        gt_assert(totallength >= (*posptr + patternlengths[patternnum]));
+        *posptr = totallength - (*posptr + patternlengths[patternnum]);
+      }
+      processmatches(processmatchesinfo, patternnum,
+                     positions + offsets[roundidx],
+                     offsets[roundidx+1] - offsets[roundidx]);
+    }
+    gt_free(positions);
+  }
+  gt_free(offsets);
+  gt_free(roundpatterns);
+  gt_free(roundbounds);
+  gt_free(bounds);
+}
+
 GtUword gt_voidpackedindex_totallength_get(const FMindex *fmindex)
 {
   GtUword bwtlen = BWTSeqLength((const BWTSeq *) fmindex);
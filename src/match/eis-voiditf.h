@@ -114,6 +114,30 @@ bool gt_pck_exactpatternmatching(const FMindex *fmindex,
                                  ProcessIdxMatch processmatch,
                                  void *processmatchinfo);
 
+/* Processes the start positions in <positions> of <numofpositions> matches
+   of pattern number <patternnum> of a batch. */
+typedef void (*ProcessIdxMatchesBatch)(void *processinfo,
+                                       GtUword patternnum,
+                                       const GtUword *positions,
+                                       GtUword numofpositions);
+
+/* Search the exact matches of the <numofpatterns> patterns in <patterns>
+   with lengths <patternlengths> simultaneously, using the threads of the
+   global thread pool if <gt_jobs> is larger than one. The matches are located
+   in rounds of at most <maxnumofmatches> positions, which are passed to
+   <processmatches> pattern by pattern, in the order in which
+   <gt_pck_exactpatternmatching()> reports them. <processmatches> is called at
+   least once for every pattern, the matches of a pattern with more than
+   <maxnumofmatches> matches are split over several calls. */
+void gt_pck_exactpatternmatching_batch(const FMindex *fmindex,
+                                       const GtUchar *const *patterns,
+                                       const GtUword *patternlengths,
+                                       GtUword numofpatterns,
+                                       GtUword totallength,
+                                       GtUword maxnumofmatches,
+                                       ProcessIdxMatchesBatch processmatches,
+                                       void *processmatchesinfo);
+
 GtUword gt_voidpackedfindfirstmatchconvert(const FMindex *fmindex,
                                                  GtUword witnessbound,
                                                  GtUword matchlength);
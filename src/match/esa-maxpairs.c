@@ -16,6 +16,7 @@
 */
 
 #include "core/arraydef.h"
+#include "core/ma_api.h"
 #include "core/unused_api.h"
 #include "esa-seqread.h"
 #include "esa-maxpairs.h"
@@ -348,18 +349,15 @@ static int processbranchingedge_maxpairs(bool firstsucc,
 
 #include "esa-bottomup-maxpairs.inc"
 
-int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
-                         const GtEncseq *encseq,
-                         GtReadmode readmode,
-                         unsigned int searchlength,
-                         Processmaxpairs processmaxpairs,
-                         void *processmaxpairsinfo,
-                         GtError *err)
+static GtBUstate_maxpairs *gt_BUstate_maxpairs_new(const GtEncseq *encseq,
+                                                GtReadmode readmode,
+                                                unsigned int searchlength,
+                                                Processmaxpairs processmaxpairs,
+                                                void *processmaxpairsinfo)
 {
   unsigned int base;
   GtArrayGtUlong *ptr;
   GtBUstate_maxpairs *state;
-  bool haserr = false;
 
   state = gt_malloc(sizeof (*state));
   state->alphabetsize = gt_alphabet_num_of_chars(gt_encseq_alphabet(encseq));
@@ -377,10 +375,14 @@ int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
     ptr = &state->poslist[base];
     GT_INITARRAY(ptr,GtUlong);
   }
-  if (gt_esa_bottomup_maxpairs(ssar, state, err) != 0)
-  {
-    haserr = true;
-  }
+  return state;
+}
+
+static void gt_BUstate_maxpairs_delete(GtBUstate_maxpairs *state)
+{
+  unsigned int base;
+  GtArrayGtUlong *ptr;
+
   GT_FREEARRAY(&state->uniquechar,GtUlong);
   for (base = 0; base < state->alphabetsize; base++)
   {
@@ -389,5 +391,98 @@ int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
   }
   gt_free(state->poslist);
   gt_free(state);
+}
+
+int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
+                         const GtEncseq *encseq,
+                         GtReadmode readmode,
+                         unsigned int searchlength,
+                         Processmaxpairs processmaxpairs,
+                         void *processmaxpairsinfo,
+                         GtError *err)
+{
+  GtBUstate_maxpairs *state;
+  bool haserr = false;
+
+  state = gt_BUstate_maxpairs_new(encseq,readmode,searchlength,
+                                  processmaxpairs,processmaxpairsinfo);
+  if (gt_esa_bottomup_maxpairs(ssar, state, err) != 0)
+  {
+    haserr = true;
+  }
+  gt_BUstate_maxpairs_delete(state);
   return haserr ? -1 : 0;
 }
+
+typedef struct
+{
+  const GtEncseq *encseq;
+  GtReadmode readmode;
+  unsigned int searchlength;
+  Processmaxpairs processmaxpairs;
+  Maxpairsrangeinfonew rangeinfonew;
+  Maxpairsrangeinfodone rangeinfodone;
+  void *data;
+} GtMaxpairsranges;
+
+static void *gt_maxpairs_rangeinfonew(void *data)
+{
+  GtMaxpairsranges *ranges = data;
+
+  return ranges->rangeinfonew(ranges->data);
+}
+
+static int gt_enumeratemaxpairs_range(Sequentialsuffixarrayreader *rangessar,
+                                      void *rangeinfo,
+                                      void *data,
+                                      GtError *err)
+{
+  GtMaxpairsranges *ranges = data;
+  GtBUstate_maxpairs *state;
+  int retval;
+
+  state = gt_BUstate_maxpairs_new(ranges->encseq,ranges->readmode,
+                                  ranges->searchlength,
+                                  ranges->processmaxpairs,
+                                  rangeinfo);
+  retval = gt_esa_bottomup_maxpairs(rangessar,state,err);
+  gt_BUstate_maxpairs_delete(state);
+  return retval;
+}
+
+static void gt_maxpairs_rangeinfodone(void *data,void *rangeinfo)
+{
+  GtMaxpairsranges *ranges = data;
+
+  ranges->rangeinfodone(ranges->data,rangeinfo);
+}
+
+/* every lcp-interval of depth at least <searchlength>, and hence every maximal
+   pair, lies in a single range of suffixes */
+int gt_enumeratemaxpairs_ranges(Sequentialsuffixarrayreader *ssar,
+                                const GtEncseq *encseq,
+                                GtReadmode readmode,
+                                unsigned int searchlength,
+                                Processmaxpairs processmaxpairs,
+                                Maxpairsrangeinfonew rangeinfonew,
+                                Maxpairsrangeinfodone rangeinfodone,
+                                void *data,
+                                GtError *err)
+{
+  GtMaxpairsranges ranges;
+
+  ranges.encseq = encseq;
+  ranges.readmode = readmode;
+  ranges.searchlength = searchlength;
+  ranges.processmaxpairs = processmaxpairs;
+  ranges.rangeinfonew = rangeinfonew;
+  ranges.rangeinfodone = rangeinfodone;
+  ranges.data = data;
+  return gt_Sequentialsuffixarrayreader_process_lcpranges(ssar,
+                                                    (GtUword) searchlength,
+                                                    gt_maxpairs_rangeinfonew,
+                                                    gt_enumeratemaxpairs_range,
+                                                    gt_maxpairs_rangeinfodone,
+                                                    &ranges,
+                                                    err);
+}
@@ -37,4 +37,29 @@ int gt_enumeratemaxpairs(Sequentialsuffixarrayreader *ssar,
                          void *processmaxpairsinfo,
                          GtError *err);
 
+/* Return the information passed to <Processmaxpairs> for the maximal pairs
+   of one part of the suffix array. <data> is the pointer given to
+   <gt_enumeratemaxpairs_ranges()>. */
+typedef void *(*Maxpairsrangeinfonew)(void *data);
+
+/* Finish and free the <rangeinfo> of a part of the suffix array after all of
+   its maximal pairs have been processed. */
+typedef void (*Maxpairsrangeinfodone)(void *data,void *rangeinfo);
+
+/* Enumerate the maximal pairs like <gt_enumeratemaxpairs()>, but split the
+   mapped suffix array <ssar> into parts which are processed in parallel by
+   the global thread pool. <processmaxpairs> is called with a separate
+   information for each part, created by <rangeinfonew>. <rangeinfodone> is
+   called in the order of the parts, so that results collected per part can
+   be reported in the order of <gt_enumeratemaxpairs()>. */
+int gt_enumeratemaxpairs_ranges(Sequentialsuffixarrayreader *ssar,
+                                const GtEncseq *encseq,
+                                GtReadmode readmode,
+                                unsigned int searchlength,
+                                Processmaxpairs processmaxpairs,
+                                Maxpairsrangeinfonew rangeinfonew,
+                                Maxpairsrangeinfodone rangeinfodone,
+                                void *data,
+                                GtError *err);
+
 #endif
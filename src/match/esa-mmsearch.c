@@ -925,3 +925,108 @@ int gt_sarrquerysubstringmatch(const GtUchar *dbseq,
   dbencseq = NULL;
   return haserr ? -1 : 0;
 }
+
+struct GtQuerysubstringmatcher
+{
+  const GtEncseq *dbencseq;
+  Sfxiterator *sfi;
+  const ESASuffixptr *suftab;
+  GtUword numberofsuffixes;
+};
+
+GtQuerysubstringmatcher *gt_querysubstringmatcher_new(const GtEncseq *dbencseq,
+                                                      GtError *err)
+{
+  GtQuerysubstringmatcher *qsm;
+  const GtSuffixsortspace *suffixsortspace;
+  Sfxstrategy sfxstrategy;
+  unsigned int prefixlength;
+
+  gt_assert(dbencseq != NULL);
+  prefixlength
+    = gt_recommendedprefixlength(gt_alphabet_num_of_chars(
+                                               gt_encseq_alphabet(dbencseq)),
+                                 gt_encseq_total_length(dbencseq),
+                                 GT_RECOMMENDED_MULTIPLIER_DEFAULT,
+                                 true);
+  defaultsfxstrategy(&sfxstrategy,
+                     gt_encseq_bitwise_cmp_ok(dbencseq) ? false : true);
+  sfxstrategy.outsuftabonfile = false;
+  qsm = gt_malloc(sizeof *qsm);
+  qsm->dbencseq = dbencseq;
+  qsm->sfi = gt_Sfxiterator_new(dbencseq,
+                                GT_READMODE_FORWARD,
+                                prefixlength,
+                                1U, /* parts */
+                                0, /* maximumspace */
+                                &sfxstrategy,
+                                NULL, /* sfxprogress */
+                                false, /* withprogressbar */
+                                NULL, /* logger */
+                                err);
+  if (qsm->sfi == NULL)
+  {
+    gt_free(qsm);
+    return NULL;
+  }
+  /* with one part the complete suffix array is delivered at once and remains
+     valid until the iterator is deleted */
+  suffixsortspace = gt_Sfxiterator_next(&qsm->numberofsuffixes,NULL,qsm->sfi);
+  gt_assert(suffixsortspace != NULL);
+  qsm->suftab = (const ESASuffixptr *)
+                gt_suffixsortspace_ulong_get(suffixsortspace);
+  return qsm;
+}
+
+int gt_querysubstringmatcher_run(const GtQuerysubstringmatcher *qsm,
+                                 const GtUchar *query,
+                                 GtUword querylen,
+                                 GtUword minlength,
+                                 GtProcessquerymatch processquerymatch,
+                                 void *processquerymatchinfo,
+                                 GtError *err)
+{
+  GtQuerymatch *querymatchspaceptr;
+  GtQueryrep queryrep;
+  int had_err;
+
+  gt_assert(qsm != NULL && minlength > 0);
+  if (querylen < minlength)
+  {
+    return 0;
+  }
+  queryrep.sequence = query;
+  queryrep.reversecopy = false;
+  queryrep.encseq = NULL;
+  queryrep.readmode = GT_READMODE_FORWARD;
+  queryrep.startpos = 0;
+  queryrep.length = querylen;
+  querymatchspaceptr = gt_querymatch_new();
+  had_err = gt_querysubstringmatch_generic(false,
+                                           qsm->dbencseq,
+                                           qsm->suftab,
+                                           GT_READMODE_FORWARD,
+                                           qsm->numberofsuffixes,
+                                           0,
+                                           &queryrep,
+                                           minlength,
+                                           processquerymatch,
+                                           processquerymatchinfo,
+                                           querymatchspaceptr,
+                                           err);
+  gt_querymatch_delete(querymatchspaceptr);
+  return had_err;
+}
+
+void gt_querysubstringmatcher_delete(GtQuerysubstringmatcher *qsm)
+{
+  GT_UNUSED int rval;
+
+  if (qsm != NULL)
+  {
+    /* the suffix array is kept in memory, so deleting it cannot fail */
+    rval = gt_Sfxiterator_delete(qsm->sfi,NULL);
+    gt_assert(rval == 0);
+    gt_free(qsm);
+  }
+}
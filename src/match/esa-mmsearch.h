@@ -87,4 +87,30 @@ int gt_sarrquerysubstringmatch(const GtUchar *dbseq,
                                GtLogger *logger,
                                GtError *err);
 
+/* A <GtQuerysubstringmatcher> keeps the suffix array of an encoded sequence in
+   memory, such that the maximal exact matches of many queries can be computed
+   without constructing it again. Different queries can be matched by
+   different threads at the same time. */
+typedef struct GtQuerysubstringmatcher GtQuerysubstringmatcher;
+
+/* Returns a new <GtQuerysubstringmatcher> for the forward strand of
+   <dbencseq>, which must not be deleted before the returned object. Returns
+   NULL and sets <err> if the suffix array could not be constructed. */
+GtQuerysubstringmatcher *gt_querysubstringmatcher_new(const GtEncseq *dbencseq,
+                                                      GtError *err);
+
+/* Calls <processquerymatch> for all maximal exact matches of length at least
+   <minlength> between <query> (of length <querylen>, encoded like the
+   database sequence, with separators not allowed) and the database sequence of
+   <qsm>. */
+int gt_querysubstringmatcher_run(const GtQuerysubstringmatcher *qsm,
+                                 const GtUchar *query,
+                                 GtUword querylen,
+                                 GtUword minlength,
+                                 GtProcessquerymatch processquerymatch,
+                                 void *processquerymatchinfo,
+                                 GtError *err);
+
+void gt_querysubstringmatcher_delete(GtQuerysubstringmatcher *qsm);
+
 #endif
@@ -18,6 +18,8 @@
 #include <limits.h>
 #include "core/unused_api.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/thread_pool.h"
 #include "sarr-def.h"
 #include "esa-seqread.h"
 #include "esa-lcpval.h"
@@ -276,3 +278,168 @@ GtBcktab *gt_Sequentialsuffixarrayreader_bcktab(
 {
   return ssar->suffixarray->bcktab;
 }
+
+GtUword gt_Sequentialsuffixarrayreader_lcpranges(
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              GtUword numofparts,
+              GtUword *bounds)
+{
+  GtUword part, boundary, numofranges = 0;
+
+  gt_assert(ssar->seqactype == SEQ_mappedboth && numofparts > 0);
+  bounds[0] = 0;
+  for (part = 1UL; part < numofparts; part++)
+  {
+    boundary = part * (ssar->nonspecials / numofparts);
+    if (boundary <= bounds[numofranges])
+    {
+      boundary = bounds[numofranges] + 1;
+    }
+    while (boundary < ssar->nonspecials &&
+           lcptable_get(ssar->suffixarray,boundary) >= minlcp)
+    {
+      boundary++;
+    }
+    if (boundary >= ssar->nonspecials)
+    {
+      break;
+    }
+    bounds[++numofranges] = boundary;
+  }
+  bounds[++numofranges] = ssar->nonspecials;
+  return numofranges;
+}
+
+void gt_Sequentialsuffixarrayreader_init_range(
+              Sequentialsuffixarrayreader *rangessar,
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword start,
+              GtUword end)
+{
+  const Largelcpvalue *leftptr, *rightptr, *midptr;
+
+  gt_assert(ssar->seqactype == SEQ_mappedboth && start < end &&
+            end <= ssar->nonspecials);
+  *rangessar = *ssar;
+  rangessar->nextsuftabindex = start;
+  rangessar->nextlcptabindex = start + 1;
+  rangessar->nonspecials = end - start;
+  /* the first large lcp value at a position larger than start */
+  leftptr = ssar->suffixarray->llvtab;
+  rightptr = ssar->suffixarray->llvtab +
+             ssar->suffixarray->numoflargelcpvalues.valueunsignedlong;
+  while (leftptr < rightptr)
+  {
+    midptr = leftptr + GT_DIV2((GtUword) (rightptr - leftptr));
+    if (midptr->position <= start)
+    {
+      leftptr = midptr + 1;
+    } else
+    {
+      rightptr = midptr;
+    }
+  }
+  rangessar->largelcpindex
+    = (GtUword) (leftptr - ssar->suffixarray->llvtab);
+}
+
+/* The ranges are enumerated in rounds of LCPRANGESPERROUND * gt_jobs
+   consecutive ranges out of LCPRANGESPERTHREAD * gt_jobs ranges in total, so
+   that the threads are balanced without keeping the results of all ranges. */
+#define LCPRANGESPERTHREAD 32UL
+#define LCPRANGESPERROUND  4UL
+
+typedef struct
+{
+  Sequentialsuffixarrayreader *ssar;
+  const GtUword *bounds;
+  GtUword firstrange;
+  Lcprangeprocess rangeprocess;
+  void *data,
+       **rangestatetab;
+  GtError **errtab;
+  bool *haserrtab;
+} Lcprangesinfo;
+
+static void gt_Sequentialsuffixarrayreader_process_range(GtUword start,
+                                                         GtUword end,
+                                                         void *data)
+{
+  Lcprangesinfo *info = data;
+  Sequentialsuffixarrayreader rangessar;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+  {
+    gt_Sequentialsuffixarrayreader_init_range(&rangessar,
+                                          info->ssar,
+                                          info->bounds[info->firstrange+idx],
+                                          info->bounds[info->firstrange+idx+1]);
+    info->haserrtab[idx]
+      = info->rangeprocess(&rangessar,info->rangestatetab[idx],info->data,
+                           info->errtab[idx]) != 0 ? true : false;
+  }
+}
+
+int gt_Sequentialsuffixarrayreader_process_lcpranges(
+              Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              Lcprangestatenew rangestatenew,
+              Lcprangeprocess rangeprocess,
+              Lcprangestatedone rangestatedone,
+              void *data,
+              GtError *err)
+{
+  Lcprangesinfo info;
+  GtUword *bounds, numofranges, roundsize, idx;
+  bool haserr = false;
+
+  if (ssar->nonspecials == 0)
+  {
+    rangestatedone(data,rangestatenew(data));
+    return 0;
+  }
+  bounds = gt_malloc(sizeof *bounds * (LCPRANGESPERTHREAD * gt_jobs + 1));
+  numofranges = gt_Sequentialsuffixarrayreader_lcpranges(ssar,minlcp,
+                                                LCPRANGESPERTHREAD * gt_jobs,
+                                                bounds);
+  roundsize = LCPRANGESPERROUND * gt_jobs;
+  info.ssar = ssar;
+  info.bounds = bounds;
+  info.rangeprocess = rangeprocess;
+  info.data = data;
+  info.rangestatetab = gt_malloc(sizeof *info.rangestatetab * roundsize);
+  info.errtab = gt_malloc(sizeof *info.errtab * roundsize);
+  info.haserrtab = gt_malloc(sizeof *info.haserrtab * roundsize);
+  for (info.firstrange = 0;
+       !haserr && info.firstrange < numofranges;
+       info.firstrange += roundsize)
+  {
+    GtUword numinround = MIN(roundsize, numofranges - info.firstrange);
+
+    for (idx = 0; idx < numinround; idx++)
+    {
+      info.rangestatetab[idx] = rangestatenew(data);
+      info.errtab[idx] = gt_error_new();
+    }
+    gt_thread_pool_parallel_for(gt_thread_pool_get(),0,numinround,1UL,
+                                gt_Sequentialsuffixarrayreader_process_range,
+                                &info);
+    for (idx = 0; idx < numinround; idx++)
+    {
+      if (!haserr && info.haserrtab[idx])
+      {
+        gt_error_set(err,"%s",gt_error_get(info.errtab[idx]));
+        haserr = true;
+      }
+      rangestatedone(data,info.rangestatetab[idx]);
+      gt_error_delete(info.errtab[idx]);
+    }
+  }
+  gt_free(info.haserrtab);
+  gt_free(info.errtab);
+  gt_free(info.rangestatetab);
+  gt_free(bounds);
+  return haserr ? -1 : 0;
+}
@@ -308,4 +308,57 @@ unsigned int gt_Sequentialsuffixarrayreader_prefixlength(
 GtBcktab *gt_Sequentialsuffixarrayreader_bcktab(
               const Sequentialsuffixarrayreader *ssar);
 
+/* Split the nonspecial suffixes of the mapped <ssar> into at most <numofparts>
+   ranges of roughly equal size, such that no lcp-interval of depth at least
+   <minlcp> spans two ranges. The ranges are stored in <bounds>, which must
+   have <numofparts> + 1 entries: range <i> consists of the suffixes from
+   <bounds[i]> to <bounds[i+1]> - 1. Returns the number of ranges. */
+GtUword gt_Sequentialsuffixarrayreader_lcpranges(
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              GtUword numofparts,
+              GtUword *bounds);
+
+/* Initialize <rangessar> such that it delivers the suffixes from <start> to
+   <end> - 1 of the mapped <ssar>, and the lcp values from <start> + 1 to <end>,
+   as if they were the only nonspecial suffixes. <rangessar> shares the
+   tables of <ssar> and must not be freed. */
+void gt_Sequentialsuffixarrayreader_init_range(
+              Sequentialsuffixarrayreader *rangessar,
+              const Sequentialsuffixarrayreader *ssar,
+              GtUword start,
+              GtUword end);
+
+/* Return the state in which a range of suffixes is processed. <data> is the
+   pointer given to <gt_Sequentialsuffixarrayreader_process_lcpranges()>. */
+typedef void *(*Lcprangestatenew)(void *data);
+
+/* Process the range of suffixes delivered by <rangessar> in <rangestate>.
+   Called in parallel for different ranges, so <data> must only be read. */
+typedef int (*Lcprangeprocess)(Sequentialsuffixarrayreader *rangessar,
+                               void *rangestate,
+                               void *data,
+                               GtError *err);
+
+/* Finish and free the <rangestate> of a range after it has been processed. */
+typedef void (*Lcprangestatedone)(void *data,void *rangestate);
+
+/* Split the nonspecial suffixes of the mapped <ssar> into ranges with
+   <gt_Sequentialsuffixarrayreader_lcpranges()> and process them with
+   <rangeprocess> in parallel by the global thread pool, each in its own state
+   created by <rangestatenew>. Only the states of a few ranges per thread are
+   kept at a time. <rangestatedone> is called for every state in the order of
+   the ranges, so that the results collected per range can be reported in the
+   order of a single traversal; if there are no nonspecial suffixes, it is
+   called once for an empty range. Returns 0 on success and -1 if processing
+   a range failed, in which case <err> is set. */
+int gt_Sequentialsuffixarrayreader_process_lcpranges(
+              Sequentialsuffixarrayreader *ssar,
+              GtUword minlcp,
+              Lcprangestatenew rangestatenew,
+              Lcprangeprocess rangeprocess,
+              Lcprangestatedone rangestatedone,
+              void *data,
+              GtError *err);
+
 #endif
@@ -1362,7 +1362,7 @@ bool gt_indexbasedexactpatternmatching(const Limdfsresources *limdfsresources,
                                     pattern,
                                     patternlength,
                                     limdfsresources->genericindex->totallength,
-                                    limdfsresources->currentpathspace,
+                                    pattern,
                                     limdfsresources->processmatch,
                                     limdfsresources->processmatchinfo);
   }
@@ -15,23 +15,31 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/chardef.h"
 #include "core/types_api.h"
 #include "core/encseq.h"
 #include "core/defined-types.h"
 #include "core/ma_api.h"
+#include "core/minmax.h"
+#include "extended/edist_myers.h"
 #include "myersapm.h"
 #include "procmatch.h"
 #include "dist-short.h"
-#include "initeqsvec.h"
+
+/* the number of characters decoded from the encoded sequence at once */
+#define MYERSAPM_CHUNKSIZE ((GtUword) 1 << 20)
 
 struct Myersonlineresources
 {
   GtEncseqReader *esr;
   const GtEncseq *encseq;
   GtUword totallength;
-  GtUword *eqsvectorrev,
-                *eqsvector;
+  GtUword *eqsvector;
+  GtUchar *textbuffer,
+          *patternrev;
+  GtUword textbuffersize,
+          patternrevsize;
   unsigned int alphasize;
   bool nowildcards;
   ProcessIdxMatch processmatch;
@@ -47,8 +55,11 @@ Myersonlineresources *gt_newMyersonlineresources(unsigned int numofchars,
   Myersonlineresources *mor;
 
   mor = gt_malloc(sizeof *mor);
-  mor->eqsvectorrev = gt_malloc(sizeof *mor->eqsvectorrev * numofchars);
   mor->eqsvector = gt_malloc(sizeof *mor->eqsvector * numofchars);
+  mor->textbuffer = NULL;
+  mor->textbuffersize = 0;
+  mor->patternrev = NULL;
+  mor->patternrevsize = 0;
   mor->encseq = encseq;
   mor->esr = gt_encseq_create_reader_with_readmode(encseq, GT_READMODE_REVERSE,
                                                    0);
@@ -65,109 +76,119 @@ void gt_freeMyersonlineresources(Myersonlineresources *ptrmyersonlineresources)
 {
   if (ptrmyersonlineresources != NULL)
   {
-    gt_free(ptrmyersonlineresources->eqsvectorrev);
     gt_free(ptrmyersonlineresources->eqsvector);
+    gt_free(ptrmyersonlineresources->textbuffer);
+    gt_free(ptrmyersonlineresources->patternrev);
     gt_encseq_reader_delete(ptrmyersonlineresources->esr);
     gt_free(ptrmyersonlineresources);
   }
 }
 
+typedef struct
+{
+  Myersonlineresources *mor;
+  const GtUchar *pattern;
+  GtUword patternlength,
+          maxdistance,
+          bufferpos; /* the position of the text buffer in the reversed
+                        sequence */
+  GtIdxMatch match;
+} Myersapmmatchinfo;
+
+static void myersapm_processmatch(void *info,GtUword endpos,GtUword score)
+{
+  Myersapmmatchinfo *mai = info;
+  Myersonlineresources *mor = mai->mor;
+  GtUword dbstartpos = GT_REVERSEPOS(mor->totallength,mai->bufferpos + endpos);
+  Definedunsignedlong matchlength;
+
+  if (mai->maxdistance > 0)
+  {
+    matchlength = gt_forwardprefixmatch(mor->encseq,
+                                     mor->alphasize,
+                                     dbstartpos,
+                                     mor->nowildcards,
+                                     mor->eqsvector,
+                                     mai->pattern,
+                                     mai->patternlength,
+                                     mai->maxdistance);
+  } else
+  {
+    matchlength.defined = true;
+    matchlength.valueunsignedlong = mai->patternlength;
+  }
+  gt_assert(matchlength.defined || mor->nowildcards);
+  if (matchlength.defined)
+  {
+    mai->match.dbstartpos = dbstartpos;
+    mai->match.dblen = (GtUword) matchlength.valueunsignedlong;
+    mai->match.distance = score;
+    mor->processmatch(mor->processmatchinfo,&mai->match);
+  }
+}
+
+/* The reversed sequence is decoded in chunks, which are searched for the
+   reversed pattern with the bit-parallel engine. Every chunk is preceded by
+   the last <patternlength> + <maxdistance> characters of the previous one,
+   which suffice to compute the scores of the chunk exactly. */
 void gt_edistmyersbitvectorAPM(Myersonlineresources *mor,
                                const GtUchar *pattern,
                                GtUword patternlength,
                                GtUword maxdistance)
 {
-  GtUword Pv = ~0UL,
-                Mv = 0UL,
-                Eq,
-                Xv,
-                Xh,
-                Ph,
-                Mh,
-                score;
-  const GtUword Ebit = 1UL << (patternlength-1);
-  GtUchar cc;
-  GtUword pos;
   const GtReadmode readmode = GT_READMODE_REVERSE;
-  GtIdxMatch match;
+  const GtUword overlap = patternlength + maxdistance;
+  GtEdistMyers *edistmyers;
+  Myersapmmatchinfo mai;
+  GtUword pos, idx, context = 0;
 
-  gt_initeqsvectorrev(mor->eqsvectorrev,
-                   (GtUword) mor->alphasize,
-                   pattern,patternlength);
-  score = patternlength;
+  if (patternlength > mor->patternrevsize)
+  {
+    mor->patternrevsize = patternlength;
+    mor->patternrev = gt_realloc(mor->patternrev,
+                                 sizeof *mor->patternrev * patternlength);
+  }
+  for (idx = 0; idx < patternlength; idx++)
+  {
+    gt_assert(pattern[idx] != (GtUchar) SEPARATOR);
+    mor->patternrev[idx] = pattern[patternlength - 1 - idx];
+  }
+  if (overlap + MYERSAPM_CHUNKSIZE > mor->textbuffersize)
+  {
+    mor->textbuffersize = overlap + MYERSAPM_CHUNKSIZE;
+    mor->textbuffer = gt_realloc(mor->textbuffer,
+                                 sizeof *mor->textbuffer *
+                                 mor->textbuffersize);
+  }
+  edistmyers = gt_edist_myers_new(mor->patternrev,patternlength,
+                                  (GtUword) mor->alphasize);
   gt_encseq_reader_reinit_with_readmode(mor->esr, mor->encseq, readmode, 0);
-  match.dbabsolute = NULL;
-  match.dbsubstring = NULL;
-  match.querystartpos = 0;
-  match.querylen = patternlength;
-  match.alignment = NULL;
-  for (pos = 0; pos < mor->totallength; pos++)
+  mai.mor = mor;
+  mai.pattern = pattern;
+  mai.patternlength = patternlength;
+  mai.maxdistance = maxdistance;
+  mai.match.dbabsolute = NULL;
+  mai.match.dbsubstring = NULL;
+  mai.match.querystartpos = 0;
+  mai.match.querylen = patternlength;
+  mai.match.alignment = NULL;
+  for (pos = 0; pos < mor->totallength; /* Nothing */)
   {
-    cc = gt_encseq_reader_next_encoded_char(mor->esr);
-    if (cc == (GtUchar) SEPARATOR)
-    {
-      Pv = ~0UL;
-      Mv = 0UL;
-      score = patternlength;
-    } else
-    {
-      if (cc == (GtUchar) WILDCARD)
-      {
-        Eq = 0;
-      } else
-      {
-        Eq = mor->eqsvectorrev[(GtUword) cc];   /*  6 */
-      }
-      Xv = Eq | Mv;                                   /*  7 */
-      Xh = (((Eq & Pv) + Pv) ^ Pv) | Eq;              /*  8 */
-
-      Ph = Mv | ~ (Xh | Pv);                          /*  9 */
-      Mh = Pv & Xh;                                   /* 10 */
+    GtUword chunklength = MIN(MYERSAPM_CHUNKSIZE, mor->totallength - pos);
 
-      if (Ph & Ebit)
-      {
-        score++;
-      } else
-      {
-        if (Mh & Ebit)
-        {
-          gt_assert(score > 0);
-          score--;
-        }
-      }
-
-      Ph <<= 1;                                       /* 15 */
-      Pv = (Mh << 1) | ~ (Xv | Ph);                   /* 17 */
-      Mv = Ph & Xv;                                   /* 18 */
-      if (score <= maxdistance)
-      {
-        GtUword dbstartpos = GT_REVERSEPOS(mor->totallength,pos);
-        Definedunsignedlong matchlength;
-
-        if (maxdistance > 0)
-        {
-          matchlength = gt_forwardprefixmatch(mor->encseq,
-                                           mor->alphasize,
-                                           dbstartpos,
-                                           mor->nowildcards,
-                                           mor->eqsvector,
-                                           pattern,
-                                           patternlength,
-                                           maxdistance);
-        } else
-        {
-          matchlength.defined = true;
-          matchlength.valueunsignedlong = patternlength;
-        }
-        gt_assert(matchlength.defined || mor->nowildcards);
-        if (matchlength.defined)
-        {
-          match.dbstartpos = dbstartpos;
-          match.dblen = (GtUword) matchlength.valueunsignedlong;
-          match.distance = score;
-          mor->processmatch(mor->processmatchinfo,&match);
-        }
-      }
+    for (idx = 0; idx < chunklength; idx++)
+    {
+      mor->textbuffer[context + idx]
+        = gt_encseq_reader_next_encoded_char(mor->esr);
     }
+    mai.bufferpos = pos - context;
+    gt_edist_myers_apm(edistmyers,mor->textbuffer,context + chunklength,
+                       context,maxdistance,myersapm_processmatch,&mai);
+    pos += chunklength;
+    idx = MIN(overlap,context + chunklength);
+    memmove(mor->textbuffer,mor->textbuffer + context + chunklength - idx,
+            (size_t) idx);
+    context = idx;
   }
+  gt_edist_myers_delete(edistmyers);
 }
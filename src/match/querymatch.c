@@ -15,7 +15,9 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <stdio.h>
 #include "core/ma_api.h"
+#include "core/str_api.h"
 #include "core/unused_api.h"
 #include "core/types_api.h"
 #include "core/readmode.h"
@@ -127,15 +129,20 @@ GtUword gt_querymatch_dbseqnum(const GtEncseq *encseq,
   return gt_encseq_seqnum(encseq,querymatch->dbstart);
 }
 
-int gt_querymatch_output(GT_UNUSED void *info,
-                         const GtEncseq *encseq,
-                         const GtQuerymatch *querymatch,
-                         GT_UNUSED const GtUchar *query,
-                         GtUword query_totallength,
-                         GT_UNUSED GtError *err)
+/* Maximal length of the line describing a match */
+#define GT_QUERYMATCH_LINELENGTH 256
+
+/* Write the line describing <querymatch> to <line> and return its length.
+   Self matches reported with exchanged positions are skipped, in which case
+   0 is returned. */
+static size_t gt_querymatch_line(char *line,
+                                 const GtEncseq *encseq,
+                                 const GtQuerymatch *querymatch,
+                                 GtUword query_totallength)
 {
   const char *outflag = "FRCP";
   GtUword dbseqnum, querystart, dbstart_relative, seqstartpos;
+  int len;
 
   gt_assert(encseq != NULL);
   dbseqnum = gt_querymatch_dbseqnum(encseq,querymatch);
@@ -154,42 +161,79 @@ int gt_querymatch_output(GT_UNUSED void *info,
   }
   gt_assert(querymatch->dbstart >= seqstartpos);
   dbstart_relative = querymatch->dbstart - seqstartpos;
-  if (!querymatch->selfmatch ||
-      (uint64_t) dbseqnum != querymatch->queryseqnum ||
-      dbstart_relative <= querystart)
+  if (querymatch->selfmatch &&
+      (uint64_t) dbseqnum == querymatch->queryseqnum &&
+      dbstart_relative > querystart)
   {
+    return 0;
+  }
 #ifdef VERIFY
-    verifymatch(encseq,
-                querymatch->len,
-                querymatch->dbstart,
-                querymatch->queryseqnum,
-                querystart,
-                querymatch->readmode);
+  verifymatch(encseq,
+              querymatch->len,
+              querymatch->dbstart,
+              querymatch->queryseqnum,
+              querystart,
+              querymatch->readmode);
 #endif
-    printf(""GT_WU" "GT_WU" "GT_WU" %c "GT_WU" " Formatuint64_t " "GT_WU"",
-           querymatch->dblen,
-           dbseqnum,
-           dbstart_relative,
-           outflag[querymatch->readmode],
-           querymatch->querylen,
-           PRINTuint64_tcast(querymatch->queryseqnum),
-           querystart);
-    if (querymatch->score > 0)
-    {
-      double similarity = querymatch->edist == 0
-        ? 100.0
-        : 100.0 * (1.0 - querymatch->edist/
-                         (double) MIN(querymatch->dblen,querymatch->querylen));
-      printf(" " GT_WD " " GT_WU " %.2f\n",
-             querymatch->score,querymatch->edist,similarity);
-    } else
-    {
-      printf("\n");
-    }
+  len = snprintf(line,GT_QUERYMATCH_LINELENGTH,
+                 ""GT_WU" "GT_WU" "GT_WU" %c "GT_WU" " Formatuint64_t " "GT_WU"",
+                 querymatch->dblen,
+                 dbseqnum,
+                 dbstart_relative,
+                 outflag[querymatch->readmode],
+                 querymatch->querylen,
+                 PRINTuint64_tcast(querymatch->queryseqnum),
+                 querystart);
+  gt_assert(len > 0 && len < GT_QUERYMATCH_LINELENGTH);
+  if (querymatch->score > 0)
+  {
+    double similarity = querymatch->edist == 0
+      ? 100.0
+      : 100.0 * (1.0 - querymatch->edist/
+                       (double) MIN(querymatch->dblen,querymatch->querylen));
+    len += snprintf(line + len,(size_t) (GT_QUERYMATCH_LINELENGTH - len),
+                    " " GT_WD " " GT_WU " %.2f\n",
+                    querymatch->score,querymatch->edist,similarity);
+  } else
+  {
+    len += snprintf(line + len,(size_t) (GT_QUERYMATCH_LINELENGTH - len),
+                    "\n");
+  }
+  gt_assert(len < GT_QUERYMATCH_LINELENGTH);
+  return (size_t) len;
+}
+
+int gt_querymatch_output(GT_UNUSED void *info,
+                         const GtEncseq *encseq,
+                         const GtQuerymatch *querymatch,
+                         GT_UNUSED const GtUchar *query,
+                         GtUword query_totallength,
+                         GT_UNUSED GtError *err)
+{
+  char line[GT_QUERYMATCH_LINELENGTH];
+
+  if (gt_querymatch_line(line,encseq,querymatch,query_totallength) > 0)
+  {
+    fputs(line,stdout);
   }
   return 0;
 }
 
+void gt_querymatch_output_str(GtStr *outbuffer,
+                              const GtEncseq *encseq,
+                              const GtQuerymatch *querymatch,
+                              GtUword query_totallength)
+{
+  char line[GT_QUERYMATCH_LINELENGTH];
+  size_t len;
+
+  len = gt_querymatch_line(line,encseq,querymatch,query_totallength);
+  if (len > 0)
+  {
+    gt_str_append_cstr_nt(outbuffer,line,(GtUword) len);
+  }
+}
+
 GtUword gt_querymatch_querylen(const GtQuerymatch *querymatch)
 {
   return querymatch->querylen;
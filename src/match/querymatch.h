@@ -22,6 +22,7 @@
 #include "core/error_api.h"
 #include "core/readmode.h"
 #include "core/encseq.h"
+#include "core/str_api.h"
 
 typedef struct GtQuerymatch GtQuerymatch;
 
@@ -48,6 +49,13 @@ int gt_querymatch_output(void *info,
                          GtUword query_totallength,
                          GtError *err);
 
+/* Append the line which <gt_querymatch_output()> shows for <querymatch> to
+   <outbuffer>. */
+void gt_querymatch_output_str(GtStr *outbuffer,
+                              const GtEncseq *encseq,
+                              const GtQuerymatch *querymatch,
+                              GtUword query_totallength);
+
 GtUword gt_querymatch_querylen(const GtQuerymatch *querymatch);
 
 GtUword gt_querymatch_dbstart(const GtQuerymatch *querymatch);
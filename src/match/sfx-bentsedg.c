@@ -24,6 +24,8 @@
 #include "core/arraydef.h"
 #include "core/unused_api.h"
 #include "core/types_api.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/encseq.h"
 #include "bcktab.h"
 #include "kmer2string.h"
@@ -1521,6 +1523,181 @@ static void bentsedgresources_delete(GtBentsedgresources *bsr, GtLogger *logger)
   gt_logger_log(logger,"counttqsort="GT_WU"",bsr->counttqsort);
 }
 
+static void bentsedgresources_radixsort_init(GtBentsedgresources *bsr,
+                                             const GtBcktab *bcktab)
+{
+  if (bsr->sfxstrategy->withradixsort &&
+      gt_encseq_accesstype_get(bsr->encseq) == GT_ACCESS_TYPE_EQUALLENGTH &&
+      bsr->readmode == GT_READMODE_FORWARD)
+  {
+    bsr->rsi = gt_radixsort_str_new(bsr->twobitencoding,
+                                    gt_encseq_is_mirrored(bsr->encseq)
+                                      ? GT_DIV2(bsr->totallength - 1)
+                                      : bsr->totallength,
+                                    1 + gt_encseq_equallength(bsr->encseq),
+                                    gt_bcktab_nonspecialsmaxsize(bcktab));
+    bsr->radixsortmaxwidth = gt_radixsort_str_maxwidth(bsr->rsi);
+  }
+}
+
+unsigned int gt_sortallbuckets_numofthreads(GT_UNUSED bool withlcps,
+                                            GT_UNUSED bool
+                                              withprocessunsortedsuffixrange)
+{
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && !withlcps && !withprocessunsortedsuffixrange)
+  {
+    return gt_jobs;
+  }
+#endif
+  return 1U;
+}
+
+#ifdef GT_THREADS_ENABLED
+typedef struct
+{
+  GtBentsedgresources *bsrtab;
+  GtUint64 *bucketitersteptab;
+  unsigned int *freebsrstack,
+               numoffreebsr,
+               numofchars,
+               prefixlength;
+  GtMutex *mutex;
+  GtBucketspec2 *bucketspec2;
+  const GtBcktab *bcktab;
+  GtCodetype maxcode;
+  GtUword numberofsuffixes;
+} GtSortallbucketsthreadinfo;
+
+/* sorts the buckets with codes from <start> to <end> - 1 using the resources
+   which are currently not used by another thread */
+static void gt_sortallbuckets_range(GtUword start, GtUword end, void *data)
+{
+  GtSortallbucketsthreadinfo *threadinfo = data;
+  GtBentsedgresources *bsr;
+  GtBucketspecification bucketspec;
+  GtCodetype code;
+  unsigned int bsridx;
+
+  gt_mutex_lock(threadinfo->mutex);
+  gt_assert(threadinfo->numoffreebsr > 0);
+  bsridx = threadinfo->freebsrstack[--threadinfo->numoffreebsr];
+  gt_mutex_unlock(threadinfo->mutex);
+  bsr = threadinfo->bsrtab + bsridx;
+  for (code = (GtCodetype) start; code < (GtCodetype) end; code++)
+  {
+    if (threadinfo->bucketspec2 != NULL &&
+        !gt_copysort_checkhardwork(threadinfo->bucketspec2,code))
+    {
+      continue;
+    }
+    threadinfo->bucketitersteptab[bsridx]++;
+    (void) gt_bcktab_calcboundsparts(&bucketspec,
+                                     threadinfo->bcktab,
+                                     code,
+                                     threadinfo->maxcode,
+                                     threadinfo->numberofsuffixes,
+                                     (unsigned int)
+                                     (code % threadinfo->numofchars));
+    if (bucketspec.nonspecialsinbucket > 1UL)
+    {
+      gt_suffixsortspace_bucketleftidx_set(bsr->sssp,bucketspec.left);
+      gt_sort_bentleysedgewick(bsr,bucketspec.nonspecialsinbucket,
+                               (GtUword) threadinfo->prefixlength);
+      gt_suffixsortspace_bucketleftidx_set(bsr->sssp,0);
+    }
+  }
+  gt_mutex_lock(threadinfo->mutex);
+  threadinfo->freebsrstack[threadinfo->numoffreebsr++] = bsridx;
+  gt_mutex_unlock(threadinfo->mutex);
+}
+
+/* The buckets are independent of each other, so they are distributed over
+   the threads of the process-wide thread pool. Every thread sorts using its
+   own resources and its own view of <suffixsortspace>. As the lcp-values
+   have to be delivered in the order of the buckets, this is only used if no
+   lcp-values are computed. */
+static void gt_sortallbuckets_threaded(GtSuffixsortspace *suffixsortspace,
+                                       GtUword numberofsuffixes,
+                                       GtBucketspec2 *bucketspec2,
+                                       const GtEncseq *encseq,
+                                       GtReadmode readmode,
+                                       GtCodetype mincode,
+                                       GtCodetype maxcode,
+                                       const GtBcktab *bcktab,
+                                       unsigned int numofchars,
+                                       unsigned int prefixlength,
+                                       unsigned int sortmaxdepth,
+                                       const Sfxstrategy *sfxstrategy,
+                                       GtUint64 *bucketiterstep,
+                                       GtLogger *logger)
+{
+  GtThreadPool *pool = gt_thread_pool_get();
+  GtSortallbucketsthreadinfo threadinfo;
+  GtUword grainsize;
+  unsigned int idx, numofbsr = gt_thread_pool_size(pool);
+
+  threadinfo.bsrtab = gt_malloc(sizeof (*threadinfo.bsrtab) * numofbsr);
+  threadinfo.bucketitersteptab
+    = gt_calloc((size_t) numofbsr, sizeof (*threadinfo.bucketitersteptab));
+  threadinfo.freebsrstack
+    = gt_malloc(sizeof (*threadinfo.freebsrstack) * numofbsr);
+  for (idx = 0; idx < numofbsr; idx++)
+  {
+    bentsedgresources_init(threadinfo.bsrtab + idx,
+                           gt_suffixsortspace_view_new(suffixsortspace),
+                           encseq,
+                           readmode,
+                           prefixlength,
+                           sortmaxdepth,
+                           sfxstrategy,
+                           false);
+    bentsedgresources_radixsort_init(threadinfo.bsrtab + idx,bcktab);
+    threadinfo.freebsrstack[idx] = idx;
+  }
+  threadinfo.numoffreebsr = numofbsr;
+  threadinfo.numofchars = numofchars;
+  threadinfo.prefixlength = prefixlength;
+  threadinfo.mutex = gt_mutex_new();
+  threadinfo.bucketspec2 = bucketspec2;
+  threadinfo.bcktab = bcktab;
+  threadinfo.maxcode = maxcode;
+  threadinfo.numberofsuffixes = numberofsuffixes;
+  /* many small ranges balance the load, as the bucket sizes vary a lot */
+  grainsize = (GtUword) (maxcode - mincode + 1) / (64UL * numofbsr);
+  gt_thread_pool_parallel_for(pool,
+                              (GtUword) mincode,
+                              (GtUword) maxcode + 1,
+                              grainsize > 0 ? grainsize : 1UL,
+                              gt_sortallbuckets_range,
+                              &threadinfo);
+  gt_assert(threadinfo.numoffreebsr == numofbsr);
+  gt_mutex_delete(threadinfo.mutex);
+  for (idx = 0; idx < numofbsr; idx++)
+  {
+    GtBentsedgresources *bsr = threadinfo.bsrtab + idx;
+
+    *bucketiterstep += threadinfo.bucketitersteptab[idx];
+    gt_suffixsortspace_view_delete(bsr->sssp,suffixsortspace);
+    if (idx > 0)
+    {
+      threadinfo.bsrtab[0].countinsertionsort += bsr->countinsertionsort;
+      threadinfo.bsrtab[0].countbltriesort += bsr->countbltriesort;
+      threadinfo.bsrtab[0].countcountingsort += bsr->countcountingsort;
+      threadinfo.bsrtab[0].countshortreadsort += bsr->countshortreadsort;
+      threadinfo.bsrtab[0].countradixsort += bsr->countradixsort;
+      threadinfo.bsrtab[0].counttqsort += bsr->counttqsort;
+      bentsedgresources_delete(bsr, NULL);
+    }
+  }
+  gt_logger_log(logger,"sorted buckets using %u threads",numofbsr);
+  bentsedgresources_delete(threadinfo.bsrtab, logger);
+  gt_free(threadinfo.bsrtab);
+  gt_free(threadinfo.bucketitersteptab);
+  gt_free(threadinfo.freebsrstack);
+}
+#endif
+
 /*
   The following function is called in sfx-suffixer.c and sorts all buckets by
   different suffix comparison methods without the help of other sorting
@@ -1551,6 +1728,30 @@ void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
   GtBucketspecification bucketspec;
   GtBentsedgresources bsr;
 
+  gt_bcktab_determinemaxsize(bcktab, mincode, maxcode, numberofsuffixes);
+#ifdef GT_THREADS_ENABLED
+  if (mincode < maxcode &&
+      gt_sortallbuckets_numofthreads(outlcpinfo != NULL ? true : false,
+                                     processunsortedsuffixrange != NULL
+                                       ? true : false) > 1U)
+  {
+    gt_sortallbuckets_threaded(suffixsortspace,
+                               numberofsuffixes,
+                               bucketspec2,
+                               encseq,
+                               readmode,
+                               mincode,
+                               maxcode,
+                               bcktab,
+                               numofchars,
+                               prefixlength,
+                               sortmaxdepth,
+                               sfxstrategy,
+                               bucketiterstep,
+                               logger);
+    return;
+  }
+#endif
   bentsedgresources_init(&bsr,
                          suffixsortspace,
                          encseq,
@@ -1559,19 +1760,7 @@ void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                          sortmaxdepth,
                          sfxstrategy,
                          outlcpinfo != NULL ? true : false);
-  gt_bcktab_determinemaxsize(bcktab, mincode, maxcode, numberofsuffixes);
-  if (bsr.sfxstrategy->withradixsort &&
-      gt_encseq_accesstype_get(bsr.encseq) == GT_ACCESS_TYPE_EQUALLENGTH &&
-      bsr.readmode == GT_READMODE_FORWARD)
-  {
-    bsr.rsi = gt_radixsort_str_new(bsr.twobitencoding,
-                                   gt_encseq_is_mirrored(encseq)
-                                     ? GT_DIV2(bsr.totallength - 1)
-                                     : bsr.totallength,
-                                   1 + gt_encseq_equallength(bsr.encseq),
-                                   gt_bcktab_nonspecialsmaxsize(bcktab));
-    bsr.radixsortmaxwidth = gt_radixsort_str_maxwidth(bsr.rsi);
-  }
+  bentsedgresources_radixsort_init(&bsr,bcktab);
   if (outlcpinfo != NULL)
   {
     bsr.tableoflcpvalues = gt_Outlcpinfo_resizereservoir(outlcpinfo,bcktab);
@@ -54,6 +54,13 @@ void gt_sortallbuckets(GtSuffixsortspace *suffixsortspace,
                        GtUint64 *bucketiterstep,
                        GtLogger *logger);
 
+/* Returns the number of threads used by <gt_sortallbuckets()>. The buckets
+   are sorted concurrently by <gt_jobs> threads, unless lcp-values are computed
+   or unsorted suffix ranges are processed. */
+unsigned int gt_sortallbuckets_numofthreads(bool withlcps,
+                                            bool
+                                              withprocessunsortedsuffixrange);
+
 void gt_sortallsuffixesfromstart(GtSuffixsortspace *suffixsortspace,
                                  GtUword numberofsuffixes,
                                  const GtEncseq *encseq,
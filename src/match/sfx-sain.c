@@ -20,6 +20,8 @@
 #include "core/unused_api.h"
 #include "core/timer_api.h"
 #include "core/mathsupport.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "sfx-linlcp.h"
 #include "sfx-sain.h"
 
@@ -431,6 +433,353 @@ static void gt_sain_induceStypes2fromspecialranges(
 
 #include "match/sfx-sain.inc"
 
+#ifdef GT_THREADS_ENABLED
+/* Sequences with fewer entries to sort are always sorted by one thread. */
+#define GT_SAIN_THREADED_MINENTRIES  (1UL << 16)
+/* Number of suftab entries processed by one thread in one step of the
+   parallel induced sorting or naming. A multiple of the word size. */
+#define GT_SAIN_THREADED_BLOCKSIZE   (1UL << 14)
+
+static bool gt_sain_threaded(GtUword entries)
+{
+  return gt_jobs > 1U && entries >= GT_SAIN_THREADED_MINENTRIES ? true : false;
+}
+
+/* The induced sorting scans suftab and, for each entry, moves the preceding
+   suffix into its bucket. The character accesses for the next block of
+   entries are done in parallel and cached in a <GtSaininduceinfo>, then the
+   block is scanned sequentially. Entries written into the block during the
+   scan are not cached, they are detected by comparing the position. */
+typedef struct
+{
+  GtWord position, putvalue;
+  GtUword currentcc;
+} GtSaininduceinfo;
+
+typedef struct
+{
+  const GtSainseq *sainseq;
+  const GtWord *suftab;
+  GtSaininduceinfo *induceinfo;
+  GtUword blockstart;
+  bool Ltype;
+} GtSaininducethreadinfo;
+
+static void gt_sain_induceinfo_set(const GtSainseq *sainseq,
+                                   GtSaininduceinfo *induceinfo,
+                                   GtWord position,
+                                   bool Ltype)
+{
+  induceinfo->position = position;
+  if (position > 0)
+  {
+    position--;
+    induceinfo->currentcc = gt_sainseq_getchar(sainseq,(GtUword) position);
+    if (induceinfo->currentcc < sainseq->numofchars)
+    {
+      if (Ltype)
+      {
+        induceinfo->putvalue
+          = (position > 0 &&
+             gt_sainseq_getchar(sainseq,(GtUword) (position-1))
+               < induceinfo->currentcc) ? ~position : position;
+      } else
+      {
+        induceinfo->putvalue
+          = (position == 0 ||
+             gt_sainseq_getchar(sainseq,(GtUword) (position-1))
+               > induceinfo->currentcc) ? ~position : position;
+      }
+    }
+  }
+}
+
+static void gt_sain_induce_prepare(GtUword start, GtUword end, void *data)
+{
+  GtSaininducethreadinfo *threadinfo = data;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+  {
+    gt_sain_induceinfo_set(threadinfo->sainseq,
+                           threadinfo->induceinfo + idx -
+                           threadinfo->blockstart,
+                           threadinfo->suftab[idx],
+                           threadinfo->Ltype);
+  }
+}
+
+static GtUword gt_sain_threaded_blocksize(void)
+{
+  return GT_SAIN_THREADED_BLOCKSIZE * gt_jobs;
+}
+
+static void gt_sain_threaded_induceLtypesuffixes2(const GtSainseq *sainseq,
+                                                  GtWord *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, blockstart, *fillptr = sainseq->bucketfillptr;
+  const GtUword blocksize = gt_sain_threaded_blocksize();
+  GtWord *bucketptr = NULL;
+  GtThreadPool *pool = gt_thread_pool_get();
+  GtSaininducethreadinfo threadinfo;
+
+  threadinfo.sainseq = sainseq;
+  threadinfo.suftab = suftab;
+  threadinfo.induceinfo = gt_malloc(sizeof (*threadinfo.induceinfo) *
+                                    blocksize);
+  threadinfo.Ltype = true;
+  for (blockstart = 0; blockstart < nonspecialentries; blockstart += blocksize)
+  {
+    GtUword idx, blockend = MIN(blockstart + blocksize,nonspecialentries);
+
+    threadinfo.blockstart = blockstart;
+    gt_thread_pool_parallel_for(pool,blockstart,blockend,
+                                GT_SAIN_THREADED_BLOCKSIZE,
+                                gt_sain_induce_prepare,&threadinfo);
+    for (idx = blockstart; idx < blockend; idx++)
+    {
+      GtWord position = suftab[idx];
+
+      suftab[idx] = ~position;
+      if (position > 0)
+      {
+        GtSaininduceinfo *induceinfo = threadinfo.induceinfo + idx -
+                                       blockstart;
+        GtUword currentcc;
+
+        if (induceinfo->position != position)
+        {
+          gt_sain_induceinfo_set(sainseq,induceinfo,position,true);
+        }
+        currentcc = induceinfo->currentcc;
+        if (currentcc < sainseq->numofchars)
+        {
+          gt_assert(currentcc > 0);
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && suftab + idx < bucketptr);
+          *bucketptr++ = induceinfo->putvalue;
+        }
+      }
+    }
+  }
+  gt_free(threadinfo.induceinfo);
+}
+
+static void gt_sain_threaded_induceStypesuffixes2(const GtSainseq *sainseq,
+                                                  GtWord *suftab,
+                                                  GtUword nonspecialentries)
+{
+  GtUword lastupdatecc = 0, blockstart, blockend,
+          *fillptr = sainseq->bucketfillptr;
+  const GtUword blocksize = gt_sain_threaded_blocksize();
+  GtWord *bucketptr = NULL;
+  GtThreadPool *pool = gt_thread_pool_get();
+  GtSaininducethreadinfo threadinfo;
+
+  gt_sain_special_singleSinduction2(sainseq,
+                                    suftab,
+                                    (GtWord) sainseq->totallength,
+                                    nonspecialentries);
+  if (sainseq->seqtype == GT_SAIN_ENCSEQ)
+  {
+    gt_sain_induceStypes2fromspecialranges(sainseq,
+                                           sainseq->seq.encseq,
+                                           suftab,
+                                           nonspecialentries);
+  }
+  threadinfo.sainseq = sainseq;
+  threadinfo.suftab = suftab;
+  threadinfo.induceinfo = gt_malloc(sizeof (*threadinfo.induceinfo) *
+                                    blocksize);
+  threadinfo.Ltype = false;
+  for (blockend = nonspecialentries; blockend > 0; blockend = blockstart)
+  {
+    GtUword idx;
+
+    blockstart = blockend > blocksize ? blockend - blocksize : 0;
+    threadinfo.blockstart = blockstart;
+    gt_thread_pool_parallel_for(pool,blockstart,blockend,
+                                GT_SAIN_THREADED_BLOCKSIZE,
+                                gt_sain_induce_prepare,&threadinfo);
+    for (idx = blockend; idx > blockstart; /* Nothing */)
+    {
+      GtWord position = suftab[--idx];
+
+      if (position > 0)
+      {
+        GtSaininduceinfo *induceinfo = threadinfo.induceinfo + idx -
+                                       blockstart;
+        GtUword currentcc;
+
+        if (induceinfo->position != position)
+        {
+          gt_sain_induceinfo_set(sainseq,induceinfo,position,false);
+        }
+        currentcc = induceinfo->currentcc;
+        if (currentcc < sainseq->numofchars)
+        {
+          GT_SAINUPDATEBUCKETPTR(currentcc);
+          gt_assert(bucketptr != NULL && bucketptr - 1 < suftab + idx);
+          *(--bucketptr) = induceinfo->putvalue;
+        }
+      } else
+      {
+        suftab[idx] = ~position;
+      }
+    }
+  }
+  gt_free(threadinfo.induceinfo);
+}
+
+/* The Sstar substrings are named in three steps: the number of marked Sstar
+   suffixes in each block is counted in parallel, the number of marks left of
+   each block is determined from the counts, and then the blocks are named in
+   parallel. */
+typedef struct
+{
+  GtUword totallength,
+          countSstartype,
+          numberofnames,
+          numofblocks,
+          *suftab,
+          *namecount;
+} GtSainnamethreadinfo;
+
+/* turn the number of marks in each block into the number of marks in all
+   blocks to the left, and return the total number */
+static GtUword gt_sain_namecount_prefixsums(GtSainnamethreadinfo *threadinfo)
+{
+  GtUword blocknum, sum = 0;
+
+  for (blocknum = 0; blocknum < threadinfo->numofblocks; blocknum++)
+  {
+    GtUword count = threadinfo->namecount[blocknum];
+
+    threadinfo->namecount[blocknum] = sum;
+    sum += count;
+  }
+  return sum;
+}
+
+static void gt_sain_fast_countnames(GtUword start, GtUword end, void *data)
+{
+  GtSainnamethreadinfo *threadinfo = data;
+  const GtUword totallength = threadinfo->totallength;
+  GtUword blocknum;
+
+  for (blocknum = start; blocknum < end; blocknum++)
+  {
+    GtUword idx, count = 0,
+            blockend = MIN((blocknum + 1) * GT_SAIN_THREADED_BLOCKSIZE,
+                           threadinfo->countSstartype);
+
+    for (idx = blocknum * GT_SAIN_THREADED_BLOCKSIZE; idx < blockend; idx++)
+    {
+      if (threadinfo->suftab[idx] >= totallength)
+      {
+        count++;
+      }
+    }
+    threadinfo->namecount[blocknum] = count;
+  }
+}
+
+static void gt_sain_fast_setnames(GtUword start, GtUword end, void *data)
+{
+  GtSainnamethreadinfo *threadinfo = data;
+  const GtUword totallength = threadinfo->totallength;
+  GtUword blocknum, *secondhalf = threadinfo->suftab +
+                                  threadinfo->countSstartype;
+
+  for (blocknum = start; blocknum < end; blocknum++)
+  {
+    /* the last suffix of each group of equal Sstar substrings is marked, so
+       the name of a suffix is one more than the number of marks left of it */
+    GtUword idx, currentname = threadinfo->namecount[blocknum] + 1,
+            blockend = MIN((blocknum + 1) * GT_SAIN_THREADED_BLOCKSIZE,
+                           threadinfo->countSstartype);
+
+    for (idx = blocknum * GT_SAIN_THREADED_BLOCKSIZE; idx < blockend; idx++)
+    {
+      GtUword position = threadinfo->suftab[idx];
+      bool marked = false;
+
+      if (position >= totallength)
+      {
+        position -= totallength;
+        marked = true;
+      }
+      if (currentname <= threadinfo->numberofnames)
+      {
+        secondhalf[GT_DIV2(position)] = currentname;
+      }
+      if (marked)
+      {
+        currentname++;
+      }
+    }
+  }
+}
+
+static void gt_sain_fast_unmark(GtUword start, GtUword end, void *data)
+{
+  GtSainnamethreadinfo *threadinfo = data;
+  const GtUword totallength = threadinfo->totallength;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+  {
+    if (threadinfo->suftab[idx] >= totallength)
+    {
+      threadinfo->suftab[idx] -= totallength;
+    }
+  }
+}
+
+/* The sequential version scans all <nonspecialentries> entries, but after
+   <gt_sain_fast_moveSstar2front()> all marked Sstar suffixes are in the first
+   <countSstartype> entries and the names are stored behind them. So only the
+   Sstar suffixes are named. */
+static void gt_sain_threaded_fast_assignSstarnames(GtUword totallength,
+                                                   GtUword countSstartype,
+                                                   GtUword *suftab,
+                                                   GtUword numberofnames,
+                                                   GtUword nonspecialentries)
+{
+  GtThreadPool *pool = gt_thread_pool_get();
+  GtSainnamethreadinfo threadinfo;
+
+  if (numberofnames < countSstartype)
+  {
+    GT_UNUSED GtUword sumofnames;
+
+    threadinfo.totallength = totallength;
+    threadinfo.countSstartype = countSstartype;
+    threadinfo.numberofnames = numberofnames;
+    threadinfo.suftab = suftab;
+    threadinfo.numofblocks = 1UL + (countSstartype - 1) /
+                                   GT_SAIN_THREADED_BLOCKSIZE;
+    threadinfo.namecount = gt_malloc(sizeof (*threadinfo.namecount) *
+                                     threadinfo.numofblocks);
+    gt_thread_pool_parallel_for(pool,0,threadinfo.numofblocks,1UL,
+                                gt_sain_fast_countnames,&threadinfo);
+    sumofnames = gt_sain_namecount_prefixsums(&threadinfo);
+    gt_assert(sumofnames == numberofnames);
+    gt_thread_pool_parallel_for(pool,0,threadinfo.numofblocks,1UL,
+                                gt_sain_fast_setnames,&threadinfo);
+    gt_free(threadinfo.namecount);
+  } else
+  {
+    threadinfo.totallength = totallength;
+    threadinfo.suftab = suftab;
+    gt_thread_pool_parallel_for(pool,0,nonspecialentries,
+                                GT_SAIN_THREADED_BLOCKSIZE,
+                                gt_sain_fast_unmark,&threadinfo);
+  }
+}
+#endif
+
 static GtUword gt_sain_insertSstarsuffixes(GtSainseq *sainseq,
                                                  GtUword *suftab,
                                                  GtLogger *logger)
@@ -715,6 +1064,14 @@ static void gt_sain_fast_assignSstarnames(GtUword totallength,
 {
   GtUword *suftabptr, *secondhalf = suftab + countSstartype;
 
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded(countSstartype))
+  {
+    gt_sain_threaded_fast_assignSstarnames(totallength,countSstartype,suftab,
+                                           numberofnames,nonspecialentries);
+    return;
+  }
+#endif
   if (numberofnames < countSstartype)
   {
     GtUword currentname = numberofnames + 1;
@@ -752,6 +1109,13 @@ static void gt_sain_induceLtypesuffixes2(const GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded(nonspecialentries))
+  {
+    gt_sain_threaded_induceLtypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
@@ -830,6 +1194,13 @@ static void gt_sain_induceStypesuffixes2(const GtSainseq *sainseq,
                                          GtWord *suftab,
                                          GtUword nonspecialentries)
 {
+#ifdef GT_THREADS_ENABLED
+  if (gt_sain_threaded(nonspecialentries))
+  {
+    gt_sain_threaded_induceStypesuffixes2(sainseq,suftab,nonspecialentries);
+    return;
+  }
+#endif
   switch (sainseq->seqtype)
   {
     case GT_SAIN_PLAINSEQ:
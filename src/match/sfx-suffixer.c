@@ -1643,6 +1643,14 @@ Sfxiterator *gt_Sfxiterator_new_withadditionalvalues(
                                         : numofsuffixestosort);
     }
     estimatedspace += sizeof (uint8_t) * largestbucketsize;
+    if (!sfi->sfxstrategy.onlybucketinsertion)
+    {
+      /* every additional thread sorting buckets has its own workspace */
+      estimatedspace += (gt_sortallbuckets_numofthreads(
+                                             sfi->outlcpinfo != NULL,
+                                             sfi->dcov != NULL) - 1) *
+                        gt_size_of_sort_workspace(&sfi->sfxstrategy);
+    }
     SHOWCURRENTSPACE;
 #ifdef DEBUGSIZEESTIMATION
     if (sfi->sfxstrategy.outsuftabonfile)
@@ -1894,7 +1902,10 @@ static void gt_sfxiterator_preparethispart(Sfxiterator *sfi)
   if (sfi->part == 0)
   {
     gt_logger_log(sfi->logger,"used workspace for sorting: %.2f MB",
-                  GT_MEGABYTES(gt_size_of_sort_workspace (&sfi->sfxstrategy)));
+                  GT_MEGABYTES(gt_sortallbuckets_numofthreads(
+                                 sfi->outlcpinfo != NULL,
+                                 sfi->dcov != NULL) *
+                               gt_size_of_sort_workspace (&sfi->sfxstrategy)));
   }
   if (!sfi->sfxstrategy.onlybucketinsertion)
   {
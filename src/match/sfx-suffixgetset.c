@@ -192,6 +192,34 @@ void gt_suffixsortspace_delete(GtSuffixsortspace *suffixsortspace,
   }
 }
 
+GtSuffixsortspace *gt_suffixsortspace_view_new(const GtSuffixsortspace *sssp)
+{
+  GtSuffixsortspace *view;
+
+  gt_assert(sssp != NULL && !sssp->currentexport);
+  view = gt_malloc(sizeof (*view));
+  *view = *sssp;
+  view->longestidx.defined = false;
+  view->longestidx.valueunsignedlong = 0;
+  return view;
+}
+
+void gt_suffixsortspace_view_delete(GtSuffixsortspace *view,
+                                    GtSuffixsortspace *sssp)
+{
+  if (view != NULL)
+  {
+    gt_assert(sssp != NULL && !view->currentexport &&
+              view->uinttab == sssp->uinttab &&
+              view->ulongtab == sssp->ulongtab);
+    if (view->longestidx.defined)
+    {
+      sssp->longestidx = view->longestidx;
+    }
+    gt_free(view);
+  }
+}
+
 void gt_suffixsortspace_nooffsets(GT_UNUSED const GtSuffixsortspace *sssp)
 {
   gt_assert(sssp->partoffset == 0);
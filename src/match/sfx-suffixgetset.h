@@ -67,6 +67,18 @@ GtSuffixsortspace *gt_suffixsortspace_new_fromfile(int filedesc,
 void gt_suffixsortspace_delete(GT_UNUSED GtSuffixsortspace *suffixsortspace,
                                GT_UNUSED bool checklongestdefined);
 
+/* Returns a view of <sssp>, i.e. a <GtSuffixsortspace> sharing the table of
+   <sssp>, but with its own bucket offset, export pointer and index of the
+   longest suffix. Thus different threads can sort disjoint ranges of the
+   table concurrently, each using its own view. */
+GtSuffixsortspace *gt_suffixsortspace_view_new(const GtSuffixsortspace *sssp);
+
+/* Deletes <view> obtained from <sssp> by <gt_suffixsortspace_view_new()>. If
+   the longest suffix was stored in the range sorted using <view>, its index
+   is transferred to <sssp>. The table is not freed. */
+void gt_suffixsortspace_view_delete(GtSuffixsortspace *view,
+                                    GtSuffixsortspace *sssp);
+
 void gt_suffixsortspace_showrange(const GtSuffixsortspace *sssp,
                                   GtUword subbucketleft,
                                   GtUword width);
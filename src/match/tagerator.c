@@ -29,6 +29,7 @@
 #include "apmeoveridx.h"
 #include "dist-short.h"
 #include "echoseq.h"
+#include "eis-voiditf.h"
 #include "esa-map.h"
 #include "idx-limdfs.h"
 #include "mssufpat.h"
@@ -536,9 +537,211 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
   }
 }
 
+static void tgr_showtagheader(const TageratorOptions *tageratoroptions,
+                              const GtAlphabet *alpha,
+                              const TgrTagwithlength *twl,
+                              uint64_t tagnumber)
+{
+  bool firstitem = true;
+
+  printf("#");
+  if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+  {
+    printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
+    firstitem = false;
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+  {
+    ADDTABULATOR;
+    printf(""GT_WU"",twl->taglen);
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+  {
+    ADDTABULATOR;
+    gt_alphabet_decode_seq_to_fp(alpha,stdout,twl->transformedtag,
+                                 twl->taglen);
+  }
+  printf("\n");
+}
+
+/* number of tags searched simultaneously in the packed index */
+#define TGR_BATCHSIZE 16384U
+
+/* maximal number of match positions of a batch located at once */
+#define TGR_MAXBATCHMATCHES 1048576U
+
+/* Exact matching of the tags in the packed index, without online search
+   or comparison, is done in batches of <TGR_BATCHSIZE> tags. The FM-index
+   searches of a batch are interleaved and run in parallel, the matches are
+   located in rounds of at most <TGR_MAXBATCHMATCHES> positions and reported
+   in the same order as by <searchoverstrands>. */
+static bool tgr_usebatchsearch(const TageratorOptions *tageratoroptions)
+{
+  return !tageratoroptions->withesa &&
+         !tageratoroptions->doonline &&
+         !tageratoroptions->docompare &&
+         tageratoroptions->userdefinedmaxdistance == 0;
+}
+
+typedef struct
+{
+  const TageratorOptions *tageratoroptions;
+  const GtAlphabet *alpha;
+  TgrTagwithlength *twltab;
+  const GtUchar **patterns;
+  GtUword patternspertag,
+          nextheader;
+  uint64_t firsttagnumber;
+  TgrShowmatchinfo *showmatchinfo;
+} TgrBatchinfo;
+
+/* show the headers of the tags of the batch before tag <tagnum>, which have
+   not been shown yet */
+static void tgr_showbatchheaders(TgrBatchinfo *batchinfo, GtUword tagnum)
+{
+  for (/* Nothing */; batchinfo->nextheader < tagnum; batchinfo->nextheader++)
+  {
+    TgrTagwithlength *twl = batchinfo->twltab + batchinfo->nextheader;
+
+    twl->tagptr = twl->transformedtag;
+    tgr_showtagheader(batchinfo->tageratoroptions,batchinfo->alpha,twl,
+                      batchinfo->firsttagnumber + batchinfo->nextheader);
+  }
+}
+
+static void tgr_showbatchmatches(void *processinfo,
+                                 GtUword patternnum,
+                                 const GtUword *positions,
+                                 GtUword numofpositions)
+{
+  TgrBatchinfo *batchinfo = (TgrBatchinfo *) processinfo;
+  GtUword tagnum = patternnum/batchinfo->patternspertag;
+  TgrTagwithlength *twl = batchinfo->twltab + tagnum;
+  const GtUword *posptr;
+  GtIdxMatch match;
+
+  tgr_showbatchheaders(batchinfo,tagnum + 1);
+  batchinfo->showmatchinfo->twlptr = twl;
+  batchinfo->showmatchinfo->tagptr = twl->tagptr
+                                   = batchinfo->patterns[patternnum];
+  match.dbabsolute = true;
+  match.dblen = match.querylen = twl->taglen;
+  match.dbsubstring = twl->tagptr;
+  match.querystartpos = 0;
+  match.distance = 0;
+  match.alignment = NULL;
+  for (posptr = positions; posptr < positions + numofpositions; posptr++)
+  {
+    match.dbstartpos = *posptr;
+    tgr_showmatch(batchinfo->showmatchinfo,&match);
+  }
+}
+
+static void tgr_showbatch(const TageratorOptions *tageratoroptions,
+                          const Genericindex *genericindex,
+                          const GtAlphabet *alpha,
+                          TgrTagwithlength *twltab,
+                          GtUword numoftags,
+                          uint64_t firsttagnumber,
+                          TgrShowmatchinfo *showmatchinfo)
+{
+  const GtUchar **patterns;
+  GtUword idx, numofpatterns = 0, *patternlengths;
+  TgrBatchinfo batchinfo;
+
+  patterns = gt_malloc(sizeof (*patterns) * 2 * numoftags);
+  patternlengths = gt_malloc(sizeof (*patternlengths) * 2 * numoftags);
+  for (idx = 0; idx < numoftags; idx++)
+  {
+    if (!tageratoroptions->nofwdmatch)
+    {
+      patterns[numofpatterns] = twltab[idx].transformedtag;
+      patternlengths[numofpatterns++] = twltab[idx].taglen;
+    }
+    if (!tageratoroptions->norcmatch)
+    {
+      patterns[numofpatterns] = twltab[idx].rctransformedtag;
+      patternlengths[numofpatterns++] = twltab[idx].taglen;
+    }
+  }
+  batchinfo.tageratoroptions = tageratoroptions;
+  batchinfo.alpha = alpha;
+  batchinfo.twltab = twltab;
+  batchinfo.patterns = patterns;
+  batchinfo.patternspertag = numofpatterns/numoftags;
+  batchinfo.nextheader = 0;
+  batchinfo.firsttagnumber = firsttagnumber;
+  batchinfo.showmatchinfo = showmatchinfo;
+  gt_pck_exactpatternmatching_batch(genericindex_get_packedindex(genericindex),
+                                    patterns,
+                                    patternlengths,
+                                    numofpatterns,
+                                    genericindex_get_totallength(genericindex),
+                                    (GtUword) TGR_MAXBATCHMATCHES,
+                                    tgr_showbatchmatches,
+                                    &batchinfo);
+  /* tags without any strand to search */
+  tgr_showbatchheaders(&batchinfo,numoftags);
+  gt_free(patternlengths);
+  gt_free(patterns);
+}
+
+static int tgr_batchsearch(const TageratorOptions *tageratoroptions,
+                           const Genericindex *genericindex,
+                           const GtAlphabet *alpha,
+                           GtSeqIterator *seqit,
+                           TgrShowmatchinfo *showmatchinfo,
+                           GtError *err)
+{
+  TgrTagwithlength *twltab;
+  const GtUchar *symbolmap = gt_alphabet_symbolmap(alpha), *currenttag;
+  uint64_t tagnumber = 0;
+  GtUword numoftags;
+  char *desc = NULL;
+  bool haserr = false, eof = false;
+
+  twltab = gt_malloc(sizeof (*twltab) * TGR_BATCHSIZE);
+  while (!haserr && !eof)
+  {
+    for (numoftags = 0; numoftags < (GtUword) TGR_BATCHSIZE; numoftags++)
+    {
+      TgrTagwithlength *twl = twltab + numoftags;
+
+      if (gt_seq_iterator_next(seqit, &currenttag, &twl->taglen, &desc,
+                               err) != 1)
+      {
+        eof = true;
+        break;
+      }
+      /* the tags before the erroneous one are still reported */
+      if (dotransformtag(twl->transformedtag,
+                         symbolmap,
+                         currenttag,
+                         twl->taglen,
+                         tagnumber + numoftags,
+                         tageratoroptions->replacewildcard,
+                         err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+      gt_copy_reversecomplement(twl->rctransformedtag,twl->transformedtag,
+                                twl->taglen);
+    }
+    if (numoftags > 0)
+    {
+      tgr_showbatch(tageratoroptions,genericindex,alpha,twltab,numoftags,
+                    tagnumber,showmatchinfo);
+      tagnumber += numoftags;
+    }
+  }
+  gt_free(twltab);
+  return haserr ? -1 : 0;
+}
+
 int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
 {
-  bool haserr = false, firstitem;
+  bool haserr = false;
   int retval;
   Myersonlineresources *mor = NULL;
   Genericindex *genericindex = NULL;
@@ -676,7 +879,15 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
     {
       haserr = true;
     }
-    if (!haserr)
+    if (!haserr && tgr_usebatchsearch(tageratoroptions))
+    {
+      if (tgr_batchsearch(tageratoroptions,genericindex,alpha,seqit,
+                          &showmatchinfo,err) != 0)
+      {
+        haserr = true;
+      }
+      gt_seq_iterator_delete(seqit);
+    } else if (!haserr)
     {
       for (tagnumber = 0; !haserr; tagnumber++)
       {
@@ -695,31 +906,12 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                            err) != 0)
         {
           haserr = true;
-          gt_free(desc);
           break;
         }
         gt_copy_reversecomplement(twl.rctransformedtag,twl.transformedtag,
                                twl.taglen);
         twl.tagptr = twl.transformedtag;
-        firstitem = true;
-        printf("#");
-        if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
-        {
-          printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
-          firstitem = false;
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
-        {
-          ADDTABULATOR;
-          printf(""GT_WU"",twl.taglen);
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
-        {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
-                                       twl.taglen);
-        }
-        printf("\n");
+        tgr_showtagheader(tageratoroptions,alpha,&twl,tagnumber);
         storeoffline.nextfreeTgrSimplematch = 0;
         storeonline.nextfreeTgrSimplematch = 0;
         if (tageratoroptions->userdefinedmaxdistance > 0 &&
@@ -734,7 +926,6 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                        twl.taglen,
                        tageratoroptions->userdefinedmaxdistance);
           haserr = true;
-          gt_free(desc);
           break;
         }
         gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
@@ -16,12 +16,14 @@
 */
 
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <stdbool.h>
 #include "core/fa.h"
 #include "core/types_api.h"
 #include "core/unused_api.h"
 #include "core/ma_api.h"
+#include "extended/edist_myers.h"
 #include "test-pairwise.h"
 #include "greedyedist.h"
 #include "squarededist.h"
@@ -179,13 +181,15 @@ void gt_checkgreedyunitedist(GT_UNUSED bool forward,
                              const GtUchar *vseq,
                              GtUword vlen)
 {
-  GtUword edist1, edist2;
+  GtUword edist1, edist2, edist3;
   GtFrontResource *frontresource = gt_frontresource_new(10UL);
   GtSeqabstract *greedyedistuseq = gt_seqabstract_new_gtuchar(useq,ulen,0),
                 *greedyedistvseq = gt_seqabstract_new_gtuchar(vseq,vlen,0);
+  GtEdistMyers *edistmyers = gt_edist_myers_new(useq,ulen,UCHAR_MAX+1);
 
   edist1 = greedyunitedist(frontresource,greedyedistuseq,greedyedistvseq);
   edist2 = gt_squarededistunit (useq,ulen,vseq,vlen);
+  edist3 = gt_edist_myers_global(edistmyers,vseq,vlen,GT_UWORD_MAX);
 #ifdef SKDEBUG
   printf("edist = "GT_WU"\n",edist1);
 #endif
@@ -195,6 +199,13 @@ void gt_checkgreedyunitedist(GT_UNUSED bool forward,
             " = gt_squarededistunit\n", edist1,edist2);
     exit(GT_EXIT_PROGRAMMING_ERROR);
   }
+  if (edist3 != edist2)
+  {
+    fprintf(stderr,"gt_edist_myers_global = "GT_WU" != "GT_WU
+            " = gt_squarededistunit\n", edist3,edist2);
+    exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+  gt_edist_myers_delete(edistmyers);
   gt_seqabstract_delete(greedyedistuseq);
   gt_seqabstract_delete(greedyedistvseq);
   gt_frontresource_delete(frontresource);
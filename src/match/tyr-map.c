@@ -15,6 +15,7 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/defined-types.h"
 #include "core/divmodmul.h"
 #include "core/encseq.h"
@@ -367,6 +368,121 @@ static int mymemcmp(GtUword *offset,const GtUchar *s1,const GtUchar *s2,
   return NULL;
 }
 
+void gt_tyrindex_sortedmersearch(const Tyrindex *tyrindex,
+                                 const GtUchar * const *keys,
+                                 GtUword numofkeys,
+                                 const GtUchar **results)
+{
+  GtUword idx, left = 0, right, mid, step,
+          numofmers = (GtUword) tyrindex->numofmers;
+  const GtUchar *mertable = tyrindex->mertable;
+
+  for (idx = 0; idx < numofkeys; idx++)
+  {
+    gt_assert(idx == 0 || memcmp(keys[idx-1],keys[idx],
+                                 (size_t) tyrindex->merbytes) <= 0);
+    /* all mers left of <left> are smaller than the key, find the first mer
+       not smaller than the key by doubling the distance to <left> */
+    right = left;
+    step = 1UL;
+    while (right < numofmers &&
+           memcmp(mertable + right * tyrindex->merbytes,keys[idx],
+                  (size_t) tyrindex->merbytes) < 0)
+    {
+      left = right + 1;
+      right = left + step - 1;
+      step = GT_MULT2(step);
+    }
+    if (right > numofmers)
+    {
+      right = numofmers;
+    }
+    while (left < right)
+    {
+      mid = left + GT_DIV2(right - left);
+      if (memcmp(mertable + mid * tyrindex->merbytes,keys[idx],
+                 (size_t) tyrindex->merbytes) < 0)
+      {
+        left = mid + 1;
+      } else
+      {
+        right = mid;
+      }
+    }
+    if (left < numofmers &&
+        memcmp(mertable + left * tyrindex->merbytes,keys[idx],
+               (size_t) tyrindex->merbytes) == 0)
+    {
+      results[idx] = mertable + left * tyrindex->merbytes;
+    } else
+    {
+      results[idx] = NULL;
+    }
+  }
+}
+
+GtUword gt_tyrindex_mer2code(const Tyrindex *tyrindex,const GtUchar *mer)
+{
+  GtUword idx, code = 0;
+
+  gt_assert(tyrindex->merbytes <= (GtUword) sizeof (GtUword));
+  for (idx = 0; idx < tyrindex->merbytes; idx++)
+  {
+    code = (code << 8) | mer[idx];
+  }
+  return code;
+}
+
+void gt_tyrindex_sortedcodesearch(const Tyrindex *tyrindex,
+                                  const GtUlongPair *keys,
+                                  GtUword numofkeys,
+                                  const GtUchar **results)
+{
+  GtUword idx, left = 0, right, mid, step,
+          numofmers = (GtUword) tyrindex->numofmers;
+  const GtUchar *mertable = tyrindex->mertable;
+
+  for (idx = 0; idx < numofkeys; idx++)
+  {
+    gt_assert(idx == 0 || keys[idx-1].a <= keys[idx].a);
+    right = left;
+    step = 1UL;
+    while (right < numofmers &&
+           gt_tyrindex_mer2code(tyrindex,mertable + right * tyrindex->merbytes)
+           < keys[idx].a)
+    {
+      left = right + 1;
+      right = left + step - 1;
+      step = GT_MULT2(step);
+    }
+    if (right > numofmers)
+    {
+      right = numofmers;
+    }
+    while (left < right)
+    {
+      mid = left + GT_DIV2(right - left);
+      if (gt_tyrindex_mer2code(tyrindex,mertable + mid * tyrindex->merbytes)
+          < keys[idx].a)
+      {
+        left = mid + 1;
+      } else
+      {
+        right = mid;
+      }
+    }
+    if (left < numofmers &&
+        gt_tyrindex_mer2code(tyrindex,mertable + left * tyrindex->merbytes)
+        == keys[idx].a)
+    {
+      results[keys[idx].b] = mertable + left * tyrindex->merbytes;
+    } else
+    {
+      results[keys[idx].b] = NULL;
+    }
+  }
+}
+
 void gt_tyrindex_check(GT_UNUSED const Tyrindex *tyrindex)
 {
 #ifndef NDEBUG
@@ -39,6 +39,27 @@ void gt_tyrindex_delete(Tyrindex **tyrindexptr);
                                               const GtUchar *key,
                                               const GtUchar *leftbound,
                                               const GtUchar *rightbound);
+/* Search the <numofkeys> mers referenced by <keys>, which must be sorted in
+   increasing order, and store a pointer to the matching mer of the index, or
+   NULL, in <results[i]> for each <keys[i]>. Each search starts where the
+   previous one stopped and doubles the distance of the probes from there, so
+   that close keys are located in the same part of the mer table. */
+void gt_tyrindex_sortedmersearch(const Tyrindex *tyrindex,
+                                 const GtUchar * const *keys,
+                                 GtUword numofkeys,
+                                 const GtUchar **results);
+/* Return the integer code of <mer> whose bytes are taken in big endian
+   order, i.e. codes compare like the mers. Requires that a mer fits into
+   a <GtUword>. */
+GtUword gt_tyrindex_mer2code(const Tyrindex *tyrindex,const GtUchar *mer);
+/* Like gt_tyrindex_sortedmersearch, but for mers fitting into a <GtUword>:
+   the component <a> of the keys is the code of the mer (see
+   gt_tyrindex_mer2code) and the result for <keys[i]> is stored in
+   <results[keys[i].b]>. */
+void gt_tyrindex_sortedcodesearch(const Tyrindex *tyrindex,
+                                  const GtUlongPair *keys,
+                                  GtUword numofkeys,
+                                  const GtUchar **results);
 void gt_tyrindex_check(const Tyrindex *tyrindex);
 int gt_determinetyrbckpfxlen(unsigned int *prefixlength,
                           const Tyrindex *tyrindex,
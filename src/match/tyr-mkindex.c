@@ -23,6 +23,7 @@
 #include "core/logger.h"
 #include "core/spacecalc.h"
 #include "core/str.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
 #include "core/ma_api.h"
@@ -80,6 +81,8 @@ typedef struct /* global information */
   GtUword countoutputmers;
   const ESASuffixptr *suftab; /* only necessary for performtest */
   GtUchar *currentmer;    /* only necessary for performtest */
+  GtArrayGtUchar merbuffer, /* only for ranges processed in parallel */
+                 countsbuffer;
 } TyrDfsstate;
 
 #include "esa-dfs.h"
@@ -408,6 +411,46 @@ static int outputsortedstring2index(GtUword countocc,
   return 0;
 }
 
+/* Like outputsortedstring2index, but the mers and counts are appended to
+   buffers in memory, which are written later. */
+static int outputsortedstring2buffer(GtUword countocc,
+                                     GtUword position,
+                                     void *adddistposinfo,
+                                     GT_UNUSED GtError *err)
+{
+  TyrDfsstate *state = (TyrDfsstate *) adddistposinfo;
+
+  if (decideifocc(state,countocc))
+  {
+    GT_CHECKARRAYSPACEMULTI(&state->merbuffer,GtUchar,
+                            1024UL * state->sizeofbuffer);
+    gt_encseq_sequence2bytecode(state->merbuffer.spaceGtUchar +
+                                state->merbuffer.nextfreeGtUchar,
+                                state->encseq,position,state->mersize);
+    state->merbuffer.nextfreeGtUchar += state->sizeofbuffer;
+    if (state->storecounts)
+    {
+      GtUchar smallcount;
+
+      if (countocc <= MAXSMALLMERCOUNT)
+      {
+        smallcount = (GtUchar) countocc;
+      } else
+      {
+        Largecount *lc;
+
+        GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+        lc->idx = state->countoutputmers;
+        lc->value = countocc;
+        smallcount = 0;
+      }
+      GT_STOREINARRAY(&state->countsbuffer,GtUchar,1024,smallcount);
+    }
+    state->countoutputmers++;
+  }
+  return 0;
+}
+
 static Dfsinfo* tyr_allocateDfsinfo(GT_UNUSED Dfsstate *state)
 {
   TyrDfsinfo *dfsinfo;
@@ -500,6 +543,133 @@ static void tyr_assignrightmostleaf(Dfsinfo *adfsinfo,
   dfsinfo->lcptabrightmostleafplus1 = currentlcp;
 }
 
+static int tyr_depthfirstesa(Sequentialsuffixarrayreader *ssar,
+                             TyrDfsstate *state,
+                             GtLogger *logger,
+                             GtError *err)
+{
+  return gt_depthfirstesa(ssar,
+                          tyr_allocateDfsinfo,
+                          tyr_freeDfsinfo,
+                          tyr_processleafedge,
+                          NULL,
+                          tyr_processcompletenode,
+                          tyr_assignleftmostleaf,
+                          tyr_assignrightmostleaf,
+                          (Dfsstate*) state,
+                          logger,
+                          err);
+}
+
+#ifdef GT_THREADS_ENABLED
+/* every lcp-interval of depth at least mersize, i.e. every mer, lies in a
+   single range of suffixes, so the results of the ranges are simply appended
+   to each other */
+static void *tyr_rangestate_new(void *data)
+{
+  const TyrDfsstate *state = data;
+  TyrDfsstate *rangestate = gt_malloc(sizeof *rangestate);
+
+  *rangestate = *state;
+  rangestate->esrspace = gt_encseq_create_reader_with_readmode(state->encseq,
+                                                               state->readmode,
+                                                               0);
+  GT_INITARRAY(&rangestate->occdistribution,Countwithpositions);
+  GT_INITARRAY(&rangestate->largecounts,Largecount);
+  GT_INITARRAY(&rangestate->merbuffer,GtUchar);
+  GT_INITARRAY(&rangestate->countsbuffer,GtUchar);
+  rangestate->countoutputmers = 0;
+  if (state->processoccurrencecount == outputsortedstring2index)
+  {
+    rangestate->processoccurrencecount = outputsortedstring2buffer;
+  }
+  return rangestate;
+}
+
+static int tyr_enumeratelcpintervals_range(
+                                    Sequentialsuffixarrayreader *rangessar,
+                                    void *rangestate,
+                                    GT_UNUSED void *data,
+                                    GtError *err)
+{
+  return tyr_depthfirstesa(rangessar,rangestate,NULL,err);
+}
+
+/* append the results of <rangestate> to those of <state> and free them */
+static void tyr_rangestate_merge(void *data,void *rangestatedata)
+{
+  TyrDfsstate *state = data, *rangestate = rangestatedata;
+  GtUword idx;
+
+  if (state->merindexfpout != NULL)
+  {
+    gt_xfwrite(rangestate->merbuffer.spaceGtUchar,sizeof (GtUchar),
+               (size_t) rangestate->merbuffer.nextfreeGtUchar,
+               state->merindexfpout);
+  }
+  if (state->countsfilefpout != NULL)
+  {
+    gt_xfwrite(rangestate->countsbuffer.spaceGtUchar,sizeof (GtUchar),
+               (size_t) rangestate->countsbuffer.nextfreeGtUchar,
+               state->countsfilefpout);
+  }
+  for (idx = 0; idx < rangestate->largecounts.nextfreeLargecount; idx++)
+  {
+    Largecount *lc;
+
+    GT_GETNEXTFREEINARRAY(lc,&state->largecounts,Largecount,32);
+    lc->idx = state->countoutputmers +
+              rangestate->largecounts.spaceLargecount[idx].idx;
+    lc->value = rangestate->largecounts.spaceLargecount[idx].value;
+  }
+  state->countoutputmers += rangestate->countoutputmers;
+  /* the position lists are built by prepending, so the lists of later
+     ranges precede those of earlier ranges */
+  for (idx = 0;
+       idx < rangestate->occdistribution.nextfreeCountwithpositions; idx++)
+  {
+    Countwithpositions *cwp
+      = rangestate->occdistribution.spaceCountwithpositions + idx;
+
+    if (cwp->occcount > 0)
+    {
+      incrementdistribcounts(&state->occdistribution,idx,cwp->occcount);
+      if (cwp->positionlist != NULL)
+      {
+        ListUlong *tail;
+
+        for (tail = cwp->positionlist; tail->nextptr != NULL;
+             tail = tail->nextptr)
+          /* Nothing */ ;
+        tail->nextptr
+          = state->occdistribution.spaceCountwithpositions[idx].positionlist;
+        state->occdistribution.spaceCountwithpositions[idx].positionlist
+          = cwp->positionlist;
+      }
+    }
+  }
+  GT_FREEARRAY(&rangestate->occdistribution,Countwithpositions);
+  GT_FREEARRAY(&rangestate->largecounts,Largecount);
+  GT_FREEARRAY(&rangestate->merbuffer,GtUchar);
+  GT_FREEARRAY(&rangestate->countsbuffer,GtUchar);
+  gt_encseq_reader_delete(rangestate->esrspace);
+  gt_free(rangestate);
+}
+
+static int tyr_depthfirstesa_threaded(Sequentialsuffixarrayreader *ssar,
+                                      TyrDfsstate *state,
+                                      GtError *err)
+{
+  return gt_Sequentialsuffixarrayreader_process_lcpranges(ssar,
+                                             state->mersize,
+                                             tyr_rangestate_new,
+                                             tyr_enumeratelcpintervals_range,
+                                             tyr_rangestate_merge,
+                                             state,
+                                             err);
+}
+#endif
+
 static void outputbytewiseUlongvalue(FILE *fpout,GtUword value)
 {
   size_t i;
@@ -518,6 +688,7 @@ static int enumeratelcpintervals(const char *inputindex,
                                  GtUword mersize,
                                  GtUword minocc,
                                  GtUword maxocc,
+                                 GT_UNUSED bool scanfile,
                                  bool performtest,
                                  GtLogger *logger,
                                  GtError *err)
@@ -546,6 +717,8 @@ static int enumeratelcpintervals(const char *inputindex,
   state->merindexfpout = NULL;
   state->countsfilefpout = NULL;
   GT_INITARRAY(&state->largecounts,Largecount);
+  GT_INITARRAY(&state->merbuffer,GtUchar);
+  GT_INITARRAY(&state->countsbuffer,GtUchar);
   if (strlen(storeindex) == 0)
   {
     state->sizeofbuffer = 0;
@@ -600,19 +773,21 @@ static int enumeratelcpintervals(const char *inputindex,
     }
     if (!haserr)
     {
-      if (gt_depthfirstesa(ssar,
-                          tyr_allocateDfsinfo,
-                          tyr_freeDfsinfo,
-                          tyr_processleafedge,
-                          NULL,
-                          tyr_processcompletenode,
-                          tyr_assignleftmostleaf,
-                          tyr_assignrightmostleaf,
-                          (Dfsstate*) state,
-                          logger,
-                          err) != 0)
+#ifdef GT_THREADS_ENABLED
+      if (gt_jobs > 1U && !scanfile && !performtest &&
+          gt_Sequentialsuffixarrayreader_nonspecials(ssar) > 0)
       {
-        haserr = true;
+        if (tyr_depthfirstesa_threaded(ssar,state,err) != 0)
+        {
+          haserr = true;
+        }
+      } else
+#endif
+      {
+        if (tyr_depthfirstesa(ssar,state,logger,err) != 0)
+        {
+          haserr = true;
+        }
       }
       if (strlen(storeindex) == 0)
       {
@@ -698,6 +873,7 @@ int gt_merstatistics(const char *inputindex,
                               mersize,
                               minocc,
                               maxocc,
+                              scanfile,
                               performtest,
                               logger,
                               err) != 0)
@@ -16,6 +16,8 @@
 */
 
 #include "core/str.h"
+#include "core/thread_api.h"
+#include "core/thread_pool.h"
 #include "core/unused_api.h"
 #include "core/logger.h"
 #include "core/ma_api.h"
@@ -194,7 +196,137 @@ static void occ_assignrightmostleaf(Dfsinfo *adfsinfo,
   dfsinfo->lcptabrightmostleafplus1 = currentlcp;
 }
 
+static int occ_depthfirstesa(Sequentialsuffixarrayreader *ssar,
+                             OccDfsstate *state,
+                             GtLogger *logger,
+                             GtError *err)
+{
+  return gt_depthfirstesa(ssar,
+                          occ_allocateDfsinfo,
+                          occ_freeDfsinfo,
+                          occ_processleafedge,
+                          NULL,
+                          occ_processcompletenode,
+                          occ_assignleftmostleaf,
+                          occ_assignrightmostleaf,
+                          (Dfsstate*) state,
+                          logger,
+                          err);
+}
+
+#ifdef GT_THREADS_ENABLED
+/* The nonspecial suffixes are split at lcp values smaller than the minimum
+   mersize into OCC_RANGESPERTHREAD * gt_jobs ranges, which are enumerated
+   independently, each into its own distributions. These are added up
+   afterwards. */
+#define OCC_RANGESPERTHREAD 32UL
+
+typedef struct
+{
+  Sequentialsuffixarrayreader *ssar;
+  const GtUword *bounds;
+  OccDfsstate *rangestates;
+  GtError **errtab;
+  bool *haserrtab;
+} OccRangeinfo;
+
+static void occ_computeoccurrenceratio_range(GtUword start,GtUword end,
+                                             void *data)
+{
+  OccRangeinfo *rangeinfo = data;
+  Sequentialsuffixarrayreader rangessar;
+  GtUword idx;
+
+  for (idx = start; idx < end; idx++)
+  {
+    gt_Sequentialsuffixarrayreader_init_range(&rangessar,
+                                              rangeinfo->ssar,
+                                              rangeinfo->bounds[idx],
+                                              rangeinfo->bounds[idx+1]);
+    rangeinfo->haserrtab[idx]
+      = occ_depthfirstesa(&rangessar,rangeinfo->rangestates + idx,NULL,
+                          rangeinfo->errtab[idx]) != 0 ? true : false;
+  }
+}
+
+static void occ_adddistribution(GtArrayuint64_t *distribution,
+                                GtArrayuint64_t *rangedistribution)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < rangedistribution->nextfreeuint64_t; idx++)
+  {
+    if (rangedistribution->spaceuint64_t[idx] > 0)
+    {
+      adddistributionuint64_t(distribution,idx,
+                              (GtUword) rangedistribution->spaceuint64_t[idx]);
+    }
+  }
+  GT_FREEARRAY(rangedistribution,uint64_t);
+}
+
+static int occ_depthfirstesa_threaded(Sequentialsuffixarrayreader *ssar,
+                                      OccDfsstate *state,
+                                      GtError *err)
+{
+  OccRangeinfo rangeinfo;
+  GtArrayuint64_t *distributions;
+  GtUword *bounds, numofranges, idx;
+  bool haserr = false;
+
+  bounds = gt_malloc(sizeof *bounds * (OCC_RANGESPERTHREAD * gt_jobs + 1));
+  numofranges = gt_Sequentialsuffixarrayreader_lcpranges(ssar,
+                                          state->minmersize,
+                                          OCC_RANGESPERTHREAD * gt_jobs,
+                                          bounds);
+  rangeinfo.ssar = ssar;
+  rangeinfo.bounds = bounds;
+  rangeinfo.rangestates = gt_malloc(sizeof *rangeinfo.rangestates *
+                                    numofranges);
+  rangeinfo.errtab = gt_malloc(sizeof *rangeinfo.errtab * numofranges);
+  rangeinfo.haserrtab = gt_malloc(sizeof *rangeinfo.haserrtab * numofranges);
+  distributions = gt_malloc(sizeof *distributions * 3 * numofranges);
+  for (idx = 0; idx < numofranges; idx++)
+  {
+    rangeinfo.rangestates[idx] = *state;
+    GT_INITARRAY(distributions + 3 * idx,uint64_t);
+    GT_INITARRAY(distributions + 3 * idx + 1,uint64_t);
+    GT_INITARRAY(distributions + 3 * idx + 2,uint64_t);
+    rangeinfo.rangestates[idx].uniquedistribution = distributions + 3 * idx;
+    rangeinfo.rangestates[idx].nonuniquedistribution
+      = distributions + 3 * idx + 1;
+    rangeinfo.rangestates[idx].nonuniquemultidistribution
+      = distributions + 3 * idx + 2;
+    rangeinfo.errtab[idx] = gt_error_new();
+  }
+  gt_thread_pool_parallel_for(gt_thread_pool_get(),0,numofranges,1UL,
+                              occ_computeoccurrenceratio_range,&rangeinfo);
+  for (idx = 0; idx < numofranges; idx++)
+  {
+    if (!haserr && rangeinfo.haserrtab[idx])
+    {
+      gt_error_set(err,"%s",gt_error_get(rangeinfo.errtab[idx]));
+      haserr = true;
+    }
+    occ_adddistribution(state->uniquedistribution,
+                        rangeinfo.rangestates[idx].uniquedistribution);
+    occ_adddistribution(state->nonuniquedistribution,
+                        rangeinfo.rangestates[idx].nonuniquedistribution);
+    occ_adddistribution(state->nonuniquemultidistribution,
+                        rangeinfo.rangestates[idx].nonuniquemultidistribution);
+    gt_error_delete(rangeinfo.errtab[idx]);
+  }
+  gt_free(distributions);
+  gt_free(rangeinfo.haserrtab);
+  gt_free(rangeinfo.errtab);
+  gt_free(rangeinfo.rangestates);
+  gt_free(bounds);
+  return haserr ? -1 : 0;
+}
+#endif
+
 static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
+                                  GT_UNUSED bool scanfile,
                                   GtUword minmersize,
                                   GtUword maxmersize,
                                   GtArrayuint64_t *uniquedistribution,
@@ -216,19 +348,21 @@ static int computeoccurrenceratio(Sequentialsuffixarrayreader *ssar,
   state->uniquedistribution = uniquedistribution;
   state->nonuniquedistribution = nonuniquedistribution;
   state->nonuniquemultidistribution = nonuniquemultidistribution;
-  if (gt_depthfirstesa(ssar,
-                    occ_allocateDfsinfo,
-                    occ_freeDfsinfo,
-                    occ_processleafedge,
-                    NULL,
-                    occ_processcompletenode,
-                    occ_assignleftmostleaf,
-                    occ_assignrightmostleaf,
-                    (Dfsstate*) state,
-                    logger,
-                    err) != 0)
+#ifdef GT_THREADS_ENABLED
+  if (gt_jobs > 1U && !scanfile &&
+      gt_Sequentialsuffixarrayreader_nonspecials(ssar) > 0)
   {
-    haserr = true;
+    if (occ_depthfirstesa_threaded(ssar,state,err) != 0)
+    {
+      haserr = true;
+    }
+  } else
+#endif
+  {
+    if (occ_depthfirstesa(ssar,state,logger,err) != 0)
+    {
+      haserr = true;
+    }
   }
   gt_free(state);
   return haserr ? -1 : 0;
@@ -263,6 +397,7 @@ int gt_tyr_occratio_func(const char *inputindex,
   if (!haserr)
   {
     if (computeoccurrenceratio(ssar,
+                               scanfile,
                                minmersize,
                                maxmersize,
                                uniquedistribution,
@@ -15,8 +15,12 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/alphabet.h"
+#include "core/arraydef.h"
 #include "core/fa.h"
+#include "core/qsort_r_api.h"
+#include "core/radix_sort.h"
 #include "core/unused_api.h"
 #include "core/seq_iterator_sequence_buffer_api.h"
 #include "core/chardef.h"
@@ -143,22 +147,102 @@ static void mermatchoutput(const Tyrindex *tyrindex,
   }
 }
 
-static void singleseqtyrsearch(const Tyrindex *tyrindex,
-                               const Tyrcountinfo *tyrcountinfo,
-                               const Tyrsearchinfo *tyrsearchinfo,
-                               const Tyrbckinfo *tyrbckinfo,
-                               uint64_t unitnum,
-                               const GtUchar *query,
-                               GtUword querylen,
-                               GT_UNUSED const char *desc)
+/* The query mers are searched in batches of at least TYR_BATCHSIZE mers.
+   The mers of a batch are sorted and then searched in this order with
+   gt_tyrindex_sortedcodesearch, which replaces the random accesses of
+   independent binary searches by a sweep over the mer table. Mers fitting
+   into a <GtUword> are sorted as integer codes by radixsort, longer mers are
+   compared bytewise. The larger the batch, the closer are the mers searched
+   one after the other, a batch of 2^20 mers of 16 bases takes about 40 MB.
+   The matches are reported in the order of the query positions. */
+#define TYR_BATCHSIZE 1048576UL
+
+typedef struct
+{
+  uint64_t unitnum;
+  GtUword queryoffset,  /* start of query in batch */
+          queryposition;
+  bool forward;
+} Tyrquerymer;
+
+GT_DECLAREARRAYSTRUCT(Tyrquerymer);
+
+typedef struct
+{
+  GtArrayGtUchar queries,
+                 bytecodes;
+  GtArrayTyrquerymer querymers;
+  GtUlongPair *sortedcodes;
+  const GtUchar **sortedkeys,
+                **results,
+                **merresults;
+  GtUword allocatedkeys;
+} Tyrsearchbatch;
+
+static void tyrsearchbatch_init(Tyrsearchbatch *batch)
 {
-  const GtUchar *qptr, *result;
-  GtUword offset, skipvalue;
+  GT_INITARRAY(&batch->queries,GtUchar);
+  GT_INITARRAY(&batch->bytecodes,GtUchar);
+  GT_INITARRAY(&batch->querymers,Tyrquerymer);
+  batch->sortedcodes = NULL;
+  batch->sortedkeys = NULL;
+  batch->results = NULL;
+  batch->merresults = NULL;
+  batch->allocatedkeys = 0;
+}
+
+static void tyrsearchbatch_delete(Tyrsearchbatch *batch)
+{
+  GT_FREEARRAY(&batch->queries,GtUchar);
+  GT_FREEARRAY(&batch->bytecodes,GtUchar);
+  GT_FREEARRAY(&batch->querymers,Tyrquerymer);
+  gt_free(batch->sortedcodes);
+  gt_free(batch->sortedkeys);
+  gt_free(batch->results);
+  gt_free(batch->merresults);
+}
+
+static void tyrsearchbatch_addmer(Tyrsearchbatch *batch,
+                                  const Tyrsearchinfo *tyrsearchinfo,
+                                  const GtUchar *qptr,
+                                  GtUword merbytes,
+                                  uint64_t unitnum,
+                                  GtUword queryoffset,
+                                  GtUword queryposition,
+                                  bool forward)
+{
+  Tyrquerymer *querymer;
+
+  GT_GETNEXTFREEINARRAY(querymer,&batch->querymers,Tyrquerymer,1024);
+  querymer->unitnum = unitnum;
+  querymer->queryoffset = queryoffset;
+  querymer->queryposition = queryposition;
+  querymer->forward = forward;
+  GT_CHECKARRAYSPACEMULTI(&batch->bytecodes,GtUchar,1024UL * merbytes);
+  gt_encseq_plainseq2bytecode(batch->bytecodes.spaceGtUchar +
+                              batch->bytecodes.nextfreeGtUchar,
+                              qptr,tyrsearchinfo->mersize);
+  batch->bytecodes.nextfreeGtUchar += merbytes;
+}
+
+static void tyrsearchbatch_addquery(Tyrsearchbatch *batch,
+                                    const Tyrsearchinfo *tyrsearchinfo,
+                                    GtUword merbytes,
+                                    uint64_t unitnum,
+                                    const GtUchar *query,
+                                    GtUword querylen)
+{
+  const GtUchar *qptr;
+  GtUword offset, skipvalue, queryoffset;
 
   if (tyrsearchinfo->mersize > querylen)
   {
     return;
   }
+  queryoffset = batch->queries.nextfreeGtUchar;
+  GT_CHECKARRAYSPACEMULTI(&batch->queries,GtUchar,querylen);
+  memcpy(batch->queries.spaceGtUchar + queryoffset,query,(size_t) querylen);
+  batch->queries.nextfreeGtUchar += querylen;
   qptr = query;
   offset = 0;
   while (qptr <= query + querylen - tyrsearchinfo->mersize)
@@ -169,37 +253,17 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
       offset = tyrsearchinfo->mersize-1;
       if (tyrsearchinfo->searchstrand & STRAND_FORWARD)
       {
-        result = gt_searchsinglemer(qptr,tyrindex,tyrsearchinfo,tyrbckinfo);
-        if (result != NULL)
-        {
-          mermatchoutput(tyrindex,
-                         tyrcountinfo,
-                         tyrsearchinfo,
-                         result,
-                         query,
-                         qptr,
-                         unitnum,
-                         true);
-        }
+        tyrsearchbatch_addmer(batch,tyrsearchinfo,qptr,merbytes,unitnum,
+                              queryoffset,(GtUword) (qptr - query),true);
       }
       if (tyrsearchinfo->searchstrand & STRAND_REVERSE)
       {
         gt_assert(tyrsearchinfo->rcbuf != NULL);
         gt_copy_reversecomplement(tyrsearchinfo->rcbuf,qptr,
-                               tyrsearchinfo->mersize);
-        result = gt_searchsinglemer(tyrsearchinfo->rcbuf,tyrindex,
-                                    tyrsearchinfo,tyrbckinfo);
-        if (result != NULL)
-        {
-          mermatchoutput(tyrindex,
-                         tyrcountinfo,
-                         tyrsearchinfo,
-                         result,
-                         query,
-                         qptr,
-                         unitnum,
-                         false);
-        }
+                                  tyrsearchinfo->mersize);
+        tyrsearchbatch_addmer(batch,tyrsearchinfo,tyrsearchinfo->rcbuf,
+                              merbytes,unitnum,queryoffset,
+                              (GtUword) (qptr - query),false);
       }
       qptr++;
     } else
@@ -210,6 +274,111 @@ static void singleseqtyrsearch(const Tyrindex *tyrindex,
   }
 }
 
+static int tyrsearchbatch_cmpkeys(const void *a,const void *b,void *data)
+{
+  const GtUword *merbytes = data;
+
+  return memcmp(*(const GtUchar * const *) a,*(const GtUchar * const *) b,
+                (size_t) *merbytes);
+}
+
+static void tyrsearchbatch_process(Tyrsearchbatch *batch,
+                                   const Tyrindex *tyrindex,
+                                   const Tyrcountinfo *tyrcountinfo,
+                                   const Tyrsearchinfo *tyrsearchinfo,
+                                   const Tyrbckinfo *tyrbckinfo,
+                                   bool performtest)
+{
+  GtUword idx, mernum, merbytes = gt_tyrindex_merbytes(tyrindex),
+          numofmers = batch->querymers.nextfreeTyrquerymer;
+
+  if (numofmers > batch->allocatedkeys)
+  {
+    batch->merresults = gt_realloc(batch->merresults,
+                                   sizeof *batch->merresults * numofmers);
+    if (merbytes <= (GtUword) sizeof (GtUword))
+    {
+      batch->sortedcodes = gt_realloc(batch->sortedcodes,
+                                      sizeof *batch->sortedcodes * numofmers);
+    } else
+    {
+      batch->sortedkeys = gt_realloc(batch->sortedkeys,
+                                     sizeof *batch->sortedkeys * numofmers);
+      batch->results = gt_realloc(batch->results,
+                                  sizeof *batch->results * numofmers);
+    }
+    batch->allocatedkeys = numofmers;
+  }
+  if (merbytes <= (GtUword) sizeof (GtUword))
+  {
+    for (idx = 0; idx < numofmers; idx++)
+    {
+      batch->sortedcodes[idx].a
+        = gt_tyrindex_mer2code(tyrindex,batch->bytecodes.spaceGtUchar +
+                                        idx * merbytes);
+      batch->sortedcodes[idx].b = idx;
+    }
+    gt_radixsort_inplace_GtUlongPair(batch->sortedcodes,numofmers);
+    gt_tyrindex_sortedcodesearch(tyrindex,batch->sortedcodes,numofmers,
+                                 batch->merresults);
+  } else
+  {
+    for (idx = 0; idx < numofmers; idx++)
+    {
+      batch->sortedkeys[idx] = batch->bytecodes.spaceGtUchar + idx * merbytes;
+    }
+    gt_qsort_r(batch->sortedkeys,(size_t) numofmers,sizeof *batch->sortedkeys,
+               &merbytes,tyrsearchbatch_cmpkeys);
+    gt_tyrindex_sortedmersearch(tyrindex,batch->sortedkeys,numofmers,
+                                batch->results);
+    /* the keys point into the bytecodes, so they give the mer numbers */
+    for (idx = 0; idx < numofmers; idx++)
+    {
+      mernum = (GtUword) (batch->sortedkeys[idx] -
+                          batch->bytecodes.spaceGtUchar) / merbytes;
+      batch->merresults[mernum] = batch->results[idx];
+    }
+  }
+  for (mernum = 0; mernum < numofmers; mernum++)
+  {
+    const Tyrquerymer *querymer = batch->querymers.spaceTyrquerymer + mernum;
+    const GtUchar *query = batch->queries.spaceGtUchar + querymer->queryoffset;
+
+    if (performtest)
+    {
+      const GtUchar *qptr = query + querymer->queryposition;
+
+      if (!querymer->forward)
+      {
+        gt_copy_reversecomplement(tyrsearchinfo->rcbuf,qptr,
+                                  tyrsearchinfo->mersize);
+        qptr = tyrsearchinfo->rcbuf;
+      }
+      if (gt_searchsinglemer(qptr,tyrindex,tyrsearchinfo,tyrbckinfo)
+          != batch->merresults[mernum])
+      {
+        fprintf(stderr,"batch search and single search differ for mer "
+                       GT_WU"\n",mernum);
+        exit(GT_EXIT_PROGRAMMING_ERROR);
+      }
+    }
+    if (batch->merresults[mernum] != NULL)
+    {
+      mermatchoutput(tyrindex,
+                     tyrcountinfo,
+                     tyrsearchinfo,
+                     batch->merresults[mernum],
+                     query,
+                     query + querymer->queryposition,
+                     querymer->unitnum,
+                     querymer->forward);
+    }
+  }
+  batch->queries.nextfreeGtUchar = 0;
+  batch->bytecodes.nextfreeGtUchar = 0;
+  batch->querymers.nextfreeTyrquerymer = 0;
+}
+
 int gt_tyrsearch(const char *tyrindexname,
                  const GtStrArray *queryfilenames,
                  unsigned int showmode,
@@ -273,10 +442,12 @@ int gt_tyrsearch(const char *tyrindexname,
     uint64_t unitnum;
     int retval;
     Tyrsearchinfo tyrsearchinfo;
+    Tyrsearchbatch batch;
     GtSeqIterator *seqit;
 
     gt_assert(tyrindex != NULL);
     gt_tyrsearchinfo_init(&tyrsearchinfo,tyrindex,showmode,searchstrand);
+    tyrsearchbatch_init(&batch);
     seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
     if (!seqit)
       haserr = true;
@@ -300,17 +471,24 @@ int gt_tyrsearch(const char *tyrindexname,
         {
           break;
         }
-        singleseqtyrsearch(tyrindex,
-                           tyrcountinfo,
-                           &tyrsearchinfo,
-                           tyrbckinfo,
-                           unitnum,
-                           query,
-                           querylen,
-                           desc);
+        tyrsearchbatch_addquery(&batch,
+                                &tyrsearchinfo,
+                                gt_tyrindex_merbytes(tyrindex),
+                                unitnum,
+                                query,
+                                querylen);
+        if (batch.querymers.nextfreeTyrquerymer >= TYR_BATCHSIZE)
+        {
+          tyrsearchbatch_process(&batch,tyrindex,tyrcountinfo,&tyrsearchinfo,
+                                 tyrbckinfo,performtest);
+        }
       }
+      /* the matches of the queries read before an error are reported */
+      tyrsearchbatch_process(&batch,tyrindex,tyrcountinfo,&tyrsearchinfo,
+                             tyrbckinfo,performtest);
       gt_seq_iterator_delete(seqit);
     }
+    tyrsearchbatch_delete(&batch);
     gt_tyrsearchinfo_delete(&tyrsearchinfo);
   }
   if (tyrbckinfo != NULL)
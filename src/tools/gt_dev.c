@@ -25,6 +25,8 @@
 #include "gth/gt_gthbssmprint.h"
 #include "gth/gt_gthbssmrmsd.h"
 #include "gth/gt_gthbssmtrain.h"
+#include "gth/gt_gthdev.h"
+#include "gth/gt_gthdpbench.h"
 #include "gth/gt_gthmkbssmfiles.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_consensus_sa.h"
@@ -53,11 +55,13 @@ static void* gt_dev_arguments_new(void)
   GtToolbox *dev_toolbox = gt_toolbox_new();
   /* add development tools here with a function call like this:
      gt_toolbox_add(dev_toolbox, "devtool", gt_devtool); */
+  gt_toolbox_add(dev_toolbox, "gth", gt_gthdev);
   gt_toolbox_add(dev_toolbox, "gthbssmbuild", gt_gthbssmbuild);
   gt_toolbox_add(dev_toolbox, "gthbssmfileinfo", gt_gthbssmfileinfo);
   gt_toolbox_add(dev_toolbox, "gthbssmprint", gt_gthbssmprint);
   gt_toolbox_add_tool(dev_toolbox, "gthbssmrmsd", gt_gthbssmrmsd());
   gt_toolbox_add_tool(dev_toolbox, "gthbssmtrain", gt_gthbssmtrain());
+  gt_toolbox_add_tool(dev_toolbox, "gthdpbench", gt_gthdpbench());
   gt_toolbox_add(dev_toolbox, "gthmkbssmfiles", gt_gthmkbssmfiles);
   gt_toolbox_add(dev_toolbox, "guessprot", gt_guessprot);
   gt_toolbox_add(dev_toolbox, "mergeesa", gt_mergeesa);
@@ -23,7 +23,9 @@
 #include "core/encseq_options.h"
 #include "core/fasta_separator.h"
 #include "core/log_api.h"
+#include "core/minmax.h"
 #include "core/readmode.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
@@ -176,6 +178,126 @@ int gt_encseq_decode_arguments_check(GT_UNUSED int rest_argc,
   return had_err;
 }
 
+/* Determine the description, the start position and the length of the
+   <seqnum>-th sequence with respect to the readmode. <buf> is used for the
+   description if <encseq> has no description support. */
+static void sequence_info(const GtEncseq *encseq,
+                          const GtEncseqDecodeArguments *args,
+                          bool has_desc,
+                          GtUword seqnum,
+                          char *buf,
+                          const char **desc,
+                          GtUword *desclen,
+                          GtUword *startpos,
+                          GtUword *len)
+{
+  GtUword fwdseqnum = seqnum;
+  /* XXX: maybe make this distinction in the functions via readmode? */
+  if (!GT_ISDIRREVERSE(args->rm)) {
+    *startpos = gt_encseq_seqstartpos(encseq, seqnum);
+    *len = gt_encseq_seqlength(encseq, seqnum);
+  } else {
+    fwdseqnum = gt_encseq_num_of_sequences(encseq) - 1 - seqnum;
+    *len = gt_encseq_seqlength(encseq, fwdseqnum);
+    *startpos = gt_encseq_total_length(encseq)
+                  - (gt_encseq_seqstartpos(encseq, fwdseqnum) + *len);
+  }
+  if (has_desc) {
+    *desc = gt_encseq_description(encseq, desclen, fwdseqnum);
+  } else {
+    (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", seqnum);
+    *desclen = strlen(buf);
+    *desc = buf;
+  }
+  gt_assert(*desc);
+}
+
+/* number of positions decoded at once if several threads are used */
+#define GT_ENCSEQ_DECODE_BATCHSIZE (1UL << 24)
+
+/* Decode and show the positions <from> to <from> + <len> - 1 in batches, each
+   decoded in parallel. If <replacesep> is true, separators are shown as
+   <sepchar>. */
+static void output_range_parallel(const GtEncseq *encseq, GtReadmode rm,
+                                  char *buffer, GtUword from, GtUword len,
+                                  bool replacesep, char sepchar)
+{
+  while (len > 0) {
+    GtUword batchlen = MIN(len, GT_ENCSEQ_DECODE_BATCHSIZE), j;
+    gt_encseq_extract_decoded_parallel(encseq, buffer, rm, from,
+                                       from + batchlen - 1);
+    if (replacesep) {
+      for (j = 0; j < batchlen; j++) {
+        if (buffer[j] == (char) SEPARATOR)
+          buffer[j] = sepchar;
+      }
+    }
+    gt_xfwrite(buffer, 1, (size_t) batchlen, stdout);
+    from += batchlen;
+    len -= batchlen;
+  }
+}
+
+/* Show the sequences <sfrom> to <sto> - 1. Consecutive sequences are
+   decoded together, so that even short sequences are decoded in parallel. */
+static void output_fasta_parallel(const GtEncseq *encseq,
+                                  const GtEncseqDecodeArguments *args,
+                                  GtUword sfrom, GtUword sto, bool has_desc)
+{
+  GtUword i = sfrom, k, desclen, startpos, len, batchfrom, batchend;
+  char *buffer, buf[BUFSIZ];
+  const char *desc;
+
+  buffer = gt_malloc(sizeof *buffer * GT_ENCSEQ_DECODE_BATCHSIZE);
+  while (i < sto) {
+    sequence_info(encseq, args, has_desc, i, buf, &desc, &desclen,
+                  &batchfrom, &len);
+    if (len > GT_ENCSEQ_DECODE_BATCHSIZE) {
+      gt_xfputc(GT_FASTA_SEPARATOR, stdout);
+      gt_xfwrite(desc, 1, desclen, stdout);
+      gt_xfputc('\n', stdout);
+      output_range_parallel(encseq, args->rm, buffer, batchfrom, len, false,
+                            '\0');
+      gt_xfputc('\n', stdout);
+      i++;
+      continue;
+    }
+    /* the sequences are consecutive with respect to the readmode */
+    batchend = batchfrom + len;
+    for (k = i + 1; k < sto; k++) {
+      sequence_info(encseq, args, has_desc, k, buf, &desc, &desclen,
+                    &startpos, &len);
+      if (startpos + len - batchfrom > GT_ENCSEQ_DECODE_BATCHSIZE)
+        break;
+      batchend = startpos + len;
+    }
+    if (batchend > batchfrom) {
+      gt_encseq_extract_decoded_parallel(encseq, buffer, args->rm, batchfrom,
+                                         batchend - 1);
+    }
+    for (/* Nothing */; i < k; i++) {
+      sequence_info(encseq, args, has_desc, i, buf, &desc, &desclen,
+                    &startpos, &len);
+      gt_xfputc(GT_FASTA_SEPARATOR, stdout);
+      gt_xfwrite(desc, 1, desclen, stdout);
+      gt_xfputc('\n', stdout);
+      gt_xfwrite(buffer + startpos - batchfrom, 1, (size_t) len, stdout);
+      gt_xfputc('\n', stdout);
+    }
+  }
+  gt_free(buffer);
+}
+
+static void output_concat_parallel(const GtEncseq *encseq,
+                                   const GtEncseqDecodeArguments *args,
+                                   GtUword from, GtUword to)
+{
+  char *buffer = gt_malloc(sizeof *buffer * GT_ENCSEQ_DECODE_BATCHSIZE);
+  output_range_parallel(encseq, args->rm, buffer, from, to - from + 1, true,
+                        gt_str_get(args->sepchar)[0]);
+  gt_free(buffer);
+}
+
 static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                            const char *filename, GtError *err)
 {
@@ -220,61 +342,38 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       sfrom = 0;
       sto = gt_encseq_num_of_sequences(encseq);
     }
-    for (i = sfrom; i < sto; i++) {
-      GtUword desclen, startpos, len;
-      char buf[BUFSIZ];
-      const char *desc = NULL;
-      /* XXX: maybe make this distinction in the functions via readmode? */
-      if (!GT_ISDIRREVERSE(args->rm)) {
-        startpos = gt_encseq_seqstartpos(encseq, i);
-        len = gt_encseq_seqlength(encseq, i);
-        if (has_desc) {
-          desc = gt_encseq_description(encseq, &desclen, i);
-        } else {
-          (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", i);
-          desclen = strlen(buf);
-          desc = buf;
-        }
-      } else {
-        startpos = gt_encseq_seqstartpos(encseq, i);
-        len = gt_encseq_seqlength(encseq,
-                                  gt_encseq_num_of_sequences(encseq)-1-i);
-        startpos = gt_encseq_total_length(encseq)
-                     - (gt_encseq_seqstartpos(encseq,
-                                              gt_encseq_num_of_sequences(
-                                                encseq)-1-i) + len);
-        if (has_desc) {
-          desc = gt_encseq_description(encseq,
-                                       &desclen,
-                                       gt_encseq_num_of_sequences(encseq)-1-i);
+    if (gt_jobs > 1U && !args->singlechars) {
+      output_fasta_parallel(encseq, args, sfrom, sto, has_desc);
+    } else {
+      for (i = sfrom; i < sto; i++) {
+        GtUword desclen, startpos, len;
+        char buf[BUFSIZ];
+        const char *desc;
+        sequence_info(encseq, args, has_desc, i, buf, &desc, &desclen,
+                      &startpos, &len);
+        /* output description */
+        gt_xfputc(GT_FASTA_SEPARATOR, stdout);
+        gt_xfwrite(desc, 1, desclen, stdout);
+        gt_xfputc('\n', stdout);
+        /* XXX: make this more efficient by writing in a buffer first and
+           then showing the result */
+        if (args->singlechars) {
+          for (j = 0; j < len; j++) {
+             gt_xfputc(gt_encseq_get_decoded_char(encseq,
+                                                  startpos + j,
+                                                  args->rm),
+                       stdout);
+          }
         } else {
-          (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", i);
-          desclen = strlen(buf);
-          desc = buf;
-        }
-      }
-      gt_assert(desc);
-      /* output description */
-      gt_xfputc(GT_FASTA_SEPARATOR, stdout);
-      gt_xfwrite(desc, 1, desclen, stdout);
-      gt_xfputc('\n', stdout);
-      /* XXX: make this more efficient by writing in a buffer first and then
-         showing the result */
-      if (args->singlechars) {
-        for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_get_decoded_char(encseq,
-                                                startpos + j,
-                                                args->rm),
-                     stdout);
-        }
-      } else {
-        esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, startpos);
-        for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_reader_next_decoded_char(esr), stdout);
+          esr = gt_encseq_create_reader_with_readmode(encseq, args->rm,
+                                                      startpos);
+          for (j = 0; j < len; j++) {
+             gt_xfputc(gt_encseq_reader_next_decoded_char(esr), stdout);
+          }
+          gt_encseq_reader_delete(esr);
         }
-        gt_encseq_reader_delete(esr);
+        gt_xfputc('\n', stdout);
       }
-      gt_xfputc('\n', stdout);
     }
   }
 
@@ -294,7 +393,9 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       }
     }
     if (!had_err) {
-      if (args->singlechars) {
+      if (gt_jobs > 1U && !args->singlechars) {
+        output_concat_parallel(encseq, args, from, to);
+      } else if (args->singlechars) {
         for (j = from; j <= to; j++) {
           char cc = gt_encseq_get_decoded_char(encseq, j, args->rm);
           if (cc == (char) SEPARATOR)
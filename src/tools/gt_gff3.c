@@ -19,6 +19,7 @@
 #include "core/ma.h"
 #include "core/option_api.h"
 #include "core/output_file_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/versionfunc.h"
 #include "extended/add_introns_stream_api.h"
@@ -31,7 +32,7 @@
 #include "extended/load_stream.h"
 #include "extended/merge_feature_stream_api.h"
 #include "extended/set_source_visitor_api.h"
-#include "extended/sort_stream_api.h"
+#include "extended/sort_stream.h"
 #include "extended/typecheck_info.h"
 #include "extended/visitor_stream_api.h"
 #include "tools/gt_gff3.h"
@@ -50,8 +51,10 @@ typedef struct {
        show,
        fixboundaries;
   GtWord offset;
-  GtStr *offsetfile, *newsource;
-  GtUword width;
+  GtStr *offsetfile, *newsource, *memlimitarg, *seqid;
+  GtRange overlap_range;
+  GtUword width, memlimit;
+  GtOption *refoptionmemlimit;
   GtTypecheckInfo *tci;
   GtOutputFileInfo *ofi;
   GtFile *outfp;
@@ -62,6 +65,8 @@ static void* gt_gff3_arguments_new(void)
   GFF3Arguments *arguments = gt_calloc(1, sizeof *arguments);
   arguments->newsource = gt_str_new();
   arguments->offsetfile = gt_str_new();
+  arguments->seqid = gt_str_new();
+  arguments->memlimitarg = gt_str_new();
   arguments->tci = gt_typecheck_info_new();
   arguments->ofi = gt_output_file_info_new();
   return arguments;
@@ -76,6 +81,9 @@ static void gt_gff3_arguments_delete(void *tool_arguments)
   gt_output_file_info_delete(arguments->ofi);
   gt_typecheck_info_delete(arguments->tci);
   gt_str_delete(arguments->offsetfile);
+  gt_option_delete(arguments->refoptionmemlimit);
+  gt_str_delete(arguments->memlimitarg);
+  gt_str_delete(arguments->seqid);
   gt_free(arguments);
 }
 
@@ -85,7 +93,7 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
   GtOptionParser *op;
   GtOption *sort_option, *load_option, *strict_option, *tidy_option,
            *mergefeat_option, *addintrons_option, *offset_option,
-           *offsetfile_option, *setsource_option, *option;
+           *offsetfile_option, *setsource_option, *seqid_option, *option;
   gt_assert(arguments);
 
   /* init */
@@ -99,6 +107,33 @@ static GtOptionParser* gt_gff3_option_parser_new(void *tool_arguments)
                                    &arguments->sort, false);
   gt_option_parser_add_option(op, sort_option);
 
+  /* -memlimit */
+  option = gt_option_new_string("memlimit", "limit the memory used for "
+                                "sorting, sorted runs exceeding the limit are "
+                                "written to temporary files and merged "
+                                "afterwards (the keywords 'MB' and 'GB' are "
+                                "required)", arguments->memlimitarg,
+                                NULL);
+  gt_option_imply(option, sort_option);
+  gt_option_parser_add_option(op, option);
+  arguments->refoptionmemlimit = gt_option_ref(option);
+
+  /* -seqid */
+  seqid_option = gt_option_new_string("seqid", "only read the features on the "
+                                      "given sequence ID from the single "
+                                      "input file, which must be indexed with "
+                                      "'gt gff3index'", arguments->seqid,
+                                      NULL);
+  gt_option_parser_add_option(op, seqid_option);
+
+  /* -overlap */
+  option = gt_option_new_range("overlap", "only read the features which "
+                               "overlap the given range on the sequence ID "
+                               "given with -seqid", &arguments->overlap_range,
+                               NULL);
+  gt_option_imply(option, seqid_option);
+  gt_option_parser_add_option(op, option);
+
   /* -strict */
   strict_option = gt_option_new_bool("strict", "be very strict during GFF3 "
                                      "parsing (stricter than the specification "
@@ -229,6 +264,13 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   gt_error_check(err);
   gt_assert(arguments);
 
+  if (gt_option_is_set(arguments->refoptionmemlimit)) {
+    had_err = gt_option_parse_spacespec(&arguments->memlimit, "memlimit",
+                                        arguments->memlimitarg, err);
+    if (had_err)
+      return had_err;
+  }
+
   /* create a gff3 input stream */
   gff3_in_stream = gt_gff3_in_stream_new_unsorted(argc - parsed_args,
                                                   argv + parsed_args);
@@ -238,9 +280,23 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
     gt_gff3_in_stream_check_id_attributes((GtGFF3InStream*) gff3_in_stream);
   if (!arguments->addids)
     gt_gff3_in_stream_disable_add_ids(gff3_in_stream);
+  if (gt_jobs > 1)
+    gt_gff3_in_stream_enable_parallel_mode((GtGFF3InStream*) gff3_in_stream);
 
   last_stream = gff3_in_stream;
 
+  /* restrict to region (if necessary) */
+  if (gt_str_length(arguments->seqid)) {
+    GtRange range = arguments->overlap_range;
+    if (range.start == GT_UNDEF_UWORD) {
+      range.start = 1;
+      range.end = GT_UWORD_MAX;
+    }
+    had_err = gt_gff3_in_stream_restrict_to_region(gff3_in_stream,
+                                                   gt_str_get(arguments->seqid),
+                                                   &range, err);
+  }
+
   /* set different type checker if necessary */
   if (gt_typecheck_info_option_used(arguments->tci)) {
     type_checker = gt_typecheck_info_create_type_checker(arguments->tci, err);
@@ -279,6 +335,9 @@ static int gt_gff3_runner(int argc, const char **argv, int parsed_args,
   /* create sort stream (if necessary) */
   if (!had_err && arguments->sort) {
     sort_stream = gt_sort_stream_new(last_stream);
+    if (arguments->memlimit)
+      gt_sort_stream_set_memlimit((GtSortStream*) sort_stream,
+                                  arguments->memlimit);
     last_stream = sort_stream;
   }
 
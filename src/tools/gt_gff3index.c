@@ -0,0 +1,52 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include "core/option_api.h"
+#include "core/unused_api.h"
+#include "extended/gff3_index.h"
+#include "tools/gt_gff3index.h"
+
+static GtOptionParser* gt_gff3index_option_parser_new(GT_UNUSED void
+                                                      *tool_arguments)
+{
+  GtOptionParser *op;
+  op = gt_option_parser_new("GFF3_file [...]",
+                            "Index sorted and BGZF compressed GFF3 files (as "
+                            "written by 'gt gff3 -sort -bgzip') for region "
+                            "queries.");
+  gt_option_parser_set_min_args(op, 1);
+  return op;
+}
+
+static int gt_gff3index_runner(int argc, const char **argv, int parsed_args,
+                               GT_UNUSED void *tool_arguments, GtError *err)
+{
+  int i, had_err = 0;
+  gt_error_check(err);
+  for (i = parsed_args; !had_err && i < argc; i++)
+    had_err = gt_gff3_index_build(argv[i], err);
+  return had_err;
+}
+
+GtTool* gt_gff3index(void)
+{
+  return gt_tool_new(NULL,
+                     NULL,
+                     gt_gff3index_option_parser_new,
+                     NULL,
+                     gt_gff3index_runner);
+}
@@ -25,6 +25,8 @@
 #include "core/tool_api.h"
 #include "core/versionfunc.h"
 #include "core/format64.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
 #include "match/esa-seqread.h"
 #include "match/esa-mmsearch.h"
 #include "match/esa-maxpairs.h"
@@ -44,6 +46,64 @@ typedef struct
   GtOption *refforwardoption;
 } Maxpairsoptions;
 
+typedef struct
+{
+  GtQuerymatch *querymatchspaceptr;
+  GtXdropArbitraryscores arbitscores;
+  GtXdropresources *res;
+  GtFrontResource *frontresource;
+  GtXdropbest best_left;
+  GtXdropbest best_right;
+  GtXdropscore belowscore;
+  GtSeqabstract *useq, *vseq;
+  const GtUchar *query_sequence;
+  GtUword query_totallength;
+  GtStr *outbuffer; /* if not NULL, matches are appended to it rather than
+                       shown */
+} GtXdropmatchinfo;
+
+static void gt_xdropmatchinfo_init(GtXdropmatchinfo *xdropmatchinfo)
+{
+  xdropmatchinfo->querymatchspaceptr = gt_querymatch_new();
+  xdropmatchinfo->useq = gt_seqabstract_new_empty();
+  xdropmatchinfo->vseq = gt_seqabstract_new_empty();
+  xdropmatchinfo->arbitscores.mat = 2;
+  xdropmatchinfo->arbitscores.mis = -2;
+  xdropmatchinfo->arbitscores.ins = -3;
+  xdropmatchinfo->arbitscores.del = -3;
+  xdropmatchinfo->frontresource = gt_frontresource_new(100UL);
+  xdropmatchinfo->res = gt_xdrop_resources_new(&xdropmatchinfo->arbitscores);
+  xdropmatchinfo->belowscore = 5L;
+  xdropmatchinfo->outbuffer = NULL;
+}
+
+static void gt_xdropmatchinfo_wipe(GtXdropmatchinfo *xdropmatchinfo)
+{
+  gt_querymatch_delete(xdropmatchinfo->querymatchspaceptr);
+  gt_seqabstract_delete(xdropmatchinfo->useq);
+  gt_seqabstract_delete(xdropmatchinfo->vseq);
+  gt_xdrop_resources_delete(xdropmatchinfo->res);
+  gt_frontresource_delete(xdropmatchinfo->frontresource);
+  gt_str_delete(xdropmatchinfo->outbuffer);
+}
+
+static void gt_xdropmatchinfo_output(GtXdropmatchinfo *xdropmatchinfo,
+                                     const GtEncseq *encseq,
+                                     GtUword query_totallength)
+{
+  if (xdropmatchinfo->outbuffer != NULL)
+  {
+    gt_querymatch_output_str(xdropmatchinfo->outbuffer,encseq,
+                             xdropmatchinfo->querymatchspaceptr,
+                             query_totallength);
+  } else
+  {
+    (void) gt_querymatch_output(NULL,encseq,
+                                xdropmatchinfo->querymatchspaceptr,NULL,
+                                query_totallength,NULL);
+  }
+}
+
 static int gt_simpleexactselfmatchoutput(void *info,
                                          const GtEncseq *encseq,
                                          GtUword len,
@@ -52,7 +112,7 @@ static int gt_simpleexactselfmatchoutput(void *info,
                                          GT_UNUSED GtError *err)
 {
   GtUword queryseqnum, seqstartpos, seqlength;
-  GtQuerymatch *querymatch = (GtQuerymatch *) info;
+  GtXdropmatchinfo *xdropmatchinfo = (GtXdropmatchinfo *) info;
 
   if (pos1 > pos2)
   {
@@ -64,7 +124,7 @@ static int gt_simpleexactselfmatchoutput(void *info,
   seqstartpos = gt_encseq_seqstartpos(encseq, queryseqnum);
   seqlength = gt_encseq_seqlength(encseq, queryseqnum);
   gt_assert(pos2 >= seqstartpos);
-  gt_querymatch_fill(querymatch,
+  gt_querymatch_fill(xdropmatchinfo->querymatchspaceptr,
                      len,
                      pos1,
                      GT_READMODE_FORWARD,
@@ -75,29 +135,16 @@ static int gt_simpleexactselfmatchoutput(void *info,
                      (uint64_t) queryseqnum,
                      len,
                      pos2 - seqstartpos);
-  return gt_querymatch_output(info, encseq, querymatch, NULL, seqlength, err);
+  gt_xdropmatchinfo_output(xdropmatchinfo,encseq,seqlength);
+  return 0;
 }
 
-typedef struct
-{
-  GtQuerymatch *querymatchspaceptr;
-  GtXdropArbitraryscores arbitscores;
-  GtXdropresources *res;
-  GtFrontResource *frontresource;
-  GtXdropbest best_left;
-  GtXdropbest best_right;
-  GtXdropscore belowscore;
-  GtSeqabstract *useq, *vseq;
-  const GtUchar *query_sequence;
-  GtUword query_totallength;
-} GtXdropmatchinfo;
-
 static int gt_simplexdropselfmatchoutput(void *info,
                                          const GtEncseq *encseq,
                                          GtUword len,
                                          GtUword pos1,
                                          GtUword pos2,
-                                         GtError *err)
+                                         GT_UNUSED GtError *err)
 {
   GtXdropmatchinfo *xdropmatchinfo = (GtXdropmatchinfo *) info;
   GtXdropscore score;
@@ -205,9 +252,9 @@ static int gt_simplexdropselfmatchoutput(void *info,
                      (uint64_t) queryseqnum,
                      querylen,
                      querystart - queryseqstartpos);
-  return gt_querymatch_output(info, encseq, xdropmatchinfo->querymatchspaceptr,
-                              NULL, gt_encseq_seqlength(encseq, queryseqnum),
-                              err);
+  gt_xdropmatchinfo_output(xdropmatchinfo,encseq,
+                           gt_encseq_seqlength(encseq, queryseqnum));
+  return 0;
 }
 
 static int gt_processxdropquerymatches(void *info,
@@ -306,7 +353,26 @@ static int gt_processxdropquerymatches(void *info,
                               err);
 }
 
-static int gt_simplesuffixprefixmatchoutput(GT_UNUSED void *info,
+static void gt_suffixprefixmatch_output(GtXdropmatchinfo *xdropmatchinfo,
+                                        GtUword seqnum1,
+                                        GtUword seqnum2,
+                                        GtUword matchlen)
+{
+  if (xdropmatchinfo->outbuffer != NULL)
+  {
+    gt_str_append_ulong(xdropmatchinfo->outbuffer,seqnum1);
+    gt_str_append_char(xdropmatchinfo->outbuffer,' ');
+    gt_str_append_ulong(xdropmatchinfo->outbuffer,seqnum2);
+    gt_str_append_char(xdropmatchinfo->outbuffer,' ');
+    gt_str_append_ulong(xdropmatchinfo->outbuffer,matchlen);
+    gt_str_append_char(xdropmatchinfo->outbuffer,'\n');
+  } else
+  {
+    printf(""GT_WU" "GT_WU" "GT_WU"\n",seqnum1,seqnum2,matchlen);
+  }
+}
+
+static int gt_simplesuffixprefixmatchoutput(void *info,
                                             const GtEncseq *encseq,
                                             GtUword matchlen,
                                             GtUword pos1,
@@ -314,6 +380,7 @@ static int gt_simplesuffixprefixmatchoutput(GT_UNUSED void *info,
                                             GT_UNUSED GtError *err)
 {
   GtUword seqnum1, relpos1, seqnum2, relpos2, seqstartpos;
+  GtXdropmatchinfo *xdropmatchinfo = (GtXdropmatchinfo *) info;
 
   if (pos1 > pos2)
   {
@@ -335,7 +402,7 @@ static int gt_simplesuffixprefixmatchoutput(GT_UNUSED void *info,
 
     if (relpos2 + matchlen == seqlen2)
     {
-      printf(""GT_WU" "GT_WU" "GT_WU"\n",seqnum2,seqnum1,matchlen);
+      gt_suffixprefixmatch_output(xdropmatchinfo,seqnum2,seqnum1,matchlen);
     }
   } else
   {
@@ -345,13 +412,36 @@ static int gt_simplesuffixprefixmatchoutput(GT_UNUSED void *info,
 
       if (relpos1 + matchlen == seqlen1)
       {
-        printf(""GT_WU" "GT_WU" "GT_WU"\n",seqnum1,seqnum2,matchlen);
+        gt_suffixprefixmatch_output(xdropmatchinfo,seqnum1,seqnum2,matchlen);
       }
     }
   }
   return 0;
 }
 
+/* For the parallel enumeration of maximal pairs, every part of the suffix
+   array gets its own extension resources and output buffer. The buffers are
+   shown in the order of the parts, which is the order of the sequential
+   enumeration. */
+static void *gt_repfind_rangeinfo_new(GT_UNUSED void *data)
+{
+  GtXdropmatchinfo *xdropmatchinfo = gt_malloc(sizeof *xdropmatchinfo);
+
+  gt_xdropmatchinfo_init(xdropmatchinfo);
+  xdropmatchinfo->outbuffer = gt_str_new();
+  return xdropmatchinfo;
+}
+
+static void gt_repfind_rangeinfo_done(GT_UNUSED void *data,void *rangeinfo)
+{
+  GtXdropmatchinfo *xdropmatchinfo = rangeinfo;
+
+  gt_xfwrite(gt_str_get_mem(xdropmatchinfo->outbuffer),sizeof (char),
+             (size_t) gt_str_length(xdropmatchinfo->outbuffer),stdout);
+  gt_xdropmatchinfo_wipe(xdropmatchinfo);
+  gt_free(xdropmatchinfo);
+}
+
 static int callenummaxpairs(const char *indexname,
                             unsigned int userdefinedleastlength,
                             bool scanfile,
@@ -377,16 +467,35 @@ static int callenummaxpairs(const char *indexname,
   {
     haserr = true;
   }
-  if (!haserr &&
-      gt_enumeratemaxpairs(ssar,
-                           gt_encseqSequentialsuffixarrayreader(ssar),
-                           gt_readmodeSequentialsuffixarrayreader(ssar),
-                           userdefinedleastlength,
-                           processmaxpairs,
-                           processmaxpairsinfo,
-                           err) != 0)
+  if (!haserr)
   {
-    haserr = true;
+    if (gt_jobs > 1U && !scanfile)
+    {
+      if (gt_enumeratemaxpairs_ranges(ssar,
+                                 gt_encseqSequentialsuffixarrayreader(ssar),
+                                 gt_readmodeSequentialsuffixarrayreader(ssar),
+                                 userdefinedleastlength,
+                                 processmaxpairs,
+                                 gt_repfind_rangeinfo_new,
+                                 gt_repfind_rangeinfo_done,
+                                 NULL,
+                                 err) != 0)
+      {
+        haserr = true;
+      }
+    } else
+    {
+      if (gt_enumeratemaxpairs(ssar,
+                               gt_encseqSequentialsuffixarrayreader(ssar),
+                               gt_readmodeSequentialsuffixarrayreader(ssar),
+                               userdefinedleastlength,
+                               processmaxpairs,
+                               processmaxpairsinfo,
+                               err) != 0)
+      {
+        haserr = true;
+      }
+    }
   }
   if (ssar != NULL)
   {
@@ -521,20 +630,10 @@ static int gt_repfind_runner(GT_UNUSED int argc,
   bool haserr = false;
   Maxpairsoptions *arguments = tool_arguments;
   GtLogger *logger = NULL;
-  GtQuerymatch *querymatchspaceptr = gt_querymatch_new();
   GtXdropmatchinfo xdropmatchinfo;
 
   gt_error_check(err);
-  xdropmatchinfo.querymatchspaceptr = querymatchspaceptr;
-  xdropmatchinfo.useq = gt_seqabstract_new_empty();
-  xdropmatchinfo.vseq = gt_seqabstract_new_empty();
-  xdropmatchinfo.arbitscores.mat = 2;
-  xdropmatchinfo.arbitscores.mis = -2;
-  xdropmatchinfo.arbitscores.ins = -3;
-  xdropmatchinfo.arbitscores.del = -3;
-  xdropmatchinfo.frontresource = gt_frontresource_new(100UL);
-  xdropmatchinfo.res = gt_xdrop_resources_new(&xdropmatchinfo.arbitscores);
-  xdropmatchinfo.belowscore = 5L;
+  gt_xdropmatchinfo_init(&xdropmatchinfo);
   logger = gt_logger_new(arguments->beverbose, GT_LOGGER_DEFLT_PREFIX, stdout);
   if (parsed_args < argc)
   {
@@ -557,9 +656,7 @@ static int gt_repfind_runner(GT_UNUSED int argc,
                                  : (arguments->extendseed
                                      ? gt_simplexdropselfmatchoutput
                                      : gt_simpleexactselfmatchoutput),
-                               arguments->extendseed
-                                 ? (void *) &xdropmatchinfo
-                                 : (void *) querymatchspaceptr,
+                               &xdropmatchinfo,
                                logger,
                                err) != 0)
           {
@@ -618,11 +715,7 @@ static int gt_repfind_runner(GT_UNUSED int argc,
       }
     }
   }
-  gt_querymatch_delete(querymatchspaceptr);
-  gt_seqabstract_delete(xdropmatchinfo.useq);
-  gt_seqabstract_delete(xdropmatchinfo.vseq);
-  gt_xdrop_resources_delete(xdropmatchinfo.res);
-  gt_frontresource_delete(xdropmatchinfo.frontresource);
+  gt_xdropmatchinfo_wipe(&xdropmatchinfo);
   gt_logger_delete(logger);
   return haserr ? -1 : 0;
 }
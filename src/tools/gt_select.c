@@ -39,6 +39,7 @@
 typedef struct {
   bool verbose,
        has_CDS,
+       useindex,
        targetbest;
   GtStr *seqid,
         *source,
@@ -98,8 +99,8 @@ static GtOptionParser* gt_select_option_parser_new(void *tool_arguments)
 {
   SelectArguments *arguments = tool_arguments;
   GtOptionParser *op;
-  GtOption *option, *contain_option, *overlap_option, *minaveragessp_option,
-           *singleintron_option, *optiondroppedfile;
+  GtOption *option, *seqid_option, *contain_option, *overlap_option,
+           *minaveragessp_option, *singleintron_option, *optiondroppedfile;
   gt_assert(arguments);
 
   static const char *filter_logic[] = {
@@ -114,10 +115,10 @@ static GtOptionParser* gt_select_option_parser_new(void *tool_arguments)
                             "options) from given GFF3 file(s).");
 
   /* -seqid */
-  option = gt_option_new_string("seqid", "select feature with the given "
-                                "sequence ID (all comments are selected). ",
-                                arguments->seqid, NULL);
-  gt_option_parser_add_option(op, option);
+  seqid_option = gt_option_new_string("seqid", "select feature with the given "
+                                      "sequence ID (all comments are "
+                                      "selected). ", arguments->seqid, NULL);
+  gt_option_parser_add_option(op, seqid_option);
 
   /* -source */
   option = gt_option_new_string("source", "select feature with the given "
@@ -137,6 +138,16 @@ static GtOptionParser* gt_select_option_parser_new(void *tool_arguments)
                                        &arguments->overlap_range, NULL);
   gt_option_parser_add_option(op, overlap_option);
 
+  /* -index */
+  option = gt_option_new_bool("index", "only read the part of the single "
+                              "input file which can contain features on the "
+                              "sequence ID given with -seqid in the range "
+                              "given with -contain or -overlap, using the "
+                              "index built with 'gt gff3index' (comments are "
+                              "not selected)", &arguments->useindex, false);
+  gt_option_imply(option, seqid_option);
+  gt_option_parser_add_option(op, option);
+
   /* -strand */
   option = gt_option_new_string(GT_STRAND_OPT, "select all top-level features"
                                 "(i.e., features without parents) whose strand "
@@ -334,6 +345,25 @@ static int gt_select_runner(int argc, const char **argv, int parsed_args,
   if (arguments->verbose && arguments->outfp)
     gt_gff3_in_stream_show_progress_bar((GtGFF3InStream*) gff3_in_stream);
 
+  /* restrict to the selected region (if necessary) */
+  if (arguments->useindex) {
+    GtRange range;
+    if (arguments->overlap_range.start != GT_UNDEF_UWORD)
+      range = arguments->overlap_range;
+    else if (arguments->contain_range.start != GT_UNDEF_UWORD)
+      range = arguments->contain_range;
+    else {
+      range.start = 1;
+      range.end = GT_UWORD_MAX;
+    }
+    if (gt_gff3_in_stream_restrict_to_region(gff3_in_stream,
+                                             gt_str_get(arguments->seqid),
+                                             &range, err)) {
+      gt_node_stream_delete(gff3_in_stream);
+      return -1;
+    }
+  }
+
   /* create a filter stream */
   select_stream = gt_select_stream_new(gff3_in_stream, arguments->seqid,
                                        arguments->source,
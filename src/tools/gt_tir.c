@@ -34,7 +34,7 @@
 
 /* struct with all arguments */
 typedef struct {
-  GtStr *str_indexname, *cutoffs;
+  GtStr *str_indexname, *cutoffs, *pdomsearch;
   GtUword min_seed_length,
                 min_TIR_length,
                 max_TIR_length,
@@ -54,6 +54,7 @@ typedef struct {
   GtOption *optionoverlaps;
   GtStrArray *hmm_files;
   GtPdomCutoff cutoff;
+  GtPdomSearch search;
 } GtTirArguments;
 
 static void* gt_tir_arguments_new(void)
@@ -62,6 +63,7 @@ static void* gt_tir_arguments_new(void)
   arguments->str_indexname = gt_str_new();
   arguments->str_overlaps = gt_str_new();
   arguments->cutoffs = gt_str_new();
+  arguments->pdomsearch = gt_str_new();
   arguments->hmm_files = gt_str_array_new();
   return arguments;
 }
@@ -72,6 +74,7 @@ static void gt_tir_arguments_delete(void *tool_arguments)
   if (!arguments) return;
   gt_str_delete(arguments->str_indexname);
   gt_str_delete(arguments->cutoffs);
+  gt_str_delete(arguments->pdomsearch);
   gt_str_delete(arguments->str_overlaps);
   gt_str_array_delete(arguments->hmm_files);
   gt_option_delete(arguments->optionoverlaps);
@@ -101,6 +104,7 @@ static GtOptionParser* gt_tir_option_parser_new(void *tool_arguments)
            *optionhmms,
            *optionevalcutoff,
            *optionpdomcutoff,
+           *optionpdomsearch,
            *optionmaxgap;
   static const char *overlaps[] = {
     "best", /* default */
@@ -114,6 +118,11 @@ static GtOptionParser* gt_tir_option_parser_new(void *tool_arguments)
     "TC",
     NULL
   };
+  static const char *searches[] = {
+    "hmmscan", /* default */
+    "builtin",
+    NULL
+  };
   gt_assert(arguments);
 
   /* init */
@@ -276,6 +285,19 @@ static GtOptionParser* gt_tir_option_parser_new(void *tool_arguments)
 
   /* XXX: make -pdomcutoff and -pdomevalcutoff mutually exclusive */
 
+  optionpdomsearch = gt_option_new_choice("pdomsearch",
+                                       "program used for the pHMM search\n"
+                                       "choose from hmmscan (external HMMER3 "
+                                       "hmmscan) | builtin (in-process, "
+                                       "requires the chosen cutoffs in the "
+                                       "models, no domain envelopes or bias "
+                                       "correction)",
+                                       arguments->pdomsearch, searches[0],
+                                       searches);
+  gt_option_parser_add_option(op, optionpdomsearch);
+  gt_option_is_extended_option(optionpdomsearch);
+  gt_option_imply(optionpdomsearch, optionhmms);
+
   optionmaxgap = gt_option_new_uint("maxgaplen",
                          "maximal allowed gap size between fragments (in amino "
                          "acids) when chaining pHMM hits for a protein domain",
@@ -388,20 +410,25 @@ static int gt_tir_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
       gt_error_set(err, "invalid cutoff setting!");
       had_err = -1;
     }
+    if (!strcmp(gt_str_get(arguments->pdomsearch), "builtin"))
+      arguments->search = GT_PDOM_SEARCH_BUILTIN;
+    else
+      arguments->search = GT_PDOM_SEARCH_HMMSCAN;
   }
 
   if (!had_err && gt_str_array_size(arguments->hmm_files) > 0) {
     GtNodeVisitor *pdom_v;
-    ms = gt_pdom_model_set_new(arguments->hmm_files, err);
+    ms = gt_pdom_model_set_new(arguments->hmm_files, arguments->search, err);
     if (ms != NULL) {
-      pdom_v = gt_ltrdigest_pdom_visitor_new(ms, arguments->cutoff,
+      pdom_v = gt_ltrdigest_pdom_visitor_new(ms, arguments->evalue_cutoff,
                                              arguments->chain_max_gap_length,
-                                             arguments->evalue_cutoff, rmap,
-                                             err);
+                                             arguments->cutoff, rmap, err);
       if (pdom_v == NULL)
         had_err = -1;
       if (!had_err) {
-        last_stream = pdom_stream = gt_visitor_stream_new(last_stream, pdom_v);
+        last_stream = pdom_stream =
+                  gt_visitor_stream_new_batched(last_stream, pdom_v,
+                                         gt_ltrdigest_pdom_visitor_visit_nodes);
         gt_ltrdigest_pdom_visitor_set_root_type((GtLTRdigestPdomVisitor*)
                                                                         pdom_v,
                                         gt_ft_terminal_inverted_repeat_element);
@@ -328,6 +328,26 @@ Test do
   grep last_stderr, /can only be used with the/
 end
 
+Name "gt encseq decode multithreaded"
+Keywords "encseq gt_encseq_decode threads"
+Test do
+  [["#{$testdata}Atinsert.fna", "direct"],
+   ["#{$testdata}RandomN.fna", "bit"],
+   ["#{$testdata}RandomN.fna", "uchar"],
+   ["#{$testdata}sw100K1.fsa", "direct"]].each do |s, sat|
+    run "#{$bin}gt encseq encode -sat #{sat} -indexname foo #{s}"
+    (s =~ /sw100K/ ? STDREADMODES : DNAREADMODES).each do |readmode|
+      ["fasta", "concat"].each do |output|
+        run_test "#{$bin}gt encseq decode -output #{output} " + \
+                 "-dir #{readmode} foo > single.out"
+        run_test "#{$bin}gt -j 4 encseq decode -output #{output} " + \
+                 "-dir #{readmode} foo > multi.out"
+        run "cmp single.out multi.out"
+      end
+    end
+  end
+end
+
 Name "gt encseq Lua bindings"
 Keywords "encseq gt_scripts "
 Test do
@@ -425,3 +445,106 @@ Test do
     end
   end
 end
+
+# MD5 sums of the files written by `gt encseq encode' on a 64-bit platform
+# for the given input files, which are copied to the test directory, so that
+# the paths stored in the .esq file do not depend on the location of the tree.
+# The first input is large enough to have the two bit encoding written in
+# several parts.
+ENCSEQ_ENCODE_MD5 =
+  [["", ["at1MB", "nGASP/III.fas", "at1MB", "at1MB"],
+    {"esq" => "083d241c0de75fb55092f24ddcaaece3",
+     "ssp" => "5dc0aa9c2e9b9df852f6cabb3543a9ba",
+     "des" => "8a6a11ad5402e5343ca217adb65572ee"}],
+   ["-sat direct", ["at1MB", "Atinsert.fna", "RandomN.fna"],
+    {"esq" => "5229f1bba7c914d36f4fab388ca49804",
+     "ssp" => "b04b4cbf7c46b0cbb0808d1a4eb12c08",
+     "des" => "0c2efbb0b32296909ae439576f0326f6"}],
+   ["-sat bit", ["at1MB", "Atinsert.fna", "RandomN.fna"],
+    {"esq" => "9f1ec56d32d83805928795ee6cde061b",
+     "ssp" => "b04b4cbf7c46b0cbb0808d1a4eb12c08",
+     "des" => "0c2efbb0b32296909ae439576f0326f6"}],
+   ["-sat uchar", ["at1MB", "Atinsert.fna", "RandomN.fna"],
+    {"esq" => "f8f4e3bd3a4a8bf060424353f9b334d6",
+     "ssp" => "b04b4cbf7c46b0cbb0808d1a4eb12c08",
+     "des" => "0c2efbb0b32296909ae439576f0326f6"}],
+   ["-sat ushort", ["at1MB", "Atinsert.fna", "RandomN.fna"],
+    {"esq" => "9fea1b249c17b6e77f33b0f45e8bfe77",
+     "ssp" => "b04b4cbf7c46b0cbb0808d1a4eb12c08",
+     "des" => "0c2efbb0b32296909ae439576f0326f6"}],
+   ["-sat uint32", ["at1MB", "Atinsert.fna", "RandomN.fna"],
+    {"esq" => "b84307fb45723cd12ab2da0369fa18cf",
+     "ssp" => "b04b4cbf7c46b0cbb0808d1a4eb12c08",
+     "des" => "0c2efbb0b32296909ae439576f0326f6"}],
+   ["", ["test1.fastq"],
+    {"esq" => "b6b03841300fd7bf15ed3cf1cd5f0481",
+     "des" => "67aca27c320dcdd79f4db84e63c254ef"}],
+   ["", ["csr_testcase.fastq", "description_test.fastq"],
+    {"esq" => "e8f034f8778697cdbcd38ce742267338",
+     "ssp" => "85484c3c94dedef257f361b6df8c404c",
+     "des" => "1e0821f0df512906c0288a141d433927"}],
+   ["", ["sw100K1.fsa", "sw100K2.fsa", "trembl.faa"],
+    {"esq" => "4bcdeab27c9c3a1fef31646f6d9cecb9",
+     "ssp" => "dc4f8f1a448d12805cf2b087bcefcd5e",
+     "des" => "4822ae3df79f07e9eff0d55e9c4f40b4"}],
+   ["", ["trembl-eqlen.faa"],
+    {"esq" => "9e4af007e4de50f14795126afcd43f34",
+     "ssp" => "a4adffa780cfea668060a2b8937da55c",
+     "des" => "6d51b95ba718d8479ce93ab222695465"}]]
+
+ENCSEQ_ENCODE_MD5.each do |opts, files, md5s|
+  Name "gt encseq encode output unchanged " + \
+       "(#{([opts] + files).reject { |a| a.empty? }.join(' ')})"
+  Keywords "encseq gt_encseq_encode encseq_file_format"
+  Test do
+    if Kernel.system("#{$bin}gt -64bit") then
+      require 'digest/md5'
+      files.uniq.each do |file|
+        run "cp #{$testdata}#{file} ."
+      end
+      run_test "#{$bin}gt encseq encode #{opts} -indexname foo " + \
+               files.map { |file| File.basename(file) }.join(" "), \
+               :maxtime => 120
+      md5s.each do |sfx, md5|
+        if Digest::MD5.file("foo.#{sfx}").hexdigest != md5 then
+          raise TestFailedError
+        end
+      end
+    end
+  end
+end
+
+# Writes reads of the given lengths to a FASTQ file. Together the two files
+# written below have reads ending exactly at and reads crossing the
+# boundaries of the internal sequence buffer, whose size is a power of two
+# between 8KB and 64KB.
+def write_boundary_fastq(filename, lengths, firstnum)
+  File.open(filename, "w") do |f|
+    lengths.each_with_index do |len, i|
+      seq = ("acgtacgtnacg" * (len / 12 + 1))[0, len]
+      f.puts "@read#{firstnum + i}", seq, "+", "I" * len
+    end
+  end
+end
+
+Name "gt encseq encode FASTQ lengths across buffer boundaries"
+Keywords "encseq gt_encseq_encode encseq_file_format"
+Test do
+  write_boundary_fastq("boundaries1.fastq", [8192] + [5000] * 6, 0)
+  write_boundary_fastq("boundaries2.fastq", [5000] * 5 + [2332] + [5000] * 3,
+                       7)
+  run_test "#{$bin}gt encseq encode -indexname foo boundaries1.fastq " + \
+           "boundaries2.fastq"
+  run_test "#{$bin}gt encseq info foo"
+  grep(last_stdout, /^total length: 80539$/)
+  # every read and its separator count for the file it belongs to
+  grep(last_stdout, /boundaries1.fastq \(38199 characters\)/)
+  grep(last_stdout, /boundaries2.fastq \(42340 characters\)/)
+  if Kernel.system("#{$bin}gt -64bit") then
+    require 'digest/md5'
+    if Digest::MD5.file("foo.esq").hexdigest != \
+       "0d55a9865eeff7a855938345420e4c56" then
+      raise TestFailedError
+    end
+  end
+end
@@ -1,3 +1,10 @@
+FEATUREINDEX_TEST_FILES = ["#{$testdata}/eden.gff3",
+                           "#{$testdata}/standard_gene_simple.gff3",
+                           "#{$testdata}/standard_gene_as_tree.gff3",
+                           "#{$testdata}/standard_gene_with_introns_as_tree.gff3",
+                           "#{$testdata}/encode_known_genes_Mar07.gff3"
+                           ]
+
 if not $arguments["nordb"] then
 
   Name "gt featureindex (empty file)"
@@ -42,13 +49,6 @@ if not $arguments["nordb"] then
     run "#{$bin}gt featureindex -filename corrupt.db", :retval => 1
   end
 
-  FEATUREINDEX_TEST_FILES = ["#{$testdata}/eden.gff3",
-                             "#{$testdata}/standard_gene_simple.gff3",
-                             "#{$testdata}/standard_gene_as_tree.gff3",
-                             "#{$testdata}/standard_gene_with_introns_as_tree.gff3",
-                             "#{$testdata}/encode_known_genes_Mar07.gff3"
-                             ]
-
   FEATUREINDEX_TEST_FILES.each do |file|
     Name "gt featureindex db vs. parser (#{File.basename(file)})"
     Keywords "gt_featureindex"
@@ -66,3 +66,71 @@ if not $arguments["nordb"] then
   end
 
 end
+
+Name "gt featureindex disk (empty file)"
+Keywords "gt_featureindex disk"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/gt_view_prob_1.gff3"
+  run "#{$bin}gt featureindex -backend disk -filename tmp.idx", :retval => 1
+  grep(last_stderr, /no sequence regions in index/)
+end
+
+Name "gt featureindex disk (empty region)"
+Keywords "gt_featureindex disk"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/gt_view_prob_2.gff3"
+  run "#{$bin}gt featureindex -backend disk -filename tmp.idx"
+  run "diff #{last_stdout} #{$testdata}/gt_view_prob_2.gff3"
+end
+
+Name "gt featureindex disk (existing file)"
+Keywords "gt_featureindex disk"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/eden.gff3"
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/eden.gff3", :retval => 1
+  grep(last_stderr, /exists already/)
+  run "#{$bin}gt mkfeatureindex -backend disk -force -filename tmp.idx #{$testdata}/eden.gff3"
+end
+
+Name "gt featureindex disk (invalid sequence ID)"
+Keywords "gt_featureindex disk"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/standard_gene_simple.gff3"
+  run "#{$bin}gt featureindex -backend disk -seqid foo -filename tmp.idx", :retval => 1
+  grep(last_stderr, /not contain/)
+end
+
+Name "gt featureindex disk (corrupt file)"
+Keywords "gt_featureindex disk"
+Test do
+  File.open("corrupt.idx", "w") do |file|
+    file.write("sdfnhsnl")
+  end
+  run "#{$bin}gt featureindex -backend disk -filename corrupt.idx", :retval => 1
+  grep(last_stderr, /is not a feature index/)
+end
+
+Name "gt featureindex disk (range query)"
+Keywords "gt_featureindex disk"
+Test do
+  run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{$testdata}/encode_known_genes_Mar07.gff3"
+  run "#{$bin}gt featureindex -backend disk -seqid chr1 -range 148325000 148370000 -retain no -filename tmp.idx > out.gff3"
+  run "#{$bin}gt gff3 -retainids no #{$testdata}/encode_known_genes_Mar07.gff3 | #{$bin}gt select -seqid chr1 -overlap 148325000 148370000"
+  run "diff -I '^##sequence-region' out.gff3 #{last_stdout}"
+end
+
+FEATUREINDEX_TEST_FILES.each do |file|
+  Name "gt featureindex disk vs. parser (#{File.basename(file)})"
+  Keywords "gt_featureindex disk"
+  Test do
+    run "#{$bin}gt seqids #{file}"
+    seqids = File.open(last_stdout).readlines
+    run "#{$bin}gt mkfeatureindex -backend disk -filename tmp.idx #{file}"
+    seqids.each do |seqid|
+      seqid.chomp!
+      run "#{$bin}gt featureindex -backend disk -seqid #{seqid} -retain no -filename tmp.idx > out.gff3"
+      run "#{$bin}gt gff3 -retainids no #{file} | #{$bin}gt select -seqid #{seqid}"
+      run "diff out.gff3 #{last_stdout}"
+    end
+  end
+end
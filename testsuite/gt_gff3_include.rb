@@ -1269,6 +1269,159 @@ Test do
   grep last_stderr, "wrong separator"
 end
 
+{"encode_known_genes_Mar07.gff3" => 0, "standard_gene_as_tree.gff3" => 0,
+ "fasta_seq.gff3" => 0, "cds_with_multiple_parents_2_tidied.gff3" => 0,
+ "md5_seqid_missing_seqid.gff3" => 1}.each do |file, retval|
+  Name "gt gff3 parallel parsing (#{file})"
+  Keywords "gt_gff3 parallel"
+  Test do
+    run_test("#{$bin}gt gff3 #{$testdata}#{file}", :retval => retval)
+    serial_stdout, serial_stderr = last_stdout, last_stderr
+    run_test("#{$bin}gt -j 4 gff3 #{$testdata}#{file}", :retval => retval)
+    parallel_stdout, parallel_stderr = last_stdout, last_stderr
+    run "diff #{parallel_stdout} #{serial_stdout}"
+    run "diff #{parallel_stderr} #{serial_stderr}"
+  end
+end
+
+Name "gt gff3 -sort -memlimit (spill to disk)"
+Keywords "gt_gff3 memlimit"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  inmemory_stdout = last_stdout
+  run_test "#{$bin}gt gff3 -sort -memlimit 1MB " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "diff #{last_stdout} #{inmemory_stdout}"
+end
+
+# Write <genes> genes with an mRNA and three exons each to <filename>, all
+# carrying a long Note attribute. The genes are written in scrambled order.
+def write_attribute_heavy_gff3(filename, genes)
+  note = "x" * 300
+  File.open(filename, "w") do |f|
+    f.puts "##gff-version 3"
+    genes.times do |n|
+      i = (n * 7919) % genes
+      seqid = "chr#{i % 3}"
+      start = 1000 + i * 1000
+      f.puts [seqid, "gen", "gene", start, start + 800, ".", "+", ".",
+              "ID=gene#{i};Note=#{note};Alias=a#{i},b#{i}"].join("\t")
+      f.puts [seqid, "gen", "mRNA", start, start + 800, ".", "+", ".",
+              "ID=gene#{i}.t;Parent=gene#{i};Note=#{note}"].join("\t")
+      3.times do |e|
+        f.puts [seqid, "gen", "exon", start + e * 300, start + e * 300 + 200,
+                ".", "+", ".",
+                "Parent=gene#{i}.t;Note=#{note};exon_number=#{e}"].join("\t")
+      end
+    end
+  end
+end
+
+Name "gt gff3 -sort -memlimit (attribute-heavy input)"
+Keywords "gt_gff3 memlimit"
+Test do
+  write_attribute_heavy_gff3("heavy.gff3", 6000)
+  run_test "#{$bin}gt gff3 -sort heavy.gff3"
+  inmemory_stdout = last_stdout
+  run_test "#{$bin}gt -debug gff3 -sort -memlimit 1MB heavy.gff3"
+  # the long attributes are accounted for (about 16MB in total)
+  if File.open(last_stderr).read.scan(/wrote run/).length < 10 then
+    raise TestFailedError
+  end
+  run "diff #{last_stdout} #{inmemory_stdout}"
+end
+
+Name "gt gff3 -sort -memlimit (more than 64 runs)"
+Keywords "gt_gff3 memlimit"
+Test do
+  write_attribute_heavy_gff3("heavy.gff3", 26000)
+  run_test "#{$bin}gt gff3 -sort heavy.gff3", :maxtime => 600
+  inmemory_stdout = last_stdout
+  run_test "#{$bin}gt -debug gff3 -sort -memlimit 1MB heavy.gff3",
+           :maxtime => 600
+  grep last_stderr, /merging \d+ runs in groups of at most 64/
+  run "diff #{last_stdout} #{inmemory_stdout}"
+end
+
+Name "gt gff3 -memlimit (invalid argument)"
+Keywords "gt_gff3 memlimit"
+Test do
+  run_test("#{$bin}gt gff3 -sort -memlimit 100 " +
+           "#{$testdata}standard_gene_as_tree.gff3", :retval => 1)
+  grep last_stderr, "option -memlimit must have"
+end
+
+Name "gt gff3 -bgzip"
+Keywords "gt_gff3 bgzip"
+Test do
+  run_test "#{$bin}gt gff3 -sort #{$testdata}encode_known_genes_Mar07.gff3"
+  sorted_stdout = last_stdout
+  run_test "#{$bin}gt gff3 -sort -bgzip -o sorted.gff3.gz " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run "gzip -dc sorted.gff3.gz"
+  run "diff #{last_stdout} #{sorted_stdout}"
+end
+
+Name "gt gff3index (region queries)"
+Keywords "gt_gff3 gff3index"
+Test do
+  run_test "#{$bin}gt gff3 -sort -bgzip -o sorted.gff3.gz " +
+           "#{$testdata}encode_known_genes_Mar07.gff3"
+  run_test "#{$bin}gt gff3index sorted.gff3.gz"
+  [["chr1", 148000000, 148100000], ["chr11", 1, 1710216],
+   ["chr22", 30500000, 31000000], ["chrX", 153939916, 160000000]].each do |r|
+    run_test "#{$bin}gt select -seqid #{r[0]} -overlap #{r[1]} #{r[2]} " +
+             "#{$testdata}encode_known_genes_Mar07.gff3"
+    run_test "#{$bin}gt gff3 -sort #{last_stdout}"
+    run "grep -v '^#' #{last_stdout} > expected.gff3; true"
+    run_test "#{$bin}gt gff3 -seqid #{r[0]} -overlap #{r[1]} #{r[2]} " +
+             "sorted.gff3.gz"
+    run "grep -v '^#' #{last_stdout} > region.gff3; true"
+    run "diff region.gff3 expected.gff3"
+    run_test "#{$bin}gt select -index -seqid #{r[0]} -overlap #{r[1]} " +
+             "#{r[2]} sorted.gff3.gz"
+    run "grep -v '^#' #{last_stdout} > region.gff3; true"
+    run "diff region.gff3 expected.gff3"
+  end
+end
+
+Name "gt gff3 -seqid (FASTA section)"
+Keywords "gt_gff3 gff3index"
+Test do
+  run_test "#{$bin}gt gff3 -sort -bgzip -o sorted.gff3.gz " +
+           "#{$testdata}standard_fasta_example.gff3"
+  run_test "#{$bin}gt gff3index sorted.gff3.gz"
+  run_test "#{$bin}gt gff3 -seqid ctg123 -overlap 7500 8000 sorted.gff3.gz"
+  grep last_stdout, "^##sequence-region   ctg123 1 1497228"
+  grep last_stdout, "cDNA_match\t7000\t9000"
+end
+
+Name "gt gff3 -seqid (file not indexed)"
+Keywords "gt_gff3 gff3index"
+Test do
+  run_test "#{$bin}gt gff3 -sort -bgzip -o sorted.gff3.gz " +
+           "#{$testdata}standard_gene_as_tree.gff3"
+  run_test("#{$bin}gt gff3 -seqid ctg123 sorted.gff3.gz", :retval => 1)
+  grep last_stderr, "has not been indexed"
+end
+
+Name "gt gff3index (file not BGZF compressed)"
+Keywords "gt_gff3 gff3index"
+Test do
+  run_test("#{$bin}gt gff3index #{$testdata}standard_gene_as_tree.gff3",
+           :retval => 1)
+  grep last_stderr, "is not BGZF compressed"
+end
+
+Name "gt gff3index (unsorted file)"
+Keywords "gt_gff3 gff3index"
+Test do
+  run_test "#{$bin}gt gff3 -bgzip -o unsorted.gff3.gz " +
+           "#{$testdata}unsorted_gff3_file.txt"
+  run_test("#{$bin}gt gff3index unsorted.gff3.gz", :retval => 1)
+  grep last_stderr, "is not sorted"
+end
+
 def large_gff3_test(name, file)
   Name "gt gff3 #{name}"
   Keywords "gt_gff3 large_gff3"
@@ -1325,3 +1478,19 @@ if $gttestdata then
     run      "diff #{last_stdout} #{$gttestdata}gff3testruns/ensembl.gff3"
   end
 end
+
+Name "gt gff3 parallel parsing without memory bookkeeping"
+Keywords "gt_gff3 parallel"
+Test do
+  # The testsuite runs with GT_MEM_BOOKKEEPING=on, where every slab block is
+  # allocated separately. Without it, the parser threads share the chunks and
+  # free lists of the slabs holding nodes, attributes and child lists.
+  write_attribute_heavy_gff3("heavy.gff3", 20000)
+  run_test "#{$bin}gt gff3 -sort heavy.gff3", :maxtime => 300
+  serial_stdout = last_stdout
+  [2, 8].each do |jobs|
+    run_test "env GT_MEM_BOOKKEEPING=off #{$bin}gt -j #{jobs} gff3 -sort " + \
+             "heavy.gff3", :maxtime => 300
+    run "diff #{last_stdout} #{serial_stdout}"
+  end
+end
@@ -0,0 +1,73 @@
+def gth_prepare_U89959
+  run "cp #{$testdata}U89959_genomic.fas ."
+  run_test "#{$bin}gt extractfeat -type exon -join " +
+           "-seqfile U89959_genomic.fas #{$testdata}U89959_csas.gff3"
+  run "mv #{last_stdout} U89959_cdnas.fas"
+  run_test "#{$bin}gt extractfeat -type CDS -join -translate " +
+           "-seqfile U89959_genomic.fas #{$testdata}U89959_cds.gff3"
+  run "mv #{last_stdout} U89959_proteins.fas"
+end
+
+[["-cdna U89959_cdnas.fas", "cDNA"],
+ ["-protein U89959_proteins.fas -scorematrix #{$testdata}BLOSUM62",
+  "protein"]].each do |ref, type|
+  Name "gt dev gth -j 1 vs. -j 4 (U89959 #{type})"
+  Keywords "gt_gth gth_jobs"
+  Test do
+    gth_prepare_U89959
+    [1, 4].each do |jobs|
+      run_test "#{$bin}gt dev gth -genomic U89959_genomic.fas #{ref} " +
+               "-j #{jobs}", :maxtime => 120
+      run "grep -v '^\\$' #{last_stdout} > gth.j#{jobs}.out"
+    end
+    run "diff gth.j1.out gth.j4.out"
+    grep "gth.j1.out", /^MATCH/
+  end
+end
+
+# returns the genomic ranges of the spliced alignments in <file> for every
+# cDNA, taken from the Target attributes of its genes (old format) or of its
+# mRNAs (the predicted gene locations, which can contain several cDNAs)
+def gth_target_ranges(file)
+  ranges = Hash.new { |h, k| h[k] = [] }
+  File.foreach(file) do |line|
+    cols = line.split("\t")
+    next unless ["gene", "mRNA"].include?(cols[2]) and
+                line =~ /Target=([^;\n]+)/
+    $1.split(",").each do |target|
+      ranges[target.split(" ")[0]].push([cols[3].to_i, cols[4].to_i])
+    end
+  end
+  ranges
+end
+
+# U89959_sas.gff3 contains the spliced alignments computed by gth with the
+# vmatch based matcher
+Name "gt dev gth built-in matcher vs. vmatch (U89959 ESTs)"
+Keywords "gt_gth gth_builtinmatcher"
+Test do
+  run "cp #{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas ."
+  run_test "#{$bin}gt dev gth -genomic U89959_genomic.fas " +
+           "-cdna U89959_ests.fas -gff3out -skipalignmentout", :maxtime => 120
+  vmatch = gth_target_ranges("#{$testdata}U89959_sas.gff3")
+  builtin = gth_target_ranges(last_stdout)
+  [[vmatch, builtin], [builtin, vmatch]].each do |from, to|
+    from.each do |target, ranges|
+      ranges.each do |s, e|
+        if not to[target].any? { |ts, te| ts <= e and s <= te }
+          failtest("spliced alignment of #{target} at #{s}-#{e} not found")
+        end
+      end
+    end
+  end
+end
+
+["-online", "-inverse", "-edist", "-maskpolyatails"].each do |opt|
+  Name "gt dev gth built-in matcher does not support #{opt}"
+  Keywords "gt_gth gth_builtinmatcher"
+  Test do
+    run_test "#{$bin}gt dev gth -genomic #{$testdata}U89959_genomic.fas " +
+             "-cdna #{$testdata}U89959_ests.fas #{opt}", :retval => 1
+    grep last_stderr, /option "#{opt}" is not supported by the built-in matcher/
+  end
+end
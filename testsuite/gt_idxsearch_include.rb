@@ -55,8 +55,21 @@ def checktagerator(queryfile,ms)
     run_test "#{$bin}gt prebwt -maxdepth 4 -pck pck", :maxtime => 180
     run_test("#{$bin}gt tagerator -rw -cmp -e 0 -pck pck -q patternfile",
              :maxtime => 240)
+    run "#{$bin}gt -j 4 tagerator -rw -e 0 -pck pck -q patternfile " +
+        "-output dbstartpos strand | grep -v '^# indexname' | sort > tmp.pck"
+    run "#{$bin}gt tagerator -rw -e 0 -esa sfx -q patternfile " +
+        "-output dbstartpos strand | grep -v '^# indexname' | sort > tmp.esa"
+    run "diff tmp.esa tmp.pck"
     run_test("#{$bin}gt tagerator -rw -cmp -e 1 -pck pck -q patternfile",
              :maxtime => 240)
+    # -best searches exact matches with the index first
+    run "#{$bin}gt tagerator -rw -e 1 -best -pck pck -q patternfile " +
+        "-output dbstartpos dbsequence | grep -v '^# indexname' | " +
+        "sort > tmp.pck"
+    run "#{$bin}gt tagerator -rw -e 1 -best -esa sfx -q patternfile " +
+        "-output dbstartpos dbsequence | grep -v '^# indexname' | " +
+        "sort > tmp.esa"
+    run "diff tmp.esa tmp.pck"
     run_test("#{$bin}gt tagerator -rw -cmp -e 2 -pck pck -q patternfile",
              :maxtime => 240)
     run_test("#{$bin}gt tagerator -rw -cmp -pck pck -q patternfile " +
@@ -155,6 +168,21 @@ Test do
   run_test "#{$bin}gt repfind -samples 40 -l 6 -ii sfx",:maxtime => 600
 end
 
+Name "gt repfind multithreaded"
+Keywords "gt_repfind"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB " +
+           "-indexname sfx -dna -tis -suf -lcp -ssp"
+  ["-l 8","-l 20 -extend","-l 16 -r","-l 25 -spm"].each do |args|
+    run_test "#{$bin}gt repfind #{args} -ii sfx"
+    run "mv #{last_stdout} repfind.out"
+    run_test "#{$bin}gt -j 4 repfind #{args} -ii sfx"
+    run "cmp -s #{last_stdout} repfind.out"
+  end
+  run_test "#{$bin}gt -j 4 repfind -l 20 -extend -ii sfx"
+  run "diff #{last_stdout} #{$testdata}repfind-20-extend.txt"
+end
+
 if $gttestdata then
   Name "gt repfind extend at1MB"
   Keywords "gt_repfind extend"
@@ -0,0 +1,44 @@
+Name "gt ltrclustering"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname genome " + \
+           "#{$testdata}ltrclustering/genome.fas"
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrclustering -psmall 80 -plarge 20 " + \
+             "genome #{$testdata}ltrclustering/ltrharvest.gff3"
+    run "diff #{last_stdout} #{$testdata}ltrclustering/ltrclustering.gff3"
+  end
+end
+
+Name "gt ltrclustering missing options"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname genome " + \
+           "#{$testdata}ltrclustering/genome.fas"
+  run_test "#{$bin}gt ltrclustering -psmall 80 genome " + \
+           "#{$testdata}ltrclustering/ltrharvest.gff3", :retval => 1
+  grep(last_stderr, /option "-plarge" is mandatory/)
+end
+
+Name "gt ltrclustering default seedlength and xdrop"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname genome " + \
+           "#{$testdata}ltrclustering/genome.fas"
+  run_test "#{$bin}gt ltrclustering -psmall 80 -plarge 20 -seedlength 14 " + \
+           "-xdrop 20 genome #{$testdata}ltrclustering/ltrharvest.gff3"
+  run "diff #{last_stdout} #{$testdata}ltrclustering/ltrclustering.gff3"
+end
+
+Name "gt ltrclustering -seedlength"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname genome " + \
+           "#{$testdata}ltrclustering/genome.fas"
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrclustering -psmall 80 -plarge 20 " + \
+             "-seedlength 30 genome #{$testdata}ltrclustering/ltrharvest.gff3"
+    run "diff #{last_stdout} " + \
+        "#{$testdata}ltrclustering/ltrclustering_seedlength30.gff3"
+  end
+end
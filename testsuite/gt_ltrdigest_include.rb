@@ -185,6 +185,125 @@ def check_amino_acid_output(gff3file, chr, pdoms)
   end
 end
 
+# returns the protein domain hits in <gff3file> by element, domain and strand
+def protein_matches(gff3file)
+  hits = {}
+  File.foreach(gff3file) do |line|
+    fields = line.chomp.split("\t")
+    next unless fields[2] == "protein_match"
+    parent = fields[8][/Parent=([^;]+)/, 1]
+    name = fields[8][/name=([^;]+)/, 1]
+    key = [parent, name, fields[6]]
+    (hits[key] ||= []).push(fields[3].to_i..fields[4].to_i)
+  end
+  hits
+end
+
+# every hit in <hits> must overlap a hit of the same domain in <otherhits>
+def check_protein_matches(hits, otherhits, what)
+  if hits.keys.sort != otherhits.keys.sort then
+    failtest("#{what}: domains differ: " + \
+             "#{(hits.keys - otherhits.keys).inspect} vs. " + \
+             "#{(otherhits.keys - hits.keys).inspect}")
+  end
+  hits.each do |key, ranges|
+    ranges.each do |r|
+      unless otherhits[key].any? {|o| o.first <= r.last && r.first <= o.last}
+        failtest("#{what}: hit #{key.inspect} #{r} has no counterpart")
+      end
+    end
+  end
+end
+
+Name "gt ltrdigest PBS search"
+Keywords "gt_ltrdigest pbs threads"
+Test do
+  run_test "#{$bin}gt encseq encode -lossless -indexname genome " + \
+           "#{$testdata}ltrdigest_pbs/genome.fas"
+  # the tRNA library is indexed next to the file
+  run "cp #{$testdata}ltrdigest_pbs/trnas.fas ."
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrdigest -encseq genome " + \
+             "-trnas trnas.fas " + \
+             "#{$testdata}ltrdigest_pbs/ltrharvest.gff3", :maxtime => 300
+    run "diff #{last_stdout} #{$testdata}ltrdigest_pbs/ltrdigest.gff3"
+  end
+end
+
+Name "gt ltrdigest protein domains threads"
+Keywords "gt_ltrdigest pdom threads"
+Test do
+  run_test "#{$bin}gt encseq encode -lossless -indexname genome " + \
+           "#{$testdata}ltrdigest_pdom/genome.fas"
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrdigest -encseq genome " + \
+             "-pdomsearch builtin -outfileprefix result -aliout yes " + \
+             "-hmms #{$testdata}ltrdigest_pdom/domains.hmm -- " + \
+             "#{$testdata}ltrdigest_pdom/ltrharvest.gff3", :maxtime => 300
+    run "diff #{last_stdout} #{$testdata}ltrdigest_pdom/ltrdigest.gff3"
+    run "diff result_pdom_RVT_syn.ali " + \
+        "#{$testdata}ltrdigest_pdom/ltrdigest_pdom_RVT_syn.ali"
+  end
+end
+
+Name "gt ltrdigest protein domain cutoffs"
+Keywords "gt_ltrdigest pdom"
+Test do
+  run_test "#{$bin}gt encseq encode -lossless -indexname genome " + \
+           "#{$testdata}ltrdigest_pdom/genome.fas"
+  run_test "#{$bin}gt ltrdigest -encseq genome -pdomsearch builtin " + \
+           "-pdomcutoff GA -hmms #{$testdata}ltrdigest_pdom/domains.hmm -- " + \
+           "#{$testdata}ltrdigest_pdom/ltrharvest.gff3"
+  grep(last_stdout, /protein_match/)
+  run "grep -v '^GA' #{$testdata}ltrdigest_pdom/domains.hmm > noga.hmm"
+  run_test "#{$bin}gt ltrdigest -encseq genome -pdomsearch builtin " + \
+           "-pdomcutoff GA -hmms noga.hmm -- " + \
+           "#{$testdata}ltrdigest_pdom/ltrharvest.gff3",
+           :retval => 1
+  grep(last_stderr, /model RVT_syn has no gathering cutoffs/)
+end
+
+Name "gt ltrdigest HMMER2 model"
+Keywords "gt_ltrdigest pdom"
+Test do
+  run_test "#{$bin}gt encseq encode -lossless -indexname genome " + \
+           "#{$testdata}ltrdigest_pdom/genome.fas"
+  run_test "#{$bin}gt ltrdigest -encseq genome -pdomsearch builtin " + \
+           "-hmms #{$testdata}broken_hmmer.hmm -- " + \
+           "#{$testdata}ltrdigest_pdom/ltrharvest.gff3", :retval => 1
+  grep(last_stderr, /HMMER2 models are not supported/)
+end
+
+# the protein domain search with hmmscan needs hmmpress and hmmscan in the PATH
+def hmmer_available?
+  ["hmmpress", "hmmscan"].all? do |prog|
+    ENV["PATH"].split(File::PATH_SEPARATOR).any? do |dir|
+      File.executable?(File.join(dir, prog))
+    end
+  end
+end
+
+if hmmer_available? then
+  Name "gt ltrdigest built-in vs. hmmscan pdom search"
+  Keywords "gt_ltrdigest pdom"
+  Test do
+    run_test "#{$bin}gt encseq encode -lossless -indexname genome " + \
+             "#{$testdata}ltrdigest_pdom/genome.fas"
+    results = {}
+    ["hmmscan", "builtin"].each do |search|
+      run_test "#{$bin}gt ltrdigest -encseq genome -pdomsearch #{search} " + \
+               "-hmms #{$testdata}ltrdigest_pdom/domains.hmm -- " + \
+               "#{$testdata}ltrdigest_pdom/ltrharvest.gff3", :maxtime => 300
+      results[search] = protein_matches(last_stdout)
+    end
+    if results["hmmscan"].empty? then
+      failtest("no protein domains found with hmmscan")
+    end
+    check_protein_matches(results["hmmscan"], results["builtin"], "builtin")
+    check_protein_matches(results["builtin"], results["hmmscan"], "hmmscan")
+  end
+end
+
 if $gttestdata then
   Name "gt ltrdigest missing input GFF"
   Keywords "gt_ltrdigest"
@@ -419,6 +538,30 @@ if $gttestdata then
     end
   end
 
+  if $arguments["hmmer"] then
+    Name "gt ltrdigest D. mel. 4 built-in vs. hmmscan pdom search"
+    Keywords "gt_ltrdigest pdom"
+    Test do
+      run_test "#{$bin}gt suffixerator -lossless -dna -des -ssp -tis -v " + \
+               "-db #{$gttestdata}ltrdigest/4_genomic_dmel_RELEASE3-1.FASTA.gz", \
+               :maxtime => 600
+      results = {}
+      ["hmmscan", "builtin"].each do |search|
+        run_test "#{$bin}gt -j 2 ltrdigest -pdomsearch #{search} " + \
+                 "-encseq 4_genomic_dmel_RELEASE3-1.FASTA.gz " + \
+                 "-hmms #{$gttestdata}ltrdigest/hmms/RVT_1.hmm -- " + \
+                 "#{$gttestdata}ltrdigest/dmel_test_Run9_4.gff3.sorted",
+                 :retval => 0, :maxtime => 12000
+        results[search] = protein_matches(last_stdout)
+      end
+      if results["hmmscan"].empty? then
+        failtest("no protein domains found with hmmscan")
+      end
+      check_protein_matches(results["hmmscan"], results["builtin"], "builtin")
+      check_protein_matches(results["builtin"], results["hmmscan"], "hmmscan")
+    end
+  end
+
   # LEGACY INTERFACE TESTS
 
   Name "gt ltrdigest missing input GFF (legacy syntax)"
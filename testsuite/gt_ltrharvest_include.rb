@@ -40,6 +40,23 @@ runs_dmel["12"] = {:seed  => 20,
                   :xdrop => 7,
                   :similar => 70}
 
+# Run ltrharvest on <index> with <options> using one and four threads and
+# check that all outputs are identical.
+def check_ltrharvest_threads(index, options)
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrharvest -index #{index} #{options}" \
+           + " -gff3 out.gff3 -out out.fas -outinner inner.fas", \
+           :maxtime => 3600
+    run "mv #{last_stdout} j#{jobs}_stdout"
+    ["out.gff3", "out.fas", "inner.fas"].each do |file|
+      run "mv #{file} j#{jobs}_#{file}"
+    end
+  end
+  ["stdout", "out.gff3", "out.fas", "inner.fas"].each do |file|
+    run "diff j1_#{file} j4_#{file}"
+  end
+end
+
 # Test Drosophila melanogaster predictions for the parameter sets as
 # described in the LTRharvest paper and compare them with prior runs.
 # This is used to ensure result integrity across LTRharvest versions.
@@ -133,6 +150,23 @@ if $gttestdata then
       grep(last_stdout, "LTR_retrotransposon specificity: 100.00%")
     end
   end
+
+  # the predictions must not depend on the number of threads
+  {"yeast" => "s_cer/#{scer_files["chrAll"]}",
+   "Dmel" => "d_mel/#{dmel_files["chr4"]}"}.each do |k, v|
+    Name "gt ltrharvest -j 1 vs. -j 4 on #{k}"
+    Keywords "gt_ltrharvest threads"
+    Test do
+      run_test "#{$bin}gt suffixerator -db #{$gttestdata}ltrharvest/#{v}" \
+             + " -indexname genome -dna -suf -lcp -tis -des -sds -ssp", \
+             :maxtime => 3600
+      check_ltrharvest_threads("genome", "-seed 76 -minlenltr 116" \
+                               + " -maxlenltr 800 -mindistltr 2280" \
+                               + " -maxdistltr 8773 -similar 91 -mintsd 4" \
+                               + " -maxtsd 20 -vic 60 -overlaps best" \
+                               + " -xdrop 7 -mat 2 -mis -2 -ins -3 -del -3")
+    end
+  end
 end
 
 Name "gt ltrharvest missing index"
@@ -268,6 +302,22 @@ Test do
            " -gff3 out.gff3"
 end
 
+["ltrdigest_pbs", "ltrdigest_pdom"].each do |dir|
+  [["default", ""],
+   ["scan", "-scan"],
+   ["TSD longoutput", "-mintsd 4 -maxtsd 20 -longoutput"],
+   ["overlaps all", "-overlaps all"]].each do |name, options|
+    Name "gt ltrharvest -j 1 vs. -j 4 (#{dir}, #{name})"
+    Keywords "gt_ltrharvest threads"
+    Test do
+      run_test "#{$bin}gt suffixerator -db #{$testdata}#{dir}/genome.fas " + \
+               "-indexname genome -dna -suf -lcp -tis -des -sds -ssp"
+      check_ltrharvest_threads("genome", options)
+      grep("j1_out.gff3", /LTR_retrotransposon/)
+    end
+  end
+end
+
 Name "gt ltrharvest missing tables (lcp)"
 Keywords "gt_ltrharvest"
 Test do
@@ -211,6 +211,32 @@ Test do
   run "cmp u8.reads.esq u8.reads2.esq"
 end
 
+Name "gt suffixerator multithreaded bucket sort"
+Keywords "gt_suffixerator threads"
+Test do
+  ["", "-dir rcl", "-memlimit 1MB", "-parts 3", "-cmpcharbychar"].each do |opt|
+    ["U89959_genomic.fas", "at1MB"].each do |filename|
+      run_test "#{$bin}gt suffixerator -tis -suf -indexname sfx1 #{opt} " +
+               "-db #{$testdata}#{filename}"
+      run_test "#{$bin}gt -j 4 suffixerator -tis -suf -indexname sfx4 " +
+               "#{opt} -db #{$testdata}#{filename}"
+      run "cmp sfx1.suf sfx4.suf"
+      run_test "#{$bin}gt dev sfxmap -suf -tis -esa sfx4"
+    end
+  end
+end
+
+Name "gt sain multithreaded"
+Keywords "gt_sain threads"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname at1MB -dna #{$testdata}at1MB"
+  ["fwd", "rcl"].each do |dir|
+    run_test "#{$bin}gt -j 4 dev sain -icheck -fcheck -dir #{dir} -esq at1MB",
+             :maxtime => 300
+  end
+  run_test "#{$bin}gt -j 4 dev sain -icheck -file at1MB.esq", :maxtime => 300
+end
+
 Name "gt suffixerator -dc 64 -dccheck -lcp -parts 1+3"
 Keywords "gt_suffixerator dc"
 Test do
@@ -49,6 +49,42 @@ runtyrmkifail("-mersize 21 -pl")
 runtyrmkifail("-mersize 21 -pl -minocc")
 runtyrmkifail("-pl -minocc 30 -maxocc 40")
 
+Name "gt tallymer mkindex/occratio multithreaded"
+Keywords "gt_tallymer mkindex occratio"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB -tis " +
+           "-suf -lcp -pl -dna -indexname sfxidx"
+  [1,4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} tallymer mkindex -counts -pl -mersize 12 " +
+             "-minocc 2 -indexname tyr-index#{jobs} -esa sfxidx"
+    run_test "#{$bin}gt -j #{jobs} tallymer mkindex -mersize 12 -minocc 20 " +
+             "-esa sfxidx"
+    run "mv #{last_stdout} mkindex#{jobs}.out"
+    run_test "#{$bin}gt -j #{jobs} tallymer occratio -minmersize 4 " +
+             "-maxmersize 40 -output unique nonunique nonuniquemulti " +
+             "-esa sfxidx"
+    run "mv #{last_stdout} occratio#{jobs}.out"
+  end
+  run "cmp tyr-index1.mer tyr-index4.mer"
+  run "cmp tyr-index1.mct tyr-index4.mct"
+  run "cmp mkindex1.out mkindex4.out"
+  run "cmp occratio1.out occratio4.out"
+end
+
+Name "gt tallymer search batches"
+Keywords "gt_tallymer search"
+Test do
+  run_test "#{$bin}gt suffixerator -db #{$testdata}at1MB -tis " +
+           "-suf -lcp -pl -dna -indexname sfxidx"
+  [14,40].each do |mersize|
+    run_test "#{$bin}gt tallymer mkindex -counts -pl -mersize #{mersize} " +
+             "-minocc 1 -indexname tyr-index -esa sfxidx"
+    run_test "#{$bin}gt tallymer search -test -output qseqnum qpos counts " +
+             "sequence -tyr tyr-index -q #{$testdata}U89959_genomic.fas " +
+             "#{$testdata}at1MB", :maxtime => 360
+  end
+end
+
 if $gttestdata then
   tyrfiles.each_pair do |reffile,mersize|
     Name "gt tallymer #{reffile}"
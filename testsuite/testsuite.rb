@@ -121,10 +121,12 @@ require 'gt_genomediff_include'
 require 'gt_gff3_include'
 require 'gt_gff3validator_include'
 require 'gt_gtf_to_gff3_include'
+require 'gt_gth_include'
 require 'gt_hop_include'
 require 'gt_id_to_md5_include'
 require 'gt_include'
 require 'gt_interfeat_include'
+require 'gt_ltrclustering_include'
 require 'gt_ltrdigest_include'
 require 'gt_ltrharvest_include'
 require 'gt_magicmatch_include'